@@ -21,6 +21,8 @@ MACRO(MPV_PLUGIN_INIT _target)
     
     IF(NOT "${ARGN}" MATCHES "NOCOMMON")
         INCLUDE_DIRECTORIES(${PROJECT_SOURCE_DIR}/common)
+        # common/Log.h uses OpenThreads
+        INCLUDE_DIRECTORIES(${OPENTHREADS_INCLUDE_DIR})
     ENDIF(NOT "${ARGN}" MATCHES "NOCOMMON")
     
     IF(NOT "${ARGN}" MATCHES "NOPDL")
@@ -0,0 +1,198 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include "CigiMessagePartitioner.h"
+
+using namespace mpv;
+
+
+// ================================================
+// CigiMessagePartitioner
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiMessagePartitioner::CigiMessagePartitioner() :
+	packetCount( 0 ),
+	truncated( false )
+{
+}
+
+
+// ================================================
+// getTargetType
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiMessagePartitioner::TargetType CigiMessagePartitioner::getTargetType( int packetID )
+{
+	// Each of these has its target's ID in bytes 2 and 3.  Symbol Clone 
+	// is left out, since it reads another symbol; so are Component 
+	// Control and Short Component Control, whose target depends on the 
+	// component class.
+	switch( packetID )
+	{
+	case 2:  // Entity Control
+	case 3:  // Conformal Clamped Entity Control
+	case 6:  // Articulated Part Control
+	case 7:  // Short Articulated Part Control
+	case 8:  // Rate Control
+	case 20: // Trajectory Definition
+	case 22: // Collision Detection Segment Definition
+	case 23: // Collision Detection Volume Definition
+		return Entity;
+	case 30: // Symbol Text Definition
+	case 31: // Symbol Circle Definition
+	case 32: // Symbol Line Definition
+	case 34: // Symbol Control
+	case 35: // Short Symbol Control
+		return Symbol;
+	default:
+		return Global;
+	}
+}
+
+
+// ================================================
+// findPartition
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiMessagePartitioner::findPartition( TargetType type, const unsigned char *id )
+{
+	unsigned int value = ( id[0] << 8 ) | id[1];
+	unsigned int key = ( (unsigned int)type << 16 ) | value;
+	std::map< unsigned int, int >::iterator iter = partitionIndex.find( key );
+	if( iter != partitionIndex.end() )
+		return iter->second;
+
+	int index = (int)partitions.size();
+	partitionIndex[key] = index;
+	partitions.push_back( Partition() );
+	partitions.back().type = type;
+	partitions.back().id = value;
+	partitions.back().referenced = false;
+	return index;
+}
+
+
+// ================================================
+// reference
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiMessagePartitioner::reference( TargetType type, const unsigned char *id )
+{
+	partitions[findPartition( type, id )].referenced = true;
+}
+
+
+// ================================================
+// scan
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiMessagePartitioner::scan( const unsigned char *message, int length )
+{
+	packetCount = 0;
+	truncated = false;
+	globalPackets.clear();
+	partitions.clear();
+	partitionIndex.clear();
+	if( message == NULL )
+		return 0;
+
+	// The IG Control's magic number (bytes 6 and 7) gives the host's 
+	// byte order, which is needed to find the low half of a 32-bit datum
+	bool bigEndian = true;
+	if( length >= 8 && message[0] == 1 )
+		bigEndian = ( message[6] == 0x80 );
+
+	int offset = 0;
+	while( offset < length )
+	{
+		// In CIGI 3, a packet's size is in its second byte
+		int packetLength = offset + 1 < length ? message[offset + 1] : 0;
+		if( packetLength < 4 || offset + packetLength > length )
+		{
+			truncated = true;
+			break;
+		}
+
+		const unsigned char *packet = message + offset;
+		TargetType type = getTargetType( packet[0] );
+
+		// Packets that refer to a second target go with the global 
+		// packets; the partitions of both targets are referenced.  The 
+		// attach flag is bit 2 of byte 4 in each of these.
+		bool multiTarget = false;
+		switch( packet[0] )
+		{
+		case 2:  // Entity Control; the parent ID is in bytes 10 and 11
+			if( packetLength >= 12 && ( packet[4] & 0x04 ) )
+			{
+				multiTarget = true;
+				reference( Entity, packet + 10 );
+			}
+			break;
+		case 33: // Symbol Clone; a source symbol's ID is in bytes 6 and 7
+			if( packetLength >= 8 )
+			{
+				reference( Symbol, packet + 2 );
+				if( ( packet[4] & 0x01 ) == 0 )
+					reference( Symbol, packet + 6 );
+			}
+			break;
+		case 34: // Symbol Control; parent ID in bytes 6-7, surface in 8-9
+			multiTarget = true;
+			if( packetLength >= 8 && ( packet[4] & 0x04 ) )
+				reference( Symbol, packet + 6 );
+			break;
+		case 35: // Short Symbol Control; datum types in bytes 6 and 7
+			if( packetLength >= 16 )
+			{
+				if( packet[4] & 0x04 )
+					multiTarget = true;
+				for( int datum = 0; datum < 2; datum++ )
+				{
+					int datumType = packet[6 + datum];
+					// 1 is the surface ID, 2 the parent ID
+					if( datumType == 1 || datumType == 2 )
+						multiTarget = true;
+					if( datumType == 2 )
+						reference( Symbol, packet + 8 + datum * 4 + ( bigEndian ? 2 : 0 ) );
+				}
+			}
+			break;
+		default:
+			break;
+		}
+
+		if( multiTarget )
+		{
+			reference( type, packet + 2 );
+			type = Global;
+		}
+
+		if( type == Global )
+			globalPackets.push_back( offset );
+		else
+			partitions[findPartition( type, packet + 2 )].packetOffsets.push_back( offset );
+
+		packetCount++;
+		offset += packetLength;
+	}
+
+	return packetCount;
+}
@@ -0,0 +1,148 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_CIGI_MESSAGE_PARTITIONER_H_
+#define _MPV_CIGI_MESSAGE_PARTITIONER_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <vector>
+
+#include "MPVCommonTypes.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! Sorts the packets in a packed CIGI 3 message from the host by what they
+//! act on.  Packets for an entity (entity, articulated part, rate control
+//! and so on) are grouped by entity ID.  Packets for a symbol are grouped by
+//! symbol ID.  Everything else is "global": IG Control, views, weather,
+//! requests, and any packet that refers to more than one target.  Each
+//! group keeps its packets in message order.
+//!
+//! A packet of an entity or symbol type is global too if it refers to a 
+//! second target: an Entity Control that attaches the entity to a parent, 
+//! any Symbol Control (it always names the symbol's surface), and a Short 
+//! Symbol Control that attaches the symbol or sets its parent or surface.  
+//! So is a Symbol Clone.  The partitions of the targets such a packet 
+//! refers to are marked as referenced, so that a caller can keep them in 
+//! order with the global packets.
+//!
+//! The scan only reads each packet's ID, size, flags and target IDs; 
+//! nothing is unpacked.  Target IDs are compared as they appear on the 
+//! wire, so the host's byte order doesn't matter.
+//!
+class MPVCMN_SPEC CigiMessagePartitioner
+{
+public:
+
+	enum TargetType
+	{
+		Global,
+		Entity,
+		Symbol
+	};
+
+	//=========================================================
+	//! The packets for one target, as offsets into the message
+	//!
+	struct Partition
+	{
+		TargetType type;
+		//! the target ID, in the host's byte order
+		unsigned int id;
+		std::vector< int > packetOffsets;
+		//! true if a global packet also refers to this target
+		bool referenced;
+	};
+
+	CigiMessagePartitioner();
+
+	//=========================================================
+	//! Returns what a packet with the given ID acts on.  A packet of an 
+	//! entity or symbol type may still be global; see above.
+	//!
+	static TargetType getTargetType( int packetID );
+
+	//=========================================================
+	//! Partitions a message.  The results stay valid until the next call.
+	//! \return the number of packets in the message
+	//!
+	int scan( const unsigned char *message, int length );
+
+	int getPacketCount() const { return packetCount; }
+
+	//=========================================================
+	//! The global packets, in message order
+	//!
+	const std::vector< int > &getGlobalPackets() const { return globalPackets; }
+
+	//=========================================================
+	//! The entity and symbol partitions, in order of their first packets.  
+	//! A target that only global packets refer to has a partition with no 
+	//! packets.
+	//!
+	int getPartitionCount() const { return (int)partitions.size(); }
+	const Partition &getPartition( int index ) const { return partitions[index]; }
+
+	//=========================================================
+	//! True if the message ended partway through a packet, or had a packet
+	//! with an impossible size; the rest of the message wasn't scanned
+	//!
+	bool isTruncated() const { return truncated; }
+
+private:
+
+	//! Returns the index of the partition for a target, creating it if 
+	//! necessary.  id points at the target ID in the message.
+	int findPartition( TargetType type, const unsigned char *id );
+
+	//! Marks the partition for a target as referenced
+	void reference( TargetType type, const unsigned char *id );
+
+	int packetCount;
+	bool truncated;
+	std::vector< int > globalPackets;
+
+	std::vector< Partition > partitions;
+
+	//! (type << 16 | id) to index in partitions
+	std::map< unsigned int, int > partitionIndex;
+};
+
+}
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,101 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <string.h>
+
+#include "CigiMessageSplitter.h"
+
+using namespace mpv;
+
+
+// ================================================
+// CigiMessageSplitter
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiMessageSplitter::CigiMessageSplitter()
+{
+}
+
+
+// ================================================
+// split
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiMessageSplitter::split( const unsigned char *message, int length, 
+	int maxLength )
+{
+	pieces.clear();
+	lengths.clear();
+	if( message == NULL || length <= 0 )
+		return 0;
+
+	// In CIGI 3, a packet's size is in its second byte
+	int headerLength = length >= 2 ? message[1] : 0;
+	if( maxLength <= 0 || length <= maxLength || 
+		headerLength < 2 || headerLength >= length )
+	{
+		pieces.push_back( message );
+		lengths.push_back( length );
+		return 1;
+	}
+
+	// The pieces are built in buffer, so their offsets are recorded first,
+	// and turned into pointers once buffer is done growing.  Each piece 
+	// adds another copy of the header, so buffer can't be sized exactly 
+	// up front.
+	buffer.clear();
+	std::vector< int > offsets;
+
+	const unsigned char *packet = message + headerLength;
+	const unsigned char *end = message + length;
+	int pieceStart = -1;
+	while( packet < end )
+	{
+		int packetLength = packet + 1 < end ? packet[1] : 0;
+		if( packetLength < 2 || packet + packetLength > end )
+		{
+			// a malformed packet; pass the rest along as it is, rather 
+			// than guess where the packets are
+			packetLength = end - packet;
+		}
+
+		int pieceLength = pieceStart < 0 ? 0 : (int)buffer.size() - pieceStart;
+		if( pieceStart < 0 || ( pieceLength + packetLength > maxLength && 
+			pieceLength > headerLength ) )
+		{
+			if( pieceStart >= 0 )
+				lengths.push_back( pieceLength );
+			pieceStart = (int)buffer.size();
+			offsets.push_back( pieceStart );
+			buffer.insert( buffer.end(), message, message + headerLength );
+		}
+
+		buffer.insert( buffer.end(), packet, packet + packetLength );
+		packet += packetLength;
+	}
+	lengths.push_back( (int)buffer.size() - pieceStart );
+
+	for( unsigned int i = 0; i < offsets.size(); i++ )
+		pieces.push_back( &buffer[0] + offsets[i] );
+	return (int)pieces.size();
+}
@@ -0,0 +1,96 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_CIGI_MESSAGE_SPLITTER_H_
+#define _MPV_CIGI_MESSAGE_SPLITTER_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "MPVCommonTypes.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! Splits a packed CIGI 3 message into messages of no more than a given
+//! size, so that each fits in one datagram.  Every piece is a valid CIGI
+//! message: it starts with a copy of the original's first packet (the
+//! Start of Frame, from an IG), followed by whole packets, in order.
+//!
+//! A message that already fits is passed through without being copied.
+//! A single packet too large to fit along with the first packet is sent
+//! in a piece of its own, over the limit.
+//!
+class MPVCMN_SPEC CigiMessageSplitter
+{
+public:
+
+	CigiMessageSplitter();
+
+	//=========================================================
+	//! Splits a message.  The pieces stay valid until the next call, or
+	//! until the original message changes.
+	//! \param message - the packed message, starting with a Start of Frame
+	//!        (or, from a host, an IG Control)
+	//! \param length - the message length
+	//! \param maxLength - the largest piece wanted; 0 or less for no limit
+	//! \return the number of pieces
+	//!
+	int split( const unsigned char *message, int length, int maxLength );
+
+	int getCount() const { return (int)pieces.size(); }
+
+	//=========================================================
+	//! The pieces from the last split(), as arrays that can be passed to
+	//! CigiTransport::sendMany()
+	//!
+	const unsigned char * const *getPieces() const
+		{ return pieces.empty() ? NULL : &pieces[0]; }
+	const int *getLengths() const
+		{ return lengths.empty() ? NULL : &lengths[0]; }
+
+private:
+
+	std::vector< const unsigned char * > pieces;
+	std::vector< int > lengths;
+
+	//! the pieces' data, for messages that had to be split
+	std::vector< unsigned char > buffer;
+};
+
+}
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif
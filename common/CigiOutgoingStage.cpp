@@ -0,0 +1,217 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <string.h>
+
+#include <sstream>
+
+#include <OpenThreads/ScopedLock>
+
+#include "Log.h"
+#include "CigiOutgoingStage.h"
+
+using namespace mpv;
+
+
+// ================================================
+// Producer
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiOutgoingStage::Producer::Producer( const std::string &_name, int capacity ) :
+	name( _name ),
+	head( 0 ),
+	tail( 0 ),
+	dropped( 0 ),
+	droppedReported( 0 )
+{
+	unsigned int size = 2;
+	while( size < (unsigned int)capacity )
+		size <<= 1;
+	slots.resize( size, NULL );
+	slab.resize( size );
+	mask = size - 1;
+}
+
+
+// ================================================
+// ~Producer
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiOutgoingStage::Producer::~Producer()
+{
+	while( front() != NULL )
+		popFront();
+}
+
+
+// ================================================
+// isFull
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiOutgoingStage::Producer::isFull() const
+{
+	unsigned int currentTail = tail;
+	memoryFence();
+	return head - currentTail >= slots.size();
+}
+
+
+// ================================================
+// push
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiOutgoingStage::Producer::push( StagedPacket *packet )
+{
+	unsigned int currentHead = head;
+	slots[currentHead & mask] = packet;
+	// the slot has to be visible before the new head is
+	memoryFence();
+	head = currentHead + 1;
+}
+
+
+// ================================================
+// front
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiOutgoingStage::StagedPacket *CigiOutgoingStage::Producer::front()
+{
+	unsigned int currentTail = tail;
+	unsigned int currentHead = head;
+	if( currentTail == currentHead )
+		return NULL;
+	// don't read the slot before the head that covers it
+	memoryFence();
+	return slots[currentTail & mask];
+}
+
+
+// ================================================
+// popFront
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiOutgoingStage::Producer::popFront()
+{
+	unsigned int currentTail = tail;
+	StagedPacket *packet = slots[currentTail & mask];
+	slots[currentTail & mask] = NULL;
+	// the copy lives in the slab, so it is destroyed but not deleted
+	packet->~StagedPacket();
+	// the slot has to be finished with before the producer may reuse it
+	memoryFence();
+	tail = currentTail + 1;
+}
+
+
+// ================================================
+// CigiOutgoingStage
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiOutgoingStage::CigiOutgoingStage() : Referenced()
+{
+	memset( mergedCounts, 0, sizeof( mergedCounts ) );
+}
+
+
+// ================================================
+// ~CigiOutgoingStage
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiOutgoingStage::~CigiOutgoingStage()
+{
+	for( unsigned int i = 0; i < producers.size(); i++ )
+		delete producers[i];
+	producers.clear();
+}
+
+
+// ================================================
+// createProducer
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiOutgoingStage::Producer *CigiOutgoingStage::createProducer(
+	const std::string &name, int capacity )
+{
+	Producer *producer = new Producer( name, capacity );
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( producersMutex );
+	producers.push_back( producer );
+	return producer;
+}
+
+
+// ================================================
+// merge
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiOutgoingStage::merge( CigiOutgoingMsg &message )
+{
+	int merged = 0;
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( producersMutex );
+	for( unsigned int i = 0; i < producers.size(); i++ )
+	{
+		Producer *producer = producers[i];
+		// only take what was staged before we started, so that a busy
+		// producer can't hold up the frame
+		unsigned int count = producer->head - producer->tail;
+		for( unsigned int j = 0; j < count; j++ )
+		{
+			StagedPacket *packet = producer->front();
+			if( packet == NULL )
+				break;
+			packet->emit( message );
+			mergedCounts[packet->getPacketID() & 0xff]++;
+			producer->popFront();
+			merged++;
+		}
+	}
+	return merged;
+}
+
+
+// ================================================
+// report
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiOutgoingStage::report()
+{
+	std::ostringstream merged;
+	for( int id = 0; id < 256; id++ )
+	{
+		if( mergedCounts[id] == 0 )
+			continue;
+		merged << " " << id << ":" << mergedCounts[id];
+		mergedCounts[id] = 0;
+	}
+
+	std::ostringstream dropped;
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( producersMutex );
+		for( unsigned int i = 0; i < producers.size(); i++ )
+		{
+			Producer *producer = producers[i];
+			unsigned int total = producer->dropped;
+			if( total != producer->droppedReported )
+			{
+				dropped << " " << producer->name << ":"
+					<< total - producer->droppedReported;
+				producer->droppedReported = total;
+			}
+		}
+	}
+
+	if( !merged.str().empty() )
+		MPV_LOG_INFO( "CigiOutgoingStage - merged packets (id:count)" << merged.str() );
+	if( !dropped.str().empty() )
+		MPV_LOG_WARNING( "CigiOutgoingStage - dropped packets (producer:count)" << dropped.str() );
+}
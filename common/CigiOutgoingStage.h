@@ -0,0 +1,215 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_CIGI_OUTGOING_STAGE_H_
+#define _MPV_CIGI_OUTGOING_STAGE_H_
+
+#include <new>
+#include <string>
+#include <vector>
+
+#include <OpenThreads/Mutex>
+
+#include <CigiOutgoingMsg.h>
+
+#include "Referenced.h"
+#include "MemoryFence.h"
+#include "MPVCommonTypes.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! Lets threads other than the kernel's queue packets for the host.  The
+//! CigiOutgoingMsg may only be written from the kernel thread; a worker
+//! thread instead gets a Producer from the stage (posted to the blackboard
+//! as "CigiOutgoingStage") and stages its packets there.  Just before the
+//! outgoing message is sent, the kernel merges the staged packets into it.
+//!
+//! Each producer has its own single-producer, single-consumer queue, so
+//! staging a packet takes no lock.  Packets are merged after the Start of
+//! Frame and after any packets written to the outgoing message directly;
+//! each producer's packets keep their order, and producers are merged in
+//! the order they were created.
+//!
+//! Staged packets are copies, packed when they are merged, by the same
+//! CigiOutgoingMsg code that packs packets written directly.  The copies
+//! are made in a slab that each producer allocates up front, one slot per
+//! place in its queue, so staging a packet doesn't allocate either.
+//!
+class MPVCMN_SPEC CigiOutgoingStage : public Referenced
+{
+public:
+
+	//=========================================================
+	//! A packet waiting in a producer's queue
+	//!
+	class StagedPacket
+	{
+	public:
+		virtual ~StagedPacket() {}
+		virtual void emit( CigiOutgoingMsg &message ) = 0;
+		virtual int getPacketID() const = 0;
+	};
+
+	template< class PacketType >
+	class TypedStagedPacket : public StagedPacket
+	{
+	public:
+		TypedStagedPacket( const PacketType &_packet ) : packet( _packet ) {}
+		virtual void emit( CigiOutgoingMsg &message ) { message << packet; }
+		virtual int getPacketID() const { return packet.GetPacketID(); }
+	private:
+		PacketType packet;
+	};
+
+	//=========================================================
+	//! One thread's queue of staged packets.  Only the thread that owns
+	//! the producer may call stage().
+	//!
+	class MPVCMN_SPEC Producer
+	{
+	public:
+		//=========================================================
+		//! Stages a copy of a packet
+		//! \return false if the queue is full; the packet is dropped, and
+		//!         counted
+		//!
+		template< class PacketType >
+		bool stage( const PacketType &packet )
+		{
+			// a packet class too big for a slot won't compile
+			(void)sizeof( char[ sizeof( TypedStagedPacket<PacketType> ) <= sizeof( Slot ) ? 1 : -1 ] );
+			if( isFull() )
+			{
+				dropped++;
+				return false;
+			}
+			void *storage = &slab[head & mask];
+			push( new( storage ) TypedStagedPacket<PacketType>( packet ) );
+			return true;
+		}
+
+		const std::string &getName() const { return name; }
+
+	private:
+		friend class CigiOutgoingStage;
+
+		Producer( const std::string &_name, int capacity );
+		~Producer();
+
+		bool isFull() const;
+		void push( StagedPacket *packet );
+
+		//! consumer side; returns NULL if the queue is empty.  The packet
+		//! keeps its slot until popFront().
+		StagedPacket *front();
+
+		//! consumer side; destroys the packet front() returned, and gives
+		//! its slot back to the producer
+		void popFront();
+
+		//=========================================================
+		//! Room for one staged packet.  The CCL packet classes are well
+		//! under this; the member that follows bytes is only there for the
+		//! alignment.
+		//!
+		union Slot
+		{
+			char bytes[256];
+			double alignment;
+		};
+
+		std::string name;
+
+		//! written only by the producer
+		volatile unsigned int head;
+		char padHead[60];
+		//! written only by the consumer
+		volatile unsigned int tail;
+		char padTail[60];
+
+		//! the packets in the queue, each constructed in the slab slot
+		//! with the same index
+		std::vector< StagedPacket * > slots;
+		std::vector< Slot > slab;
+		unsigned int mask;
+
+		//! written only by the producer
+		volatile unsigned int dropped;
+		//! consumer's copy of dropped, as of the last report
+		unsigned int droppedReported;
+	};
+
+	CigiOutgoingStage();
+
+	//=========================================================
+	//! Creates a queue for a thread to stage packets in.  The producer
+	//! belongs to the stage, and lasts as long as it does.
+	//! \param name - for the statistics
+	//! \param capacity - the most packets that can wait in the queue;
+	//!        rounded up to a power of two.  The producer's slab takes
+	//!        that many slots, of 256 bytes each.
+	//!
+	Producer *createProducer( const std::string &name, int capacity = 1024 );
+
+	//=========================================================
+	//! Moves the staged packets into the outgoing message.  Called by the
+	//! kernel, before each message is sent.
+	//! \return the number of packets merged
+	//!
+	int merge( CigiOutgoingMsg &message );
+
+	//=========================================================
+	//! Writes the number of packets merged, by packet ID, and dropped, by
+	//! producer, since the last report to the log, and resets them
+	//!
+	void report();
+
+protected:
+
+	virtual ~CigiOutgoingStage();
+
+	std::vector< Producer * > producers;
+
+	//! protects producers; staging doesn't touch it
+	OpenThreads::Mutex producersMutex;
+
+	//! packets merged since the last report, by packet ID
+	unsigned int mergedCounts[256];
+};
+
+}
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif
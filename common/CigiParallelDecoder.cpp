@@ -0,0 +1,297 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <algorithm>
+
+#include <OpenThreads/ScopedLock>
+
+#include <CigiException.h>
+
+#include "Log.h"
+#include "CigiParallelDecoder.h"
+
+using namespace mpv;
+
+
+// ================================================
+// CigiParallelDecoder
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiParallelDecoder::CigiParallelDecoder( CigiIncomingMsg &_serialMessage, int numThreads ) :
+	Referenced(),
+	serialMessage( &_serialMessage ),
+	generation( 0 ),
+	workersRemaining( 0 ),
+	quit( false )
+{
+	for( int i = 0; i < 256; i++ )
+		parallelSafe[i] = false;
+
+	if( numThreads <= 0 )
+		return;
+
+	// configured the same way as the kernel's session
+	for( int i = 0; i < numThreads + 1; i++ )
+	{
+		Slot *slot = new Slot;
+		slot->session = new CigiIGSession;
+		slot->session->SetCigiVersion( 3, 3 );
+		slot->session->SetSynchronous( true );
+		slot->session->GetIncomingMsgMgr().SetReaderCigiVersion( 3, 3 );
+		slot->session->GetIncomingMsgMgr().UsingIteration( false );
+		slot->packets = 0;
+		slots.push_back( slot );
+	}
+
+	for( int i = 0; i < numThreads; i++ )
+		workers.push_back( new Worker( this, i + 1 ) );
+	for( unsigned int i = 0; i < workers.size(); i++ )
+		workers[i]->start();
+}
+
+
+// ================================================
+// ~CigiParallelDecoder
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiParallelDecoder::~CigiParallelDecoder()
+{
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( runMutex );
+		quit = true;
+		startCondition.broadcast();
+	}
+
+	for( unsigned int i = 0; i < workers.size(); i++ )
+	{
+		workers[i]->join();
+		delete workers[i];
+	}
+	for( unsigned int i = 0; i < slots.size(); i++ )
+	{
+		delete slots[i]->session;
+		for( unsigned int j = 0; j < slots[i]->captures.size(); j++ )
+			delete slots[i]->captures[j];
+		delete slots[i];
+	}
+}
+
+
+// ================================================
+// isParallelSafe
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiParallelDecoder::isParallelSafe( int packetID ) const
+{
+	if( packetID < 0 || packetID >= 256 )
+		return false;
+	return parallelSafe[packetID];
+}
+
+
+// ================================================
+// append
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiParallelDecoder::append( std::vector< unsigned char > &buffer,
+	const unsigned char *packet )
+{
+	// the scan has already checked that the packet fits in the message
+	buffer.insert( buffer.end(), packet, packet + packet[1] );
+}
+
+
+// ================================================
+// apply
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiParallelDecoder::apply( const CigiMessagePartitioner &partitioner,
+	unsigned char *message, int length )
+{
+	// The IG Control's version is in byte 2, and the IG mode in bits 0
+	// and 1 of byte 4; 0 is Reset/Standby.  The packet IDs the scan relies
+	// on are CIGI 3's.
+	if( workers.empty() || partitioner.isTruncated() ||
+		length < 8 || message[0] != 1 || message[2] != 3 ||
+		( message[4] & 0x03 ) == 0 )
+	{
+		serialMessage->ProcessIncomingMsg( message, length );
+		return 0;
+	}
+
+	const unsigned char *igCtrl = message;
+	for( unsigned int i = 0; i < slots.size(); i++ )
+	{
+		slots[i]->buffer.clear();
+		append( slots[i]->buffer, igCtrl );
+		slots[i]->packets = 0;
+	}
+
+	serialOffsets = partitioner.getGlobalPackets();
+	int parallelPackets = 0;
+	for( int p = 0; p < partitioner.getPartitionCount(); p++ )
+	{
+		const CigiMessagePartitioner::Partition &partition = partitioner.getPartition( p );
+		const std::vector< int > &offsets = partition.packetOffsets;
+
+		// The packets from the last one that isn't parallel-safe on are 
+		// applied serially, so they still come before the rest
+		int first = (int)offsets.size();
+		if( !partition.referenced )
+		{
+			while( first > 0 && parallelSafe[message[offsets[first - 1]]] )
+				first--;
+		}
+		serialOffsets.insert( serialOffsets.end(), 
+			offsets.begin(), offsets.begin() + first );
+		int count = (int)offsets.size() - first;
+		if( count == 0 )
+			continue;
+
+		// the rest of the partition goes to the least loaded slot
+		Slot *slot = slots[0];
+		for( unsigned int i = 1; i < slots.size(); i++ )
+		{
+			if( slots[i]->packets < slot->packets )
+				slot = slots[i];
+		}
+		for( int i = first; i < (int)offsets.size(); i++ )
+			append( slot->buffer, message + offsets[i] );
+		slot->packets += count;
+		parallelPackets += count;
+	}
+
+	if( parallelPackets == 0 )
+	{
+		serialMessage->ProcessIncomingMsg( message, length );
+		return 0;
+	}
+
+	for( unsigned int i = 0; i < slots.size(); i++ )
+	{
+		for( unsigned int j = 0; j < slots[i]->captures.size(); j++ )
+			slots[i]->captures[j]->reset();
+		slots[i]->decoded.clear();
+	}
+
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( runMutex );
+		workersRemaining = (int)workers.size();
+		generation++;
+		startCondition.broadcast();
+	}
+
+	// While the workers decode, this thread applies the serial packets, 
+	// in message order, starting with the IG Control.  For any one 
+	// target, those are the packets that came before the ones decoded in 
+	// parallel, and no global packet refers to it, so each target's 
+	// packets are still applied in order.
+	std::sort( serialOffsets.begin(), serialOffsets.end() );
+	serialBuffer.clear();
+	for( unsigned int i = 0; i < serialOffsets.size(); i++ )
+		append( serialBuffer, message + serialOffsets[i] );
+	try
+	{
+		serialMessage->ProcessIncomingMsg( &serialBuffer[0], (int)serialBuffer.size() );
+	}
+	catch( ... )
+	{
+		// the workers mustn't be left holding this message
+		applyDecoded();
+		throw;
+	}
+
+	applyDecoded();
+	return parallelPackets;
+}
+
+
+// ================================================
+// applyDecoded
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiParallelDecoder::applyDecoded()
+{
+	// this thread decodes a share too
+	decodeSlot( 0 );
+
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( runMutex );
+		while( workersRemaining > 0 )
+			doneCondition.wait( &runMutex );
+	}
+
+	for( unsigned int i = 0; i < slots.size(); i++ )
+	{
+		std::vector< std::pair< Capture *, int > > &decoded = slots[i]->decoded;
+		for( unsigned int j = 0; j < decoded.size(); j++ )
+			decoded[j].first->apply( decoded[j].second );
+	}
+}
+
+
+// ================================================
+// decodeSlot
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiParallelDecoder::decodeSlot( int index )
+{
+	Slot *slot = slots[index];
+	if( slot->packets == 0 )
+		return;
+
+	try
+	{
+		slot->session->GetIncomingMsgMgr().ProcessIncomingMsg(
+			&slot->buffer[0], (int)slot->buffer.size() );
+	}
+	catch( CigiException &theException )
+	{
+		MPV_LOG_ERROR( "CigiParallelDecoder - Exception: "
+			<< theException.what() );
+	}
+}
+
+
+// ================================================
+// Worker::run
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiParallelDecoder::Worker::run()
+{
+	unsigned int seen = 0;
+	while( true )
+	{
+		{
+			OpenThreads::ScopedLock<OpenThreads::Mutex> lock( decoder->runMutex );
+			while( !decoder->quit && decoder->generation == seen )
+				decoder->startCondition.wait( &decoder->runMutex );
+			if( decoder->quit )
+				return;
+			seen = decoder->generation;
+		}
+
+		decoder->decodeSlot( index );
+
+		{
+			OpenThreads::ScopedLock<OpenThreads::Mutex> lock( decoder->runMutex );
+			decoder->workersRemaining--;
+			if( decoder->workersRemaining == 0 )
+				decoder->doneCondition.signal();
+		}
+	}
+}
@@ -0,0 +1,262 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_CIGI_PARALLEL_DECODER_H_
+#define _MPV_CIGI_PARALLEL_DECODER_H_
+
+#include <vector>
+#include <utility>
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Thread>
+
+#include <CigiIGSession.h>
+#include <CigiIncomingMsg.h>
+#include <CigiBaseEventProcessor.h>
+
+#include "Referenced.h"
+#include "CigiMessagePartitioner.h"
+#include "MPVCommonTypes.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! Decodes the packets in a message from the host on several threads, and
+//! applies them on the calling thread.  The kernel scans each message with
+//! a CigiMessagePartitioner.  Packets for an entity or symbol that may be
+//! decoded in parallel, and that no packet which may not follows, are
+//! split among the threads, a target at a time.  Each thread unpacks its
+//! share with its own CigiIGSession, into copies that it keeps.
+//!
+//! Only the unpacking happens on the worker threads.  Every processor
+//! runs on the thread that called apply(): first for the serial packets
+//! (the IG Control, the global packets, and everything else, in message
+//! order), which the kernel's CigiIncomingMsg unpacks while the workers
+//! unpack theirs; then for the decoded packets, a target at a time, each
+//! target's in message order.  Processors therefore needn't be
+//! thread-safe; the entity and symbol containers, the signals they emit,
+//! and the scene graph are only touched by the calling thread.
+//!
+//! A packet type is decoded in parallel if its processor was registered
+//! here rather than with the CigiIncomingMsg.  Its packets may then be
+//! applied after global packets that came later in the message, so a
+//! type should only be registered here if no global packet depends on
+//! it.  A processor registered here is also registered with the
+//! CigiIncomingMsg, for the packets that are applied serially.  No other
+//! processor should be registered for the same packet type, since it
+//! would only see the packets that happened to be applied serially.
+//!
+//! So an Entity Control followed by articulated part controls for the
+//! same entity is applied serially, and the articulated part controls are
+//! decoded in parallel; an articulated part control that comes before the
+//! Entity Control is applied serially too.  If a global packet refers to
+//! a target, all of its packets are applied serially.  Either way, packets
+//! for one target are always applied in order.  The whole message is
+//! applied serially if it doesn't start with a CIGI 3 IG Control in
+//! Operate or Debug mode, or if it ends partway through a packet.
+//!
+//! Posted to the blackboard as "CigiParallelDecoder".
+//!
+class MPVCMN_SPEC CigiParallelDecoder : public Referenced
+{
+public:
+
+	//=========================================================
+	//! Constructor
+	//! \param serialMessage - the kernel's incoming message handler
+	//! \param numThreads - the number of worker threads to start.  The
+	//!        thread calling apply() also decodes a share.  0 turns
+	//!        parallel decoding off; registered processors are then
+	//!        simply registered with serialMessage.
+	//!
+	CigiParallelDecoder( CigiIncomingMsg &serialMessage, int numThreads );
+
+	//=========================================================
+	//! Returns the number of worker threads
+	//!
+	int getNumThreads() const { return (int)workers.size(); }
+
+	//=========================================================
+	//! Registers a processor for a packet type that may be decoded in
+	//! parallel (see above).  PacketType is the class CCL unpacks the
+	//! packet into, which the processor casts to.  Must be called from the
+	//! kernel thread, before messages arrive.
+	//!
+	template< class PacketType >
+	void registerEventProcessor( int packetID, CigiBaseEventProcessor *processor )
+	{
+		serialMessage->RegisterEventProcessor( packetID, processor );
+		for( unsigned int i = 0; i < slots.size(); i++ )
+		{
+			Capture *capture = new TypedCapture<PacketType>( slots[i], processor );
+			slots[i]->captures.push_back( capture );
+			slots[i]->session->GetIncomingMsgMgr().RegisterEventProcessor( 
+				packetID, capture );
+		}
+
+		if( packetID >= 0 && packetID < 256 )
+			parallelSafe[packetID] = true;
+	}
+
+	//=========================================================
+	//! Returns true if the processors for a packet type were registered
+	//! with registerEventProcessor()
+	//!
+	bool isParallelSafe( int packetID ) const;
+
+	//=========================================================
+	//! Applies a message.  Exceptions from the serial packets are passed
+	//! on to the caller, once the decoded packets have been applied; those
+	//! from the worker threads are logged.
+	//! \param partitioner - must have just scanned the message
+	//! \return the number of packets decoded in parallel
+	//!
+	int apply( const CigiMessagePartitioner &partitioner,
+		unsigned char *message, int length );
+
+protected:
+
+	virtual ~CigiParallelDecoder();
+
+	struct Slot;
+
+	//=========================================================
+	//! Keeps the packets of one type that a slot's session decodes, until
+	//! they are applied.  The copies are reused from message to message.
+	//!
+	class Capture : public CigiBaseEventProcessor
+	{
+	public:
+		Capture( Slot *_slot, CigiBaseEventProcessor *_processor ) :
+			slot( _slot ), processor( _processor ), used( 0 ) {}
+		virtual ~Capture() {}
+
+		//! Passes the index'th packet kept to the processor
+		virtual void apply( int index ) = 0;
+
+		void reset() { used = 0; }
+
+	protected:
+		Slot *slot;
+		CigiBaseEventProcessor *processor;
+		int used;
+	};
+
+	template< class PacketType >
+	class TypedCapture : public Capture
+	{
+	public:
+		TypedCapture( Slot *_slot, CigiBaseEventProcessor *_processor ) :
+			Capture( _slot, _processor ) {}
+
+		virtual void OnPacketReceived( CigiBasePacket *packet )
+		{
+			if( used == (int)packets.size() )
+				packets.push_back( *static_cast<PacketType *>( packet ) );
+			else
+				packets[used] = *static_cast<PacketType *>( packet );
+			slot->decoded.push_back( std::make_pair( (Capture *)this, used ) );
+			used++;
+		}
+
+		virtual void apply( int index ) { processor->OnPacketReceived( &packets[index] ); }
+
+	private:
+		std::vector< PacketType > packets;
+	};
+
+	//=========================================================
+	//! One thread's session, its share of the current message, and the 
+	//! packets it has decoded
+	//!
+	struct Slot
+	{
+		CigiIGSession *session;
+		std::vector< unsigned char > buffer;
+		int packets;
+		std::vector< Capture * > captures;
+		//! the decoded packets, in the order they were decoded
+		std::vector< std::pair< Capture *, int > > decoded;
+	};
+
+	class Worker : public OpenThreads::Thread
+	{
+	public:
+		Worker( CigiParallelDecoder *_decoder, int _index ) :
+			decoder( _decoder ), index( _index ) {}
+		virtual void run();
+
+		CigiParallelDecoder *decoder;
+		int index;
+	};
+
+	//! Unpacks a slot's share of the message
+	void decodeSlot( int index );
+
+	//! Decodes slot 0, waits for the workers, and passes every slot's 
+	//! decoded packets to their processors
+	void applyDecoded();
+
+	//! Appends a packet to a buffer
+	static void append( std::vector< unsigned char > &buffer,
+		const unsigned char *packet );
+
+	CigiIncomingMsg *serialMessage;
+
+	//! slots[0] belongs to the thread calling apply(); slots[i+1] belongs
+	//! to workers[i]
+	std::vector< Slot * > slots;
+	std::vector< Worker * > workers;
+
+	bool parallelSafe[256];
+
+	//! the packets applied serially, in message order
+	std::vector< int > serialOffsets;
+	std::vector< unsigned char > serialBuffer;
+
+	//! wakes the workers when there is a message to decode, and the thread
+	//! calling apply() when the last of them is done
+	OpenThreads::Mutex runMutex;
+	OpenThreads::Condition startCondition;
+	OpenThreads::Condition doneCondition;
+	unsigned int generation;
+	int workersRemaining;
+	bool quit;
+};
+
+}
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,254 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "CigiRecording.h"
+
+using namespace mpv;
+
+namespace
+{
+	const char recordingMagic[8] = { 'M', 'P', 'V', 'C', 'I', 'G', 'I', 'R' };
+	const unsigned int recordingVersion = 1;
+
+	//! type (1) + length (4) + timestamp (8)
+	const int recordHeaderSize = 13;
+
+	void putU32( unsigned char *p, unsigned int v )
+	{
+		for( int i = 0; i < 4; i++ )
+			p[i] = (unsigned char)( v >> ( 8 * i ) );
+	}
+
+	void putU64( unsigned char *p, unsigned long long v )
+	{
+		for( int i = 0; i < 8; i++ )
+			p[i] = (unsigned char)( v >> ( 8 * i ) );
+	}
+
+	unsigned int getU32( const unsigned char *p )
+	{
+		unsigned int v = 0;
+		for( int i = 3; i >= 0; i-- )
+			v = ( v << 8 ) | p[i];
+		return v;
+	}
+
+	unsigned long long getU64( const unsigned char *p )
+	{
+		unsigned long long v = 0;
+		for( int i = 7; i >= 0; i-- )
+			v = ( v << 8 ) | p[i];
+		return v;
+	}
+}
+
+
+// ================================================
+// cigiRecordingClock
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+#ifdef WIN32
+double mpv::cigiRecordingClock()
+{
+	LARGE_INTEGER frequency, count;
+	QueryPerformanceFrequency( &frequency );
+	QueryPerformanceCounter( &count );
+	return (double)count.QuadPart / (double)frequency.QuadPart;
+}
+#else
+double mpv::cigiRecordingClock()
+{
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+#endif
+
+
+// ================================================
+// CigiRecordWriter
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiRecordWriter::CigiRecordWriter() :
+	file( NULL ),
+	startTime( 0.0 )
+{
+}
+
+
+// ================================================
+// ~CigiRecordWriter
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiRecordWriter::~CigiRecordWriter()
+{
+	close();
+}
+
+
+// ================================================
+// open
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiRecordWriter::open( const std::string &filename )
+{
+	close();
+
+	file = fopen( filename.c_str(), "wb" );
+	if( file == NULL )
+		return false;
+
+	unsigned char header[16];
+	memcpy( header, recordingMagic, 8 );
+	putU32( header + 8, recordingVersion );
+	putU32( header + 12, 0 );
+	fwrite( header, 1, sizeof( header ), file );
+
+	startTime = cigiRecordingClock();
+	return true;
+}
+
+
+// ================================================
+// close
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiRecordWriter::close()
+{
+	if( file != NULL )
+	{
+		fclose( file );
+		file = NULL;
+	}
+}
+
+
+// ================================================
+// write
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiRecordWriter::write( CigiRecord::Type type, const unsigned char *data, int length )
+{
+	if( file == NULL )
+		return;
+	if( length < 0 || ( length > 0 && data == NULL ) )
+		return;
+
+	double elapsed = cigiRecordingClock() - startTime;
+	unsigned long long usec =
+		elapsed > 0.0 ? (unsigned long long)( elapsed * 1000000.0 ) : 0;
+
+	unsigned char header[recordHeaderSize];
+	header[0] = (unsigned char)type;
+	putU32( header + 1, (unsigned int)length );
+	putU64( header + 5, usec );
+
+	fwrite( header, 1, recordHeaderSize, file );
+	if( length > 0 )
+		fwrite( data, 1, length, file );
+}
+
+
+// ================================================
+// CigiRecordReader
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiRecordReader::CigiRecordReader() :
+	file( NULL )
+{
+}
+
+
+// ================================================
+// ~CigiRecordReader
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiRecordReader::~CigiRecordReader()
+{
+	close();
+}
+
+
+// ================================================
+// open
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiRecordReader::open( const std::string &filename )
+{
+	close();
+
+	file = fopen( filename.c_str(), "rb" );
+	if( file == NULL )
+		return false;
+
+	unsigned char header[16];
+	if( fread( header, 1, sizeof( header ), file ) != sizeof( header ) ||
+		memcmp( header, recordingMagic, 8 ) != 0 ||
+		getU32( header + 8 ) != recordingVersion )
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+
+// ================================================
+// close
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiRecordReader::close()
+{
+	if( file != NULL )
+	{
+		fclose( file );
+		file = NULL;
+	}
+}
+
+
+// ================================================
+// read
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiRecordReader::read( CigiRecord &record )
+{
+	if( file == NULL )
+		return false;
+
+	unsigned char header[recordHeaderSize];
+	if( fread( header, 1, recordHeaderSize, file ) != (size_t)recordHeaderSize )
+		return false;
+
+	unsigned int length = getU32( header + 1 );
+	if( header[0] > CigiRecord::FrameEnd || length > 0x1000000 )
+		return false;
+
+	record.type = (CigiRecord::Type)header[0];
+	record.time = (double)getU64( header + 5 ) / 1000000.0;
+	record.data.resize( length );
+	if( length > 0 && fread( &record.data[0], 1, length, file ) != length )
+		return false;
+
+	return true;
+}
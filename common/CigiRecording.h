@@ -0,0 +1,162 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_CIGI_RECORDING_H_
+#define _MPV_CIGI_RECORDING_H_
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "MPVCommonTypes.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! One entry in a CIGI recording.
+//!
+//! The file format is a 16 byte header (the magic string "MPVCIGIR",
+//! followed by a 32 bit version number and 32 reserved bits), and then a
+//! sequence of records.  Each record is a 1 byte type, a 32 bit payload
+//! length, a 64 bit timestamp in microseconds since the recording was
+//! started, and the payload.  All integers are little-endian.  Records
+//! are only ever appended, so a recording cut short by a crash can still
+//! be read up to its last complete record.
+//!
+struct MPVCMN_SPEC CigiRecord
+{
+	enum Type
+	{
+		//! a datagram received from the host
+		Incoming = 0,
+		//! a datagram sent to the host
+		Outgoing = 1,
+		//! the end of an IG frame; has no payload
+		FrameEnd = 2
+	};
+
+	Type type;
+
+	//! seconds since the recording was started
+	double time;
+
+	std::vector<unsigned char> data;
+};
+
+
+//=========================================================
+//! Appends CIGI traffic to a recording file.  Writes are buffered by
+//! stdio; nothing here blocks on the network or allocates per datagram.
+//!
+class MPVCMN_SPEC CigiRecordWriter
+{
+public:
+
+	CigiRecordWriter();
+	~CigiRecordWriter();
+
+	//=========================================================
+	//! Creates (or truncates) the recording file and writes its header.
+	//! The recording clock starts now.
+	//! \return false if the file could not be opened
+	//!
+	bool open( const std::string &filename );
+
+	//=========================================================
+	//! Flushes and closes the file
+	//!
+	void close();
+
+	bool isOpen() const { return file != NULL; }
+
+	//=========================================================
+	//! Appends a record, timestamped with the current time
+	//! \param type - what kind of record this is
+	//! \param data - the datagram; may be NULL if length is 0
+	//! \param length - the datagram's size in bytes
+	//!
+	void write( CigiRecord::Type type, const unsigned char *data, int length );
+
+private:
+
+	FILE *file;
+	double startTime;
+};
+
+
+//=========================================================
+//! Reads a recording written by CigiRecordWriter, one record at a time.
+//!
+class MPVCMN_SPEC CigiRecordReader
+{
+public:
+
+	CigiRecordReader();
+	~CigiRecordReader();
+
+	//=========================================================
+	//! Opens a recording and checks its header
+	//! \return false if the file could not be opened, or isn't a
+	//!         recording of a version this reader understands
+	//!
+	bool open( const std::string &filename );
+
+	void close();
+
+	bool isOpen() const { return file != NULL; }
+
+	//=========================================================
+	//! Reads the next record.  The record's data vector is reused, so
+	//! passing the same record in each time avoids reallocation.
+	//! \return false at the end of the recording, or at a truncated record
+	//!
+	bool read( CigiRecord &record );
+
+private:
+
+	FILE *file;
+};
+
+
+//=========================================================
+//! Returns a monotonically increasing time in seconds, for timestamping
+//! and pacing recordings.  Also the clock for other timings that cross 
+//! threads, such as FrameHandoff's write start times.
+//!
+MPVCMN_SPEC double cigiRecordingClock();
+
+}
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,302 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <string.h>
+
+#include "Log.h"
+#include "MemoryFence.h"
+#include "CigiRingBuffer.h"
+
+using namespace mpv;
+
+namespace
+{
+	//! length word written where a message would have straddled the end
+	//! of the ring; the consumer skips to the start
+	const unsigned int wrapMarker = 0xffffffffu;
+
+	//! space taken in the ring by a message: a length word, and the
+	//! payload padded to 4 bytes so that length words stay aligned
+	inline unsigned int slotSize( int length )
+	{
+		return 4 + ( ( (unsigned int)length + 3 ) & ~3u );
+	}
+}
+
+
+// ================================================
+// format
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiRingBuffer::format( void *memory, int capacity )
+{
+	if( memory == NULL || capacity < 256 || ( capacity & ( capacity - 1 ) ) != 0 )
+		return false;
+
+	Header *h = (Header *)memory;
+	memset( h, 0, sizeof( Header ) );
+	h->capacity = capacity;
+	memoryFence();
+	return true;
+}
+
+
+// ================================================
+// CigiRingBuffer
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiRingBuffer::CigiRingBuffer() :
+	header( NULL ),
+	data( NULL ),
+	capacity( 0 ),
+	mask( 0 ),
+	reservedSkip( 0 ),
+	peekedSize( 0 )
+{
+}
+
+
+// ================================================
+// attach
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiRingBuffer::attach( void *memory )
+{
+	header = (Header *)memory;
+	data = (unsigned char *)memory + sizeof( Header );
+	capacity = header->capacity;
+	mask = capacity - 1;
+	reservedSkip = 0;
+	peekedSize = 0;
+}
+
+
+// ================================================
+// detach
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiRingBuffer::detach()
+{
+	header = NULL;
+	data = NULL;
+	capacity = 0;
+	mask = 0;
+	reservedSkip = 0;
+	peekedSize = 0;
+}
+
+
+// ================================================
+// corrupted
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiRingBuffer::corrupted( const char *what )
+{
+	MPV_LOG_ERROR( "CigiRingBuffer - the ring is corrupt (" << what 
+		<< "); detaching from it" );
+	detach();
+}
+
+
+// ================================================
+// getMaxMessageSize
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiRingBuffer::getMaxMessageSize() const
+{
+	// a message may have to skip up to its own size at the end of the
+	// ring, so anything over half the capacity could never fit
+	return capacity / 2 - 4;
+}
+
+
+// ================================================
+// reserve
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+unsigned char *CigiRingBuffer::reserve( int length )
+{
+	if( header == NULL || length < 0 || length > getMaxMessageSize() )
+		return NULL;
+
+	unsigned int need = slotSize( length );
+	unsigned int head = header->head;
+	memoryFence();
+	unsigned int tail = header->tail;
+	// don't let writes to the slot move ahead of the read of tail
+	memoryFence();
+
+	// the consumer owns tail; if it has run past head, or further behind 
+	// than the ring holds, the space can't be worked out
+	if( head - tail > capacity )
+	{
+		corrupted( "tail is outside the ring" );
+		return NULL;
+	}
+
+	unsigned int space = capacity - ( head - tail );
+	unsigned int offset = head & mask;
+	unsigned int contiguous = capacity - offset;
+
+	reservedSkip = 0;
+	if( need > contiguous )
+	{
+		// the message goes at the start of the ring
+		if( space < contiguous + need )
+			return NULL;
+		reservedSkip = contiguous;
+		offset = 0;
+	}
+	else if( space < need )
+	{
+		return NULL;
+	}
+
+	return data + offset + 4;
+}
+
+
+// ================================================
+// commit
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiRingBuffer::commit( int length )
+{
+	if( header == NULL )
+		return;
+
+	unsigned int head = header->head;
+	if( reservedSkip > 0 )
+		*(unsigned int *)( data + ( head & mask ) ) = wrapMarker;
+
+	unsigned int offset = ( head + reservedSkip ) & mask;
+	*(unsigned int *)( data + offset ) = (unsigned int)length;
+
+	// the message must be complete before the consumer can see it
+	memoryFence();
+	header->head = head + reservedSkip + slotSize( length );
+	reservedSkip = 0;
+}
+
+
+// ================================================
+// write
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiRingBuffer::write( const unsigned char *message, int length )
+{
+	unsigned char *slot = reserve( length );
+	if( slot == NULL )
+		return false;
+	if( length > 0 )
+		memcpy( slot, message, length );
+	commit( length );
+	return true;
+}
+
+
+// ================================================
+// peek
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const unsigned char *CigiRingBuffer::peek( int &length )
+{
+	if( header == NULL )
+		return NULL;
+
+	while( true )
+	{
+		unsigned int tail = header->tail;
+		memoryFence();
+		unsigned int head = header->head;
+		// don't let reads of the message move ahead of the read of head
+		memoryFence();
+
+		if( head == tail )
+			return NULL;
+
+		// Everything below comes from the producer, which may be another
+		// process; none of it may send the read outside the ring, or tail
+		// past head
+		unsigned int used = head - tail;
+		if( used > capacity || ( used & 3 ) != 0 || ( tail & 3 ) != 0 )
+		{
+			corrupted( "head is outside the ring" );
+			return NULL;
+		}
+
+		unsigned int offset = tail & mask;
+		unsigned int word = *(const unsigned int *)( data + offset );
+		if( word == wrapMarker )
+		{
+			// a message must follow the skipped bytes
+			unsigned int skip = capacity - offset;
+			if( skip >= used )
+			{
+				corrupted( "bad wrap marker" );
+				return NULL;
+			}
+			header->tail = tail + skip;
+			continue;
+		}
+
+		if( word > capacity - offset - 4 || slotSize( word ) > used )
+		{
+			corrupted( "bad message length" );
+			return NULL;
+		}
+
+		peekedSize = slotSize( word );
+		length = (int)word;
+		return data + offset + 4;
+	}
+}
+
+
+// ================================================
+// release
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiRingBuffer::release()
+{
+	if( header == NULL || peekedSize == 0 )
+		return;
+
+	// finish reading the message before the producer can overwrite it
+	memoryFence();
+	header->tail = header->tail + peekedSize;
+	peekedSize = 0;
+}
+
+
+// ================================================
+// read
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiRingBuffer::read( unsigned char *buffer, int bufferSize )
+{
+	int length = 0;
+	const unsigned char *message = peek( length );
+	if( message == NULL )
+		return 0;
+
+	if( length > bufferSize )
+	{
+		release();
+		return -1;
+	}
+
+	memcpy( buffer, message, length );
+	release();
+	return length;
+}
@@ -0,0 +1,159 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_CIGI_RING_BUFFER_H_
+#define _MPV_CIGI_RING_BUFFER_H_
+
+#include "MPVCommonTypes.h"
+
+namespace mpv
+{
+
+//=========================================================
+//! A single-producer, single-consumer queue of variable-length messages,
+//! laid out in a caller-supplied block of memory.  The block may be
+//! ordinary heap memory (for a host and IG in the same process) or a
+//! shared memory segment (for a host in another process on the same
+//! machine); the ring keeps no pointers in the block, only offsets.
+//!
+//! Messages are stored contiguously, so the consumer can process them in
+//! place with peek()/release(), and the producer can build them in place
+//! with reserve()/commit().  Neither side takes a lock or makes a system
+//! call.
+//!
+class MPVCMN_SPEC CigiRingBuffer
+{
+public:
+
+	//=========================================================
+	//! The control block at the start of the ring's memory.  head is
+	//! written only by the producer and tail only by the consumer; they
+	//! are on separate cache lines so that the two sides don't contend.
+	//! Both count bytes since the ring was formatted, and wrap at 2^32.
+	//!
+	struct Header
+	{
+		volatile unsigned int head;
+		char padHead[60];
+		volatile unsigned int tail;
+		char padTail[60];
+		unsigned int capacity;
+		char padCapacity[60];
+	};
+
+	//=========================================================
+	//! Returns the number of bytes of memory needed for a ring with the
+	//! given capacity
+	//!
+	static int getRequiredSize( int capacity ) { return sizeof( Header ) + capacity; }
+
+	//=========================================================
+	//! Initializes a block of memory as an empty ring.  Only one side
+	//! should do this, before either side attaches.
+	//! \param memory - at least getRequiredSize( capacity ) bytes
+	//! \param capacity - a power of two, no smaller than 256
+	//! \return false if the capacity is unusable
+	//!
+	static bool format( void *memory, int capacity );
+
+	CigiRingBuffer();
+
+	//=========================================================
+	//! Points this object at a ring that has already been formatted
+	//!
+	void attach( void *memory );
+
+	void detach();
+
+	bool isAttached() const { return header != 0; }
+
+	//=========================================================
+	//! Returns the largest message that the ring will accept
+	//!
+	int getMaxMessageSize() const;
+
+	//==> Producer side
+
+	//=========================================================
+	//! Returns space for a message of the given length, or NULL if the
+	//! ring doesn't currently have room for it.  The message is not
+	//! visible to the consumer until commit() is called.
+	//!
+	unsigned char *reserve( int length );
+
+	//=========================================================
+	//! Publishes the message most recently reserved
+	//!
+	void commit( int length );
+
+	//=========================================================
+	//! Copies a message into the ring
+	//! \return false if there wasn't room
+	//!
+	bool write( const unsigned char *message, int length );
+
+	//==> Consumer side
+
+	//=========================================================
+	//! Returns the oldest message in the ring, in place, or NULL if the
+	//! ring is empty.  The message stays valid until release() is called.
+	//! If the producer has left the ring in a state it could not have
+	//! reached by itself, the error is logged, the ring is detached, and
+	//! NULL is returned; reserve() does the same for the consumer's side.
+	//!
+	const unsigned char *peek( int &length );
+
+	//=========================================================
+	//! Removes the message returned by the last call to peek()
+	//!
+	void release();
+
+	//=========================================================
+	//! Copies the oldest message out of the ring and removes it
+	//! \return the message length, 0 if the ring is empty, or -1 if the
+	//!         message didn't fit in the buffer (it is dropped)
+	//!
+	int read( unsigned char *buffer, int bufferSize );
+
+private:
+
+	//! Logs that the other side has damaged the ring, and detaches from it
+	void corrupted( const char *what );
+
+	Header *header;
+	unsigned char *data;
+	unsigned int capacity;
+	unsigned int mask;
+
+	//! producer: bytes at the end of the ring skipped by the reserved message
+	unsigned int reservedSkip;
+
+	//! consumer: size in the ring of the message returned by peek()
+	unsigned int peekedSize;
+};
+
+}
+
+#endif
@@ -0,0 +1,63 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <OpenThreads/Thread>
+
+#include "CigiTransport.h"
+
+using namespace mpv;
+
+
+// ================================================
+// recvBlock
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiTransport::recvBlock( unsigned char *buffer, int bufferSize )
+{
+	// transports without a way to wait on the other side poll
+	while( isOpen() )
+	{
+		int length = recv( buffer, bufferSize );
+		if( length > 0 )
+			return length;
+		OpenThreads::Thread::YieldCurrentThread();
+	}
+	return -1;
+}
+
+
+// ================================================
+// sendMany
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiTransport::sendMany( const unsigned char * const *messages,
+	const int *lengths, int count )
+{
+	int sent = 0;
+	for( ; sent < count; sent++ )
+	{
+		if( send( messages[sent], lengths[sent] ) < 0 )
+			return sent > 0 ? sent : -1;
+	}
+	return sent;
+}
@@ -0,0 +1,99 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_CIGI_TRANSPORT_H_
+#define _MPV_CIGI_TRANSPORT_H_
+
+#include "MPVCommonTypes.h"
+
+namespace mpv
+{
+
+//=========================================================
+//! A bidirectional channel for CIGI messages between a host and an IG.
+//! Each call to send() delivers one message, and each successful call to
+//! recv() returns one whole message, as with UDP datagrams.
+//!
+//! Transports that keep messages in memory the receiver can read
+//! directly also support peek()/release(), which hand out the message in
+//! place instead of copying it.
+//!
+class MPVCMN_SPEC CigiTransport
+{
+public:
+
+	virtual ~CigiTransport() {}
+
+	virtual bool isOpen() const = 0;
+
+	virtual void close() = 0;
+
+	//=========================================================
+	//! Sends a message
+	//! \return the number of bytes sent, or -1 on error
+	//!
+	virtual int send( const unsigned char *message, int length ) = 0;
+
+	//=========================================================
+	//! Sends several messages, each delivered separately.  Transports that
+	//! can hand them all to the system at once override this; the default
+	//! calls send() for each.
+	//! \return the number of messages sent, or -1 on error
+	//!
+	virtual int sendMany( const unsigned char * const *messages,
+		const int *lengths, int count );
+
+	//=========================================================
+	//! Receives a message, if one is waiting
+	//! \return the message length, 0 or -1 if no message was waiting
+	//!
+	virtual int recv( unsigned char *buffer, int bufferSize ) = 0;
+
+	//=========================================================
+	//! Receives a message, waiting for one if necessary
+	//! \return the message length, or -1 on error
+	//!
+	virtual int recvBlock( unsigned char *buffer, int bufferSize );
+
+	//=========================================================
+	//! Returns true if peek() and release() are supported
+	//!
+	virtual bool canPeek() const { return false; }
+
+	//=========================================================
+	//! Returns the next message without copying it, or NULL if none is
+	//! waiting.  The message stays valid until release() is called.
+	//!
+	virtual const unsigned char *peek( int &length ) { return 0; }
+
+	//=========================================================
+	//! Discards the message returned by peek()
+	//!
+	virtual void release() {}
+};
+
+}
+
+#endif
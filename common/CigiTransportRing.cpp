@@ -0,0 +1,276 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "MemoryFence.h"
+#include "CigiTransportRing.h"
+
+using namespace mpv;
+
+namespace
+{
+	const char segmentMagic[8] = { 'M', 'P', 'V', 'C', 'R', 'I', 'N', 'G' };
+	const unsigned int segmentVersion = 1;
+
+	//! The start of a segment.  The host-to-IG ring follows it, then the
+	//! IG-to-host ring.
+	struct SegmentHeader
+	{
+		char magic[8];
+		unsigned int version;
+		unsigned int capacity;
+		volatile unsigned int ready;
+		char pad[44];
+	};
+
+	//! capacities stop at 2^29, so that a segment's size fits in an int
+	int roundUpCapacity( int capacity )
+	{
+		int rounded = 256;
+		while( rounded < capacity && rounded < ( 1 << 29 ) )
+			rounded *= 2;
+		return rounded;
+	}
+
+	bool isValidCapacity( unsigned int capacity )
+	{
+		return capacity >= 256 && capacity <= ( 1u << 29 ) && 
+			( capacity & ( capacity - 1 ) ) == 0;
+	}
+}
+
+
+// ================================================
+// HeapSegment
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiTransportRing::HeapSegment::HeapSegment( int size ) : Referenced()
+{
+	memory = calloc( 1, size );
+}
+
+
+// ================================================
+// ~HeapSegment
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiTransportRing::HeapSegment::~HeapSegment()
+{
+	free( memory );
+}
+
+
+// ================================================
+// createInProcessPair
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiTransportRing::createInProcessPair( int capacity, 
+	CigiTransportRing *&igEnd, CigiTransportRing *&hostEnd )
+{
+	capacity = roundUpCapacity( capacity );
+	RefPtr<HeapSegment> segment = new HeapSegment( getSegmentSize( capacity ) );
+	formatSegment( segment->memory, capacity );
+
+	igEnd = new CigiTransportRing();
+	igEnd->heapSegment = segment;
+	igEnd->attachSegment( segment->memory, getSegmentSize( capacity ), IGSide );
+
+	hostEnd = new CigiTransportRing();
+	hostEnd->heapSegment = segment;
+	hostEnd->attachSegment( segment->memory, getSegmentSize( capacity ), HostSide );
+}
+
+
+// ================================================
+// CigiTransportRing
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiTransportRing::CigiTransportRing()
+{
+}
+
+
+// ================================================
+// ~CigiTransportRing
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiTransportRing::~CigiTransportRing()
+{
+	close();
+}
+
+
+// ================================================
+// getSegmentSize
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiTransportRing::getSegmentSize( int capacity )
+{
+	return sizeof( SegmentHeader ) + 2 * CigiRingBuffer::getRequiredSize( capacity );
+}
+
+
+// ================================================
+// formatSegment
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiTransportRing::formatSegment( void *memory, int capacity )
+{
+	SegmentHeader *header = (SegmentHeader *)memory;
+	unsigned char *rings = (unsigned char *)memory + sizeof( SegmentHeader );
+
+	header->ready = 0;
+	memoryFence();
+
+	memcpy( header->magic, segmentMagic, sizeof( segmentMagic ) );
+	header->version = segmentVersion;
+	header->capacity = capacity;
+	CigiRingBuffer::format( rings, capacity );
+	CigiRingBuffer::format( rings + CigiRingBuffer::getRequiredSize( capacity ), capacity );
+
+	memoryFence();
+	header->ready = 1;
+}
+
+
+// ================================================
+// attachSegment
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiTransportRing::attachSegment( void *memory, int size, Side side )
+{
+	if( memory == NULL || size < (int)sizeof( SegmentHeader ) )
+		return false;
+
+	SegmentHeader *header = (SegmentHeader *)memory;
+	if( !header->ready )
+		return false;
+	memoryFence();
+	if( memcmp( header->magic, segmentMagic, sizeof( segmentMagic ) ) != 0 || 
+		header->version != segmentVersion )
+		return false;
+
+	// A stale segment, or one made by something else, mustn't send the 
+	// rings outside the mapping
+	unsigned int capacity = header->capacity;
+	if( !isValidCapacity( capacity ) )
+		return false;
+	long long ringSize = (long long)sizeof( CigiRingBuffer::Header ) + capacity;
+	if( (long long)size < (long long)sizeof( SegmentHeader ) + 2 * ringSize )
+		return false;
+
+	unsigned char *toIG = (unsigned char *)memory + sizeof( SegmentHeader );
+	unsigned char *toHost = toIG + ringSize;
+
+	// each ring keeps its own copy of the capacity, which attach() uses
+	if( ( (CigiRingBuffer::Header *)toIG )->capacity != capacity || 
+		( (CigiRingBuffer::Header *)toHost )->capacity != capacity )
+		return false;
+
+	if( side == IGSide )
+	{
+		inbound.attach( toIG );
+		outbound.attach( toHost );
+	}
+	else
+	{
+		inbound.attach( toHost );
+		outbound.attach( toIG );
+	}
+	return true;
+}
+
+
+// ================================================
+// openSharedMemory
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiTransportRing::openSharedMemory( const std::string &name, int capacity, Side side )
+{
+	close();
+
+	if( side == IGSide )
+	{
+		capacity = roundUpCapacity( capacity );
+		if( !sharedSegment.create( name, getSegmentSize( capacity ) ) )
+			return false;
+		formatSegment( sharedSegment.getMemory(), capacity );
+	}
+	else
+	{
+		if( !sharedSegment.open( name ) )
+			return false;
+	}
+
+	if( !attachSegment( sharedSegment.getMemory(), sharedSegment.getSize(), side ) )
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+
+// ================================================
+// close
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiTransportRing::close()
+{
+	inbound.detach();
+	outbound.detach();
+	heapSegment = NULL;
+	sharedSegment.close();
+}
+
+
+// ================================================
+// send
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiTransportRing::send( const unsigned char *message, int length )
+{
+	if( !outbound.write( message, length ) )
+		return -1;
+	return length;
+}
+
+
+// ================================================
+// recv
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiTransportRing::recv( unsigned char *buffer, int bufferSize )
+{
+	return inbound.read( buffer, bufferSize );
+}
+
+
+// ================================================
+// peek
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const unsigned char *CigiTransportRing::peek( int &length )
+{
+	return inbound.peek( length );
+}
+
+
+// ================================================
+// release
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiTransportRing::release()
+{
+	inbound.release();
+}
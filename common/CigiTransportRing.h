@@ -0,0 +1,136 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_CIGI_TRANSPORT_RING_H_
+#define _MPV_CIGI_TRANSPORT_RING_H_
+
+#include <string>
+
+#include "CigiTransport.h"
+#include "CigiRingBuffer.h"
+#include "Referenced.h"
+#include "SharedMemorySegment.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! CIGI through a pair of CigiRingBuffers in memory, one for each
+//! direction.  Used for a host in the same process as the IG (an
+//! in-process pair), or for a host in another process on the same
+//! machine (a named shared memory segment).  Messages are exchanged
+//! with a single memcpy on the sending side, none on the receiving side
+//! (see peek()), and no system calls.
+//!
+//! When the receiving ring is full, send() fails and the message is
+//! dropped, as it would be by a full UDP socket buffer.
+//!
+class MPVCMN_SPEC CigiTransportRing : public CigiTransport
+{
+public:
+
+	enum Side
+	{
+		//! receives what the host sends, and sends to the host
+		IGSide,
+		//! receives what the IG sends, and sends to the IG
+		HostSide
+	};
+
+	//=========================================================
+	//! Creates two connected transports, sharing heap memory
+	//! \param capacity - bytes per direction; rounded up to a power of 2
+	//! \param igEnd - set to the IG's end; caller takes ownership
+	//! \param hostEnd - set to the host's end; caller takes ownership
+	//!
+	static void createInProcessPair( int capacity, 
+		CigiTransportRing *&igEnd, CigiTransportRing *&hostEnd );
+
+	CigiTransportRing();
+	virtual ~CigiTransportRing();
+
+	//=========================================================
+	//! Opens a transport in a named shared memory segment.  The IG side
+	//! creates the segment (replacing any stale one with the same name);
+	//! the host side attaches to it, and fails if the IG hasn't created
+	//! it yet.
+	//! \param name - the segment name, eg "/mpv_cigi"
+	//! \param capacity - bytes per direction; used only by the IG side
+	//! \param side - which end of the connection this is
+	//!
+	bool openSharedMemory( const std::string &name, int capacity, Side side );
+
+	virtual bool isOpen() const { return inbound.isAttached(); }
+	virtual void close();
+
+	virtual int send( const unsigned char *message, int length );
+	virtual int recv( unsigned char *buffer, int bufferSize );
+
+	virtual bool canPeek() const { return true; }
+	virtual const unsigned char *peek( int &length );
+	virtual void release();
+
+private:
+
+	//! Returns the size of a segment holding two rings of the given capacity
+	static int getSegmentSize( int capacity );
+
+	//! Lays out an empty segment
+	static void formatSegment( void *memory, int capacity );
+
+	//! Attaches the rings in a formatted segment of size bytes; returns
+	//! false if the segment isn't valid, or its rings don't fit in it
+	bool attachSegment( void *memory, int size, Side side );
+
+	//! Heap memory for an in-process pair, shared by both ends
+	class HeapSegment : public Referenced
+	{
+	public:
+		HeapSegment( int size );
+		void *memory;
+	protected:
+		virtual ~HeapSegment();
+	};
+
+	CigiRingBuffer inbound;
+	CigiRingBuffer outbound;
+
+	RefPtr<HeapSegment> heapSegment;
+
+	SharedMemorySegment sharedSegment;
+};
+
+}
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif
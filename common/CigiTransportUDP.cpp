@@ -0,0 +1,104 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include "CigiTransportUDP.h"
+
+using namespace mpv;
+
+
+// ================================================
+// CigiTransportUDP
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiTransportUDP::CigiTransportUDP() :
+	opened( false )
+{
+}
+
+
+// ================================================
+// ~CigiTransportUDP
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiTransportUDP::~CigiTransportUDP()
+{
+	close();
+}
+
+
+// ================================================
+// open
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiTransportUDP::open( const char *ip, int sendPort, int recvPort )
+{
+	opened = network.openSocket( ip, sendPort, recvPort );
+	return opened;
+}
+
+
+// ================================================
+// close
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiTransportUDP::close()
+{
+	network.closeSocket();
+	opened = false;
+}
+
+
+// ================================================
+// send
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiTransportUDP::send( const unsigned char *message, int length )
+{
+	return network.send( const_cast<unsigned char *>( message ), length );
+}
+
+
+// ================================================
+// sendMany
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiTransportUDP::sendMany( const unsigned char * const *messages,
+	const int *lengths, int count )
+{
+	return network.sendMany( const_cast<unsigned char * const *>( messages ),
+		lengths, count );
+}
+
+
+// ================================================
+// recv
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiTransportUDP::recv( unsigned char *buffer, int bufferSize )
+{
+	return network.recv( buffer, bufferSize );
+}
+
+
+// ================================================
+// recvBlock
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiTransportUDP::recvBlock( unsigned char *buffer, int bufferSize )
+{
+	return network.recvBlock( buffer, bufferSize );
+}
@@ -0,0 +1,72 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_CIGI_TRANSPORT_UDP_H_
+#define _MPV_CIGI_TRANSPORT_UDP_H_
+
+#include "Network.h"  // network includes winsock2.h which must be included before windows.h
+
+#include "CigiTransport.h"
+
+namespace mpv
+{
+
+//=========================================================
+//! CIGI over UDP, using the Network class
+//!
+class MPVCMN_SPEC CigiTransportUDP : public CigiTransport
+{
+public:
+
+	CigiTransportUDP();
+	virtual ~CigiTransportUDP();
+
+	//=========================================================
+	//! Opens the sockets
+	//! \param ip - the address to send to
+	//! \param sendPort - the port to send to
+	//! \param recvPort - the local port to receive on
+	//! \return false if the sockets could not be opened
+	//!
+	bool open( const char *ip, int sendPort, int recvPort );
+
+	virtual bool isOpen() const { return opened; }
+	virtual void close();
+
+	virtual int send( const unsigned char *message, int length );
+	virtual int sendMany( const unsigned char * const *messages,
+		const int *lengths, int count );
+	virtual int recv( unsigned char *buffer, int bufferSize );
+	virtual int recvBlock( unsigned char *buffer, int bufferSize );
+
+private:
+
+	Network network;
+	bool opened;
+};
+
+}
+
+#endif
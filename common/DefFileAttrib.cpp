@@ -31,6 +31,9 @@
  *  
  *  03/29/2004 Andrew Sampson                       MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Attribute names are interned.
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -44,12 +47,16 @@
 #endif
 
 #include "DefFileAttrib.h"
+#include "DefFileGroup.h"
+#include "DefFileName.h"
 
 // ================================================
 // DefFileAttrib
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 DefFileAttrib::DefFileAttrib()
 {
+	nameID_ = DefFileName::intern( name_ );
+	group_ = NULL;
 	type_ = ATTRIB_INT;
 	setInt( 0 );
 }
@@ -68,6 +75,11 @@ DefFileAttrib::~DefFileAttrib()
 void DefFileAttrib::setName( const std::string &name )
 {
 	name_ = name;
+	nameID_ = DefFileName::intern( name );
+	
+	// as DefFileGroup::setName does for its parent
+	if( group_ != NULL )
+		group_->indexValid_ = false;
 }
 
 // ================================================
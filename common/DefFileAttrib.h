@@ -31,6 +31,10 @@
  *  
  *  03/29/2004 Andrew Sampson                       MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Added getListItems(), for DefFileCache, and the interned name ID.
+ *      Renaming an attribute invalidates its group's index.
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -45,6 +49,8 @@
 
 #include "MPVCommonTypes.h"
 
+class DefFileGroup;
+
 #if defined(_MSC_VER)
    #pragma warning(push)
    #pragma warning(disable : 4251)
@@ -84,7 +90,9 @@ public:
 
 	//============================================
 	//! Method to set the name of this attribute.  Unless this method is 
-	//! called, the attribute's name defaults to an empty string.
+	//! called, the attribute's name defaults to an empty string.  If the 
+	//! attribute is in a group, the group's index is rebuilt on its next 
+	//! lookup.
 	//! \param name - The new name for this attribute
 	//!
 	void setName( const std::string &name );
@@ -95,6 +103,11 @@ public:
 	//!
 	const std::string & getName() const;
 	
+	//============================================
+	//! Gets the interned ID of this attribute's name (see DefFileName).
+	//!
+	int getNameID() const { return nameID_; }
+	
 	//============================================
 	//! Gets this attribute's type.
 	//! \return The attribute's type, corresponding to one of the values in the DefFileAttribType enum.
@@ -181,6 +194,13 @@ public:
 	//!
 	std::vector<int> asInts() const;
 	
+	//============================================
+	//! Returns the items of a "list" attribute.  The list is empty if the 
+	//! attribute is not a list.
+	//! \return The attribute's list items
+	//!
+	const std::list< DefFileAttrib* > &getListItems() const { return list_; }
+	
 	//============================================
 	//! Prints the contents of this attribute.
 	//! \param fp - The file pointer to send the output to (defaults to stdout)
@@ -195,6 +215,19 @@ private:
 	//!
 	std::string name_;
 
+	//=========================================================
+	//! The interned ID of the attribute's name
+	//!
+	int nameID_;
+
+	//=========================================================
+	//! The group this attribute was added to, if any; setName() 
+	//! invalidates its index
+	//!
+	DefFileGroup *group_;
+
+	friend class DefFileGroup;
+
 	//=========================================================
 	//! The attribute's value type
 	//!
@@ -0,0 +1,570 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <map>
+#include <vector>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "Log.h"
+
+#include "DefFileCache.h"
+
+
+namespace
+{
+
+const char cacheMagic[8] = { 'M', 'P', 'V', 'D', 'E', 'F', 'C', '\0' };
+
+//! bump this when the format, or the parser's output, changes
+const unsigned int cacheVersion = 1;
+
+//! written in native byte order; a cache from a machine of the other
+//! byte order doesn't match, and is rewritten
+const unsigned int cacheByteOrder = 0x01020304;
+
+//! larger trees are taken to be damaged caches
+const int maxDepth = 256;
+
+
+//=========================================================
+//! The size and modification time of a def file.  A size that doesn't 
+//! match rules a cache out without hashing; the time is only recorded.
+//!
+struct SourceInfo
+{
+	unsigned long long size;
+	long long mtime;
+};
+
+
+bool getSourceInfo( const std::string &filename, SourceInfo &info )
+{
+	struct stat st;
+	if( stat( filename.c_str(), &st ) != 0 )
+		return false;
+	info.size = (unsigned long long)st.st_size;
+	info.mtime = (long long)st.st_mtime;
+	return true;
+}
+
+
+//=========================================================
+//! FNV-1a, over the whole def file.  Computed whenever a cache is read
+//! or written; it's a single pass over a file that is small next to
+//! the work of parsing it.
+//!
+bool hashSource( const std::string &filename, unsigned int &hash )
+{
+	FILE *fp = fopen( filename.c_str(), "rb" );
+	if( fp == NULL )
+		return false;
+
+	hash = 2166136261u;
+	unsigned char buffer[8192];
+	size_t count;
+	while( ( count = fread( buffer, 1, sizeof( buffer ), fp ) ) > 0 )
+	{
+		for( size_t i = 0; i < count; i++ )
+		{
+			hash ^= buffer[i];
+			hash *= 16777619u;
+		}
+	}
+
+	fclose( fp );
+	return true;
+}
+
+
+//=========================================================
+//! Builds the cache in memory.  Names and string values are interned as
+//! the tree is written; the string table goes ahead of the tree in the
+//! file.
+//!
+class CacheWriter
+{
+public:
+	void putU8( unsigned char value )
+	{
+		body.push_back( (char)value );
+	}
+
+	void putU32( unsigned int value )
+	{
+		put( body, &value, sizeof( value ) );
+	}
+
+	void putString( const std::string &value )
+	{
+		std::map< std::string, unsigned int >::iterator iter = stringIndices.find( value );
+		if( iter != stringIndices.end() )
+		{
+			putU32( iter->second );
+			return;
+		}
+
+		unsigned int index = (unsigned int)strings.size();
+		stringIndices[value] = index;
+		strings.push_back( value );
+		putU32( index );
+	}
+
+	void putAttribute( const DefFileAttrib *attr )
+	{
+		putString( attr->getName() );
+		putU8( (unsigned char)attr->getType() );
+		switch( attr->getType() )
+		{
+		case ATTRIB_INT:
+			{
+			int value = attr->asInt();
+			put( body, &value, sizeof( value ) );
+			}
+			break;
+		case ATTRIB_FLOAT:
+			{
+			float value = attr->asFloat();
+			put( body, &value, sizeof( value ) );
+			}
+			break;
+		case ATTRIB_LIST:
+			{
+			const std::list< DefFileAttrib * > &items = attr->getListItems();
+			putU32( (unsigned int)items.size() );
+			std::list< DefFileAttrib * >::const_iterator iter;
+			for( iter = items.begin(); iter != items.end(); iter++ )
+				putAttribute( *iter );
+			}
+			break;
+		default:
+			putString( attr->asString() );
+			break;
+		}
+	}
+
+	void putGroup( const DefFileGroup *group )
+	{
+		putString( group->getName() );
+
+		putU32( (unsigned int)group->attributes.size() );
+		std::list< DefFileAttrib * >::const_iterator attrIter;
+		for( attrIter = group->attributes.begin(); attrIter != group->attributes.end(); attrIter++ )
+			putAttribute( *attrIter );
+
+		putU32( (unsigned int)group->children.size() );
+		std::list< DefFileGroup * >::const_iterator childIter;
+		for( childIter = group->children.begin(); childIter != group->children.end(); childIter++ )
+			putGroup( *childIter );
+	}
+
+	//! the string table, then the tree
+	void finish( std::vector<char> &out )
+	{
+		unsigned int count = (unsigned int)strings.size();
+		put( out, &count, sizeof( count ) );
+		for( unsigned int i = 0; i < strings.size(); i++ )
+		{
+			unsigned int length = (unsigned int)strings[i].size();
+			put( out, &length, sizeof( length ) );
+			put( out, strings[i].data(), length );
+		}
+		out.insert( out.end(), body.begin(), body.end() );
+	}
+
+	static void put( std::vector<char> &out, const void *data, size_t size )
+	{
+		const char *bytes = (const char *)data;
+		out.insert( out.end(), bytes, bytes + size );
+	}
+
+private:
+	std::vector<char> body;
+	std::vector<std::string> strings;
+	std::map< std::string, unsigned int > stringIndices;
+};
+
+
+//=========================================================
+//! Reads the cache from memory.  Every read is bounds-checked; a cache
+//! that runs short, or refers to a string that isn't in the table, is
+//! taken to be damaged.
+//!
+class CacheReader
+{
+public:
+	CacheReader( const char *data, size_t size ) :
+		pos( data ), end( data + size ), ok( true )
+	{
+	}
+
+	bool isOK() const { return ok; }
+
+	bool get( void *out, size_t size )
+	{
+		if( !ok || (size_t)( end - pos ) < size )
+		{
+			ok = false;
+			return false;
+		}
+		memcpy( out, pos, size );
+		pos += size;
+		return true;
+	}
+
+	unsigned int getU32()
+	{
+		unsigned int value = 0;
+		get( &value, sizeof( value ) );
+		return value;
+	}
+
+	unsigned char getU8()
+	{
+		unsigned char value = 0;
+		get( &value, sizeof( value ) );
+		return value;
+	}
+
+	bool readStringTable()
+	{
+		unsigned int count = getU32();
+		// each string takes at least its length field
+		if( !ok || count > (size_t)( end - pos ) / sizeof( unsigned int ) )
+			return ok = false;
+
+		strings.reserve( count );
+		for( unsigned int i = 0; i < count && ok; i++ )
+		{
+			unsigned int length = getU32();
+			if( !ok || (size_t)( end - pos ) < length )
+				return ok = false;
+			strings.push_back( std::string( pos, length ) );
+			pos += length;
+		}
+		return ok;
+	}
+
+	const std::string &getString()
+	{
+		static const std::string empty;
+		unsigned int index = getU32();
+		if( !ok || index >= strings.size() )
+		{
+			ok = false;
+			return empty;
+		}
+		return strings[index];
+	}
+
+	DefFileAttrib *getAttribute( int depth )
+	{
+		if( depth > maxDepth )
+		{
+			ok = false;
+			return NULL;
+		}
+
+		DefFileAttrib *attr = new DefFileAttrib();
+		attr->setName( getString() );
+
+		switch( getU8() )
+		{
+		case ATTRIB_INT:
+			{
+			int value = 0;
+			get( &value, sizeof( value ) );
+			attr->setInt( value );
+			}
+			break;
+		case ATTRIB_FLOAT:
+			{
+			float value = 0.f;
+			get( &value, sizeof( value ) );
+			attr->setFloat( value );
+			}
+			break;
+		case ATTRIB_STRING:
+			attr->setString( getString() );
+			break;
+		case ATTRIB_LIST:
+			{
+			unsigned int count = getU32();
+			for( unsigned int i = 0; i < count && ok; i++ )
+			{
+				DefFileAttrib *item = getAttribute( depth + 1 );
+				if( item != NULL )
+					attr->appendListItem( item );
+			}
+			}
+			break;
+		default:
+			ok = false;
+			break;
+		}
+
+		return attr;
+	}
+
+	DefFileGroup *getGroup( int depth )
+	{
+		if( depth > maxDepth )
+		{
+			ok = false;
+			return NULL;
+		}
+
+		DefFileGroup *group = new DefFileGroup();
+		group->setName( getString() );
+
+		unsigned int count = getU32();
+		for( unsigned int i = 0; i < count && ok; i++ )
+			group->addAttribute( getAttribute( depth + 1 ) );
+
+		count = getU32();
+		for( unsigned int i = 0; i < count && ok; i++ )
+			group->addChild( getGroup( depth + 1 ) );
+
+		return group;
+	}
+
+private:
+	const char *pos;
+	const char *end;
+	bool ok;
+	std::vector<std::string> strings;
+};
+
+
+//=========================================================
+//! A read-only view of a whole file; mapped where mmap is available,
+//! read into memory elsewhere
+//!
+class MappedFile
+{
+public:
+	MappedFile() : data( NULL ), size( 0 ) {}
+
+	~MappedFile()
+	{
+#ifndef WIN32
+		if( data != NULL )
+			munmap( (void *)data, size );
+#endif
+	}
+
+	bool open( const std::string &filename )
+	{
+#ifdef WIN32
+		FILE *fp = fopen( filename.c_str(), "rb" );
+		if( fp == NULL )
+			return false;
+		fseek( fp, 0, SEEK_END );
+		long length = ftell( fp );
+		fseek( fp, 0, SEEK_SET );
+		if( length <= 0 )
+		{
+			fclose( fp );
+			return false;
+		}
+		buffer.resize( length );
+		size_t count = fread( &buffer[0], 1, length, fp );
+		fclose( fp );
+		if( count != (size_t)length )
+			return false;
+		data = &buffer[0];
+		size = length;
+		return true;
+#else
+		int fd = ::open( filename.c_str(), O_RDONLY );
+		if( fd < 0 )
+			return false;
+		struct stat st;
+		if( fstat( fd, &st ) != 0 || st.st_size <= 0 )
+		{
+			::close( fd );
+			return false;
+		}
+		void *mapping = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+		// the mapping stays valid after the descriptor is closed
+		::close( fd );
+		if( mapping == MAP_FAILED )
+			return false;
+		data = (const char *)mapping;
+		size = st.st_size;
+		return true;
+#endif
+	}
+
+	const char *data;
+	size_t size;
+
+private:
+#ifdef WIN32
+	std::vector<char> buffer;
+#endif
+};
+
+}
+
+
+// ================================================
+// isEnabled
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool DefFileCache::isEnabled()
+{
+	const char *setting = getenv( "MPV_DEF_FILE_CACHE" );
+	return setting == NULL || strcmp( setting, "0" ) != 0;
+}
+
+
+// ================================================
+// getCacheFilename
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+std::string DefFileCache::getCacheFilename( const std::string &filename )
+{
+	// doesn't end in "def", so the def file reader won't try to parse it
+	return filename + ".cache";
+}
+
+
+// ================================================
+// read
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+DefFileGroup *DefFileCache::read( const std::string &filename )
+{
+	SourceInfo source;
+	if( !getSourceInfo( filename, source ) )
+		return NULL;
+
+	MappedFile file;
+	if( !file.open( getCacheFilename( filename ) ) )
+		return NULL;
+
+	CacheReader reader( file.data, file.size );
+
+	char magic[sizeof( cacheMagic )];
+	reader.get( magic, sizeof( magic ) );
+	unsigned int version = reader.getU32();
+	unsigned int byteOrder = reader.getU32();
+	SourceInfo cached;
+	reader.get( &cached.size, sizeof( cached.size ) );
+	reader.get( &cached.mtime, sizeof( cached.mtime ) );
+	unsigned int cachedHash = reader.getU32();
+
+	if( !reader.isOK() ||
+		memcmp( magic, cacheMagic, sizeof( magic ) ) != 0 ||
+		version != cacheVersion || byteOrder != cacheByteOrder ||
+		cached.size != source.size )
+		return NULL;
+
+	// The hash is always checked.  An edit that keeps the size can also 
+	// keep the modification time (the time's resolution is a second, and 
+	// tools can restore it), and a stale cache would be used silently.  A 
+	// def file that has only been touched is still served from the cache.
+	unsigned int hash;
+	if( !hashSource( filename, hash ) || hash != cachedHash )
+		return NULL;
+
+	if( !reader.readStringTable() )
+		return NULL;
+
+	DefFileGroup *root = reader.getGroup( 0 );
+	if( !reader.isOK() )
+	{
+		MPV_LOG_WARNING( "DefFileCache - \"" << getCacheFilename( filename )
+			<< "\" is damaged; parsing \"" << filename << "\" instead" );
+		delete root;
+		return NULL;
+	}
+
+	return root;
+}
+
+
+// ================================================
+// write
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool DefFileCache::write( const std::string &filename, const DefFileGroup *root )
+{
+	SourceInfo source;
+	unsigned int hash;
+	if( root == NULL || !getSourceInfo( filename, source ) ||
+		!hashSource( filename, hash ) )
+		return false;
+
+	CacheWriter writer;
+	writer.putGroup( root );
+
+	std::vector<char> out;
+	CacheWriter::put( out, cacheMagic, sizeof( cacheMagic ) );
+	CacheWriter::put( out, &cacheVersion, sizeof( cacheVersion ) );
+	CacheWriter::put( out, &cacheByteOrder, sizeof( cacheByteOrder ) );
+	CacheWriter::put( out, &source.size, sizeof( source.size ) );
+	CacheWriter::put( out, &source.mtime, sizeof( source.mtime ) );
+	CacheWriter::put( out, &hash, sizeof( hash ) );
+	writer.finish( out );
+
+	// Written to a temporary file and renamed into place, so that another
+	// MPV starting at the same time never reads half a cache
+	std::string cacheFilename = getCacheFilename( filename );
+	std::string tempFilename = cacheFilename + ".tmp";
+
+	FILE *fp = fopen( tempFilename.c_str(), "wb" );
+	if( fp == NULL )
+	{
+		MPV_LOG_DEBUG( "DefFileCache - can't write \"" << tempFilename << "\"" );
+		return false;
+	}
+	size_t count = fwrite( &out[0], 1, out.size(), fp );
+	bool closed = ( fclose( fp ) == 0 );
+	if( count != out.size() || !closed )
+	{
+		remove( tempFilename.c_str() );
+		return false;
+	}
+
+#ifdef WIN32
+	// rename() won't replace an existing file on Windows
+	remove( cacheFilename.c_str() );
+#endif
+	if( rename( tempFilename.c_str(), cacheFilename.c_str() ) != 0 )
+	{
+		remove( tempFilename.c_str() );
+		return false;
+	}
+
+	return true;
+}
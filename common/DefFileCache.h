@@ -0,0 +1,85 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _DEFINITION_FILE_CACHE_INCLUDED_
+#define _DEFINITION_FILE_CACHE_INCLUDED_
+
+#include <string>
+
+#include "DefFileGroup.h"
+
+
+//=========================================================
+//! Reads and writes binary copies of parsed def files, so that unchanged
+//! files don't have to go through the flex & bison -based parser at
+//! startup.  Used by DefFileParser.
+//!
+//! The cache for "foo.def" is "foo.def.cache", in the same directory.  It
+//! holds the size, modification time and a hash of the def file it was
+//! made from, a table of the (interned) group and attribute names and
+//! string values, and the tree, with each value stored as the type the
+//! parser gave it.  A cache is used if the def file's size and hash
+//! match; otherwise the def file is parsed and the cache rewritten.  The
+//! modification time isn't trusted, since an edit can keep both it and
+//! the size.
+//!
+//! Caching can be turned off by setting the MPV_DEF_FILE_CACHE
+//! environment variable to 0.
+//!
+class MPVCMN_SPEC DefFileCache
+{
+public:
+
+	//=========================================================
+	//! \return false if caching has been turned off
+	//!
+	static bool isEnabled();
+
+	//=========================================================
+	//! \return the name of the cache for a def file
+	//!
+	static std::string getCacheFilename( const std::string &filename );
+
+	//=========================================================
+	//! Loads the cached tree for a def file
+	//! \param filename - the def file
+	//! \return a newly-allocated DefFileGroup, or NULL if there is no
+	//!         cache, or it is stale or damaged
+	//!
+	static DefFileGroup *read( const std::string &filename );
+
+	//=========================================================
+	//! Writes the cache for a def file
+	//! \param filename - the def file
+	//! \param root - the tree parsed from it
+	//! \return false if the cache couldn't be written (if the directory
+	//!         is read-only, for example)
+	//!
+	static bool write( const std::string &filename, const DefFileGroup *root );
+
+};
+
+
+#endif    //  _DEFINITION_FILE_CACHE_INCLUDED_
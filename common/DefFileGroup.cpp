@@ -31,6 +31,10 @@
  *  
  *  03/29/2004 Andrew Sampson                       MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Children and attributes are indexed by interned name; the URI 
+ *      lookups go through DefFilePath.
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -41,6 +45,7 @@
 #include <iostream>
 
 #include "DefFileGroup.h"
+#include "DefFilePath.h"
 
 
 
@@ -50,6 +55,10 @@
 DefFileGroup::DefFileGroup(  )
 {
 	parent = NULL;
+	nameID_ = DefFileName::intern( name_ );
+	indexValid_ = false;
+	indexedChildren_ = 0;
+	indexedAttributes_ = 0;
 }
 
 // ================================================
@@ -81,6 +90,11 @@ DefFileGroup::~DefFileGroup(  )
 void DefFileGroup::setName( const std::string &name )
 {
 	name_ = name;
+	nameID_ = DefFileName::intern( name );
+	
+	// the parser names groups after adding them to their parents
+	if( parent != NULL )
+		parent->indexValid_ = false;
 }
 
 // ================================================
@@ -105,11 +119,18 @@ void DefFileGroup::addChild( DefFileGroup* child )
 		// The child was formerly under another parent.  This isn't supposed 
 		// to happen, but it might.
 		child->parent->children.remove( child );
+		child->parent->indexValid_ = false;
 	}
 	
 	child->parent = this;
 	
 	children.push_back( child );
+	
+	if( indexValid_ && indexedChildren_ + 1 == children.size() )
+	{
+		childIndex_[child->nameID_].push_back( child );
+		indexedChildren_++;
+	}
 }
 
 
@@ -123,6 +144,7 @@ void DefFileGroup::removeChild( DefFileGroup *child )
 	
 	children.remove( child );
 	child->parent = NULL;
+	indexValid_ = false;
 }
 
 
@@ -131,14 +153,8 @@ void DefFileGroup::removeChild( DefFileGroup *child )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 DefFileGroup * DefFileGroup::getChild( const std::string &name )
 {
-	for( std::list< DefFileGroup * >::iterator iterG = this->children.begin();
-		iterG != this->children.end(); iterG++ )
-	{
-		if( (*iterG)->getName() == name ) {
-			return (*iterG);
-		}
-	}
-	return NULL;
+	const std::vector< DefFileGroup * > *result = getChildren( DefFileName::find( name ) );
+	return result ? result->front() : NULL;
 }
 
 
@@ -147,108 +163,69 @@ DefFileGroup * DefFileGroup::getChild( const std::string &name )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 const DefFileGroup * DefFileGroup::getChild( const std::string &name ) const
 {
-	for( std::list< DefFileGroup * >::const_iterator iterG = this->children.begin();
-		iterG != this->children.end(); iterG++ )
-	{
-		if( (*iterG)->getName() == name ) {
-			return (*iterG);
-		}
-	}
-	return NULL;
+	const std::vector< DefFileGroup * > *result = getChildren( DefFileName::find( name ) );
+	return result ? result->front() : NULL;
 }
 
 
 // ================================================
-// getGroupByURI
+// getChild (interned name)
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-DefFileGroup * DefFileGroup::getGroupByURI( const std::string &uriStr )
+DefFileGroup * DefFileGroup::getChild( const DefFileName &name )
 {
-	DefFileGroup *result = NULL;
-	char * uriCopy = strdup( uriStr.c_str() );
-	char * uri = uriCopy;
+	const std::vector< DefFileGroup * > *result = getChildren( name.getID() );
+	return result ? result->front() : NULL;
+}
 
-	// skip leading slashes
-	while( *uri == '/' )
-		uri++;
-	
-	// Now search for the next slash.  
-	// If there are no more slashes, we've reached the "attribute" part of the 
-	// URI.  In such a situation, we set 'result' to 'this'.
-	// If there is another slash, we need to search our child groups to see if 
-	// any of them match the text between the "beginning" of the string and 
-	// the first slash.
-	char *tokenStart = uri;
-	while( *uri != '/' && *uri != '\0' )
-		uri++;
-	if( *uri == '\0' )
-	{
-		// we've reached the "attribute" part of the URI
-		result = this;
-	}
-	else
-	{
-		// we need to search our child groups
-		std::string groupName( tokenStart, uri - tokenStart );
-		std::list< DefFileGroup * >::iterator iterG = this->children.begin();
-		for( ; iterG != this->children.end(); iterG++ )
-		{
-			DefFileGroup *child = (*iterG);
-			if( child->getName() == groupName )
-				result = child->getGroupByURI( uri );
-			if( result )
-				break;
-		}
-	}
+
+// ================================================
+// getChild (interned name, const version)
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const DefFileGroup * DefFileGroup::getChild( const DefFileName &name ) const
+{
+	const std::vector< DefFileGroup * > *result = getChildren( name.getID() );
+	return result ? result->front() : NULL;
+}
+
+
+// ================================================
+// getChildren
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const std::vector< DefFileGroup * > *DefFileGroup::getChildren( int nameID ) const
+{
+	if( nameID == DefFileName::NotFound )
+		return NULL;
 	
-	free( uriCopy );
-	return result;
+	validateIndex();
+	ChildIndex::const_iterator iter = childIndex_.find( nameID );
+	if( iter == childIndex_.end() )
+		return NULL;
+	return &iter->second;
 }
 
 
 // ================================================
-// getGroupByURI (const version)
+// getGroupByURI
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-const DefFileGroup * DefFileGroup::getGroupByURI( const std::string &uriStr ) const
+DefFileGroup * DefFileGroup::getGroupByURI( const std::string &uri )
 {
-	const DefFileGroup *result = NULL;
-	char * uriCopy = strdup( uriStr.c_str() );
-	char * uri = uriCopy;
+	// a name that has never been seen can't match
+	DefFilePath path;
+	if( !path.compile( uri, false ) )
+		return NULL;
+	return path.findGroup( this );
+}
 
-	// skip leading slashes
-	while( *uri == '/' )
-		uri++;
-	
-	// Now search for the next slash.  
-	// If there are no more slashes, we've reached the "attribute" part of the 
-	// URI.  In such a situation, we set 'result' to 'this'.
-	// If there is another slash, we need to search our child groups to see if 
-	// any of them match the text between the "beginning" of the string and 
-	// the first slash.
-	char *tokenStart = uri;
-	while( *uri != '/' && *uri != '\0' )
-		uri++;
-	if( *uri == '\0' )
-	{
-		// we've reached the "attribute" part of the URI
-		result = this;
-	}
-	else
-	{
-		// we need to search our child groups
-		std::string groupName( tokenStart, uri - tokenStart );
-		std::list< DefFileGroup * >::const_iterator iterG = this->children.begin();
-		for( ; iterG != this->children.end(); iterG++ )
-		{
-			const DefFileGroup *child = (*iterG);
-			if( child->getName() == groupName )
-				result = child->getGroupByURI( uri );
-			if( result )
-				break;
-		}
-	}
-	
-	free( uriCopy );
-	return result;
+
+// ================================================
+// getGroupByURI (const version)
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const DefFileGroup * DefFileGroup::getGroupByURI( const std::string &uri ) const
+{
+	DefFilePath path;
+	if( !path.compile( uri, false ) )
+		return NULL;
+	return path.findGroup( this );
 }
 
 
@@ -259,6 +236,14 @@ void DefFileGroup::addAttribute( DefFileAttrib * attr )
 {
 	if( attr == NULL ) return;
 	attributes.push_back( attr );
+	attr->group_ = this;
+	
+	if( indexValid_ && indexedAttributes_ + 1 == attributes.size() )
+	{
+		// the first attribute with a given name is the one found
+		attributeIndex_.insert( std::make_pair( attr->getNameID(), attr ) );
+		indexedAttributes_++;
+	}
 }
 
 
@@ -269,6 +254,9 @@ void DefFileGroup::removeAttribute( DefFileAttrib *attr )
 {
 	if( attr == NULL ) return;
 	attributes.remove( attr );
+	if( attr->group_ == this )
+		attr->group_ = NULL;
+	indexValid_ = false;
 }
 
 
@@ -277,14 +265,7 @@ void DefFileGroup::removeAttribute( DefFileAttrib *attr )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 DefFileAttrib * DefFileGroup::getAttribute( const std::string &name )
 {
-	for( std::list< DefFileAttrib * >::iterator iterA = this->attributes.begin();
-		iterA != this->attributes.end(); iterA++ )
-	{
-		if( (*iterA)->getName() == name ) {
-			return (*iterA);
-		}
-	}
-	return NULL;
+	return const_cast<DefFileAttrib *>( getAttribute( DefFileName::find( name ) ) );
 }
 
 
@@ -293,104 +274,105 @@ DefFileAttrib * DefFileGroup::getAttribute( const std::string &name )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 const DefFileAttrib * DefFileGroup::getAttribute( const std::string &name ) const
 {
-	for( std::list< DefFileAttrib * >::const_iterator iterA = this->attributes.begin();
-		iterA != this->attributes.end(); iterA++ )
-	{
-		if( (*iterA)->getName() == name ) {
-			return (*iterA);
-		}
-	}
-	return NULL;
+	return getAttribute( DefFileName::find( name ) );
 }
 
 
 // ================================================
-// getAttributeByURI
+// getAttribute (interned name)
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-DefFileAttrib * DefFileGroup::getAttributeByURI( const std::string &uriStr )
+DefFileAttrib * DefFileGroup::getAttribute( const DefFileName &name )
 {
-	DefFileAttrib *result = NULL;
-	char * uriCopy = strdup( uriStr.c_str() );
-	char * uri = uriCopy;
+	return const_cast<DefFileAttrib *>( getAttribute( name.getID() ) );
+}
 
-	// skip leading slashes
-	while( *uri == '/' )
-		uri++;
-	
-	// Now search for the next slash.  If there are no more slashes, we've 
-	// reached the "attribute" part of the URI.  If there is another slash, we 
-	// need to search our child groups to see if any of them match the text 
-	// between the "beginning" of the string and the first slash.
-	char *tokenStart = uri;
-	while( *uri != '/' && *uri != '\0' )
-		uri++;
-	if( *uri == '\0' )
-	{
-		// we've reached the "attribute" part of the URI
-		result = getAttribute( tokenStart );
-	}
-	else
-	{
-		// we need to search our child groups
-		std::string groupName( tokenStart, uri - tokenStart );
-		std::list< DefFileGroup * >::iterator iterG = this->children.begin();
-		for( ; iterG != this->children.end(); iterG++ )
-		{
-			DefFileGroup *child = (*iterG);
-			if( child->getName() == groupName )
-				result = child->getAttributeByURI( uri );
-			if( result )
-				break;
-		}
-	}
+
+// ================================================
+// getAttribute (interned name, const version)
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const DefFileAttrib * DefFileGroup::getAttribute( const DefFileName &name ) const
+{
+	return getAttribute( name.getID() );
+}
+
+
+// ================================================
+// getAttribute (name ID)
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const DefFileAttrib * DefFileGroup::getAttribute( int nameID ) const
+{
+	if( nameID == DefFileName::NotFound )
+		return NULL;
 	
-	free( uriCopy );
-	return result;
+	validateIndex();
+	AttributeIndex::const_iterator iter = attributeIndex_.find( nameID );
+	if( iter == attributeIndex_.end() )
+		return NULL;
+	return iter->second;
+}
+
+
+// ================================================
+// getAttributeByURI
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+DefFileAttrib * DefFileGroup::getAttributeByURI( const std::string &uri )
+{
+	DefFilePath path;
+	if( !path.compile( uri, false ) )
+		return NULL;
+	return path.findAttribute( this );
 }
 
 
 // ================================================
 // getAttributeByURI (const version)
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-const DefFileAttrib * DefFileGroup::getAttributeByURI( const std::string &uriStr ) const
+const DefFileAttrib * DefFileGroup::getAttributeByURI( const std::string &uri ) const
 {
-	const DefFileAttrib *result = NULL;
-	char * uriCopy = strdup( uriStr.c_str() );
-	char * uri = uriCopy;
+	DefFilePath path;
+	if( !path.compile( uri, false ) )
+		return NULL;
+	return path.findAttribute( this );
+}
 
-	// skip leading slashes
-	while( *uri == '/' )
-		uri++;
-	
-	// Now search for the next slash.  If there are no more slashes, we've 
-	// reached the "attribute" part of the URI.  If there is another slash, we 
-	// need to search our child groups to see if any of them match the text 
-	// between the "beginning" of the string and the first slash.
-	char *tokenStart = uri;
-	while( *uri != '/' && *uri != '\0' )
-		uri++;
-	if( *uri == '\0' )
+
+// ================================================
+// validateIndex
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void DefFileGroup::validateIndex() const
+{
+	if( !indexValid_ || 
+		indexedChildren_ != children.size() || 
+		indexedAttributes_ != attributes.size() )
+		buildIndex();
+}
+
+
+// ================================================
+// buildIndex
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void DefFileGroup::buildIndex() const
+{
+	childIndex_.clear();
+	for( std::list< DefFileGroup * >::const_iterator iterG = this->children.begin();
+		iterG != this->children.end(); iterG++ )
 	{
-		// we've reached the "attribute" part of the URI
-		result = getAttribute( tokenStart );
+		childIndex_[(*iterG)->nameID_].push_back( *iterG );
 	}
-	else
+	
+	// attributes added through the public list are claimed here, so that 
+	// renaming them invalidates the index too
+	attributeIndex_.clear();
+	for( std::list< DefFileAttrib * >::const_iterator iterA = this->attributes.begin();
+		iterA != this->attributes.end(); iterA++ )
 	{
-		// we need to search our child groups
-		std::string groupName( tokenStart, uri - tokenStart );
-		std::list< DefFileGroup * >::const_iterator iterG = this->children.begin();
-		for( ; iterG != this->children.end(); iterG++ )
-		{
-			const DefFileGroup *child = (*iterG);
-			if( child->getName() == groupName )
-				result = child->getAttributeByURI( uri );
-			if( result )
-				break;
-		}
+		attributeIndex_.insert( std::make_pair( (*iterA)->getNameID(), *iterA ) );
+		(*iterA)->group_ = const_cast<DefFileGroup *>( this );
 	}
 	
-	free( uriCopy );
-	return result;
+	indexedChildren_ = children.size();
+	indexedAttributes_ = attributes.size();
+	indexValid_ = true;
 }
 
 
@@ -31,6 +31,10 @@
  *  
  *  03/29/2004 Andrew Sampson                       MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Children and attributes are indexed by interned name; the URI 
+ *      lookups go through DefFilePath.
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -41,9 +45,14 @@
 
 #include <stdio.h>
 #include <list>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "DefFileAttrib.h"
+#include "DefFileName.h"
+
+class DefFilePath;
 
 #if defined(_MSC_VER)
    #pragma warning(push)
@@ -53,6 +62,16 @@
 //======================================================
 //! A class for storing groups, as loaded from .def files.  Groups can contain 
 //! attributes and other groups.
+//! 
+//! Alongside the children and attributes lists, a group keeps an index of 
+//! them by name (see DefFileName), so that lookups don't search the lists.  
+//! The index is kept up to date by the methods below, including renames 
+//! through setName(), and rebuilt on the next lookup after the lists change 
+//! size behind its back.
+//! 
+//! Lookups, const ones included, may rebuild the index, so they aren't 
+//! thread-safe: a tree that more than one thread searches needs a lock 
+//! around its lookups, just as one that is being changed does.
 class MPVCMN_SPEC DefFileGroup {
 public:
 
@@ -110,6 +129,13 @@ public:
 	//!
 	const DefFileGroup * getChild( const std::string &name ) const;
 	
+	//============================================
+	//! Searches this group's list of child groups for one with specified 
+	//! (interned) name.  \see getChild()
+	//!
+	DefFileGroup * getChild( const DefFileName &name );
+	const DefFileGroup * getChild( const DefFileName &name ) const;
+	
 	//============================================
 	//! Retrieves group by URI (Universal Resource Identifier... kind of 
 	//! like a URL).  If more than one group in the def tree matches the 
@@ -157,6 +183,13 @@ public:
 	//!
 	const DefFileAttrib * getAttribute( const std::string &name ) const;
 	
+	//============================================
+	//! Searches this group's list of attributes for one with specified 
+	//! (interned) name.  \see getAttribute()
+	//!
+	DefFileAttrib * getAttribute( const DefFileName &name );
+	const DefFileAttrib * getAttribute( const DefFileName &name ) const;
+	
 	//============================================
 	//! Retrieves an attribute by URI (Universal Resource Identifier... kind of 
 	//! like a URL).  If more than one attribute in the def tree matches the 
@@ -205,10 +238,54 @@ public:
 
 private:
 	
+	friend class DefFilePath;
+	friend class DefFileAttrib;
+	
+	typedef std::map< int, std::vector< DefFileGroup * > > ChildIndex;
+	typedef std::map< int, DefFileAttrib * > AttributeIndex;
+	
+	//=========================================================
+	//! Returns the children with the given name ID, in order, or NULL if 
+	//! there are none
+	//!
+	const std::vector< DefFileGroup * > *getChildren( int nameID ) const;
+	
+	//=========================================================
+	//! Returns the first attribute with the given name ID, or NULL
+	//!
+	const DefFileAttrib *getAttribute( int nameID ) const;
+	
+	//=========================================================
+	//! Rebuilds the index if the lists have changed behind its back
+	//!
+	void validateIndex() const;
+	
+	//=========================================================
+	//! Rebuilds the index from the lists
+	//!
+	void buildIndex() const;
+	
 	//=========================================================
 	//! The name of this group
 	//!
 	std::string name_;
+	
+	//=========================================================
+	//! The interned ID of the group's name
+	//!
+	int nameID_;
+	
+	//=========================================================
+	//! The index of the children and attributes lists.  Built on the first 
+	//! lookup, hence mutable.  The list sizes when it was last brought up 
+	//! to date are kept, to catch changes made to the (public) lists 
+	//! directly.
+	//!
+	mutable bool indexValid_;
+	mutable ChildIndex childIndex_;
+	mutable AttributeIndex attributeIndex_;
+	mutable size_t indexedChildren_;
+	mutable size_t indexedAttributes_;
 
 };
 
@@ -0,0 +1,162 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <string.h>
+
+#include <vector>
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+
+#include "DefFileName.h"
+
+
+namespace
+{
+
+//=========================================================
+//! The interned names, and an open-addressed hash table of their IDs.
+//! Names are interned from the def file parser, and from DefFileName and
+//! DefFilePath constructors (which may run during static initialization,
+//! hence the function-local instance below).
+//!
+class NameTable
+{
+public:
+	NameTable() : slots( 256, (int)DefFileName::NotFound ) {}
+
+	int find( const char *begin, const char *end )
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+		size_t slot;
+		return lookup( begin, end, slot );
+	}
+
+	int intern( const std::string &name )
+	{
+		const char *begin = name.data();
+		const char *end = begin + name.size();
+
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+		size_t slot;
+		int id = lookup( begin, end, slot );
+		if( id != DefFileName::NotFound )
+			return id;
+
+		id = (int)names.size();
+		names.push_back( name );
+		slots[slot] = id;
+
+		// keep the table at most half full
+		if( names.size() * 2 > slots.size() )
+			grow();
+		return id;
+	}
+
+private:
+	static size_t hash( const char *begin, const char *end )
+	{
+		// FNV-1a
+		unsigned int result = 2166136261u;
+		for( const char *c = begin; c != end; c++ )
+		{
+			result ^= (unsigned char)*c;
+			result *= 16777619u;
+		}
+		return result;
+	}
+
+	//! returns the name's ID, or NotFound and the empty slot it would go in
+	int lookup( const char *begin, const char *end, size_t &slot ) const
+	{
+		size_t length = end - begin;
+		size_t mask = slots.size() - 1;
+		for( slot = hash( begin, end ) & mask; ; slot = ( slot + 1 ) & mask )
+		{
+			int id = slots[slot];
+			if( id == DefFileName::NotFound )
+				return id;
+			const std::string &name = names[id];
+			if( name.size() == length && memcmp( name.data(), begin, length ) == 0 )
+				return id;
+		}
+	}
+
+	void grow()
+	{
+		std::vector<int> newSlots( slots.size() * 2, (int)DefFileName::NotFound );
+		size_t mask = newSlots.size() - 1;
+		for( unsigned int id = 0; id < names.size(); id++ )
+		{
+			const char *begin = names[id].data();
+			size_t slot = hash( begin, begin + names[id].size() ) & mask;
+			while( newSlots[slot] != DefFileName::NotFound )
+				slot = ( slot + 1 ) & mask;
+			newSlots[slot] = id;
+		}
+		slots.swap( newSlots );
+	}
+
+	std::vector<std::string> names;
+	//! a power of two in size
+	std::vector<int> slots;
+	OpenThreads::Mutex mutex;
+};
+
+
+NameTable &getNameTable()
+{
+	static NameTable table;
+	return table;
+}
+
+}
+
+
+// ================================================
+// intern
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int DefFileName::intern( const std::string &name )
+{
+	return getNameTable().intern( name );
+}
+
+
+// ================================================
+// find
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int DefFileName::find( const std::string &name )
+{
+	return getNameTable().find( name.data(), name.data() + name.size() );
+}
+
+
+// ================================================
+// find
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int DefFileName::find( const char *begin, const char *end )
+{
+	return getNameTable().find( begin, end );
+}
@@ -0,0 +1,87 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _DEFINITION_FILE_NAME_INCLUDED_
+#define _DEFINITION_FILE_NAME_INCLUDED_
+
+#include <string>
+
+#include "MPVCommonTypes.h"
+
+
+//=========================================================
+//! An interned group or attribute name.  Every distinct name is given a
+//! small integer ID, from a process-wide hash table; DefFileGroup indexes
+//! its children and attributes by these IDs.
+//!
+//! Looking up a name by string costs one hash of the string.  Code that
+//! looks up the same name repeatedly can intern it once, and pass the
+//! DefFileName instead:
+//! \code
+//! static const DefFileName elementType( "element_type" );
+//! DefFileAttrib *attr = group->getAttribute( elementType );
+//! \endcode
+//!
+class MPVCMN_SPEC DefFileName
+{
+public:
+
+	//=========================================================
+	//! The ID of a name that has never been interned
+	//!
+	static const int NotFound = -1;
+
+	//=========================================================
+	//! Interns a name
+	//! \param name - the group or attribute name
+	//!
+	explicit DefFileName( const std::string &name ) : id( intern( name ) ) {}
+
+	int getID() const { return id; }
+
+	//=========================================================
+	//! Returns the ID for a name, giving it one if it doesn't have one
+	//!
+	static int intern( const std::string &name );
+
+	//=========================================================
+	//! Returns the ID for a name, or NotFound if it doesn't have one (in
+	//! which case no group or attribute has that name)
+	//!
+	static int find( const std::string &name );
+
+	//=========================================================
+	//! Returns find() for the characters [begin, end)
+	//!
+	static int find( const char *begin, const char *end );
+
+private:
+
+	int id;
+
+};
+
+
+#endif    //  _DEFINITION_FILE_NAME_INCLUDED_
@@ -31,6 +31,9 @@
  *  
  *  03/29/2004 Andrew Sampson                       MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Parsed files are cached; see DefFileCache.
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -40,6 +43,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "DefFileCache.h"
 #include "DefFileParser.h"
 
 int yyparse( void );
@@ -78,6 +82,13 @@ DefFileParser::~DefFileParser()
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 DefFileGroup * DefFileParser::parse( const std::string &filename )
 {
+	bool useCache = DefFileCache::isEnabled();
+	if( useCache )
+	{
+		DefFileGroup *cached = DefFileCache::read( filename );
+		if( cached != NULL )
+			return cached;
+	}
 
 	FILE *fp = fopen( filename.c_str(), "r" );
 
@@ -121,6 +132,9 @@ DefFileGroup * DefFileParser::parse( const std::string &filename )
 	
 	fclose( fp );
 	
+	if( useCache )
+		DefFileCache::write( filename, root );
+	
 	return root;
 }
 
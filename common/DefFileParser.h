@@ -31,6 +31,9 @@
  *  
  *  03/29/2004 Andrew Sampson                       MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Parsed files are cached; see DefFileCache.
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -77,7 +80,9 @@ public:
 	~DefFileParser();
 
 	//=========================================================
-	//! Parses the specified definition file
+	//! Parses the specified definition file.  If the file has a valid 
+	//! cache (see DefFileCache), the tree is loaded from that instead; 
+	//! otherwise the file is parsed and its cache written.
 	//! \param filename - The name of the definition file to parse
 	//! \return a newly-allocated DefFileGroup, or NULL on failure
 	//!
@@ -0,0 +1,173 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include "DefFileName.h"
+#include "DefFilePath.h"
+
+
+// ================================================
+// DefFilePath
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+DefFilePath::DefFilePath() :
+	attributeID( DefFileName::NotFound ),
+	valid( false )
+{
+}
+
+
+// ================================================
+// DefFilePath
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+DefFilePath::DefFilePath( const std::string &uri ) :
+	attributeID( DefFileName::NotFound ),
+	valid( false )
+{
+	compile( uri );
+}
+
+
+// ================================================
+// compile
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool DefFilePath::compile( const std::string &newURI, bool intern )
+{
+	uri = newURI;
+	groupIDs.clear();
+	attributeID = DefFileName::NotFound;
+	valid = true;
+
+	// Every slash-terminated token is a group name (empty tokens, from
+	// leading or doubled slashes, are skipped); whatever follows the last
+	// slash is the attribute name
+	const char *c = uri.c_str();
+	const char *tokenStart = c;
+	for( ; *c != '\0'; c++ )
+	{
+		if( *c != '/' )
+			continue;
+		if( c != tokenStart )
+		{
+			int id = intern
+				? DefFileName::intern( std::string( tokenStart, c ) )
+				: DefFileName::find( tokenStart, c );
+			if( id == DefFileName::NotFound )
+				valid = false;
+			groupIDs.push_back( id );
+		}
+		tokenStart = c + 1;
+	}
+
+	attributeID = intern
+		? DefFileName::intern( std::string( tokenStart, c ) )
+		: DefFileName::find( tokenStart, c );
+
+	return valid;
+}
+
+
+// ================================================
+// findGroup
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+DefFileGroup *DefFilePath::findGroup( DefFileGroup *root ) const
+{
+	return const_cast<DefFileGroup *>( findGroup( (const DefFileGroup *)root ) );
+}
+
+
+// ================================================
+// findGroup (const version)
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const DefFileGroup *DefFilePath::findGroup( const DefFileGroup *root ) const
+{
+	if( root == NULL || !valid )
+		return NULL;
+	return findGroup( root, 0 );
+}
+
+
+// ================================================
+// findAttribute
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+DefFileAttrib *DefFilePath::findAttribute( DefFileGroup *root ) const
+{
+	return const_cast<DefFileAttrib *>( findAttribute( (const DefFileGroup *)root ) );
+}
+
+
+// ================================================
+// findAttribute (const version)
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const DefFileAttrib *DefFilePath::findAttribute( const DefFileGroup *root ) const
+{
+	if( root == NULL || !valid || attributeID == DefFileName::NotFound )
+		return NULL;
+	return findAttribute( root, 0 );
+}
+
+
+// ================================================
+// findGroup
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const DefFileGroup *DefFilePath::findGroup(
+	const DefFileGroup *group, unsigned int depth ) const
+{
+	if( depth == groupIDs.size() )
+		return group;
+
+	const std::vector<DefFileGroup *> *children = group->getChildren( groupIDs[depth] );
+	if( children == NULL )
+		return NULL;
+
+	for( unsigned int i = 0; i < children->size(); i++ )
+	{
+		const DefFileGroup *result = findGroup( (*children)[i], depth + 1 );
+		if( result != NULL )
+			return result;
+	}
+	return NULL;
+}
+
+
+// ================================================
+// findAttribute
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const DefFileAttrib *DefFilePath::findAttribute(
+	const DefFileGroup *group, unsigned int depth ) const
+{
+	if( depth == groupIDs.size() )
+		return group->getAttribute( attributeID );
+
+	const std::vector<DefFileGroup *> *children = group->getChildren( groupIDs[depth] );
+	if( children == NULL )
+		return NULL;
+
+	for( unsigned int i = 0; i < children->size(); i++ )
+	{
+		const DefFileAttrib *result = findAttribute( (*children)[i], depth + 1 );
+		if( result != NULL )
+			return result;
+	}
+	return NULL;
+}
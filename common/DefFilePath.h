@@ -0,0 +1,116 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _DEFINITION_FILE_PATH_INCLUDED_
+#define _DEFINITION_FILE_PATH_INCLUDED_
+
+#include <string>
+#include <vector>
+
+#include "DefFileGroup.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+//=========================================================
+//! A URI (as taken by DefFileGroup::getGroupByURI() and
+//! getAttributeByURI()), split up and interned once so that it can be
+//! resolved repeatedly without any string handling:
+//! \code
+//! static const DefFilePath fovPath( "/view/fov" );
+//! DefFileAttrib *attr = fovPath.findAttribute( root );
+//! \endcode
+//! Resolution follows the same rules as the URI methods: each group in the
+//! path is looked for among all the same-named children, in order, and the
+//! first complete match wins.
+//!
+class MPVCMN_SPEC DefFilePath
+{
+public:
+
+	//=========================================================
+	//! General Constructor; the path matches nothing until compile()
+	//! is called
+	//!
+	DefFilePath();
+
+	//=========================================================
+	//! Compiles a URI, interning its names
+	//! \param uri - "/group1/group2/" for a group, or
+	//!        "/group1/group2/attribute" for an attribute
+	//!
+	explicit DefFilePath( const std::string &uri );
+
+	//=========================================================
+	//! Compiles a URI.  If intern is false, and some name in the URI has
+	//! never been seen, the path can't match anything, and false is
+	//! returned.
+	//!
+	bool compile( const std::string &uri, bool intern = true );
+
+	const std::string &getURI() const { return uri; }
+
+	//=========================================================
+	//! Resolves the path's groups, starting from root
+	//! \return the group, or NULL if there is no match
+	//!
+	DefFileGroup *findGroup( DefFileGroup *root ) const;
+	const DefFileGroup *findGroup( const DefFileGroup *root ) const;
+
+	//=========================================================
+	//! Resolves the path's groups and attribute, starting from root
+	//! \return the attribute, or NULL if there is no match
+	//!
+	DefFileAttrib *findAttribute( DefFileGroup *root ) const;
+	const DefFileAttrib *findAttribute( const DefFileGroup *root ) const;
+
+private:
+
+	const DefFileGroup *findGroup( const DefFileGroup *group,
+		unsigned int depth ) const;
+
+	const DefFileAttrib *findAttribute( const DefFileGroup *group,
+		unsigned int depth ) const;
+
+	std::string uri;
+
+	//! the groups' name IDs
+	std::vector<int> groupIDs;
+
+	//! the attribute's name ID; NotFound for group paths
+	int attributeID;
+
+	//! false if a group name has never been seen
+	bool valid;
+
+};
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif    //  _DEFINITION_FILE_PATH_INCLUDED_
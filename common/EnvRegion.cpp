@@ -23,7 +23,7 @@
  *  
  *  PROGRAM DESCRIPTION: 
  *  This class contains the data and methods necessary to
- *   represent an entity.
+ *   represent an environmental region.
  *  
  *  MODIFICATION NOTES:
  *  DATE     NAME                                SCR NUMBER
@@ -31,98 +31,245 @@
  *  
  *  11/01/2005 Greg Basler                       MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Rewritten against the current common library; see EnvRegion.h
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
  */
 
-#define _EXPORT_MPVCMN_
-
-#include <iostream>
+#include <math.h>
 
 #include "EnvRegion.h"
-#include <math.h>
 
-//////////////////////////////////////////////////////////////////////
-// Construction/Destruction
-//////////////////////////////////////////////////////////////////////
+using namespace mpv;
+
+
+unsigned int EnvRegion::nextUpdateSequence = 0;
+
+
+// ================================================
+// EnvConditions
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EnvConditions::EnvConditions() :
+	humidity( 0.0f ),
+	airTemp( 0.0f ),
+	visibilityRange( 0.0f ),
+	horizWindSpeed( 0.0f ),
+	vertWindSpeed( 0.0f ),
+	windDirection( 0.0f ),
+	baroPressure( 0.0f ),
+	aerosol( 0.0f ),
+	layerID( -1 ),
+	numRegions( 0 )
+{
+}
+
+
+// ================================================
+// EnvRegion
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EnvRegion::EnvRegion( int newID ) : GeodeticObject(),
+	id( newID ),
+	state( Inactive ),
+	weatherMerge( UseLast ),
+	aerosolMerge( UseLast ),
+	maritimeSurfaceMerge( UseLast ),
+	terrestrialSurfaceMerge( UseLast ),
+	xSize( 0.0f ),
+	ySize( 0.0f ),
+	cornerRadius( 0.0f ),
+	transition( 0.0f ),
+	updateSequence( 0 )
+{
+}
+
+
+// ================================================
+// ~EnvRegion
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EnvRegion::~EnvRegion()
+{
+}
 
 
 // ================================================
-// Initialize the static variable ExtendedDataCount
+// setState
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-int EnvRegion::ExtendedDataCount = 0;
+void EnvRegion::setState( RegionState newState )
+{
+	if( state != newState )
+	{
+		state = newState;
+		stateChanged( this );
+	}
+}
+
 
 // ================================================
-// Entity
+// processEnvRegionCtrl
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-EnvRegion::EnvRegion() : ExtendedDataSet()
+void EnvRegion::processEnvRegionCtrl( CigiEnvRgnCtrlV3 *packet )
 {
+	if( id != packet->GetRegionID() )
+		return;
+
+	// the first packet always sets the position, even if it matches the 
+	// default, so that the database position gets computed
+	bool firstPacket = ( updateSequence == 0 );
+	updateSequence = ++nextUpdateSequence;
 
+	weatherMerge = (MergeMode)packet->GetWeatherProp();
+	aerosolMerge = (MergeMode)packet->GetAerosol();
+	maritimeSurfaceMerge = (MergeMode)packet->GetMaritimeSurface();
+	terrestrialSurfaceMerge = (MergeMode)packet->GetTerrestrialSurface();
 
-	EnvRegionID = 0;
-   CigiPos.LatX = 0.0;
-   CigiPos.LonY = 0.0;
-   CigiPos.AltZ = 0.0;
-   CigiPos.Yaw = 0.0;
-   CigiPos.Pitch = 0.0;
-   CigiPos.Roll = 0.0;
-   XSize = 0.0f;
-   YSize = 0.0f;
-   CornerRadius = 0.0f;
-   Transition = 0.0f;
-   RgnState = CigiBaseEnvRgnCtrl::Inactive;
-   WeatherProp = CigiBaseEnvRgnCtrl::UseLast;
-   Aerosol = CigiBaseEnvRgnCtrl::UseLast;
-   MaritimeSurface = CigiBaseEnvRgnCtrl::UseLast;
-   TerrestrialSurface = CigiBaseEnvRgnCtrl::UseLast;
+	if( xSize != packet->GetXSize() || ySize != packet->GetYSize() || 
+		cornerRadius != packet->GetCornerRadius() || 
+		transition != packet->GetTransition() )
+	{
+		xSize = packet->GetXSize();
+		ySize = packet->GetYSize();
+		cornerRadius = packet->GetCornerRadius();
+		transition = packet->GetTransition();
+		footprintChanged( this );
+	}
 
+	if( firstPacket || 
+		positionGDC.LatX != packet->GetLat() || 
+		positionGDC.LonY != packet->GetLon() || 
+		positionGDC.Yaw != packet->GetRotation() )
+	{
+		// Alt, Pitch, and Roll stay 0
+		CoordinateSet newPosition;
+		newPosition.LatX = packet->GetLat();
+		newPosition.LonY = packet->GetLon();
+		newPosition.Yaw = packet->GetRotation();
+		setPositionGDC( newPosition );
+	}
 
-   CreateExtendedData(ExtendedDataCount);
+	// state last, so that anyone listening sees the new footprint
+	setState( (RegionState)packet->GetRgnState() );
+}
 
 
+// ================================================
+// processWeatherCtrl
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegion::processWeatherCtrl( CigiWeatherCtrlV3 *packet )
+{
+	WeatherCtrl &layer = layers[packet->GetLayerID()];
+	layer.SetLayerID( packet->GetLayerID() );
+	layer.ProcWeatherCtrlPckt( packet );
+	weatherChanged( this );
 }
 
 
 // ================================================
-// ~Entity
+// getBounds
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-EnvRegion::~EnvRegion()
+void EnvRegion::getBounds( double &minX, double &minY, double &maxX, double &maxY ) const
 {
+	double yaw = positionDB.Yaw * M_PI / 180.0;
+	double s = fabs( sin( yaw ) );
+	double c = fabs( cos( yaw ) );
+	double halfX = 0.5 * xSize;
+	double halfY = 0.5 * ySize;
 
-}
+	// the region's X axis points north and its Y axis east, before the 
+	// yaw (clockwise from north) is applied; database x is east, y north
+	double extentX = halfX * s + halfY * c + transition;
+	double extentY = halfX * c + halfY * s + transition;
 
+	minX = positionDB.LatX - extentX;
+	maxX = positionDB.LatX + extentX;
+	minY = positionDB.LonY - extentY;
+	maxY = positionDB.LonY + extentY;
+}
 
 
 // ================================================
-// ProcEnvRegionCtrlPckt
+// getInfluence
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-void EnvRegion::ProcEnvRegionCtrlPckt(CigiEnvRgnCtrlV3 *Packet)
+float EnvRegion::getInfluence( double x, double y ) const
 {
+	double yaw = positionDB.Yaw * M_PI / 180.0;
+	double s = sin( yaw );
+	double c = cos( yaw );
+	double dx = x - positionDB.LatX;
+	double dy = y - positionDB.LonY;
 
-   if(EnvRegionID != Packet->GetRegionID())
-      return;
-
-   RgnState = Packet->GetRgnState();
-   WeatherProp = Packet->GetWeatherProp();
-   Aerosol = Packet->GetAerosol();
-   MaritimeSurface = Packet->GetMaritimeSurface();
-   TerrestrialSurface = Packet->GetTerrestrialSurface();
-   CigiPos.LatX = Packet->GetLat();
-   CigiPos.LonY = Packet->GetLon();
-   CigiPos.Yaw = Packet->GetRotation();
-   XSize = Packet->GetXSize();
-   YSize = Packet->GetYSize();
-   CornerRadius = Packet->GetCornerRadius();
-   Transition = Packet->GetTransition();
-
-   // Alt, Pitch, and Roll are already set to 0
-   if(CoordCigi2DBase != NULL)
-      CoordCigi2DBase(CigiPos,DBasePos);
-
-   // Set updated flag
-   PcktUpdated = true;
+	// point in the region's frame; u along its X (north) axis, v along 
+	// its Y (east) axis
+	double u = fabs( dx * s + dy * c );
+	double v = fabs( dx * c - dy * s );
 
+	double halfX = 0.5 * xSize;
+	double halfY = 0.5 * ySize;
+	double radius = cornerRadius;
+	if( radius > halfX ) radius = halfX;
+	if( radius > halfY ) radius = halfY;
+	if( radius < 0.0 ) radius = 0.0;
+
+	// signed distance from the rounded rectangle's edge
+	double qu = u - ( halfX - radius );
+	double qv = v - ( halfY - radius );
+	double outU = qu > 0.0 ? qu : 0.0;
+	double outV = qv > 0.0 ? qv : 0.0;
+	double inside = qu > qv ? qu : qv;
+	if( inside > 0.0 ) inside = 0.0;
+	double distance = sqrt( outU * outU + outV * outV ) + inside - radius;
+
+	if( distance <= 0.0 )
+		return 1.0f;
+	if( distance >= transition )
+		return 0.0f;
+	return (float)( 1.0 - distance / transition );
 }
 
 
+// ================================================
+// findLayer
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+const WeatherCtrl *EnvRegion::findLayer( const LayerMap &layers,
+	float altitude, float &weight )
+{
+	const WeatherCtrl *result = NULL;
+	weight = 0.0f;
+
+	LayerMap::const_iterator iter;
+	for( iter = layers.begin(); iter != layers.end(); iter++ )
+	{
+		const WeatherCtrl &layer = iter->second;
+		if( !layer.GetWeatherEn() )
+			continue;
+
+		float base = layer.GetBaseElev();
+		float top = base + layer.GetThickness();
+		float band = layer.GetTransition();
+		float distance = 0.0f;
+		if( altitude < base )
+			distance = base - altitude;
+		else if( altitude > top )
+			distance = altitude - top;
+
+		float layerWeight;
+		if( distance <= 0.0f )
+			layerWeight = 1.0f;
+		else if( distance < band )
+			layerWeight = 1.0f - distance / band;
+		else
+			continue;
+
+		// ties go to the lower layer ID
+		if( layerWeight > weight )
+		{
+			weight = layerWeight;
+			result = &layer;
+		}
+	}
+
+	return result;
+}
@@ -23,7 +23,7 @@
  *  
  *  PROGRAM DESCRIPTION: 
  *  This class contains the data and methods necessary to
- *   represent an entity.
+ *   represent an environmental region.
  *  
  *  MODIFICATION NOTES:
  *  DATE     NAME                                SCR NUMBER
@@ -31,6 +31,12 @@
  *  
  *  11/01/2005 Greg Basler                       MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Rewritten against the current common library: now a GeodeticObject
+ *      with signals, in namespace mpv, and able to compute its own
+ *      footprint and the weight of its conditions at a point.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -39,330 +45,208 @@
 #if !defined(_ENVIRONMENTAL_REGION_INCLUDED_)
 #define _ENVIRONMENTAL_REGION_INCLUDED_
 
+#include <map>
+
 #include <CigiEnvRgnCtrlV3.h>
-#include <list>
-#include <string>
-#include <vector>
-#include "CompCtrlList.h"
-#include "WeatherCtrlList.h"
-#include "CoordSet.h"
-#include "BasePositionConversion.h"
+#include <CigiWeatherCtrlV3.h>
 
-#include "ExtendedData.h"
+#include "GeodeticObject.h"
+#include "WeatherCtrl.h"
 
 #include "MPVCommonTypes.h"
 
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+
+namespace mpv
+{
+
+//=========================================================
+//! The atmospheric conditions at a point, as reported in a CIGI Weather
+//! Conditions Response.  Produced by EnvRegionContainer::getConditions().
+//!
+struct MPVCMN_SPEC EnvConditions
+{
+	EnvConditions();
+
+	//! relative humidity, in percent
+	float humidity;
+	//! degrees C
+	float airTemp;
+	//! meters
+	float visibilityRange;
+	//! m/s
+	float horizWindSpeed;
+	//! m/s, positive up
+	float vertWindSpeed;
+	//! degrees from true north that the wind is blowing from
+	float windDirection;
+	//! millibars
+	float baroPressure;
+	//! grams/m^3
+	float aerosol;
+
+	//! the weather layer that contributed most to these conditions, or -1
+	//! if the point isn't in any enabled layer
+	int layerID;
+
+	//! the number of regions that contributed
+	int numRegions;
+};
 
 
 //=========================================================
 //! This class encapsulates the Environmental Region
-//!   functionality and data
+//!   functionality and data.  The region's footprint is a rounded
+//!   rectangle, centered on the region's position and rotated by its
+//!   yaw, surrounded by a transition perimeter across which the region's
+//!   conditions fade out.
 //!
-class MPVCMN_SPEC EnvRegion : public ExtendedDataSet, public CompCtrlList,
-   public WeatherCtrlList
+class MPVCMN_SPEC EnvRegion : public GeodeticObject
 {
 public:
 
-   //==> Management
+	//=========================================================
+	//! The enumeration for the region state
+	//!
+	enum RegionState
+	{
+		Inactive = CigiBaseEnvRgnCtrl::Inactive,
+		Active = CigiBaseEnvRgnCtrl::Active,
+		Destroyed = CigiBaseEnvRgnCtrl::Destroyed
+	};
+
+	//=========================================================
+	//! How this region's properties combine with those of the regions
+	//! it overlaps
+	//!
+	enum MergeMode
+	{
+		//! this region's properties replace those beneath it
+		UseLast = CigiBaseEnvRgnCtrl::UseLast,
+		//! this region's properties are averaged with those beneath it
+		Merge = CigiBaseEnvRgnCtrl::Merge
+	};
+
+	//! weather layers, keyed by layer ID
+	typedef std::map< int, WeatherCtrl > LayerMap;
+
+	boost::signal<void (EnvRegion*)> stateChanged;
+
+	//! emitted when the size, corner radius or transition perimeter
+	//! changes; position changes emit positionGDCChanged/positionDBChanged
+	boost::signal<void (EnvRegion*)> footprintChanged;
+
+	boost::signal<void (EnvRegion*)> weatherChanged;
+
+	//=========================================================
+	//! General Constructor
+	//! \param id - the region ID assigned by the host
+	//!
+	EnvRegion( int id );
+
+	int getID() const { return id; }
+
+	RegionState getState() const { return state; }
+	void setState( RegionState newState );
+
+	MergeMode getWeatherMerge() const { return weatherMerge; }
+	MergeMode getAerosolMerge() const { return aerosolMerge; }
+	MergeMode getMaritimeSurfaceMerge() const { return maritimeSurfaceMerge; }
+	MergeMode getTerrestrialSurfaceMerge() const { return terrestrialSurfaceMerge; }
+
+	float getXSize() const { return xSize; }
+	float getYSize() const { return ySize; }
+	float getCornerRadius() const { return cornerRadius; }
+	float getTransition() const { return transition; }
+
+	//=========================================================
+	//! Returns a number that increases each time any region receives an
+	//! Environmental Region Control packet.  Overlapping regions are
+	//! applied in this order.
+	//!
+	unsigned int getUpdateSequence() const { return updateSequence; }
+
+	const LayerMap &getLayers() const { return layers; }
+
+	//=========================================================
+	//! Processes the environmental region control packet
+	//! \param packet - A pointer to the received CigiEnvRgnCtrlV3
+	//!   packet for this environmental region
+	//!
+	void processEnvRegionCtrl( CigiEnvRgnCtrlV3 *packet );
+
+	//=========================================================
+	//! Processes a regional weather control packet for this region.
+	//! Layers are created as the host first mentions them.
+	//!
+	void processWeatherCtrl( CigiWeatherCtrlV3 *packet );
+
+	//=========================================================
+	//! Returns the axis-aligned bounds, in database coordinates, of the
+	//! footprint and its transition perimeter
+	//!
+	void getBounds( double &minX, double &minY, double &maxX, double &maxY ) const;
+
+	//=========================================================
+	//! Returns how strongly this region applies at a database x/y: 1
+	//! inside the footprint, falling linearly to 0 across the transition
+	//! perimeter, and 0 beyond it
+	//!
+	float getInfluence( double x, double y ) const;
+
+	//=========================================================
+	//! Finds the enabled layer that applies most strongly at an altitude.
+	//! A layer applies fully between its base and top, and falls off
+	//! linearly across its transition band above and below.
+	//! \param layers - the layers to search
+	//! \param altitude - meters MSL
+	//! \param weight - set to the layer's weight at that altitude
+	//! \return the layer, or NULL if no enabled layer applies
+	//!
+	static const WeatherCtrl *findLayer( const LayerMap &layers,
+		float altitude, float &weight );
 
-   //=========================================================
-   //! General Constructor
-   //!
-	EnvRegion();
+protected:
 
-   //=========================================================
-   //! General Destructor
-   //!
+	//=========================================================
+	//! General Destructor
+	//!
 	virtual ~EnvRegion();
 
+	int id;
 
+	RegionState state;
 
-   //==> Accessing Modifiable Member functions
-
-
-   //+> EnvRegion ID
-
-   //=========================================================
-   //! Sets the Environmental Region ID
-   //! \param EntityIDIn - The new Environmental Region ID.
-   //!
-   void SetEnvRegionID(unsigned short EnvRegionIDIn) { EnvRegionID = EnvRegionIDIn; }
-
-   //=========================================================
-   //! Gets the Environmental Region ID
-   //! \return The Environmental Region ID.
-   //!
-   unsigned short GetEnvRegionID(void) { return(EnvRegionID); }
-
-
-
-   //==> Accessing Write-Only Member functions
-
-
-   //=========================================================
-   //! Sets the pointer to the position conversion object
-   //! \param PosConvIn - The pointer to the position conversion object.
-   //!
-   void SetPosConv(CoordCigi2DBaseFunctionPtr CoordCigi2DBaseIn,
-                   CoordDBase2CigiFunctionPtr CoordDBase2CigiIn)
-   {
-      CoordCigi2DBase = CoordCigi2DBaseIn;
-      CoordDBase2Cigi = CoordDBase2CigiIn;
-   }
-      
-
-
-   //==> Accessing Read-Only Member functions
-
-   //=========================================================
-   //! Gets the RgnState value.
-   //! \return the current RgnState.
-   CigiBaseEnvRgnCtrl::RgnStateGrp GetRgnState(void) const
-   {
-      return(RgnState);
-   }
-
-   //=========================================================
-   //! Gets the WeatherProp value.
-   //! \return the current WeatherProp.
-   CigiBaseEnvRgnCtrl::MergeCtrlGrp GetWeatherProp(void) const
-   {
-      return(WeatherProp);
-   }
-
-   //=========================================================
-   //! Gets the Aerosol value.
-   //! \return the current Aerosol.
-   CigiBaseEnvRgnCtrl::MergeCtrlGrp GetAerosol(void) const
-   {
-      return(Aerosol);
-   }
-
-   //=========================================================
-   //! Gets the MaritimeSurface value.
-   //! \return the current MaritimeSurface.
-   CigiBaseEnvRgnCtrl::MergeCtrlGrp GetMaritimeSurface(void) const
-   {
-      return(MaritimeSurface);
-   }
-
-   //=========================================================
-   //! Gets the TerrestrialSurface value.
-   //! \return the current TerrestrialSurface.
-   CigiBaseEnvRgnCtrl::MergeCtrlGrp GetTerrestrialSurface(void) const
-   {
-      return(TerrestrialSurface);
-   }
-
-   //=========================================================
-   //! Gets the Lat value.
-   //! \return the current Lat.
-   double GetLat(void) const { return(CigiPos.LatX); }
-
-   //=========================================================
-   //! Gets the Lon value.
-   //! \return the current Lon.
-   double GetLon(void) const { return(CigiPos.LonY); }
-
-   //=========================================================
-   //! Rotation of the environmental region
-   //! \return The rotation in degrees of the environmental region<br>
-   double GetRotation(void) const { return(CigiPos.Yaw); }
+	MergeMode weatherMerge;
+	MergeMode aerosolMerge;
+	MergeMode maritimeSurfaceMerge;
+	MergeMode terrestrialSurfaceMerge;
 
-   //=========================================================
-   //! Gets the XSize value.
-   //! \return the current XSize.
-   float GetXSize(void) const { return(XSize); }
+	//! size of the region along its X (north, before rotation) axis, meters
+	float xSize;
+	//! size of the region along its Y (east, before rotation) axis, meters
+	float ySize;
+	//! radius of the footprint's corners, meters
+	float cornerRadius;
+	//! width of the transition perimeter, meters
+	float transition;
 
-   //=========================================================
-   //! Gets the YSize value.
-   //! \return the current YSize.
-   float GetYSize(void) const { return(YSize); }
-
-   //=========================================================
-   //! Gets the CornerRadius value.
-   //! \return the current CornerRadius.
-   float GetCornerRadius(void) const { return(CornerRadius); }
-
-   //=========================================================
-   //! Gets the Transition value.
-   //! \return the current Transition.
-   float GetTransition(void) const { return(Transition); }
-
-   //=========================================================
-   //! Gets the X position in the database coordinate system.
-   //! \return the current X position.
-   double GetDbaseX(void) const { return(DBasePos.LatX); }
-
-   //=========================================================
-   //! Gets the Y position in the database coordinate system.
-   //! \return the current Y position.
-   double GetDbaseY(void) const { return(DBasePos.LonY); }
-
-   //=========================================================
-   //! Gets the Rotation in the database coordinate system.
-   //! \return the current Database rotation.
-   double GetDbaseRotation(void) const { return(DBasePos.Yaw); }
-
-
-
-   //==> Processing Packets Member functions
-
-
-   //=========================================================
-   //! Processes the environmental region control packet
-   //! \param Packet - A pointer to the received CigiEnvRgnCtrlV3 
-   //!   packet for this environmental region
-   //!
-	void ProcEnvRegionCtrlPckt(CigiEnvRgnCtrlV3 *Packet);
-
-
-   //==> Env Region Processing Member functions
-
-
-   //=========================================================
-   //! Processes the environmental region for this frame.<br>
-   //!   This clears the updated flag to prepair for the next frame.
-   //! \param dTime - The elapsed or delta time in seconds between
-   //!   the last rendered frame and this rendered frame.
-   //!
-   void Act(float dTime) { PcktUpdated = false; }
-
-
-   //==> Environmental Region Extended Data public functions
-
-
-   //=========================================================
-   //! Gets the number of extended data items
-   //! \return - The number of extended data items.
-   //!
-   static int GetExtendedDataCount(void) { return(ExtendedDataCount); }
-
-   //=========================================================
-   //! Gets the number of extended data items
-   //! \return - The number of extended data items.
-   //!
-   static void IncrementExtendedDataCount(void) { ExtendedDataCount++; }
-
-
-
-protected:
-
-   //==> Member variables
-
-   //=========================================================
-   //! Entity ID<br>
-   //! Uniquely identifies the specific environmental region instance<br>
-   //!
-	unsigned short EnvRegionID;
-
-   //=========================================================
-   //! XSize<br>
-   //! X size of the region
-   //!
-   float XSize;
-
-   //=========================================================
-   //! YSize<br>
-   //! Y size of the region
-   //!
-   float YSize;
-
-   //=========================================================
-   //! CornerRadius<br>
-   //! Radius of the corners
-   //!
-   float CornerRadius;
-
-   //=========================================================
-   //! Transition<br>
-   //! Width of the transition band.
-   //!
-   float Transition;
-
-
-   //==> Member flags
-
-   //=========================================================
-   //! RgnState<br>
-   //! Region state control<br>
-   //!  0-Inactive<br>
-   //!  1-Active<br>
-   //!  2-Destroyed
-   //!
-   CigiBaseEnvRgnCtrl::RgnStateGrp RgnState;
-
-   //=========================================================
-   //! WeatherProp<br>
-   //! Weather property merge control
-   //!
-   CigiBaseEnvRgnCtrl::MergeCtrlGrp WeatherProp;
-
-   //=========================================================
-   //! Aerosol<br>
-   //! Aerosol Concentration merge control
-   //!
-   CigiBaseEnvRgnCtrl::MergeCtrlGrp Aerosol;
-
-   //=========================================================
-   //! MaritimeSurface<br>
-   //! Maritime surface conditions merge control
-   //!
-   CigiBaseEnvRgnCtrl::MergeCtrlGrp MaritimeSurface;
-
-   //=========================================================
-   //! TerrestrialSurface<br>
-   //! Terrestrial surface conditions merge control
-   //!
-   CigiBaseEnvRgnCtrl::MergeCtrlGrp TerrestrialSurface;
-
-
-   //==> Position/Attitude/Rate Data
-
-   //=========================================================
-   //! CigiPos<br>
-   //! The Cigi Coordinate Position, and Attitude of the Entity
-   //!
-   CoordSet CigiPos;
-
-   //=========================================================
-   //! DBasePos<br>
-   //! The Database Coordinate Position, and Attitude of the Entity
-   //!
-   CoordSet DBasePos;
-
-
-   //==> Overall Flags and pointers
-
-
-   //=========================================================
-   //! ExtendCount<br>
-   //! The number of extended data items per entity
-   //!
-   static int ExtendedDataCount;
-
-   //=========================================================
-   //! PcktUpdated<br>
-   //! This environmental region has been updated by a CIGI packet this frame
-   //!
-   bool PcktUpdated;
-
-   //=========================================================
-   //! CoordCigi2DBase<br>
-   //! A pointer to the CIGI coordinate to Database coordinate
-   //!  member function of the position conversion plugin 
-   //!
-   CoordCigi2DBaseFunctionPtr CoordCigi2DBase;
-
-   //=========================================================
-   //! CoordDBase2Cigi<br>
-   //! A pointer to the Database coordinate to CIGI coordinate
-   //!  member function of the position conversion plugin 
-   //!
-   CoordDBase2CigiFunctionPtr CoordDBase2Cigi;
+	unsigned int updateSequence;
 
+	LayerMap layers;
 
+	//! source of updateSequence
+	static unsigned int nextUpdateSequence;
 };
 
+}
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
 
 #endif // !defined(_ENVIRONMENTAL_REGION_INCLUDED_)
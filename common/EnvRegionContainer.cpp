@@ -0,0 +1,477 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <math.h>
+#include <algorithm>
+
+#include "BindSlot.h"
+#include "EnvRegionContainer.h"
+
+using namespace mpv;
+
+namespace
+{
+	//! children per R-tree node
+	const int indexNodeSize = 8;
+
+	//! Fields blended by getConditions.  Winds are blended as east/north 
+	//! components.
+	enum Field
+	{
+		Humidity = 0,
+		AirTemp,
+		Visibility,
+		WindEast,
+		WindNorth,
+		VertWind,
+		BaroPressure,
+		NumWeatherFields,
+		Aerosol = NumWeatherFields,
+		NumFields
+	};
+
+	//! Regional conditions, accumulated one region at a time.  coverage is 
+	//! how much of the point the regions cover, from 0 to 1.
+	struct Accumulator
+	{
+		Accumulator() : coverage( 0.0 ) {}
+		double values[NumFields];
+		double coverage;
+	};
+
+	void toFields( float humidity, float airTemp, float visibility, 
+		float horizWind, float windDir, float vertWind, float baro, 
+		float aerosol, double *fields )
+	{
+		double dir = windDir * M_PI / 180.0;
+		fields[Humidity] = humidity;
+		fields[AirTemp] = airTemp;
+		fields[Visibility] = visibility;
+		fields[WindEast] = horizWind * sin( dir );
+		fields[WindNorth] = horizWind * cos( dir );
+		fields[VertWind] = vertWind;
+		fields[BaroPressure] = baro;
+		fields[Aerosol] = aerosol;
+	}
+
+	void toFields( const WeatherCtrl &layer, double *fields )
+	{
+		toFields( layer.GetHumidity(), layer.GetAirTemp(), 
+			layer.GetVisibilityRng(), layer.GetHorizWindSp(), 
+			layer.GetWindDir(), layer.GetVertWindSp(), 
+			layer.GetBaroPress(), layer.GetAerosol(), fields );
+	}
+
+	//! Applies one region's fields [first, last) to an accumulator
+	void accumulate( Accumulator &acc, const double *fields, 
+		int first, int last, double weight, EnvRegion::MergeMode mode )
+	{
+		for( int i = first; i < last; i++ )
+		{
+			if( acc.coverage <= 0.0 )
+				acc.values[i] = fields[i];
+			else if( mode == EnvRegion::Merge )
+				acc.values[i] = ( acc.values[i] * acc.coverage + fields[i] * weight ) / 
+					( acc.coverage + weight );
+			else
+				acc.values[i] += ( fields[i] - acc.values[i] ) * weight;
+		}
+		acc.coverage += weight * ( 1.0 - acc.coverage );
+	}
+
+	bool compareUpdateSequence( const EnvRegion *a, const EnvRegion *b )
+	{
+		return a->getUpdateSequence() < b->getUpdateSequence();
+	}
+}
+
+
+// ================================================
+// EnvRegionContainer
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EnvRegionContainer::EnvRegionContainer() : Referenced(),
+	indexRoot( -1 ),
+	indexDirty( false )
+{
+}
+
+
+// ================================================
+// ~EnvRegionContainer
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EnvRegionContainer::~EnvRegionContainer()
+{
+	flagAllRegionsAsDestroyed();
+}
+
+
+// ================================================
+// addRegion
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::addRegion( EnvRegion *region )
+{
+	if( region == NULL )
+		return;
+
+	region->stateChanged.connect( BIND_SLOT1( EnvRegionContainer::regionChangedState, this ) );
+	region->footprintChanged.connect( BIND_SLOT1( EnvRegionContainer::regionChangedFootprint, this ) );
+	region->positionDBChanged.connect( BIND_SLOT1( EnvRegionContainer::regionChangedPosition, this ) );
+	regions[region->getID()] = region;
+	indexDirty = true;
+
+	addedRegion( this, region );
+}
+
+
+// ================================================
+// removeRegion
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::removeRegion( EnvRegion *region )
+{
+	EnvRegionMap::iterator iter = regions.find( region->getID() );
+	if( iter != regions.end() )
+	{
+		// hold on to a reference until signal emission is complete
+		RefPtr<EnvRegion> regionReference( region );
+
+		region->stateChanged.disconnect( BIND_SLOT1( EnvRegionContainer::regionChangedState, this ) );
+		region->footprintChanged.disconnect( BIND_SLOT1( EnvRegionContainer::regionChangedFootprint, this ) );
+		region->positionDBChanged.disconnect( BIND_SLOT1( EnvRegionContainer::regionChangedPosition, this ) );
+		regions.erase( iter );
+		indexDirty = true;
+
+		removedRegion( this, region );
+	}
+}
+
+
+// ================================================
+// flagAllRegionsAsDestroyed
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::flagAllRegionsAsDestroyed()
+{
+	while( !regions.empty() )
+	{
+		// hold on to a reference until signal emission is complete
+		RefPtr<EnvRegion> region( regions.begin()->second );
+
+		if( region->getState() == EnvRegion::Destroyed )
+			removeRegion( region.get() );
+		else
+			region->setState( EnvRegion::Destroyed );
+		// note - regionChangedState will handle removal of the region 
+		// from the map
+	}
+}
+
+
+// ================================================
+// processGlobalWeatherCtrl
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::processGlobalWeatherCtrl( CigiWeatherCtrlV3 *packet )
+{
+	WeatherCtrl &layer = globalLayers[packet->GetLayerID()];
+	layer.SetLayerID( packet->GetLayerID() );
+	layer.ProcWeatherCtrlPckt( packet );
+}
+
+
+// ================================================
+// regionChangedState
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::regionChangedState( EnvRegion *region )
+{
+	if( region->getState() == EnvRegion::Destroyed )
+		removeRegion( region );
+	else
+		// only active regions are indexed
+		indexDirty = true;
+}
+
+
+// ================================================
+// regionChangedFootprint
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::regionChangedFootprint( EnvRegion * )
+{
+	indexDirty = true;
+}
+
+
+// ================================================
+// regionChangedPosition
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::regionChangedPosition( GeodeticObject * )
+{
+	indexDirty = true;
+}
+
+
+// ================================================
+// updateIndex
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::updateIndex()
+{
+	if( !indexDirty )
+		return;
+	indexDirty = false;
+
+	indexEntries.clear();
+	indexNodes.clear();
+	indexChildren.clear();
+	indexRoot = -1;
+
+	// The items being packed at each level are stored as IndexNodes, with 
+	// 'first' holding the index of the entry or node they stand for
+	std::vector<IndexNode> items;
+	EnvRegionMap::iterator iter;
+	for( iter = regions.begin(); iter != regions.end(); iter++ )
+	{
+		EnvRegion *region = iter->second.get();
+		if( region->getState() != EnvRegion::Active )
+			continue;
+
+		IndexEntry entry;
+		region->getBounds( entry.minX, entry.minY, entry.maxX, entry.maxY );
+		entry.region = region;
+
+		IndexNode item;
+		item.minX = entry.minX;
+		item.minY = entry.minY;
+		item.maxX = entry.maxX;
+		item.maxY = entry.maxY;
+		item.first = (int)indexEntries.size();
+		item.count = 0;
+		item.leaf = true;
+
+		indexEntries.push_back( entry );
+		items.push_back( item );
+	}
+
+	if( items.empty() )
+		return;
+
+	std::vector<IndexNode> parents;
+	bool leaf = true;
+	do
+	{
+		packIndexLevel( items, leaf, parents );
+		items.swap( parents );
+		leaf = false;
+	} while( items.size() > 1 );
+
+	indexRoot = items[0].first;
+}
+
+
+// ================================================
+// packIndexLevel
+// Sort-tile-recursive packing: the items are sorted by x and cut into 
+// vertical slices, each slice is sorted by y, and runs of indexNodeSize 
+// items become nodes.  This gives nodes with little overlap, which is 
+// what keeps point queries logarithmic.
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::packIndexLevel( std::vector<IndexNode> &items, 
+	bool leaf, std::vector<IndexNode> &parents )
+{
+	parents.clear();
+
+	int numItems = (int)items.size();
+	int numNodes = ( numItems + indexNodeSize - 1 ) / indexNodeSize;
+	int numSlices = (int)ceil( sqrt( (double)numNodes ) );
+	int sliceSize = numSlices * indexNodeSize;
+
+	std::sort( items.begin(), items.end(), compareCenterX );
+
+	for( int sliceStart = 0; sliceStart < numItems; sliceStart += sliceSize )
+	{
+		int sliceEnd = std::min( sliceStart + sliceSize, numItems );
+		std::sort( items.begin() + sliceStart, items.begin() + sliceEnd, compareCenterY );
+
+		for( int nodeStart = sliceStart; nodeStart < sliceEnd; nodeStart += indexNodeSize )
+		{
+			int nodeEnd = std::min( nodeStart + indexNodeSize, sliceEnd );
+
+			IndexNode node = items[nodeStart];
+			node.first = (int)indexChildren.size();
+			node.count = nodeEnd - nodeStart;
+			node.leaf = leaf;
+			for( int i = nodeStart; i < nodeEnd; i++ )
+			{
+				const IndexNode &item = items[i];
+				node.minX = std::min( node.minX, item.minX );
+				node.minY = std::min( node.minY, item.minY );
+				node.maxX = std::max( node.maxX, item.maxX );
+				node.maxY = std::max( node.maxY, item.maxY );
+				indexChildren.push_back( item.first );
+			}
+
+			IndexNode parent = node;
+			parent.first = (int)indexNodes.size();
+			indexNodes.push_back( node );
+			parents.push_back( parent );
+		}
+	}
+}
+
+
+// ================================================
+// compareCenterX
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool EnvRegionContainer::compareCenterX( const IndexNode &a, const IndexNode &b )
+{
+	return a.minX + a.maxX < b.minX + b.maxX;
+}
+
+
+// ================================================
+// compareCenterY
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool EnvRegionContainer::compareCenterY( const IndexNode &a, const IndexNode &b )
+{
+	return a.minY + a.maxY < b.minY + b.maxY;
+}
+
+
+// ================================================
+// findRegions
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::findRegions( double x, double y, std::vector<EnvRegion*> &result )
+{
+	result.clear();
+	updateIndex();
+	if( indexRoot < 0 )
+		return;
+
+	queryStack.clear();
+	queryStack.push_back( indexRoot );
+	while( !queryStack.empty() )
+	{
+		const IndexNode &node = indexNodes[queryStack.back()];
+		queryStack.pop_back();
+
+		if( x < node.minX || x > node.maxX || y < node.minY || y > node.maxY )
+			continue;
+
+		for( int i = node.first; i < node.first + node.count; i++ )
+		{
+			int child = indexChildren[i];
+			if( node.leaf )
+			{
+				const IndexEntry &entry = indexEntries[child];
+				if( x >= entry.minX && x <= entry.maxX && 
+					y >= entry.minY && y <= entry.maxY )
+					result.push_back( entry.region );
+			}
+			else
+				queryStack.push_back( child );
+		}
+	}
+
+	std::sort( result.begin(), result.end(), compareUpdateSequence );
+}
+
+
+// ================================================
+// getConditions
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionContainer::getConditions( double x, double y, float altitude, EnvConditions &result )
+{
+	double fields[NumFields];
+	float strongestWeight = 0.0f;
+	int layerID = -1;
+
+	// background: the atmosphere, overridden by any global layer at this 
+	// altitude
+	double background[NumFields];
+	toFields( globalConditions.humidity, globalConditions.airTemp, 
+		globalConditions.visibilityRange, globalConditions.horizWindSpeed, 
+		globalConditions.windDirection, globalConditions.vertWindSpeed, 
+		globalConditions.baroPressure, globalConditions.aerosol, background );
+
+	float layerWeight;
+	const WeatherCtrl *layer = EnvRegion::findLayer( globalLayers, altitude, layerWeight );
+	if( layer != NULL )
+	{
+		toFields( *layer, fields );
+		for( int i = 0; i < NumFields; i++ )
+			background[i] += ( fields[i] - background[i] ) * layerWeight;
+		strongestWeight = layerWeight;
+		layerID = layer->GetLayerID();
+	}
+
+	// regions, in update order
+	Accumulator weather, aerosol;
+	int numRegions = 0;
+
+	findRegions( x, y, queryRegions );
+	std::vector<EnvRegion*>::iterator iter;
+	for( iter = queryRegions.begin(); iter != queryRegions.end(); iter++ )
+	{
+		EnvRegion *region = *iter;
+
+		float weight = region->getInfluence( x, y );
+		if( weight <= 0.0f )
+			continue;
+
+		layer = EnvRegion::findLayer( region->getLayers(), altitude, layerWeight );
+		if( layer == NULL )
+			continue;
+		weight *= layerWeight;
+
+		toFields( *layer, fields );
+		accumulate( weather, fields, 0, NumWeatherFields, weight, region->getWeatherMerge() );
+		accumulate( aerosol, fields, Aerosol, NumFields, weight, region->getAerosolMerge() );
+		numRegions++;
+
+		if( weight >= strongestWeight )
+		{
+			strongestWeight = weight;
+			layerID = layer->GetLayerID();
+		}
+	}
+
+	double blended[NumFields];
+	for( int i = 0; i < NumFields; i++ )
+	{
+		const Accumulator &acc = ( i < NumWeatherFields ) ? weather : aerosol;
+		blended[i] = background[i];
+		if( acc.coverage > 0.0 )
+			blended[i] += ( acc.values[i] - background[i] ) * acc.coverage;
+	}
+
+	result.humidity = (float)blended[Humidity];
+	result.airTemp = (float)blended[AirTemp];
+	result.visibilityRange = (float)blended[Visibility];
+	result.horizWindSpeed = (float)sqrt( 
+		blended[WindEast] * blended[WindEast] + blended[WindNorth] * blended[WindNorth] );
+	double windDirection = atan2( blended[WindEast], blended[WindNorth] ) * 180.0 / M_PI;
+	result.windDirection = (float)( windDirection < 0.0 ? windDirection + 360.0 : windDirection );
+	result.vertWindSpeed = (float)blended[VertWind];
+	result.baroPressure = (float)blended[BaroPressure];
+	result.aerosol = (float)blended[Aerosol];
+	result.layerID = layerID;
+	result.numRegions = numRegions;
+}
@@ -0,0 +1,203 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _ENV_REGION_CONTAINER_H_
+#define _ENV_REGION_CONTAINER_H_
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "Referenced.h"
+#include "EnvRegion.h"
+#include "MPVCommonTypes.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! Holds the environmental regions, and answers "what are the conditions 
+//! at this point".  The active regions' footprints are kept in an R-tree 
+//! (packed with the sort-tile-recursive method, and rebuilt whenever a 
+//! footprint changes), so a query visits O(log n) nodes plus the regions 
+//! that actually overlap the point.
+//! 
+//! Overlapping regions are applied in update order (see 
+//! EnvRegion::getUpdateSequence).  Each is weighted by its transition 
+//! perimeter and by the vertical transition of the weather layer that 
+//! applies at the query altitude.  A Use Last region replaces the 
+//! regional conditions beneath it in proportion to its weight; a Merge 
+//! region is averaged with them.  The result is then blended with the 
+//! global conditions by the regions' combined coverage.  Winds are 
+//! blended as vectors.
+//! 
+//! Queries rebuild the index if it is out of date, so they must not run 
+//! concurrently with each other or with region updates.
+//! 
+class MPVCMN_SPEC EnvRegionContainer : public Referenced
+{
+public:
+
+	boost::signal<void (EnvRegionContainer*, EnvRegion*)> addedRegion;
+	boost::signal<void (EnvRegionContainer*, EnvRegion*)> removedRegion;
+
+	typedef std::map< int, RefPtr<EnvRegion> > EnvRegionMap;
+	typedef std::pair< EnvRegionMap::iterator, EnvRegionMap::iterator > EnvRegionIteratorPair;
+
+	//=========================================================
+	//! General Constructor
+	//! 
+	EnvRegionContainer();
+
+	//=========================================================
+	//! Adds a region.  The region is removed automatically when its 
+	//! state changes to Destroyed.
+	//! 
+	void addRegion( EnvRegion *region );
+
+	void removeRegion( EnvRegion *region );
+
+	//=========================================================
+	//! Flags each region as destroyed, which removes it
+	//! 
+	void flagAllRegionsAsDestroyed();
+
+	EnvRegion *findRegion( int regionID )
+	{
+		EnvRegionMap::iterator iter = regions.find( regionID );
+		if( iter != regions.end() )
+			return iter->second.get();
+		return NULL;
+	}
+
+	EnvRegionIteratorPair getRegions()
+	{
+		return EnvRegionIteratorPair( regions.begin(), regions.end() );
+	}
+
+	//=========================================================
+	//! Sets the conditions that apply outside all regions and layers, 
+	//! ie those from the Atmosphere Control packet
+	//! 
+	void setGlobalConditions( const EnvConditions &conditions ) { globalConditions = conditions; }
+
+	const EnvConditions &getGlobalConditions() const { return globalConditions; }
+
+	//=========================================================
+	//! Processes a global-scope weather control packet
+	//! 
+	void processGlobalWeatherCtrl( CigiWeatherCtrlV3 *packet );
+
+	const EnvRegion::LayerMap &getGlobalLayers() const { return globalLayers; }
+
+	//=========================================================
+	//! Rebuilds the spatial index if any region has changed since it was 
+	//! last built.  Queries do this themselves; calling it once per frame 
+	//! keeps the cost out of the first query.
+	//! 
+	void updateIndex();
+
+	//=========================================================
+	//! Computes the conditions at a point
+	//! \param x - database x
+	//! \param y - database y
+	//! \param altitude - meters MSL; selects the weather layers
+	//! \param result - receives the conditions
+	//! 
+	void getConditions( double x, double y, float altitude, EnvConditions &result );
+
+	//=========================================================
+	//! Finds the active regions whose footprint (including the transition 
+	//! perimeter) contains a point.  The result is sorted by update order.
+	//! \param x - database x
+	//! \param y - database y
+	//! \param result - cleared, then filled with the regions
+	//! 
+	void findRegions( double x, double y, std::vector<EnvRegion*> &result );
+
+protected:
+
+	//=========================================================
+	//! General Destructor
+	//! 
+	virtual ~EnvRegionContainer();
+
+	void regionChangedState( EnvRegion *region );
+	void regionChangedFootprint( EnvRegion *region );
+	void regionChangedPosition( GeodeticObject *region );
+
+	//! One node of the R-tree.  Its children are 
+	//! indexChildren[first .. first+count-1], which are indices into 
+	//! indexEntries for a leaf, and into indexNodes otherwise.
+	struct IndexNode
+	{
+		double minX, minY, maxX, maxY;
+		int first;
+		int count;
+		bool leaf;
+	};
+
+	struct IndexEntry
+	{
+		double minX, minY, maxX, maxY;
+		EnvRegion *region;
+	};
+
+	//! Packs one level of the tree; see the .cpp
+	void packIndexLevel( std::vector<IndexNode> &items, bool leaf, 
+		std::vector<IndexNode> &parents );
+
+	static bool compareCenterX( const IndexNode &a, const IndexNode &b );
+	static bool compareCenterY( const IndexNode &a, const IndexNode &b );
+
+	EnvRegionMap regions;
+
+	EnvConditions globalConditions;
+
+	EnvRegion::LayerMap globalLayers;
+
+	std::vector<IndexEntry> indexEntries;
+	std::vector<IndexNode> indexNodes;
+	std::vector<int> indexChildren;
+	int indexRoot;
+	bool indexDirty;
+
+	//! scratch space for queries
+	std::vector<int> queryStack;
+	std::vector<EnvRegion*> queryRegions;
+};
+
+}
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,177 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <OpenThreads/ScopedLock>
+
+#include "CigiRecording.h"
+#include "FrameHandoff.h"
+
+using namespace mpv;
+
+
+// ================================================
+// FrameHandoff
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+FrameHandoff::FrameHandoff() : 
+	readerAttached( false ),
+	writing( false ),
+	reading( false ),
+	writeFrame( 0 ),
+	writeStartTime( 0.0 ),
+	publishedFrame( 0 ),
+	publishedWriteStartTime( 0.0 ),
+	readFrame( 0 )
+{
+}
+
+
+// ================================================
+// ~FrameHandoff
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+FrameHandoff::~FrameHandoff()
+{
+}
+
+
+// ================================================
+// beginWrite
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void FrameHandoff::beginWrite()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+
+	// wait for the reader to finish with the last frame; if it hasn't 
+	// started on it yet, wait for that too, or a kernel that runs faster 
+	// than the reader would keep it from ever getting a turn
+	while( readerAttached && ( reading || readFrame != publishedFrame ) )
+		condition.wait( &mutex );
+
+	writing = true;
+	writeFrame++;
+	writeStartTime = cigiRecordingClock();
+}
+
+
+// ================================================
+// endWrite
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void FrameHandoff::endWrite()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+
+	writing = false;
+	publishedFrame = writeFrame;
+	publishedWriteStartTime = writeStartTime;
+	condition.broadcast();
+}
+
+
+// ================================================
+// beginRead
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool FrameHandoff::beginRead( unsigned int &frame, double &startTime )
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+
+	while( readerAttached && ( writing || readFrame == publishedFrame ) )
+		condition.wait( &mutex );
+
+	if( !readerAttached )
+		return false;
+
+	reading = true;
+	readFrame = publishedFrame;
+	frame = publishedFrame;
+	startTime = publishedWriteStartTime;
+	return true;
+}
+
+
+// ================================================
+// endRead
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void FrameHandoff::endRead()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+
+	reading = false;
+	condition.broadcast();
+}
+
+
+// ================================================
+// attachReader
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void FrameHandoff::attachReader()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+
+	readerAttached = true;
+	reading = false;
+	// frames published before the reader arrived are of no interest to it
+	readFrame = publishedFrame;
+}
+
+
+// ================================================
+// detachReader
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void FrameHandoff::detachReader()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+
+	readerAttached = false;
+	condition.broadcast();
+}
+
+
+// ================================================
+// isReaderAttached
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool FrameHandoff::isReaderAttached()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	return readerAttached;
+}
+
+
+// ================================================
+// getWriteFrame
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+unsigned int FrameHandoff::getWriteFrame()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	return writeFrame;
+}
+
+
+// ================================================
+// getWriteStartTime
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+double FrameHandoff::getWriteStartTime()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	return writeStartTime;
+}
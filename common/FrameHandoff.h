@@ -0,0 +1,138 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _FRAME_HANDOFF_H_
+#define _FRAME_HANDOFF_H_
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/Condition>
+
+#include "MPVCommonTypes.h"
+
+namespace mpv
+{
+
+//=========================================================
+//! Hands each frame's state from the kernel thread, which writes it while 
+//! it receives the Host's messages and the plugins act, to a single 
+//! reader thread (ie a render thread), which reads it while the kernel is 
+//! sending and waiting.
+//! 
+//! The kernel brackets everything that changes the state, from receiving 
+//! through the plugins' act() calls, with beginWrite() and endWrite().  
+//! When a reader is attached, beginWrite() waits until the 
+//! reader has finished with the previous frame, so the reader sees every 
+//! frame, and never sees one half-written.  The reader brackets its reads 
+//! with beginRead() and endRead(); anything it copied out (such as an OSG 
+//! draw thread's render stages) can be used after endRead(), concurrently 
+//! with the kernel's writes to the next frame.
+//! 
+//! With no reader attached, beginWrite() and endWrite() never block.
+//! 
+class MPVCMN_SPEC FrameHandoff
+{
+public:
+
+	FrameHandoff();
+	~FrameHandoff();
+
+	//=========================================================
+	//! Called by the kernel before it receives the Host's messages
+	//! 
+	void beginWrite();
+
+	//=========================================================
+	//! Called by the kernel after the plugins act; publishes the frame
+	//! 
+	void endWrite();
+
+	//=========================================================
+	//! Called by the reader thread.  Waits for a frame that hasn't been 
+	//! read yet.
+	//! \param frame - set to the frame's number
+	//! \param writeStartTime - set to the time (see cigiRecordingClock()) 
+	//!     at which the kernel began writing the frame
+	//! \return false if the reader has been detached, in which case the 
+	//!     reader should exit without calling endRead()
+	//! 
+	bool beginRead( unsigned int &frame, double &writeStartTime );
+
+	//=========================================================
+	//! Called by the reader thread when it no longer needs the frame's 
+	//! state
+	//! 
+	void endRead();
+
+	//=========================================================
+	//! Attaches the reader.  Must be called from the kernel thread, ie 
+	//! from a plugin's act(); the first frame the reader sees is the one 
+	//! being written.
+	//! 
+	void attachReader();
+
+	//=========================================================
+	//! Detaches the reader, waking it if it is waiting in beginRead().  
+	//! May be called from any thread, including from a plugin's act().
+	//! 
+	void detachReader();
+
+	bool isReaderAttached();
+
+	//=========================================================
+	//! Returns the number of the frame being written, or last written
+	//! 
+	unsigned int getWriteFrame();
+
+	//=========================================================
+	//! Returns the time at which the kernel began writing the current 
+	//! (or last) frame
+	//! 
+	double getWriteStartTime();
+
+private:
+
+	OpenThreads::Mutex mutex;
+	OpenThreads::Condition condition;
+
+	bool readerAttached;
+	bool writing;
+	bool reading;
+
+	//! number of the frame being written, or last written
+	unsigned int writeFrame;
+	double writeStartTime;
+
+	//! number of the last frame the kernel finished writing
+	unsigned int publishedFrame;
+	double publishedWriteStartTime;
+
+	//! number of the last frame the reader began reading; frames are 
+	//! numbered from 1, so 0 means none
+	unsigned int readFrame;
+};
+
+}
+
+#endif
@@ -0,0 +1,410 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <time.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#include <syslog.h>
+#endif
+
+#include <OpenThreads/ScopedLock>
+
+#include "MemoryFence.h"
+#include "Log.h"
+
+using namespace mpv;
+
+
+LogSite::LogSite( const char *_file, int _line ) :
+	file( _file ),
+	line( _line ),
+	windowStart( 0.0 ),
+	emittedInWindow( 0 ),
+	suppressed( 0 ),
+	registered( false )
+{
+}
+
+
+Log &Log::instance()
+{
+	static Log log;
+	return log;
+}
+
+
+Log::Log() : OpenThreads::Thread(),
+	minimumSeverity( Info ),
+	maxPerInterval( 5 ),
+	rateInterval( 1.0 ),
+	destination( Console ),
+	file( NULL ),
+	writerRunning( false ),
+	writerShouldExit( false ),
+	droppedEntries( 0 )
+{
+}
+
+
+Log::~Log()
+{
+	stopWriter();
+
+	if( file != NULL )
+		fclose( file );
+#ifndef WIN32
+	if( destination == Syslog )
+		closelog();
+#endif
+}
+
+
+bool Log::setDestination( Destination dest, const std::string &filename )
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+
+	// the writer thread may be in the middle of output()
+	if( writerRunning )
+		return false;
+
+	if( file != NULL )
+	{
+		fclose( file );
+		file = NULL;
+	}
+#ifndef WIN32
+	if( destination == Syslog )
+		closelog();
+#endif
+
+	destination = Console;
+
+	if( dest == File )
+	{
+		file = fopen( filename.c_str(), "a" );
+		if( file == NULL )
+			return false;
+		destination = File;
+	}
+	else if( dest == Syslog )
+	{
+#ifdef WIN32
+		return false;
+#else
+		openlog( "mpv", LOG_PID, LOG_USER );
+		destination = Syslog;
+#endif
+	}
+
+	return true;
+}
+
+
+void Log::setMinimumSeverity( Severity severity )
+{
+	// an int is written in one piece; the fence publishes it to the 
+	// threads calling shouldLog()
+	minimumSeverity = severity;
+	memoryFence();
+}
+
+
+void Log::setRateLimit( unsigned int _maxPerInterval, double intervalSeconds )
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	maxPerInterval = _maxPerInterval;
+	rateInterval = intervalSeconds > 0.0 ? intervalSeconds : 1.0;
+}
+
+
+void Log::startWriter()
+{
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+		if( writerRunning )
+			return;
+		writerRunning = true;
+		writerShouldExit = false;
+	}
+	start();
+}
+
+
+void Log::stopWriter()
+{
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+		if( !writerRunning )
+			return;
+		writerShouldExit = true;
+		queueCondition.signal();
+	}
+	join();
+
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	writerRunning = false;
+
+	// anything that raced in after the writer exited is written here
+	flushSuppressed( now() + rateInterval );
+	while( !queue.empty() )
+	{
+		output( queue.front() );
+		queue.pop_front();
+	}
+}
+
+
+bool Log::shouldLog( LogSite &site, Severity severity )
+{
+	if( severity < minimumSeverity )
+		return false;
+
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+
+	if( !site.registered )
+	{
+		sites.push_back( &site );
+		site.registered = true;
+	}
+
+	if( maxPerInterval == 0 )
+		return true;
+
+	double t = now();
+	if( t - site.windowStart >= rateInterval )
+	{
+		if( site.suppressed > 0 )
+		{
+			std::ostringstream summary;
+			summary << site.suppressed
+				<< " similar messages suppressed ("
+				<< site.file << ":" << site.line << ")";
+			enqueue( Notice, summary.str() );
+		}
+		site.windowStart = t;
+		site.emittedInWindow = 0;
+		site.suppressed = 0;
+	}
+
+	if( site.emittedInWindow < maxPerInterval )
+	{
+		site.emittedInWindow++;
+		return true;
+	}
+
+	site.suppressed++;
+	return false;
+}
+
+
+void Log::write( LogSite &, Severity severity, const std::string &message )
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	enqueue( severity, message );
+}
+
+
+void Log::enqueue( Severity severity, const std::string &text )
+{
+	Entry entry;
+	entry.severity = severity;
+	entry.text = text;
+
+	if( !writerRunning )
+	{
+		output( entry );
+		return;
+	}
+
+	if( queue.size() >= maxQueueLength )
+	{
+		droppedEntries++;
+		return;
+	}
+
+	queue.push_back( entry );
+	queueCondition.signal();
+}
+
+
+void Log::flushSuppressed( double t )
+{
+	std::list<LogSite *>::iterator iter = sites.begin();
+	for( ; iter != sites.end(); iter++ )
+	{
+		LogSite *site = *iter;
+		if( site->suppressed > 0 && t - site->windowStart >= rateInterval )
+		{
+			std::ostringstream summary;
+			summary << site->suppressed
+				<< " similar messages suppressed ("
+				<< site->file << ":" << site->line << ")";
+			Entry entry;
+			entry.severity = Notice;
+			entry.text = summary.str();
+			queue.push_back( entry );
+
+			// start a fresh window, so that the next message from this
+			// site is written
+			site->windowStart = 0.0;
+			site->emittedInWindow = 0;
+			site->suppressed = 0;
+		}
+	}
+
+	if( droppedEntries > 0 )
+	{
+		std::ostringstream summary;
+		summary << "log queue overflowed; " << droppedEntries
+			<< " messages dropped";
+		Entry entry;
+		entry.severity = Warning;
+		entry.text = summary.str();
+		queue.push_back( entry );
+		droppedEntries = 0;
+	}
+}
+
+
+void Log::run()
+{
+	std::deque<Entry> pending;
+
+	while( true )
+	{
+		{
+			OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+
+			if( queue.empty() && !writerShouldExit )
+			{
+				// wake up periodically, so that summaries for sites that
+				// have gone quiet still get written
+				queueCondition.wait( &mutex,
+					(unsigned long)( rateInterval * 1000.0 ) );
+			}
+
+			flushSuppressed( now() );
+			pending.swap( queue );
+
+			if( pending.empty() && writerShouldExit )
+				break;
+		}
+
+		// I/O happens outside the lock, so that producers never wait on it
+		while( !pending.empty() )
+		{
+			output( pending.front() );
+			pending.pop_front();
+		}
+	}
+}
+
+
+void Log::output( const Entry &entry )
+{
+	switch( destination )
+	{
+#ifndef WIN32
+	case Syslog:
+		{
+			int priority = LOG_INFO;
+			switch( entry.severity )
+			{
+			case Debug:   priority = LOG_DEBUG; break;
+			case Info:    priority = LOG_INFO; break;
+			case Notice:  priority = LOG_NOTICE; break;
+			case Warning: priority = LOG_WARNING; break;
+			case Error:   priority = LOG_ERR; break;
+			}
+			syslog( priority, "%s", entry.text.c_str() );
+		}
+		break;
+#endif
+	case File:
+		if( file != NULL )
+		{
+			time_t seconds = time( NULL );
+			char stamp[32];
+			strftime( stamp, sizeof( stamp ), "%Y-%m-%d %H:%M:%S",
+				localtime( &seconds ) );
+			fprintf( file, "%s %s - %s\n", stamp,
+				getSeverityName( entry.severity ), entry.text.c_str() );
+			fflush( file );
+			break;
+		}
+		// fall through to the console if the file couldn't be opened
+	default:
+		fprintf( stdout, "%s - %s\n",
+			getSeverityName( entry.severity ), entry.text.c_str() );
+		fflush( stdout );
+		break;
+	}
+}
+
+
+const char *Log::getSeverityName( Severity severity )
+{
+	switch( severity )
+	{
+	case Debug:   return "Debug";
+	case Info:    return "Info";
+	case Notice:  return "Note";
+	case Warning: return "Warning";
+	case Error:   return "Error";
+	}
+	return "Unknown";
+}
+
+
+Log::Severity Log::parseSeverityName( const std::string &name )
+{
+	if( name == "debug" )
+		return Debug;
+	if( name == "notice" )
+		return Notice;
+	if( name == "warning" )
+		return Warning;
+	if( name == "error" )
+		return Error;
+	return Info;
+}
+
+
+#ifdef WIN32
+double Log::now()
+{
+	return (double)GetTickCount() / 1000.0;
+}
+#else
+double Log::now()
+{
+	struct timeval tv;
+	gettimeofday( &tv, NULL );
+	return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+}
+#endif
@@ -0,0 +1,255 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_LOG_H_
+#define _MPV_LOG_H_
+
+#include <string>
+#include <list>
+#include <deque>
+#include <sstream>
+#include <cstdio>
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Thread>
+
+#include "MPVCommonTypes.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! Per-call-site bookkeeping for the rate limiter.  One of these is
+//! declared (statically) by each MPV_LOG statement; it should not normally
+//! be used directly.
+//!
+struct MPVCMN_SPEC LogSite
+{
+	LogSite( const char *file, int line );
+
+	const char *file;
+	int line;
+
+	//! start of the current rate-limiting window, in seconds
+	double windowStart;
+
+	//! number of messages emitted in the current window
+	unsigned int emittedInWindow;
+
+	//! number of messages dropped since the last one that was emitted
+	unsigned int suppressed;
+
+	//! true once the site has been added to the Log's site list
+	bool registered;
+};
+
+
+//=========================================================
+//! A diagnostics log with severity levels, per-call-site rate limiting,
+//! and an asynchronous writer thread.  Formatting is done by the caller;
+//! the actual I/O (console, file or syslog) happens on the writer thread,
+//! so a flood of warnings from a misbehaving host won't stall the frame
+//! on terminal output.
+//!
+//! Use the MPV_LOG macro (or one of its severity-specific variants) rather
+//! than calling write() directly, so that each call site gets its own
+//! rate limiter.
+//!
+class MPVCMN_SPEC Log : protected OpenThreads::Thread
+{
+public:
+
+	enum Severity
+	{
+		Debug = 0,
+		Info,
+		Notice,
+		Warning,
+		Error
+	};
+
+	enum Destination
+	{
+		Console,
+		File,
+		Syslog
+	};
+
+	//=========================================================
+	//! Returns the process-wide log.
+	//!
+	static Log &instance();
+
+	//=========================================================
+	//! Selects where messages are written.  Must be called before
+	//! startWriter(); the writer thread uses the destination without the
+	//! lock, so once it is running the destination can't change.
+	//! \param dest - the destination
+	//! \param filename - the file to append to; used only when dest is File
+	//! \return false if the destination could not be opened, in which case
+	//!         the log falls back to the console, or if the writer thread
+	//!         is running, in which case the destination is unchanged
+	//!
+	bool setDestination( Destination dest, const std::string &filename = "" );
+
+	//=========================================================
+	//! Messages below this severity are discarded at the call site,
+	//! without being formatted.  May be called from any thread.
+	//!
+	void setMinimumSeverity( Severity severity );
+	Severity getMinimumSeverity() const { return (Severity)minimumSeverity; }
+
+	//=========================================================
+	//! Sets the rate limit applied to each call site.  At most
+	//! maxPerInterval messages are written per site per interval; the
+	//! remainder are counted and reported in a summary line.  A
+	//! maxPerInterval of 0 disables rate limiting.
+	//!
+	void setRateLimit( unsigned int maxPerInterval, double intervalSeconds );
+
+	//=========================================================
+	//! Starts the writer thread.  Until this is called, messages are
+	//! written synchronously by the calling thread.
+	//!
+	void startWriter();
+
+	//=========================================================
+	//! Stops the writer thread, after draining any queued messages.
+	//!
+	void stopWriter();
+
+	//=========================================================
+	//! Called by MPV_LOG before formatting a message.  Updates the site's
+	//! rate limiter.
+	//! \return true if the message should be formatted and written
+	//!
+	bool shouldLog( LogSite &site, Severity severity );
+
+	//=========================================================
+	//! Queues a formatted message for the writer thread.
+	//!
+	void write( LogSite &site, Severity severity, const std::string &message );
+
+	//=========================================================
+	//! Returns a short name for the given severity, ie "Warning".
+	//!
+	static const char *getSeverityName( Severity severity );
+
+	//=========================================================
+	//! Parses a severity name, as used in the def files.  Unrecognized
+	//! names produce Info.
+	//!
+	static Severity parseSeverityName( const std::string &name );
+
+protected:
+
+	Log();
+	virtual ~Log();
+
+	//! writer thread main loop
+	virtual void run();
+
+	struct Entry
+	{
+		Severity severity;
+		std::string text;
+	};
+
+	//! Appends an entry to the queue, or writes it immediately if the
+	//! writer isn't running.  Caller must hold mutex.
+	void enqueue( Severity severity, const std::string &text );
+
+	//! Writes a single entry to the current destination.
+	void output( const Entry &entry );
+
+	//! Emits summaries for sites whose windows have expired with
+	//! messages still suppressed.  Caller must hold mutex.
+	void flushSuppressed( double now );
+
+	//! Monotonic-ish wall clock, in seconds.
+	static double now();
+
+	//! read by shouldLog() without taking the mutex, so that a message
+	//! that is filtered out costs no more than a comparison
+	volatile int minimumSeverity;
+	unsigned int maxPerInterval;
+	double rateInterval;
+
+	Destination destination;
+	FILE *file;
+
+	bool writerRunning;
+	bool writerShouldExit;
+
+	//! protects the queue, the site list and the destination
+	OpenThreads::Mutex mutex;
+	OpenThreads::Condition queueCondition;
+
+	std::deque<Entry> queue;
+	std::list<LogSite *> sites;
+
+	//! maximum number of queued entries; beyond this, entries are dropped
+	//! and counted rather than letting the queue grow without bound
+	static const unsigned int maxQueueLength = 4096;
+	unsigned int droppedEntries;
+};
+
+}
+
+
+//=========================================================
+//! Writes a rate-limited message to the MPV log.  The message argument
+//! is a stream expression, ie
+//! MPV_LOG( mpv::Log::Warning, "entity " << id << " doesn't exist" );
+//! The stream expression is not evaluated if the message is filtered out.
+//!
+#define MPV_LOG( severity, message ) \
+	do { \
+		static mpv::LogSite mpvLogSite_( __FILE__, __LINE__ ); \
+		if( mpv::Log::instance().shouldLog( mpvLogSite_, severity ) ) \
+		{ \
+			std::ostringstream mpvLogStream_; \
+			mpvLogStream_ << message; \
+			mpv::Log::instance().write( mpvLogSite_, severity, mpvLogStream_.str() ); \
+		} \
+	} while( 0 )
+
+#define MPV_LOG_DEBUG( message )   MPV_LOG( mpv::Log::Debug, message )
+#define MPV_LOG_INFO( message )    MPV_LOG( mpv::Log::Info, message )
+#define MPV_LOG_NOTICE( message )  MPV_LOG( mpv::Log::Notice, message )
+#define MPV_LOG_WARNING( message ) MPV_LOG( mpv::Log::Warning, message )
+#define MPV_LOG_ERROR( message )   MPV_LOG( mpv::Log::Error, message )
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,57 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_MEMORY_FENCE_H_
+#define _MPV_MEMORY_FENCE_H_
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! A full hardware and compiler memory barrier.  Used by the lock-free
+//! structures that communicate through plain (volatile) integers, which
+//! may live in memory shared between processes, where OpenThreads'
+//! mutexes and atomics can't go.
+//!
+inline void memoryFence()
+{
+#if defined(_MSC_VER)
+	_ReadWriteBarrier();
+	_mm_mfence();
+	_ReadWriteBarrier();
+#elif defined(__GNUC__)
+	__sync_synchronize();
+#else
+#error "mpv::memoryFence() needs an implementation for this compiler"
+#endif
+}
+
+}
+
+#endif
@@ -31,6 +31,10 @@
  *  
  *  03/29/2004 Andrew Sampson                       MPV_CR_DR_1
  *  Initial Release.
+ *  
+ *  2026-10-19
+ *      Added sendMany, which sends several datagrams in one call where 
+ *      the platform allows
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -40,6 +44,7 @@
 
 #include <stdio.h>
 #include <fcntl.h>
+#include <string.h>
 #include <stdio.h>
 
 // ================================================
@@ -136,6 +141,55 @@ int Network::send( unsigned char * sendbuff, int sendsize )
 
 }
 
+// ================================================
+// sendMany
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int Network::sendMany( unsigned char * const * sendbuffs, const int * sendsizes, int count )
+{
+	if( !valid ) return -1;
+
+#if defined(__linux__) && !defined(JUST_IP_ADDRESSES)
+	if( !saddr ) return -1;
+
+	// sendmmsg takes at most UIO_MAXIOV messages; send in batches
+	const int batchSize = 64;
+	struct mmsghdr headers[batchSize];
+	struct iovec vectors[batchSize];
+	int sent = 0;
+	while( sent < count )
+	{
+		int batch = count - sent;
+		if( batch > batchSize )
+			batch = batchSize;
+
+		memset( headers, 0, sizeof( headers[0] ) * batch );
+		for( int i = 0; i < batch; i++ )
+		{
+			vectors[i].iov_base = sendbuffs[sent + i];
+			vectors[i].iov_len = sendsizes[sent + i];
+			headers[i].msg_hdr.msg_name = saddr->ai_addr;
+			headers[i].msg_hdr.msg_namelen = saddr->ai_addrlen;
+			headers[i].msg_hdr.msg_iov = &vectors[i];
+			headers[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		int result = sendmmsg( sndsock, headers, batch, 0 );
+		if( result <= 0 )
+			return sent > 0 ? sent : -1;
+		sent += result;
+	}
+	return sent;
+#else
+	int sent = 0;
+	for( ; sent < count; sent++ )
+	{
+		if( send( sendbuffs[sent], sendsizes[sent] ) < 0 )
+			return sent > 0 ? sent : -1;
+	}
+	return sent;
+#endif
+}
+
 // ================================================
 // recv
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
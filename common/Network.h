@@ -31,6 +31,10 @@
  *  
  *  03/29/2004 Andrew Sampson                       MPV_CR_DR_1
  *  Initial Release.
+ *  
+ *  2026-10-19
+ *      Added sendMany, which sends several datagrams in one call where 
+ *      the platform allows
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -117,6 +121,17 @@ public:
    //!
 	int send( unsigned char * sendbuff, int sendsize ) ;
 
+   //=========================================================
+   //! Sends several messages, each as its own datagram.  On Linux this 
+   //! takes a single system call.
+   //! \param sendbuffs - The messages
+   //! \param sendsizes - The size of each message
+   //! \param count - The number of messages
+   //!
+   //! \return The number of messages sent, or -1 on error.
+   //!
+	int sendMany( unsigned char * const * sendbuffs, const int * sendsizes, int count ) ;
+
    //=========================================================
    //! Receive a message
    //! \param rcvbuff - A pointer to the buffer to place the
@@ -0,0 +1,67 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include "RandomStream.h"
+
+using namespace mpv;
+
+
+// ================================================
+// fill
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void RandomStream::fill( float *values, int count, float minimum, float maximum, 
+	unsigned int firstIndex ) const
+{
+	float span = maximum - minimum;
+	for( int i = 0; i < count; i++ )
+		values[i] = minimum + span * toFloat( at( firstIndex + i ) );
+}
+
+
+// ================================================
+// fill
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void RandomStream::fill( int *values, int count, int minimum, int maximum, 
+	unsigned int firstIndex ) const
+{
+	for( int i = 0; i < count; i++ )
+		values[i] = toInt( at( firstIndex + i ), minimum, maximum );
+}
+
+
+// ================================================
+// getStreamID
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+unsigned int SyncedRandom::getStreamID( const char *name )
+{
+	// 32 bit FNV-1a
+	unsigned int hash = 2166136261u;
+	for( const unsigned char *c = (const unsigned char *)name; *c != '\0'; c++ )
+	{
+		hash ^= *c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
@@ -0,0 +1,200 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_RANDOM_STREAM_H_
+#define _MPV_RANDOM_STREAM_H_
+
+#include "MPVCommonTypes.h"
+
+namespace mpv
+{
+
+//=========================================================
+//! A counter-based random number generator.  The value at a given 
+//! (stream, frame, index) is a fixed hash of those three numbers, so:
+//! - each consumer that uses its own stream ID gets its own sequence, 
+//!   unaffected by how many numbers anyone else draws;
+//! - any index can be computed directly, so a bulk fill can be split 
+//!   across threads and still give the same values;
+//! - IGs that agree on the frame number (see SyncedRandom) agree on 
+//!   every value, which keeps multi-channel IGs in sync.
+//! 
+//! A RandomStream object is just the stream's key plus a counter; it is 
+//! cheap to create on the stack, and is not shared between threads.
+//! 
+class MPVCMN_SPEC RandomStream
+{
+public:
+	
+	RandomStream() : key( 0 ), index( 0 ) {}
+	
+	//=========================================================
+	//! \param streamID - the consumer's stream (see SyncedRandom::getStreamID)
+	//! \param frame - the frame number
+	//! \param firstIndex - the index of the first value next() returns
+	//! 
+	RandomStream( unsigned int streamID, unsigned int frame, unsigned int firstIndex = 0 ) : 
+		key( makeKey( streamID, frame ) ), 
+		index( firstIndex )
+	{}
+	
+	//=========================================================
+	//! Returns the value at the given index, without moving the counter
+	//! 
+	unsigned int at( unsigned int i ) const
+	{
+		return (unsigned int)( mix( key + (unsigned long long)i * 0x9e3779b97f4a7c15ULL ) >> 32 );
+	}
+	
+	//! Returns the next 32 bit value
+	unsigned int next() { return at( index++ ); }
+	
+	//! Returns the next value as a float in [0, 1)
+	float nextFloat() { return toFloat( next() ); }
+	
+	//! Returns the next value as a float in [minimum, maximum)
+	float nextFloat( float minimum, float maximum )
+	{
+		return minimum + ( maximum - minimum ) * nextFloat();
+	}
+	
+	//! Returns the next value as an int in [minimum, maximum]
+	int nextInt( int minimum, int maximum )
+	{
+		return toInt( next(), minimum, maximum );
+	}
+	
+	//=========================================================
+	//! Fills an array with floats in [minimum, maximum), taking values 
+	//! from indices firstIndex through firstIndex + count - 1.  Does not 
+	//! move the counter, so threads can fill separate parts of an array 
+	//! from one stream.
+	//! 
+	void fill( float *values, int count, float minimum, float maximum, 
+		unsigned int firstIndex ) const;
+	
+	//=========================================================
+	//! Fills an array with ints in [minimum, maximum]; see above
+	//! 
+	void fill( int *values, int count, int minimum, int maximum, 
+		unsigned int firstIndex ) const;
+	
+	//=========================================================
+	//! Fills an array from the counter, and moves the counter past the 
+	//! values used
+	//! 
+	void fill( float *values, int count, float minimum, float maximum )
+	{
+		fill( values, count, minimum, maximum, index );
+		index += count;
+	}
+	
+	void fill( int *values, int count, int minimum, int maximum )
+	{
+		fill( values, count, minimum, maximum, index );
+		index += count;
+	}
+	
+	unsigned int getIndex() const { return index; }
+	void setIndex( unsigned int i ) { index = i; }
+	
+	//! Converts a value to a float in [0, 1), using its top 24 bits
+	static float toFloat( unsigned int v )
+	{
+		return (float)( v >> 8 ) * ( 1.0f / 16777216.0f );
+	}
+	
+	//! Converts a value to an int in [minimum, maximum], without modulo bias
+	static int toInt( unsigned int v, int minimum, int maximum )
+	{
+		unsigned long long span = (unsigned long long)( (long long)maximum - minimum + 1 );
+		return (int)( minimum + (long long)( ( span * v ) >> 32 ) );
+	}
+	
+private:
+	
+	//! splitmix64's finalizer; a bijection with good avalanche
+	static unsigned long long mix( unsigned long long z )
+	{
+		z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+		z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+		return z ^ ( z >> 31 );
+	}
+	
+	static unsigned long long makeKey( unsigned int streamID, unsigned int frame )
+	{
+		return mix( ( (unsigned long long)streamID << 32 ) | frame );
+	}
+	
+	unsigned long long key;
+	unsigned int index;
+};
+
+
+//=========================================================
+//! The IG's source of synchronized random numbers, posted to the 
+//! blackboard as "SyncedRandom" by PluginSyncedRandomNumbers.  It knows 
+//! the host's frame number, and hands out RandomStreams for the current 
+//! frame.  Nothing here is modified after startup except the frame 
+//! number, so it can be used from any thread.
+//! 
+class MPVCMN_SPEC SyncedRandom
+{
+public:
+	
+	SyncedRandom() : frameNumber( 0 ) {}
+	
+	//=========================================================
+	//! Returns a stream ID for a consumer's name.  Call it once, at 
+	//! startup, and keep the result; the same name always gives the same 
+	//! ID, on every IG.
+	//! 
+	static unsigned int getStreamID( const char *name );
+	
+	//! Returns a stream of values for the current frame
+	RandomStream getStream( unsigned int streamID ) const
+	{
+		return RandomStream( streamID, frameNumber );
+	}
+	
+	//! Returns a stream of values for the given frame
+	RandomStream getStream( unsigned int streamID, unsigned int frame ) const
+	{
+		return RandomStream( streamID, frame );
+	}
+	
+	unsigned int getFrameNumber() const { return frameNumber; }
+	
+	//! Called by PluginSyncedRandomNumbers when a new host frame arrives
+	void setFrameNumber( unsigned int frame ) { frameNumber = frame; }
+	
+private:
+	
+	volatile unsigned int frameNumber;
+};
+
+}
+
+#endif
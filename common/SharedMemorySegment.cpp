@@ -0,0 +1,219 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "SharedMemorySegment.h"
+
+using namespace mpv;
+
+
+// ================================================
+// SharedMemorySegment
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+SharedMemorySegment::SharedMemorySegment() :
+	memory( NULL ),
+	size( 0 ),
+	created( false )
+#ifdef WIN32
+	, handle( NULL )
+#endif
+{
+}
+
+
+// ================================================
+// ~SharedMemorySegment
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+SharedMemorySegment::~SharedMemorySegment()
+{
+	close();
+}
+
+
+#ifdef WIN32
+// ================================================
+// create
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool SharedMemorySegment::create( const std::string &newName, int newSize )
+{
+	close();
+
+	handle = CreateFileMappingA( INVALID_HANDLE_VALUE, NULL, 
+		PAGE_READWRITE, 0, newSize, newName.c_str() );
+	if( handle == NULL )
+		return false;
+	memory = MapViewOfFile( handle, FILE_MAP_ALL_ACCESS, 0, 0, newSize );
+	if( memory == NULL )
+	{
+		close();
+		return false;
+	}
+
+	// a mapping that already existed keeps its old contents
+	memset( memory, 0, newSize );
+
+	name = newName;
+	size = newSize;
+	created = true;
+	return true;
+}
+
+
+// ================================================
+// open
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool SharedMemorySegment::open( const std::string &newName, bool readOnly )
+{
+	close();
+
+	DWORD access = readOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS;
+	handle = OpenFileMappingA( access, FALSE, newName.c_str() );
+	if( handle == NULL )
+		return false;
+	memory = MapViewOfFile( handle, access, 0, 0, 0 );
+	if( memory == NULL )
+	{
+		close();
+		return false;
+	}
+
+	MEMORY_BASIC_INFORMATION info;
+	VirtualQuery( memory, &info, sizeof( info ) );
+
+	name = newName;
+	size = (int)info.RegionSize;
+	return true;
+}
+
+
+// ================================================
+// close
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void SharedMemorySegment::close()
+{
+	if( memory != NULL )
+		UnmapViewOfFile( memory );
+	if( handle != NULL )
+		CloseHandle( handle );
+	handle = NULL;
+	memory = NULL;
+	size = 0;
+	created = false;
+	name.clear();
+}
+
+#else
+
+// ================================================
+// create
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool SharedMemorySegment::create( const std::string &newName, int newSize )
+{
+	close();
+
+	// start from a fresh segment, in case an earlier run left one behind
+	shm_unlink( newName.c_str() );
+	int fd = shm_open( newName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600 );
+	if( fd == -1 )
+		return false;
+	if( ftruncate( fd, newSize ) == -1 )
+	{
+		::close( fd );
+		shm_unlink( newName.c_str() );
+		return false;
+	}
+
+	void *mapped = mmap( NULL, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	::close( fd );
+	if( mapped == MAP_FAILED )
+	{
+		shm_unlink( newName.c_str() );
+		return false;
+	}
+
+	name = newName;
+	memory = mapped;
+	size = newSize;
+	created = true;
+	return true;
+}
+
+
+// ================================================
+// open
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool SharedMemorySegment::open( const std::string &newName, bool readOnly )
+{
+	close();
+
+	int fd = shm_open( newName.c_str(), readOnly ? O_RDONLY : O_RDWR, 0 );
+	if( fd == -1 )
+		return false;
+	struct stat info;
+	if( fstat( fd, &info ) == -1 || info.st_size <= 0 )
+	{
+		::close( fd );
+		return false;
+	}
+
+	void *mapped = mmap( NULL, info.st_size, 
+		readOnly ? PROT_READ : ( PROT_READ | PROT_WRITE ), MAP_SHARED, fd, 0 );
+	::close( fd );
+	if( mapped == MAP_FAILED )
+		return false;
+
+	name = newName;
+	memory = mapped;
+	size = (int)info.st_size;
+	return true;
+}
+
+
+// ================================================
+// close
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void SharedMemorySegment::close()
+{
+	if( memory != NULL )
+		munmap( memory, size );
+	if( created )
+		shm_unlink( name.c_str() );
+	memory = NULL;
+	size = 0;
+	created = false;
+	name.clear();
+}
+
+#endif
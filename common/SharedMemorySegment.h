@@ -0,0 +1,99 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_SHARED_MEMORY_SEGMENT_H_
+#define _MPV_SHARED_MEMORY_SEGMENT_H_
+
+#include <string>
+
+#include "MPVCommonTypes.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! A named block of memory shared between processes on the same machine
+//! (a POSIX shared memory object, or a Windows file mapping).  One
+//! process creates the segment and the others open it by name.  The
+//! creator removes the name when it closes the segment.
+//!
+class MPVCMN_SPEC SharedMemorySegment
+{
+public:
+
+	SharedMemorySegment();
+	~SharedMemorySegment();
+
+	//=========================================================
+	//! Creates a zero-filled segment, replacing any stale segment that an
+	//! earlier run left behind under the same name
+	//! \param name - the segment name, eg "/mpv_cigi"
+	//! \param size - the segment's size in bytes
+	//! \return false if the segment could not be created
+	//!
+	bool create( const std::string &name, int size );
+
+	//=========================================================
+	//! Maps a segment that another process created
+	//! \param name - the segment name
+	//! \param readOnly - if true, the segment is mapped read-only
+	//! \return false if there is no such segment
+	//!
+	bool open( const std::string &name, bool readOnly = false );
+
+	//=========================================================
+	//! Unmaps the segment, and removes its name if this object created it
+	//!
+	void close();
+
+	bool isOpen() const { return memory != NULL; }
+
+	void *getMemory() const { return memory; }
+
+	int getSize() const { return size; }
+
+private:
+
+	std::string name;
+	void *memory;
+	int size;
+	bool created;
+#ifdef WIN32
+	void *handle;
+#endif
+};
+
+}
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,537 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "MemoryFence.h"
+#include "StateSnapshot.h"
+
+using namespace mpv;
+
+namespace
+{
+	const char snapshotMagic[8] = { 'M', 'P', 'V', 'S', 'T', 'A', 'T', 'E' };
+	const unsigned int snapshotVersion = 1;
+
+	//! latest's value until the first snapshot is published
+	const unsigned int noBuffer = 0xffffffff;
+
+	//! The start of the segment.  The schema follows it, then the two 
+	//! buffers.
+	struct SegmentHeader
+	{
+		char magic[8];
+		unsigned int version;
+		unsigned int schemaOffset;
+		unsigned int schemaCount;
+		unsigned int bufferOffset;
+		unsigned int bufferSize;
+		unsigned int maxEntities;
+		unsigned int maxViews;
+		unsigned int maxSymbols;
+		unsigned int entitySize;
+		unsigned int viewSize;
+		unsigned int symbolSize;
+		//! the index of the newest complete buffer
+		volatile unsigned int latest;
+		volatile unsigned int ready;
+		char pad[4];
+	};
+
+	//! The start of each buffer.  The entity, view and symbol records 
+	//! follow it, each array sized for the maximum count.
+	struct BufferHeader
+	{
+		//! odd while the buffer is being written
+		volatile unsigned int sequence;
+		unsigned int frame;
+		double time;
+		int systemState;
+		unsigned int entityCount;
+		unsigned int viewCount;
+		unsigned int symbolCount;
+		char pad[32];
+	};
+
+	// compile-time checks that the records have the documented sizes
+	typedef char entitySizeCheck[ sizeof( SnapshotEntity ) == 64 ? 1 : -1 ];
+	typedef char viewSizeCheck[ sizeof( SnapshotView ) == 96 ? 1 : -1 ];
+	typedef char symbolSizeCheck[ sizeof( SnapshotSymbol ) == 48 ? 1 : -1 ];
+	typedef char fieldSizeCheck[ sizeof( SnapshotField ) == 32 ? 1 : -1 ];
+	typedef char segmentSizeCheck[ sizeof( SegmentHeader ) == 64 ? 1 : -1 ];
+	typedef char bufferSizeCheck[ sizeof( BufferHeader ) == 64 ? 1 : -1 ];
+
+	struct FieldDesc
+	{
+		const char *name;
+		unsigned char record;
+		unsigned char type;
+		unsigned char count;
+		unsigned int offset;
+	};
+
+#define ENTITY_FIELD( name, type, count ) \
+	{ #name, SnapshotField::EntityRecord, SnapshotField::type, count, offsetof( SnapshotEntity, name ) }
+#define VIEW_FIELD( name, type, count ) \
+	{ #name, SnapshotField::ViewRecord, SnapshotField::type, count, offsetof( SnapshotView, name ) }
+#define SYMBOL_FIELD( name, type, count ) \
+	{ #name, SnapshotField::SymbolRecord, SnapshotField::type, count, offsetof( SnapshotSymbol, name ) }
+
+	const FieldDesc schemaFields[] = 
+	{
+		ENTITY_FIELD( position, Float64, 3 ),
+		ENTITY_FIELD( orientation, Float32, 3 ),
+		ENTITY_FIELD( id, UInt16, 1 ),
+		ENTITY_FIELD( type, UInt16, 1 ),
+		ENTITY_FIELD( parentID, UInt16, 1 ),
+		ENTITY_FIELD( state, UInt8, 1 ),
+		ENTITY_FIELD( alpha, UInt8, 1 ),
+		ENTITY_FIELD( groundClamp, UInt8, 1 ),
+		ENTITY_FIELD( flags, UInt8, 1 ),
+
+		VIEW_FIELD( id, Int32, 1 ),
+		VIEW_FIELD( groupID, Int32, 1 ),
+		VIEW_FIELD( entityID, Int32, 1 ),
+		VIEW_FIELD( type, Int32, 1 ),
+		VIEW_FIELD( fov, Float32, 4 ),
+		VIEW_FIELD( nearPlane, Float32, 1 ),
+		VIEW_FIELD( farPlane, Float32, 1 ),
+		VIEW_FIELD( offset, Float32, 3 ),
+		VIEW_FIELD( rotate, Float32, 3 ),
+		VIEW_FIELD( viewport, Float32, 4 ),
+		VIEW_FIELD( mirrorMode, UInt8, 1 ),
+		VIEW_FIELD( parallelProjection, UInt8, 1 ),
+
+		SYMBOL_FIELD( position, Float32, 2 ),
+		SYMBOL_FIELD( scale, Float32, 2 ),
+		SYMBOL_FIELD( rotation, Float32, 1 ),
+		SYMBOL_FIELD( color, Float32, 4 ),
+		SYMBOL_FIELD( id, UInt16, 1 ),
+		SYMBOL_FIELD( parentID, UInt16, 1 ),
+		SYMBOL_FIELD( surfaceID, UInt16, 1 ),
+		SYMBOL_FIELD( type, UInt8, 1 ),
+		SYMBOL_FIELD( state, UInt8, 1 ),
+		SYMBOL_FIELD( layer, UInt8, 1 ),
+		SYMBOL_FIELD( flags, UInt8, 1 )
+	};
+
+#undef ENTITY_FIELD
+#undef VIEW_FIELD
+#undef SYMBOL_FIELD
+
+	const unsigned int schemaCount = sizeof( schemaFields ) / sizeof( schemaFields[0] );
+
+	unsigned int getBufferSize( int maxEntities, int maxViews, int maxSymbols )
+	{
+		return sizeof( BufferHeader ) + 
+			maxEntities * sizeof( SnapshotEntity ) + 
+			maxViews * sizeof( SnapshotView ) + 
+			maxSymbols * sizeof( SnapshotSymbol );
+	}
+
+	unsigned char *getBuffer( void *memory, unsigned int index )
+	{
+		SegmentHeader *header = (SegmentHeader *)memory;
+		return (unsigned char *)memory + header->bufferOffset + 
+			index * header->bufferSize;
+	}
+
+	unsigned char *getEntities( void *memory, unsigned int index )
+	{
+		return getBuffer( memory, index ) + sizeof( BufferHeader );
+	}
+
+	unsigned char *getViews( void *memory, unsigned int index )
+	{
+		SegmentHeader *header = (SegmentHeader *)memory;
+		return getEntities( memory, index ) + 
+			header->maxEntities * sizeof( SnapshotEntity );
+	}
+
+	unsigned char *getSymbols( void *memory, unsigned int index )
+	{
+		SegmentHeader *header = (SegmentHeader *)memory;
+		return getViews( memory, index ) + 
+			header->maxViews * sizeof( SnapshotView );
+	}
+}
+
+
+// ================================================
+// StateSnapshotWriter
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+StateSnapshotWriter::StateSnapshotWriter() :
+	maxEntities( 0 ),
+	maxViews( 0 ),
+	maxSymbols( 0 ),
+	backBuffer( -1 ),
+	entityCount( 0 ),
+	viewCount( 0 ),
+	symbolCount( 0 ),
+	overflowCount( 0 )
+{
+}
+
+
+// ================================================
+// ~StateSnapshotWriter
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+StateSnapshotWriter::~StateSnapshotWriter()
+{
+	close();
+}
+
+
+// ================================================
+// create
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool StateSnapshotWriter::create( const std::string &name, 
+	int newMaxEntities, int newMaxViews, int newMaxSymbols )
+{
+	close();
+
+	if( newMaxEntities < 0 || newMaxViews < 0 || newMaxSymbols < 0 )
+		return false;
+
+	// keep the buffers 64-byte aligned, like their headers
+	unsigned int schemaSize = schemaCount * sizeof( SnapshotField );
+	unsigned int bufferOffset = ( sizeof( SegmentHeader ) + schemaSize + 63 ) & ~63u;
+	unsigned int bufferSize = getBufferSize( newMaxEntities, newMaxViews, newMaxSymbols );
+
+	if( !segment.create( name, bufferOffset + 2 * bufferSize ) )
+		return false;
+
+	void *memory = segment.getMemory();
+	SegmentHeader *header = (SegmentHeader *)memory;
+	header->ready = 0;
+	memoryFence();
+
+	memcpy( header->magic, snapshotMagic, sizeof( snapshotMagic ) );
+	header->version = snapshotVersion;
+	header->schemaOffset = sizeof( SegmentHeader );
+	header->schemaCount = schemaCount;
+	header->bufferOffset = bufferOffset;
+	header->bufferSize = bufferSize;
+	header->maxEntities = newMaxEntities;
+	header->maxViews = newMaxViews;
+	header->maxSymbols = newMaxSymbols;
+	header->entitySize = sizeof( SnapshotEntity );
+	header->viewSize = sizeof( SnapshotView );
+	header->symbolSize = sizeof( SnapshotSymbol );
+	header->latest = noBuffer;
+
+	SnapshotField *fields = (SnapshotField *)( (unsigned char *)memory + header->schemaOffset );
+	for( unsigned int i = 0; i < schemaCount; i++ )
+	{
+		strncpy( fields[i].name, schemaFields[i].name, sizeof( fields[i].name ) - 1 );
+		fields[i].record = schemaFields[i].record;
+		fields[i].type = schemaFields[i].type;
+		fields[i].count = schemaFields[i].count;
+		fields[i].offset = schemaFields[i].offset;
+	}
+
+	memoryFence();
+	header->ready = 1;
+
+	maxEntities = newMaxEntities;
+	maxViews = newMaxViews;
+	maxSymbols = newMaxSymbols;
+	return true;
+}
+
+
+// ================================================
+// close
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void StateSnapshotWriter::close()
+{
+	segment.close();
+	backBuffer = -1;
+}
+
+
+// ================================================
+// beginFrame
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void StateSnapshotWriter::beginFrame( unsigned int frame, double time, int systemState )
+{
+	if( !segment.isOpen() )
+		return;
+
+	void *memory = segment.getMemory();
+	SegmentHeader *header = (SegmentHeader *)memory;
+
+	// readers are directed to the other buffer, so this one is normally 
+	// idle; a reader that is still copying it will notice the odd 
+	// sequence number and retry
+	backBuffer = ( header->latest == 0 ) ? 1 : 0;
+
+	BufferHeader *buffer = (BufferHeader *)getBuffer( memory, backBuffer );
+	buffer->sequence++;
+	memoryFence();
+
+	buffer->frame = frame;
+	buffer->time = time;
+	buffer->systemState = systemState;
+
+	entityCount = 0;
+	viewCount = 0;
+	symbolCount = 0;
+	overflowCount = 0;
+}
+
+
+// ================================================
+// addEntity
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+SnapshotEntity *StateSnapshotWriter::addEntity()
+{
+	if( backBuffer < 0 )
+		return NULL;
+	if( entityCount >= maxEntities )
+	{
+		overflowCount++;
+		return NULL;
+	}
+
+	SnapshotEntity *record = (SnapshotEntity *)
+		getEntities( segment.getMemory(), backBuffer ) + entityCount;
+	memset( record, 0, sizeof( SnapshotEntity ) );
+	entityCount++;
+	return record;
+}
+
+
+// ================================================
+// addView
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+SnapshotView *StateSnapshotWriter::addView()
+{
+	if( backBuffer < 0 )
+		return NULL;
+	if( viewCount >= maxViews )
+	{
+		overflowCount++;
+		return NULL;
+	}
+
+	SnapshotView *record = (SnapshotView *)
+		getViews( segment.getMemory(), backBuffer ) + viewCount;
+	memset( record, 0, sizeof( SnapshotView ) );
+	viewCount++;
+	return record;
+}
+
+
+// ================================================
+// addSymbol
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+SnapshotSymbol *StateSnapshotWriter::addSymbol()
+{
+	if( backBuffer < 0 )
+		return NULL;
+	if( symbolCount >= maxSymbols )
+	{
+		overflowCount++;
+		return NULL;
+	}
+
+	SnapshotSymbol *record = (SnapshotSymbol *)
+		getSymbols( segment.getMemory(), backBuffer ) + symbolCount;
+	memset( record, 0, sizeof( SnapshotSymbol ) );
+	symbolCount++;
+	return record;
+}
+
+
+// ================================================
+// publish
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void StateSnapshotWriter::publish()
+{
+	if( backBuffer < 0 )
+		return;
+
+	void *memory = segment.getMemory();
+	SegmentHeader *header = (SegmentHeader *)memory;
+	BufferHeader *buffer = (BufferHeader *)getBuffer( memory, backBuffer );
+
+	buffer->entityCount = entityCount;
+	buffer->viewCount = viewCount;
+	buffer->symbolCount = symbolCount;
+
+	memoryFence();
+	buffer->sequence++;
+	memoryFence();
+	header->latest = backBuffer;
+
+	backBuffer = -1;
+}
+
+
+// ================================================
+// StateSnapshotReader
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+StateSnapshotReader::StateSnapshotReader()
+{
+}
+
+
+// ================================================
+// ~StateSnapshotReader
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+StateSnapshotReader::~StateSnapshotReader()
+{
+	close();
+}
+
+
+// ================================================
+// open
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool StateSnapshotReader::open( const std::string &name )
+{
+	close();
+
+	if( !segment.open( name, true ) )
+		return false;
+
+	const SegmentHeader *header = (const SegmentHeader *)segment.getMemory();
+	bool valid = 
+		segment.getSize() >= (int)sizeof( SegmentHeader ) && 
+		header->ready && 
+		memcmp( header->magic, snapshotMagic, sizeof( snapshotMagic ) ) == 0 && 
+		header->version == snapshotVersion && 
+		header->entitySize == sizeof( SnapshotEntity ) && 
+		header->viewSize == sizeof( SnapshotView ) && 
+		header->symbolSize == sizeof( SnapshotSymbol ) && 
+		header->bufferSize == getBufferSize( 
+			header->maxEntities, header->maxViews, header->maxSymbols ) && 
+		header->bufferOffset + 2 * header->bufferSize <= (unsigned int)segment.getSize() && 
+		header->schemaOffset + header->schemaCount * sizeof( SnapshotField ) <= 
+			header->bufferOffset;
+	if( !valid )
+	{
+		close();
+		return false;
+	}
+
+	memoryFence();
+	const SnapshotField *fields = (const SnapshotField *)
+		( (const unsigned char *)segment.getMemory() + header->schemaOffset );
+	schema.assign( fields, fields + header->schemaCount );
+	for( unsigned int i = 0; i < schema.size(); i++ )
+		schema[i].name[ sizeof( schema[i].name ) - 1 ] = 0;
+
+	return true;
+}
+
+
+// ================================================
+// close
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void StateSnapshotReader::close()
+{
+	segment.close();
+	schema.clear();
+}
+
+
+// ================================================
+// getLatestFrame
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+unsigned int StateSnapshotReader::getLatestFrame() const
+{
+	if( !segment.isOpen() )
+		return 0;
+	const SegmentHeader *header = (const SegmentHeader *)segment.getMemory();
+	unsigned int latest = header->latest;
+	if( latest > 1 )
+		return 0;
+	memoryFence();
+	return ((const BufferHeader *)getBuffer( segment.getMemory(), latest ))->frame;
+}
+
+
+// ================================================
+// read
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool StateSnapshotReader::read( StateSnapshot &snapshot )
+{
+	if( !segment.isOpen() )
+		return false;
+
+	void *memory = segment.getMemory();
+	const SegmentHeader *header = (const SegmentHeader *)memory;
+
+	// the writer only touches a buffer that readers have been directed 
+	// away from, so a retry means this reader fell a whole frame behind
+	for( int attempt = 0; attempt < 16; attempt++ )
+	{
+		unsigned int latest = header->latest;
+		if( latest > 1 )
+			return false;
+		memoryFence();
+
+		const BufferHeader *buffer = (const BufferHeader *)getBuffer( memory, latest );
+		unsigned int sequence = buffer->sequence;
+		if( sequence & 1 )
+			continue;
+		memoryFence();
+
+		// the counts may be torn if the writer has started on this 
+		// buffer; clamp them so that the copy stays in bounds, and let 
+		// the sequence check below throw the result away
+		unsigned int entityCount = buffer->entityCount;
+		unsigned int viewCount = buffer->viewCount;
+		unsigned int symbolCount = buffer->symbolCount;
+		if( entityCount > header->maxEntities ) entityCount = header->maxEntities;
+		if( viewCount > header->maxViews ) viewCount = header->maxViews;
+		if( symbolCount > header->maxSymbols ) symbolCount = header->maxSymbols;
+
+		snapshot.frame = buffer->frame;
+		snapshot.time = buffer->time;
+		snapshot.systemState = buffer->systemState;
+		snapshot.entities.resize( entityCount );
+		snapshot.views.resize( viewCount );
+		snapshot.symbols.resize( symbolCount );
+		if( entityCount > 0 )
+			memcpy( &snapshot.entities[0], getEntities( memory, latest ), 
+				entityCount * sizeof( SnapshotEntity ) );
+		if( viewCount > 0 )
+			memcpy( &snapshot.views[0], getViews( memory, latest ), 
+				viewCount * sizeof( SnapshotView ) );
+		if( symbolCount > 0 )
+			memcpy( &snapshot.symbols[0], getSymbols( memory, latest ), 
+				symbolCount * sizeof( SnapshotSymbol ) );
+
+		memoryFence();
+		if( buffer->sequence == sequence )
+			return true;
+	}
+
+	return false;
+}
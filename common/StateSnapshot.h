@@ -0,0 +1,318 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_STATE_SNAPSHOT_H_
+#define _MPV_STATE_SNAPSHOT_H_
+
+#include <string>
+#include <vector>
+
+#include "MPVCommonTypes.h"
+#include "SharedMemorySegment.h"
+
+#if defined(_MSC_VER)
+   #pragma warning(push)
+   #pragma warning(disable : 4251)
+#endif
+
+namespace mpv
+{
+
+//=========================================================
+//! The state of one entity, as published in a state snapshot.  Records
+//! have a fixed layout with explicit padding, so that tools built with
+//! another compiler (or in another language) can read them; the schema
+//! in the segment header describes the same layout.
+//!
+struct SnapshotEntity
+{
+	enum Flags
+	{
+		IsChild = 0x01,
+		InheritAlpha = 0x02,
+		CollisionDetectionEnabled = 0x04
+	};
+
+	//! lat/lon/alt for top-level entities; x/y/z relative to the parent 
+	//! for child entities
+	double position[3];
+	//! yaw, pitch, roll in degrees
+	float orientation[3];
+	unsigned short id;
+	unsigned short type;
+	unsigned short parentID;
+	//! Entity::EntityState
+	unsigned char state;
+	unsigned char alpha;
+	//! Entity::GroundClampState
+	unsigned char groundClamp;
+	//! bitwise-or of Flags
+	unsigned char flags;
+	unsigned char pad[18];
+};
+
+
+//=========================================================
+//! The state of one view, as published in a state snapshot
+//!
+struct SnapshotView
+{
+	int id;
+	int groupID;
+	int entityID;
+	int type;
+	//! left, right, top, bottom, in degrees
+	float fov[4];
+	float nearPlane;
+	float farPlane;
+	//! offset from the entity, in the entity's coordinate system
+	float offset[3];
+	//! yaw, pitch, roll relative to the entity, in degrees
+	float rotate[3];
+	//! left, top, width, height, as fractions of the window
+	float viewport[4];
+	unsigned char mirrorMode;
+	unsigned char parallelProjection;
+	unsigned char pad[14];
+};
+
+
+//=========================================================
+//! The state of one symbol, as published in a state snapshot
+//!
+struct SnapshotSymbol
+{
+	enum Flags
+	{
+		IsChild = 0x01,
+		InheritColor = 0x02,
+		FlashOn = 0x04
+	};
+
+	//! u, v on the symbol surface
+	float position[2];
+	float scale[2];
+	//! degrees
+	float rotation;
+	//! red, green, blue, alpha, from 0 to 1
+	float color[4];
+	unsigned short id;
+	unsigned short parentID;
+	unsigned short surfaceID;
+	//! Symbol::SymbolType
+	unsigned char type;
+	//! Symbol::SymbolState
+	unsigned char state;
+	unsigned char layer;
+	//! bitwise-or of Flags
+	unsigned char flags;
+	unsigned char pad[2];
+};
+
+
+//=========================================================
+//! Describes one field of a snapshot record.  The segment header holds an
+//! array of these, so that a generic tool can decode the records without
+//! this header file.
+//!
+struct SnapshotField
+{
+	enum Record
+	{
+		EntityRecord = 0,
+		ViewRecord = 1,
+		SymbolRecord = 2
+	};
+
+	enum Type
+	{
+		UInt8 = 0,
+		UInt16 = 1,
+		Int32 = 2,
+		Float32 = 3,
+		Float64 = 4
+	};
+
+	//! NUL-terminated
+	char name[24];
+	//! one of Record
+	unsigned char record;
+	//! one of Type
+	unsigned char type;
+	//! the number of consecutive values of that type
+	unsigned char count;
+	unsigned char pad;
+	//! the field's byte offset within its record
+	unsigned int offset;
+};
+
+
+//=========================================================
+//! One complete copy of the IG's state, as returned by 
+//! StateSnapshotReader::read()
+//!
+struct MPVCMN_SPEC StateSnapshot
+{
+	//! the IG's frame counter when the snapshot was taken
+	unsigned int frame;
+	//! seconds of simulation time
+	double time;
+	//! the IG's SystemState::ID
+	int systemState;
+
+	std::vector<SnapshotEntity> entities;
+	std::vector<SnapshotView> views;
+	std::vector<SnapshotSymbol> symbols;
+};
+
+
+//=========================================================
+//! Publishes a binary snapshot of the IG's state in a named shared memory 
+//! segment, once per frame.
+//!
+//! The segment holds a header, the schema, and two buffers.  Each frame 
+//! is written to whichever buffer readers aren't directed to, and each 
+//! buffer is guarded by a sequence lock: its sequence number is odd while 
+//! it is being written.  Readers never block the writer; they copy the 
+//! newest buffer and retry if the sequence number changed underneath 
+//! them, which only happens if a reader is more than a frame behind.
+//!
+class MPVCMN_SPEC StateSnapshotWriter
+{
+public:
+
+	StateSnapshotWriter();
+	~StateSnapshotWriter();
+
+	//=========================================================
+	//! Creates the segment, sized for the given number of records
+	//! \return false if the segment could not be created
+	//!
+	bool create( const std::string &name, 
+		int maxEntities, int maxViews, int maxSymbols );
+
+	void close();
+
+	bool isOpen() const { return segment.isOpen(); }
+
+	//=========================================================
+	//! Starts writing a new snapshot into the back buffer
+	//!
+	void beginFrame( unsigned int frame, double time, int systemState );
+
+	//=========================================================
+	//! Returns the next record of the snapshot being written, to be 
+	//! filled in by the caller, or NULL if there is no more room.
+	//! Records are zero-filled first.
+	//!
+	SnapshotEntity *addEntity();
+	SnapshotView *addView();
+	SnapshotSymbol *addSymbol();
+
+	//=========================================================
+	//! Finishes the snapshot and directs readers to it
+	//!
+	void publish();
+
+	//=========================================================
+	//! Returns the number of records dropped from the last snapshot 
+	//! for lack of room
+	//!
+	int getOverflowCount() const { return overflowCount; }
+
+private:
+
+	SharedMemorySegment segment;
+
+	int maxEntities;
+	int maxViews;
+	int maxSymbols;
+
+	//! the buffer being written, or -1 outside of beginFrame/publish
+	int backBuffer;
+
+	int entityCount;
+	int viewCount;
+	int symbolCount;
+	int overflowCount;
+};
+
+
+//=========================================================
+//! Reads the snapshots published by a StateSnapshotWriter, possibly in 
+//! another process.  Reading never stalls the IG.
+//!
+class MPVCMN_SPEC StateSnapshotReader
+{
+public:
+
+	StateSnapshotReader();
+	~StateSnapshotReader();
+
+	//=========================================================
+	//! Maps the segment read-only, and checks that its layout matches 
+	//! this reader's
+	//! \return false if there is no such segment, or it is incompatible
+	//!
+	bool open( const std::string &name );
+
+	void close();
+
+	bool isOpen() const { return segment.isOpen(); }
+
+	//=========================================================
+	//! Copies the newest snapshot.  The vectors in snapshot are reused, 
+	//! so passing the same object in each time avoids reallocation.
+	//! \return false if nothing has been published yet, or a consistent 
+	//!         copy could not be made (the writer lapped this reader 
+	//!         repeatedly)
+	//!
+	bool read( StateSnapshot &snapshot );
+
+	//=========================================================
+	//! Returns the frame number of the newest snapshot, without copying 
+	//! it; useful for polling
+	//!
+	unsigned int getLatestFrame() const;
+
+	//=========================================================
+	//! Returns the record layout described by the segment's schema
+	//!
+	const std::vector<SnapshotField> &getSchema() const { return schema; }
+
+private:
+
+	SharedMemorySegment segment;
+
+	std::vector<SnapshotField> schema;
+};
+
+}
+
+#if defined(_MSC_VER)
+   #pragma warning(pop)
+#endif
+
+#endif
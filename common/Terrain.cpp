@@ -20,6 +20,14 @@
  *  2008-09-29 Andrew Sampson
  *      Initial release
  *  
+ *  2026-10-19
+ *      Added preloading: a terrain can be loaded into memory without being 
+ *      displayed, and kept in memory when another terrain is displayed
+ *  
+ *  2026-10-19
+ *      Added tiling parameters, for databases that are split into a grid 
+ *      of tile files and paged in around the eye points
+ *  
  *  </pre>
  */
 
@@ -33,7 +41,14 @@ using namespace mpv;
 // Terrain
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 Terrain::Terrain() : ComponentContainer(),
-	id( 0xffff )
+	id( 0xffff ),
+	tileSize( 1000.0 ),
+	tileOriginX( 0.0 ),
+	tileOriginY( 0.0 ),
+	tileMinX( 0 ),
+	tileMinY( 0 ),
+	tileMaxX( -1 ),
+	tileMaxY( -1 )
 {
 	
 }
@@ -70,6 +85,28 @@ void Terrain::unload()
 }
 
 
+void Terrain::detach()
+{
+	TerrainImpList::iterator iter;
+	for( iter = imps.begin(); iter != imps.end(); iter++ )
+	{
+		if( (*iter).valid() )
+			(*iter)->detach();
+	}
+}
+
+
+void Terrain::preload()
+{
+	TerrainImpList::iterator iter;
+	for( iter = imps.begin(); iter != imps.end(); iter++ )
+	{
+		if( (*iter).valid() )
+			(*iter)->preload();
+	}
+}
+
+
 void Terrain::update( double timeElapsed )
 {
 	TerrainImpList::iterator iter;
@@ -142,6 +179,59 @@ Terrain::TerrainState Terrain::getState()
 }
 
 
+bool Terrain::isResident()
+{
+	// as with getState(), a terrain without implementation objects has 
+	// nothing to load
+	TerrainImpList::iterator iter;
+	for( iter = imps.begin(); iter != imps.end(); iter++ )
+	{
+		if( (*iter).valid() && !(*iter)->isResident() )
+			return false;
+	}
+	return true;
+}
+
+
+bool Terrain::isLoading()
+{
+	TerrainImpList::iterator iter;
+	for( iter = imps.begin(); iter != imps.end(); iter++ )
+	{
+		if( (*iter).valid() && (*iter)->isLoading() )
+			return true;
+	}
+	return false;
+}
+
+
+size_t Terrain::getResidentBytes()
+{
+	size_t result = 0;
+	TerrainImpList::iterator iter;
+	for( iter = imps.begin(); iter != imps.end(); iter++ )
+	{
+		if( (*iter).valid() )
+			result += (*iter)->getResidentBytes();
+	}
+	return result;
+}
+
+
+double Terrain::getLoadTime()
+{
+	// the imps load in parallel, so the slowest one decides
+	double result = 0.0;
+	TerrainImpList::iterator iter;
+	for( iter = imps.begin(); iter != imps.end(); iter++ )
+	{
+		if( (*iter).valid() && (*iter)->getLoadTime() > result )
+			result = (*iter)->getLoadTime();
+	}
+	return result;
+}
+
+
 void Terrain::setID( int newID )
 {
 	id = newID;
@@ -167,6 +257,20 @@ void Terrain::setCoordSys( const CoordSysParams &newCoordSys )
 	coordSys = newCoordSys;
 }
 
+void Terrain::setTiling( const std::string &pattern, double size, 
+	double originX, double originY, 
+	int minX, int minY, int maxX, int maxY )
+{
+	tilePattern = pattern;
+	tileSize = size;
+	tileOriginX = originX;
+	tileOriginY = originY;
+	tileMinX = minX;
+	tileMinY = minY;
+	tileMaxX = maxX;
+	tileMaxY = maxY;
+}
+
 
 void Terrain::addImplementation( TerrainImp *newImp )
 {
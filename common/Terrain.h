@@ -20,6 +20,14 @@
  *  2008-09-29 Andrew Sampson
  *      Initial release
  *  
+ *  2026-10-19
+ *      Added preloading: a terrain can be loaded into memory without being 
+ *      displayed, and kept in memory when another terrain is displayed
+ *  
+ *  2026-10-19
+ *      Added tiling parameters, for databases that are split into a grid 
+ *      of tile files and paged in around the eye points
+ *  
  *  </pre>
  */
 
@@ -27,6 +35,8 @@
 #ifndef _TERRAIN_H_
 #define _TERRAIN_H_
 
+#include <cstddef>
+
 #include "MPVCommonTypes.h"
 #include "ComponentContainer.h"
 #include "CoordSysParams.h"
@@ -67,9 +77,45 @@ public:
 	
 	void unload();
 	
+	//=========================================================
+	//! Stops displaying the terrain, but keeps it in memory, so that a 
+	//! later load() takes effect at once.  Implementations that can't keep 
+	//! a terrain in memory unload it instead.
+	//! 
+	void detach();
+	
+	//=========================================================
+	//! Begins loading the terrain into memory, without displaying it.  
+	//! getState() is unaffected; isResident() becomes true once the 
+	//! terrain is in memory.
+	//! 
+	void preload();
+	
 	void update( double timeElapsed );
 	
 	TerrainState getState();
+	
+	//=========================================================
+	//! Returns true if the terrain is in memory, whether or not it is 
+	//! displayed, and so can be displayed without waiting for a load
+	//! 
+	bool isResident();
+	
+	//=========================================================
+	//! Returns true if a load or preload is in progress
+	//! 
+	bool isLoading();
+	
+	//=========================================================
+	//! Returns an estimate of the memory held by the terrain, in bytes
+	//! 
+	size_t getResidentBytes();
+	
+	//=========================================================
+	//! Returns the time spent on the current or most recent load, in 
+	//! seconds
+	//! 
+	double getLoadTime();
 
 	int getID() const { return id; }
 	const std::string &getName() const { return name; }
@@ -77,12 +123,41 @@ public:
 	const std::string &getDirectoryname() const { return directoryname; }
 	const CoordSysParams &getCoordSys() const { return coordSys; }
 	
+	//=========================================================
+	//! Returns true if the database is a grid of tile files, rather than 
+	//! a single file
+	//! 
+	bool isTiled() const { return !tilePattern.empty(); }
+	const std::string &getTilePattern() const { return tilePattern; }
+	double getTileSize() const { return tileSize; }
+	double getTileOriginX() const { return tileOriginX; }
+	double getTileOriginY() const { return tileOriginY; }
+	int getTileMinX() const { return tileMinX; }
+	int getTileMinY() const { return tileMinY; }
+	int getTileMaxX() const { return tileMaxX; }
+	int getTileMaxY() const { return tileMaxY; }
+	
 	void setID( int newID );
 	void setName( const std::string &newName );
 	void setFilename( const std::string &newFilename );
 	void setDirectoryname( const std::string &newDirectoryname );
 	void setCoordSys( const CoordSysParams &newCoordSys );
 	
+	//=========================================================
+	//! Makes this a tiled database.  Tile (x, y) covers database 
+	//! coordinates originX + x * size to originX + (x + 1) * size, and 
+	//! likewise in y.
+	//! \param pattern - the tile filename, relative to the database 
+	//!   directory, with {x} and {y} in place of the tile's column and row
+	//! \param size - the tile edge length, in database units
+	//! \param originX, originY - the corner of tile (0, 0)
+	//! \param minX, minY, maxX, maxY - the range of tiles in the database, 
+	//!   inclusive
+	//! 
+	void setTiling( const std::string &pattern, double size, 
+		double originX, double originY, 
+		int minX, int minY, int maxX, int maxY );
+	
 	void addImplementation( TerrainImp *newImp );
 	
 	TerrainImpIteratorPair getImplementations()
@@ -111,6 +186,20 @@ protected:
 	
 	//! Parameters which define the coordinate system for this database
 	CoordSysParams coordSys;
+	
+	//! The tile filename pattern; empty if the database isn't tiled
+	std::string tilePattern;
+	
+	//! Tile edge length and the corner of tile (0, 0), in database units
+	double tileSize;
+	double tileOriginX;
+	double tileOriginY;
+	
+	//! The range of tiles in the database, inclusive
+	int tileMinX;
+	int tileMinY;
+	int tileMaxX;
+	int tileMaxY;
 
 	//! Implementation objects for this Terrain.  
 	TerrainImpList imps;
@@ -148,9 +237,32 @@ public:
 	//! Sets state accordingly.
 	virtual void unload() = 0;
 	
+	//! Stops displaying this imp's terrain database, keeping it in memory 
+	//! if possible.  Sets state to NotLoaded.  The default unloads it.
+	virtual void detach() { unload(); }
+	
+	//! Begins loading this imp's terrain database into memory without 
+	//! displaying it.  Does not change state.  The default does nothing; 
+	//! load() will then load the database as usual.
+	virtual void preload() {}
+	
 	virtual void update( double timeElapsed ) {}
 
+	Terrain *getTerrain() { return terrain; }
+
 	virtual Terrain::TerrainState getState() { return state; }
+	
+	//! Returns true if the database is in memory, displayed or not
+	virtual bool isResident() { return state == Terrain::Loaded || state == Terrain::Broken; }
+	
+	//! Returns true if a load or preload is in progress
+	virtual bool isLoading() { return state == Terrain::Loading; }
+	
+	//! Returns an estimate of the memory held by the database, in bytes
+	virtual size_t getResidentBytes() { return 0; }
+	
+	//! Returns the time spent on the current or most recent load, in seconds
+	virtual double getLoadTime() { return 0.0; }
 
 protected:
 	//=========================================================
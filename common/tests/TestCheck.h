@@ -0,0 +1,59 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#ifndef _MPV_TEST_CHECK_H_
+#define _MPV_TEST_CHECK_H_
+
+#include <iostream>
+
+//=========================================================
+//! The number of checks that have failed so far
+//!
+static int testFailures = 0;
+
+//=========================================================
+//! Reports a failed condition, and carries on with the test
+//!
+#define CHECK( condition ) \
+	do { \
+		if( !( condition ) ) \
+		{ \
+			std::cerr << __FILE__ << ":" << __LINE__ \
+				<< ": check failed: " << #condition << std::endl; \
+			testFailures++; \
+		} \
+	} while( 0 )
+
+//=========================================================
+//! The exit status for main()
+//!
+inline int testResult()
+{
+	if( testFailures > 0 )
+		std::cerr << testFailures << " check(s) failed" << std::endl;
+	return testFailures > 0 ? 1 : 0;
+}
+
+#endif
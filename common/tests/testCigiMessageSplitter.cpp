@@ -0,0 +1,295 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <vector>
+
+#include "CigiMessageSplitter.h"
+#include "TestCheck.h"
+
+using namespace mpv;
+
+namespace
+{
+	unsigned int seed = 12345;
+
+	int randomInt( int limit )
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return (int)( ( seed >> 16 ) % limit );
+	}
+
+	//! Appends a packet of the given size.  Its contents are its ID, its 
+	//! size, and then a count that runs on from packet to packet, so that 
+	//! a packet that was moved, cut, or repeated shows up.
+	void addPacket( std::vector< unsigned char > &message, int id, int size )
+	{
+		static unsigned char counter = 0;
+		message.push_back( (unsigned char)id );
+		message.push_back( (unsigned char)size );
+		for( int i = 2; i < size; i++ )
+			message.push_back( counter++ );
+	}
+
+	//! A Start of Frame followed by packets of the given sizes
+	std::vector< unsigned char > makeMessage( const int *sizes, int count )
+	{
+		std::vector< unsigned char > message;
+		addPacket( message, 101, 24 );
+		for( int i = 0; i < count; i++ )
+			addPacket( message, 102, sizes[i] );
+		return message;
+	}
+
+	//=========================================================
+	//! Checks what every split must do: each piece starts with the first 
+	//! packet, and the pieces' packets, in order, are the original's.  For
+	//! well-formed messages, a piece is only over maxLength if it holds a
+	//! single packet.
+	//!
+	void checkPieces( const CigiMessageSplitter &splitter, 
+		const std::vector< unsigned char > &message, int maxLength, bool wellFormed )
+	{
+		int headerLength = message[1];
+		const unsigned char * const *pieces = splitter.getPieces();
+		const int *lengths = splitter.getLengths();
+		CHECK( pieces != NULL && lengths != NULL );
+		if( pieces == NULL || lengths == NULL )
+			return;
+
+		std::vector< unsigned char > rest;
+		bool headersMatch = true;
+		bool withinLimit = true;
+		for( int i = 0; i < splitter.getCount(); i++ )
+		{
+			CHECK( lengths[i] > headerLength );
+			if( lengths[i] <= headerLength )
+				continue;
+			for( int j = 0; j < headerLength; j++ )
+			{
+				if( pieces[i][j] != message[j] )
+					headersMatch = false;
+			}
+			if( wellFormed && lengths[i] > maxLength && 
+				lengths[i] != headerLength + pieces[i][headerLength + 1] )
+			{
+				withinLimit = false;
+			}
+			rest.insert( rest.end(), pieces[i] + headerLength, pieces[i] + lengths[i] );
+		}
+		CHECK( headersMatch );
+		CHECK( withinLimit );
+		CHECK( rest == std::vector< unsigned char >( message.begin() + headerLength, message.end() ) );
+	}
+}
+
+
+// ================================================
+// testPassThrough
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testPassThrough()
+{
+	CigiMessageSplitter splitter;
+	const int sizes[] = { 24, 32, 8 };
+	std::vector< unsigned char > message = makeMessage( sizes, 3 );
+	int length = (int)message.size();
+
+	// nothing to send
+	CHECK( splitter.split( NULL, 10, 100 ) == 0 );
+	CHECK( splitter.split( &message[0], 0, 100 ) == 0 );
+	CHECK( splitter.getCount() == 0 );
+	CHECK( splitter.getPieces() == NULL );
+	CHECK( splitter.getLengths() == NULL );
+
+	// fits, or no limit; the message itself is the one piece
+	const int limits[] = { length, length + 1, 0, -1 };
+	for( int i = 0; i < 4; i++ )
+	{
+		CHECK( splitter.split( &message[0], length, limits[i] ) == 1 );
+		CHECK( splitter.getCount() == 1 );
+		CHECK( splitter.getPieces()[0] == &message[0] );
+		CHECK( splitter.getLengths()[0] == length );
+	}
+}
+
+
+// ================================================
+// testSplit
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testSplit()
+{
+	CigiMessageSplitter splitter;
+	const int sizes[] = { 24, 24, 24, 24, 24 };
+	std::vector< unsigned char > message = makeMessage( sizes, 5 );
+
+	// room for the Start of Frame and two packets a piece
+	CHECK( splitter.split( &message[0], (int)message.size(), 72 ) == 3 );
+	CHECK( splitter.getLengths()[0] == 72 );
+	CHECK( splitter.getLengths()[1] == 72 );
+	CHECK( splitter.getLengths()[2] == 48 );
+	checkPieces( splitter, message, 72, true );
+
+	// one byte short of two packets; one a piece
+	CHECK( splitter.split( &message[0], (int)message.size(), 71 ) == 5 );
+	for( int i = 0; i < 5; i++ )
+		CHECK( splitter.getLengths()[i] == 48 );
+	checkPieces( splitter, message, 71, true );
+
+	// the original isn't touched, and can be split again
+	std::vector< unsigned char > copy = message;
+	CHECK( splitter.split( &message[0], (int)message.size(), 100 ) == 2 );
+	checkPieces( splitter, message, 100, true );
+	CHECK( message == copy );
+}
+
+
+// ================================================
+// testOversize
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testOversize()
+{
+	CigiMessageSplitter splitter;
+
+	// the 200-byte packet can't fit with the Start of Frame in 64 bytes, 
+	// so it goes in a piece of its own, over the limit, and the packets 
+	// around it aren't held up
+	const int sizes[] = { 16, 200, 16, 16 };
+	std::vector< unsigned char > message = makeMessage( sizes, 4 );
+	CHECK( splitter.split( &message[0], (int)message.size(), 64 ) == 3 );
+	CHECK( splitter.getLengths()[0] == 40 );
+	CHECK( splitter.getLengths()[1] == 224 );
+	CHECK( splitter.getLengths()[2] == 56 );
+	checkPieces( splitter, message, 64, true );
+
+	// a limit smaller than the Start of Frame; a packet a piece
+	const int small[] = { 8, 8, 8 };
+	message = makeMessage( small, 3 );
+	CHECK( splitter.split( &message[0], (int)message.size(), 10 ) == 3 );
+	checkPieces( splitter, message, 10, true );
+}
+
+
+// ================================================
+// testMalformed
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testMalformed()
+{
+	CigiMessageSplitter splitter;
+	const int sizes[] = { 24, 24, 24, 24 };
+	const std::vector< unsigned char > good = makeMessage( sizes, 4 );
+	int length = (int)good.size();
+
+	// a first packet too short, or no shorter than the message, can't be 
+	// copied into each piece; the message goes as it is
+	std::vector< unsigned char > message = good;
+	const int headerLengths[] = { 0, 1, length, 255 };
+	for( int i = 0; i < 4; i++ )
+	{
+		message[1] = (unsigned char)headerLengths[i];
+		CHECK( splitter.split( &message[0], length, 50 ) == 1 );
+		CHECK( splitter.getPieces()[0] == &message[0] );
+		CHECK( splitter.getLengths()[0] == length );
+	}
+
+	// a one-byte message
+	CHECK( splitter.split( &message[0], 1, 0 ) == 1 );
+	CHECK( splitter.split( &message[0], 1, 1 ) == 1 );
+
+	// from a packet whose size is too small, or runs past the end, the 
+	// rest of the message goes in one piece, as it is
+	const int badSizes[] = { 0, 1, 25 + 24 + 24 };
+	for( int i = 0; i < 3; i++ )
+	{
+		message = good;
+		message[24 + 24 + 1] = (unsigned char)badSizes[i];
+		CHECK( splitter.split( &message[0], length, 50 ) == 2 );
+		CHECK( splitter.getLengths()[0] == 48 );
+		CHECK( splitter.getLengths()[1] == 24 + 72 );
+		checkPieces( splitter, message, 50, false );
+	}
+
+	// a message cut off partway through its last packet
+	message = good;
+	CHECK( splitter.split( &message[0], length - 5, 50 ) == 4 );
+	CHECK( splitter.getLengths()[3] == 24 + 19 );
+	message.resize( length - 5 );
+	checkPieces( splitter, message, 50, false );
+
+	// ... or partway through a packet's size byte
+	message = good;
+	message.resize( 24 + 24 + 1 );
+	CHECK( splitter.split( &message[0], (int)message.size(), 30 ) == 2 );
+	CHECK( splitter.getLengths()[1] == 24 + 1 );
+	checkPieces( splitter, message, 30, false );
+}
+
+
+// ================================================
+// testRandom
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testRandom()
+{
+	// well-formed messages of random packets, split at random limits
+	CigiMessageSplitter splitter;
+	for( int round = 0; round < 2000; round++ )
+	{
+		std::vector< int > sizes( 1 + randomInt( 40 ) );
+		for( unsigned int i = 0; i < sizes.size(); i++ )
+			sizes[i] = 8 * ( 1 + randomInt( 31 ) );
+		std::vector< unsigned char > message = makeMessage( &sizes[0], (int)sizes.size() );
+		int maxLength = 16 + randomInt( 600 );
+		int count = splitter.split( &message[0], (int)message.size(), maxLength );
+		CHECK( count == splitter.getCount() );
+		if( (int)message.size() <= maxLength )
+			CHECK( count == 1 && splitter.getPieces()[0] == &message[0] );
+		checkPieces( splitter, message, maxLength, true );
+
+		// then with random bytes overwritten, sizes included.  Under a 
+		// memory checker, this shows the splitter never reads past the end.
+		int length = (int)message.size();
+		std::vector< unsigned char > damaged( message.begin(), message.end() );
+		for( int i = 0; i < 4; i++ )
+			damaged[24 + randomInt( length - 24 )] = (unsigned char)randomInt( 256 );
+		int cut = length - randomInt( 30 );
+		if( cut <= 24 )
+			cut = length;
+		std::vector< unsigned char > exact( damaged.begin(), damaged.begin() + cut );
+		splitter.split( &exact[0], cut, maxLength );
+		checkPieces( splitter, exact, maxLength, false );
+	}
+}
+
+
+// ================================================
+// main
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int main( int argc, char **argv )
+{
+	testPassThrough();
+	testSplit();
+	testOversize();
+	testMalformed();
+	testRandom();
+	return testResult();
+}
@@ -0,0 +1,296 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <string.h>
+#include <vector>
+#include <utility>
+
+#include <OpenThreads/Thread>
+
+#include <CigiIGSession.h>
+#include <CigiOutgoingMsg.h>
+#include <CigiSOFV3_2.h>
+#include <CigiHatHotRespV3_2.h>
+
+#include "RefPtr.h"
+#include "CigiOutgoingStage.h"
+#include "TestCheck.h"
+
+using namespace mpv;
+
+namespace
+{
+	//! A packet as it came out of the message: its ID, and for HAT/HOT 
+	//! responses, the HAT/HOT ID, which the tests use as a sequence number
+	typedef std::pair< int, int > SentPacket;
+
+	//! An IG session set up the way the kernel's is, that sends its 
+	//! messages to a vector instead of the host
+	struct TestSession
+	{
+		TestSession()
+		{
+			session.SetCigiVersion( 3, 3 );
+			session.SetSynchronous( true );
+			session.GetOutgoingMsgMgr().BeginMsg();
+			session.GetOutgoingMsgMgr() << sof;
+		}
+
+		CigiOutgoingMsg &message() { return session.GetOutgoingMsgMgr(); }
+
+		//! Merges the stage into the message and "sends" it, the way 
+		//! Kernel::sendNetMessages() does
+		std::vector< SentPacket > send( CigiOutgoingStage *stage, int *merged = NULL )
+		{
+			int count = stage->merge( message() );
+			if( merged != NULL )
+				*merged = count;
+
+			std::vector< SentPacket > sent;
+			message().LockMsg();
+			message().UpdateFrameCntr();
+			int length = 0;
+			unsigned char *buffer = message().GetMsg( length );
+			int offset = 0;
+			while( buffer != NULL && offset + 2 <= length && buffer[offset + 1] > 0 )
+			{
+				int id = -1;
+				if( buffer[offset] == CIGI_HAT_HOT_RESP_PACKET_ID_V3_2 )
+				{
+					unsigned short hatHotID;
+					memcpy( &hatHotID, buffer + offset + 2, sizeof( hatHotID ) );
+					id = hatHotID;
+				}
+				sent.push_back( SentPacket( buffer[offset], id ) );
+				offset += buffer[offset + 1];
+			}
+			CHECK( offset == length );
+			message().UnlockMsg();
+
+			message() << sof;
+			return sent;
+		}
+
+		CigiIGSession session;
+		CigiSOFV3_2 sof;
+	};
+
+	CigiHatHotRespV3_2 response( int hatHotID )
+	{
+		CigiHatHotRespV3_2 packet;
+		packet.SetHatHotID( (Cigi_uint16)hatHotID );
+		return packet;
+	}
+
+	//! Stages a run of numbered responses, retrying while the queue is 
+	//! full, as a worker thread would
+	class StagingThread : public OpenThreads::Thread
+	{
+	public:
+		StagingThread( CigiOutgoingStage::Producer *_producer, int _first, int _count ) :
+			producer( _producer ), first( _first ), count( _count ), retries( 0 ) {}
+
+		virtual void run()
+		{
+			for( int i = 0; i < count; i++ )
+			{
+				CigiHatHotRespV3_2 packet = response( first + i );
+				while( !producer->stage( packet ) )
+				{
+					retries++;
+					YieldCurrentThread();
+				}
+			}
+		}
+
+		CigiOutgoingStage::Producer *producer;
+		int first;
+		int count;
+		int retries;
+	};
+}
+
+
+// ================================================
+// testMergeOrder
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testMergeOrder()
+{
+	RefPtr<CigiOutgoingStage> stage = new CigiOutgoingStage();
+	TestSession session;
+
+	// nothing staged; the message is just the Start of Frame
+	int merged = -1;
+	std::vector< SentPacket > sent = session.send( stage.get(), &merged );
+	CHECK( merged == 0 );
+	CHECK( sent.size() == 1 );
+	CHECK( sent.size() > 0 && sent[0].first == CIGI_SOF_PACKET_ID_V3 );
+
+	CigiOutgoingStage::Producer *first = stage->createProducer( "first", 8 );
+	CigiOutgoingStage::Producer *second = stage->createProducer( "second", 8 );
+	CHECK( first->getName() == "first" );
+
+	// staged before the direct packet, but merged after it; producers in 
+	// the order they were created
+	CHECK( second->stage( response( 20 ) ) );
+	CHECK( first->stage( response( 10 ) ) );
+	CHECK( first->stage( response( 11 ) ) );
+	CHECK( second->stage( response( 21 ) ) );
+	CHECK( first->stage( response( 12 ) ) );
+	CigiHatHotRespV3_2 direct = response( 1 );
+	session.message() << direct;
+
+	sent = session.send( stage.get(), &merged );
+	CHECK( merged == 5 );
+	const int expected[] = { -1, 1, 10, 11, 12, 20, 21 };
+	CHECK( sent.size() == 7 );
+	for( unsigned int i = 0; i < sent.size() && i < 7; i++ )
+	{
+		CHECK( sent[i].first == ( i == 0 ? CIGI_SOF_PACKET_ID_V3 : CIGI_HAT_HOT_RESP_PACKET_ID_V3_2 ) );
+		CHECK( sent[i].second == expected[i] );
+	}
+
+	// the queues are empty again
+	sent = session.send( stage.get(), &merged );
+	CHECK( merged == 0 );
+	CHECK( sent.size() == 1 );
+
+	stage->report();
+}
+
+
+// ================================================
+// testFull
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testFull()
+{
+	RefPtr<CigiOutgoingStage> stage = new CigiOutgoingStage();
+	TestSession session;
+
+	// rounded up to 4
+	CigiOutgoingStage::Producer *producer = stage->createProducer( "full", 3 );
+	for( int i = 0; i < 4; i++ )
+		CHECK( producer->stage( response( i ) ) );
+	CHECK( !producer->stage( response( 4 ) ) );
+	CHECK( !producer->stage( response( 5 ) ) );
+
+	// the dropped packets are gone; the rest are sent in order
+	int merged = -1;
+	std::vector< SentPacket > sent = session.send( stage.get(), &merged );
+	CHECK( merged == 4 );
+	CHECK( sent.size() == 5 );
+	for( unsigned int i = 1; i < sent.size(); i++ )
+		CHECK( sent[i].second == (int)i - 1 );
+
+	// the slab slots are reused once merged; around the ring a few times
+	for( int round = 0; round < 5; round++ )
+	{
+		for( int i = 0; i < 3; i++ )
+			CHECK( producer->stage( response( 100 * round + i ) ) );
+		sent = session.send( stage.get(), &merged );
+		CHECK( merged == 3 );
+		CHECK( sent.size() == 4 );
+		for( unsigned int i = 1; i < sent.size(); i++ )
+			CHECK( sent[i].second == 100 * round + (int)i - 1 );
+	}
+
+	// logs the two dropped packets
+	stage->report();
+
+	// packets left in a queue are destroyed with the stage
+	CHECK( producer->stage( response( 7 ) ) );
+	stage = NULL;
+}
+
+
+// ================================================
+// testThreads
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testThreads()
+{
+	const int numThreads = 3;
+	const int perThread = 20000;
+	const int spacing = 20000;
+
+	RefPtr<CigiOutgoingStage> stage = new CigiOutgoingStage();
+	TestSession session;
+
+	// small queues, so that the threads fill them and wait on the merges
+	std::vector< StagingThread * > threads;
+	for( int i = 0; i < numThreads; i++ )
+	{
+		threads.push_back( new StagingThread( 
+			stage->createProducer( "thread", 64 ), i * spacing, perThread ) );
+	}
+	for( int i = 0; i < numThreads; i++ )
+		threads[i]->start();
+
+	// each thread's packets come out once each, in the order staged
+	std::vector< int > next( numThreads, 0 );
+	int total = 0;
+	int frames = 0;
+	bool ordered = true;
+	while( total < numThreads * perThread && frames < 10000000 )
+	{
+		int merged = 0;
+		std::vector< SentPacket > sent = session.send( stage.get(), &merged );
+		CHECK( (int)sent.size() == merged + 1 );
+		for( unsigned int i = 1; i < sent.size(); i++ )
+		{
+			int thread = sent[i].second / spacing;
+			if( thread >= numThreads || sent[i].second % spacing != next[thread] )
+				ordered = false;
+			else
+				next[thread]++;
+		}
+		total += merged;
+		frames++;
+		if( merged == 0 )
+			OpenThreads::Thread::YieldCurrentThread();
+	}
+	CHECK( ordered );
+	CHECK( total == numThreads * perThread );
+	for( int i = 0; i < numThreads; i++ )
+		CHECK( next[i] == perThread );
+
+	for( int i = 0; i < numThreads; i++ )
+	{
+		threads[i]->join();
+		delete threads[i];
+	}
+	stage->report();
+}
+
+
+// ================================================
+// main
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int main( int argc, char **argv )
+{
+	testMergeOrder();
+	testFull();
+	testThreads();
+	return testResult();
+}
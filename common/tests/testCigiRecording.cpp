@@ -0,0 +1,276 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "CigiRecording.h"
+#include "TestCheck.h"
+
+using namespace mpv;
+
+namespace
+{
+	const char *recordingFilename = "testCigiRecording.rec";
+
+	//! type (1) + length (4) + timestamp (8)
+	const int recordHeaderSize = 13;
+
+	//! Reads a whole file
+	std::vector< unsigned char > readFile( const char *filename )
+	{
+		std::vector< unsigned char > contents;
+		FILE *file = fopen( filename, "rb" );
+		if( file == NULL )
+			return contents;
+		unsigned char buffer[256];
+		size_t n;
+		while( ( n = fread( buffer, 1, sizeof( buffer ), file ) ) > 0 )
+			contents.insert( contents.end(), buffer, buffer + n );
+		fclose( file );
+		return contents;
+	}
+
+	//! Replaces a file's contents
+	void writeFile( const char *filename, const std::vector< unsigned char > &contents )
+	{
+		FILE *file = fopen( filename, "wb" );
+		if( file == NULL )
+			return;
+		if( !contents.empty() )
+			fwrite( &contents[0], 1, contents.size(), file );
+		fclose( file );
+	}
+
+	unsigned int getU32( const unsigned char *p )
+	{
+		return p[0] | ( p[1] << 8 ) | ( p[2] << 16 ) | ( (unsigned int)p[3] << 24 );
+	}
+
+	//! Writes the recording the tests start from: an incoming datagram,
+	//! an outgoing one, and a frame end
+	void writeSample()
+	{
+		unsigned char incoming[40];
+		for( int i = 0; i < (int)sizeof( incoming ); i++ )
+			incoming[i] = (unsigned char)i;
+		unsigned char outgoing[3] = { 0xff, 0x00, 0x80 };
+
+		CigiRecordWriter writer;
+		CHECK( writer.open( recordingFilename ) );
+		writer.write( CigiRecord::Incoming, incoming, sizeof( incoming ) );
+		writer.write( CigiRecord::Outgoing, outgoing, sizeof( outgoing ) );
+		writer.write( CigiRecord::FrameEnd, NULL, 0 );
+		writer.close();
+	}
+}
+
+
+// ================================================
+// testRoundTrip
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testRoundTrip()
+{
+	writeSample();
+
+	CigiRecordReader reader;
+	CHECK( reader.open( recordingFilename ) );
+
+	CigiRecord record;
+	CHECK( reader.read( record ) );
+	CHECK( record.type == CigiRecord::Incoming );
+	CHECK( record.data.size() == 40 );
+	CHECK( record.data.size() == 40 && record.data[0] == 0 && record.data[39] == 39 );
+	double previousTime = record.time;
+	CHECK( previousTime >= 0.0 );
+
+	CHECK( reader.read( record ) );
+	CHECK( record.type == CigiRecord::Outgoing );
+	CHECK( record.data.size() == 3 );
+	CHECK( record.data.size() == 3 && record.data[0] == 0xff && record.data[2] == 0x80 );
+	CHECK( record.time >= previousTime );
+	previousTime = record.time;
+
+	CHECK( reader.read( record ) );
+	CHECK( record.type == CigiRecord::FrameEnd );
+	CHECK( record.data.empty() );
+	CHECK( record.time >= previousTime );
+
+	CHECK( !reader.read( record ) );
+}
+
+
+// ================================================
+// testLayout
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testLayout()
+{
+	// recordings are read on other machines, so the bytes are pinned 
+	// down, not just the round trip
+	writeSample();
+	std::vector< unsigned char > contents = readFile( recordingFilename );
+	CHECK( contents.size() == 16 + 3 * recordHeaderSize + 40 + 3 );
+	if( contents.size() != 16 + 3 * recordHeaderSize + 40 + 3 )
+		return;
+
+	CHECK( memcmp( &contents[0], "MPVCIGIR", 8 ) == 0 );
+	CHECK( getU32( &contents[8] ) == 1 );
+	CHECK( getU32( &contents[12] ) == 0 );
+
+	const unsigned char *record = &contents[16];
+	CHECK( record[0] == CigiRecord::Incoming );
+	CHECK( getU32( record + 1 ) == 40 );
+	CHECK( record[recordHeaderSize] == 0 && record[recordHeaderSize + 39] == 39 );
+
+	record += recordHeaderSize + 40;
+	CHECK( record[0] == CigiRecord::Outgoing );
+	CHECK( getU32( record + 1 ) == 3 );
+	CHECK( record[recordHeaderSize] == 0xff );
+
+	record += recordHeaderSize + 3;
+	CHECK( record[0] == CigiRecord::FrameEnd );
+	CHECK( getU32( record + 1 ) == 0 );
+}
+
+
+// ================================================
+// testTruncated
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testTruncated()
+{
+	// a recording cut short in the second record's payload still gives 
+	// up the first record
+	writeSample();
+	std::vector< unsigned char > contents = readFile( recordingFilename );
+	contents.resize( 16 + recordHeaderSize + 40 + recordHeaderSize + 1 );
+	writeFile( recordingFilename, contents );
+
+	CigiRecordReader reader;
+	CHECK( reader.open( recordingFilename ) );
+	CigiRecord record;
+	CHECK( reader.read( record ) );
+	CHECK( record.type == CigiRecord::Incoming && record.data.size() == 40 );
+	CHECK( !reader.read( record ) );
+
+	// and one cut short in a record header
+	contents.resize( 16 + recordHeaderSize + 40 + 5 );
+	writeFile( recordingFilename, contents );
+	CHECK( reader.open( recordingFilename ) );
+	CHECK( reader.read( record ) );
+	CHECK( !reader.read( record ) );
+
+	// a header alone is an empty recording
+	contents.resize( 16 );
+	writeFile( recordingFilename, contents );
+	CHECK( reader.open( recordingFilename ) );
+	CHECK( !reader.read( record ) );
+}
+
+
+// ================================================
+// testDamaged
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testDamaged()
+{
+	CigiRecordReader reader;
+	CigiRecord record;
+
+	writeSample();
+	std::vector< unsigned char > good = readFile( recordingFilename );
+	std::vector< unsigned char > contents;
+
+	// not a recording
+	contents = good;
+	contents[0] = 'X';
+	writeFile( recordingFilename, contents );
+	CHECK( !reader.open( recordingFilename ) );
+	CHECK( !reader.isOpen() );
+
+	// a version this reader doesn't know
+	contents = good;
+	contents[8] = 2;
+	writeFile( recordingFilename, contents );
+	CHECK( !reader.open( recordingFilename ) );
+
+	// shorter than the header
+	contents = good;
+	contents.resize( 10 );
+	writeFile( recordingFilename, contents );
+	CHECK( !reader.open( recordingFilename ) );
+
+	// an unknown record type ends the recording
+	contents = good;
+	contents[16] = 3;
+	writeFile( recordingFilename, contents );
+	CHECK( reader.open( recordingFilename ) );
+	CHECK( !reader.read( record ) );
+
+	// so does an absurd length, rather than a huge allocation
+	contents = good;
+	contents[16 + 4] = 0x7f;
+	writeFile( recordingFilename, contents );
+	CHECK( reader.open( recordingFilename ) );
+	CHECK( !reader.read( record ) );
+
+	CHECK( !reader.open( "no such recording" ) );
+	CHECK( !reader.read( record ) );
+}
+
+
+// ================================================
+// testClosed
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testClosed()
+{
+	// writing to a closed writer does nothing, as does a bad datagram
+	CigiRecordWriter writer;
+	CHECK( !writer.isOpen() );
+	unsigned char byte = 0;
+	writer.write( CigiRecord::Incoming, &byte, 1 );
+
+	CHECK( writer.open( recordingFilename ) );
+	writer.write( CigiRecord::Incoming, NULL, 4 );
+	writer.write( CigiRecord::Incoming, &byte, -1 );
+	writer.close();
+	CHECK( !writer.isOpen() );
+	CHECK( readFile( recordingFilename ).size() == 16 );
+}
+
+
+// ================================================
+// main
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int main( int argc, char **argv )
+{
+	testRoundTrip();
+	testLayout();
+	testTruncated();
+	testDamaged();
+	testClosed();
+
+	remove( recordingFilename );
+	return testResult();
+}
@@ -0,0 +1,319 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <string.h>
+#include <vector>
+
+#include "CigiRingBuffer.h"
+#include "TestCheck.h"
+
+using namespace mpv;
+
+namespace
+{
+	const int capacity = 256;
+
+	//! A formatted ring in heap memory, aligned for its length words
+	struct TestRing
+	{
+		TestRing() : memory( ( CigiRingBuffer::getRequiredSize( capacity ) + 3 ) / 4 )
+		{
+			CigiRingBuffer::format( &memory[0], capacity );
+			ring.attach( &memory[0] );
+		}
+
+		CigiRingBuffer::Header *header() { return (CigiRingBuffer::Header *)&memory[0]; }
+		unsigned char *data() { return (unsigned char *)&memory[0] + sizeof( CigiRingBuffer::Header ); }
+
+		std::vector< unsigned int > memory;
+		CigiRingBuffer ring;
+	};
+
+	//! Fills a message with bytes that depend on its sequence number
+	void fill( unsigned char *message, int length, int sequence )
+	{
+		for( int i = 0; i < length; i++ )
+			message[i] = (unsigned char)( sequence * 7 + i );
+	}
+
+	bool matches( const unsigned char *message, int length, int sequence )
+	{
+		for( int i = 0; i < length; i++ )
+		{
+			if( message[i] != (unsigned char)( sequence * 7 + i ) )
+				return false;
+		}
+		return true;
+	}
+}
+
+
+// ================================================
+// testFormat
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testFormat()
+{
+	std::vector< unsigned int > memory( 1024 );
+	CHECK( !CigiRingBuffer::format( NULL, 256 ) );
+	CHECK( !CigiRingBuffer::format( &memory[0], 128 ) );
+	CHECK( !CigiRingBuffer::format( &memory[0], 300 ) );
+	CHECK( CigiRingBuffer::format( &memory[0], 256 ) );
+
+	TestRing t;
+	CHECK( t.ring.isAttached() );
+	CHECK( t.ring.getMaxMessageSize() == capacity / 2 - 4 );
+
+	int length = -1;
+	CHECK( t.ring.peek( length ) == NULL );
+	unsigned char buffer[16];
+	CHECK( t.ring.read( buffer, sizeof( buffer ) ) == 0 );
+}
+
+
+// ================================================
+// testRoundTrip
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testRoundTrip()
+{
+	TestRing t;
+	unsigned char message[64];
+
+	// lengths that aren't multiples of 4 are padded in the ring
+	for( int length = 0; length <= 9; length++ )
+	{
+		fill( message, length, length );
+		CHECK( t.ring.write( message, length ) );
+	}
+	for( int length = 0; length <= 9; length++ )
+	{
+		int peeked = -1;
+		const unsigned char *in = t.ring.peek( peeked );
+		CHECK( in != NULL );
+		if( in == NULL )
+			return;
+		CHECK( peeked == length );
+		CHECK( matches( in, peeked, length ) );
+		t.ring.release();
+	}
+
+	int length = -1;
+	CHECK( t.ring.peek( length ) == NULL );
+
+	// reserve() and commit() build a message in place
+	unsigned char *out = t.ring.reserve( 10 );
+	CHECK( out != NULL );
+	fill( out, 10, 3 );
+	t.ring.commit( 10 );
+	unsigned char buffer[64];
+	CHECK( t.ring.read( buffer, sizeof( buffer ) ) == 10 );
+	CHECK( matches( buffer, 10, 3 ) );
+
+	// a message too big for the reader's buffer is dropped
+	CHECK( t.ring.write( message, 20 ) );
+	CHECK( t.ring.read( buffer, 8 ) == -1 );
+	CHECK( t.ring.peek( length ) == NULL );
+}
+
+
+// ================================================
+// testFull
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testFull()
+{
+	TestRing t;
+	unsigned char message[256];
+
+	CHECK( !t.ring.write( message, t.ring.getMaxMessageSize() + 1 ) );
+	CHECK( t.ring.reserve( -1 ) == NULL );
+
+	// 28-byte messages take 32 bytes each, so 8 of them fill the ring
+	int written = 0;
+	while( t.ring.write( message, 28 ) )
+		written++;
+	CHECK( written == capacity / 32 );
+	CHECK( t.ring.reserve( 0 ) == NULL );
+
+	// freeing one message makes room for exactly one more
+	unsigned char buffer[64];
+	CHECK( t.ring.read( buffer, sizeof( buffer ) ) == 28 );
+	CHECK( t.ring.write( message, 28 ) );
+	CHECK( !t.ring.write( message, 0 ) );
+
+	int read = 0;
+	while( t.ring.read( buffer, sizeof( buffer ) ) == 28 )
+		read++;
+	CHECK( read == written );
+}
+
+
+// ================================================
+// testWrap
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testWrap()
+{
+	TestRing t;
+	unsigned char message[128];
+	unsigned char buffer[128];
+
+	// Messages of several sizes, read one behind, go round the ring many
+	// times; some straddle the end, and are moved to the start
+	int lengths[] = { 1, 60, 17, 100, 3, 44, 0, 120 };
+	int count = sizeof( lengths ) / sizeof( lengths[0] );
+	int next = 0;
+	for( int sequence = 0; sequence < 1000; sequence++ )
+	{
+		int length = lengths[sequence % count];
+		fill( message, length, sequence );
+		while( !t.ring.write( message, length ) )
+		{
+			// the reader has to catch up first; an empty ring takes any
+			// message up to the maximum size
+			CHECK( next < sequence );
+			if( next == sequence )
+				return;
+			CHECK( t.ring.read( buffer, sizeof( buffer ) ) == lengths[next % count] );
+			CHECK( matches( buffer, lengths[next % count], next ) );
+			next++;
+		}
+		if( sequence % 3 == 0 )
+		{
+			CHECK( t.ring.read( buffer, sizeof( buffer ) ) == lengths[next % count] );
+			CHECK( matches( buffer, lengths[next % count], next ) );
+			next++;
+		}
+	}
+
+	int length;
+	while( t.ring.peek( length ) != NULL )
+	{
+		CHECK( length == lengths[next % count] );
+		t.ring.release();
+		next++;
+	}
+	CHECK( next == 1000 );
+	CHECK( t.ring.isAttached() );
+}
+
+
+// ================================================
+// testIndexWrap
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testIndexWrap()
+{
+	// head and tail count bytes, and wrap at 2^32
+	TestRing t;
+	t.header()->head = 0xffffff00u;
+	t.header()->tail = 0xffffff00u;
+
+	unsigned char message[64];
+	unsigned char buffer[64];
+	for( int sequence = 0; sequence < 40; sequence++ )
+	{
+		fill( message, 50, sequence );
+		CHECK( t.ring.write( message, 50 ) );
+		CHECK( t.ring.read( buffer, sizeof( buffer ) ) == 50 );
+		CHECK( matches( buffer, 50, sequence ) );
+	}
+	CHECK( t.header()->head < 0x1000u );
+}
+
+
+// ================================================
+// testCorruption
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testCorruption()
+{
+	unsigned char message[16];
+	memset( message, 0, sizeof( message ) );
+	int length;
+
+	// a length word running past the end of the ring
+	{
+		TestRing t;
+		CHECK( t.ring.write( message, 8 ) );
+		*(unsigned int *)t.data() = capacity;
+		CHECK( t.ring.peek( length ) == NULL );
+		CHECK( !t.ring.isAttached() );
+		CHECK( t.header()->tail == 0 );
+	}
+
+	// a length word longer than what the producer has published
+	{
+		TestRing t;
+		CHECK( t.ring.write( message, 8 ) );
+		*(unsigned int *)t.data() = 40;
+		CHECK( t.ring.peek( length ) == NULL );
+		CHECK( !t.ring.isAttached() );
+	}
+
+	// a wrap marker with nothing after it
+	{
+		TestRing t;
+		CHECK( t.ring.write( message, 8 ) );
+		*(unsigned int *)t.data() = 0xffffffffu;
+		CHECK( t.ring.peek( length ) == NULL );
+		CHECK( !t.ring.isAttached() );
+		CHECK( t.header()->tail == 0 );
+	}
+
+	// head further ahead than the ring holds
+	{
+		TestRing t;
+		t.header()->head = capacity + 4;
+		CHECK( t.ring.peek( length ) == NULL );
+		CHECK( !t.ring.isAttached() );
+	}
+
+	// head not on a length word
+	{
+		TestRing t;
+		t.header()->head = 6;
+		CHECK( t.ring.peek( length ) == NULL );
+		CHECK( !t.ring.isAttached() );
+	}
+
+	// the consumer's tail past the producer's head
+	{
+		TestRing t;
+		t.header()->tail = 16;
+		CHECK( t.ring.reserve( 8 ) == NULL );
+		CHECK( !t.ring.isAttached() );
+	}
+}
+
+
+// ================================================
+// main
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int main( int argc, char **argv )
+{
+	testFormat();
+	testRoundTrip();
+	testFull();
+	testWrap();
+	testIndexWrap();
+	testCorruption();
+	return testResult();
+}
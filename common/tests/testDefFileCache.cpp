@@ -0,0 +1,364 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+
+#ifdef WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include "DefFileCache.h"
+#include "DefFileParser.h"
+#include "TestCheck.h"
+
+namespace
+{
+	const char *defFilename = "testDefFileCache.def";
+
+	const char *defContents = 
+		"// a comment\n"
+		"view\n"
+		"{\n"
+		"\tid = 3;\n"
+		"\tfov = 45.5;\n"
+		"\tname = \"left channel\";\n"
+		"\toffset = 1.0, -2, 3.5;\n"
+		"\tenabled = true;\n"
+		"\tviewport\n"
+		"\t{\n"
+		"\t\tleft = 0.0;\n"
+		"\t\tname = \"left channel\";\n"
+		"\t}\n"
+		"}\n"
+		"view\n"
+		"{\n"
+		"\tid = 4;\n"
+		"}\n";
+
+	//! the size of the header: magic, version, byte order, size, 
+	//! modification time and hash
+	const size_t headerSize = 8 + 4 + 4 + 8 + 8 + 4;
+
+	std::vector< char > readFile( const std::string &filename )
+	{
+		std::vector< char > contents;
+		FILE *file = fopen( filename.c_str(), "rb" );
+		if( file == NULL )
+			return contents;
+		char buffer[256];
+		size_t n;
+		while( ( n = fread( buffer, 1, sizeof( buffer ), file ) ) > 0 )
+			contents.insert( contents.end(), buffer, buffer + n );
+		fclose( file );
+		return contents;
+	}
+
+	void writeFile( const std::string &filename, const char *data, size_t size )
+	{
+		FILE *file = fopen( filename.c_str(), "wb" );
+		if( file == NULL )
+			return;
+		if( size > 0 )
+			fwrite( data, 1, size, file );
+		fclose( file );
+	}
+
+	void writeFile( const std::string &filename, const std::vector< char > &contents )
+	{
+		writeFile( filename, contents.empty() ? NULL : &contents[0], contents.size() );
+	}
+
+	time_t getMTime( const std::string &filename )
+	{
+		struct stat st;
+		if( stat( filename.c_str(), &st ) != 0 )
+			return 0;
+		return st.st_mtime;
+	}
+
+	void setMTime( const std::string &filename, time_t mtime )
+	{
+		struct utimbuf times;
+		times.actime = mtime;
+		times.modtime = mtime;
+		utime( filename.c_str(), &times );
+	}
+
+	//! Compares two attributes, values, types and list items
+	bool sameAttribute( const DefFileAttrib *a, const DefFileAttrib *b )
+	{
+		if( a->getName() != b->getName() || a->getType() != b->getType() )
+			return false;
+		switch( a->getType() )
+		{
+		case ATTRIB_INT:
+			return a->asInt() == b->asInt();
+		case ATTRIB_FLOAT:
+			return a->asFloat() == b->asFloat();
+		case ATTRIB_LIST:
+			{
+			const std::list< DefFileAttrib * > &aItems = a->getListItems();
+			const std::list< DefFileAttrib * > &bItems = b->getListItems();
+			if( aItems.size() != bItems.size() )
+				return false;
+			std::list< DefFileAttrib * >::const_iterator i = aItems.begin();
+			std::list< DefFileAttrib * >::const_iterator j = bItems.begin();
+			for( ; i != aItems.end(); i++, j++ )
+			{
+				if( !sameAttribute( *i, *j ) )
+					return false;
+			}
+			return true;
+			}
+		default:
+			return a->asString() == b->asString();
+		}
+	}
+
+	//! Compares two trees, in order
+	bool sameGroup( const DefFileGroup *a, const DefFileGroup *b )
+	{
+		if( a->getName() != b->getName() ||
+			a->attributes.size() != b->attributes.size() ||
+			a->children.size() != b->children.size() )
+			return false;
+
+		std::list< DefFileAttrib * >::const_iterator i = a->attributes.begin();
+		std::list< DefFileAttrib * >::const_iterator j = b->attributes.begin();
+		for( ; i != a->attributes.end(); i++, j++ )
+		{
+			if( !sameAttribute( *i, *j ) )
+				return false;
+		}
+
+		std::list< DefFileGroup * >::const_iterator k = a->children.begin();
+		std::list< DefFileGroup * >::const_iterator l = b->children.begin();
+		for( ; k != a->children.end(); k++, l++ )
+		{
+			if( !sameGroup( *k, *l ) )
+				return false;
+		}
+		return true;
+	}
+
+	//! Writes the def file, parses it, and returns the tree; the parser 
+	//! writes the cache
+	DefFileGroup *parseFresh()
+	{
+		remove( DefFileCache::getCacheFilename( defFilename ).c_str() );
+		writeFile( defFilename, defContents, strlen( defContents ) );
+		DefFileParser parser;
+		return parser.parse( defFilename );
+	}
+}
+
+
+// ================================================
+// testRoundTrip
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testRoundTrip()
+{
+	DefFileGroup *parsed = parseFresh();
+	CHECK( parsed != NULL );
+	if( parsed == NULL )
+		return;
+	CHECK( !readFile( DefFileCache::getCacheFilename( defFilename ) ).empty() );
+
+	// the cached tree is the parsed one, values, types and all
+	DefFileGroup *cached = DefFileCache::read( defFilename );
+	CHECK( cached != NULL );
+	if( cached != NULL )
+	{
+		CHECK( sameGroup( parsed, cached ) );
+
+		DefFileGroup *view = cached->getGroupByURI( "/view/" );
+		CHECK( view != NULL );
+		if( view != NULL )
+		{
+			DefFileAttrib *attr = view->getAttribute( "id" );
+			CHECK( attr != NULL && attr->getType() == ATTRIB_INT && attr->asInt() == 3 );
+			attr = view->getAttribute( "fov" );
+			CHECK( attr != NULL && attr->getType() == ATTRIB_FLOAT && attr->asFloat() == 45.5f );
+			attr = view->getAttribute( "name" );
+			CHECK( attr != NULL && attr->asString() == "left channel" );
+			attr = view->getAttribute( "offset" );
+			CHECK( attr != NULL && attr->getType() == ATTRIB_LIST && 
+				attr->getListItems().size() == 3 );
+			attr = view->getAttribute( "enabled" );
+			CHECK( attr != NULL && attr->asInt() == 1 );
+		}
+		delete cached;
+	}
+
+	// the parser uses the cache the next time round
+	DefFileParser parser;
+	DefFileGroup *again = parser.parse( defFilename );
+	CHECK( again != NULL && sameGroup( parsed, again ) );
+	delete again;
+
+	delete parsed;
+}
+
+
+// ================================================
+// testStale
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testStale()
+{
+	delete parseFresh();
+	time_t mtime = getMTime( defFilename );
+
+	// an edit that keeps the size and the modification time
+	std::string edited( defContents );
+	edited.replace( edited.find( "id = 3" ), 6, "id = 7" );
+	writeFile( defFilename, edited.data(), edited.size() );
+	setMTime( defFilename, mtime );
+	CHECK( getMTime( defFilename ) == mtime );
+	CHECK( DefFileCache::read( defFilename ) == NULL );
+
+	// the parser then parses the file, and rewrites the cache
+	DefFileParser parser;
+	DefFileGroup *root = parser.parse( defFilename );
+	CHECK( root != NULL );
+	if( root != NULL )
+	{
+		DefFileAttrib *attr = root->getGroupByURI( "/view/" )->getAttribute( "id" );
+		CHECK( attr != NULL && attr->asInt() == 7 );
+		delete root;
+	}
+	DefFileGroup *cached = DefFileCache::read( defFilename );
+	CHECK( cached != NULL );
+	delete cached;
+
+	// an edit that changes the size
+	edited += "extra { }\n";
+	writeFile( defFilename, edited.data(), edited.size() );
+	CHECK( DefFileCache::read( defFilename ) == NULL );
+
+	// a def file that has only been touched is still served from the cache
+	delete parseFresh();
+	setMTime( defFilename, getMTime( defFilename ) + 100 );
+	cached = DefFileCache::read( defFilename );
+	CHECK( cached != NULL );
+	delete cached;
+
+	// no def file, no cache
+	remove( defFilename );
+	CHECK( DefFileCache::read( defFilename ) == NULL );
+}
+
+
+// ================================================
+// testDamaged
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testDamaged()
+{
+	delete parseFresh();
+	std::string cacheFilename = DefFileCache::getCacheFilename( defFilename );
+	std::vector< char > good = readFile( cacheFilename );
+	CHECK( good.size() > headerSize );
+	if( good.size() <= headerSize )
+		return;
+	std::vector< char > damaged;
+
+	// a cache cut short anywhere is refused
+	int accepted = 0;
+	for( size_t length = 0; length < good.size(); length++ )
+	{
+		damaged.assign( good.begin(), good.begin() + length );
+		writeFile( cacheFilename, damaged );
+		DefFileGroup *root = DefFileCache::read( defFilename );
+		if( root != NULL )
+		{
+			accepted++;
+			delete root;
+		}
+	}
+	CHECK( accepted == 0 );
+
+	// bad magic, version and byte order
+	damaged = good;
+	damaged[0] = 'X';
+	writeFile( cacheFilename, damaged );
+	CHECK( DefFileCache::read( defFilename ) == NULL );
+	damaged = good;
+	damaged[8]++;
+	writeFile( cacheFilename, damaged );
+	CHECK( DefFileCache::read( defFilename ) == NULL );
+	damaged = good;
+	damaged[12]++;
+	writeFile( cacheFilename, damaged );
+	CHECK( DefFileCache::read( defFilename ) == NULL );
+
+	// a string table that claims more strings than the file could hold
+	damaged = good;
+	memset( &damaged[headerSize], 0xff, 4 );
+	writeFile( cacheFilename, damaged );
+	CHECK( DefFileCache::read( defFilename ) == NULL );
+
+	// Any one byte changed past the header gives either no tree or a 
+	// tree; either way nothing is read outside the cache.  (Changes to 
+	// values can't be detected, since there's no checksum over the cache 
+	// itself.)
+	for( size_t i = headerSize; i < good.size(); i++ )
+	{
+		damaged = good;
+		damaged[i] ^= 0xa5;
+		writeFile( cacheFilename, damaged );
+		delete DefFileCache::read( defFilename );
+	}
+
+	// an empty cache
+	writeFile( cacheFilename, NULL, 0 );
+	CHECK( DefFileCache::read( defFilename ) == NULL );
+
+	// and the good one still works
+	writeFile( cacheFilename, good );
+	DefFileGroup *root = DefFileCache::read( defFilename );
+	CHECK( root != NULL );
+	delete root;
+}
+
+
+// ================================================
+// main
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int main( int argc, char **argv )
+{
+	testRoundTrip();
+	testStale();
+	testDamaged();
+
+	remove( defFilename );
+	remove( DefFileCache::getCacheFilename( defFilename ).c_str() );
+	return testResult();
+}
@@ -0,0 +1,367 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <string>
+#include <vector>
+
+#include "DefFileGroup.h"
+#include "DefFilePath.h"
+#include "TestCheck.h"
+
+namespace
+{
+	//! Few names, so that the trees are full of same-named siblings
+	const char *names[] = { "a", "b", "view", "x_1", "" };
+	const int numNames = 5;
+
+	unsigned int seed = 12345;
+
+	int randomInt( int limit )
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return (int)( ( seed >> 16 ) % limit );
+	}
+
+	//=========================================================
+	//! The lookups as they were before the index: list scans, with the 
+	//! first complete match winning
+	//!
+	const DefFileAttrib *scanAttribute( const DefFileGroup *group, const std::string &name )
+	{
+		std::list< DefFileAttrib * >::const_iterator iter;
+		for( iter = group->attributes.begin(); iter != group->attributes.end(); iter++ )
+		{
+			if( (*iter)->getName() == name )
+				return *iter;
+		}
+		return NULL;
+	}
+
+	const DefFileGroup *scanChild( const DefFileGroup *group, const std::string &name )
+	{
+		std::list< DefFileGroup * >::const_iterator iter;
+		for( iter = group->children.begin(); iter != group->children.end(); iter++ )
+		{
+			if( (*iter)->getName() == name )
+				return *iter;
+		}
+		return NULL;
+	}
+
+	//! as getGroupByURI() was: slashes are skipped, and each child with 
+	//! the next name is tried in turn
+	const DefFileGroup *scanGroupByURI( const DefFileGroup *group, const char *uri )
+	{
+		while( *uri == '/' )
+			uri++;
+		const char *tokenStart = uri;
+		while( *uri != '/' && *uri != '\0' )
+			uri++;
+		if( *uri == '\0' )
+			return group;
+
+		std::string groupName( tokenStart, uri - tokenStart );
+		std::list< DefFileGroup * >::const_iterator iter;
+		for( iter = group->children.begin(); iter != group->children.end(); iter++ )
+		{
+			if( (*iter)->getName() != groupName )
+				continue;
+			const DefFileGroup *result = scanGroupByURI( *iter, uri );
+			if( result != NULL )
+				return result;
+		}
+		return NULL;
+	}
+
+	const DefFileAttrib *scanAttributeByURI( const DefFileGroup *group, const char *uri )
+	{
+		while( *uri == '/' )
+			uri++;
+		const char *tokenStart = uri;
+		while( *uri != '/' && *uri != '\0' )
+			uri++;
+		if( *uri == '\0' )
+			return scanAttribute( group, tokenStart );
+
+		std::string groupName( tokenStart, uri - tokenStart );
+		std::list< DefFileGroup * >::const_iterator iter;
+		for( iter = group->children.begin(); iter != group->children.end(); iter++ )
+		{
+			if( (*iter)->getName() != groupName )
+				continue;
+			const DefFileAttrib *result = scanAttributeByURI( *iter, uri );
+			if( result != NULL )
+				return result;
+		}
+		return NULL;
+	}
+
+	//=========================================================
+	//! Builds a random tree, naming groups after they are added, as the 
+	//! parser does
+	//!
+	void buildTree( DefFileGroup *group, int depth, std::vector< DefFileGroup * > &groups )
+	{
+		groups.push_back( group );
+
+		int numAttributes = randomInt( 5 );
+		for( int i = 0; i < numAttributes; i++ )
+		{
+			DefFileAttrib *attr = new DefFileAttrib();
+			attr->setName( names[randomInt( numNames )] );
+			attr->setInt( i );
+			group->addAttribute( attr );
+		}
+
+		if( depth >= 4 )
+			return;
+		int numChildren = randomInt( 4 );
+		for( int i = 0; i < numChildren; i++ )
+		{
+			DefFileGroup *child = new DefFileGroup();
+			group->addChild( child );
+			child->setName( names[randomInt( numNames )] );
+			buildTree( child, depth + 1, groups );
+		}
+	}
+
+	//! Every URI of up to three names, with and without a trailing slash, 
+	//! plus some odd ones
+	std::vector< std::string > makeURIs()
+	{
+		std::vector< std::string > uris;
+		uris.push_back( "" );
+		uris.push_back( "/" );
+		for( int i = 0; i < numNames; i++ )
+		{
+			std::string one = std::string( "/" ) + names[i];
+			uris.push_back( one );
+			uris.push_back( one + "/" );
+			for( int j = 0; j < numNames; j++ )
+			{
+				std::string two = one + "/" + names[j];
+				uris.push_back( two );
+				uris.push_back( two + "/" );
+				for( int k = 0; k < numNames; k++ )
+				{
+					std::string three = two + "/" + names[k];
+					uris.push_back( three );
+					uris.push_back( three + "/" );
+				}
+			}
+		}
+		uris.push_back( "a/b" );
+		uris.push_back( "//a//b/" );
+		uris.push_back( "/a/never_interned_name" );
+		uris.push_back( "/never_interned_name/a" );
+		return uris;
+	}
+
+	//! Compares every lookup against the list scans; returns the number 
+	//! of mismatches
+	int compareLookups( DefFileGroup *root, const std::vector< DefFileGroup * > &groups, 
+		const std::vector< std::string > &uris )
+	{
+		int mismatches = 0;
+		const DefFileGroup *constRoot = root;
+
+		for( unsigned int i = 0; i < uris.size(); i++ )
+		{
+			const char *uri = uris[i].c_str();
+			const DefFileGroup *group = scanGroupByURI( root, uri );
+			const DefFileAttrib *attr = scanAttributeByURI( root, uri );
+
+			if( root->getGroupByURI( uris[i] ) != group ||
+				constRoot->getGroupByURI( uris[i] ) != group ||
+				root->getAttributeByURI( uris[i] ) != attr ||
+				constRoot->getAttributeByURI( uris[i] ) != attr )
+				mismatches++;
+
+			// compiled once, resolved from the root
+			DefFilePath path( uris[i] );
+			if( path.findGroup( root ) != group || path.findAttribute( constRoot ) != attr )
+				mismatches++;
+		}
+
+		for( unsigned int g = 0; g < groups.size(); g++ )
+		{
+			DefFileGroup *group = groups[g];
+			for( int i = 0; i < numNames; i++ )
+			{
+				if( group->getAttribute( names[i] ) != scanAttribute( group, names[i] ) ||
+					group->getAttribute( DefFileName( names[i] ) ) != scanAttribute( group, names[i] ) ||
+					group->getChild( names[i] ) != scanChild( group, names[i] ) ||
+					group->getChild( DefFileName( names[i] ) ) != scanChild( group, names[i] ) )
+					mismatches++;
+			}
+			if( group->getAttribute( "never_interned_name" ) != NULL ||
+				group->getChild( "never_interned_name" ) != NULL )
+				mismatches++;
+		}
+		return mismatches;
+	}
+
+	//! Picks a random group, other than the root
+	DefFileGroup *pickGroup( const std::vector< DefFileGroup * > &groups )
+	{
+		return groups[1 + randomInt( (int)groups.size() - 1 )];
+	}
+}
+
+
+// ================================================
+// testRandomTrees
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testRandomTrees()
+{
+	std::vector< std::string > uris = makeURIs();
+
+	for( int tree = 0; tree < 50; tree++ )
+	{
+		DefFileGroup *root = new DefFileGroup();
+		std::vector< DefFileGroup * > groups;
+		buildTree( root, 0, groups );
+		CHECK( compareLookups( root, groups, uris ) == 0 );
+
+		if( groups.size() < 2 )
+		{
+			delete root;
+			continue;
+		}
+
+		// Change the tree between lookups, in each of the ways the index 
+		// has to notice
+		for( int change = 0; change < 20; change++ )
+		{
+			DefFileGroup *group = pickGroup( groups );
+			switch( randomInt( 6 ) )
+			{
+			case 0:
+				// rename an attribute, after the index has been built
+				if( !group->attributes.empty() )
+					group->attributes.front()->setName( names[randomInt( numNames )] );
+				break;
+			case 1:
+				// rename a group
+				group->setName( names[randomInt( numNames )] );
+				break;
+			case 2:
+				{
+				// add an attribute, named before it's added
+				DefFileAttrib *attr = new DefFileAttrib();
+				attr->setName( names[randomInt( numNames )] );
+				group->addAttribute( attr );
+				}
+				break;
+			case 3:
+				// remove an attribute
+				if( !group->attributes.empty() )
+				{
+					DefFileAttrib *attr = group->attributes.back();
+					group->removeAttribute( attr );
+					delete attr;
+				}
+				break;
+			case 4:
+				{
+				// add a child, named after it's added
+				DefFileGroup *child = new DefFileGroup();
+				group->addChild( child );
+				child->setName( names[randomInt( numNames )] );
+				groups.push_back( child );
+				}
+				break;
+			case 5:
+				{
+				// add an attribute through the public list
+				DefFileAttrib *attr = new DefFileAttrib();
+				attr->setName( names[randomInt( numNames )] );
+				group->attributes.push_front( attr );
+				}
+				break;
+			}
+			CHECK( compareLookups( root, groups, uris ) == 0 );
+		}
+
+		delete root;
+	}
+}
+
+
+// ================================================
+// testRename
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testRename()
+{
+	DefFileGroup root;
+	DefFileAttrib *fov = new DefFileAttrib();
+	fov->setName( "fov" );
+	root.addAttribute( fov );
+	DefFileAttrib *near = new DefFileAttrib();
+	near->setName( "near" );
+	root.addAttribute( near );
+
+	CHECK( root.getAttribute( "fov" ) == fov );
+
+	// a renamed attribute is found under its new name, and no longer 
+	// under its old one
+	fov->setName( "fov_y" );
+	CHECK( root.getAttribute( "fov_y" ) == fov );
+	CHECK( root.getAttribute( "fov" ) == NULL );
+
+	// renamed to the name of a later attribute, it's found first
+	near->setName( "far" );
+	fov->setName( "far" );
+	CHECK( root.getAttribute( "far" ) == fov );
+	CHECK( root.getAttributeByURI( "/far" ) == fov );
+
+	// once removed, renaming it doesn't disturb the group
+	root.removeAttribute( fov );
+	CHECK( root.getAttribute( "far" ) == near );
+	fov->setName( "near" );
+	CHECK( root.getAttribute( "near" ) == NULL );
+	delete fov;
+
+	// groups too
+	DefFileGroup *child = new DefFileGroup();
+	root.addChild( child );
+	child->setName( "view" );
+	CHECK( root.getGroupByURI( "/view/" ) == child );
+	child->setName( "window" );
+	CHECK( root.getGroupByURI( "/view/" ) == NULL );
+	CHECK( root.getGroupByURI( "/window/" ) == child );
+}
+
+
+// ================================================
+// main
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int main( int argc, char **argv )
+{
+	testRandomTrees();
+	testRename();
+
+	return testResult();
+}
@@ -0,0 +1,198 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <stdio.h>
+#include <string>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Log.h"
+#include "TestCheck.h"
+
+using namespace mpv;
+
+namespace
+{
+	const char *logFilename = "testLog.log";
+
+	int formatted = 0;
+
+	//! Stands in for an expensive stream expression
+	int countFormatting()
+	{
+		formatted++;
+		return formatted;
+	}
+
+	void sleepSeconds( double seconds )
+	{
+#ifdef WIN32
+		Sleep( (DWORD)( seconds * 1000.0 ) );
+#else
+		usleep( (useconds_t)( seconds * 1000000.0 ) );
+#endif
+	}
+
+	//! Returns the number of lines in the log file containing text
+	int countLines( const std::string &text )
+	{
+		FILE *f = fopen( logFilename, "r" );
+		if( f == NULL )
+			return -1;
+		int count = 0;
+		char line[512];
+		while( fgets( line, sizeof( line ), f ) != NULL )
+		{
+			if( std::string( line ).find( text ) != std::string::npos )
+				count++;
+		}
+		fclose( f );
+		return count;
+	}
+}
+
+
+// ================================================
+// testSeverity
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testSeverity()
+{
+	Log &log = Log::instance();
+	log.setRateLimit( 0, 1.0 );
+	log.setMinimumSeverity( Log::Warning );
+	CHECK( log.getMinimumSeverity() == Log::Warning );
+
+	// a filtered message isn't formatted at all
+	formatted = 0;
+	MPV_LOG_INFO( "filtered " << countFormatting() );
+	MPV_LOG_DEBUG( "filtered " << countFormatting() );
+	CHECK( formatted == 0 );
+	MPV_LOG_WARNING( "severity test " << countFormatting() );
+	MPV_LOG_ERROR( "severity test " << countFormatting() );
+	CHECK( formatted == 2 );
+	CHECK( countLines( "severity test" ) == 2 );
+	CHECK( countLines( "filtered" ) == 0 );
+
+	log.setMinimumSeverity( Log::Debug );
+	CHECK( Log::parseSeverityName( "warning" ) == Log::Warning );
+	CHECK( Log::parseSeverityName( "nonsense" ) == Log::Info );
+}
+
+
+// ================================================
+// testRateLimit
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testRateLimit()
+{
+	Log &log = Log::instance();
+	log.setRateLimit( 3, 0.2 );
+
+	// each site has its own limit
+	LogSite first( "first.cpp", 1 );
+	LogSite second( "second.cpp", 2 );
+	int passed = 0;
+	for( int i = 0; i < 10; i++ )
+	{
+		if( log.shouldLog( first, Log::Warning ) )
+			passed++;
+	}
+	CHECK( passed == 3 );
+	CHECK( first.suppressed == 7 );
+	CHECK( log.shouldLog( second, Log::Warning ) );
+
+	// the count comes out in a summary once the window has passed, and 
+	// the site may write again
+	sleepSeconds( 0.3 );
+	CHECK( log.shouldLog( first, Log::Warning ) );
+	CHECK( first.suppressed == 0 );
+	CHECK( countLines( "7 similar messages suppressed (first.cpp:1)" ) == 1 );
+
+	// through the macro, one site in a loop
+	formatted = 0;
+	for( int i = 0; i < 20; i++ )
+		MPV_LOG_WARNING( "rate test " << countFormatting() );
+	CHECK( formatted == 3 );
+	CHECK( countLines( "rate test" ) == 3 );
+
+	// 0 turns the limit off
+	log.setRateLimit( 0, 0.2 );
+	passed = 0;
+	for( int i = 0; i < 100; i++ )
+	{
+		if( log.shouldLog( second, Log::Warning ) )
+			passed++;
+	}
+	CHECK( passed == 100 );
+}
+
+
+// ================================================
+// testWriter
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testWriter()
+{
+	Log &log = Log::instance();
+	log.setRateLimit( 2, 0.2 );
+	log.startWriter();
+
+	// the destination is fixed while the writer runs
+	CHECK( !log.setDestination( Log::Console ) );
+
+	for( int i = 0; i < 10; i++ )
+		MPV_LOG_WARNING( "writer test" );
+
+	// stopping the writer drains the queue, and writes the summary of 
+	// the suppressed messages
+	log.stopWriter();
+	CHECK( countLines( "writer test" ) == 2 );
+	CHECK( countLines( "8 similar messages suppressed" ) == 1 );
+
+	CHECK( log.setDestination( Log::Console ) );
+}
+
+
+// ================================================
+// main
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int main( int argc, char **argv )
+{
+	remove( logFilename );
+	if( !Log::instance().setDestination( Log::File, logFilename ) )
+	{
+		fprintf( stderr, "can't write %s\n", logFilename );
+		return 1;
+	}
+
+	testSeverity();
+	testRateLimit();
+	testWriter();
+
+	remove( logFilename );
+	return testResult();
+}
@@ -0,0 +1,221 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+#include <vector>
+
+#include "RandomStream.h"
+#include "TestCheck.h"
+
+using namespace mpv;
+
+
+// ================================================
+// testKnownValues
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testKnownValues()
+{
+	// Every IG has to draw the same numbers, whatever the compiler or 
+	// platform, so the values are pinned down here.  If these change, 
+	// IGs built before and after the change won't agree.
+	CHECK( SyncedRandom::getStreamID( "" ) == 2166136261u );
+	CHECK( SyncedRandom::getStreamID( "a" ) == 0xe40c292cu );
+	unsigned int streamID = SyncedRandom::getStreamID( "ParticleSystem" );
+	CHECK( streamID == 1178498654u );
+
+	RandomStream stream( streamID, 1000 );
+	CHECK( stream.next() == 0xd0efdfb2u );
+	CHECK( stream.next() == 0x0ff97271u );
+	CHECK( stream.next() == 0xbf3c6ecdu );
+	CHECK( stream.next() == 0xa861a33du );
+	CHECK( stream.getIndex() == 4 );
+}
+
+
+// ================================================
+// testReproducible
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testReproducible()
+{
+	// the same stream and frame give the same sequence, however it's drawn
+	RandomStream a( 17, 42 );
+	RandomStream b( 17, 42 );
+	RandomStream c( 17, 42, 100 );
+	bool same = true;
+	bool atMatches = true;
+	for( unsigned int i = 0; i < 1000; i++ )
+	{
+		unsigned int value = a.next();
+		if( value != b.next() )
+			same = false;
+		if( value != c.at( i ) )
+			atMatches = false;
+	}
+	CHECK( same );
+	CHECK( atMatches );
+
+	// starting at an index skips to it
+	RandomStream d( 17, 42 );
+	CHECK( c.next() == d.at( 100 ) );
+
+	// drawing from one stream doesn't disturb another
+	RandomStream e( 18, 42 );
+	RandomStream f( 18, 42 );
+	for( int i = 0; i < 10; i++ )
+		d.next();
+	CHECK( e.next() == f.next() );
+}
+
+
+// ================================================
+// testIndependent
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testIndependent()
+{
+	// neighbouring streams and frames give different sequences
+	const int count = 64;
+	RandomStream base( 17, 42 );
+	RandomStream otherStream( 18, 42 );
+	RandomStream otherFrame( 17, 43 );
+	int sameStream = 0;
+	int sameFrame = 0;
+	for( int i = 0; i < count; i++ )
+	{
+		unsigned int value = base.next();
+		if( value == otherStream.next() )
+			sameStream++;
+		if( value == otherFrame.next() )
+			sameFrame++;
+	}
+	CHECK( sameStream == 0 );
+	CHECK( sameFrame == 0 );
+
+	// a frame number the host has synced gives the same stream
+	SyncedRandom synced;
+	synced.setFrameNumber( 42 );
+	RandomStream fromSynced = synced.getStream( 17 );
+	RandomStream direct( 17, 42 );
+	CHECK( fromSynced.next() == direct.next() );
+	CHECK( synced.getStream( 17, 43 ).next() == RandomStream( 17, 43 ).next() );
+}
+
+
+// ================================================
+// testFill
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testFill()
+{
+	const int count = 1000;
+
+	// a fill gives the values next() would have
+	RandomStream serial( 5, 9 );
+	std::vector< float > expected( count );
+	for( int i = 0; i < count; i++ )
+		expected[i] = serial.nextFloat( -2.0f, 3.0f );
+
+	RandomStream bulk( 5, 9 );
+	std::vector< float > filled( count );
+	bulk.fill( &filled[0], count, -2.0f, 3.0f );
+	CHECK( filled == expected );
+	CHECK( bulk.getIndex() == (unsigned int)count );
+
+	// and so does a fill split into parts, as the threads of a bulk 
+	// fill would do it, in any order
+	const RandomStream shared( 5, 9 );
+	std::vector< float > split( count );
+	shared.fill( &split[600], count - 600, -2.0f, 3.0f, 600 );
+	shared.fill( &split[0], 250, -2.0f, 3.0f, 0 );
+	shared.fill( &split[250], 350, -2.0f, 3.0f, 250 );
+	CHECK( split == expected );
+
+	// the same for ints
+	RandomStream serialInts( 5, 9 );
+	std::vector< int > expectedInts( count );
+	for( int i = 0; i < count; i++ )
+		expectedInts[i] = serialInts.nextInt( -5, 5 );
+	std::vector< int > filledInts( count );
+	shared.fill( &filledInts[500], count - 500, -5, 5, 500 );
+	shared.fill( &filledInts[0], 500, -5, 5, 0 );
+	CHECK( filledInts == expectedInts );
+}
+
+
+// ================================================
+// testRanges
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testRanges()
+{
+	CHECK( RandomStream::toFloat( 0 ) == 0.0f );
+	CHECK( RandomStream::toFloat( 0xffffffffu ) < 1.0f );
+	CHECK( RandomStream::toInt( 0, -3, 3 ) == -3 );
+	CHECK( RandomStream::toInt( 0xffffffffu, -3, 3 ) == 3 );
+	CHECK( RandomStream::toInt( 0, -2147483647 - 1, 2147483647 ) == -2147483647 - 1 );
+	CHECK( RandomStream::toInt( 0xffffffffu, -2147483647 - 1, 2147483647 ) == 2147483647 );
+	CHECK( RandomStream::toInt( 12345, 7, 7 ) == 7 );
+
+	// every value in a small range turns up, and nothing outside it
+	RandomStream stream( 3, 1 );
+	int counts[6] = { 0, 0, 0, 0, 0, 0 };
+	bool inRange = true;
+	for( int i = 0; i < 6000; i++ )
+	{
+		int value = stream.nextInt( 0, 5 );
+		if( value < 0 || value > 5 )
+			inRange = false;
+		else
+			counts[value]++;
+	}
+	CHECK( inRange );
+	for( int i = 0; i < 6; i++ )
+		CHECK( counts[i] > 800 && counts[i] < 1200 );
+
+	// nextFloat( minimum, maximum ) may round up to maximum, so only the 
+	// unit range is checked as half-open
+	bool floatsInRange = true;
+	for( int i = 0; i < 6000; i++ )
+	{
+		float value = stream.nextFloat();
+		if( value < 0.0f || value >= 1.0f )
+			floatsInRange = false;
+		value = stream.nextFloat( -1.0f, 1.0f );
+		if( value < -1.0f || value > 1.0f )
+			floatsInRange = false;
+	}
+	CHECK( floatsInRange );
+}
+
+
+// ================================================
+// main
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int main( int argc, char **argv )
+{
+	testKnownValues();
+	testReproducible();
+	testIndependent();
+	testFill();
+	testRanges();
+
+	return testResult();
+}
@@ -20,6 +20,10 @@
  *  The children of this base class construct EntityElements
  *  
  *  Initial Release: 2007-03-24 Andrew Sampson
+ *  
+ *  2026-10-19
+ *      Factories can compile an element definition once, into parameters 
+ *      that are shared by every entity of the type.
  * </pre>
  */
 
@@ -39,3 +43,15 @@ EntityElementFactory::~EntityElementFactory()
 
 }
 
+
+ElementParams *EntityElementFactory::compile( 
+	DefFileGroup *elementDefinition, int entityType )
+{
+	return NULL;
+}
+
+EntityElement *EntityElementFactory::createElement( 
+	const ElementParams *params, Entity *ent )
+{
+	return NULL;
+}
@@ -20,6 +20,10 @@
  *  The children of this base class construct EntityElements
  *  
  *  Initial Release: 2007-03-24 Andrew Sampson
+ *  
+ *  2026-10-19
+ *      Factories can compile an element definition once, into parameters 
+ *      that are shared by every entity of the type.
  * </pre>
  */
 
@@ -29,6 +33,8 @@
 
 #include <string>
 
+#include "Referenced.h"
+#include "RefPtr.h"
 #include "Entity.h"
 #include "DefFileGroup.h"
 #include "EntityElement.h"
@@ -39,6 +45,18 @@
 namespace mpvosg
 {
 
+//=========================================================
+//! An element definition, parsed by an EntityElementFactory.  Factories 
+//! derive their own parameter classes from this one.  The parameters are 
+//! not changed once compiled, and are shared by every entity of the type.
+//! 
+class MPVCMNOSG_SPEC ElementParams : public mpv::Referenced
+{
+protected:
+	virtual ~ElementParams() {}
+};
+
+
 class MPVCMNOSG_SPEC EntityElementFactory
 {
 public:
@@ -50,6 +68,25 @@ public:
 	virtual EntityElement *createElement( 
 		DefFileGroup *elementDefinition, mpv::Entity *ent ) = 0;
 	
+	//=========================================================
+	//! Parses an element definition, so that elements can later be created 
+	//! without going back to the config data.  Called once per entity type, 
+	//! when the config is processed.
+	//! \param elementDefinition - the element's config group
+	//! \param entityType - the type being compiled; for messages
+	//! 
+	//! \return the parameters, or NULL if this factory doesn't compile its 
+	//!   definitions (createElement() is then called with the config group)
+	//! 
+	virtual ElementParams *compile( 
+		DefFileGroup *elementDefinition, int entityType );
+	
+	//=========================================================
+	//! Creates an element from parameters returned by compile()
+	//! 
+	virtual EntityElement *createElement( 
+		const ElementParams *params, mpv::Entity *ent );
+	
 protected:
 	
 	//=========================================================
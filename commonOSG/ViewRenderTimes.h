@@ -0,0 +1,41 @@
+/*
+
+Per-view render timing, measured by the camera plugin and displayed by the 
+statistics plugin.
+
+Copyright 2026
+
+
+*/
+
+#ifndef VIEW_RENDER_TIMES_H
+#define VIEW_RENDER_TIMES_H
+
+#include <map>
+
+namespace mpvosg
+{
+
+//=========================================================
+//! How long one view took to render, averaged over the last few frames.  
+//! Times are in seconds; a time that hasn't been measured yet is 0.
+//! 
+struct ViewRenderTimes
+{
+	ViewRenderTimes() : cullTime( 0.0 ), drawTime( 0.0 ), gpuDrawTime( 0.0 ) {}
+	
+	//! CPU time spent culling the view
+	double cullTime;
+	//! CPU time spent issuing the view's draw calls
+	double drawTime;
+	//! GPU time spent drawing the view; only measured while the viewer's 
+	//! "gpu" statistics are being collected (osgViewer::StatsHandler)
+	double gpuDrawTime;
+};
+
+//! keyed by view ID; posted on the blackboard as "ViewRenderTimes"
+typedef std::map< int, ViewRenderTimes > ViewRenderTimesMap;
+
+}
+
+#endif
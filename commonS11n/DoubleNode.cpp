@@ -66,7 +66,10 @@ double DoubleNode::get() const
 
 void DoubleNode::set( double v )
 {
+	if( value == v )
+		return;
 	value = v;
+	notifyChanged();
 }
 
 
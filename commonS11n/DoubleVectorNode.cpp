@@ -66,37 +66,68 @@ std::vector<double> DoubleVectorNode::get() const
 
 void DoubleVectorNode::set( const Vect2 &v )
 {
-	value.clear();
+	if( value.size() == 2 )
+	{
+		bool same = true;
+		for( int i = 0; i < 2 && same; i++ )
+			same = ( value[i] == v[i] );
+		if( same )
+			return;
+	}
 	
 	value.resize( 2 );
 	for( int i = 0; i < 2; i++ )
 	{
 		value[i] = v[i];
 	}
+	notifyChanged();
 }
 
 
 void DoubleVectorNode::set( const Vect3 &v )
 {
-	value.clear();
+	if( value.size() == 3 )
+	{
+		bool same = true;
+		for( int i = 0; i < 3 && same; i++ )
+			same = ( value[i] == v[i] );
+		if( same )
+			return;
+	}
 	
 	value.resize( 3 );
 	for( int i = 0; i < 3; i++ )
 	{
 		value[i] = v[i];
 	}
+	notifyChanged();
 }
 
 
 void DoubleVectorNode::set( const Vect4 &v )
 {
-	value.clear();
+	if( value.size() == 4 )
+	{
+		bool same = true;
+		for( int i = 0; i < 4 && same; i++ )
+			same = ( value[i] == v[i] );
+		if( same )
+			return;
+	}
 	
 	value.resize( 4 );
 	for( int i = 0; i < 4; i++ )
 	{
 		value[i] = v[i];
 	}
+	notifyChanged();
 }
 
 
+void DoubleVectorNode::set( const std::vector<double> &v )
+{
+	if( value == v )
+		return;
+	value = v;
+	notifyChanged();
+}
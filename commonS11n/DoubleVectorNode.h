@@ -61,6 +61,8 @@ public:
 	void set( const mpv::Vect3 &v );
 	void set( const mpv::Vect4 &v );
 	
+	void set( const std::vector<double> &v );
+	
 protected:
 
 	//=========================================================
@@ -66,7 +66,10 @@ float FloatNode::get() const
 
 void FloatNode::set( float v )
 {
+	if( value == v )
+		return;
 	value = v;
+	notifyChanged();
 }
 
 
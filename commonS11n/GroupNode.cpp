@@ -57,6 +57,18 @@ void GroupNode::accept( const NodeVisitor &visitor )
 }
 
 
+// ================================================
+// setObserver
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void GroupNode::setObserver( NodeObserver *newObserver )
+{
+	observer = newObserver;
+	NodeList::iterator iter;
+	for( iter = children.begin(); iter != children.end(); iter++ )
+		(*iter)->setObserver( newObserver );
+}
+
+
 // ================================================
 // addChild
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -66,6 +78,10 @@ void GroupNode::addChild( Node *node )
 		return;
 	// fixme - check if node already in list?
 	children.push_back( node );
+	
+	node->setObserver( observer );
+	if( observer != NULL )
+		observer->childAdded( this, node );
 }
 
 
@@ -74,6 +90,21 @@ void GroupNode::addChild( Node *node )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void GroupNode::removeChild( Node *node )
 {
+	if( node == NULL )
+		return;
+	
+	NodeList::iterator iter;
+	for( iter = children.begin(); iter != children.end(); iter++ )
+	{
+		if( iter->get() == node )
+			break;
+	}
+	if( iter == children.end() )
+		return;
+	
+	if( observer != NULL )
+		observer->childRemoved( this, node );
+	node->setObserver( NULL );
 	children.remove( node );
 }
 
@@ -83,6 +114,13 @@ void GroupNode::removeChild( Node *node )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void GroupNode::removeAllChildren()
 {
+	NodeList::iterator iter;
+	for( iter = children.begin(); iter != children.end(); iter++ )
+	{
+		if( observer != NULL )
+			observer->childRemoved( this, iter->get() );
+		(*iter)->setObserver( NULL );
+	}
 	children.clear();
 }
 
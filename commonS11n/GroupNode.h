@@ -55,6 +55,9 @@ public:
 	//! visitor.visit( something )
 	virtual void accept( const NodeVisitor &visitor );
 	
+	//! Sets the observer for this node and every node beneath it
+	virtual void setObserver( NodeObserver *newObserver );
+	
 	//! 
 	void addChild( Node *node );
 	
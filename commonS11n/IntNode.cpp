@@ -66,7 +66,10 @@ int IntNode::get() const
 
 void IntNode::set( int v )
 {
+	if( value == v )
+		return;
 	value = v;
+	notifyChanged();
 }
 
 
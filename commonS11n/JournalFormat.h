@@ -0,0 +1,238 @@
+/** <pre>
+ *  MPV Serialization Framework
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#ifndef _JOURNALFORMAT_H_
+#define _JOURNALFORMAT_H_
+
+#include <ostream>
+#include <string>
+#include <string.h>
+
+//=========================================================
+//! The on-disk format of an s11n journal, shared by JournalWriter, 
+//! JournalState and JournalReader.  Not part of the public interface.
+//!
+//! A journal is a 16 byte header (the magic string "MPVS11NJ", a 32 bit 
+//! version and 32 reserved bits) followed by one block per frame.  Each 
+//! block is a 1 byte block type, a 32 bit frame number, a 64 bit IEEE 
+//! double holding the simulation time, a 32 bit payload length and the 
+//! payload.  A payload is a sequence of operations:
+//!
+//!   define: op, u32 id, u32 parent id (0 for a root), u16 name length, 
+//!           name, value
+//!   value:  op, u32 id, value
+//!   remove: op, u32 id (the node and everything beneath it)
+//!
+//! A value is a 1 byte value type followed by: nothing for groups; a u32 
+//! length and the bytes for strings; 4 bytes for ints and floats; 8 for 
+//! doubles; a u8 count and that many doubles for double vectors.
+//!
+//! A keyframe block defines every node; it stands alone.  A delta block 
+//! only makes sense applied on top of the state of the previous block.
+//! All integers are little-endian.
+//!
+namespace mpvs11n
+{
+namespace journal
+{
+	const char fileMagic[8] = { 'M', 'P', 'V', 'S', '1', '1', 'N', 'J' };
+	const unsigned int fileVersion = 1;
+	const int fileHeaderSize = 16;
+
+	//! type (1) + frame (4) + time (8) + length (4)
+	const int blockHeaderSize = 17;
+
+	enum BlockType
+	{
+		KeyframeBlock = 1,
+		DeltaBlock = 2
+	};
+
+	enum Op
+	{
+		DefineOp = 1,
+		ValueOp = 2,
+		RemoveOp = 3
+	};
+
+	enum ValueType
+	{
+		GroupValue = 0,
+		StringValue = 1,
+		IntValue = 2,
+		FloatValue = 3,
+		DoubleValue = 4,
+		DoubleVectorValue = 5
+	};
+
+	inline void putU8( std::ostream &out, unsigned int v )
+	{
+		out.put( (char)( v & 0xff ) );
+	}
+
+	inline void putU16( std::ostream &out, unsigned int v )
+	{
+		char b[2] = { (char)( v & 0xff ), (char)( ( v >> 8 ) & 0xff ) };
+		out.write( b, 2 );
+	}
+
+	inline void putU32( std::ostream &out, unsigned int v )
+	{
+		char b[4];
+		for( int i = 0; i < 4; i++ )
+			b[i] = (char)( ( v >> ( 8 * i ) ) & 0xff );
+		out.write( b, 4 );
+	}
+
+	inline void putU64( std::ostream &out, unsigned long long v )
+	{
+		char b[8];
+		for( int i = 0; i < 8; i++ )
+			b[i] = (char)( ( v >> ( 8 * i ) ) & 0xff );
+		out.write( b, 8 );
+	}
+
+	inline void putFloat( std::ostream &out, float v )
+	{
+		unsigned int bits;
+		memcpy( &bits, &v, 4 );
+		putU32( out, bits );
+	}
+
+	inline void putDouble( std::ostream &out, double v )
+	{
+		unsigned long long bits;
+		memcpy( &bits, &v, 8 );
+		putU64( out, bits );
+	}
+
+	//=========================================================
+	//! Reads little-endian values from a byte range.  Reading past the 
+	//! end sets the failed flag and returns zeros, so callers can check 
+	//! once after a group of reads.
+	//!
+	class Cursor
+	{
+	public:
+		Cursor( const unsigned char *begin, const unsigned char *end ) : 
+			p( begin ), end( end ), failed( false ) {}
+
+		bool atEnd() const { return p >= end; }
+		bool hasFailed() const { return failed; }
+		const unsigned char *position() const { return p; }
+
+		const unsigned char *skip( unsigned int n )
+		{
+			if( failed || (unsigned int)( end - p ) < n )
+			{
+				failed = true;
+				return NULL;
+			}
+			const unsigned char *result = p;
+			p += n;
+			return result;
+		}
+
+		unsigned int getU8()
+		{
+			const unsigned char *b = skip( 1 );
+			return b ? b[0] : 0;
+		}
+
+		unsigned int getU16()
+		{
+			const unsigned char *b = skip( 2 );
+			return b ? ( b[0] | ( b[1] << 8 ) ) : 0;
+		}
+
+		unsigned int getU32()
+		{
+			const unsigned char *b = skip( 4 );
+			if( b == NULL )
+				return 0;
+			unsigned int v = 0;
+			for( int i = 3; i >= 0; i-- )
+				v = ( v << 8 ) | b[i];
+			return v;
+		}
+
+		unsigned long long getU64()
+		{
+			const unsigned char *b = skip( 8 );
+			if( b == NULL )
+				return 0;
+			unsigned long long v = 0;
+			for( int i = 7; i >= 0; i-- )
+				v = ( v << 8 ) | b[i];
+			return v;
+		}
+
+		float getFloat()
+		{
+			unsigned int bits = getU32();
+			float v;
+			memcpy( &v, &bits, 4 );
+			return v;
+		}
+
+		double getDouble()
+		{
+			unsigned long long bits = getU64();
+			double v;
+			memcpy( &v, &bits, 8 );
+			return v;
+		}
+
+		//=========================================================
+		//! Skips over an encoded value (type byte included), returning 
+		//! its start, or NULL if it is malformed
+		//!
+		const unsigned char *skipValue()
+		{
+			const unsigned char *start = p;
+			switch( getU8() )
+			{
+			case GroupValue: break;
+			case StringValue: skip( getU32() ); break;
+			case IntValue: skip( 4 ); break;
+			case FloatValue: skip( 4 ); break;
+			case DoubleValue: skip( 8 ); break;
+			case DoubleVectorValue: skip( getU8() * 8 ); break;
+			default: failed = true; break;
+			}
+			return failed ? NULL : start;
+		}
+
+	private:
+		const unsigned char *p;
+		const unsigned char *end;
+		bool failed;
+	};
+}
+}
+
+#endif
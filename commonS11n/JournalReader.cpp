@@ -0,0 +1,222 @@
+/** <pre>
+ *  MPV Serialization Framework
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#include <string.h>
+
+#include "JournalReader.h"
+#include "JournalFormat.h"
+
+using namespace mpvs11n;
+using namespace mpvs11n::journal;
+
+
+// ================================================
+// JournalReader
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+JournalReader::JournalReader() :
+	file( NULL ),
+	current( -1 )
+{
+	
+}
+
+
+// ================================================
+// ~JournalReader
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+JournalReader::~JournalReader()
+{
+	close();
+}
+
+
+// ================================================
+// open
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool JournalReader::open( const std::string &filename )
+{
+	close();
+	
+	file = fopen( filename.c_str(), "rb" );
+	if( file == NULL )
+		return false;
+	
+	unsigned char header[fileHeaderSize];
+	Cursor headerCursor( header, header + fileHeaderSize );
+	if( fread( header, 1, fileHeaderSize, file ) != (size_t)fileHeaderSize || 
+		memcmp( header, fileMagic, sizeof( fileMagic ) ) != 0 || 
+		( headerCursor.skip( sizeof( fileMagic ) ), headerCursor.getU32() ) != fileVersion )
+	{
+		close();
+		return false;
+	}
+	
+	long offset = fileHeaderSize;
+	while( true )
+	{
+		unsigned char blockHeader[blockHeaderSize];
+		if( fread( blockHeader, 1, blockHeaderSize, file ) != (size_t)blockHeaderSize )
+			break;
+		
+		Cursor cursor( blockHeader, blockHeader + blockHeaderSize );
+		IndexEntry entry;
+		unsigned int type = cursor.getU8();
+		entry.frame = cursor.getU32();
+		entry.time = cursor.getDouble();
+		entry.length = cursor.getU32();
+		entry.offset = offset + blockHeaderSize;
+		entry.keyframe = ( type == KeyframeBlock );
+		if( type != KeyframeBlock && type != DeltaBlock )
+			break;
+		
+		// a truncated final block is left out of the index
+		if( fseek( file, entry.length, SEEK_CUR ) != 0 )
+			break;
+		offset = entry.offset + entry.length;
+		if( ftell( file ) != offset )
+			break;
+		
+		index.push_back( entry );
+	}
+	
+	// fseek happily moves past the end of the file, so check the last 
+	// block's payload is really there
+	if( !index.empty() )
+	{
+		fseek( file, 0, SEEK_END );
+		if( ftell( file ) < offset )
+			index.pop_back();
+	}
+	
+	return true;
+}
+
+
+// ================================================
+// close
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalReader::close()
+{
+	if( file != NULL )
+	{
+		fclose( file );
+		file = NULL;
+	}
+	index.clear();
+	state.clear();
+	current = -1;
+}
+
+
+// ================================================
+// seek
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool JournalReader::seek( unsigned int frame )
+{
+	if( file == NULL || index.empty() || index[0].frame > frame )
+		return false;
+	
+	// binary search for the last block at or before the frame
+	int low = 0, high = index.size() - 1;
+	while( low < high )
+	{
+		int mid = ( low + high + 1 ) / 2;
+		if( index[mid].frame <= (unsigned int)frame )
+			low = mid;
+		else
+			high = mid - 1;
+	}
+	int target = low;
+	
+	int keyframe = target;
+	while( keyframe > 0 && !index[keyframe].keyframe )
+		keyframe--;
+	
+	int first;
+	if( current >= keyframe && current <= target )
+		first = current + 1;
+	else
+	{
+		state.clear();
+		current = -1;
+		first = keyframe;
+	}
+	
+	for( int n = first; n <= target; n++ )
+	{
+		if( !applyBlock( n ) )
+		{
+			state.clear();
+			current = -1;
+			return false;
+		}
+		current = n;
+	}
+	
+	return true;
+}
+
+
+// ================================================
+// applyBlock
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool JournalReader::applyBlock( int n )
+{
+	const IndexEntry &entry = index[n];
+	
+	// a keyframe stands alone
+	if( entry.keyframe )
+		state.clear();
+	
+	if( entry.length == 0 )
+		return true;
+	
+	buffer.resize( entry.length );
+	if( fseek( file, entry.offset, SEEK_SET ) != 0 || 
+		fread( &buffer[0], 1, entry.length, file ) != entry.length )
+		return false;
+	
+	return state.apply( &buffer[0], entry.length );
+}
+
+
+// ================================================
+// getCurrentFrame
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+unsigned int JournalReader::getCurrentFrame() const
+{
+	return ( current >= 0 ) ? index[current].frame : 0;
+}
+
+
+// ================================================
+// getCurrentTime
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+double JournalReader::getCurrentTime() const
+{
+	return ( current >= 0 ) ? index[current].time : 0.0;
+}
@@ -0,0 +1,128 @@
+/** <pre>
+ *  MPV Serialization Framework
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#ifndef _JOURNALREADER_H_
+#define _JOURNALREADER_H_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "RefPtr.h"
+#include "Node.h"
+#include "JournalState.h"
+
+namespace mpvs11n
+{
+
+//=========================================================
+//! Reads a journal written by JournalWriter, and reconstructs the node 
+//! graph as it was at any recorded frame.  Opening a journal only reads 
+//! the block headers; seeking reads the nearest keyframe at or before 
+//! the requested frame and the deltas after it.  Seeking forward from 
+//! the current frame reuses the current state when no keyframe is 
+//! closer.
+//! 
+class JournalReader
+{
+public:
+
+	JournalReader();
+	~JournalReader();
+
+	//=========================================================
+	//! Opens a journal and indexes its blocks.  A journal that was cut 
+	//! short (by a crash, say) is readable up to its last complete block.
+	//! \return false if the file could not be opened, or isn't a journal 
+	//!         of a version this reader understands
+	//! 
+	bool open( const std::string &filename );
+
+	void close();
+
+	bool isOpen() const { return file != NULL; }
+
+	//! Returns the number of frames in the journal
+	int getFrameCount() const { return index.size(); }
+
+	//! Returns the frame number of the n'th recorded frame
+	unsigned int getFrameNumber( int n ) const { return index[n].frame; }
+
+	//! Returns the simulation time recorded with the n'th recorded frame
+	double getFrameTime( int n ) const { return index[n].time; }
+
+	//=========================================================
+	//! Moves to the last recorded frame at or before the given frame
+	//! \return false if the journal starts after that frame, or a block 
+	//!         could not be read
+	//! 
+	bool seek( unsigned int frame );
+
+	//! Returns the frame that the state corresponds to
+	unsigned int getCurrentFrame() const;
+
+	//! Returns the simulation time recorded with the current frame
+	double getCurrentTime() const;
+
+	const JournalState &getState() const { return state; }
+
+	//=========================================================
+	//! Creates a node graph matching the current frame's state, which 
+	//! can be handed to any NodeVisitor
+	//! 
+	mpv::RefPtr<Node> buildTree() const { return state.buildTree(); }
+
+private:
+
+	struct IndexEntry
+	{
+		unsigned int frame;
+		double time;
+		long offset;
+		unsigned int length;
+		bool keyframe;
+	};
+
+	//! Reads a block's payload and applies it to the state
+	bool applyBlock( int n );
+
+	FILE *file;
+
+	std::vector<IndexEntry> index;
+
+	//! the index entry that state corresponds to, or -1
+	int current;
+
+	JournalState state;
+
+	//! scratch space for block payloads
+	std::vector<unsigned char> buffer;
+};
+
+}
+
+#endif
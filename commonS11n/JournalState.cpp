@@ -0,0 +1,279 @@
+/** <pre>
+ *  MPV Serialization Framework
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#include <algorithm>
+
+#include "JournalState.h"
+#include "JournalFormat.h"
+#include "StringNode.h"
+#include "IntNode.h"
+#include "FloatNode.h"
+#include "DoubleNode.h"
+#include "DoubleVectorNode.h"
+
+using namespace mpvs11n;
+using namespace mpvs11n::journal;
+
+
+// ================================================
+// JournalState
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+JournalState::JournalState()
+{
+	
+}
+
+
+// ================================================
+// ~JournalState
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+JournalState::~JournalState()
+{
+	
+}
+
+
+// ================================================
+// clear
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalState::clear()
+{
+	entries.clear();
+	roots.clear();
+}
+
+
+// ================================================
+// apply
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool JournalState::apply( const unsigned char *ops, int length )
+{
+	Cursor cursor( ops, ops + length );
+	
+	while( !cursor.atEnd() )
+	{
+		unsigned int op = cursor.getU8();
+		unsigned int id = cursor.getU32();
+		
+		if( op == DefineOp )
+		{
+			unsigned int parent = cursor.getU32();
+			unsigned int nameLength = cursor.getU16();
+			const unsigned char *name = cursor.skip( nameLength );
+			const unsigned char *value = cursor.skipValue();
+			if( cursor.hasFailed() )
+				return false;
+			
+			// a redefinition replaces the old node outright
+			if( entries.find( id ) != entries.end() )
+				remove( id );
+			
+			Entry &entry = entries[id];
+			entry.parent = parent;
+			entry.name.assign( (const char *)name, nameLength );
+			entry.value.assign( (const char *)value, cursor.position() - value );
+			
+			if( parent == 0 )
+				roots.push_back( id );
+			else
+			{
+				EntryMap::iterator parentIter = entries.find( parent );
+				if( parentIter != entries.end() )
+					parentIter->second.children.push_back( id );
+			}
+		}
+		else if( op == ValueOp )
+		{
+			const unsigned char *value = cursor.skipValue();
+			if( cursor.hasFailed() )
+				return false;
+			
+			EntryMap::iterator iter = entries.find( id );
+			if( iter != entries.end() )
+				iter->second.value.assign( (const char *)value, cursor.position() - value );
+		}
+		else if( op == RemoveOp )
+		{
+			if( cursor.hasFailed() )
+				return false;
+			remove( id );
+		}
+		else
+			return false;
+	}
+	
+	return true;
+}
+
+
+// ================================================
+// remove
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalState::remove( unsigned int id )
+{
+	EntryMap::iterator iter = entries.find( id );
+	if( iter == entries.end() )
+		return;
+	
+	// detach from the parent first; the recursion below only needs to 
+	// erase the descendants
+	std::vector<unsigned int> *siblings = &roots;
+	if( iter->second.parent != 0 )
+	{
+		EntryMap::iterator parentIter = entries.find( iter->second.parent );
+		siblings = ( parentIter != entries.end() ) ? &parentIter->second.children : NULL;
+	}
+	if( siblings != NULL )
+	{
+		std::vector<unsigned int>::iterator pos = 
+			std::find( siblings->begin(), siblings->end(), id );
+		if( pos != siblings->end() )
+			siblings->erase( pos );
+	}
+	
+	std::vector<unsigned int> pending;
+	pending.push_back( id );
+	while( !pending.empty() )
+	{
+		unsigned int current = pending.back();
+		pending.pop_back();
+		EntryMap::iterator currentIter = entries.find( current );
+		if( currentIter == entries.end() )
+			continue;
+		pending.insert( pending.end(), 
+			currentIter->second.children.begin(), currentIter->second.children.end() );
+		entries.erase( currentIter );
+	}
+}
+
+
+// ================================================
+// encode
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalState::encode( std::ostream &out ) const
+{
+	for( unsigned int i = 0; i < roots.size(); i++ )
+		encodeEntry( out, roots[i] );
+}
+
+
+// ================================================
+// encodeEntry
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalState::encodeEntry( std::ostream &out, unsigned int id ) const
+{
+	EntryMap::const_iterator iter = entries.find( id );
+	if( iter == entries.end() )
+		return;
+	const Entry &entry = iter->second;
+	
+	putU8( out, DefineOp );
+	putU32( out, id );
+	putU32( out, entry.parent );
+	putU16( out, entry.name.size() );
+	out.write( entry.name.data(), entry.name.size() );
+	out.write( entry.value.data(), entry.value.size() );
+	
+	// parents are defined before their children
+	for( unsigned int i = 0; i < entry.children.size(); i++ )
+		encodeEntry( out, entry.children[i] );
+}
+
+
+// ================================================
+// buildTree
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+mpv::RefPtr<Node> JournalState::buildTree() const
+{
+	if( roots.empty() )
+		return mpv::RefPtr<Node>();
+	return buildNode( roots[0] );
+}
+
+
+// ================================================
+// buildNode
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+Node *JournalState::buildNode( unsigned int id ) const
+{
+	EntryMap::const_iterator iter = entries.find( id );
+	if( iter == entries.end() )
+		return NULL;
+	const Entry &entry = iter->second;
+	
+	const unsigned char *value = (const unsigned char *)entry.value.data();
+	Cursor cursor( value, value + entry.value.size() );
+	
+	switch( cursor.getU8() )
+	{
+	case GroupValue:
+		{
+			GroupNode *group = new GroupNode( entry.name );
+			for( unsigned int i = 0; i < entry.children.size(); i++ )
+				group->addChild( buildNode( entry.children[i] ) );
+			return group;
+		}
+	case StringValue:
+		{
+			StringNode *node = new StringNode( entry.name );
+			unsigned int length = cursor.getU32();
+			const unsigned char *text = cursor.skip( length );
+			if( text != NULL )
+				node->set( std::string( (const char *)text, length ) );
+			return node;
+		}
+	case IntValue:
+		{
+			IntNode *node = new IntNode( entry.name );
+			node->set( (int)cursor.getU32() );
+			return node;
+		}
+	case FloatValue:
+		{
+			FloatNode *node = new FloatNode( entry.name );
+			node->set( cursor.getFloat() );
+			return node;
+		}
+	case DoubleValue:
+		{
+			DoubleNode *node = new DoubleNode( entry.name );
+			node->set( cursor.getDouble() );
+			return node;
+		}
+	case DoubleVectorValue:
+		{
+			DoubleVectorNode *node = new DoubleVectorNode( entry.name );
+			std::vector<double> v( cursor.getU8() );
+			for( unsigned int i = 0; i < v.size(); i++ )
+				v[i] = cursor.getDouble();
+			node->set( v );
+			return node;
+		}
+	default:
+		return NULL;
+	}
+}
@@ -0,0 +1,108 @@
+/** <pre>
+ *  MPV Serialization Framework
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#ifndef _JOURNALSTATE_H_
+#define _JOURNALSTATE_H_
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "RefPtr.h"
+#include "GroupNode.h"
+
+namespace mpvs11n
+{
+
+//=========================================================
+//! A node graph in its journal form: a table of nodes keyed by the IDs 
+//! that JournalWriter assigns, each holding its encoded value.  Journal 
+//! blocks are applied to it to move it forward in time.  The writer 
+//! keeps one of these (on its background thread) to produce keyframes, 
+//! and JournalReader uses one to reconstruct the graph at a given frame.
+//! 
+class JournalState
+{
+public:
+
+	struct Entry
+	{
+		//! 0 for a root node
+		unsigned int parent;
+		std::string name;
+		//! the encoded value, starting with its value type
+		std::string value;
+		std::vector<unsigned int> children;
+	};
+
+	typedef std::map< unsigned int, Entry > EntryMap;
+
+	JournalState();
+	~JournalState();
+
+	void clear();
+
+	//=========================================================
+	//! Applies a block's operations
+	//! \return false if the operations are malformed; the state is then 
+	//!         only partly updated
+	//! 
+	bool apply( const unsigned char *ops, int length );
+
+	//=========================================================
+	//! Writes operations that define every node, ie a keyframe payload
+	//! 
+	void encode( std::ostream &out ) const;
+
+	//=========================================================
+	//! Creates a node graph matching this state
+	//! \return the first root node, or NULL if the state is empty
+	//! 
+	mpv::RefPtr<Node> buildTree() const;
+
+	const EntryMap &getEntries() const { return entries; }
+
+	const std::vector<unsigned int> &getRoots() const { return roots; }
+
+private:
+
+	//! Removes a node and everything beneath it
+	void remove( unsigned int id );
+
+	void encodeEntry( std::ostream &out, unsigned int id ) const;
+
+	Node *buildNode( unsigned int id ) const;
+
+	EntryMap entries;
+
+	std::vector<unsigned int> roots;
+};
+
+}
+
+#endif
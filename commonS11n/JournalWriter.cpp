@@ -0,0 +1,395 @@
+/** <pre>
+ *  MPV Serialization Framework
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#include <OpenThreads/ScopedLock>
+
+#include "JournalWriter.h"
+#include "JournalFormat.h"
+#include "StringNode.h"
+#include "IntNode.h"
+#include "FloatNode.h"
+#include "DoubleNode.h"
+#include "DoubleVectorNode.h"
+
+using namespace mpvs11n;
+using namespace mpvs11n::journal;
+
+namespace
+{
+	//=========================================================
+	//! Writes a node's value in journal form
+	//! 
+	class ValueEncoder : public NodeVisitor
+	{
+	public:
+		ValueEncoder( std::ostream &os ) : NodeVisitor( os ) {}
+		
+		virtual void visit( GroupNode &n ) const
+		{
+			putU8( output, GroupValue );
+		}
+		
+		virtual void visit( StringNode &n ) const
+		{
+			const std::string &v = n.get();
+			putU8( output, StringValue );
+			putU32( output, v.size() );
+			output.write( v.data(), v.size() );
+		}
+		
+		virtual void visit( IntNode &n ) const
+		{
+			putU8( output, IntValue );
+			putU32( output, (unsigned int)n.get() );
+		}
+		
+		virtual void visit( FloatNode &n ) const
+		{
+			putU8( output, FloatValue );
+			putFloat( output, n.get() );
+		}
+		
+		virtual void visit( DoubleNode &n ) const
+		{
+			putU8( output, DoubleValue );
+			putDouble( output, n.get() );
+		}
+		
+		virtual void visit( DoubleVectorNode &n ) const
+		{
+			std::vector<double> v = n.get();
+			if( v.size() > 255 )
+				v.resize( 255 );
+			putU8( output, DoubleVectorValue );
+			putU8( output, v.size() );
+			for( unsigned int i = 0; i < v.size(); i++ )
+				putDouble( output, v[i] );
+		}
+	};
+}
+
+
+// ================================================
+// JournalWriter
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+JournalWriter::JournalWriter() : NodeObserver(), OpenThreads::Thread(), 
+	nextID( 1 ),
+	writerShouldExit( false ),
+	file( NULL ),
+	keyframeInterval( 600 ),
+	blocksWritten( 0 )
+{
+	
+}
+
+
+// ================================================
+// ~JournalWriter
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+JournalWriter::~JournalWriter()
+{
+	close();
+}
+
+
+// ================================================
+// open
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool JournalWriter::open( const std::string &filename, int newKeyframeInterval )
+{
+	close();
+	
+	file = fopen( filename.c_str(), "wb" );
+	if( file == NULL )
+		return false;
+	
+	std::ostringstream header;
+	header.write( fileMagic, sizeof( fileMagic ) );
+	putU32( header, fileVersion );
+	putU32( header, 0 );
+	fwrite( header.str().data(), 1, fileHeaderSize, file );
+	
+	keyframeInterval = ( newKeyframeInterval > 0 ) ? newKeyframeInterval : 1;
+	blocksWritten = 0;
+	shadow.clear();
+	writerShouldExit = false;
+	start();
+	return true;
+}
+
+
+// ================================================
+// attach
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalWriter::attach( GroupNode *newRoot )
+{
+	if( root.valid() )
+	{
+		TrackedMap::iterator iter = tracked.find( root.get() );
+		if( iter != tracked.end() )
+		{
+			putU8( ops, RemoveOp );
+			putU32( ops, iter->second.id );
+		}
+		root->setObserver( NULL );
+		forget( root.get() );
+	}
+	
+	root = newRoot;
+	if( newRoot != NULL )
+	{
+		define( newRoot, 0 );
+		newRoot->setObserver( this );
+	}
+}
+
+
+// ================================================
+// endFrame
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalWriter::endFrame( unsigned int frame, double time )
+{
+	if( file == NULL )
+		return;
+	
+	ValueEncoder encoder( ops );
+	for( unsigned int i = 0; i < dirtyNodes.size(); i++ )
+	{
+		// the node may have been removed (and even destroyed) since it 
+		// changed; in that case it is no longer tracked, and must not be 
+		// touched
+		TrackedMap::iterator iter = tracked.find( dirtyNodes[i] );
+		if( iter == tracked.end() || !iter->second.dirty )
+			continue;
+		iter->second.dirty = false;
+		
+		putU8( ops, ValueOp );
+		putU32( ops, iter->second.id );
+		dirtyNodes[i]->accept( encoder );
+	}
+	dirtyNodes.clear();
+	
+	Block block;
+	block.frame = frame;
+	block.time = time;
+	block.ops = ops.str();
+	ops.str( std::string() );
+	
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	queue.push_back( block );
+	queueCondition.signal();
+}
+
+
+// ================================================
+// close
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalWriter::close()
+{
+	if( root.valid() )
+	{
+		root->setObserver( NULL );
+		root = NULL;
+	}
+	tracked.clear();
+	dirtyNodes.clear();
+	ops.str( std::string() );
+	nextID = 1;
+	
+	if( file == NULL )
+		return;
+	
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+		writerShouldExit = true;
+		queueCondition.signal();
+	}
+	join();
+	
+	fclose( file );
+	file = NULL;
+	shadow.clear();
+}
+
+
+// ================================================
+// nodeChanged
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalWriter::nodeChanged( Node *node )
+{
+	TrackedMap::iterator iter = tracked.find( node );
+	if( iter == tracked.end() || iter->second.dirty )
+		return;
+	iter->second.dirty = true;
+	dirtyNodes.push_back( node );
+}
+
+
+// ================================================
+// childAdded
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalWriter::childAdded( GroupNode *parent, Node *child )
+{
+	TrackedMap::iterator iter = tracked.find( parent );
+	if( iter == tracked.end() )
+		return;
+	define( child, iter->second.id );
+}
+
+
+// ================================================
+// childRemoved
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalWriter::childRemoved( GroupNode *parent, Node *child )
+{
+	TrackedMap::iterator iter = tracked.find( child );
+	if( iter == tracked.end() )
+		return;
+	putU8( ops, RemoveOp );
+	putU32( ops, iter->second.id );
+	forget( child );
+}
+
+
+// ================================================
+// define
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalWriter::define( Node *node, unsigned int parentID )
+{
+	// a node that is somehow already tracked gets a fresh ID; the reader 
+	// treats the new definition as a separate node
+	forget( node );
+	
+	Tracked &entry = tracked[node];
+	entry.id = nextID++;
+	entry.dirty = false;
+	
+	const std::string &name = node->getName();
+	unsigned int nameLength = ( name.size() < 0xffff ) ? name.size() : 0xffff;
+	putU8( ops, DefineOp );
+	putU32( ops, entry.id );
+	putU32( ops, parentID );
+	putU16( ops, nameLength );
+	ops.write( name.data(), nameLength );
+	node->accept( ValueEncoder( ops ) );
+	
+	GroupNode *group = dynamic_cast<GroupNode *>( node );
+	if( group != NULL )
+	{
+		unsigned int id = entry.id;
+		GroupNode::NodeIteratorPair children = group->getChildren();
+		for( GroupNode::NodeList::iterator iter = children.first; 
+			iter != children.second; iter++ )
+		{
+			define( iter->get(), id );
+		}
+	}
+}
+
+
+// ================================================
+// forget
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalWriter::forget( Node *node )
+{
+	if( tracked.erase( node ) == 0 )
+		return;
+	
+	GroupNode *group = dynamic_cast<GroupNode *>( node );
+	if( group != NULL )
+	{
+		GroupNode::NodeIteratorPair children = group->getChildren();
+		for( GroupNode::NodeList::iterator iter = children.first; 
+			iter != children.second; iter++ )
+		{
+			forget( iter->get() );
+		}
+	}
+}
+
+
+// ================================================
+// run
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalWriter::run()
+{
+	std::deque<Block> pending;
+	
+	while( true )
+	{
+		{
+			OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+			
+			if( queue.empty() && !writerShouldExit )
+				queueCondition.wait( &mutex );
+			
+			pending.swap( queue );
+			
+			if( pending.empty() && writerShouldExit )
+				break;
+		}
+		
+		// encoding keyframes and I/O happen outside the lock, so that the 
+		// frame loop never waits on them
+		while( !pending.empty() )
+		{
+			const Block &block = pending.front();
+			shadow.apply( (const unsigned char *)block.ops.data(), block.ops.size() );
+			
+			if( blocksWritten % keyframeInterval == 0 )
+			{
+				keyframeOps.str( std::string() );
+				shadow.encode( keyframeOps );
+				writeBlock( KeyframeBlock, block, keyframeOps.str() );
+			}
+			else
+				writeBlock( DeltaBlock, block, block.ops );
+			
+			blocksWritten++;
+			pending.pop_front();
+		}
+	}
+	
+	fflush( file );
+}
+
+
+// ================================================
+// writeBlock
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void JournalWriter::writeBlock( int type, const Block &block, const std::string &blockOps )
+{
+	std::ostringstream header;
+	putU8( header, type );
+	putU32( header, block.frame );
+	putDouble( header, block.time );
+	putU32( header, blockOps.size() );
+	
+	fwrite( header.str().data(), 1, blockHeaderSize, file );
+	if( !blockOps.empty() )
+		fwrite( blockOps.data(), 1, blockOps.size(), file );
+}
@@ -0,0 +1,168 @@
+/** <pre>
+ *  MPV Serialization Framework
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#ifndef _JOURNALWRITER_H_
+#define _JOURNALWRITER_H_
+
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Thread>
+
+#include "RefPtr.h"
+#include "GroupNode.h"
+#include "NodeObserver.h"
+#include "JournalState.h"
+
+namespace mpvs11n
+{
+
+//=========================================================
+//! Records the changes to a node graph, frame by frame, so that the 
+//! graph can later be reconstructed as it was at any frame (see 
+//! JournalReader).  
+//! 
+//! The writer observes the graph.  During a frame it only notes which 
+//! nodes changed; at endFrame() it encodes the current values of those 
+//! nodes (so a value that changes many times in a frame costs one 
+//! entry), along with any nodes added or removed, and hands the block 
+//! to a background thread.  That thread keeps its own copy of the graph 
+//! in journal form, from which it writes a full keyframe every so often, 
+//! and does all of the file I/O.  The frame loop never waits on the disk 
+//! and never walks the whole graph.
+//! 
+class JournalWriter : public NodeObserver, protected OpenThreads::Thread
+{
+public:
+
+	JournalWriter();
+	virtual ~JournalWriter();
+
+	//=========================================================
+	//! Creates (or truncates) the journal file and starts the background 
+	//! thread
+	//! \param filename - the journal file
+	//! \param keyframeInterval - a keyframe is written every this many 
+	//!        frames; smaller values make seeking faster and the file 
+	//!        larger
+	//! \return false if the file could not be opened
+	//! 
+	bool open( const std::string &filename, int keyframeInterval );
+
+	//=========================================================
+	//! Starts recording the graph beneath root.  The first block written 
+	//! will define the whole graph.
+	//! 
+	void attach( GroupNode *root );
+
+	//=========================================================
+	//! Ends a frame, queueing everything that changed during it
+	//! \param frame - the frame number to record
+	//! \param time - the simulation time to record, in seconds
+	//! 
+	void endFrame( unsigned int frame, double time );
+
+	//=========================================================
+	//! Detaches from the graph, writes out everything queued and closes 
+	//! the file
+	//! 
+	void close();
+
+	bool isOpen() const { return file != NULL; }
+
+	virtual void nodeChanged( Node *node );
+	virtual void childAdded( GroupNode *parent, Node *child );
+	virtual void childRemoved( GroupNode *parent, Node *child );
+
+protected:
+
+	//! The background thread; writes queued blocks to disk
+	virtual void run();
+
+private:
+
+	struct Tracked
+	{
+		unsigned int id;
+		bool dirty;
+	};
+
+	typedef std::map< Node *, Tracked > TrackedMap;
+
+	struct Block
+	{
+		unsigned int frame;
+		double time;
+		std::string ops;
+	};
+
+	//! Assigns IDs to a node and everything beneath it, and writes 
+	//! define operations for them
+	void define( Node *node, unsigned int parentID );
+
+	//! Stops tracking a node and everything beneath it
+	void forget( Node *node );
+
+	//! Writes a block to the file; background thread only
+	void writeBlock( int type, const Block &block, const std::string &ops );
+
+	mpv::RefPtr<GroupNode> root;
+
+	//! the nodes being observed, and their IDs
+	TrackedMap tracked;
+
+	//! nodes whose values changed this frame, in the order they changed
+	std::vector<Node *> dirtyNodes;
+
+	unsigned int nextID;
+
+	//! this frame's operations so far
+	std::ostringstream ops;
+
+	OpenThreads::Mutex mutex;
+	OpenThreads::Condition queueCondition;
+	std::deque<Block> queue;
+	bool writerShouldExit;
+
+	// only touched by the background thread while it is running
+
+	FILE *file;
+	int keyframeInterval;
+	unsigned int blocksWritten;
+	JournalState shadow;
+	std::ostringstream keyframeOps;
+};
+
+}
+
+#endif
@@ -34,7 +34,8 @@ using namespace mpvs11n;
 // Node
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 Node::Node( const std::string &n ) : mpv::Referenced(), 
-	name( n )
+	name( n ),
+	observer( NULL )
 {
 	
 }
@@ -33,6 +33,7 @@
 #include "Referenced.h"
 
 #include "NodeVisitor.h"
+#include "NodeObserver.h"
 
 namespace mpvs11n
 {
@@ -56,6 +57,12 @@ public:
 	//! visitor.visit( something )
 	virtual void accept( const NodeVisitor &visitor ) = 0;
 	
+	//! Sets the observer to be notified of changes to this node.  Group 
+	//! nodes pass the observer on to their children.  May be NULL.
+	virtual void setObserver( NodeObserver *newObserver ) { observer = newObserver; }
+	
+	NodeObserver *getObserver() const { return observer; }
+	
 protected:
 
 	//=========================================================
@@ -70,6 +77,16 @@ protected:
 	//! Must not contain whitespace, quotes, punctuation.  Must start with a 
 	//! letter.  Should be lower-case.
 	std::string name;
+	
+	//! Notified of changes to this node; usually NULL
+	NodeObserver *observer;
+	
+	//! Called by child classes after their value changes
+	void notifyChanged()
+	{
+		if( observer != NULL )
+			observer->nodeChanged( this );
+	}
 };
 
 }
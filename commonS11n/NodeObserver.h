@@ -0,0 +1,70 @@
+/** <pre>
+ *  MPV Serialization Framework
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#ifndef _NODEOBSERVER_H_
+#define _NODEOBSERVER_H_
+
+namespace mpvs11n
+{
+// forward declarations
+class Node;
+class GroupNode;
+
+
+//=========================================================
+//! Receives notification of changes to a node graph.  An observer set 
+//! on a group node (see Node::setObserver()) is passed down to every 
+//! node beneath it, including nodes added later, so attaching an 
+//! observer to the root node is enough to hear about every change.
+//! 
+class NodeObserver
+{
+public:
+	virtual ~NodeObserver() {}
+
+	//=========================================================
+	//! Called after a value node's value changes.  Not called when a 
+	//! value is set to what it already was.
+	//! 
+	virtual void nodeChanged( Node *node ) = 0;
+
+	//=========================================================
+	//! Called after a node (and the subtree beneath it) is added to a 
+	//! group
+	//! 
+	virtual void childAdded( GroupNode *parent, Node *child ) = 0;
+
+	//=========================================================
+	//! Called before a node (and the subtree beneath it) is removed from 
+	//! a group
+	//! 
+	virtual void childRemoved( GroupNode *parent, Node *child ) = 0;
+};
+
+}
+
+#endif
@@ -65,7 +65,10 @@ const std::string &StringNode::get() const
 
 void StringNode::set( const std::string &v )
 {
+	if( value == v )
+		return;
 	value = v;
+	notifyChanged();
 }
 
 
@@ -20,6 +20,7 @@
 #include "ModularProgram.h"
 #include "Operator.h"
 #include "Particle.h"
+#include "ParticleArrays.h"
 
 #include <osg/CopyOp>
 #include <osg/Object>
@@ -50,6 +51,11 @@ namespace osgParticleHPS
         
         /// Apply the acceleration to a particle. Do not call this method manually.
         inline void operate(Particle *P, double dt);
+
+        /// Apply the acceleration to all live particles. Do not call this method manually.
+        inline void operateBatch(ParticleArrays &arrays, double dt);
+        inline unsigned int getBatchInputs() const { return ParticleArrays::VELOCITY; }
+        inline unsigned int getBatchOutputs() const { return ParticleArrays::VELOCITY; }
         
         /// Perform some initializations. Do not call this method manually.
         inline void beginOperate(Program *prg);
@@ -94,6 +100,22 @@ namespace osgParticleHPS
     {
         P->addVelocity(xf_accel_ * dt);
     }
+
+    inline void AccelOperator::operateBatch(ParticleArrays &arrays, double dt)
+    {
+        const osg::Vec3 dv = xf_accel_ * dt;
+        const float dvx = dv.x();
+        const float dvy = dv.y();
+        const float dvz = dv.z();
+        float *vx = arrays.velocityX();
+        float *vy = arrays.velocityY();
+        float *vz = arrays.velocityZ();
+        const int n = arrays.size();
+
+        for (int i=0; i<n; ++i) vx[i] += dvx;
+        for (int i=0; i<n; ++i) vy[i] += dvy;
+        for (int i=0; i<n; ++i) vz[i] += dvz;
+    }
     
     inline void AccelOperator::beginOperate(Program *prg)
     {
@@ -2,6 +2,7 @@
 #include "ModularProgram.h"
 #include "Operator.h"
 #include "Particle.h"
+#include "ParticleArrays.h"
 #include <osg/Notify>
 
 osgParticleHPS::FluidFrictionOperator::FluidFrictionOperator():
@@ -50,3 +51,68 @@ void osgParticleHPS::FluidFrictionOperator::operate(Particle *P, double dt)
 
     P->addVelocity(dv);
 }
+
+unsigned int osgParticleHPS::FluidFrictionOperator::getBatchInputs() const
+{
+    unsigned int fields = ParticleArrays::VELOCITY | ParticleArrays::MASS_INV;
+    if (ovr_rad_ <= 0) fields |= ParticleArrays::RADIUS;
+    return fields;
+}
+
+unsigned int osgParticleHPS::FluidFrictionOperator::getBatchOutputs() const
+{
+    return ParticleArrays::VELOCITY;
+}
+
+void osgParticleHPS::FluidFrictionOperator::operateBatch(ParticleArrays &arrays, double dt)
+{
+    // rotateLocalToWorld is linear, so it can be applied as a 3x3 matrix 
+    // built from the rotated basis vectors
+    bool rotate = current_program_->getReferenceFrame() == ModularProgram::RELATIVE_TO_PARENTS;
+    osg::Vec3 ax(1, 0, 0), ay(0, 1, 0), az(0, 0, 1);
+    if (rotate) {
+        ax = current_program_->rotateLocalToWorld(ax);
+        ay = current_program_->rotateLocalToWorld(ay);
+        az = current_program_->rotateLocalToWorld(az);
+    }
+
+    const float fdt = dt;
+    const float *mi = arrays.massInv();
+    const float *rad = (ovr_rad_ > 0)? 0 : arrays.radius();
+    float *vx = arrays.velocityX();
+    float *vy = arrays.velocityY();
+    float *vz = arrays.velocityZ();
+    const int n = arrays.size();
+
+    for (int i=0; i<n; ++i) {
+        float r = rad? rad[i] : ovr_rad_;
+        float vm = sqrtf(vx[i]*vx[i] + vy[i]*vy[i] + vz[i]*vz[i]);
+        float vinv = (vm > 0)? 1.0f / vm : 0.0f;
+        float R = A_ * r * vm + B_ * r * r * vm * vm;
+
+        float fx = -R * vx[i] * vinv;
+        float fy = -R * vy[i] * vinv;
+        float fz = -R * vz[i] * vinv;
+        if (rotate) {
+            float tx = ax.x() * fx + ay.x() * fy + az.x() * fz;
+            float ty = ax.y() * fx + ay.y() * fy + az.y() * fz;
+            float tz = ax.z() * fx + ay.z() * fy + az.z() * fz;
+            fx = tx; fy = ty; fz = tz;
+        }
+
+        // correct unwanted velocity increments
+        float k = mi[i] * fdt;
+        float dvx = fx * k;
+        float dvy = fy * k;
+        float dvz = fz * k;
+        float dvl = sqrtf(dvx*dvx + dvy*dvy + dvz*dvz);
+        if (dvl > vm) {
+            float c = vm / dvl;
+            dvx *= c; dvy *= c; dvz *= c;
+        }
+
+        vx[i] += dvx;
+        vy[i] += dvy;
+        vz[i] += dvz;
+    }
+}
@@ -67,6 +67,11 @@ namespace osgParticleHPS
         
         /// Apply the friction forces to a particle. Do not call this method manually.
         void operate(Particle *P, double dt);
+
+        /// Apply the friction forces to all live particles. Do not call this method manually.
+        void operateBatch(ParticleArrays &arrays, double dt);
+        unsigned int getBatchInputs() const;
+        unsigned int getBatchOutputs() const;
         
         /// Perform some initializations. Do not call this method manually.
         inline void beginOperate(Program *prg);
@@ -20,6 +20,7 @@
 #include "ModularProgram.h"
 #include "Operator.h"
 #include "Particle.h"
+#include "ParticleArrays.h"
 
 #include <osg/CopyOp>
 #include <osg/Object>
@@ -47,6 +48,11 @@ namespace osgParticleHPS
         
         /// Apply the force to a particle. Do not call this method manually.
         inline void operate(Particle *P, double dt);
+
+        /// Apply the force to all live particles. Do not call this method manually.
+        inline void operateBatch(ParticleArrays &arrays, double dt);
+        inline unsigned int getBatchInputs() const { return ParticleArrays::VELOCITY | ParticleArrays::MASS_INV; }
+        inline unsigned int getBatchOutputs() const { return ParticleArrays::VELOCITY; }
         
         /// Perform some initialization. Do not call this method manually.
         inline void beginOperate(Program *prg);
@@ -86,6 +92,24 @@ namespace osgParticleHPS
     {
         P->addVelocity(xf_force_ * (P->getMassInv() * dt));
     }
+
+    inline void ForceOperator::operateBatch(ParticleArrays &arrays, double dt)
+    {
+        const float fx = xf_force_.x() * dt;
+        const float fy = xf_force_.y() * dt;
+        const float fz = xf_force_.z() * dt;
+        const float *mi = arrays.massInv();
+        float *vx = arrays.velocityX();
+        float *vy = arrays.velocityY();
+        float *vz = arrays.velocityZ();
+        const int n = arrays.size();
+
+        for (int i=0; i<n; ++i) {
+            vx[i] += fx * mi[i];
+            vy[i] += fy * mi[i];
+            vz[i] += fz * mi[i];
+        }
+    }
     
     inline void ForceOperator::beginOperate(Program *prg)
     {
@@ -278,6 +278,11 @@ void HPSFactory::createParticleSys(
 	if( attr ) {
 		lighting = attr->asInt();
 	}
+
+	attr = partSysDefinition->getAttribute( "vertex_buffer_rendering" );
+	if( attr ) {
+		ps->setVertexBufferRendering( attr->asInt() );
+	}
 	
 	attr = partSysDefinition->getAttribute( "alignment" );
 	if( attr ) {
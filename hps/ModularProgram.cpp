@@ -23,15 +23,79 @@ void osgParticleHPS::ModularProgram::execute(double dt)
     Operator_vector::iterator ci_end = operators_.end();
 
     ParticleSystem *ps = getParticleSystem();
-    for (ci=operators_.begin(); ci!=ci_end; ++ci) {        
+
+    // Gathering the particles into arrays and scattering them back costs 
+    // about as much as two of the kernels, so only a run of at least 
+    // minBatchRun_ kernels, over at least minBatchParticles_ particles, 
+    // is batched.  The other operators run one particle at a time.
+    const int num = static_cast<int>(operators_.size());
+    batched_.assign(num, false);
+    if (ps->numParticles() >= minBatchParticles_) {
+        int first = 0;
+        while (first < num) {
+            // disabled operators do nothing, so they don't end a run
+            int last = first;
+            int kernels = 0;
+            while (last < num && (!operators_[last]->isEnabled() || 
+                    operators_[last]->hasBatchKernel())) {
+                if (operators_[last]->isEnabled()) ++kernels;
+                ++last;
+            }
+            if (kernels >= minBatchRun_) {
+                for (int k=first; k<last; ++k) {
+                    batched_[k] = operators_[k]->isEnabled();
+                }
+            }
+            first = last + 1;
+        }
+    }
+
+    // work out which fields the batch kernels need, so that they can all 
+    // share a single gather
+    unsigned int batchFields = 0;
+    for (int k=0; k<num; ++k) {
+        if (batched_[k]) {
+            batchFields |= operators_[k]->getBatchInputs() | operators_[k]->getBatchOutputs();
+        }
+    }
+
+    bool gathered = false;
+    unsigned int dirtyFields = 0;
+
+    int k = 0;
+    for (ci=operators_.begin(); ci!=ci_end; ++ci, ++k) {        
         (*ci)->beginOperate(this);
-        int n = ps->numParticles();
-        for (int i=0; i<n; ++i) {
-            Particle *P = ps->getParticle(i);
-            if (P->isAlive() && (*ci)->isEnabled()) {
-                (*ci)->operate(P, dt);
+        if ((*ci)->isEnabled()) {
+            if (batched_[k]) {
+                if (!gathered) {
+                    arrays_.gather(ps, batchFields);
+                    gathered = true;
+                }
+                (*ci)->operateBatch(arrays_, dt);
+                dirtyFields |= (*ci)->getBatchOutputs();
+            } else {
+                // the per-particle operator must see the results of the 
+                // batch kernels that ran before it, and the batch kernels 
+                // after it must see its results
+                if (dirtyFields) {
+                    arrays_.scatter(dirtyFields);
+                    dirtyFields = 0;
+                }
+                gathered = false;
+
+                int n = ps->numParticles();
+                for (int i=0; i<n; ++i) {
+                    Particle *P = ps->getParticle(i);
+                    if (P->isAlive()) {
+                        (*ci)->operate(P, dt);
+                    }
+                }
             }
         }
         (*ci)->endOperate();
     }
+
+    if (dirtyFields) {
+        arrays_.scatter(dirtyFields);
+    }
 }
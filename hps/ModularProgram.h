@@ -18,6 +18,7 @@
 #include "Export.h"
 #include "Program.h"
 #include "Operator.h"
+#include "ParticleArrays.h"
 
 #include <osg/CopyOp>
 #include <osg/Object>
@@ -31,6 +32,9 @@ namespace osgParticleHPS
         To use a <CODE>ModularProgram</CODE> you have to create some <CODE>Operator</CODE> objects and 
         add them to the program.
         All operators will be applied to each particle in the same order they've been added to the program.
+        A run of several operators that provide batch kernels, in a large enough particle system, is
+        run over a structure-of-arrays copy of the live particles (see <CODE>ParticleArrays</CODE>);
+        the other operators are applied one particle at a time.
     */    
     class OSGPARTICLE_EXPORT ModularProgram: public Program {
     public:
@@ -64,6 +68,17 @@ namespace osgParticleHPS
         typedef std::vector<osg::ref_ptr<Operator> > Operator_vector;
 
         Operator_vector operators_;
+
+        /// SoA scratch storage for batch operators; reused from frame to frame
+        ParticleArrays arrays_;
+
+        /// whether each operator runs its batch kernel this frame
+        std::vector<bool> batched_;
+
+        /// the fewest consecutive kernels, and the fewest particles, for 
+        /// which the batch path is faster than the per-particle one
+        static const int minBatchRun_ = 3;
+        static const int minBatchParticles_ = 4096;
     };
     
     // INLINE FUNCTIONS
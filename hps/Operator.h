@@ -28,6 +28,7 @@ namespace osgParticleHPS
 
     // forward declaration to avoid including the whole header file
     class Particle;
+    class ParticleArrays;
 
     /** An abstract base class used by <CODE>ModularProgram</CODE> to perform operations on particles before they are updated. 
         To implement a new operator, derive from this class and override the <CODE>operate()</CODE> method.
@@ -56,6 +57,25 @@ namespace osgParticleHPS
             the time elapsed from last operation.            
         */
         virtual void operate(Particle *P, double dt) = 0;
+
+        /** Get the <CODE>ParticleArrays</CODE> fields read by <CODE>operateBatch()</CODE>.
+            Operators that return 0 here and from <CODE>getBatchOutputs()</CODE> have no batch
+            kernel; <CODE>ModularProgram</CODE> calls <CODE>operate()</CODE> on each particle instead.
+        */
+        virtual unsigned int getBatchInputs() const { return 0; }
+
+        /// Get the <CODE>ParticleArrays</CODE> fields modified by <CODE>operateBatch()</CODE>.
+        virtual unsigned int getBatchOutputs() const { return 0; }
+
+        /// Return true if this operator implements <CODE>operateBatch()</CODE>.
+        inline bool hasBatchKernel() const;
+
+        /**    Do something on all of the live particles at once.
+            The arrays hold (at least) the fields named by <CODE>getBatchInputs()</CODE> and
+            <CODE>getBatchOutputs()</CODE>. The result must be the same as calling
+            <CODE>operate()</CODE> on each particle in turn.
+        */
+        virtual void operateBatch(ParticleArrays & /*arrays*/, double /*dt*/) {}
         
         /** Do something before processing particles via the <CODE>operate()</CODE> method.
             Overriding this method could be necessary to query the calling <CODE>Program</CODE> object
@@ -97,6 +117,11 @@ namespace osgParticleHPS
         enabled_ = v;
     }
 
+    inline bool Operator::hasBatchKernel() const
+    {
+        return getBatchInputs() != 0 || getBatchOutputs() != 0;
+    }
+
 
 }
 
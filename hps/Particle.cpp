@@ -1,5 +1,6 @@
 #include "Particle.h"
 #include "LinearInterpolator.h"
+#include "ParticleVertexBuffer.h"
 
 #include <osg/Vec3>
 #include <osg/Vec4>
@@ -251,6 +252,121 @@ void osgParticleHPS::Particle::render(const osg::Vec3 &xpos, const osg::Vec3 &px
 }
 
 
+// ================================================
+// fillVertices
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool osgParticleHPS::Particle::fillVertices(ParticleVertexBuffer &buffer, const osg::Vec3 &xpos, const osg::Vec3 &px, const osg::Vec3 &py ) const
+{
+	const osg::Vec4 &c = current_color_;
+
+	switch (shape_)
+	{
+	case POINT:
+		buffer.addVertex(ParticleVertexBuffer::POINTS, xpos, s_coord_, t_coord_, c);
+		return true;
+
+	case LINE:
+		{
+			float vl = velocity_.length();
+			if (vl != 0) {
+				osg::Vec3 v = velocity_ * current_size_.x() / vl;
+				buffer.addVertex(ParticleVertexBuffer::LINES, xpos, 0, 0, c);
+				buffer.addVertex(ParticleVertexBuffer::LINES, xpos + v, 1, 0, c);
+			}
+		}
+		return true;
+
+	case QUAD:
+	case QUAD_OFFSET:
+	case QUAD_TRIANGLESTRIP:
+	case HEXAGON:
+		break;
+
+	default:
+		return false;
+	}
+
+	// same transform as render(); the rotation is skipped for unrotated 
+	// particles, which are the common case
+	osg::Matrix m;
+	if (angle_[0] != 0 || angle_[1] != 0 || angle_[2] != 0)
+		m = 
+			osg::Matrix::scale( 
+				current_size_.x(), 
+				current_size_.y(), 
+				current_size_.z() ) * 
+			osg::Matrix::rotate( 
+				angle_[0], osg::Vec3(0, 1, 0), 
+				angle_[1], osg::Vec3(1, 0, 0), 
+				angle_[2], osg::Vec3(0, 0, 1) ) * 
+			osg::Matrix::translate( xpos );
+	else
+		m = 
+			osg::Matrix::scale( 
+				current_size_.x(), 
+				current_size_.y(), 
+				current_size_.z() ) * 
+			osg::Matrix::translate( xpos );
+
+	const ParticleVertexBuffer::Primitive tris = ParticleVertexBuffer::TRIANGLES;
+	const float s0 = s_coord_;
+	const float s1 = s_coord_ + s_tile_;
+	const float t0 = t_coord_;
+	const float t1 = t_coord_ + t_tile_;
+
+	if (shape_ == HEXAGON)
+	{
+		// the triangle fan of render(), as independent triangles
+		osg::Vec3 corner[7];
+		float cs[7], ct[7];
+		corner[0] = px*cosPI3+py*sinPI3;  cs[0] = hex_texcoord_x1; ct[0] = hex_texcoord_y1;
+		corner[1] = -px*cosPI3+py*sinPI3; cs[1] = hex_texcoord_x2; ct[1] = hex_texcoord_y1;
+		corner[2] = -px;                  cs[2] = 0.0f;            ct[2] = 0.5f;
+		corner[3] = -px*cosPI3-py*sinPI3; cs[3] = hex_texcoord_x2; ct[3] = hex_texcoord_y2;
+		corner[4] = px*cosPI3-py*sinPI3;  cs[4] = hex_texcoord_x1; ct[4] = hex_texcoord_y2;
+		corner[5] = px;                   cs[5] = 1.0f;            ct[5] = 0.5f;
+		corner[6] = corner[0];            cs[6] = cs[0];           ct[6] = ct[0];
+
+		osg::Vec3 center = osg::Vec3(0, 0, 0) * m;
+		float cs_center = s_coord_ + s_tile_ * 0.5f;
+		float ct_center = t_coord_ + t_tile_ * 0.5f;
+		for (int i = 0; i < 6; i++)
+		{
+			buffer.addVertex(tris, center, cs_center, ct_center, c);
+			buffer.addVertex(tris, corner[i] * m, s_coord_ + s_tile_ * cs[i], t_coord_ + t_tile_ * ct[i], c);
+			buffer.addVertex(tris, corner[i+1] * m, s_coord_ + s_tile_ * cs[i+1], t_coord_ + t_tile_ * ct[i+1], c);
+		}
+		return true;
+	}
+
+	// the remaining shapes are all quads; corners in counter-clockwise order
+	osg::Vec3 q0, q1, q2, q3;
+	if (shape_ == QUAD_OFFSET)
+	{
+		osg::Vec3 p2 = py * 2.0;
+		q0 = -px * m;
+		q1 = px * m;
+		q2 = (px + p2) * m;
+		q3 = (-px + p2) * m;
+	}
+	else
+	{
+		q0 = (-px - py) * m;
+		q1 = (px - py) * m;
+		q2 = (px + py) * m;
+		q3 = (-px + py) * m;
+	}
+
+	buffer.addVertex(tris, q0, s0, t0, c);
+	buffer.addVertex(tris, q1, s1, t0, c);
+	buffer.addVertex(tris, q2, s1, t1, c);
+	buffer.addVertex(tris, q0, s0, t0, c);
+	buffer.addVertex(tris, q2, s1, t1, c);
+	buffer.addVertex(tris, q3, s0, t1, c);
+	return true;
+}
+
+
 // ================================================
 // copy
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
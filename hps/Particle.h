@@ -28,6 +28,8 @@
 namespace osgParticleHPS
 {
 
+    class ParticleVertexBuffer;
+
     /**    Implementation of a <B>particle</B>.
         Objects of this class are particles, they have some graphical properties
         and some physical properties. Particles are created by emitters and then placed
@@ -216,6 +218,16 @@ namespace osgParticleHPS
         
         /// Perform some post-rendering tasks. Called automatically by particle systems.
         inline virtual void endRender() const;
+
+        /** Append this particle's vertices to a vertex buffer, producing the same geometry as
+            <CODE>render()</CODE> without making any GL calls.
+            Only the built-in shapes (those below <CODE>CUSTOM</CODE>) are supported; returns
+            false, and leaves the buffer untouched, for any other shape.
+        */
+        bool fillVertices(ParticleVertexBuffer &buffer, const osg::Vec3 &xpos, const osg::Vec3 &px, const osg::Vec3 &py) const;
+
+        /// Get the current (interpolated) color. Valid only after the first call to update().
+        inline const osg::Vec4 &getCurrentColor() const;
         
         /// Get the current (interpolated) polygon size. Valid only after the first call to update().
         inline osg::Vec3 getCurrentSize() const;
@@ -489,6 +501,11 @@ namespace osgParticleHPS
     {
         return current_size_;
     }
+
+    inline const osg::Vec4 &Particle::getCurrentColor() const
+    {
+        return current_color_;
+    }
     
     inline void Particle::setTextureTile(int sTile, int tTile, int numTiles)
 	{
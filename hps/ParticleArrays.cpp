@@ -0,0 +1,162 @@
+/** <pre>
+ *  The Multi-Purpose Viewer
+ *  Copyright (c) 2004 The Boeing Company
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ *  FILENAME:   ParticleArrays.cpp
+ *  LANGUAGE:   C++
+ *  CLASS:      UNCLASSIFIED
+ *  PROJECT:    Multi-Purpose Viewer
+ *
+ *  PROGRAM DESCRIPTION:
+ *  This file implements the ParticleArrays class.
+ *
+ *  MODIFICATION NOTES:
+ *  DATE     NAME                                SCR NUMBER
+ *  DESCRIPTION OF CHANGE........................
+ *
+ *  2026-10-19
+ *  Initial Release.
+ * </pre>
+ *  The Boeing Company
+ *  1.0
+ */
+
+#include "ParticleArrays.h"
+#include "ParticleSystem.h"
+#include "Particle.h"
+
+using namespace osgParticleHPS;
+
+
+// ================================================
+// ParticleArrays
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+ParticleArrays::ParticleArrays() :
+	count_( 0 ),
+	capacity_( 0 ),
+	fields_( 0 )
+{
+	// the accessors hand out &array[0], so the arrays are never empty
+	reserve( 64 );
+}
+
+
+// ================================================
+// reserve
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleArrays::reserve( int n )
+{
+	if( n <= capacity_ )
+		return;
+
+	int newCapacity = capacity_ > 0 ? capacity_ : 64;
+	while( newCapacity < n )
+		newCapacity *= 2;
+
+	particles_.resize( newCapacity );
+	px_.resize( newCapacity ); py_.resize( newCapacity ); pz_.resize( newCapacity );
+	vx_.resize( newCapacity ); vy_.resize( newCapacity ); vz_.resize( newCapacity );
+	massinv_.resize( newCapacity );
+	radius_.resize( newCapacity );
+	age_.resize( newCapacity ); lifetime_.resize( newCapacity );
+	sx_.resize( newCapacity ); sy_.resize( newCapacity ); sz_.resize( newCapacity );
+
+	capacity_ = newCapacity;
+}
+
+
+// ================================================
+// gather
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleArrays::gather( ParticleSystem *ps, unsigned int fields )
+{
+	int n = ps->numParticles();
+	reserve( n );
+
+	fields_ = fields;
+	count_ = 0;
+	for( int i = 0; i < n; i++ )
+	{
+		Particle *P = ps->getParticle( i );
+		if( P->isAlive() )
+			particles_[count_++] = P;
+	}
+
+	// One pass per field keeps each destination array's writes sequential.
+	if( fields & POSITION )
+	{
+		for( int i = 0; i < count_; i++ )
+		{
+			const osg::Vec3 &p = particles_[i]->getPosition();
+			px_[i] = p.x(); py_[i] = p.y(); pz_[i] = p.z();
+		}
+	}
+	if( fields & VELOCITY )
+	{
+		for( int i = 0; i < count_; i++ )
+		{
+			const osg::Vec3 &v = particles_[i]->getVelocity();
+			vx_[i] = v.x(); vy_[i] = v.y(); vz_[i] = v.z();
+		}
+	}
+	if( fields & MASS_INV )
+	{
+		for( int i = 0; i < count_; i++ )
+			massinv_[i] = particles_[i]->getMassInv();
+	}
+	if( fields & RADIUS )
+	{
+		for( int i = 0; i < count_; i++ )
+			radius_[i] = particles_[i]->getRadius();
+	}
+	if( fields & AGE )
+	{
+		for( int i = 0; i < count_; i++ )
+		{
+			age_[i] = particles_[i]->getAge();
+			lifetime_[i] = particles_[i]->getLifeTime();
+		}
+	}
+	if( fields & SIZE )
+	{
+		for( int i = 0; i < count_; i++ )
+		{
+			osg::Vec3 s = particles_[i]->getCurrentSize();
+			sx_[i] = s.x(); sy_[i] = s.y(); sz_[i] = s.z();
+		}
+	}
+}
+
+
+// ================================================
+// scatter
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleArrays::scatter( unsigned int fields )
+{
+	fields &= fields_;
+
+	if( fields & POSITION )
+	{
+		for( int i = 0; i < count_; i++ )
+			particles_[i]->setPosition( osg::Vec3( px_[i], py_[i], pz_[i] ) );
+	}
+	if( fields & VELOCITY )
+	{
+		for( int i = 0; i < count_; i++ )
+			particles_[i]->setVelocity( osg::Vec3( vx_[i], vy_[i], vz_[i] ) );
+	}
+}
@@ -0,0 +1,148 @@
+/** <pre>
+ *  The Multi-Purpose Viewer
+ *  Copyright (c) 2004 The Boeing Company
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ *  FILENAME:   ParticleArrays.h
+ *  LANGUAGE:   C++
+ *  CLASS:      UNCLASSIFIED
+ *  PROJECT:    Multi-Purpose Viewer
+ *
+ *  PROGRAM DESCRIPTION:
+ *  This file defines the ParticleArrays class.
+ *
+ *  MODIFICATION NOTES:
+ *  DATE     NAME                                SCR NUMBER
+ *  DESCRIPTION OF CHANGE........................
+ *
+ *  2026-10-19
+ *  Initial Release.
+ * </pre>
+ *  The Boeing Company
+ *  1.0
+ */
+
+#ifndef PARTICLEARRAYS_H
+#define PARTICLEARRAYS_H
+
+#include <vector>
+
+#include "Export.h"
+
+namespace osgParticleHPS
+{
+
+class Particle;
+class ParticleSystem;
+
+//=========================================================
+//! A structure-of-arrays snapshot of the live particles in a
+//! ParticleSystem.  ModularProgram gathers the fields its operators need
+//! into contiguous float arrays once per frame, runs each operator's batch
+//! kernel over the whole span, then scatters the modified fields back.
+//! This replaces one virtual Operator::operate() call per particle per
+//! operator with one call per operator, and gives the kernels loops over
+//! plain float arrays that the compiler can vectorize.
+//!
+class OSGPARTICLE_EXPORT ParticleArrays {
+public:
+
+	//=========================================================
+	//! Bit flags identifying the fields held by the arrays
+	//!
+	enum Field {
+		POSITION = 0x01,
+		VELOCITY = 0x02,
+		MASS_INV = 0x04,
+		RADIUS   = 0x08,
+		AGE      = 0x10,  // age and lifetime
+		SIZE     = 0x20
+	};
+
+	//=========================================================
+	//! General Constructor
+	//!
+	ParticleArrays();
+
+	//=========================================================
+	//! Collects the live particles of ps and copies the requested fields
+	//! into the arrays.  Storage is reused from frame to frame; it only
+	//! grows when the number of live particles exceeds the previous maximum.
+	//! \param ps - the particle system to read from
+	//! \param fields - a combination of Field flags
+	//!
+	void gather( ParticleSystem *ps, unsigned int fields );
+
+	//=========================================================
+	//! Copies the requested fields back into the particles they were
+	//! gathered from.  Only POSITION and VELOCITY may be written back.
+	//! \param fields - a combination of Field flags
+	//!
+	void scatter( unsigned int fields );
+
+	//=========================================================
+	//! Returns the number of particles in the arrays
+	//!
+	int size() const { return count_; }
+
+	//=========================================================
+	//! Returns the particle that element i was gathered from
+	//!
+	Particle *getParticle( int i ) const { return particles_[i]; }
+
+	//=========================================================
+	//! Returns the fields that were gathered by the last call to gather()
+	//!
+	unsigned int getFields() const { return fields_; }
+
+	float *positionX() { return &px_[0]; }
+	float *positionY() { return &py_[0]; }
+	float *positionZ() { return &pz_[0]; }
+	float *velocityX() { return &vx_[0]; }
+	float *velocityY() { return &vy_[0]; }
+	float *velocityZ() { return &vz_[0]; }
+	float *massInv() { return &massinv_[0]; }
+	float *radius() { return &radius_[0]; }
+	float *age() { return &age_[0]; }
+	float *lifeTime() { return &lifetime_[0]; }
+	float *sizeX() { return &sx_[0]; }
+	float *sizeY() { return &sy_[0]; }
+	float *sizeZ() { return &sz_[0]; }
+
+private:
+
+	//=========================================================
+	//! Grows the arrays so that they can hold at least n elements
+	//!
+	void reserve( int n );
+
+	int count_;
+	int capacity_;
+	unsigned int fields_;
+
+	std::vector<Particle *> particles_;
+
+	std::vector<float> px_, py_, pz_;
+	std::vector<float> vx_, vy_, vz_;
+	std::vector<float> massinv_;
+	std::vector<float> radius_;
+	std::vector<float> age_, lifetime_;
+	std::vector<float> sx_, sy_, sz_;
+};
+
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "ParticleProcessor.h"
+#include "ParticleUpdatePool.h"
 
 #include <osg/Node>
 #include <osg/NodeVisitor>
@@ -44,6 +45,22 @@ osgParticleHPS::ParticleProcessor::ParticleProcessor(const ParticleProcessor &co
     currentTime_(copy.currentTime_),
     resetTime_(copy.resetTime_)
 {
+    updatePoolChanged();
+}
+
+void osgParticleHPS::ParticleProcessor::setParticleSystem(ParticleSystem *ps)
+{
+    ps_ = ps;
+    updatePoolChanged();
+}
+
+void osgParticleHPS::ParticleProcessor::updatePoolChanged()
+{
+    // the update visitor only visits nodes that ask for it, and only 
+    // processors whose system has an update pool do their work then
+    unsigned int wanted = (ps_.valid() && ps_->getUpdatePool()) ? 1 : 0;
+    if (getNumChildrenRequiringUpdateTraversal() != wanted)
+        setNumChildrenRequiringUpdateTraversal(wanted);
 }
 
 void osgParticleHPS::ParticleProcessor::traverse(osg::NodeVisitor &nv)
@@ -51,8 +68,21 @@ void osgParticleHPS::ParticleProcessor::traverse(osg::NodeVisitor &nv)
     // typecast the NodeVisitor to CullVisitor
     osgUtil::CullVisitor *cv = dynamic_cast<osgUtil::CullVisitor *>(&nv);
 
-    // continue only if the visitor actually is a cull visitor
-    if (cv) {
+    // With an update pool, the processing is queued during the update 
+    // traversal and run by the pool; otherwise it happens right here, 
+    // during cull.
+    ParticleUpdatePool *pool = ps_.valid() ? ps_->getUpdatePool() : 0;
+    bool active = pool ? 
+        nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR : 
+        cv != 0;
+
+    // the pool was taken away without telling this processor; stop 
+    // asking for update traversals
+    if (!pool && nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR)
+        updatePoolChanged();
+
+    // continue only if the visitor is the one we process in
+    if (active) {
 
         // continue only if the particle system is valid
         if (ps_.valid())
@@ -94,8 +124,17 @@ void osgParticleHPS::ParticleProcessor::traverse(osg::NodeVisitor &nv)
                         need_wtl_matrix_ = true;
                         current_nodevisitor_ = &nv;
 
-                        // do some process (unimplemented in this base class)
-                        process(t - t0_);
+                        if (pool) {
+                            // the node path is only valid during this 
+                            // traversal, so resolve the matrices now
+                            getLocalToWorldMatrix();
+                            getWorldToLocalMatrix();
+                            current_nodevisitor_ = 0;
+                            pool->addProcessor(ps_.get(), this, t - t0_);
+                        } else {
+                            // do some process (unimplemented in this base class)
+                            process(t - t0_);
+                        }
                     }
                 }
 
@@ -73,7 +73,13 @@ namespace osgParticleHPS
         inline const ParticleSystem *getParticleSystem() const;
         
         /// Set the destination particle system.
-        inline void setParticleSystem(ParticleSystem *ps);
+        void setParticleSystem(ParticleSystem *ps);
+
+        /** Ask for update traversals if the destination particle system has an update pool, 
+            and stop asking if it doesn't.  Call this after setting or clearing the system's 
+            pool; <CODE>setParticleSystem()</CODE> calls it already.
+        */
+        void updatePoolChanged();
         
         /// Set the endless flag of this processor.
         inline void setEndless(bool type);
@@ -143,6 +149,9 @@ namespace osgParticleHPS
         virtual void process(double dt) = 0;
         
     private:
+        // runs process() for processors whose system has an update pool
+        friend class ParticleUpdatePool;
+
         ReferenceFrame rf_;
         bool enabled_;
         double t0_;
@@ -197,11 +206,6 @@ namespace osgParticleHPS
         return ps_.get();
     }
     
-    inline void ParticleProcessor::setParticleSystem(ParticleSystem *ps)
-    {
-        ps_ = ps;
-    }
-   
     inline void ParticleProcessor::setEndless(bool type)
     {
 		endless_ = type;
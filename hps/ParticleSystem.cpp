@@ -18,6 +18,9 @@
 #include "ParticleSystem.h"
 #include "ImageCache.h"
 
+// the default random seed keys; particle systems are created on one thread
+static unsigned int next_random_seed_key = 1;
+
 osgParticleHPS::ParticleSystem::ParticleSystem()
 :    osg::Drawable(), 
     def_bbox_(osg::Vec3(-10, -10, -10), osg::Vec3(10, 10, 10)),
@@ -26,6 +29,9 @@ osgParticleHPS::ParticleSystem::ParticleSystem()
     align_Y_axis_(0, 1, 0),
     doublepass_(false),
     frozen_(false),
+    vertex_buffer_rendering_(true),
+    texture_unit_(0),
+    random_seed_key_(next_random_seed_key++),
     bmin_(0, 0, 0), 
     bmax_(0, 0, 0), 
     reset_bounds_flag_(false),
@@ -51,6 +57,10 @@ osgParticleHPS::ParticleSystem::ParticleSystem(const ParticleSystem &copy, const
     align_Y_axis_(copy.align_Y_axis_),
     doublepass_(copy.doublepass_),
     frozen_(copy.frozen_),
+    vertex_buffer_rendering_(copy.vertex_buffer_rendering_),
+    texture_unit_(copy.texture_unit_),
+    update_pool_(copy.update_pool_),
+    random_seed_key_(next_random_seed_key++),
     bmin_(copy.bmin_), 
     bmax_(copy.bmax_), 
     reset_bounds_flag_(copy.reset_bounds_flag_),
@@ -87,7 +97,7 @@ void osgParticleHPS::ParticleSystem::update(double dt)
             if ((*i)->update(dt)) {
                 update_bounds((*i)->getPosition(), (*i)->getCurrentSize());
             } else {
-                deadparts_.push(*i);
+                deadparts_.push_back(*i);
             }
         }
     }
@@ -110,12 +120,19 @@ void osgParticleHPS::ParticleSystem::drawImplementation(osg::RenderInfo &renderI
     if (alignment_ == BILLBOARD)
         state.applyModelViewMatrix(0);
 
+    // expand the particles once; both passes draw from the same buffer
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(vertices_mutex_);
+    bool use_buffer = vertex_buffer_rendering_ && fillVertexBuffer(modelview, vertices_);
+
     // set up depth mask for first rendering pass
     glPushAttrib(GL_DEPTH_BUFFER_BIT); 
     glDepthMask(GL_FALSE);
 
     // render, first pass
-    single_pass_render(state, modelview);
+    if (use_buffer)
+        vertices_.draw(state, texture_unit_);
+    else
+        single_pass_render(state, modelview);
 
     // restore depth mask settings
     glPopAttrib();
@@ -127,13 +144,51 @@ void osgParticleHPS::ParticleSystem::drawImplementation(osg::RenderInfo &renderI
         glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
 
         // render the particles onto the depth buffer
-        single_pass_render(state, modelview);
+        if (use_buffer)
+            vertices_.draw(state, texture_unit_);
+        else
+            single_pass_render(state, modelview);
 
         // restore color mask settings
         glPopAttrib();
     }
 }
 
+bool osgParticleHPS::ParticleSystem::fillVertexBuffer(const osg::Matrix &modelview, ParticleVertexBuffer &buffer) const
+{
+    buffer.clear();
+    draw_count_ = 0;
+
+    Particle_vector::const_iterator i;
+    Particle_vector::const_iterator end = particles_.end();
+
+    for ( i = particles_.begin(); i < end; i++ ) {
+        if (!(*i)->isAlive())
+            continue;
+
+        bool ok = true;
+        switch (alignment_) {
+            case BILLBOARD:
+                ok = (*i)->fillVertices(buffer, modelview.preMult((*i)->getPosition()), osg::Vec3(1, 0, 0), osg::Vec3(0, 1, 0) );
+                break;
+            case FIXED:
+                ok = (*i)->fillVertices(buffer, (*i)->getPosition(), align_X_axis_, align_Y_axis_ );
+                break;
+            default: ;
+        }
+
+        if (!ok) {
+            // a custom shape; the caller has to fall back to render()
+            buffer.clear();
+            draw_count_ = 0;
+            return false;
+        }
+        ++draw_count_;
+    }
+
+    return true;
+}
+
 void osgParticleHPS::ParticleSystem::setDefaultAttributes(const std::string &texturefile, bool emissive_particles, bool lighting, int texture_unit)
 {
     osg::StateSet *stateset = new osg::StateSet;
@@ -147,6 +202,8 @@ void osgParticleHPS::ParticleSystem::setDefaultAttributes(const std::string &tex
     material->setColorMode(lighting? osg::Material::AMBIENT_AND_DIFFUSE : osg::Material::OFF);
     stateset->setAttributeAndModes(material, osg::StateAttribute::ON);
 
+    texture_unit_ = texture_unit;
+
     if (!texturefile.empty()) {
         osg::Texture2D *texture = new osg::Texture2D;
         texture->setImage( ImageCache::Instance()->loadImage( texturefile ) );
@@ -214,14 +271,14 @@ osgParticleHPS::Particle *osgParticleHPS::ParticleSystem::createParticle()
     if (!deadparts_.empty()) {
 
         // retrieve a pointer to the last dead particle
-        Particle *P = deadparts_.top();
+        Particle *P = deadparts_.back();
 
         // reset the particle; this restores the particle lifetime-related 
         // variables, and makes it ready for reuse
         P->reset();
 
         // remove the pointer from the death stack
-        deadparts_.pop();
+        deadparts_.pop_back();
         return P;
 
     } else {
@@ -17,9 +17,10 @@
 
 #include "Export.h"
 #include "Particle.h"
+#include "ParticleVertexBuffer.h"
+#include "ParticleUpdatePool.h"
 
 #include <vector>
-#include <stack>
 #include <algorithm>
 #include <string>
 
@@ -29,6 +30,9 @@
 #include <osg/State>
 #include <osg/Vec3>
 #include <osg/BoundingBox>
+#include <osg/ref_ptr>
+
+#include <OpenThreads/Mutex>
 
 namespace osgParticleHPS
 {
@@ -93,6 +97,43 @@ namespace osgParticleHPS
             system will fall into a transparent bin.
         */
         inline void setDoublePassRendering(bool v);
+
+        /// Get the vertex buffer rendering flag.
+        inline bool getVertexBufferRendering() const;
+
+        /** Set the vertex buffer rendering flag.
+            When enabled (the default), the particles are expanded into a vertex buffer on the
+            CPU and drawn with one call per primitive type, rather than one <CODE>glBegin()</CODE>
+            per particle.  Systems containing particles with custom shapes always use the
+            per-particle <CODE>render()</CODE> path.
+        */
+        inline void setVertexBufferRendering(bool v);
+
+        /// Get the update pool that runs this system's processors and update(), if any.
+        inline ParticleUpdatePool *getUpdatePool() const;
+
+        /** Set the update pool.  Normally set by <CODE>ParticleSystemUpdater</CODE>; when a pool is 
+            set, this system's emitters and programs queue their work on it during the update 
+            traversal instead of running it during cull.  They only get update traversals if 
+            they ask, so call <CODE>ParticleProcessor::updatePoolChanged()</CODE> on each of 
+            them after setting a pool.
+        */
+        inline void setUpdatePool(ParticleUpdatePool *pool);
+
+        /// Get the key used to seed this system's random numbers when it's run by an update pool.
+        inline unsigned int getRandomSeedKey() const;
+
+        /** Set the key used to seed this system's random numbers when it's run by an update pool.
+            Particle systems that should behave identically on every IG need keys that are the 
+            same on every IG; the default is the order in which the systems were created.
+        */
+        inline void setRandomSeedKey(unsigned int key);
+
+        /** Expand the live particles into <CODE>buffer</CODE>, as they would be drawn with the
+            given modelview matrix.  No GL calls are made, so this may be used without a context.
+            Returns false if any live particle has a shape that can't be put in a vertex buffer.
+        */
+        bool fillVertexBuffer(const osg::Matrix &modelview, ParticleVertexBuffer &buffer) const;
         
         /// Return true if the particle system is frozen.
         inline bool isFrozen() const;
@@ -224,7 +265,11 @@ namespace osgParticleHPS
 
     private:
         typedef std::vector<Particle*> Particle_vector;
-        typedef std::stack<Particle*> Death_stack;
+
+        // A vector-backed free list; unlike std::stack's default deque, it 
+        // keeps its storage across frames, so recycling a particle never 
+        // touches the heap.
+        typedef std::vector<Particle*> Death_stack;
 
 		//=========================================================
 		//! the list of particles, including dead ones
@@ -232,7 +277,7 @@ namespace osgParticleHPS
         Particle_vector particles_;
 
 		//=========================================================
-		//! the stack of dead particles
+		//! the stack of dead particles, reused by createParticle()
 		//! 
         Death_stack deadparts_;
         
@@ -244,6 +289,23 @@ namespace osgParticleHPS
 
         bool doublepass_;
         bool frozen_;
+        bool vertex_buffer_rendering_;
+
+		//=========================================================
+		//! the texture unit set up by setDefaultAttributes(); the vertex 
+		//! buffer's texture coordinates go to this unit
+		//! 
+        int texture_unit_;
+
+		//=========================================================
+		//! per-frame vertex storage, and the lock that serializes its use 
+		//! when the system is drawn by more than one graphics thread
+		//! 
+        mutable ParticleVertexBuffer vertices_;
+        mutable OpenThreads::Mutex vertices_mutex_;
+
+        osg::ref_ptr<ParticleUpdatePool> update_pool_;
+        unsigned int random_seed_key_;
 
         osg::Vec3 bmin_;
         osg::Vec3 bmax_;
@@ -336,6 +398,36 @@ namespace osgParticleHPS
         doublepass_ = v;
     }
 
+    inline ParticleUpdatePool *ParticleSystem::getUpdatePool() const
+    {
+        return update_pool_.get();
+    }
+
+    inline void ParticleSystem::setUpdatePool(ParticleUpdatePool *pool)
+    {
+        update_pool_ = pool;
+    }
+
+    inline unsigned int ParticleSystem::getRandomSeedKey() const
+    {
+        return random_seed_key_;
+    }
+
+    inline void ParticleSystem::setRandomSeedKey(unsigned int key)
+    {
+        random_seed_key_ = key;
+    }
+
+    inline bool ParticleSystem::getVertexBufferRendering() const
+    {
+        return vertex_buffer_rendering_;
+    }
+
+    inline void ParticleSystem::setVertexBufferRendering(bool v)
+    {
+        vertex_buffer_rendering_ = v;
+    }
+
     inline int ParticleSystem::numParticles() const
     {
         return static_cast<int>(particles_.size());
@@ -451,10 +543,7 @@ namespace osgParticleHPS
 		
 		particles_.clear();
 		
-		// std::stack has no clear().  The STL is asinine.  C++ sucks.  -ADS
-		//deadparts_.clear();
-		while( !deadparts_.empty() )
-			deadparts_.pop();
+		deadparts_.clear();
 	}
 
 }
@@ -12,18 +12,39 @@ osgParticleHPS::ParticleSystemUpdater::ParticleSystemUpdater()
 }
 
 osgParticleHPS::ParticleSystemUpdater::ParticleSystemUpdater(const ParticleSystemUpdater &copy, const osg::CopyOp &copyop)
-: osg::Node(copy, copyop), t0_(copy.t0_)
+: osg::Node(copy, copyop), t0_(copy.t0_), pool_(copy.pool_)
 {
+    if (pool_.valid())
+        setNumChildrenRequiringUpdateTraversal(1);
     ParticleSystem_Vector::const_iterator i;
     for (i=copy.psv_.begin(); i!=copy.psv_.end(); ++i) {
         psv_.push_back(static_cast<ParticleSystem *>(copyop(i->get())));
     }
 }
 
+void osgParticleHPS::ParticleSystemUpdater::setUpdatePool(ParticleUpdatePool *pool)
+{
+    pool_ = pool;
+
+    // the update visitor only visits nodes that ask for it, and there's 
+    // only work to do then with a pool
+    setNumChildrenRequiringUpdateTraversal(pool ? 1 : 0);
+
+    ParticleSystem_Vector::iterator i;
+    for (i=psv_.begin(); i!=psv_.end(); ++i)
+        i->get()->setUpdatePool(pool);
+}
+
 void osgParticleHPS::ParticleSystemUpdater::traverse(osg::NodeVisitor &nv)
 {
     osgUtil::CullVisitor *cv = dynamic_cast<osgUtil::CullVisitor *>(&nv);
-    if (cv) {
+
+    // with a pool, the update is queued during the update traversal
+    bool active = pool_.valid() ? 
+        nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR : 
+        cv != 0;
+
+    if (active) {
         if (nv.getFrameStamp())
         {
             double t = nv.getFrameStamp()->getReferenceTime();
@@ -34,7 +55,10 @@ void osgParticleHPS::ParticleSystemUpdater::traverse(osg::NodeVisitor &nv)
                 {
                     if (!i->get()->isFrozen() && (i->get()->getLastFrameNumber() >= (nv.getFrameStamp()->getFrameNumber() - 1) || !i->get()->getFreezeOnCull()))
                     {
-                        i->get()->update(t - t0_);
+                        if (pool_.valid())
+                            pool_->addUpdate(i->get(), t - t0_);
+                        else
+                            i->get()->update(t - t0_);
                     }
                 }
             }
@@ -46,5 +70,11 @@ void osgParticleHPS::ParticleSystemUpdater::traverse(osg::NodeVisitor &nv)
         }
 
     }
+    else if (cv && pool_.valid())
+    {
+        // normally the pool has already been dispatched by a callback on 
+        // the scene root; if not, make sure the work is done before drawing
+        pool_->dispatchPending();
+    }
     Node::traverse(nv);
 }
@@ -17,6 +17,7 @@
 
 #include "Export.h"
 #include "ParticleSystem.h"
+#include "ParticleUpdatePool.h"
 
 #include <vector>
 
@@ -35,6 +36,9 @@ namespace osgParticleHPS
         When a <CODE>ParticleSystemUpdater</CODE> is traversed by a cull visitor, it calls the
         <CODE>update()</CODE> method on the specified particle systems. You should place this updater
         <U>AFTER</U> other nodes like emitters and programs.
+        If the updater has a <CODE>ParticleUpdatePool</CODE>, the update is instead queued on the pool
+        during the update traversal, along with the work of the systems' emitters and programs, and 
+        the placement of the updater doesn't matter.
     */
     class OSGPARTICLE_EXPORT ParticleSystemUpdater: public osg::Node {
     public:
@@ -73,6 +77,14 @@ namespace osgParticleHPS
         /// get index number of ParticleSystem.
         inline unsigned int getParticleSystemIndex( const ParticleSystem* ps ) const;
         
+        /** Set the update pool.  The pool is passed on to the particle systems on the list, and to
+            any that are added later.  Pass NULL to go back to updating during cull.
+        */
+        void setUpdatePool(ParticleUpdatePool *pool);
+
+        /// Get the update pool.
+        inline ParticleUpdatePool *getUpdatePool() const;
+
         virtual void traverse(osg::NodeVisitor &nv);
         
     protected:
@@ -86,6 +98,7 @@ namespace osgParticleHPS
         
         ParticleSystem_Vector psv_;
         double t0_;
+        osg::ref_ptr<ParticleUpdatePool> pool_;
     };
     
     // INLINE FUNCTIONS
@@ -98,8 +111,14 @@ namespace osgParticleHPS
     inline bool ParticleSystemUpdater::addParticleSystem(ParticleSystem *ps)
     {
         psv_.push_back(ps);
+        if (pool_.valid()) ps->setUpdatePool(pool_.get());
         return true;
     }
+
+    inline ParticleUpdatePool *ParticleSystemUpdater::getUpdatePool() const
+    {
+        return pool_.get();
+    }
     
     inline bool ParticleSystemUpdater::removeParticleSystem(ParticleSystem *ps)
     {
@@ -143,6 +162,7 @@ namespace osgParticleHPS
        if( (i < psv_.size()) && ps )
        {
           psv_[i] = ps;
+          if (pool_.valid()) ps->setUpdatePool(pool_.get());
           return true;
        }
        return false;
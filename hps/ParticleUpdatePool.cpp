@@ -0,0 +1,403 @@
+/** <pre>
+ *  The Multi-Purpose Viewer
+ *  Copyright (c) 2004 The Boeing Company
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ *  FILENAME:   ParticleUpdatePool.cpp
+ *  LANGUAGE:   C++
+ *  CLASS:      UNCLASSIFIED
+ *  PROJECT:    Multi-Purpose Viewer
+ *
+ *  PROGRAM DESCRIPTION:
+ *  This file implements the ParticleUpdatePool class.
+ *
+ *  MODIFICATION NOTES:
+ *  DATE     NAME                                SCR NUMBER
+ *  DESCRIPTION OF CHANGE........................
+ *
+ *  2026-10-19
+ *  Initial Release.
+ * </pre>
+ *  The Boeing Company
+ *  1.0
+ */
+
+#include <OpenThreads/ScopedLock>
+
+#include "ParticleUpdatePool.h"
+#include "ParticleSystem.h"
+#include "ParticleProcessor.h"
+#include "range.h"
+
+using namespace osgParticleHPS;
+
+// the largest value returned by jobRandom()
+#define JOB_RAND_MAX 0x7fffffff
+
+int (*ParticleUpdatePool::previousRandFunc_)( void ) = NULL;
+int ParticleUpdatePool::previousRandMax_ = 0;
+ParticleUpdatePool *ParticleUpdatePool::randomPool_ = NULL;
+
+
+// ================================================
+// ParticleUpdatePool
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+ParticleUpdatePool::ParticleUpdatePool( int numThreads ) :
+	osg::Referenced(),
+	numJobs_( 0 ),
+	generation_( 0 ),
+	jobsRemaining_( 0 ),
+	quit_( false ),
+	dispatching_( false ),
+	dispatchThreadID_(),
+	dispatchRandomStream_( NULL )
+{
+	dispatchCallback_ = new DispatchCallback( this );
+
+	if( numThreads < 0 )
+		numThreads = 0;
+
+	deques_.push_back( new JobDeque );
+	for( int i = 0; i < numThreads; i++ )
+	{
+		deques_.push_back( new JobDeque );
+		workers_.push_back( new Worker( this, i + 1 ) );
+	}
+
+	for( unsigned int i = 0; i < workers_.size(); i++ )
+		workers_[i]->start();
+}
+
+
+// ================================================
+// ~ParticleUpdatePool
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+ParticleUpdatePool::~ParticleUpdatePool()
+{
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( runMutex_ );
+		quit_ = true;
+		startCondition_.broadcast();
+	}
+
+	for( unsigned int i = 0; i < workers_.size(); i++ )
+	{
+		workers_[i]->join();
+		delete workers_[i];
+	}
+	for( unsigned int i = 0; i < deques_.size(); i++ )
+		delete deques_[i];
+
+	if( randomPool_ == this )
+	{
+		// put back the function we replaced
+		rangeSetRandFunc( previousRandFunc_, previousRandMax_ );
+		randomPool_ = NULL;
+	}
+}
+
+
+// ================================================
+// findJob
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+ParticleUpdatePool::Job &ParticleUpdatePool::findJob( ParticleSystem *ps )
+{
+	std::map<ParticleSystem *, int>::iterator iter = jobIndex_.find( ps );
+	if( iter != jobIndex_.end() )
+		return jobs_[iter->second];
+
+	// job storage (and the processor lists inside it) is reused from
+	// frame to frame
+	if( numJobs_ == static_cast<int>( jobs_.size() ) )
+		jobs_.push_back( Job() );
+
+	Job &job = jobs_[numJobs_];
+	job.ps = ps;
+	job.processors.clear();
+	job.processorDts.clear();
+	job.hasUpdate = false;
+	job.updateDt = 0.0;
+	job.random = mpv::RandomStream();
+
+	jobIndex_[ps] = numJobs_;
+	numJobs_++;
+	return job;
+}
+
+
+// ================================================
+// addProcessor
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleUpdatePool::addProcessor( ParticleSystem *ps, ParticleProcessor *proc, double dt )
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( queueMutex_ );
+	Job &job = findJob( ps );
+	job.processors.push_back( proc );
+	job.processorDts.push_back( dt );
+}
+
+
+// ================================================
+// addUpdate
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleUpdatePool::addUpdate( ParticleSystem *ps, double dt )
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( queueMutex_ );
+	Job &job = findJob( ps );
+	job.hasUpdate = true;
+	job.updateDt = dt;
+}
+
+
+// ================================================
+// dispatch
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleUpdatePool::dispatch()
+{
+	// holding queueMutex_ for the whole dispatch also keeps a second
+	// dispatch (ie the cull-time fallback) from overlapping this one
+	OpenThreads::ScopedLock<OpenThreads::Mutex> queueLock( queueMutex_ );
+
+	// One value per frame from the previous generator, whether or not
+	// anything is queued, so that the synchronized generator's sequence
+	// doesn't depend on which particle systems happen to be active.
+	unsigned int frameSeed = 0;
+	if( randomPool_ == this && previousRandFunc_ != NULL )
+		frameSeed = (unsigned int)previousRandFunc_();
+
+	if( numJobs_ == 0 )
+		return;
+
+	// set before the jobs are queued, since a late worker could pick one 
+	// up as soon as it is
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( runMutex_ );
+		jobsRemaining_ = numJobs_;
+	}
+
+	int numDeques = static_cast<int>( deques_.size() );
+	for( int j = 0; j < numJobs_; j++ )
+	{
+		Job &job = jobs_[j];
+		job.random = mpv::RandomStream( job.ps->getRandomSeedKey(), frameSeed );
+
+		// a worker that was slow to notice the last dispatch may still be
+		// looking through the deques, so they're locked even here
+		JobDeque *d = deques_[j % numDeques];
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( d->mutex );
+		d->jobs.push_back( j );
+	}
+
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( runMutex_ );
+		generation_++;
+#if defined(WIN32) && !defined(__CYGWIN__)
+		dispatchThreadID_ = GetCurrentThreadId();
+#else
+		dispatchThreadID_ = pthread_self();
+#endif
+		dispatching_ = true;
+		startCondition_.broadcast();
+	}
+
+	// this thread works too
+	runJobs( 0, dispatchRandomStream_ );
+
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( runMutex_ );
+		while( jobsRemaining_ > 0 )
+			doneCondition_.wait( &runMutex_ );
+		dispatching_ = false;
+	}
+
+	numJobs_ = 0;
+	jobIndex_.clear();
+}
+
+
+// ================================================
+// dispatchPending
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleUpdatePool::dispatchPending()
+{
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( queueMutex_ );
+		if( numJobs_ == 0 )
+			return;
+	}
+	dispatch();
+}
+
+
+// ================================================
+// takeJob
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int ParticleUpdatePool::takeJob( int i, bool steal )
+{
+	JobDeque *d = deques_[i];
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( d->mutex );
+	if( d->jobs.empty() )
+		return -1;
+
+	int result;
+	if( steal )
+	{
+		result = d->jobs.front();
+		d->jobs.pop_front();
+	}
+	else
+	{
+		result = d->jobs.back();
+		d->jobs.pop_back();
+	}
+	return result;
+}
+
+
+// ================================================
+// runJobs
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleUpdatePool::runJobs( int self, mpv::RandomStream *&randomStream )
+{
+	int numDeques = static_cast<int>( deques_.size() );
+
+	// all of the jobs are queued before anyone is woken, so once every
+	// deque is empty there's nothing left for this thread to do
+	while( true )
+	{
+		int j = takeJob( self, false );
+		for( int i = 1; j < 0 && i < numDeques; i++ )
+			j = takeJob( ( self + i ) % numDeques, true );
+		if( j < 0 )
+			break;
+
+		randomStream = &jobs_[j].random;
+		runJob( jobs_[j] );
+		randomStream = NULL;
+
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( runMutex_ );
+		jobsRemaining_--;
+		if( jobsRemaining_ == 0 )
+			doneCondition_.broadcast();
+	}
+}
+
+
+// ================================================
+// runJob
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleUpdatePool::runJob( Job &job )
+{
+	for( unsigned int i = 0; i < job.processors.size(); i++ )
+		job.processors[i]->process( job.processorDts[i] );
+
+	if( job.hasUpdate )
+		job.ps->update( job.updateDt );
+}
+
+
+// ================================================
+// Worker::run
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleUpdatePool::Worker::run()
+{
+	unsigned int seen = 0;
+	while( true )
+	{
+		{
+			OpenThreads::ScopedLock<OpenThreads::Mutex> lock( pool_->runMutex_ );
+			while( pool_->generation_ == seen && !pool_->quit_ )
+				pool_->startCondition_.wait( &pool_->runMutex_ );
+			if( pool_->quit_ )
+				return;
+			seen = pool_->generation_;
+		}
+
+		pool_->runJobs( index_, randomStream_ );
+	}
+}
+
+
+// ================================================
+// DispatchCallback::operator()
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleUpdatePool::DispatchCallback::operator()( osg::Node *node, osg::NodeVisitor *nv )
+{
+	// the processors and updaters below this node queue their work as
+	// they're traversed; run it once they all have
+	traverse( node, nv );
+	pool_->dispatch();
+}
+
+
+// ================================================
+// enableJobRandom
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleUpdatePool::enableJobRandom()
+{
+	if( rangef::randFunc != jobRandom )
+	{
+		previousRandFunc_ = rangef::randFunc;
+		previousRandMax_ = rangef::randMax;
+	}
+	randomPool_ = this;
+	rangeSetRandFunc( jobRandom, JOB_RAND_MAX );
+}
+
+
+// ================================================
+// isDispatchThread
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool ParticleUpdatePool::isDispatchThread() const
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( runMutex_ );
+	if( !dispatching_ )
+		return false;
+#if defined(WIN32) && !defined(__CYGWIN__)
+	return dispatchThreadID_ == GetCurrentThreadId();
+#else
+	return pthread_equal( dispatchThreadID_, pthread_self() ) != 0;
+#endif
+}
+
+
+// ================================================
+// jobRandom
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int ParticleUpdatePool::jobRandom()
+{
+	ParticleUpdatePool *pool = randomPool_;
+	mpv::RandomStream *stream = NULL;
+
+	if( pool != NULL )
+	{
+		Worker *worker = dynamic_cast<Worker *>( OpenThreads::Thread::CurrentThread() );
+		if( worker != NULL && worker->pool_ == pool )
+			stream = worker->randomStream_;
+		else if( pool->isDispatchThread() )
+			stream = pool->dispatchRandomStream_;
+	}
+
+	if( stream == NULL )
+	{
+		// not inside a job; use the previous generator, rescaled
+		if( previousRandFunc_ == NULL || previousRandMax_ <= 0 )
+			return 0;
+		return (int)( (double)previousRandFunc_() / previousRandMax_ * JOB_RAND_MAX );
+	}
+
+	return (int)( stream->next() >> 1 );
+}
@@ -0,0 +1,268 @@
+/** <pre>
+ *  The Multi-Purpose Viewer
+ *  Copyright (c) 2004 The Boeing Company
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ *  FILENAME:   ParticleUpdatePool.h
+ *  LANGUAGE:   C++
+ *  CLASS:      UNCLASSIFIED
+ *  PROJECT:    Multi-Purpose Viewer
+ *
+ *  PROGRAM DESCRIPTION:
+ *  This file defines the ParticleUpdatePool class.
+ *
+ *  MODIFICATION NOTES:
+ *  DATE     NAME                                SCR NUMBER
+ *  DESCRIPTION OF CHANGE........................
+ *
+ *  2026-10-19
+ *  Initial Release.
+ * </pre>
+ *  The Boeing Company
+ *  1.0
+ */
+
+#ifndef PARTICLEUPDATEPOOL_H
+#define PARTICLEUPDATEPOOL_H
+
+#include <vector>
+#include <map>
+#include <deque>
+
+#include <osg/Referenced>
+#include <osg/NodeCallback>
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Thread>
+
+#if defined(WIN32) && !defined(__CYGWIN__)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "RandomStream.h"
+
+#include "Export.h"
+
+namespace osgParticleHPS
+{
+
+class ParticleSystem;
+class ParticleProcessor;
+
+//=========================================================
+//! Runs the per-frame simulation of independent particle systems on a pool
+//! of worker threads.
+//!
+//! When a ParticleSystemUpdater has a pool, its particle systems' emitters,
+//! programs and update() are no longer run as the cull visitor reaches
+//! them.  Instead, during the update traversal, each ParticleProcessor
+//! resolves its matrices and queues itself, and the updater queues the
+//! system's update().  dispatch() then runs one job per particle system --
+//! the system's processors in traversal order, followed by its update() --
+//! spread across the workers with work stealing, and returns when all of
+//! them are done.  Install the callback from getDispatchCallback() on the
+//! scene root so that dispatch() happens after the update traversal and
+//! before cull.
+//!
+//! Random numbers: the range<> types draw from a single global function,
+//! which can't be shared between threads and whose sequence would depend
+//! on the order the jobs happened to run in.  enableJobRandom() replaces it
+//! with one that draws from a generator belonging to the current job.
+//! Each job's generator is an mpv::RandomStream, whose stream ID is the
+//! particle system's random seed key, and whose frame is one value per
+//! frame drawn from the function that was installed before (ie the
+//! synchronized generator from PluginSyncedRandomNumbers, when it's
+//! loaded).  IGs that receive the same host frames therefore produce the
+//! same particles, regardless of thread count or scheduling.
+//!
+class OSGPARTICLE_EXPORT ParticleUpdatePool : public osg::Referenced {
+public:
+
+	//=========================================================
+	//! General Constructor
+	//! \param numThreads - the number of worker threads to start.  The
+	//!        thread calling dispatch() also runs jobs, so 0 is valid and
+	//!        runs everything on that thread.
+	//!
+	ParticleUpdatePool( int numThreads );
+
+	//=========================================================
+	//! Returns the number of worker threads
+	//!
+	int getNumThreads() const { return static_cast<int>( workers_.size() ); }
+
+	//=========================================================
+	//! Queues a call to proc->process(dt) in ps's job for this frame.  The
+	//! processor's matrices must already have been resolved.
+	//!
+	void addProcessor( ParticleSystem *ps, ParticleProcessor *proc, double dt );
+
+	//=========================================================
+	//! Queues a call to ps->update(dt), which runs after ps's processors.
+	//!
+	void addUpdate( ParticleSystem *ps, double dt );
+
+	//=========================================================
+	//! Runs all queued jobs and waits for them to finish.  Draws this
+	//! frame's seed first, so it should be called exactly once per frame.
+	//!
+	void dispatch();
+
+	//=========================================================
+	//! Calls dispatch() if any jobs are queued.  ParticleSystemUpdater
+	//! calls this from the cull traversal, as a fallback for scenes where
+	//! the dispatch callback hasn't been installed.
+	//!
+	void dispatchPending();
+
+	//=========================================================
+	//! Returns a node callback which traverses the node it's attached to
+	//! and then calls dispatch().  Any callback that was previously on the
+	//! node should be set as its nested callback.
+	//!
+	osg::NodeCallback *getDispatchCallback() { return dispatchCallback_.get(); }
+
+	//=========================================================
+	//! Installs the per-job random number function for the range<> types.
+	//! The previously installed function is kept, and is used for the
+	//! per-frame seed and for random numbers drawn outside of a job.
+	//!
+	void enableJobRandom();
+
+	//=========================================================
+	//! The random number function installed by enableJobRandom()
+	//!
+	static int jobRandom();
+
+protected:
+
+	virtual ~ParticleUpdatePool();
+
+	//=========================================================
+	//! Everything that has to happen to one particle system this frame
+	//!
+	struct Job
+	{
+		ParticleSystem *ps;
+		std::vector<ParticleProcessor *> processors;
+		std::vector<double> processorDts;
+		bool hasUpdate;
+		double updateDt;
+		mpv::RandomStream random;
+	};
+
+	//=========================================================
+	//! A deque of job indices.  The thread that owns it takes jobs from the
+	//! back; other threads steal from the front.  Jobs are whole particle
+	//! systems, so a mutex per deque is cheap enough.
+	//!
+	struct JobDeque
+	{
+		OpenThreads::Mutex mutex;
+		std::deque<int> jobs;
+	};
+
+	class Worker : public OpenThreads::Thread
+	{
+	public:
+		Worker( ParticleUpdatePool *pool, int index ) : 
+			pool_( pool ), index_( index ), randomStream_( NULL ) {}
+		virtual void run();
+
+		ParticleUpdatePool *pool_;
+		int index_;
+
+		//! the random stream of the job this thread is running, or NULL
+		mpv::RandomStream *randomStream_;
+	};
+
+	class DispatchCallback : public osg::NodeCallback
+	{
+	public:
+		DispatchCallback( ParticleUpdatePool *pool ) : pool_( pool ) {}
+		virtual void operator()( osg::Node *node, osg::NodeVisitor *nv );
+		ParticleUpdatePool *pool_;
+	};
+
+	//! Returns the job for ps, creating it if this is the first time ps
+	//! has been seen this frame.  Caller must hold queueMutex_.
+	Job &findJob( ParticleSystem *ps );
+
+	//! Runs jobs from deque self, then steals from the others, until none
+	//! remain.  randomStream is pointed at each job's stream while it runs.
+	void runJobs( int self, mpv::RandomStream *&randomStream );
+
+	//! Removes a job index from the back of deque i, or from the front if
+	//! steal is set.  Returns -1 if the deque is empty.
+	int takeJob( int i, bool steal );
+
+	void runJob( Job &job );
+
+	std::vector<Worker *> workers_;
+
+	//! deques_[0] belongs to the thread calling dispatch(); deques_[i+1]
+	//! belongs to workers_[i]
+	std::vector<JobDeque *> deques_;
+
+	//! protects the job list
+	OpenThreads::Mutex queueMutex_;
+	std::vector<Job> jobs_;
+	int numJobs_;
+	std::map<ParticleSystem *, int> jobIndex_;
+
+	//! wakes the workers when a dispatch starts, and the dispatching
+	//! thread when the last job finishes; also guards dispatching_ and
+	//! dispatchThreadID_, which isDispatchThread() reads from any thread
+	mutable OpenThreads::Mutex runMutex_;
+	OpenThreads::Condition startCondition_;
+	OpenThreads::Condition doneCondition_;
+	unsigned int generation_;
+	int jobsRemaining_;
+	bool quit_;
+
+	//! set while a thread is in dispatch(); dispatchThreadID_ is that 
+	//! thread's native ID.  The native ID is used because the dispatching 
+	//! thread may not be an OpenThreads thread, and CurrentThread() 
+	//! returns NULL for all of those alike.  Both are guarded by
+	//! runMutex_.
+	bool dispatching_;
+#if defined(WIN32) && !defined(__CYGWIN__)
+	DWORD dispatchThreadID_;
+#else
+	pthread_t dispatchThreadID_;
+#endif
+
+	//! the random stream of the job the dispatching thread is running
+	mpv::RandomStream *dispatchRandomStream_;
+
+	//! true if the calling thread is the one in dispatch()
+	bool isDispatchThread() const;
+
+	osg::ref_ptr<osg::NodeCallback> dispatchCallback_;
+
+	//! the range<> random function that was installed before
+	//! enableJobRandom(), and its maximum
+	static int (*previousRandFunc_)( void );
+	static int previousRandMax_;
+	static ParticleUpdatePool *randomPool_;
+};
+
+}
+
+#endif
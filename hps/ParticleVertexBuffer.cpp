@@ -0,0 +1,97 @@
+/** <pre>
+ *  The Multi-Purpose Viewer
+ *  Copyright (c) 2004 The Boeing Company
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ *  FILENAME:   ParticleVertexBuffer.cpp
+ *  LANGUAGE:   C++
+ *  CLASS:      UNCLASSIFIED
+ *  PROJECT:    Multi-Purpose Viewer
+ *
+ *  PROGRAM DESCRIPTION:
+ *  This file implements the ParticleVertexBuffer class.
+ *
+ *  MODIFICATION NOTES:
+ *  DATE     NAME                                SCR NUMBER
+ *  DESCRIPTION OF CHANGE........................
+ *
+ *  2026-10-19
+ *  Initial Release.
+ * </pre>
+ *  The Boeing Company
+ *  1.0
+ */
+
+#include <osg/GL>
+#include <osg/State>
+
+#include "ParticleVertexBuffer.h"
+
+using namespace osgParticleHPS;
+
+
+// ================================================
+// ParticleVertexBuffer
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+ParticleVertexBuffer::ParticleVertexBuffer()
+{
+}
+
+
+// ================================================
+// clear
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleVertexBuffer::clear()
+{
+	// std::vector::clear() keeps the allocation
+	for( int p = 0; p < NUM_PRIMITIVES; p++ )
+		vertices_[p].clear();
+}
+
+
+// ================================================
+// draw
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ParticleVertexBuffer::draw( osg::State &state, unsigned int textureUnit ) const
+{
+	static const GLenum modes[NUM_PRIMITIVES] = { GL_POINTS, GL_LINES, GL_TRIANGLES };
+
+	// osg::State selects the client texture unit for the texture 
+	// coordinates, and keeps track of what is enabled, so the next 
+	// drawable starts from what it expects
+	state.disableAllVertexArrays();
+	state.unbindVertexBufferObject();
+
+	for( int p = 0; p < NUM_PRIMITIVES; p++ )
+	{
+		if( vertices_[p].empty() )
+			continue;
+
+		const Vertex *v = &vertices_[p][0];
+
+		// render() gives points no texture coordinates; they get the 
+		// current one
+		if( p == POINTS )
+			state.disableTexCoordPointer( textureUnit );
+		else
+			state.setTexCoordPointer( textureUnit, 2, GL_FLOAT, sizeof( Vertex ), &v->s );
+		state.setColorPointer( 4, GL_FLOAT, sizeof( Vertex ), &v->r );
+		state.setVertexPointer( 3, GL_FLOAT, sizeof( Vertex ), &v->x );
+		glDrawArrays( modes[p], 0, static_cast<GLsizei>( vertices_[p].size() ) );
+	}
+
+	state.disableAllVertexArrays();
+}
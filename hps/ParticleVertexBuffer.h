@@ -0,0 +1,149 @@
+/** <pre>
+ *  The Multi-Purpose Viewer
+ *  Copyright (c) 2004 The Boeing Company
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ *  FILENAME:   ParticleVertexBuffer.h
+ *  LANGUAGE:   C++
+ *  CLASS:      UNCLASSIFIED
+ *  PROJECT:    Multi-Purpose Viewer
+ *
+ *  PROGRAM DESCRIPTION:
+ *  This file defines the ParticleVertexBuffer class.
+ *
+ *  MODIFICATION NOTES:
+ *  DATE     NAME                                SCR NUMBER
+ *  DESCRIPTION OF CHANGE........................
+ *
+ *  2026-10-19
+ *  Initial Release.
+ * </pre>
+ *  The Boeing Company
+ *  1.0
+ */
+
+#ifndef PARTICLEVERTEXBUFFER_H
+#define PARTICLEVERTEXBUFFER_H
+
+#include <vector>
+
+#include <osg/Vec3>
+#include <osg/Vec4>
+#include <osg/State>
+
+#include "Export.h"
+
+namespace osgParticleHPS
+{
+
+//=========================================================
+//! Streaming vertex storage for a ParticleSystem.  Each frame, the system
+//! expands its particles into this buffer on the CPU (see
+//! Particle::fillVertices) and then draws the whole system with one
+//! glDrawArrays per primitive type, instead of issuing glBegin/glVertex
+//! for every particle.  Storage is kept between frames, so a steady-state
+//! particle count does no allocation.
+//!
+//! Filling the buffer makes no GL calls; only draw() needs a context.
+//!
+class OSGPARTICLE_EXPORT ParticleVertexBuffer {
+public:
+
+	//=========================================================
+	//! Primitive groups.  Quads, triangle strips and hexagons are all
+	//! expanded into independent triangles so that they share one draw.
+	//!
+	enum Primitive {
+		POINTS = 0,
+		LINES,
+		TRIANGLES,
+		NUM_PRIMITIVES
+	};
+
+	//=========================================================
+	//! Interleaved vertex; the layout matches the strides passed to
+	//! the array pointers in draw().  The texture coordinates of points
+	//! are not drawn.
+	//!
+	struct Vertex {
+		float s, t;
+		float r, g, b, a;
+		float x, y, z;
+	};
+
+	//=========================================================
+	//! General Constructor
+	//!
+	ParticleVertexBuffer();
+
+	//=========================================================
+	//! Empties the buffer, keeping its storage for the next frame
+	//!
+	void clear();
+
+	//=========================================================
+	//! Appends a vertex to the given primitive group
+	//!
+	inline void addVertex( Primitive p, const osg::Vec3 &pos, float s, float t, const osg::Vec4 &color );
+
+	//=========================================================
+	//! Returns the number of vertices in the given primitive group
+	//!
+	int getNumVertices( Primitive p ) const { return static_cast<int>( vertices_[p].size() ); }
+
+	//=========================================================
+	//! Returns the vertices in the given primitive group, or NULL if the
+	//! group is empty
+	//!
+	const Vertex *getVertices( Primitive p ) const
+	{
+		return vertices_[p].empty() ? 0 : &vertices_[p][0];
+	}
+
+	//=========================================================
+	//! Issues one glDrawArrays call per non-empty primitive group.  Must be
+	//! called with a current GL context.
+	//! \param state - the state of the context being drawn in
+	//! \param textureUnit - the unit given the texture coordinates
+	//!
+	void draw( osg::State &state, unsigned int textureUnit ) const;
+
+private:
+
+	std::vector<Vertex> vertices_[NUM_PRIMITIVES];
+};
+
+
+// INLINE FUNCTIONS
+
+inline void ParticleVertexBuffer::addVertex( Primitive p, const osg::Vec3 &pos, float s, float t, const osg::Vec4 &color )
+{
+	Vertex v;
+	v.s = s;
+	v.t = t;
+	v.r = color.x();
+	v.g = color.y();
+	v.b = color.z();
+	v.a = color.w();
+	v.x = pos.x();
+	v.y = pos.y();
+	v.z = pos.z();
+	vertices_[p].push_back( v );
+}
+
+}
+
+#endif
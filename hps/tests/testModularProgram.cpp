@@ -0,0 +1,184 @@
+/** <pre>
+ *  The Multi-Purpose Viewer
+ *  Copyright (c) 2004 The Boeing Company
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ *  FILENAME:   testModularProgram.cpp
+ *  LANGUAGE:   C++
+ *  CLASS:      UNCLASSIFIED
+ *  PROJECT:    Multi-Purpose Viewer
+ *
+ *  PROGRAM DESCRIPTION:
+ *  Checks that the batch operator kernels give the same results as the
+ *  per-particle ones.
+ *
+ *  MODIFICATION NOTES:
+ *  DATE     NAME                                SCR NUMBER
+ *  DESCRIPTION OF CHANGE........................
+ *
+ *  2026-10-19
+ *  Initial Release.
+ * </pre>
+ *  The Boeing Company
+ *  1.0
+ */
+
+#include <math.h>
+
+#include <osg/ref_ptr>
+
+#include "ModularProgram.h"
+#include "ParticleSystem.h"
+#include "Particle.h"
+#include "AccelOperator.h"
+#include "ForceOperator.h"
+#include "FluidFrictionOperator.h"
+
+#include "TestCheck.h"
+
+using namespace osgParticleHPS;
+
+namespace
+{
+	//=========================================================
+	//! An operator without a batch kernel that does nothing; placed 
+	//! between two kernels, it keeps them from being batched together
+	//!
+	class IdentityOperator : public Operator
+	{
+	public:
+		IdentityOperator() : Operator() {}
+		IdentityOperator( const IdentityOperator &copy, 
+			const osg::CopyOp &copyop = osg::CopyOp::SHALLOW_COPY ) : 
+			Operator( copy, copyop ) {}
+
+		META_Object( osgParticleHPS, IdentityOperator );
+
+		void operate( Particle *, double ) {}
+
+	protected:
+		virtual ~IdentityOperator() {}
+	};
+
+	//=========================================================
+	//! Makes execute() callable
+	//!
+	class TestProgram : public ModularProgram
+	{
+	public:
+		void run( double dt ) { execute( dt ); }
+	};
+
+	const int numParticles = 5000;
+
+	//! Fills a particle system with particles of assorted sizes and 
+	//! masses, moving in assorted directions
+	ParticleSystem *makeParticles()
+	{
+		ParticleSystem *ps = new ParticleSystem;
+		for( int i = 0; i < numParticles; i++ )
+		{
+			Particle *P = ps->createParticle();
+			P->setRadius( 0.05f + 0.01f * ( i % 7 ) );
+			P->setMass( 0.1f + 0.05f * ( i % 5 ) );
+			P->setPosition( osg::Vec3( i, -i, 0.5f * i ) );
+			P->setVelocity( osg::Vec3( 
+				10.0f * sinf( (float)i ), 10.0f * cosf( (float)i ), 0.1f * ( i % 13 ) ) );
+		}
+		return ps;
+	}
+
+	//! Adds acceleration, force and friction operators, with an identity
+	//! operator after each one if separate is set
+	TestProgram *makeProgram( ParticleSystem *ps, bool separate )
+	{
+		TestProgram *program = new TestProgram;
+		program->setReferenceFrame( ParticleProcessor::ABSOLUTE_RF );
+		program->setParticleSystem( ps );
+
+		AccelOperator *accel = new AccelOperator;
+		accel->setToGravity();
+		program->addOperator( accel );
+		if( separate )
+			program->addOperator( new IdentityOperator );
+
+		ForceOperator *force = new ForceOperator;
+		force->setForce( osg::Vec3( 0.3f, -0.2f, 0.1f ) );
+		program->addOperator( force );
+		if( separate )
+			program->addOperator( new IdentityOperator );
+
+		FluidFrictionOperator *friction = new FluidFrictionOperator;
+		friction->setFluidToAir();
+		program->addOperator( friction );
+
+		return program;
+	}
+
+	bool close( float a, float b )
+	{
+		return fabsf( a - b ) <= 1e-4f * ( 1.0f + fabsf( a ) );
+	}
+}
+
+
+// ================================================
+// testBatchMatchesPerParticle
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testBatchMatchesPerParticle()
+{
+	// three kernels in a row over this many particles are batched; 
+	// separated, each one runs per particle
+	osg::ref_ptr<ParticleSystem> batchedPS = makeParticles();
+	osg::ref_ptr<ParticleSystem> separatePS = makeParticles();
+	osg::ref_ptr<TestProgram> batched = makeProgram( batchedPS.get(), false );
+	osg::ref_ptr<TestProgram> separate = makeProgram( separatePS.get(), true );
+
+	for( int frame = 0; frame < 10; frame++ )
+	{
+		batched->run( 1.0 / 60.0 );
+		separate->run( 1.0 / 60.0 );
+	}
+
+	CHECK( batchedPS->numParticles() == separatePS->numParticles() );
+	int mismatches = 0;
+	for( int i = 0; i < batchedPS->numParticles(); i++ )
+	{
+		const Particle *a = batchedPS->getParticle( i );
+		const Particle *b = separatePS->getParticle( i );
+		CHECK( a->isAlive() == b->isAlive() );
+		const osg::Vec3 &va = a->getVelocity();
+		const osg::Vec3 &vb = b->getVelocity();
+		if( !close( va.x(), vb.x() ) || !close( va.y(), vb.y() ) || 
+			!close( va.z(), vb.z() ) )
+			mismatches++;
+	}
+	CHECK( mismatches == 0 );
+
+	// and something did happen
+	const osg::Vec3 &v = batchedPS->getParticle( 0 )->getVelocity();
+	CHECK( v.z() < 0.0f );
+}
+
+
+// ================================================
+// main
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int main( int argc, char **argv )
+{
+	testBatchMatchesPerParticle();
+	return testResult();
+}
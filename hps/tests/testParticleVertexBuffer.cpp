@@ -0,0 +1,219 @@
+/** <pre>
+ *  The Multi-Purpose Viewer
+ *  Copyright (c) 2004 The Boeing Company
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ *  FILENAME:   testParticleVertexBuffer.cpp
+ *  LANGUAGE:   C++
+ *  CLASS:      UNCLASSIFIED
+ *  PROJECT:    Multi-Purpose Viewer
+ *
+ *  PROGRAM DESCRIPTION:
+ *  Checks that the vertex buffer holds the vertices that render() would
+ *  draw, for each built-in particle shape.
+ *
+ *  MODIFICATION NOTES:
+ *  DATE     NAME                                SCR NUMBER
+ *  DESCRIPTION OF CHANGE........................
+ *
+ *  2026-10-19
+ *  Initial Release.
+ * </pre>
+ *  The Boeing Company
+ *  1.0
+ */
+
+#include <math.h>
+
+#include <osg/Matrix>
+
+#include "Particle.h"
+#include "ParticleVertexBuffer.h"
+
+#include "TestCheck.h"
+
+using namespace osgParticleHPS;
+
+namespace
+{
+	const osg::Vec3 xpos( 1.0f, 2.0f, 3.0f );
+	const osg::Vec3 px( 1.0f, 0.0f, 0.0f );
+	const osg::Vec3 py( 0.0f, 1.0f, 0.0f );
+
+	//! The transform render() applies to the corners of a particle
+	osg::Matrix renderMatrix( const Particle &P )
+	{
+		const osg::Vec3 &size = P.getCurrentSize();
+		const osg::Vec3 &angle = P.getAngle();
+		return 
+			osg::Matrix::scale( size.x(), size.y(), size.z() ) * 
+			osg::Matrix::rotate( 
+				angle[0], osg::Vec3( 0, 1, 0 ), 
+				angle[1], osg::Vec3( 1, 0, 0 ), 
+				angle[2], osg::Vec3( 0, 0, 1 ) ) * 
+			osg::Matrix::translate( xpos );
+	}
+
+	bool near( const ParticleVertexBuffer::Vertex &v, const osg::Vec3 &p, 
+		float s, float t )
+	{
+		const float e = 1e-5f;
+		return fabsf( v.x - p.x() ) < e && fabsf( v.y - p.y() ) < e && 
+			fabsf( v.z - p.z() ) < e && fabsf( v.s - s ) < e && 
+			fabsf( v.t - t ) < e;
+	}
+
+	//! Sets a particle up with the given shape, partway through its life.
+	//! (Copying a particle doesn't copy its current size.)
+	void setUp( Particle &P, Particle::Shape shape, const osg::Vec3 &angle )
+	{
+		P.setShape( shape );
+		P.setSizeRange( rangev3( osg::Vec3( 1, 2, 3 ), osg::Vec3( 3, 4, 5 ) ) );
+		P.setAngle( angle );
+		P.setVelocity( osg::Vec3( 0, 0, 2 ) );
+		P.update( 0.5 );
+		P.update( 0.5 );
+	}
+}
+
+
+// ================================================
+// testQuads
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testQuads()
+{
+	// unrotated particles take a shortcut in fillVertices()
+	osg::Vec3 angles[] = { osg::Vec3( 0, 0, 0 ), osg::Vec3( 0.3f, -0.2f, 1.1f ) };
+	for( int a = 0; a < 2; a++ )
+	{
+		// render() draws the corners as a quad, counter-clockwise; the 
+		// buffer splits it into two triangles
+		Particle P;
+		setUp( P, Particle::QUAD, angles[a] );
+		osg::Matrix m = renderMatrix( P );
+		ParticleVertexBuffer buffer;
+		CHECK( P.fillVertices( buffer, xpos, px, py ) );
+		CHECK( buffer.getNumVertices( ParticleVertexBuffer::TRIANGLES ) == 6 );
+		if( buffer.getNumVertices( ParticleVertexBuffer::TRIANGLES ) != 6 )
+			continue;
+
+		const ParticleVertexBuffer::Vertex *v = buffer.getVertices( ParticleVertexBuffer::TRIANGLES );
+		CHECK( near( v[0], ( -px - py ) * m, 0, 0 ) );
+		CHECK( near( v[1], ( px - py ) * m, 1, 0 ) );
+		CHECK( near( v[2], ( px + py ) * m, 1, 1 ) );
+		CHECK( near( v[3], ( -px - py ) * m, 0, 0 ) );
+		CHECK( near( v[4], ( px + py ) * m, 1, 1 ) );
+		CHECK( near( v[5], ( -px + py ) * m, 0, 1 ) );
+
+		const osg::Vec4 &c = P.getCurrentColor();
+		CHECK( v[0].r == c.x() && v[0].g == c.y() && v[0].b == c.z() && v[0].a == c.w() );
+
+		// QUAD_OFFSET has its base at the particle's position
+		Particle Q;
+		setUp( Q, Particle::QUAD_OFFSET, angles[a] );
+		m = renderMatrix( Q );
+		buffer.clear();
+		CHECK( Q.fillVertices( buffer, xpos, px, py ) );
+		v = buffer.getVertices( ParticleVertexBuffer::TRIANGLES );
+		CHECK( v != NULL );
+		if( v == NULL )
+			continue;
+		osg::Vec3 p2 = py * 2.0;
+		CHECK( near( v[0], -px * m, 0, 0 ) );
+		CHECK( near( v[1], px * m, 1, 0 ) );
+		CHECK( near( v[2], ( px + p2 ) * m, 1, 1 ) );
+		CHECK( near( v[5], ( -px + p2 ) * m, 0, 1 ) );
+	}
+}
+
+
+// ================================================
+// testHexagon
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testHexagon()
+{
+	// render() draws a fan around the center; the buffer has one 
+	// triangle per edge, each starting at the center
+	Particle P;
+	setUp( P, Particle::HEXAGON, osg::Vec3( 0.5f, 0, 0 ) );
+	osg::Matrix m = renderMatrix( P );
+	ParticleVertexBuffer buffer;
+	CHECK( P.fillVertices( buffer, xpos, px, py ) );
+	CHECK( buffer.getNumVertices( ParticleVertexBuffer::TRIANGLES ) == 18 );
+	if( buffer.getNumVertices( ParticleVertexBuffer::TRIANGLES ) != 18 )
+		return;
+
+	const ParticleVertexBuffer::Vertex *v = buffer.getVertices( ParticleVertexBuffer::TRIANGLES );
+	for( int i = 0; i < 6; i++ )
+	{
+		CHECK( near( v[i * 3], osg::Vec3( 0, 0, 0 ) * m, 0.5f, 0.5f ) );
+		// consecutive triangles share an edge
+		if( i > 0 )
+			CHECK( near( v[i * 3 + 1], osg::Vec3( v[i * 3 - 1].x, v[i * 3 - 1].y, v[i * 3 - 1].z ), 
+				v[i * 3 - 1].s, v[i * 3 - 1].t ) );
+	}
+	// the fan's last corner is its first; the seventh corner is -px
+	CHECK( near( v[17], osg::Vec3( v[1].x, v[1].y, v[1].z ), v[1].s, v[1].t ) );
+	CHECK( near( v[7], ( -px ) * m, 0, 0.5f ) );
+	CHECK( near( v[16], px * m, 1, 0.5f ) );
+}
+
+
+// ================================================
+// testPointsAndLines
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void testPointsAndLines()
+{
+	Particle P;
+	setUp( P, Particle::POINT, osg::Vec3( 0, 0, 0 ) );
+	ParticleVertexBuffer buffer;
+	CHECK( P.fillVertices( buffer, xpos, px, py ) );
+	CHECK( buffer.getNumVertices( ParticleVertexBuffer::POINTS ) == 1 );
+	CHECK( buffer.getNumVertices( ParticleVertexBuffer::TRIANGLES ) == 0 );
+	const ParticleVertexBuffer::Vertex *v = buffer.getVertices( ParticleVertexBuffer::POINTS );
+	CHECK( v != NULL && v->x == xpos.x() && v->y == xpos.y() && v->z == xpos.z() );
+
+	// a line runs from the particle, along its velocity, for its size
+	Particle L;
+	setUp( L, Particle::LINE, osg::Vec3( 0, 0, 0 ) );
+	buffer.clear();
+	CHECK( L.fillVertices( buffer, xpos, px, py ) );
+	CHECK( buffer.getNumVertices( ParticleVertexBuffer::LINES ) == 2 );
+	v = buffer.getVertices( ParticleVertexBuffer::LINES );
+	if( v == NULL )
+		return;
+	float length = L.getCurrentSize().x();
+	CHECK( near( v[0], xpos, 0, 0 ) );
+	CHECK( near( v[1], xpos + osg::Vec3( 0, 0, length ), 1, 0 ) );
+
+	// render() draws nothing for a line that isn't moving
+	L.setVelocity( osg::Vec3( 0, 0, 0 ) );
+	buffer.clear();
+	CHECK( L.fillVertices( buffer, xpos, px, py ) );
+	CHECK( buffer.getNumVertices( ParticleVertexBuffer::LINES ) == 0 );
+}
+
+
+// ================================================
+// main
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int main( int argc, char **argv )
+{
+	testQuads();
+	testHexagon();
+	testPointsAndLines();
+	return testResult();
+}
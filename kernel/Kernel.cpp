@@ -40,6 +40,7 @@
  */
 
 #include <string>
+#include <algorithm>
 #include <stdlib.h>
 #include <string.h>
 
@@ -56,20 +57,53 @@
 // Constructor
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 Kernel::Kernel() : 
+	transport( NULL ),
+	hostTransport( NULL ),
 	bb( new Blackboard() ),
 	stateMachine( bb ),
 	OmsgPtr( NULL ),
+	outgoingStage( new mpv::CigiOutgoingStage() ),
+	outgoingReportInterval( 0.0f ),
+	timeSinceOutgoingReport( 0.0 ),
+	maxDatagramSize( -1 ),
+	outgoingFrames( 0 ),
+	outgoingBytes( 0.0 ),
+	outgoingDatagrams( 0 ),
+	outgoingMaxBytes( 0 ),
+	outgoingMaxDatagrams( 0 ),
+	incomingReportInterval( 0.0f ),
+	lastIncomingReportTime( 0.0 ),
+	incomingDecodeThreads( 0 ),
+	incomingMessages( 0 ),
+	incomingPackets( 0 ),
+	incomingMaxPackets( 0 ),
+	incomingTargets( 0 ),
+	incomingGlobalPackets( 0 ),
+	incomingParallelPackets( 0 ),
+	incomingDecodeTime( 0.0 ),
+	incomingMaxDecodeTime( 0.0 ),
 	ImsgPtr( NULL ),
 	LoadedDatabaseNumber( -128 ),
 	CommandedDatabaseNumber( 0 ),
 	ReportedDatabaseNumber( LoadedDatabaseNumber ),
 	DefaultDatabaseNumber( CommandedDatabaseNumber ),
+	transportType( "udp" ),
+	sharedMemoryName( "/mpv_cigi" ),
+	transportBufferSize( 1048576 ),
 	HostIp( "127.0.0.1" ),
 	HostSockSendTo( 8005 ),
 	LocalSockListenOn( 8004 ),
 	Hertz( 60 ),
 	busy_wait_time( 0.0f ),
 	shouldKernelSendNetMessages( true ),
+	recordOutgoing( false ),
+	replaySpeed( 1.0f ),
+	replayExitWhenDone( true ),
+	replayRecordPending( false ),
+	replayStarted( false ),
+	replayStartTime( 0.0 ),
+	replayLastFrameClock( 0.0 ),
+	replayDatagramCount( 0 ),
 	timeElapsedLastFrame( 0.0 )
 {
 #ifdef WIN32
@@ -86,9 +120,16 @@ Kernel::Kernel() :
 Kernel::~Kernel()
 {
 	// shut down the network
-	network.closeSocket();
+	delete transport;
+	delete hostTransport;
+
+	// flush the tail of the CIGI recording, if any
+	recorder.close();
 
 	delete bb;
+
+	// flush any queued log output
+	mpv::Log::instance().stopWriter();
 }
 
 
@@ -131,6 +172,9 @@ int Kernel::init( int argc, char *argv[] )
 		exit( 1 );
 	}
 
+	// command-line options override system.def
+	parseCommandLine( argc, argv );
+
 #ifdef WIN32
 	// Due to the VC7 problem
 	std::pair< int, unsigned char * > bwPair;
@@ -139,8 +183,16 @@ int Kernel::init( int argc, char *argv[] )
 	barrier.push( bwPair );
 #endif
 
-	// initialize the network class
-	initNetwork();
+	// from here on, log output is written by a background thread
+	mpv::Log::instance().startWriter();
+
+	// initialize the network class; when replaying a recording, the 
+	// network isn't used at all
+	if( replayFilename.empty() )
+		initNetwork();
+
+	// open the CIGI recording or replay file, if one was requested
+	initRecording();
 
 	// initialize the CIGI class library
 	initCCL();
@@ -164,6 +216,9 @@ int Kernel::init( int argc, char *argv[] )
 	bb->put( "TimerList", &TmrLst );
 	bb->put( "TimeElapsedLastFrame", &timeElapsedLastFrame );
 
+	// post the handoff for a render thread
+	bb->put( "FrameHandoff", &frameHandoff );
+
 	// post the sendNetMessages function to the blackboard
 //	bb->put( "SendNetMessagesCB", sendNetMessages );
 //	bb->put( "ShouldKernelSendNetMessagesBool", &shouldKernelSendNetMessages );
@@ -181,6 +236,10 @@ int Kernel::run( void )
 	// after deallocating all plugins prior to returning.
 	std::string shutdown_error_message;
 
+	// the first frame's write starts here; each later one starts when the 
+	// kernel begins receiving the Host's messages (see below)
+	frameHandoff.beginWrite();
+
 	// main loop
 	for( int i=0; !stateMachine.getShouldExit(); i++ )
 	{
@@ -209,6 +268,10 @@ int Kernel::run( void )
 			break;
 		}
 
+		// the scene is finished for this frame; a render thread, if there 
+		// is one, reads it while the kernel sends and waits
+		frameHandoff.endWrite();
+
 		// send any queued messages
 		if( shouldKernelSendNetMessages && stateMachine.getShouldSendSOF() )
 			sendNetMessages();
@@ -216,13 +279,32 @@ int Kernel::run( void )
 		// wait for some amount of time
 		delay();
 
+		// the packet processors change the scene (creating entities, 
+		// moving them, and so on), so receiving is part of the next frame's 
+		// write; this waits for the render thread to finish with the frame
+		frameHandoff.beginWrite();
+
 		// check to see if any network messages have arrived
 		getNetMessages();
 		
 		mainTimer.stop();
 		timeElapsedLastFrame = mainTimer.getElapsedTime();
+
+		// while replaying, keep the frame times for the report at the end; 
+		// frames before the first datagram (plugin loading) don't count
+		if( !replayFilename.empty() )
+		{
+			double now = mpv::cigiRecordingClock();
+			if( replayer.isOpen() && replayDatagramCount > 0 )
+				replayFrameTimes.push_back( now - replayLastFrameClock );
+			replayLastFrameClock = now;
+		}
 	}
 
+	// don't leave a render thread waiting on a frame that will never be 
+	// finished
+	frameHandoff.endWrite();
+
 	if( shutdown_error_message != "" )
 	{
 		std::cout << std::endl << shutdown_error_message << std::endl;
@@ -255,6 +337,30 @@ void Kernel::loadConfigFile( std::string filename )
 		if( group->getName() == "system" )
 		{
 			DefFileAttrib * attr;
+			attr = group->getAttribute( "transport" );
+			if( attr )
+			{
+				transportType = attr->asString();
+			}
+
+			attr = group->getAttribute( "shared_memory_name" );
+			if( attr )
+			{
+				sharedMemoryName = attr->asString();
+			}
+
+			attr = group->getAttribute( "transport_buffer_size" );
+			if( attr )
+			{
+				transportBufferSize = attr->asInt();
+			}
+
+			attr = group->getAttribute( "max_datagram_size" );
+			if( attr )
+			{
+				maxDatagramSize = attr->asInt();
+			}
+
 			attr = group->getAttribute( "host_addr" );
 			if( attr )
 			{
@@ -295,6 +401,21 @@ void Kernel::loadConfigFile( std::string filename )
 			{
 				busy_wait_time = attr->asFloat();
 			}
+			attr = group->getAttribute( "outgoing_report_interval" );
+			if( attr )
+			{
+				outgoingReportInterval = attr->asFloat();
+			}
+			attr = group->getAttribute( "incoming_report_interval" );
+			if( attr )
+			{
+				incomingReportInterval = attr->asFloat();
+			}
+			attr = group->getAttribute( "incoming_decode_threads" );
+			if( attr )
+			{
+				incomingDecodeThreads = attr->asInt();
+			}
 			attr = group->getAttribute( "default_database" );
 			if( attr )
 			{
@@ -302,6 +423,98 @@ void Kernel::loadConfigFile( std::string filename )
 				CommandedDatabaseNumber = DefaultDatabaseNumber;
 			}
 		}
+		else if( group->getName() == "log" )
+		{
+			mpv::Log &log = mpv::Log::instance();
+			DefFileAttrib * attr;
+
+			attr = group->getAttribute( "level" );
+			if( attr )
+			{
+				log.setMinimumSeverity( mpv::Log::parseSeverityName( attr->asString() ) );
+			}
+
+			// messages from a single call site beyond rate_limit_count 
+			// per rate_limit_interval seconds are counted rather than 
+			// written; a count of 0 disables rate limiting
+			int rateLimitCount = 5;
+			float rateLimitInterval = 1.0f;
+			attr = group->getAttribute( "rate_limit_count" );
+			if( attr )
+			{
+				rateLimitCount = attr->asInt();
+			}
+			attr = group->getAttribute( "rate_limit_interval" );
+			if( attr )
+			{
+				rateLimitInterval = attr->asFloat();
+			}
+			log.setRateLimit( rateLimitCount > 0 ? rateLimitCount : 0, 
+				rateLimitInterval );
+
+			attr = group->getAttribute( "destination" );
+			if( attr )
+			{
+				std::string destination = attr->asString();
+				bool success = true;
+				if( destination == "file" )
+				{
+					std::string filename = "mpv.log";
+					DefFileAttrib *fileAttr = group->getAttribute( "filename" );
+					if( fileAttr )
+						filename = fileAttr->asString();
+					success = log.setDestination( mpv::Log::File, filename );
+				}
+				else if( destination == "syslog" )
+				{
+					success = log.setDestination( mpv::Log::Syslog );
+				}
+				else
+				{
+					log.setDestination( mpv::Log::Console );
+				}
+
+				if( !success )
+				{
+					std::cerr << "Warning - could not open log destination \"" 
+						<< destination << "\"; logging to the console\n";
+				}
+			}
+		}
+		else if( group->getName() == "cigi_recording" )
+		{
+			DefFileAttrib * attr;
+
+			attr = group->getAttribute( "record_file" );
+			if( attr )
+			{
+				recordFilename = attr->asString();
+			}
+
+			attr = group->getAttribute( "record_outgoing" );
+			if( attr )
+			{
+				recordOutgoing = attr->asInt() != 0;
+			}
+
+			attr = group->getAttribute( "replay_file" );
+			if( attr )
+			{
+				replayFilename = attr->asString();
+			}
+
+			attr = group->getAttribute( "replay_speed" );
+			if( attr )
+			{
+				replaySpeed = attr->asFloat();
+			}
+
+			attr = group->getAttribute( "replay_exit_when_done" );
+			if( attr )
+			{
+				replayExitWhenDone = attr->asInt() != 0;
+			}
+		}
 		else
 		{
 			// ignore non-system groups
@@ -313,6 +526,41 @@ void Kernel::loadConfigFile( std::string filename )
 
 
 
+// ================================================
+// parseCommandLine
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void Kernel::parseCommandLine( int argc, char *argv[] )
+{
+	for( int i = 1; i < argc; i++ )
+	{
+		std::string arg = argv[i];
+		bool hasValue = ( i + 1 < argc );
+
+		if( arg == "--record" && hasValue )
+		{
+			recordFilename = argv[++i];
+		}
+		else if( arg == "--record-outgoing" )
+		{
+			recordOutgoing = true;
+		}
+		else if( arg == "--replay" && hasValue )
+		{
+			replayFilename = argv[++i];
+		}
+		else if( arg == "--replay-speed" && hasValue )
+		{
+			replaySpeed = (float)atof( argv[++i] );
+		}
+		else
+		{
+			std::cerr << "Warning - ignoring unrecognized command-line argument \"" 
+				<< arg << "\"\n";
+		}
+	}
+}
+
+
 // ================================================
 // timevaldiff
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -331,11 +579,45 @@ void Kernel::initNetwork( void )
 
 	timeDelayLimit = 1.0f / ( float ) ( Hertz );
 
-	// hostemu-ip-addr, hostemu-socket, local-socket
-	bool netstatus = network.openSocket(
-		HostIp.c_str(),
-		HostSockSendTo,
-		LocalSockListenOn );
+	bool netstatus = false;
+	if( transportType == "in_process" )
+	{
+		// the Host's end is posted to the blackboard, for a plugin to use
+		mpv::CigiTransportRing *igEnd, *hostEnd;
+		mpv::CigiTransportRing::createInProcessPair( transportBufferSize, igEnd, hostEnd );
+		transport = igEnd;
+		hostTransport = hostEnd;
+		bb->put( "CigiHostTransport", hostTransport );
+		netstatus = true;
+	}
+	else if( transportType == "shared_memory" )
+	{
+		mpv::CigiTransportRing *ring = new mpv::CigiTransportRing();
+		transport = ring;
+		netstatus = ring->openSharedMemory( sharedMemoryName, 
+			transportBufferSize, mpv::CigiTransportRing::IGSide );
+	}
+	else
+	{
+		if( transportType != "udp" )
+			MPV_LOG_WARNING( "unknown transport \"" << transportType 
+				<< "\"; using udp" );
+
+		if( maxDatagramSize < 0 )
+			maxDatagramSize = 1472;
+
+		// hostemu-ip-addr, hostemu-socket, local-socket
+		mpv::CigiTransportUDP *udp = new mpv::CigiTransportUDP();
+		transport = udp;
+		netstatus = udp->open(
+			HostIp.c_str(),
+			HostSockSendTo,
+			LocalSockListenOn );
+	}
+
+	// the memory transports have no MTU to stay under
+	if( maxDatagramSize < 0 )
+		maxDatagramSize = 0;
 
 	if( !netstatus )
 	{
@@ -344,7 +626,8 @@ void Kernel::initNetwork( void )
 	}
 	else
 	{
-		printf( "Successfully initialized network interface\n" );
+		printf( "Successfully initialized network interface (%s)\n", 
+			transportType.c_str() );
 	}
 
 }
@@ -363,6 +646,7 @@ void Kernel::initCCL( void )
 
 	bb->put( "CigiIGSession", &normalIGSession );
 	bb->put( "CigiOutgoingMsg", &Omsg );
+	bb->put( "CigiOutgoingStage", outgoingStage.get() );
 	bb->put( "CigiIncomingMsg", &Imsg );
 
 	normalIGSession.SetCigiVersion( 3, 3 );
@@ -383,6 +667,11 @@ void Kernel::initCCL( void )
 		CIGI_IG_CTRL_PACKET_ID_V3_2, 
 		(CigiBaseEventProcessor *) &igCtrlProcessor );
 
+	// plugins register the processors for packets that may be decoded in 
+	// parallel with this
+	incomingDecoder = new mpv::CigiParallelDecoder( Imsg, incomingDecodeThreads );
+	bb->put( "CigiParallelDecoder", incomingDecoder.get() );
+
 	Omsg.BeginMsg();
 
 	// add the Start Of Frame, in preparation for the next frame
@@ -396,6 +685,172 @@ void Kernel::initCCL( void )
 }
 
 
+// ================================================
+// initRecording
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void Kernel::initRecording( void )
+{
+	if( !replayFilename.empty() )
+	{
+		if( !replayer.open( replayFilename ) )
+		{
+			printf( "ERROR - could not open CIGI recording \"%s\" for replay\n", 
+				replayFilename.c_str() );
+			exit( 1 );
+		}
+
+		// as-fast-as-possible replay ignores the frame-rate cap
+		if( replaySpeed > 0.0f )
+			timeDelayLimit = 1.0f / ( float ) ( Hertz );
+		else
+			timeDelayLimit = 0.0f;
+
+		if( replaySpeed > 0.0f )
+			printf( "Replaying CIGI recording \"%s\" at %gx speed\n", 
+				replayFilename.c_str(), replaySpeed );
+		else
+			printf( "Replaying CIGI recording \"%s\" as fast as possible\n", 
+				replayFilename.c_str() );
+
+		// a replay is never re-recorded
+		recordFilename.clear();
+	}
+
+	if( !recordFilename.empty() )
+	{
+		if( recorder.open( recordFilename ) )
+		{
+			printf( "Recording CIGI traffic to \"%s\"\n", recordFilename.c_str() );
+		}
+		else
+		{
+			MPV_LOG_WARNING( "could not open \"" << recordFilename 
+				<< "\" for CIGI recording; traffic will not be recorded" );
+		}
+	}
+}
+
+
+// ================================================
+// receiveDatagram
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int Kernel::receiveDatagram( unsigned char *buffer, int bufferSize )
+{
+	if( !replayFilename.empty() )
+		return replayDatagram( buffer, bufferSize );
+
+	int length = transport->recv( buffer, bufferSize );
+	if( length > 0 )
+		recorder.write( mpv::CigiRecord::Incoming, buffer, length );
+	return length;
+}
+
+
+// ================================================
+// replayDatagram
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int Kernel::replayDatagram( unsigned char *buffer, int bufferSize )
+{
+	if( !replayer.isOpen() )
+		return 0;
+
+	double now = mpv::cigiRecordingClock();
+	if( !replayStarted )
+	{
+		replayStarted = true;
+		replayStartTime = now;
+	}
+
+	while( true )
+	{
+		if( !replayRecordPending )
+		{
+			if( !replayer.read( replayRecord ) )
+			{
+				finishReplay();
+				return 0;
+			}
+			replayRecordPending = true;
+		}
+
+		if( replayRecord.type == mpv::CigiRecord::FrameEnd )
+		{
+			replayRecordPending = false;
+			// when running as fast as possible, each recorded frame's 
+			// datagrams are delivered in one IG frame
+			if( replaySpeed <= 0.0f )
+				return 0;
+			continue;
+		}
+
+		if( replayRecord.type != mpv::CigiRecord::Incoming )
+		{
+			// outgoing traffic is in the recording for reference only
+			replayRecordPending = false;
+			continue;
+		}
+
+		if( replaySpeed > 0.0f && 
+			replayRecord.time > ( now - replayStartTime ) * replaySpeed )
+		{
+			// not due yet
+			return 0;
+		}
+
+		replayRecordPending = false;
+
+		int length = (int)replayRecord.data.size();
+		if( length == 0 )
+			continue;
+		if( length > bufferSize )
+		{
+			MPV_LOG_WARNING( "skipping a recorded " << length 
+				<< " byte datagram; the receive buffer holds " << bufferSize );
+			continue;
+		}
+
+		memcpy( buffer, &replayRecord.data[0], length );
+		replayDatagramCount++;
+		return length;
+	}
+}
+
+
+// ================================================
+// finishReplay
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void Kernel::finishReplay( void )
+{
+	replayer.close();
+
+	double wallTime = mpv::cigiRecordingClock() - replayStartTime;
+	std::cout << "CIGI replay of \"" << replayFilename << "\" finished: " 
+		<< replayDatagramCount << " datagrams, " 
+		<< replayFrameTimes.size() << " frames in " << wallTime << " s\n";
+
+	if( !replayFrameTimes.empty() )
+	{
+		std::vector<double> sorted( replayFrameTimes );
+		std::sort( sorted.begin(), sorted.end() );
+
+		double sum = 0.0;
+		for( unsigned int i = 0; i < sorted.size(); i++ )
+			sum += sorted[i];
+
+		unsigned int last = sorted.size() - 1;
+		std::cout << "Frame time (ms): mean " << 1000.0 * sum / sorted.size() 
+			<< ", min " << 1000.0 * sorted[0] 
+			<< ", median " << 1000.0 * sorted[last / 2] 
+			<< ", 95th " << 1000.0 * sorted[( last * 95 ) / 100] 
+			<< ", 99th " << 1000.0 * sorted[( last * 99 ) / 100] 
+			<< ", max " << 1000.0 * sorted[last] << std::endl;
+	}
+
+	if( replayExitWhenDone )
+		stateMachine.requestQuit();
+}
+
+
 #ifdef NO_INTERNAL_QUEUING 
 // ================================================
 // getNetMessages
@@ -403,11 +858,12 @@ void Kernel::initCCL( void )
 void Kernel::getNetMessages( void )
 {
 
-	recvLen = network.recv( recvBuffer, RECV_BUFFER_SIZE );
+	recvLen = receiveDatagram( recvBuffer, RECV_BUFFER_SIZE );
 	if( recvLen > 0 )
 	{
 		processCigiMessage( recvBuffer, recvLen );
 	}
+	recorder.write( mpv::CigiRecord::FrameEnd, NULL, 0 );
 	//else{ fprintf( stderr, "!!!recvd no packets this time 'round!!!\n" ); }
 }
 #else 
@@ -419,11 +875,27 @@ void Kernel::getNetMessages( void )
 
 	unsigned char * tempBuffer = NULL;
 
+	// memory transports hand over messages in place; there is no network 
+	// jitter to smooth out, so they are processed as they are read
+	if( transport != NULL && transport->canPeek() )
+	{
+		int length;
+		const unsigned char *message;
+		while( ( message = transport->peek( length ) ) != NULL )
+		{
+			recorder.write( mpv::CigiRecord::Incoming, message, length );
+			processCigiMessage( const_cast<unsigned char *>( message ), length );
+			transport->release();
+		}
+		recorder.write( mpv::CigiRecord::FrameEnd, NULL, 0 );
+		return;
+	}
+
 	// first, pull all of the available messages out of the UDP buffer
 	// and put them into our queue
 	do
 	{
-		recvLen = network.recv( recvBuffer, RECV_BUFFER_SIZE );
+		recvLen = receiveDatagram( recvBuffer, RECV_BUFFER_SIZE );
 		if( recvLen > 0 )
 		{
 			std::pair< int, unsigned char * > newPair;
@@ -437,6 +909,10 @@ void Kernel::getNetMessages( void )
 	}
 	while( recvLen > 0 );
 
+	// everything received before this point arrived during the frame 
+	// that just finished
+	recorder.write( mpv::CigiRecord::FrameEnd, NULL, 0 );
+
 	unsigned int messagesWaiting = cigiMessageQueue.size();
 	unsigned int messagesToLeaveInQueue;
 	if( messagesWaiting > 1 )
@@ -476,6 +952,27 @@ void Kernel::getNetMessages( void )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void Kernel::processCigiMessage( unsigned char *message, int messageLength )
 {
+	// the decode time includes the scan
+	double decodeStart = 0.0;
+	if( incomingReportInterval > 0.0f )
+		decodeStart = mpv::cigiRecordingClock();
+
+	// the parallel decoder needs the scan too
+	bool parallel = incomingDecoder->getNumThreads() > 0 && 
+		!stateMachine.getShouldIgnoreNonIGCtrl();
+	if( parallel || incomingReportInterval > 0.0f )
+		incomingPartitioner.scan( message, messageLength );
+
+	if( incomingReportInterval > 0.0f )
+	{
+		int packets = incomingPartitioner.getPacketCount();
+		incomingPackets += packets;
+		if( packets > incomingMaxPackets )
+			incomingMaxPackets = packets;
+		incomingTargets += incomingPartitioner.getPartitionCount();
+		incomingGlobalPackets += (int)incomingPartitioner.getGlobalPackets().size();
+	}
+
 	try
 	{
 		/*
@@ -492,18 +989,39 @@ void Kernel::processCigiMessage( unsigned char *message, int messageLength )
 		*/
 		if( stateMachine.getShouldIgnoreNonIGCtrl() )
 			internalIGSession.GetIncomingMsgMgr().ProcessIncomingMsg( message, messageLength );
+		else if( parallel )
+			incomingParallelPackets += 
+				incomingDecoder->apply( incomingPartitioner, message, messageLength );
 		else
 			ImsgPtr->ProcessIncomingMsg( message, messageLength );
 	}
 	catch( CigiMissingIgControlException &theException )
 	{
-		std::cout << "Warning in processCigiMessage - first packet in CIGI " 
-			<< "message from the host \n\twas not an IGCtrl\n";
+		MPV_LOG_WARNING( "in processCigiMessage - first packet in CIGI " 
+			<< "message from the host was not an IGCtrl" );
 	}
 	catch( CigiException &theException )
 	{
-		std::cout << "processCigiMessage - Exception: " 
-			<< theException.what() << std::endl;
+		MPV_LOG_ERROR( "processCigiMessage - Exception: " 
+			<< theException.what() );
+	}
+
+	if( incomingReportInterval > 0.0f )
+	{
+		double now = mpv::cigiRecordingClock();
+		double decodeTime = now - decodeStart;
+		incomingMessages++;
+		incomingDecodeTime += decodeTime;
+		if( decodeTime > incomingMaxDecodeTime )
+			incomingMaxDecodeTime = decodeTime;
+
+		if( lastIncomingReportTime == 0.0 )
+			lastIncomingReportTime = now;
+		else if( now - lastIncomingReportTime >= incomingReportInterval )
+		{
+			reportIncoming();
+			lastIncomingReportTime = now;
+		}
 	}
 }
 
@@ -516,18 +1034,58 @@ void Kernel::sendNetMessages( void )
 	unsigned char * sendBuffer = NULL;
 	int sendLen = 0;
 
+	// packets staged by other threads go after the ones written directly
+	outgoingStage->merge( *OmsgPtr );
+
 	// time to bundle up all of the stored packets and
-	// send them off
+	// send them off, in datagrams no bigger than maxDatagramSize
 	OmsgPtr->LockMsg();
 	OmsgPtr->UpdateFrameCntr();
 	sendBuffer = OmsgPtr->GetMsg( sendLen );
-	int sentBytes =
-	    network.send( sendBuffer, sendLen );
+	int datagramCount = outgoingSplitter.split( sendBuffer, sendLen, maxDatagramSize );
+	const unsigned char * const *datagrams = outgoingSplitter.getPieces();
+	const int *datagramLengths = outgoingSplitter.getLengths();
+	int sentDatagrams = 0;
+	if( replayFilename.empty() && datagramCount > 0 )
+	{
+		if( datagramCount == 1 )
+			sentDatagrams = transport->send( datagrams[0], datagramLengths[0] ) < 0 ? 0 : 1;
+		else
+			sentDatagrams = transport->sendMany( datagrams, datagramLengths, datagramCount );
+		if( sentDatagrams < datagramCount )
+			MPV_LOG_WARNING( "sendNetMessages - sent " << ( sentDatagrams < 0 ? 0 : sentDatagrams ) 
+				<< " of " << datagramCount << " datagrams to the host" );
+	}
+
+	int frameBytes = 0;
+	for( int i = 0; i < datagramCount; i++ )
+	{
+		frameBytes += datagramLengths[i];
+		if( recordOutgoing )
+			recorder.write( mpv::CigiRecord::Outgoing, datagrams[i], datagramLengths[i] );
+	}
 	OmsgPtr->UnlockMsg();
+
+	outgoingFrames++;
+	outgoingBytes += frameBytes;
+	outgoingDatagrams += datagramCount;
+	if( frameBytes > outgoingMaxBytes )
+		outgoingMaxBytes = frameBytes;
+	if( datagramCount > outgoingMaxDatagrams )
+		outgoingMaxDatagrams = datagramCount;
+	if( outgoingReportInterval > 0.0f )
+	{
+		timeSinceOutgoingReport += timeElapsedLastFrame;
+		if( timeSinceOutgoingReport >= outgoingReportInterval )
+		{
+			reportOutgoing();
+			timeSinceOutgoingReport = 0.0;
+		}
+	}
 //	OmsgPtr->BeginMsg();
 
 	/*
-	printf( "sent %i bytes\n", sentBytes);
+	printf( "sent %i bytes\n", frameBytes);
 	printf( "Sending a SOF\n" );
 	*/
 
@@ -541,6 +1099,56 @@ void Kernel::sendNetMessages( void )
 }
 
 
+// ================================================
+// reportOutgoing
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void Kernel::reportOutgoing( void )
+{
+	if( outgoingFrames > 0 )
+	{
+		MPV_LOG_INFO( "sent to host, per frame: " 
+			<< (int)( outgoingBytes / outgoingFrames ) << " bytes in " 
+			<< (float)outgoingDatagrams / outgoingFrames << " datagrams on average; at most " 
+			<< outgoingMaxBytes << " bytes in " << outgoingMaxDatagrams << " datagrams" );
+	}
+	outgoingFrames = 0;
+	outgoingBytes = 0.0;
+	outgoingDatagrams = 0;
+	outgoingMaxBytes = 0;
+	outgoingMaxDatagrams = 0;
+
+	outgoingStage->report();
+}
+
+
+// ================================================
+// reportIncoming
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void Kernel::reportIncoming( void )
+{
+	if( incomingMessages > 0 )
+	{
+		MPV_LOG_INFO( "received from host: " << incomingMessages 
+			<< " messages, decoded in " 
+			<< incomingDecodeTime * 1000.0 / incomingMessages << " ms on average (at most " 
+			<< incomingMaxDecodeTime * 1000.0 << " ms); per message, " 
+			<< (float)incomingPackets / incomingMessages << " packets (at most " 
+			<< incomingMaxPackets << "), " 
+			<< (float)incomingGlobalPackets / incomingMessages << " of them global, for " 
+			<< (float)incomingTargets / incomingMessages << " entities and symbols, and " 
+			<< (float)incomingParallelPackets / incomingMessages << " decoded in parallel" );
+	}
+	incomingMessages = 0;
+	incomingPackets = 0;
+	incomingMaxPackets = 0;
+	incomingTargets = 0;
+	incomingGlobalPackets = 0;
+	incomingParallelPackets = 0;
+	incomingDecodeTime = 0.0;
+	incomingMaxDecodeTime = 0.0;
+}
+
+
 // ================================================
 // delay
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
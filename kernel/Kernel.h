@@ -43,6 +43,7 @@
 #include <stdio.h>
 #include <iostream>
 #include <list>
+#include <vector>
 #include <queue>
 #include <utility>
 #include <cassert>
@@ -67,6 +68,15 @@
 #include "GenerateID.h"
 #include "SimpleTimer.h"
 #include "MPVTimer.h"
+#include "Log.h"
+#include "CigiRecording.h"
+#include "FrameHandoff.h"
+#include "CigiOutgoingStage.h"
+#include "CigiMessageSplitter.h"
+#include "CigiMessagePartitioner.h"
+#include "CigiParallelDecoder.h"
+#include "CigiTransportUDP.h"
+#include "CigiTransportRing.h"
 
 #define RECV_BUFFER_SIZE 65536
 
@@ -81,7 +91,16 @@ public:
 	
 private:
 	
-	Network network;
+	//=========================================================
+	//! The channel to the Host.  UDP by default; see initNetwork().
+	//!
+	mpv::CigiTransport *transport;
+
+	//=========================================================
+	//! The Host's end of an in-process transport, or NULL.  Posted to 
+	//! the blackboard, so that a plugin can play the part of the Host.
+	//!
+	mpv::CigiTransport *hostTransport;
 
 	#ifdef WIN32 
 	// VC7 seems to have a problem between our network class and the queue class that results in some overlap.
@@ -135,6 +154,70 @@ private:
 	//! 
 	CigiOutgoingMsg *OmsgPtr;
 	
+	//=========================================================
+	//! Packets staged by threads other than the kernel's.  Merged into 
+	//! the outgoing message just before it is sent.  Posted to the 
+	//! blackboard.
+	//! 
+	mpv::RefPtr<mpv::CigiOutgoingStage> outgoingStage;
+	
+	//=========================================================
+	//! How often, in seconds, the traffic to the Host and the outgoing 
+	//! stage's statistics are logged; 0 or less turns the report off.
+	//! 
+	float outgoingReportInterval;
+	double timeSinceOutgoingReport;
+	
+	//=========================================================
+	//! The largest datagram sent to the Host; bigger messages are split 
+	//! into several, each starting with the Start of Frame.  0 or less 
+	//! means no limit.  Defaults to 1472 (an Ethernet frame, less the IP 
+	//! and UDP headers) for the udp transport, and no limit otherwise.
+	//! 
+	int maxDatagramSize;
+	mpv::CigiMessageSplitter outgoingSplitter;
+	
+	//=========================================================
+	//! Traffic to the Host since the last outgoing report
+	//! 
+	int outgoingFrames;
+	double outgoingBytes;
+	int outgoingDatagrams;
+	int outgoingMaxBytes;
+	int outgoingMaxDatagrams;
+
+	//=========================================================
+	//! How often, in seconds, the time taken to decode messages from the 
+	//! Host is logged, along with how the messages' packets divide up by 
+	//! target (see mpv::CigiMessagePartitioner); 0 or less turns the 
+	//! report off.
+	//! 
+	float incomingReportInterval;
+	double lastIncomingReportTime;
+	mpv::CigiMessagePartitioner incomingPartitioner;
+
+	//=========================================================
+	//! The number of extra threads that decode the packets from the 
+	//! Host, and the decoder that runs them (see mpv::CigiParallelDecoder).  
+	//! Packets are always applied by the kernel thread.  With 0 threads, 
+	//! it decodes them too, and messages are only scanned for the 
+	//! incoming report.  The decoder is posted to the blackboard.
+	//! 
+	int incomingDecodeThreads;
+	mpv::RefPtr<mpv::CigiParallelDecoder> incomingDecoder;
+	
+	//=========================================================
+	//! Messages from the Host since the last incoming report
+	//! 
+	int incomingMessages;
+	int incomingPackets;
+	int incomingMaxPackets;
+	int incomingTargets;
+	int incomingGlobalPackets;
+	int incomingParallelPackets;
+	double incomingDecodeTime;
+	double incomingMaxDecodeTime;
+	
 	//=========================================================
 	//! Incoming message handler.  Plugins can register packet handlers with 
 	//! this object.  Packets received from the Host will be propagated 
@@ -193,6 +276,9 @@ private:
 	//!
 	int DefaultDatabaseNumber;
 
+	std::string transportType;
+	std::string sharedMemoryName;
+	int transportBufferSize;
 	std::string HostIp;
 	int HostSockSendTo;
 	int LocalSockListenOn;
@@ -200,9 +286,48 @@ private:
 	float busy_wait_time;
 
 	bool shouldKernelSendNetMessages;
+
+	//=========================================================
+	//! CIGI recording.  When recordFilename is set, every datagram 
+	//! received from the Host (and, if recordOutgoing is set, every 
+	//! message sent to it) is appended to the file, along with a marker 
+	//! at the end of each frame.
+	//!
+	std::string recordFilename;
+	bool recordOutgoing;
+	mpv::CigiRecordWriter recorder;
+
+	//=========================================================
+	//! CIGI replay.  When replayFilename is set, the network is not 
+	//! opened; incoming datagrams are read from the recording instead.  
+	//! replaySpeed scales the recorded timestamps (1.0 is real time); 
+	//! a speed of 0 or less replays one recorded frame per IG frame, as 
+	//! fast as the IG can go.  Frame times are reported when the recording 
+	//! runs out.
+	//!
+	std::string replayFilename;
+	float replaySpeed;
+	bool replayExitWhenDone;
+	mpv::CigiRecordReader replayer;
+	mpv::CigiRecord replayRecord;
+	bool replayRecordPending;
+	bool replayStarted;
+	double replayStartTime;
+	double replayLastFrameClock;
+	int replayDatagramCount;
+	std::vector<double> replayFrameTimes;
 	
 	SimpleTimer mainTimer;
 	
+	//=========================================================
+	//! Lets a thread outside the kernel (ie a render thread) read the 
+	//! scene between frames.  Everything that changes the scene, from 
+	//! receiving the Host's messages through the plugins' act(), happens 
+	//! between beginWrite() and endWrite(); the reader gets its turn 
+	//! while the kernel sends and waits.  Posted to the blackboard.
+	//!
+	mpv::FrameHandoff frameHandoff;
+	
 	std::list<MPVTimer *> TmrLst;
 	double timeElapsedLastFrame;
 	GenerateID GenID;
@@ -211,9 +336,26 @@ private:
 	std::string pathSeparator;
 	
 	void loadConfigFile( std::string filename );
+
+	//=========================================================
+	//! Logs the traffic to the Host, per frame, and the outgoing stage's 
+	//! statistics, and resets them
+	//! 
+	void reportOutgoing();
+
+	//=========================================================
+	//! Logs the decode time and partitioning of messages from the Host, 
+	//! and resets them
+	//! 
+	void reportIncoming();
 	float timevaldiff( struct timeval *t1, struct timeval *t2 );
 	void initNetwork( void );
 	void initCCL( void );
+	void parseCommandLine( int argc, char *argv[] );
+	void initRecording( void );
+	int receiveDatagram( unsigned char *buffer, int bufferSize );
+	int replayDatagram( unsigned char *buffer, int bufferSize );
+	void finishReplay( void );
 	void getNetMessages( void );
 	void processCigiMessage( unsigned char *message, int messageLength );
 	void sendNetMessages( void );
@@ -507,6 +507,11 @@ void StateMachine::setIGMode( CigiBaseIGCtrl::IGModeGrp mode )
 	context.commandedIGMode = mode;
 }
 
+void StateMachine::requestQuit()
+{
+	context.userRequestedQuit = true;
+}
+
 CigiBaseSOF::IGModeGrp StateMachine::getIGMode() const
 {
 	if( currentState == NULL )
@@ -39,6 +39,10 @@ public:
 	//! Called by the kernel, to indicate which mode the Host has commanded.
 	void setIGMode( CigiBaseIGCtrl::IGModeGrp );
 	
+	//! Called by the kernel to shut down the MPV, as though the user 
+	//! had asked to quit.
+	void requestQuit();
+	
 	//! Called by the kernel, so that the kernel knows what value to put 
 	//! in Start-Of-Frame packets.
 	CigiBaseSOF::IGModeGrp getIGMode() const;
@@ -20,13 +20,18 @@
  *  2008-11-14 Andrew Sampson
  *      Initial release
  *  
+ *  2026-10-19
+ *      Entities added again (reused from the entity pool) are connected 
+ *      only once.
+ *  
+ *  2026-10-19
+ *      Removed the debug print for every animation stop.
+ *  
  *  
  *  </pre>
  */
 
 
-#include <iostream>
-
 #include <CigiAnimationStopV3.h>
 
 #include "BindSlot.h"
@@ -67,10 +72,12 @@ void AnimStopNotificationListener::entityAdded( EntityContainer *, Entity *entit
 {
 	if( entity != NULL )
 	{
-		entity->animationFinished.connect( BIND_SLOT1( AnimStopNotificationListener::animationStoppedPlaying, this ) );
 		// don't need to worry about disconnecting... we want to recv 
 		// animationFinished events for the entire lifetime of the 
-		// entity object
+		// entity object.  Entities reused from the pool are added again, 
+		// though, and must not end up connected twice.
+		entity->animationFinished.disconnect( BIND_SLOT1( AnimStopNotificationListener::animationStoppedPlaying, this ) );
+		entity->animationFinished.connect( BIND_SLOT1( AnimStopNotificationListener::animationStoppedPlaying, this ) );
 	}
 }
 
@@ -80,7 +87,6 @@ void AnimStopNotificationListener::animationStoppedPlaying( Entity *entity )
 	CigiAnimationStopV3 animStop;
 	animStop.SetEntityID( entity->getID() );
 	(*outgoing) << animStop;
-std::cout << "ANIMATION STOP EVENT!  Entity " << entity->getID() << std::endl;
 }
 
 
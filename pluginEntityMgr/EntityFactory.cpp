@@ -23,6 +23,16 @@
  *  2008-12-07 Andrew Sampson
  *      Removed EntityDefinition, reworked class.
  *  
+ *  2026-10-19
+ *      The type name is looked up once per type, in init().
+ *  
+ *  2026-10-19
+ *      Reads each type's pool_size.
+ *  
+ *  2026-10-19
+ *      The note about entities using the default configuration goes 
+ *      through the rate-limited log.
+ *  
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -30,9 +40,11 @@
 
 
 #include <iostream>
+#include <algorithm>
 
 #include "EntityFactory.h"
 #include "MPVExceptions.h"
+#include "Log.h"
 
 using namespace mpv;
 
@@ -84,13 +96,13 @@ void EntityFactory::init( DefFileGroup *root )
 			// "catch-all" typeID of -1 (which is not a valid CIGI type id)
 			if( attr->asString() == "default" )
 			{
-				typeIDToDefinitionMap[-1] = group;
+				addTypeDefinition( -1, group );
 			}
 			else
 			{
 				int typeID = attr->asInt();
 				if( typeID >= 0 && typeID < 65536 )
-					typeIDToDefinitionMap[typeID] = group;
+					addTypeDefinition( typeID, group );
 				else
 					std::cout << "Warning - In the entity config file: entity type ID " 
 						<< typeID << " is outside the valid range of type IDs."
@@ -109,6 +121,24 @@ void EntityFactory::init( DefFileGroup *root )
 }
 
 
+// ================================================
+// addTypeDefinition
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EntityFactory::addTypeDefinition( int typeID, DefFileGroup *group )
+{
+	TypeDefinition &definition = typeIDToDefinitionMap[typeID];
+	definition.configGroup = group;
+	
+	// retrieve the type name
+	DefFileAttrib *attr = group->getAttribute( "name" );
+	definition.hasName = ( attr != NULL );
+	definition.name = attr ? attr->asString() : std::string();
+	
+	attr = group->getAttribute( "pool_size" );
+	definition.poolSize = attr ? std::max( 0, attr->asInt() ) : 0;
+}
+
+
 // ================================================
 // createEntity
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -118,9 +148,13 @@ Entity * EntityFactory::createEntity( int id, int typeID )
 	result->setID( id );
 	result->setType( typeID );
 	
-	DefFileGroup *configGroup = typeIDToDefinitionMap[typeID];
+	const TypeDefinition *definition = NULL;
+	std::map< int, TypeDefinition >::const_iterator iter = 
+		typeIDToDefinitionMap.find( typeID );
+	if( iter != typeIDToDefinitionMap.end() )
+		definition = &iter->second;
 
-	if( configGroup == NULL && typeID != 0 )
+	if( definition == NULL && typeID != 0 )
 	{
 		/* 
 		If:
@@ -130,26 +164,24 @@ Entity * EntityFactory::createEntity( int id, int typeID )
 		then this entity will use the catchall entity configuration.
 		*/
 		
-		DefFileGroup *catchAll = typeIDToDefinitionMap[-1];
-		if( catchAll )
+		iter = typeIDToDefinitionMap.find( -1 );
+		if( iter != typeIDToDefinitionMap.end() )
 		{
-			std::cout << "Note - New entity " << id 
+			MPV_LOG_NOTICE( "New entity " << id 
 				<< " uses type ID " << typeID 
-				<< ", which is not specified in the config files.\n"
-				<< "\tUsing the default entity configuration instead." << std::endl;
-			configGroup = catchAll;
+				<< ", which is not specified in the config files; "
+				<< "using the default entity configuration instead" );
+			definition = &iter->second;
 		}
 	}
 	
-	if( configGroup )
+	if( definition )
 	{
-		result->setConfig( configGroup );
+		result->setConfig( definition->configGroup );
 		
-		// retrieve the type name
-		DefFileAttrib *attr = configGroup->getAttribute( "name" );
-		if( attr )
+		if( definition->hasName )
 		{
-			result->setName( attr->asString() );
+			result->setName( definition->name );
 		}
 	}
 
@@ -157,3 +189,19 @@ Entity * EntityFactory::createEntity( int id, int typeID )
 }
 
 
+// ================================================
+// getPoolSize
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int EntityFactory::getPoolSize( int typeID ) const
+{
+	std::map< int, TypeDefinition >::const_iterator iter = 
+		typeIDToDefinitionMap.find( typeID );
+	if( iter == typeIDToDefinitionMap.end() && typeID != 0 )
+		iter = typeIDToDefinitionMap.find( -1 );
+	
+	if( iter == typeIDToDefinitionMap.end() )
+		return 0;
+	return iter->second.poolSize;
+}
+
+
@@ -23,6 +23,12 @@
  *  2008-12-07 Andrew Sampson
  *      Removed EntityDefinition, reworked class.
  *  
+ *  2026-10-19
+ *      The type name is looked up once per type, in init().
+ *  
+ *  2026-10-19
+ *      Reads each type's pool_size.
+ *  
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -66,13 +72,41 @@ public:
 	//!
 	mpv::Entity *createEntity( int id, int type );
 	
+	//=========================================================
+	//! Returns the number of removed entities of the given type that 
+	//! should be kept for reuse, as given by the pool_size attribute in 
+	//! the type's config data.  Types without explicit configuration use 
+	//! the catch-all configuration, like createEntity() does.
+	//! \param type - the entity type ID
+	//! \return the pool size, or 0 if entities of this type aren't pooled
+	//!
+	int getPoolSize( int type ) const;
+	
 private:
 	
+	//=========================================================
+	//! An entity type's config data, and the name given there
+	//! 
+	struct TypeDefinition
+	{
+		TypeDefinition() : configGroup( NULL ), hasName( false ), poolSize( 0 ) {}
+		
+		DefFileGroup *configGroup;
+		bool hasName;
+		std::string name;
+		int poolSize;
+	};
+	
 	//=========================================================
 	//! A map used to speed up the entity creation process.
 	//! Maps typeIDs to config data groups.
 	//! 
-	std::map< int, DefFileGroup * > typeIDToDefinitionMap;
+	std::map< int, TypeDefinition > typeIDToDefinitionMap;
+	
+	//=========================================================
+	//! Stores a type definition for the given config group
+	//! 
+	void addTypeDefinition( int typeID, DefFileGroup *group );
 	
 };
 
@@ -0,0 +1,326 @@
+/** <pre>
+ *  MPV entity manager plugin
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ *
+ *  </pre>
+ */
+
+
+#include <set>
+
+#include "BindSlot.h"
+#include "CoordSet.h"
+#include "Log.h"
+
+#include "EntityPool.h"
+
+
+using namespace mpv;
+
+// ================================================
+// EntityPool
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EntityPool::EntityPool( EntityContainer *_entities,
+	const EntityFactory *_factory ) :
+	Referenced(),
+	entities( _entities ),
+	factory( _factory )
+{
+	entities->removedEntity.connect( BIND_SLOT2( EntityPool::entityRemoved, this ) );
+}
+
+
+// ================================================
+// ~EntityPool
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EntityPool::~EntityPool()
+{
+	entities->removedEntity.disconnect( BIND_SLOT2( EntityPool::entityRemoved, this ) );
+}
+
+
+// ================================================
+// getPool
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EntityPool::TypePool *EntityPool::getPool( int type )
+{
+	std::map< int, TypePool >::iterator iter = pools.find( type );
+	if( iter == pools.end() )
+	{
+		// first entity of this type; the factory knows whether it's pooled
+		TypePool &pool = pools[type];
+		pool.maxSize = factory->getPoolSize( type );
+		return pool.maxSize > 0 ? &pool : NULL;
+	}
+	return iter->second.maxSize > 0 ? &iter->second : NULL;
+}
+
+
+// ================================================
+// acquire
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+RefPtr<Entity> EntityPool::acquire( int id, int type )
+{
+	parkRemovedEntities();
+
+	TypePool *pool = getPool( type );
+	if( pool == NULL )
+		return NULL;
+
+	if( pool->entities.empty() )
+	{
+		pool->misses++;
+		return NULL;
+	}
+	pool->hits++;
+
+	RefPtr<Entity> entity = pool->entities.back();
+	pool->entities.pop_back();
+
+	entity->setID( id );
+	entity->setState( Entity::Standby );
+	entity->setFullControlPacketRecvd( false );
+
+	// the entity's parts carry its ID
+	ArticulationContainer::ArticulationIteratorPair artIters =
+		entity->getArticulations();
+	for( ; artIters.first != artIters.second; artIters.first++ )
+		artIters.first->second->setEntityID( id );
+
+	ComponentContainer::ComponentIteratorPair compIters =
+		entity->getComponents();
+	for( ; compIters.first != compIters.second; compIters.first++ )
+		compIters.first->second->setInstanceID( id );
+
+	return entity;
+}
+
+
+// ================================================
+// entityAdded
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EntityPool::entityAdded( Entity *entity )
+{
+	if( entity == NULL || defaults.find( entity ) != defaults.end() )
+		return;
+
+	if( getPool( entity->getType() ) == NULL )
+		return;
+
+	EntityDefaults &entityDefaults = defaults[entity];
+
+	ArticulationContainer::ArticulationIteratorPair artIters =
+		entity->getArticulations();
+	for( ; artIters.first != artIters.second; artIters.first++ )
+	{
+		Articulation *articulation = artIters.first->second.get();
+		ArticulationDefaults art;
+		art.articulation = articulation;
+		art.enabled = articulation->getEnabled();
+		art.offset = articulation->getOffset();
+		art.rotation = articulation->getRotation();
+		art.offsetVelocity = articulation->getOffsetVelocity();
+		art.rotationVelocity = articulation->getRotationVelocity();
+		entityDefaults.articulations.push_back( art );
+	}
+
+	ComponentContainer::ComponentIteratorPair compIters =
+		entity->getComponents();
+	for( ; compIters.first != compIters.second; compIters.first++ )
+	{
+		ComponentDefaults comp;
+		comp.component = compIters.first->second;
+		comp.state = comp.component->getState();
+		entityDefaults.components.push_back( comp );
+	}
+
+	AnimationContainer::AnimationIteratorPair animIters =
+		entity->getAnimations();
+	for( ; animIters.first != animIters.second; animIters.first++ )
+	{
+		AnimationDefaults anim;
+		anim.animation = animIters.first->second;
+		anim.direction = anim.animation->getDirection();
+		anim.loopMode = anim.animation->getLoopMode();
+		anim.state = anim.animation->getState();
+		entityDefaults.animations.push_back( anim );
+	}
+}
+
+
+// ================================================
+// entityRemoved
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EntityPool::entityRemoved( EntityContainer *, Entity *entity )
+{
+	if( entity == NULL || defaults.find( entity ) == defaults.end() )
+		return;
+
+	// The parent may be destroyed before the entity is parked, so the
+	// entity lets go of it now.  The entity's children have already been
+	// removed, by Entity::setState().
+	if( entity->getIsChild() )
+		entity->setParent( false, 0xffff, NULL );
+
+	removed.push_back( entity );
+}
+
+
+// ================================================
+// parkRemovedEntities
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EntityPool::parkRemovedEntities()
+{
+	if( removed.empty() )
+		return;
+
+	std::vector< RefPtr<Entity> >::iterator iter;
+	for( iter = removed.begin(); iter != removed.end(); iter++ )
+	{
+		Entity *entity = iter->get();
+
+		TypePool *pool = getPool( entity->getType() );
+		if( pool == NULL || (int)pool->entities.size() >= pool->maxSize )
+		{
+			if( pool != NULL )
+				pool->discards++;
+			defaults.erase( entity );
+			continue;
+		}
+
+		resetEntity( entity );
+		pool->entities.push_back( entity );
+	}
+	removed.clear();
+}
+
+
+// ================================================
+// resetEntity
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EntityPool::resetEntity( Entity *entity )
+{
+	EntityDefaults &entityDefaults = defaults[entity];
+
+	// symbol surfaces attached to the entity go away with it
+	entity->flagAllSurfacesAsDestroyed();
+
+	entity->setAlpha( 255 );
+	entity->setInheritAlpha( false );
+	entity->setCollisionDetectionEnabled( false );
+	entity->setGroundClampState( Entity::NoClamp );
+	entity->setPositionGDC( CoordinateSet() );
+	entity->setPositionDB( CoordinateSet() );
+
+	// Parts created for the entity after it was first created (by
+	// articulation or component packets for parts that weren't in its
+	// definition) are removed; the rest are put back as they were.
+	std::vector<ArticulationDefaults>::iterator artIter;
+	std::set< Articulation * > keepArticulations;
+	for( artIter = entityDefaults.articulations.begin();
+		artIter != entityDefaults.articulations.end(); artIter++ )
+	{
+		Articulation *articulation = artIter->articulation.get();
+		articulation->setEnabled( artIter->enabled );
+		articulation->setOffset( artIter->offset );
+		articulation->setRotation( artIter->rotation );
+		articulation->setOffsetVelocity( artIter->offsetVelocity );
+		articulation->setRotationVelocity( artIter->rotationVelocity );
+		keepArticulations.insert( articulation );
+	}
+	std::vector< RefPtr<Articulation> > extraArticulations;
+	ArticulationContainer::ArticulationIteratorPair artIters =
+		entity->getArticulations();
+	for( ; artIters.first != artIters.second; artIters.first++ )
+	{
+		if( keepArticulations.find( artIters.first->second.get() ) == keepArticulations.end() )
+			extraArticulations.push_back( artIters.first->second );
+	}
+	for( unsigned int i = 0; i < extraArticulations.size(); i++ )
+		entity->removeArticulation( extraArticulations[i].get() );
+
+	std::vector<ComponentDefaults>::iterator compIter;
+	std::set< Component * > keepComponents;
+	for( compIter = entityDefaults.components.begin();
+		compIter != entityDefaults.components.end(); compIter++ )
+	{
+		compIter->component->setState( compIter->state );
+		keepComponents.insert( compIter->component.get() );
+	}
+	std::vector< RefPtr<Component> > extraComponents;
+	ComponentContainer::ComponentIteratorPair compIters =
+		entity->getComponents();
+	for( ; compIters.first != compIters.second; compIters.first++ )
+	{
+		if( keepComponents.find( compIters.first->second.get() ) == keepComponents.end() )
+			extraComponents.push_back( compIters.first->second );
+	}
+	for( unsigned int i = 0; i < extraComponents.size(); i++ )
+		entity->removeComponent( extraComponents[i].get() );
+
+	std::vector<AnimationDefaults>::iterator animIter;
+	for( animIter = entityDefaults.animations.begin();
+		animIter != entityDefaults.animations.end(); animIter++ )
+	{
+		Animation *animation = animIter->animation.get();
+		animation->setState( animIter->state );
+		animation->setDirection( animIter->direction );
+		animation->setLoopMode( animIter->loopMode );
+	}
+}
+
+
+// ================================================
+// clear
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EntityPool::clear()
+{
+	removed.clear();
+	pools.clear();
+	defaults.clear();
+}
+
+
+// ================================================
+// report
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EntityPool::report()
+{
+	std::map< int, TypePool >::iterator iter;
+	for( iter = pools.begin(); iter != pools.end(); iter++ )
+	{
+		TypePool &pool = iter->second;
+		if( pool.maxSize <= 0 )
+			continue;
+		if( pool.hits == 0 && pool.misses == 0 && pool.discards == 0 )
+			continue;
+
+		MPV_LOG_INFO( "PluginEntityMgr - entity pool for type " << iter->first
+			<< ": " << pool.hits << " hits, " << pool.misses << " misses, "
+			<< pool.discards << " discards, " << pool.entities.size()
+			<< "/" << pool.maxSize << " parked" );
+		pool.hits = 0;
+		pool.misses = 0;
+		pool.discards = 0;
+	}
+}
+
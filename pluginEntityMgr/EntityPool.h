@@ -0,0 +1,184 @@
+/** <pre>
+ *  MPV entity manager plugin
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ *
+ *  </pre>
+ */
+
+
+#ifndef _ENTITYPOOL_H_
+#define _ENTITYPOOL_H_
+
+#include <map>
+#include <vector>
+
+#include "Entity.h"
+#include "EntityContainer.h"
+#include "EntityFactory.h"
+
+//=========================================================
+//! Keeps removed entities of pooled types, so that they can be reused
+//! by the next Entity Control of the same type.  A reused entity keeps
+//! its implementation objects (and so its scene graph), which saves the
+//! cost of building them again.
+//!
+//! The pool watches the all-entities container.  When a pooled entity is
+//! removed, it is detached from its parent at once, and parked (reset to
+//! the state it was in when it was first created) the next time the pool
+//! is used.  Parking is deferred because the entity is still being
+//! removed from the other containers when the pool hears about it.
+//!
+class EntityPool : public mpv::Referenced
+{
+public:
+	//=========================================================
+	//! General Constructor
+	//! \param _entities - the container holding all the entities
+	//! \param _factory - provides the pool size for each entity type
+	//!
+	EntityPool( mpv::EntityContainer *_entities, const EntityFactory *_factory );
+
+	//=========================================================
+	//! Takes a parked entity of the given type out of the pool, and
+	//! prepares it for use as a new entity.  The caller should add it to
+	//! the all-entities container, as with a newly-created entity.
+	//! \param id - the entity instance ID for the reused entity
+	//! \param type - the entity type ID
+	//! \return the entity, or NULL if none of that type are parked
+	//!
+	mpv::RefPtr<mpv::Entity> acquire( int id, int type );
+
+	//=========================================================
+	//! Called after an entity has been added to the all-entities
+	//! container, when its implementations (and their articulations,
+	//! components and animations) exist.  Records that state for newly-
+	//! created entities of pooled types, so that it can be restored when
+	//! the entity is parked.
+	//!
+	void entityAdded( mpv::Entity *entity );
+
+	//=========================================================
+	//! Parks (or discards, if the pool is full) the entities removed since
+	//! the pool was last used
+	//!
+	void parkRemovedEntities();
+
+	//=========================================================
+	//! Releases all the parked entities.  Should be called at shutdown,
+	//! while the plugins that created the entities' implementations are
+	//! still loaded.
+	//!
+	void clear();
+
+	//=========================================================
+	//! Writes the pool statistics for each pooled type to the log, and
+	//! resets them
+	//!
+	void report();
+
+protected:
+	//=========================================================
+	//! General Destructor
+	//!
+	virtual ~EntityPool();
+
+	//=========================================================
+	//! Callback; notification that an entity was removed from the
+	//! all-entities container
+	//!
+	void entityRemoved( mpv::EntityContainer *, mpv::Entity *entity );
+
+	//=========================================================
+	//! Puts the entity back into the state recorded by entityAdded()
+	//!
+	void resetEntity( mpv::Entity *entity );
+
+	//=========================================================
+	//! The state of an entity's parts when it was first created
+	//!
+	struct ArticulationDefaults
+	{
+		mpv::RefPtr<mpv::Articulation> articulation;
+		bool enabled;
+		mpv::Vect3 offset;
+		mpv::Vect3 rotation;
+		mpv::Vect3 offsetVelocity;
+		mpv::Vect3 rotationVelocity;
+	};
+	struct ComponentDefaults
+	{
+		mpv::RefPtr<mpv::Component> component;
+		Cigi_uint8 state;
+	};
+	struct AnimationDefaults
+	{
+		mpv::RefPtr<mpv::Animation> animation;
+		mpv::Animation::AnimationDirection direction;
+		mpv::Animation::AnimationLoopMode loopMode;
+		mpv::Animation::AnimationState state;
+	};
+	struct EntityDefaults
+	{
+		std::vector<ArticulationDefaults> articulations;
+		std::vector<ComponentDefaults> components;
+		std::vector<AnimationDefaults> animations;
+	};
+
+	//=========================================================
+	//! The parked entities of one type, and the statistics for that type
+	//!
+	struct TypePool
+	{
+		TypePool() : maxSize( 0 ), hits( 0 ), misses( 0 ), discards( 0 ) {}
+
+		int maxSize;
+		std::vector< mpv::RefPtr<mpv::Entity> > entities;
+
+		//! reuses of a parked entity
+		int hits;
+		//! creations while the pool was empty
+		int misses;
+		//! removals while the pool was full
+		int discards;
+	};
+
+	//=========================================================
+	//! Returns the pool for the given type, or NULL if the type isn't
+	//! pooled.  Pools are created as their types are first seen.
+	//!
+	TypePool *getPool( int type );
+
+	mpv::RefPtr<mpv::EntityContainer> entities;
+	const EntityFactory *factory;
+
+	//! pools, keyed by entity type
+	std::map< int, TypePool > pools;
+
+	//! the recorded state of each live or parked entity of a pooled type
+	std::map< mpv::Entity *, EntityDefaults > defaults;
+
+	//! entities removed since the pool was last used, waiting to be parked
+	std::vector< mpv::RefPtr<mpv::Entity> > removed;
+
+};
+
+#endif
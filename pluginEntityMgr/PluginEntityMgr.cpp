@@ -39,6 +39,12 @@
  *  2008-07-07 Andrew Sampson
  *      Rewrote entity manager.  Mostly based on symbology mgr plugin.
  *
+ *  2026-10-19
+ *      Removed entities of types with a pool_size are kept and reused.
+ *
+ *  2026-10-19
+ *      Articulated part controls may be decoded in parallel.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -69,6 +75,9 @@ EXPORT_DYNAMIC_CLASS( PluginEntityMgr )
 PluginEntityMgr::PluginEntityMgr() : Plugin(),
 	allEntities( new EntityContainer ),
 	topLevelEntities( new EntityContainer ),
+	entityPool( new EntityPool( allEntities.get(), &factory ) ),
+	poolReportInterval( 60.0f ),
+	timeSinceReport( 0.0 ),
 	conversionObserver( new EntityCoordinateConversionObserver ),
 	animStopNotificationListener( new AnimStopNotificationListener( allEntities.get() ) ),
 	entityCtrlProc( this ),
@@ -86,6 +95,7 @@ PluginEntityMgr::PluginEntityMgr() : Plugin(),
 	dependencies_.push_back( "PluginCoordinateConversionMgr" );
 
 	ImsgPtr = NULL;
+	parallelDecoder = NULL;
 	OmsgPtr = NULL;
 	DefFileData = NULL;
 	timeElapsedLastFrame = NULL;
@@ -125,6 +135,7 @@ void PluginEntityMgr::act( SystemState::ID state, StateContext &stateContext )
 		// This state is for retrieving things from the blackboard
 
 		bb_->get( "CigiIncomingMsg", ImsgPtr );
+		bb_->get( "CigiParallelDecoder", parallelDecoder );
 		bb_->get( "CigiOutgoingMsg", OmsgPtr );
 		bb_->get( "DefinitionData", DefFileData );
 		bb_->get( "TimeElapsedLastFrame", timeElapsedLastFrame );
@@ -138,8 +149,23 @@ void PluginEntityMgr::act( SystemState::ID state, StateContext &stateContext )
 		if( ImsgPtr != NULL )
 		{
 			ImsgPtr->RegisterEventProcessor( CIGI_ENTITY_CTRL_PACKET_ID_V3, &entityCtrlProc );
-			ImsgPtr->RegisterEventProcessor( CIGI_ART_PART_CTRL_PACKET_ID_V3, &artPartProc );
-			ImsgPtr->RegisterEventProcessor( CIGI_SHORT_ART_PART_CTRL_PACKET_ID_V3, &shortArtPartProc );
+			// Articulated part controls may be decoded in parallel; 
+			// they're still applied on this thread.  No global packet 
+			// depends on them.  Entity Control stays serial, since 
+			// component controls (which are global) may refer to the 
+			// entities it creates.
+			if( parallelDecoder != NULL )
+			{
+				parallelDecoder->registerEventProcessor<CigiArtPartCtrlV3>( 
+					CIGI_ART_PART_CTRL_PACKET_ID_V3, &artPartProc );
+				parallelDecoder->registerEventProcessor<CigiShortArtPartCtrlV3>( 
+					CIGI_SHORT_ART_PART_CTRL_PACKET_ID_V3, &shortArtPartProc );
+			}
+			else
+			{
+				ImsgPtr->RegisterEventProcessor( CIGI_ART_PART_CTRL_PACKET_ID_V3, &artPartProc );
+				ImsgPtr->RegisterEventProcessor( CIGI_SHORT_ART_PART_CTRL_PACKET_ID_V3, &shortArtPartProc );
+			}
 			ImsgPtr->RegisterEventProcessor( CIGI_COMP_CTRL_PACKET_ID_V3_3, &compCtrlProc );
 			ImsgPtr->RegisterEventProcessor( CIGI_SHORT_COMP_CTRL_PACKET_ID_V3_3, &shortCompCtrlProc );
 		}
@@ -157,8 +183,14 @@ void PluginEntityMgr::act( SystemState::ID state, StateContext &stateContext )
 		break;
 
 	case SystemState::Reset:
+		allEntities->flagAllEntitiesAsDestroyed();
+		break;
+
 	case SystemState::Shutdown:
 		allEntities->flagAllEntitiesAsDestroyed();
+		// the parked entities' implementations belong to other plugins, 
+		// so they must go before the plugins are unloaded
+		entityPool->clear();
 		break;
 
 	default:
@@ -173,6 +205,7 @@ void PluginEntityMgr::act( SystemState::ID state, StateContext &stateContext )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void PluginEntityMgr::operate()
 {
+	entityPool->parkRemovedEntities();
 
 	EntityContainer::EntityIteratorPair iterators = allEntities->getEntities();
 	for( ; iterators.first != iterators.second; iterators.first++ )
@@ -187,6 +220,16 @@ void PluginEntityMgr::operate()
 		processEntity( entity );
 		
 	}
+	
+	if( poolReportInterval > 0.0f )
+	{
+		timeSinceReport += *timeElapsedLastFrame;
+		if( timeSinceReport >= poolReportInterval )
+		{
+			timeSinceReport = 0.0;
+			entityPool->report();
+		}
+	}
 }
 
 
@@ -203,6 +246,14 @@ void PluginEntityMgr::processConfigData()
 	}
 
 	factory.init( root );
+	
+	DefFileGroup *entitiesGroup = root->getGroupByURI( "/entities/" );
+	if( entitiesGroup != NULL )
+	{
+		DefFileAttrib *attr = entitiesGroup->getAttribute( "pool_report_interval" );
+		if( attr )
+			poolReportInterval = attr->asFloat();
+	}
 }
 
 
@@ -225,8 +276,14 @@ Entity *PluginEntityMgr::createEntity( int id, int type )
 	Entity *result = allEntities->findEntity( id );
 	if( result == NULL )
 	{
-		result = factory.createEntity( id, type );
-		allEntities->addEntity( result );
+		// reuse a removed entity of the same type, if one has been kept
+		RefPtr<Entity> entity = entityPool->acquire( id, type );
+		if( !entity.valid() )
+			entity = factory.createEntity( id, type );
+		
+		allEntities->addEntity( entity.get() );
+		entityPool->entityAdded( entity.get() );
+		result = entity.get();
 	}
 
 	return result;
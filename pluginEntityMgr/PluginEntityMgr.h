@@ -39,6 +39,12 @@
  *  2008-07-07 Andrew Sampson
  *      Rewrote entity manager.  Mostly based on symbology mgr plugin.
  *
+ *  2026-10-19
+ *      Removed entities of types with a pool_size are kept and reused.
+ *
+ *  2026-10-19
+ *      Articulated part controls may be decoded in parallel.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -60,8 +66,10 @@
 #include "Entity.h"
 #include "EntityContainer.h"
 #include "CoordinateConverter.h"
+#include "CigiParallelDecoder.h"
 
 #include "EntityFactory.h"
+#include "EntityPool.h"
 #include "ProcEntityCtrl.h"
 #include "ProcArtPart.h"
 #include "ProcShortArtPart.h"
@@ -137,6 +145,13 @@ private:
 	//! 
 	CigiIncomingMsg *ImsgPtr;
 
+	//=========================================================
+	//! Decodes packets from the Host on several threads; the articulated 
+	//! part processors are registered with it.  Retrieved from the 
+	//! blackboard.
+	//! 
+	mpv::CigiParallelDecoder *parallelDecoder;
+
 	//=========================================================
 	//! The outgoing message buffer.  Retrieved from the blackboard.
 	//! 
@@ -177,6 +192,18 @@ private:
 	//! 
 	EntityFactory factory;
 	
+	//=========================================================
+	//! Keeps removed entities of pooled types for reuse.
+	//! 
+	mpv::RefPtr<EntityPool> entityPool;
+	
+	//=========================================================
+	//! Seconds between pool statistics reports; 0 disables them.  From 
+	//! the config data.
+	//! 
+	float poolReportInterval;
+	double timeSinceReport;
+	
 	//=========================================================
 	//! Performs automatic coordinate conversion on all entities in 
 	//! topLevelEntities.  
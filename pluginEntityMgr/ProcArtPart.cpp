@@ -25,10 +25,9 @@
  */
 
 
-#include <iostream>
-
 #include <CigiArtPartCtrlV3.h>
 
+#include "Log.h"
 #include "ProcArtPart.h"
 
 using namespace mpv;
@@ -64,8 +63,8 @@ void ProcArtPart::OnPacketReceived( CigiBasePacket *Packet )
 	if( !entity.valid() )
 	{
 		// entity not found!
-		std::cout << "Warning - in ProcArtPart::OnPacketReceived() - entity " 
-			<< artPartCtrl->GetEntityID() << " doesn't exist\n";
+		MPV_LOG_WARNING( "in ProcArtPart::OnPacketReceived() - entity " 
+			<< artPartCtrl->GetEntityID() << " doesn't exist" );
 		return;
 	}
 	
@@ -25,10 +25,9 @@
  */
 
 
-#include <iostream>
-
 #include <CigiCompCtrlV3_3.h>
 
+#include "Log.h"
 #include "ProcCompCtrl.h"
 
 using namespace mpv;
@@ -68,8 +67,8 @@ void ProcCompCtrl::OnPacketReceived( CigiBasePacket *Packet )
 	if( !entity.valid() )
 	{
 		// entity not found!
-		std::cout << "Warning - in ProcCompCtrl::OnPacketReceived() - entity " 
-			<< compCtrl->GetInstanceID() << " doesn't exist\n";
+		MPV_LOG_WARNING( "in ProcCompCtrl::OnPacketReceived() - entity " 
+			<< compCtrl->GetInstanceID() << " doesn't exist" );
 		return;
 	}
 	
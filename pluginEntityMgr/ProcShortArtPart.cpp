@@ -25,8 +25,7 @@
  */
 
 
-#include <iostream>
-
+#include "Log.h"
 #include "ProcShortArtPart.h"
 
 using namespace mpv;
@@ -62,8 +61,8 @@ void ProcShortArtPart::OnPacketReceived( CigiBasePacket *Packet )
 	if( !entity.valid() )
 	{
 		// entity not found!
-		std::cout << "Warning - in ProcShortArtPart::OnPacketReceived() - entity " 
-			<< artPartCtrl->GetEntityID() << " doesn't exist\n";
+		MPV_LOG_WARNING( "in ProcShortArtPart::OnPacketReceived() - entity " 
+			<< artPartCtrl->GetEntityID() << " doesn't exist" );
 		return;
 	}
 	
@@ -25,10 +25,9 @@
  */
 
 
-#include <iostream>
-
 #include <CigiShortCompCtrlV3_3.h>
 
+#include "Log.h"
 #include "ProcShortCompCtrl.h"
 
 using namespace mpv;
@@ -68,8 +67,8 @@ void ProcShortCompCtrl::OnPacketReceived( CigiBasePacket *Packet )
 	if( !entity.valid() )
 	{
 		// entity not found!
-		std::cout << "Warning - in ProcShortCompCtrl::OnPacketReceived() - entity " 
-			<< compCtrl->GetInstanceID() << " doesn't exist\n";
+		MPV_LOG_WARNING( "in ProcShortCompCtrl::OnPacketReceived() - entity " 
+			<< compCtrl->GetInstanceID() << " doesn't exist" );
 		return;
 	}
 	
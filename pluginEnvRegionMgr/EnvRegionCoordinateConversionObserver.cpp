@@ -0,0 +1,139 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026 
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+
+
+#include "BindSlot.h"
+#include "EnvRegionCoordinateConversionObserver.h"
+
+using namespace mpv;
+
+// ================================================
+// EnvRegionCoordinateConversionObserver
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EnvRegionCoordinateConversionObserver::EnvRegionCoordinateConversionObserver() : 
+	mpv::CoordinateConversionObserver()
+{
+	
+}
+
+
+// ================================================
+// ~EnvRegionCoordinateConversionObserver
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EnvRegionCoordinateConversionObserver::~EnvRegionCoordinateConversionObserver() 
+{
+	stopObservingContainer();
+}
+
+
+// ================================================
+// startObservingContainer
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionCoordinateConversionObserver::startObservingContainer( EnvRegionContainer *regionContainer )
+{
+	stopObservingContainer();
+	
+	container = regionContainer;
+
+	// register existing regions
+	EnvRegionContainer::EnvRegionIteratorPair iterPair = container->getRegions();
+	EnvRegionContainer::EnvRegionMap::iterator iter = iterPair.first;
+	for( ; iter != iterPair.second; iter++ )
+	{
+		startObserving( iter->second.get() );
+	}
+	
+	// listen for new regions, so that they can be registered as well
+	container->addedRegion.connect( BIND_SLOT2( 
+		EnvRegionCoordinateConversionObserver::startObservingRegion, this ) );
+
+	// listen for region removal, so that they can be un-registered
+	container->removedRegion.connect( BIND_SLOT2( 
+		EnvRegionCoordinateConversionObserver::stopObservingRegion, this ) );
+}
+
+
+// ================================================
+// stopObservingContainer
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionCoordinateConversionObserver::stopObservingContainer()
+{
+	if( !container.valid() )
+		return;
+
+	// un-register existing regions
+	EnvRegionContainer::EnvRegionIteratorPair iterPair = container->getRegions();
+	EnvRegionContainer::EnvRegionMap::iterator iter = iterPair.first;
+	for( ; iter != iterPair.second; iter++ )
+	{
+		stopObserving( iter->second.get() );
+	}
+
+	// stop listening for new regions
+	container->addedRegion.disconnect( BIND_SLOT2( 
+		EnvRegionCoordinateConversionObserver::startObservingRegion, this ) );
+
+	// stop listening for region removal
+	container->removedRegion.disconnect( BIND_SLOT2( 
+		EnvRegionCoordinateConversionObserver::stopObservingRegion, this ) );
+
+	container = NULL;
+}
+
+
+// ================================================
+// performConversionForAllObservedObjects
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionCoordinateConversionObserver::performConversionForAllObservedObjects()
+{
+	EnvRegionContainer::EnvRegionIteratorPair iterPair = container->getRegions();
+	EnvRegionContainer::EnvRegionMap::iterator iter = iterPair.first;
+	for( ; iter != iterPair.second; iter++ )
+	{
+		performCoordinateConversion( iter->second.get() );
+	}
+}
+
+// ================================================
+// startObservingRegion
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionCoordinateConversionObserver::startObservingRegion( EnvRegionContainer*, EnvRegion *region )
+{
+	startObserving( region );
+}
+
+
+// ================================================
+// stopObservingRegion
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EnvRegionCoordinateConversionObserver::stopObservingRegion( EnvRegionContainer*, EnvRegion *region )
+{
+	stopObserving( region );
+}
+
+
@@ -0,0 +1,71 @@
+/** <pre>
+ *  The MPV Common Library
+ *  Copyright (c) 2026 
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+
+
+#ifndef _ENVREGIONCOORDINATECONVERSIONOBSERVER_H_
+#define _ENVREGIONCOORDINATECONVERSIONOBSERVER_H_
+
+#include "CoordinateConversionObserver.h"
+#include "EnvRegionContainer.h"
+#include "MPVCommonTypes.h"
+
+
+using namespace mpv;
+
+//=========================================================
+//! Keeps the database positions of the environmental regions up to date, 
+//! including when the database origin changes
+//! 
+class EnvRegionCoordinateConversionObserver : public CoordinateConversionObserver
+{
+public:
+	//=========================================================
+	//! General Constructor
+	//! 
+	EnvRegionCoordinateConversionObserver();
+	
+	void startObservingContainer( EnvRegionContainer *regionContainer );
+	
+	void stopObservingContainer();
+	
+protected:
+	//=========================================================
+	//! General Destructor
+	//! 
+	virtual ~EnvRegionCoordinateConversionObserver();
+	
+	virtual void performConversionForAllObservedObjects();
+
+	void startObservingRegion( EnvRegionContainer*, EnvRegion *region );
+
+	void stopObservingRegion( EnvRegionContainer*, EnvRegion *region );
+
+	RefPtr<EnvRegionContainer> container;
+};
+
+#endif
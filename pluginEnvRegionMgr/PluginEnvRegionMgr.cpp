@@ -0,0 +1,340 @@
+/** <pre>
+ *  The Multi-Purpose Viewer
+ *  Copyright (c) 2004 The Boeing Company
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *  
+ *  
+ *  FILENAME:   PluginEnvRegionMgr.cpp
+ *  LANGUAGE:   C++
+ *  CLASS:      UNCLASSIFIED
+ *  PROJECT:    Multi-Purpose Viewer
+ *  
+ *  PROGRAM DESCRIPTION: 
+ *  This class manages environmental regions.
+ *  
+ *  MODIFICATION NOTES:
+ *  DATE     NAME                                SCR NUMBER
+ *  DESCRIPTION OF CHANGE........................
+ *  
+ *  04/04/2004 Greg Basler                       MPV_CR_DR_1
+ *  Initial Release.
+ *
+ *  2007-07-14 Andrew Sampson
+ *      Changed interface to use new state machine API
+ *
+ *  2026-10-19
+ *      Revived against the current plugin API.  Regions live in an
+ *      EnvRegionContainer with a spatial index, and the plugin answers
+ *      Environmental Conditions Requests and computes the conditions at
+ *      each view's eye point.
+ *
+ * </pre>
+ *  The Boeing Company
+ *  1.0
+ */
+
+
+#include "PluginEnvRegionMgr.h"
+#include "Entity.h"
+
+using namespace mpv;
+
+
+EXPORT_DYNAMIC_CLASS( PluginEnvRegionMgr )
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// ================================================
+// PluginEnvRegionMgr
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+PluginEnvRegionMgr::PluginEnvRegionMgr() : Plugin(), 
+	atmosphereCtrlProc( this ),
+	envCondRequestProc( this )
+{
+	name_ = "PluginEnvRegionMgr";
+	licenseInfo_.setLicense( LicenseInfo::LicenseGPL );
+	licenseInfo_.setOrigin( "Boeing" );
+
+	dependencies_.push_back( "PluginCoordinateConversionMgr" );
+	dependencies_.push_back( "PluginEntityMgr" );
+	dependencies_.push_back( "PluginViewMgr" );
+
+	OmsgPtr = NULL;
+	ImsgPtr = NULL;
+	allEntities = NULL;
+	viewMap = NULL;
+	coordinateConverter = NULL;
+
+	regions = new EnvRegionContainer();
+	conversionObserver = new EnvRegionCoordinateConversionObserver();
+	conversionObserver->startObservingContainer( regions.get() );
+
+	EnvRegionCtrlP.Init( regions.get() );
+	WeatherCtrlP.Init( regions.get() );
+
+	cleanUp();
+}
+
+
+// ================================================
+// ~PluginEnvRegionMgr
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+PluginEnvRegionMgr::~PluginEnvRegionMgr() throw()
+{
+	conversionObserver->stopObservingContainer();
+	cleanUp();
+}
+
+
+// ================================================
+// act
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginEnvRegionMgr::act( SystemState::ID state, StateContext &stateContext )
+{
+	switch( state )
+	{
+
+	case SystemState::BlackboardPost:
+		// This state is for posting things to the blackboard
+		bb_->put( "EnvRegions", regions.get() );
+		bb_->put( "ViewEnvConditions", &viewEnvConditions );
+		bb_->put( "EyeEnvConditions", &eyeEnvConditions );
+		break;
+
+	case SystemState::BlackboardRetrieve:
+		// This state is for retrieving things from the blackboard
+		bb_->get( "CigiOutgoingMsg", OmsgPtr );
+		bb_->get( "CigiIncomingMsg", ImsgPtr );
+		bb_->get( "AllEntities", allEntities );
+		bb_->get( "ViewMap", viewMap );
+		bb_->get( "CoordinateConverterProxy", coordinateConverter );
+
+		if( coordinateConverter != NULL )
+			conversionObserver->setCoordinateConverter( coordinateConverter );
+
+		if( ImsgPtr != NULL )
+		{
+			ImsgPtr->RegisterEventProcessor( CIGI_ENV_RGN_CTRL_PACKET_ID_V3,
+				(CigiBaseEventProcessor *) &EnvRegionCtrlP );
+
+			ImsgPtr->RegisterEventProcessor( CIGI_WEATHER_CTRL_PACKET_ID_V3,
+				(CigiBaseEventProcessor *) &WeatherCtrlP );
+
+			ImsgPtr->RegisterEventProcessor( CIGI_ATMOS_CTRL_PACKET_ID_V3,
+				(CigiBaseEventProcessor *) &atmosphereCtrlProc );
+
+			ImsgPtr->RegisterEventProcessor( CIGI_ENV_COND_REQ_PACKET_ID_V3_2,
+				(CigiBaseEventProcessor *) &envCondRequestProc );
+		}
+		break;
+
+	case SystemState::Reset:
+		cleanUp();
+		break;
+
+	case SystemState::Operate:
+	case SystemState::Debug:
+		operate();
+		break;
+
+	case SystemState::Shutdown:
+		cleanUp();
+		break;
+
+	default:
+		break;
+	}
+	
+}
+
+
+// ================================================
+// operate
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginEnvRegionMgr::operate() 
+{
+	// Process orphaned weather controls
+	WeatherCtrlP.Act();
+
+	// Regions that changed this frame are reindexed once, here, rather 
+	// than by whichever query happens to come first
+	regions->updateIndex();
+
+	if( coordinateConverter == NULL )
+		return;
+
+	updateViewConditions();
+	sendResponses();
+}
+
+
+// ================================================
+// updateViewConditions
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginEnvRegionMgr::updateViewConditions() 
+{
+	viewEnvConditions.clear();
+	eyeEnvConditions = regions->getGlobalConditions();
+
+	if( viewMap == NULL || allEntities == NULL )
+		return;
+
+	bool haveEye = false;
+
+	std::map< int, RefPtr<View> >::iterator iter;
+	for( iter = viewMap->begin(); iter != viewMap->end(); iter++ )
+	{
+		View *view = iter->second.get();
+		Entity *entity = allEntities->findEntity( view->getEntityID() );
+		if( entity == NULL )
+			continue;
+
+		Vect3 eye = entity->getAbsoluteTransform() * view->getViewOffset();
+
+		// the weather layers are selected by altitude MSL, which the 
+		// database z isn't, in general
+		CoordinateSet db, gdc;
+		db.LatX = eye[0];
+		db.LonY = eye[1];
+		db.AltZ = eye[2];
+		coordinateConverter->performReverseConversion( db, gdc );
+
+		EnvConditions &conditions = viewEnvConditions[iter->first];
+		regions->getConditions( eye[0], eye[1], gdc.AltZ, conditions );
+
+		// the map is sorted by view ID, so the first view found is the 
+		// lowest-numbered one
+		if( !haveEye )
+		{
+			eyeEnvConditions = conditions;
+			haveEye = true;
+		}
+	}
+}
+
+
+// ================================================
+// sendResponses
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginEnvRegionMgr::sendResponses() 
+{
+	if( OmsgPtr == NULL )
+	{
+		pendingRequests.clear();
+		return;
+	}
+
+	std::list<EnvCondRequest>::iterator iter;
+	for( iter = pendingRequests.begin(); iter != pendingRequests.end(); iter++ )
+	{
+		CoordinateSet gdc, db;
+		gdc.LatX = iter->lat;
+		gdc.LonY = iter->lon;
+		gdc.AltZ = iter->alt;
+		coordinateConverter->performConversion( gdc, db );
+
+		EnvConditions conditions;
+		regions->getConditions( db.LatX, db.LonY, (float)iter->alt, conditions );
+
+		if( iter->type & CigiBaseEnvCondReq::Weather )
+		{
+			CigiWeatherCondRespV3 packet;
+			packet.SetRequestID( iter->id );
+			packet.SetHumidity( (Cigi_uint8)( conditions.humidity + 0.5f ) );
+			packet.SetAirTemp( conditions.airTemp );
+			packet.SetVisibility( conditions.visibilityRange );
+			packet.SetHorizSpeed( conditions.horizWindSpeed );
+			packet.SetVertSpeed( conditions.vertWindSpeed );
+			packet.SetWindDir( conditions.windDirection );
+			packet.SetBaroPress( conditions.baroPressure );
+			*OmsgPtr << packet;
+		}
+
+		// Only the layer that dominates at the requested point is reported
+		if( ( iter->type & CigiBaseEnvCondReq::Aerosol ) && conditions.layerID >= 0 )
+		{
+			CigiAerosolRespV3 packet;
+			packet.SetRequestID( iter->id );
+			packet.SetLayerID( conditions.layerID );
+			packet.SetAerosolConcentration( conditions.aerosol );
+			*OmsgPtr << packet;
+		}
+
+		// Maritime and terrestrial surface conditions aren't modelled, so 
+		// those parts of the request go unanswered
+	}
+
+	pendingRequests.clear();
+}
+
+
+// ================================================
+// cleanUp
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginEnvRegionMgr::cleanUp()
+{
+	regions->flagAllRegionsAsDestroyed();
+
+	// a standard atmosphere, until the host says otherwise
+	EnvConditions conditions;
+	conditions.humidity = 30.0f;
+	conditions.airTemp = 15.0f;
+	conditions.visibilityRange = 100000.0f;
+	conditions.baroPressure = 1013.25f;
+	regions->setGlobalConditions( conditions );
+
+	viewEnvConditions.clear();
+	eyeEnvConditions = conditions;
+
+	pendingRequests.clear();
+}
+
+
+// ================================================
+// AtmosphereCtrlProc::OnPacketReceived
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginEnvRegionMgr::AtmosphereCtrlProc::OnPacketReceived( CigiBasePacket *packet )
+{
+	CigiAtmosCtrlV3 *acp = static_cast<CigiAtmosCtrlV3*>( packet );
+
+	EnvConditions conditions = plugin->regions->getGlobalConditions();
+	conditions.humidity = acp->GetHumidity();
+	conditions.airTemp = acp->GetAirTemp();
+	conditions.visibilityRange = acp->GetVisibility();
+	conditions.horizWindSpeed = acp->GetHorizWindSp();
+	conditions.vertWindSpeed = acp->GetVertWindSp();
+	conditions.windDirection = acp->GetWindDir();
+	conditions.baroPressure = acp->GetBaroPress();
+	plugin->regions->setGlobalConditions( conditions );
+}
+
+
+// ================================================
+// EnvCondRequestProc::OnPacketReceived
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginEnvRegionMgr::EnvCondRequestProc::OnPacketReceived( CigiBasePacket *packet )
+{
+	CigiEnvCondReqV3_2 *ecrp = static_cast<CigiEnvCondReqV3_2*>( packet );
+
+	EnvCondRequest request;
+	request.id = ecrp->GetReqID();
+	request.type = ecrp->GetReqType();
+	request.lat = ecrp->GetLat();
+	request.lon = ecrp->GetLon();
+	request.alt = ecrp->GetAlt();
+	plugin->pendingRequests.push_back( request );
+}
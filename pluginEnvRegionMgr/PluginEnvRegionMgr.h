@@ -0,0 +1,230 @@
+/** <pre>
+ *  The Multi-Purpose Viewer
+ *  Copyright (c) 2004 The Boeing Company
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *  
+ *  
+ *  FILENAME:   PluginEnvRegionMgr.h
+ *  LANGUAGE:   C++
+ *  CLASS:      UNCLASSIFIED
+ *  PROJECT:    Multi-Purpose Viewer
+ *  
+ *  PROGRAM DESCRIPTION: 
+ *  This class manages environmental regions.
+ *  
+ *  MODIFICATION NOTES:
+ *  DATE     NAME                                SCR NUMBER
+ *  DESCRIPTION OF CHANGE........................
+ *  
+ *  11/02/2005 Greg Basler                       MPV_CR_DR_1
+ *  Initial Release.
+ *
+ *  2007-07-14 Andrew Sampson
+ *      Changed interface to use new state machine API
+ *
+ *  2026-10-19
+ *      Revived against the current plugin API.  Regions live in an
+ *      EnvRegionContainer with a spatial index, and the plugin answers
+ *      Environmental Conditions Requests and computes the conditions at
+ *      each view's eye point.
+ *
+ * </pre>
+ *  The Boeing Company
+ *  1.0
+ */
+
+
+#ifndef _PLUGIN_ENVREGION_MANAGER_INCLUDED_
+#define _PLUGIN_ENVREGION_MANAGER_INCLUDED_
+
+#include <list>
+#include <map>
+
+#include "Plugin.h"
+#include "AllCigi.h"
+#include "CoordinateConverter.h"
+#include "EntityContainer.h"
+#include "View.h"
+#include "EnvRegionContainer.h"
+
+#include "ProcEnvRegionCtrl.h"
+#include "ProcWeatherCtrl.h"
+#include "EnvRegionCoordinateConversionObserver.h"
+
+
+
+//=========================================================
+//! This class manages environmental regions and the global atmosphere.
+//! Each frame it computes the conditions at every view's eye point, and 
+//! answers the host's Environmental Conditions Requests.
+//!
+class PluginEnvRegionMgr : public Plugin 
+{
+public:
+
+	//=========================================================
+	//! General Constructor
+	//!
+	PluginEnvRegionMgr();
+
+	//=========================================================
+	//! General Destructor
+	//!
+	virtual ~PluginEnvRegionMgr() throw();
+
+	//=========================================================
+	//! The per-frame processing that this plugin performs
+	//! \param state - The current system state
+	//! \param stateContext - an object containing all the variables which 
+	//!     influence state transitions
+	//!
+	virtual void act( SystemState::ID state, StateContext &stateContext );
+
+protected:
+
+	void operate();
+
+	//=========================================================
+	//! Computes the conditions at each view's eye point
+	//!
+	void updateViewConditions();
+
+	//=========================================================
+	//! Answers the Environmental Conditions Requests received this frame
+	//!
+	void sendResponses();
+
+	void cleanUp();
+
+	//=========================================================
+	//! The OutgoingMsg pointer.  Retrieved from the blackboard.
+	//!
+	CigiOutgoingMsg *OmsgPtr;
+
+	//=========================================================
+	//! The IncomingMsg pointer.  Retrieved from the blackboard.
+	//!
+	CigiIncomingMsg *ImsgPtr;
+
+	//=========================================================
+	//! All the entities; views are attached to these.  Retrieved from 
+	//! the blackboard.
+	//!
+	mpv::EntityContainer *allEntities;
+
+	//=========================================================
+	//! The views.  Retrieved from the blackboard.
+	//!
+	std::map< int, mpv::RefPtr<mpv::View> > *viewMap;
+
+	//=========================================================
+	//! Coordinate converter, for converting region and request positions 
+	//! from GDC to database coordinates and eye points back again.  
+	//! Retrieved from the blackboard.
+	//!
+	mpv::CoordinateConverter *coordinateConverter;
+
+	//=========================================================
+	//! The environmental regions.  Posted to the blackboard.
+	//!
+	mpv::RefPtr<mpv::EnvRegionContainer> regions;
+
+	//=========================================================
+	//! The conditions at each view's eye point, keyed by view ID.  
+	//! Posted to the blackboard.
+	//!
+	std::map< int, mpv::EnvConditions > viewEnvConditions;
+
+	//=========================================================
+	//! The conditions at the eye point of the lowest-numbered view.  
+	//! Posted to the blackboard.
+	//!
+	mpv::EnvConditions eyeEnvConditions;
+
+	//=========================================================
+	//! Keeps the regions' database positions up to date
+	//!
+	mpv::RefPtr<EnvRegionCoordinateConversionObserver> conversionObserver;
+
+	//=========================================================
+	//! The Environmental Region Control packet processor object
+	//!
+	ProcEnvRegionCtrl EnvRegionCtrlP;
+
+	//=========================================================
+	//! The Weather control packet processing object
+	//!
+	ProcEnvRegionWeatherCtrl WeatherCtrlP;
+
+	//=========================================================
+	//! An Environmental Conditions Request, held until the end of the 
+	//! frame so that it sees this frame's region updates
+	//!
+	struct EnvCondRequest
+	{
+		int id;
+		int type;
+		double lat;
+		double lon;
+		double alt;
+	};
+
+	std::list<EnvCondRequest> pendingRequests;
+
+	//=========================================================
+	//! This class processes Atmosphere Control packets
+	//!
+	class AtmosphereCtrlProc : public CigiBaseEventProcessor
+	{
+	public:
+
+		AtmosphereCtrlProc( PluginEnvRegionMgr *_plugin )
+			: plugin( _plugin ) {}
+
+		virtual ~AtmosphereCtrlProc() {}
+
+		virtual void OnPacketReceived( CigiBasePacket *packet );
+
+	private:
+
+		PluginEnvRegionMgr *plugin;
+	};
+
+	AtmosphereCtrlProc atmosphereCtrlProc;
+
+	//=========================================================
+	//! This class processes Environmental Conditions Request packets
+	//!
+	class EnvCondRequestProc : public CigiBaseEventProcessor
+	{
+	public:
+
+		EnvCondRequestProc( PluginEnvRegionMgr *_plugin )
+			: plugin( _plugin ) {}
+
+		virtual ~EnvCondRequestProc() {}
+
+		virtual void OnPacketReceived( CigiBasePacket *packet );
+
+	private:
+
+		PluginEnvRegionMgr *plugin;
+	};
+
+	EnvCondRequestProc envCondRequestProc;
+
+};
+
+#endif
@@ -16,14 +16,14 @@
  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  *  
  *  
- *  FILENAME:   ProcEntityCtrl.cpp
+ *  FILENAME:   ProcEnvRegionCtrl.cpp
  *  LANGUAGE:   C++
  *  CLASS:      UNCLASSIFIED
  *  PROJECT:    Multi-Purpose Viewer
  *  
  *  PROGRAM DESCRIPTION: 
  *  This class contains the data and methods necessary to
- *   process the entity control packets.
+ *   process the environmental region control packets.
  *  
  *  MODIFICATION NOTES:
  *  DATE     NAME                                SCR NUMBER
@@ -32,6 +32,10 @@
  *  11/02/2005 Greg Basler                       MPV_CR_DR_1
  *  Initial Release.
  *
+ *  2026-10-19
+ *      Creates mpv::EnvRegion objects in an EnvRegionContainer, in place
+ *      of the old list and jump table.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -41,6 +45,8 @@
 #include "ProcEnvRegionCtrl.h"
 #include "AllCigi.h"
 
+using namespace mpv;
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -48,7 +54,8 @@
 // ================================================
 // ProcEnvRegionCtrl
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-ProcEnvRegionCtrl::ProcEnvRegionCtrl()
+ProcEnvRegionCtrl::ProcEnvRegionCtrl() : 
+   regions( NULL )
 {
 
 }
@@ -71,46 +78,24 @@ void ProcEnvRegionCtrl::OnPacketReceived(CigiBasePacket *Packet)
    CigiEnvRgnCtrlV3 *ercp = (CigiEnvRgnCtrlV3 *)Packet;
 
    int RgnID = (int)ercp->GetRegionID();
-   std::list<EnvRegion>::iterator CrntRgn = 
-      *(EnvRegionTable + RgnID);
+   EnvRegion *CrntRgn = regions->findRegion(RgnID);
 
-   if(CrntRgn != EnvRegionLst->end())
-   {
-      CrntRgn->ProcEnvRegionCtrlPckt(ercp);
-   }
-   else
+   if(CrntRgn == NULL)
    {
-      EnvRegion *TempRgn = new EnvRegion;
-
-      EnvRegionLst->push_back(*TempRgn);
-      
-      delete TempRgn;
-
-      // Get an iterator to the new environmental region
-      CrntRgn = EnvRegionLst->end();
-      CrntRgn--;
-
-      // place a pointer to the environmental region in the lookup table
-      *(EnvRegionTable + RgnID) = CrntRgn;
-      
-      // set up the new region according to the contents of the packet
-      CrntRgn->SetEnvRegionID(RgnID);
-      
-      CrntRgn->SetPosConv(CoordCigi2DBase,
-                       CoordDBase2Cigi);
-	  
-      CrntRgn->ProcEnvRegionCtrlPckt(ercp);
-
-      // Create the 10 CIGI defined weather layers
-      int ndx;
-      WeatherCtrl InitWeatherCtrl;
-      for(ndx=0;ndx<10;ndx++)
-      {
-         InitWeatherCtrl.SetLayerID(ndx);
-         CrntRgn->AddWeatherCtrl(InitWeatherCtrl);
-      }
+      // destroying a region that doesn't exist is a no-op
+      if(ercp->GetRgnState() == CigiBaseEnvRgnCtrl::Destroyed)
+         return;
 
+      CrntRgn = new EnvRegion(RgnID);
+
+      // The region is added before the packet is applied, so that the 
+      // coordinate conversion observer (connected to addedRegion) sees 
+      // the region's first position change.
+      regions->addRegion(CrntRgn);
    }
 
-}
+   // Note - this may remove the region from the container, and thereby 
+   // delete it
+   CrntRgn->processEnvRegionCtrl(ercp);
 
+}
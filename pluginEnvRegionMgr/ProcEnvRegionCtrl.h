@@ -23,7 +23,7 @@
  *  
  *  PROGRAM DESCRIPTION: 
  *  This class contains the data and methods necessary to
- *   process the entity control packets.
+ *   process the environmental region control packets.
  *  
  *  MODIFICATION NOTES:
  *  DATE     NAME                                SCR NUMBER
@@ -32,6 +32,10 @@
  *  11/02/2005 Greg Basler                       MPV_CR_DR_1
  *  Initial Release.
  *
+ *  2026-10-19
+ *      Creates mpv::EnvRegion objects in an EnvRegionContainer, in place
+ *      of the old list and jump table.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -43,13 +47,12 @@
 
 
 #include "CigiBaseEventProcessor.h"
-#include "EnvRegion.h"
-#include <list>
+#include "EnvRegionContainer.h"
 
 
 
 //=========================================================
-//! This class processes an incoming entity control packet.
+//! This class processes an incoming environmental region control packet.
 //!
 class ProcEnvRegionCtrl : public CigiBaseEventProcessor  
 {
@@ -74,8 +77,8 @@ public:
 
 
    //=========================================================
-   //! A CIGI packet call back method processing the entity
-   //!   control packet.
+   //! A CIGI packet call back method processing the environmental 
+   //!   region control packet.
    //! \param Packet - A pointer to the incoming packet.
    //!
    virtual void OnPacketReceived(CigiBasePacket *Packet);
@@ -85,21 +88,12 @@ public:
 
 
    //=========================================================
-   //! Initializes the entity control processor
-   //! \param EntLstIn - A pointer to the EnvRegion list.
-   //! \param EnvRegionTableIn - A pointer to the entity jump table
-   //! \param PosConvIn - A pointer to the position conversion object
-   //! \param entityFactoryIn - A pointer to the entity factory object
+   //! Initializes the environmental region control processor
+   //! \param regionsIn - the container that regions are created in
    //!
-   void Init(std::list<EnvRegion> *EnvRegionLstIn,
-             std::list<EnvRegion>::iterator *EnvRegionTableIn,
-             CoordCigi2DBaseFunctionPtr CoordCigi2DBaseIn,
-             CoordDBase2CigiFunctionPtr CoordDBase2CigiIn)
+   void Init(mpv::EnvRegionContainer *regionsIn)
    {
-      EnvRegionLst = EnvRegionLstIn;
-      EnvRegionTable = EnvRegionTableIn;
-      CoordCigi2DBase = CoordCigi2DBaseIn;
-      CoordDBase2Cigi = CoordDBase2CigiIn;
+      regions = regionsIn;
    }
 
 
@@ -107,28 +101,9 @@ protected:
 
 
    //=========================================================
-   //! A pointer to the entity list
-   //!
-   std::list<EnvRegion> *EnvRegionLst;
-
-   //=========================================================
-   //! A pointer to the environmental region jump table
-   //!
-   std::list<EnvRegion>::iterator *EnvRegionTable;
-
-   //=========================================================
-   //! CoordCigi2DBase<br>
-   //! A pointer to the CIGI coordinate to Database coordinate
-   //!  member function of the position conversion plugin 
-   //!
-   CoordCigi2DBaseFunctionPtr CoordCigi2DBase;
-
-   //=========================================================
-   //! CoordDBase2Cigi<br>
-   //! A pointer to the Database coordinate to CIGI coordinate
-   //!  member function of the position conversion plugin 
+   //! The environmental regions
    //!
-   CoordDBase2CigiFunctionPtr CoordDBase2Cigi;
+   mpv::EnvRegionContainer *regions;
 
 
 };
@@ -23,7 +23,7 @@
  *  
  *  PROGRAM DESCRIPTION: 
  *  This class contains the data and methods necessary to
- *   process the component control packets.
+ *   process the weather control packets.
  *  
  *  MODIFICATION NOTES:
  *  DATE     NAME                                SCR NUMBER
@@ -32,6 +32,11 @@
  *  11/10/2005 Greg Basler                       MPV_CR_DR_1
  *  Initial Release.
  *
+ *  2026-10-19
+ *      Works on an EnvRegionContainer.  Global weather controls are now
+ *      handled too, and orphaned packets are matched to their region by
+ *      region ID rather than entity ID.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -40,6 +45,8 @@
 
 #include "ProcWeatherCtrl.h"
 
+using namespace mpv;
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -47,7 +54,8 @@
 // ================================================
 // ProcEnvRegionWeatherCtrl
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-ProcEnvRegionWeatherCtrl::ProcEnvRegionWeatherCtrl()
+ProcEnvRegionWeatherCtrl::ProcEnvRegionWeatherCtrl() : 
+   regions( NULL )
 {
 
 }
@@ -71,16 +79,19 @@ void ProcEnvRegionWeatherCtrl::OnPacketReceived(CigiBasePacket *Packet)
 {
    CigiWeatherCtrlV3 *ccp = (CigiWeatherCtrlV3 *)Packet;
 
-   // check the 'Scopy' for this Weather ctrl.
-   // We're only interested in 'regional' Weather controls
-   if(ccp->GetScope() == CigiBaseWeatherCtrl::Regional)
+   // check the 'Scope' for this Weather ctrl.
+   // Entity-scope weather is of no interest here.
+   if(ccp->GetScope() == CigiBaseWeatherCtrl::Global)
+   {
+      regions->processGlobalWeatherCtrl(ccp);
+   }
+   else if(ccp->GetScope() == CigiBaseWeatherCtrl::Regional)
    {
 
-      int RgnID = (int)ccp->GetRegionID();
-      std::list<EnvRegion>::iterator CrntRgn = *(EnvRegionTable + RgnID);
+      EnvRegion *CrntRgn = regions->findRegion((int)ccp->GetRegionID());
 
-      if(CrntRgn != EnvRegions->end())
-         CrntRgn->ProcWeatherCtrlPckt(ccp);
+      if(CrntRgn != NULL)
+         CrntRgn->processWeatherCtrl(ccp);
       else
          OrphanedWeatherCtrl.push_back(*ccp);
 
@@ -94,31 +105,26 @@ void ProcEnvRegionWeatherCtrl::OnPacketReceived(CigiBasePacket *Packet)
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void ProcEnvRegionWeatherCtrl::Act()
 {
-   // The OrphanedCompCtrl should usually be empty.  There are situations 
+   // The OrphanedWeatherCtrl should usually be empty.  There are situations 
    // where it will not be empty.  For example, it is possible (and allowable) 
-   // for the host to insert component control packets before the entity 
+   // for the host to insert weather control packets before the region 
    // creation packet in the message.
    
    if(OrphanedWeatherCtrl.empty())
       return;
 
-   int RgnID;
-   std::list<EnvRegion>::iterator CrntRgn;
+   EnvRegion *CrntRgn;
 
    std::list<CigiWeatherCtrlV3>::iterator occi;
    for(occi=OrphanedWeatherCtrl.begin();occi != OrphanedWeatherCtrl.end();occi++)
    {
-      RgnID = occi->GetEntityID();
-      CrntRgn = *(EnvRegionTable + RgnID);
+      CrntRgn = regions->findRegion((int)occi->GetRegionID());
 
-      if(CrntRgn != EnvRegions->end())
-         CrntRgn->ProcWeatherCtrlPckt(&(*occi));
+      if(CrntRgn != NULL)
+         CrntRgn->processWeatherCtrl(&(*occi));
 
    }
 
    OrphanedWeatherCtrl.clear();
 
 }
-
-
-
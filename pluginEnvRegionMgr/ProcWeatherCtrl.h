@@ -23,7 +23,7 @@
  *  
  *  PROGRAM DESCRIPTION: 
  *  This class contains the data and methods necessary to
- *   process the component control packets.
+ *   process the weather control packets.
  *  
  *  MODIFICATION NOTES:
  *  DATE     NAME                                SCR NUMBER
@@ -32,6 +32,11 @@
  *  11/10/2005 Greg Basler                       MPV_CR_DR_1
  *  Initial Release.
  *
+ *  2026-10-19
+ *      Works on an EnvRegionContainer.  Global weather controls are now
+ *      handled too, and orphaned packets are matched to their region by
+ *      region ID rather than entity ID.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -41,12 +46,16 @@
 #if !defined(_PROC_ENVIRONMENTAL_REGION_WEATHER_CTRL_INCLUDED_)
 #define _PROC_ENVIRONMENTAL_REGION_WEATHER_CTRL_INCLUDED_
 
+#include <list>
+
 #include "CigiBaseEventProcessor.h"
-#include "EnvRegion.h"
 #include "CigiWeatherCtrlV3.h"
+#include "EnvRegionContainer.h"
 
 //=========================================================
-//! This class processes an incoming component control packet.
+//! This class processes an incoming weather control packet, for the 
+//! global and regional scopes.  Entity-scope weather controls are left 
+//! to the entity plugins.
 //!
 class ProcEnvRegionWeatherCtrl : public CigiBaseEventProcessor  
 {
@@ -71,7 +80,7 @@ public:
 
 
    //=========================================================
-   //! A CIGI packet call back method processing the component 
+   //! A CIGI packet call back method processing the weather 
    //! control packet.
    //! \param Packet - A pointer to the incoming packet.
    //!
@@ -82,14 +91,12 @@ public:
 
 
    //=========================================================
-   //! Initializes the component control processor
-   //! \param EntityTableIn - A pointer to the Entity jump table.
+   //! Initializes the weather control processor
+   //! \param regionsIn - the environmental regions
    //!
-   void Init(std::list<EnvRegion> *EnvRegionsIn,
-             std::list<EnvRegion>::iterator *EnvRegionTableIn)
+   void Init(mpv::EnvRegionContainer *regionsIn)
    {
-      EnvRegions = EnvRegionsIn;
-      EnvRegionTable = EnvRegionTableIn;
+      regions = regionsIn;
    }
 
    //=========================================================
@@ -100,14 +107,9 @@ public:
 protected:
 
    //=========================================================
-   //! A pointer to the Environmental Region list
-   //!
-   std::list<EnvRegion> *EnvRegions;
-
-   //=========================================================
-   //! A pointer to the Environmental Region jump table
+   //! The environmental regions
    //!
-   std::list<EnvRegion>::iterator *EnvRegionTable;
+   mpv::EnvRegionContainer *regions;
 
    //=========================================================
    //! A list of orphaned weather controls
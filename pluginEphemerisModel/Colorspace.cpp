@@ -592,6 +592,21 @@ void XYZ_to_RGB709(float X, float Y, float Z, float &R, float &G, float &B) {
 	B =  0.055648f*X-0.204043f*Y+1.057311f*Z;
 }
 
+/**
+ * Convert n CIE XYZ colors to RGB709, as XYZ_to_RGB709.
+ *
+ * The colors are given as separate arrays of components, so that the
+ * loop can be vectorized.  The output arrays may alias the inputs.
+ */
+void XYZ_to_RGB709_batch(int n, const float *X, const float *Y, const float *Z, float *R, float *G, float *B) {
+	for (int i = 0; i < n; ++i) {
+		float x = X[i], y = Y[i], z = Z[i];
+		R[i] =  3.240479f*x-1.537150f*y-0.498535f*z;
+		G[i] = -0.969256f*x+1.875992f*y+0.041556f*z;
+		B[i] =  0.055648f*x-0.204043f*y+1.057311f*z;
+	}
+}
+
 /**
  * Convert RGB709 to CIE XYZ color coordinates.
  *
@@ -637,6 +652,26 @@ void xyY_to_XYZ(float x, float y, float Y_, float &X, float &Y, float &Z) {
 	}
 }
 
+/**
+ * Convert n CIE xyY colors to CIE XYZ, as xyY_to_XYZ.
+ *
+ * The colors are given as separate arrays of components, so that the
+ * loop can be vectorized; the branches of xyY_to_XYZ are replaced by
+ * selects.  Unlike xyY_to_XYZ, a chromaticity y of zero produces black
+ * rather than a division by zero.  The output arrays may alias the inputs.
+ */
+void xyY_to_XYZ_batch(int n, const float *x, const float *y, const float *Y_, float *X, float *Y, float *Z) {
+	for (int i = 0; i < n; ++i) {
+		float xi = x[i], yi = y[i], Yi = Y_[i];
+		float s = (Yi != 0.0f && yi != 0.0f) ? Yi / yi : 0.0f;
+		float Xo = xi * s;
+		float Zo = (1.0f - xi - yi) * s;
+		X[i] = Xo < 0.0f ? 0.0f : Xo;
+		Y[i] = Yi;
+		Z[i] = Zo < 0.0f ? 0.0f : Zo;
+	}
+}
+
 /**
  * Correct out-of-range CIE xyY color coordinates.
  */
@@ -53,8 +53,10 @@ void uvpY_to_XYZ(float uprime, float vprime, float Y_, float &X, float &Y, float
 void xy_to_uvwp(float x, float y, float &uprime, float &vprime, float &wprime);
 void xyY_check(float &x, float &y, float &Y);
 void xyY_to_XYZ(float x, float y, float Y_, float &X, float &Y, float &Z);
+void xyY_to_XYZ_batch(int n, const float *x, const float *y, const float *Y_, float *X, float *Y, float *Z);
 void XYZ_to_Luv(float X, float Y, float Z, float &Lstar, float &ustar, float &vstar);
 void XYZ_to_RGB709(float X, float Y, float Z, float &R, float &G, float &B);
+void XYZ_to_RGB709_batch(int n, const float *X, const float *Y, const float *Z, float *R, float *G, float *B);
 void RGB709_to_XYZ(float R, float G, float B, float &X, float &Y, float &Z);
 float getY709(float R, float G, float B);
 void XYZ_to_uvwp(float X, float Y, float Z, float &uprime, float &vprime, float &wprime);
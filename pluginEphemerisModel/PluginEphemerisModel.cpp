@@ -68,6 +68,7 @@ PluginEphemerisModel::PluginEphemerisModel() : Plugin(),
 	dependencies_.push_back( "PluginViewMgr" );
 
 	ImsgPtr = NULL;
+	DefFileData = NULL;
 	
 	allEntities = NULL;
 	viewMap = NULL;
@@ -141,6 +142,8 @@ void PluginEphemerisModel::act( SystemState::ID state, StateContext &stateContex
 
 		bb_->get( "CigiIncomingMsg", ImsgPtr );
 
+		bb_->get( "DefinitionData", DefFileData );
+
 		bb_->get( "AllEntities", allEntities );
 
 		// get the view parameters
@@ -155,6 +158,10 @@ void PluginEphemerisModel::act( SystemState::ID state, StateContext &stateContex
 
 		break;
 
+	case SystemState::ConfigurationProcess:
+		getConfig();
+		break;
+
 	case SystemState::Operate:
 	case SystemState::Debug:
 		{
@@ -283,6 +290,24 @@ CoordSet PluginEphemerisModel::getOwnshipLocation( void )
 }
 
 
+// ================================================
+// getConfig
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginEphemerisModel::getConfig()
+{
+	if( DefFileData == NULL || *DefFileData == NULL )
+		return;
+	
+	DefFileGroup *ephemerisGroup = (*DefFileData)->getGroupByURI( "/ephemeris/" );
+	if( ephemerisGroup == NULL )
+		return;
+	
+	DefFileAttrib *attr = ephemerisGroup->getAttribute( "sky_colors_thread" );
+	if( attr && attr->asInt() )
+		m_SkyColors.setUseWorkerThread( true );
+}
+
+
 // ================================================
 // updateEphemeris
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
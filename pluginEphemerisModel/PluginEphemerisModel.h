@@ -54,6 +54,7 @@
 #include "CoordSet.h"
 #include "Entity.h"
 #include "View.h"
+#include "DefFileGroup.h"
 
 #include "Date.h"
 #include "SkyColors.h"
@@ -96,6 +97,11 @@ private:
 	//!
 	CigiIncomingMsg *ImsgPtr;
 	
+	//=========================================================
+	//! Configuration data.  Retrieved from the blackboard.
+	//!
+	DefFileGroup **DefFileData;
+	
 	//=========================================================
 	//! An entity container containing all active entities. 
 	//! This data is necessary for finding out 
@@ -244,6 +250,11 @@ private:
 	//!
 	CoordSet getOwnshipLocation( void );
 
+	//=========================================================
+	//! Reads the plugin's settings from the "ephemeris" def file group
+	//!
+	void getConfig();
+
 	void updateEphemeris( double lat, double lon, simdata::SimDate const &t );
 	void updateSkyColors();
 	void updateSun();
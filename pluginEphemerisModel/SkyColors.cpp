@@ -3,6 +3,9 @@
 #define _USE_MATH_DEFINES
 
 #include <math.h>
+#include <string.h>
+
+#include <OpenThreads/ScopedLock>
 
 #include "SkyColors.h"
 #include "Date.h"
@@ -15,8 +18,21 @@ SkyColors::SkyColors()
 
 SkyColors::~SkyColors()
 {
+	if( m_threadRunning )
+	{
+		{
+			OpenThreads::ScopedLock<OpenThreads::Mutex> lock( m_mutex );
+			m_threadQuit = true;
+			m_requestCondition.signal();
+		}
+		join();
+	}
+
 	delete [] m_lev;
+	delete [] m_elev;
 	delete [] colors;
+	delete [] m_workColors;
+	delete [] m_backColors;
 }
 
 
@@ -24,8 +40,15 @@ void SkyColors::init()
 {
 	m_ZenithIntensity = 0.0;
 	m_AverageIntensity = 0.0;
-	m_AverageIntensityTemp = 0.0;
-	m_skyShadingLeftoff = 0;
+
+	m_threadRunning = false;
+	m_threadQuit = false;
+	m_requestPending = false;
+	m_requestSunH = m_requestSunA = 0.0;
+	m_requestMoon = 0.0;
+	m_resultReady = false;
+	m_backZenithIntensity = 0.0;
+	m_backAverageIntensity = 0.0;
 
 	m_lev = new float[90];
 	float base_elev = -10.0;
@@ -45,34 +68,101 @@ void SkyColors::init()
 		}
 	}
 	m_nseg = 37;
+
+	m_elev = new float[m_nlev];
+	for( int i = 0; i < m_nlev; ++i )
+	{
+		double elev = degreesToRadians( m_lev[i] );
+		if( elev < 0.0 ) elev = 0.0; // sub horizon colors aren't correct
+		m_elev[i] = elev;
+	}
 	
 	colors = new float[m_nseg * m_nlev * 4];
+	m_workColors = new float[m_nseg * m_nlev * 4];
+	m_backColors = new float[m_nseg * m_nlev * 4];
 
-	int offset, ci = 0;
-	for( int i = 0; i < m_nlev; ++i )
+	for( int i = 0; i < m_nseg * m_nlev * 4; ++i )
+		colors[i] = 1.0;
+}
+
+void SkyColors::setUseWorkerThread( bool useThread )
+{
+	if( useThread && !m_threadRunning )
 	{
-		for( int j = 0; j < m_nseg; ++j )
-		{
-			offset = ci * 4;
-			colors[offset + 0] = 1.0;
-			colors[offset + 1] = 1.0;
-			colors[offset + 2] = 1.0;
-			colors[offset + 3] = 1.0;
+		m_threadQuit = false;
+		m_threadRunning = true;
+		start();
+	}
+}
 
-			++ci;
+void SkyColors::update( double sun_h, double sun_A, float moonBrightness ) 
+{
+	if( !m_threadRunning )
+	{
+		shade( sun_h, sun_A, moonBrightness, 
+			colors, m_ZenithColor, m_ZenithIntensity, m_AverageIntensity );
+		return;
+	}
+
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( m_mutex );
+
+	// publish the worker's latest result
+	if( m_resultReady )
+	{
+		memcpy( colors, m_backColors, sizeof( float ) * m_nseg * m_nlev * 4 );
+		m_ZenithColor = m_backZenithColor;
+		m_ZenithIntensity = m_backZenithIntensity;
+		m_AverageIntensity = m_backAverageIntensity;
+		m_resultReady = false;
+	}
+
+	// and give it the new sun position; if it's still busy with the last 
+	// one, this simply replaces the request it will pick up next
+	m_requestSunH = sun_h;
+	m_requestSunA = sun_A;
+	m_requestMoon = moonBrightness;
+	m_requestPending = true;
+	m_requestCondition.signal();
+}
+
+void SkyColors::run()
+{
+	while( true )
+	{
+		double sun_h, sun_A;
+		float moonBrightness;
+		{
+			OpenThreads::ScopedLock<OpenThreads::Mutex> lock( m_mutex );
+			while( !m_requestPending && !m_threadQuit )
+				m_requestCondition.wait( &m_mutex );
+			if( m_threadQuit )
+				return;
+			sun_h = m_requestSunH;
+			sun_A = m_requestSunA;
+			moonBrightness = m_requestMoon;
+			m_requestPending = false;
 		}
+
+		Color zenithColor;
+		float zenithIntensity, averageIntensity;
+		shade( sun_h, sun_A, moonBrightness, 
+			m_workColors, zenithColor, zenithIntensity, averageIntensity );
+
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( m_mutex );
+		memcpy( m_backColors, m_workColors, sizeof( float ) * m_nseg * m_nlev * 4 );
+		m_backZenithColor = zenithColor;
+		m_backZenithIntensity = zenithIntensity;
+		m_backAverageIntensity = averageIntensity;
+		m_resultReady = true;
 	}
 }
 
-void SkyColors::update( double sun_h, double sun_A, float moonBrightness ) 
+void SkyColors::shade( double sun_h, double sun_A, float moonBrightness, 
+	float *out, Color &zenithColor, float &zenithIntensity, 
+	float &averageIntensity )
 {
 	double da = 2.0 * M_PI / (m_nseg);
-	double min_a = 0.5*da;
-	double jitter = 0.0;
-	int i, j, offset, ci = 0;
 
-//	simdata::SimTime t = simdata::SimDate::getSystemTime();
-	
 	m_SkyShader.setSunElevation( sun_h );
 	
 	float light_h = sun_h;
@@ -81,61 +171,16 @@ void SkyColors::update( double sun_h, double sun_A, float moonBrightness )
 		light_h = 0.0;
 	}
 	// get the sky shading at the position of the sun
-	m_ZenithColor = m_SkyShader.SkyColor( light_h, 0.0, 0.0, m_ZenithIntensity );
+	zenithColor = m_SkyShader.SkyColor( light_h, 0.0, 0.0, zenithIntensity );
 
-//	osg::Vec4 horizon_average;
-	for( i = m_skyShadingLeftoff; i < m_skyShadingLeftoff+1 && i < m_nlev; ++i )
-	{
-		ci = i * m_nseg;
-		double elev = degreesToRadians( m_lev[i] );
-		if( elev < 0.0 ) elev = 0.0; // sub horizon colors aren't correct
-		double azimuth = -sun_A - 0.5 * M_PI;
-		bool at_vertex = fabs(elev - sun_h) < min_a; // this is only a rough measure
-		for( j = 0; j < m_nseg; ++j )
-		{
-			float intensity;
-			// if the sun lines up very close to a vertex, the vertex will be
-			// pure white and create a noticible artifact on the surrounding
-			// triangles.
-			if( at_vertex && (fabs(azimuth) < min_a) )
-			{
-				jitter = 0.0; //da;
-			} else {
-				jitter = 0.0;
-			}
-			Color c = m_SkyShader.SkyColor(elev, azimuth+jitter, moonBrightness, intensity);
-			azimuth += da;
-			offset = ci * 4;
-			colors[offset + 0] = c.getA();
-			colors[offset + 1] = c.getB();
-			colors[offset + 2] = c.getC();
-			colors[offset + 3] = 1.0;
-			if( i == m_HorizonIndex )
-			{
-//				(*m_HorizonColors)[j] = colors[ci];
-//				horizon_average += colors[ci];
-			}
-			++ci;
-			m_AverageIntensityTemp += intensity;
-		}
-	}
-	m_skyShadingLeftoff = i;
-	
-	if( m_skyShadingLeftoff >= m_nlev )
-	{
-		// The sky colors have all been calculated, and the array of colors 
-		// is now valid.
-
-		m_skyShadingLeftoff = 0;
-		
-//		m_Horizon->updateHorizonColors(*m_HorizonColors);
-		m_AverageIntensity = m_AverageIntensityTemp / (m_nlev*m_nseg);
-		m_AverageIntensityTemp = 0.0;
-
-//		simdata::SimTime u = simdata::SimDate::getSystemTime();
-//		std::cout << "Sky update time (vertex based, not texture based): " << ((u-t)*1000.0) << " ms\n";
-		
-	}
+	// The whole dome is shaded every time.  This used to be spread over 
+	// several frames, one elevation per frame, which made the sky lag 
+	// behind fast time-of-day changes; the batch evaluator is fast enough 
+	// not to need that.
+	float intensitySum = m_SkyShader.SkyColorGrid( m_nlev, m_elev, 
+		m_nseg, -sun_A - 0.5 * M_PI, da, moonBrightness, out );
+
+	averageIntensity = intensitySum / (m_nlev*m_nseg);
 }
 
 
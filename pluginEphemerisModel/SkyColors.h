@@ -1,11 +1,14 @@
-
 #ifndef __SKYCOLORS_H__
 #define __SKYCOLORS_H__
 
+#include <OpenThreads/Mutex>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Thread>
+
 #include "Colorspace.h"
 #include "SkyShader.h"
 
-class SkyColors
+class SkyColors : protected OpenThreads::Thread
 {
 public:
 	SkyColors();
@@ -13,6 +16,12 @@ public:
 
 	void update( double sun_h, double sun_A, float moonBrightness );
 	
+	// Moves the shading onto a worker thread.  update() then hands the 
+	// sun position to the worker and publishes the most recent finished 
+	// result, so the colors lag the sun by a frame.  Should be called 
+	// before the first update().
+	void setUseWorkerThread( bool useThread );
+	
 	float getAverageIntensity() { return m_AverageIntensity; }
 	Color getZenithColor() { return m_ZenithColor; }
 	float getZenithIntensity() { return m_ZenithIntensity; }
@@ -31,22 +40,45 @@ private:
 	float m_ZenithIntensity;
 	float m_AverageIntensity;
 	
-	 // A temporary variable to help with incremental calculation of 
-	 // m_AverageIntensity
-	 float m_AverageIntensityTemp;
-
-	// Used for incremental calculation of sky dome colors.
-	int m_skyShadingLeftoff;
+	// m_lev converted to radians, with the sub-horizon levels raised to 
+	// the horizon (sub horizon colors aren't correct)
+	float *m_elev;
 	
 	// the shader object - calculates sky colors given the sun position 
 	// and the moon ambient brightness
 	SkyShader m_SkyShader;
 	
-	// the output array
+	// the output array; its address is posted to the blackboard, so it 
+	// never changes
 	float *colors;
 
+	// Worker thread state.  The worker shades into m_workColors without 
+	// holding the lock, then copies the result to m_backColors; update() 
+	// copies m_backColors to colors.
+	bool m_threadRunning;
+	bool m_threadQuit;
+	OpenThreads::Mutex m_mutex;
+	OpenThreads::Condition m_requestCondition;
+	bool m_requestPending;
+	double m_requestSunH, m_requestSunA;
+	float m_requestMoon;
+	bool m_resultReady;
+	float *m_workColors;
+	float *m_backColors;
+	Color m_backZenithColor;
+	float m_backZenithIntensity;
+	float m_backAverageIntensity;
+
 	void init();
 
+	// shades the whole dome into the given array
+	void shade( double sun_h, double sun_A, float moonBrightness, 
+		float *out, Color &zenithColor, float &zenithIntensity, 
+		float &averageIntensity );
+
+	// worker thread main loop
+	virtual void run();
+
 	void writePPMImageFile();
 };
 
@@ -245,3 +245,117 @@ Color SkyShader::SkyColor(float elevation, float azimuth, float dark, float &int
 	return rgb;
 }
 
+
+float SkyShader::SkyColorGrid(int nlev, const float *elevation, int nseg, float azimuth, float dAzimuth, float dark, float *rgba) {
+	if (m_Dirty) _computeBase();
+	if (nseg <= 0) return 0.0;
+
+	m_GridSinA.resize(nseg);
+	m_GridCosA.resize(nseg);
+	m_GridX.resize(nseg);
+	m_GridY.resize(nseg);
+	m_GridZ.resize(nseg);
+	float *sinA = &m_GridSinA[0];
+	float *cosA = &m_GridCosA[0];
+	float *X = &m_GridX[0];
+	float *Y = &m_GridY[0];
+	float *Z = &m_GridZ[0];
+
+	// the azimuth terms are the same for every row
+	for (int j = 0; j < nseg; ++j) {
+		float A = azimuth + j * dAzimuth + m_AzimuthCorrection;
+		sinA[j] = sinf(A);
+		cosA[j] = cosf(A);
+	}
+
+	coeff &px = m_Coefficients.x;
+	coeff &py = m_Coefficients.y;
+	coeff &pY = m_Coefficients.Y;
+	float Yscale = (m_MaxY > 0.0) ? m_OverLuminescence / m_MaxY : 1.0f;
+	bool halo_sqrt = (m_HaloSharpness == 0.5f);
+	float moonR = m_FullMoonColor.getA() * dark;
+	float moonG = m_FullMoonColor.getB() * dark;
+	float moonB = m_FullMoonColor.getC() * dark;
+	float intensitySum = 0.0;
+
+	for (int i = 0; i < nlev; ++i) {
+		float theta = 0.5*M_PI - elevation[i];
+		float sin_theta = sinf(theta);
+		float cos_theta = cosf(theta);
+		float sx = sin_theta * m_SunVector[0];
+		float sy = sin_theta * m_SunVector[1];
+		float sz = cos_theta * m_SunVector[2];
+
+		// the theta-dependent half of F(), and the FastPerez scaling, 
+		// once per row
+		float theta_c = (theta > 1.57f) ? 1.57f : theta;
+#ifdef CUSTOM
+		float cos_t = fabs(cosf(theta_c)) + 0.09;
+#else
+		float cos_t = cosf(theta_c);
+#endif
+		float rowx = m_PerezFactor.x * m_Zenith.getA() * (1.0f + px[0]*expf(px[1]/cos_t));
+		float rowy = m_PerezFactor.y * m_Zenith.getB() * (1.0f + py[0]*expf(py[1]/cos_t));
+		float rowY = m_PerezFactor.Y * m_Zenith.getC() * (1.0f + pY[0]*expf(pY[1]/cos_t));
+
+		// Perez model; X, Y and Z temporarily hold x, y and Y.  cos(gamma)
+		// is the dot product itself, so it isn't recomputed.
+		for (int j = 0; j < nseg; ++j) {
+			float dot = sinA[j]*sx + cosA[j]*sy + sz;
+			dot = (dot < -1.0f) ? -1.0f : ((dot > 1.0f) ? 1.0f : dot);
+			float gamma = acosf(dot);
+			float cos_g2 = dot*dot;
+			X[j] = rowx * (1.0f + px[2]*expf(px[3]*gamma) + px[4]*cos_g2);
+			Y[j] = rowy * (1.0f + py[2]*expf(py[3]*gamma) + py[4]*cos_g2);
+			Z[j] = rowY * (1.0f + pY[2]*expf(pY[3]*gamma) + pY[4]*cos_g2);
+		}
+
+#ifdef CUSTOM
+		// luminance adjustments, as in SkyColor
+		if (halo_sqrt) {
+			for (int j = 0; j < nseg; ++j) {
+				float cieY = Z[j] * Yscale;
+				cieY = (cieY < 0.0f) ? 0.0f : cieY;
+				cieY = sqrtf(cieY) * m_F;
+				Z[j] = (cieY > 1.0f) ? 1.0f : cieY;
+			}
+		} else {
+			for (int j = 0; j < nseg; ++j) {
+				float cieY = Z[j] * Yscale;
+				cieY = (cieY < 0.0f) ? 0.0f : cieY;
+				cieY = powf(cieY, m_HaloSharpness) * m_F;
+				Z[j] = (cieY > 1.0f) ? 1.0f : cieY;
+			}
+		}
+#endif
+		for (int j = 0; j < nseg; ++j)
+			intensitySum += Z[j];
+
+		xyY_to_XYZ_batch(nseg, X, Y, Z, X, Y, Z);
+		XYZ_to_RGB709_batch(nseg, X, Y, Z, X, Y, Z);
+
+		// clamp, add the moonlight and clamp again, as toRGB(), 
+		// composite() and check() do in SkyColor
+		float *out = rgba + i * nseg * 4;
+		for (int j = 0; j < nseg; ++j) {
+			float R = X[j], G = Y[j], B = Z[j];
+			R = (R < 0.0f) ? 0.0f : ((R > 1.0f) ? 1.0f : R);
+			G = (G < 0.0f) ? 0.0f : ((G > 1.0f) ? 1.0f : G);
+			B = (B < 0.0f) ? 0.0f : ((B > 1.0f) ? 1.0f : B);
+#ifdef CUSTOM
+			R += moonR;
+			G += moonG;
+			B += moonB;
+			R = (R < 0.0f) ? 0.0f : ((R > 1.0f) ? 1.0f : R);
+			G = (G < 0.0f) ? 0.0f : ((G > 1.0f) ? 1.0f : G);
+			B = (B < 0.0f) ? 0.0f : ((B > 1.0f) ? 1.0f : B);
+#endif
+			out[j*4 + 0] = R;
+			out[j*4 + 1] = G;
+			out[j*4 + 2] = B;
+			out[j*4 + 3] = 1.0;
+		}
+	}
+
+	return intensitySum;
+}
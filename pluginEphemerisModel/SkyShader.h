@@ -19,6 +19,8 @@
 #ifndef __SKYSHADER_H__
 #define __SKYSHADER_H__
 
+#include <vector>
+
 #include "Colorspace.h"
 
 class SkyShader {
@@ -47,6 +49,10 @@ protected:
 	float m_AzimuthCorrection;
 	perez m_PerezFactor;
 	bool m_Dirty;
+
+	// scratch arrays for SkyColorGrid, one entry per azimuth
+	std::vector<float> m_GridSinA, m_GridCosA;
+	std::vector<float> m_GridX, m_GridY, m_GridZ;
 	
 	/**
 	 * Get Skylight Distribution Coefficients (c.f. Preetham et al.) for
@@ -102,6 +108,24 @@ public:
 	void setTurbidity(float T);
 	void setSunElevation(float h);
 	Color SkyColor(float elevation, float azimuth, float dark, float &intensity);
+
+	/**
+	 * Shade a grid of sky directions at once.  Equivalent to calling
+	 * SkyColor for every (elevation, azimuth) pair, but the terms that
+	 * depend only on elevation or only on azimuth are computed once per
+	 * row or column, and each row is processed as a set of flat loops
+	 * that the compiler can vectorize.
+	 *
+	 * @param nlev Number of elevations (rows).
+	 * @param elevation Elevations of the rows (radians).
+	 * @param nseg Number of azimuths (columns).
+	 * @param azimuth Azimuth of the first column (radians).
+	 * @param dAzimuth Azimuth step between columns (radians).
+	 * @param dark Moon ambient brightness, as for SkyColor.
+	 * @param rgba Output, nlev*nseg RGBA colors; alpha is set to 1.
+	 * @return The sum of the intensities of all of the grid points.
+	 */
+	float SkyColorGrid(int nlev, const float *elevation, int nseg, float azimuth, float dAzimuth, float dark, float *rgba);
 };
 
 #endif
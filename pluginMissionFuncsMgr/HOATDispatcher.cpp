@@ -20,6 +20,9 @@
  *  2008-09-01 AUTHORNAME
  *      Initial release
  *  
+ *  2026-10-19
+ *      Added periodic (continuous) requests.
+ *  
  *  
  *  </pre>
  */
@@ -30,12 +33,14 @@
 #endif
 
 #include <math.h>
-#include <iostream>
+#include <algorithm>
+#include <vector>
 
 #include <CigiHatHotRespV3_2.h>
 #include <CigiHatHotXRespV3_2.h>
 
 #include "BindSlot.h"
+#include "Log.h"
 
 #include "HOATDispatcher.h"
 
@@ -49,7 +54,9 @@ HOATDispatcher::HOATDispatcher() : Referenced(),
 	allEntities( NULL ),
 	numWorkers( 0 ),
 	terrainMaterialOverride( false ),
-	terrainMaterialOverrideCode( 0 )
+	terrainMaterialOverrideCode( 0 ),
+	periodicEvaluationsPerFrame( 0 ),
+	periodicTolerance( -1.0 )
 {
 	
 }
@@ -68,11 +75,43 @@ void HOATDispatcher::processRequest( CigiHatHotReqV3_2 *packet )
 {
 	if( numWorkers == 0 )
 	{
-		std::cout << "HOATDispatcher::processRequest - no workers; discarding HOT request " 
-			<< packet->GetHatHotID() << std::endl;
+		MPV_LOG_ERROR( "HOATDispatcher::processRequest - no workers; discarding HOT request " 
+			<< packet->GetHatHotID() );
 		return;
 	}
 	
+	// A new request replaces a periodic request with the same ID.  (A 
+	// one-shot request is how the Host cancels a periodic one.)
+	periodicRequests.erase( packet->GetHatHotID() );
+	
+	RefPtr<HOTRequest> request = buildRequest( packet );
+	if( !request.valid() )
+		return;
+	
+	if( packet->GetUpdatePeriod() != 0 )
+	{
+		if( packet->GetSrcCoordSys() == CigiBaseHatHotReq::Entity )
+		{
+			// the request is rebuilt from the packet each time it's due
+			PeriodicRequest &periodic = periodicRequests[request->id];
+			periodic.packet = *packet;
+		}
+		else
+		{
+			MPV_LOG_WARNING( "HOATDispatcher::processRequest - Host sent nonsensical HOT/HAT request: requested continuous responses on a geodetic position (HOT request " 
+				<< packet->GetHatHotID() << ")" );
+		}
+	}
+	
+	dispatchRequest( request.get() );
+}
+
+
+// ================================================
+// buildRequest
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+RefPtr<HOTRequest> HOATDispatcher::buildRequest( CigiHatHotReqV3_2 *packet )
+{
 	RefPtr<HOTRequest> request = new HOTRequest();
 	
 	request->id = packet->GetHatHotID();
@@ -86,10 +125,10 @@ void HOATDispatcher::processRequest( CigiHatHotReqV3_2 *packet )
 		Entity *entity = allEntities->findEntity( packet->GetEntityID() );
 		if( entity == NULL )
 		{
-			std::cout << "HOATDispatcher::processRequest - entity " 
+			MPV_LOG_WARNING( "HOATDispatcher::processRequest - entity " 
 				<< packet->GetEntityID() << " doesn't exist; discarding HOT request " 
-				<< packet->GetHatHotID() << std::endl;
-			return;
+				<< packet->GetHatHotID() );
+			return NULL;
 		}
 		
 		Mtx4 entityTransform = entity->getAbsoluteTransform();
@@ -137,11 +176,6 @@ void HOATDispatcher::processRequest( CigiHatHotReqV3_2 *packet )
 
 		//fixme - geocentric db's (ent will prolly get an "up" eventually, so just pull value from there)
 		request->up.Set( 0., 0., 1. );
-		
-		if( packet->GetUpdatePeriod() != 0 )
-			std::cout << "HOATDispatcher::processRequest - warning/fixme - continuous HOT/HAT requests are not supported (HOT request " 
-				<< packet->GetHatHotID() << ")\n";
-		
 	}
 	else
 	{
@@ -183,22 +217,26 @@ void HOATDispatcher::processRequest( CigiHatHotReqV3_2 *packet )
 		
 		//fixme - geocentric db's
 		request->up.Set( 0., 0., 1. );
-		
-		if( packet->GetUpdatePeriod() != 0 )
-			std::cout << "HOATDispatcher::processRequest - warning - Host sent nonsensical HOT/HAT request: requested continuous responses on a geodetic position (HOT request " 
-				<< packet->GetHatHotID() << ")\n";
 	}
 	
+	return request;
+}
 
+
+// ================================================
+// dispatchRequest
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void HOATDispatcher::dispatchRequest( HOTRequest *request )
+{
 	RequestEntryMap::iterator iter = requests.find( request->id );
 	if( iter != requests.end() )
 	{
-		std::cout << "HOATDispatcher::processRequest - warning - HOT request ID " 
-			<< packet->GetHatHotID() << " is still active.  \n"
-			<< "\tDiscarding previous request with same ID.  Expect strange behavior.\n";
+		MPV_LOG_WARNING( "HOATDispatcher::processRequest - HOT request ID " 
+			<< request->id << " is still active; "
+			<< "discarding the previous request with the same ID.  Expect strange behavior." );
 	}
 	RequestEntry entry;
-	entry.request = request.get();
+	entry.request = request;
 	requests[request->id] = entry;
 	
 	// finally, emit signal
@@ -224,6 +262,8 @@ void HOATDispatcher::queueResponse( int requestID, mpv::HOTResponseList &respons
 
 void HOATDispatcher::sendResponses( CigiOutgoingMsg *outgoing )
 {
+	updatePeriodicRequests( outgoing );
+	
 	std::list<RequestEntryMap::iterator> completedRequests;
 	
 	RequestEntryMap::iterator requestIter;
@@ -238,33 +278,18 @@ void HOATDispatcher::sendResponses( CigiOutgoingMsg *outgoing )
 		// sent
 		if( workerResponseList.size() >= numWorkers )
 		{
-			int numResponses = 0;
-		
-			// need to total the responses
-			std::list< mpv::HOTResponseList >::iterator workerIter;
-			for( workerIter = workerResponseList.begin(); workerIter != workerResponseList.end(); workerIter++ )
-			{
-				numResponses += workerIter->size();
-			}
-
-			if( numResponses > 0 )
-			{
-				std::list< mpv::HOTResponseList >::iterator workerIter;
-				for( workerIter = workerResponseList.begin(); workerIter != workerResponseList.end(); workerIter++ )
-				{
-					mpv::HOTResponseList::iterator responseIter;
-					for( responseIter = workerIter->begin(); responseIter != workerIter->end(); responseIter++ )
-					{
-						if( request->type == CigiBaseHatHotReq::Extended )
-							sendExtendedResponse( outgoing, request, responseIter->get(), numResponses );
-						else
-							sendResponse( outgoing, request, responseIter->get(), numResponses );
-					}
-				}
-			}
-			else
+			sendResponseLists( outgoing, request, workerResponseList );
+			
+			// periodic requests keep their results, for reuse if the 
+			// entity hasn't moved by the next time they're due
+			PeriodicRequestMap::iterator periodicIter = periodicRequests.find( requestID );
+			if( periodicIter != periodicRequests.end() )
 			{
-				sendMissResponse( outgoing, requestID );
+				PeriodicRequest &periodic = periodicIter->second;
+				periodic.framesUntilDue = periodic.packet.GetUpdatePeriod();
+				periodic.haveResults = true;
+				periodic.resultsLocation = request->location;
+				periodic.results = workerResponseList;
 			}
 			
 			// request has been handled
@@ -281,6 +306,138 @@ void HOATDispatcher::sendResponses( CigiOutgoingMsg *outgoing )
 }
 
 
+// ================================================
+// updatePeriodicRequests
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void HOATDispatcher::updatePeriodicRequests( CigiOutgoingMsg *outgoing )
+{
+	// find the requests that are due, most overdue first
+	std::vector< std::pair<int, int> > dueRequests;
+	PeriodicRequestMap::iterator iter;
+	for( iter = periodicRequests.begin(); iter != periodicRequests.end(); iter++ )
+	{
+		// requests still with the workers wait until their results are in
+		if( requests.find( iter->first ) != requests.end() )
+			continue;
+		
+		PeriodicRequest &periodic = iter->second;
+		periodic.framesUntilDue--;
+		if( periodic.framesUntilDue <= 0 )
+			dueRequests.push_back( std::make_pair( periodic.framesUntilDue, iter->first ) );
+	}
+	std::sort( dueRequests.begin(), dueRequests.end() );
+	
+	int evaluations = 0;
+	std::list<int> cancelledRequests;
+	for( unsigned int i = 0; i < dueRequests.size(); i++ )
+	{
+		int requestID = dueRequests[i].second;
+		PeriodicRequest &periodic = periodicRequests[requestID];
+		
+		RefPtr<HOTRequest> request = buildRequest( &periodic.packet );
+		if( !request.valid() )
+		{
+			// the entity is gone, and the request with it
+			cancelledRequests.push_back( requestID );
+			continue;
+		}
+		
+		// The intersections depend only on the horizontal position of the 
+		// test point; HAT is measured from the new position, so vertical 
+		// movement alone doesn't call for a new intersection test.
+		if( periodic.haveResults )
+		{
+			Vect3 delta = request->location - periodic.resultsLocation;
+			Vect3 horizontal = delta - request->up * ( delta * request->up );
+			if( horizontal.mag() <= periodicTolerance )
+			{
+				sendResponseLists( outgoing, request.get(), periodic.results );
+				periodic.framesUntilDue = periodic.packet.GetUpdatePeriod();
+				continue;
+			}
+		}
+		
+		// Over budget, the request stays due, and is near the front of 
+		// the queue next frame.  The late response shifts the request's 
+		// schedule, which spreads bunched-up requests across frames.
+		if( periodicEvaluationsPerFrame > 0 && 
+			evaluations >= periodicEvaluationsPerFrame )
+			continue;
+		evaluations++;
+		
+		dispatchRequest( request.get() );
+	}
+	
+	std::list<int>::iterator cancelledIter;
+	for( cancelledIter = cancelledRequests.begin(); cancelledIter != cancelledRequests.end(); cancelledIter++ )
+	{
+		periodicRequests.erase( *cancelledIter );
+	}
+}
+
+
+// ================================================
+// invalidatePeriodicResults
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void HOATDispatcher::invalidatePeriodicResults()
+{
+	PeriodicRequestMap::iterator iter;
+	for( iter = periodicRequests.begin(); iter != periodicRequests.end(); iter++ )
+	{
+		iter->second.haveResults = false;
+		iter->second.results.clear();
+	}
+}
+
+
+// ================================================
+// reset
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void HOATDispatcher::reset()
+{
+	requests.clear();
+	periodicRequests.clear();
+}
+
+
+// ================================================
+// sendResponseLists
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void HOATDispatcher::sendResponseLists( 
+	CigiOutgoingMsg *outgoing, 
+	HOTRequest *request, 
+	std::list< mpv::HOTResponseList > &workerResponseList )
+{
+	int numResponses = 0;
+
+	// need to total the responses
+	std::list< mpv::HOTResponseList >::iterator workerIter;
+	for( workerIter = workerResponseList.begin(); workerIter != workerResponseList.end(); workerIter++ )
+	{
+		numResponses += workerIter->size();
+	}
+
+	if( numResponses > 0 )
+	{
+		for( workerIter = workerResponseList.begin(); workerIter != workerResponseList.end(); workerIter++ )
+		{
+			mpv::HOTResponseList::iterator responseIter;
+			for( responseIter = workerIter->begin(); responseIter != workerIter->end(); responseIter++ )
+			{
+				if( request->type == CigiBaseHatHotReq::Extended )
+					sendExtendedResponse( outgoing, request, responseIter->get(), numResponses );
+				else
+					sendResponse( outgoing, request, responseIter->get(), numResponses );
+			}
+		}
+	}
+	else
+	{
+		sendMissResponse( outgoing, request );
+	}
+}
+
+
 void HOATDispatcher::sendResponse( 
 	CigiOutgoingMsg *outgoing, 
 	HOTRequest *request, 
@@ -368,19 +525,8 @@ void HOATDispatcher::sendExtendedResponse(
 }
 
 
-void HOATDispatcher::sendMissResponse( CigiOutgoingMsg *outgoing, int requestID )
+void HOATDispatcher::sendMissResponse( CigiOutgoingMsg *outgoing, HOTRequest *request )
 {
-	RequestEntryMap::iterator iter = requests.find( requestID );
-	
-	if( iter == requests.end() )
-	{
-		// hmm, that's weird... btw, should throw an exception or something
-		return;
-	}
-	
-	RequestEntry &requestEntry = iter->second;
-	RefPtr<HOTRequest> request = requestEntry.request;
-	
 	if( request->type == CigiBaseHatHotReq::Extended )
 	{
 		CigiHatHotXRespV3_2 packet;
@@ -20,6 +20,9 @@
  *  2008-09-01 AUTHORNAME
  *      Initial release
  *  
+ *  2026-10-19
+ *      Added periodic (continuous) requests.
+ *  
  *  
  *  </pre>
  */
@@ -42,7 +45,18 @@
 #include "MissionFunctionsWorker.h"
 
 //=========================================================
+//! Turns HAT/HOT requests into HOTRequests for the mission functions 
+//! workers, and their results into responses.
 //! 
+//! Requests with an update period, on entity-relative positions, are 
+//! kept, and re-evaluated every update period frames until the entity is 
+//! destroyed or the Host sends a one-shot request with the same ID.  If a 
+//! periodic tolerance is set, and the test point hasn't moved 
+//! (horizontally) by more than that since the last intersection test, the 
+//! previous intersections are reused.  There's no tolerance by default, 
+//! since an entity can move under a test point that hasn't.  The number 
+//! of intersection tests for periodic requests can be limited per frame; 
+//! requests over the limit are answered a frame late.
 //! 
 class HOATDispatcher : public mpv::Referenced
 {
@@ -71,12 +85,48 @@ public:
 		terrainMaterialOverrideCode = materialOverride;
 	}
 	
+	//=========================================================
+	//! Sets the maximum number of periodic requests sent to the workers 
+	//! each frame; 0 means no limit.
+	//! 
+	void setPeriodicEvaluationsPerFrame( int evaluations )
+	{
+		periodicEvaluationsPerFrame = evaluations;
+	}
+	
+	//=========================================================
+	//! Sets how far, in meters, the test point of a periodic request may 
+	//! move before its intersections are found again.  A negative value 
+	//! means they are always found again.
+	//! 
+	void setPeriodicTolerance( double tolerance )
+	{
+		periodicTolerance = tolerance;
+	}
+	
 	void processRequest( CigiHatHotReqV3_2 *packet );
 
 	void registerWorker( mpv::MissionFunctionsWorker *worker );
 	
+	//=========================================================
+	//! Re-evaluates the periodic requests that are due, then sends the 
+	//! responses for all the requests that the workers have finished.  
+	//! Should be called once per frame.
+	//! 
 	void sendResponses( CigiOutgoingMsg *outgoing );
 	
+	//=========================================================
+	//! Discards the intersections kept for periodic requests, so that 
+	//! they are found again when next due.  Called when the terrain 
+	//! changes.
+	//! 
+	void invalidatePeriodicResults();
+	
+	//=========================================================
+	//! Discards all requests, including the periodic ones
+	//! 
+	void reset();
+	
 protected:
 	
 	class RequestEntry
@@ -87,13 +137,49 @@ protected:
 	};
 	typedef std::map< int, RequestEntry > RequestEntryMap;
 
+	class PeriodicRequest
+	{
+	public:
+		PeriodicRequest() : framesUntilDue( 0 ), haveResults( false ) {}
+		
+		//! the request as the Host sent it
+		CigiHatHotReqV3_2 packet;
+		
+		int framesUntilDue;
+		
+		//! the intersections from the last test, and where it was made
+		bool haveResults;
+		mpv::Vect3 resultsLocation;
+		std::list< mpv::HOTResponseList > results;
+	};
+	typedef std::map< int, PeriodicRequest > PeriodicRequestMap;
+
 	//=========================================================
 	//! General Destructor
 	//! 
 	virtual ~HOATDispatcher();
 	
+	//=========================================================
+	//! Converts a request packet into a HOTRequest
+	//! \return the request, or NULL if it refers to an entity that 
+	//!         doesn't exist
+	//! 
+	mpv::RefPtr<mpv::HOTRequest> buildRequest( CigiHatHotReqV3_2 *packet );
+	
+	//=========================================================
+	//! Hands a request to the workers
+	//! 
+	void dispatchRequest( mpv::HOTRequest *request );
+	
+	void updatePeriodicRequests( CigiOutgoingMsg *outgoing );
+	
 	void queueResponse( int requestID, mpv::HOTResponseList &responses );
 	
+	void sendResponseLists( 
+		CigiOutgoingMsg *outgoing, 
+		mpv::HOTRequest *request, 
+		std::list< mpv::HOTResponseList > &workerResponseList );
+	
 	void sendResponse( 
 		CigiOutgoingMsg *outgoing, 
 		mpv::HOTRequest *request, 
@@ -104,7 +190,7 @@ protected:
 		mpv::HOTRequest *request, 
 		mpv::HOTResponse *response, int numResponses );
 
-	void sendMissResponse( CigiOutgoingMsg *outgoing, int requestID );
+	void sendMissResponse( CigiOutgoingMsg *outgoing, mpv::HOTRequest *request );
 
 	double normalize_angle(double a) const;
 	double normalize_angle_positive(double a) const;
@@ -120,6 +206,11 @@ protected:
 
 	bool terrainMaterialOverride;
 	unsigned int terrainMaterialOverrideCode;
+	
+	PeriodicRequestMap periodicRequests;
+	
+	int periodicEvaluationsPerFrame;
+	double periodicTolerance;
 };
 
 #endif
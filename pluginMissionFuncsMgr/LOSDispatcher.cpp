@@ -20,6 +20,9 @@
  *  2008-09-01 AUTHORNAME
  *      Initial release
  *  
+ *  2026-10-19
+ *      Added periodic (continuous) requests.
+ *  
  *  
  *  </pre>
  */
@@ -27,12 +30,14 @@
 #define _USE_MATH_DEFINES
 
 #include <math.h>
-#include <iostream>
+#include <algorithm>
+#include <vector>
 
 #include <CigiLosRespV3_2.h>
 #include <CigiLosXRespV3_2.h>
 
 #include "BindSlot.h"
+#include "Log.h"
 #include "LOSDispatcher.h"
 
 using namespace mpv;
@@ -47,7 +52,9 @@ LOSDispatcher::LOSDispatcher() : Referenced(),
 	terrainMaterialOverride( false ),
 	terrainMaterialOverrideCode( 0 ),
 	entityMaterialOverride( false ),
-	entityMaterialOverrideCode( 0 )
+	entityMaterialOverrideCode( 0 ),
+	periodicEvaluationsPerFrame( 0 ),
+	periodicTolerance( -1.0 )
 {
 	
 }
@@ -66,11 +73,79 @@ void LOSDispatcher::processRequest( CigiLosSegReqV3_2 *packet )
 {
 	if( numWorkers == 0 )
 	{
-		std::cout << "Error in LOSDispatcher::processRequest - no workers; discarding LOS request " 
-			<< packet->GetLosID() << std::endl;
+		MPV_LOG_ERROR( "LOSDispatcher::processRequest - no workers; discarding LOS request " 
+			<< packet->GetLosID() );
+		return;
+	}
+	
+	// A new request replaces a periodic request with the same ID.  (A 
+	// one-shot request is how the Host cancels a periodic one.)
+	periodicRequests.erase( packet->GetLosID() );
+	
+	RefPtr<LOSRequest> request = buildRequest( packet );
+	if( !request.valid() )
 		return;
+	
+	if( packet->GetUpdatePeriod() != 0 )
+	{
+		if( packet->GetSrcCoordSys() == CigiBaseLosSegReq::Entity )
+		{
+			// the request is rebuilt from the packet each time it's due
+			PeriodicRequest &periodic = periodicRequests[request->id];
+			periodic.isVector = false;
+			periodic.segmentPacket = *packet;
+			periodic.updatePeriod = packet->GetUpdatePeriod();
+		}
+		else
+		{
+			MPV_LOG_WARNING( "LOSDispatcher::processRequest - "
+				<< "Host sent nonsensical LOS request: requested continuous responses " 
+				<< "on a geodetic position (request " << request->id << ")" );
+		}
 	}
 	
+	dispatchRequest( request.get() );
+}
+
+
+void LOSDispatcher::processRequest( CigiLosVectReqV3_2 *packet )
+{
+	if( numWorkers == 0 )
+	{
+		MPV_LOG_ERROR( "LOSDispatcher::processRequest - no workers; discarding LOS request " 
+			<< packet->GetLosID() );
+		return;
+	}
+	
+	periodicRequests.erase( packet->GetLosID() );
+	
+	RefPtr<LOSRequest> request = buildRequest( packet );
+	if( !request.valid() )
+		return;
+	
+	if( packet->GetUpdatePeriod() != 0 )
+	{
+		if( packet->GetSrcCoordSys() == CigiBaseLosVectReq::Entity )
+		{
+			PeriodicRequest &periodic = periodicRequests[request->id];
+			periodic.isVector = true;
+			periodic.vectorPacket = *packet;
+			periodic.updatePeriod = packet->GetUpdatePeriod();
+		}
+		else
+		{
+			MPV_LOG_WARNING( "LOSDispatcher::processRequest - "
+				<< "Host sent nonsensical LOS request: requested continuous responses " 
+				<< "on a geodetic position (request " << request->id << ")" );
+		}
+	}
+	
+	dispatchRequest( request.get() );
+}
+
+
+RefPtr<LOSRequest> LOSDispatcher::buildRequest( CigiLosSegReqV3_2 *packet )
+{
 	RefPtr<LOSRequest> request = new LOSRequest();
 	
 	request->id = packet->GetLosID();
@@ -81,9 +156,9 @@ void LOSDispatcher::processRequest( CigiLosSegReqV3_2 *packet )
 	
 	if( request->materialMask == 0 )
 	{
-		std::cout << "Warning in LOSDispatcher::processRequest - "
+		MPV_LOG_WARNING( "LOSDispatcher::processRequest - "
 			<< "Host sent nonsensical LOS request: material mask set to 0 " 
-			<< "(request " << request->id << ")\n";
+			<< "(request " << request->id << ")" );
 	}
 	
 	request->requestedResponseCoordinateSystem = 
@@ -99,10 +174,10 @@ void LOSDispatcher::processRequest( CigiLosSegReqV3_2 *packet )
 		srcEntity = allEntities->findEntity( packet->GetEntityID() );
 		if( srcEntity == NULL )
 		{
-			std::cout << "Warning in LOSDispatcher::processRequest - source entity " 
+			MPV_LOG_WARNING( "LOSDispatcher::processRequest - source entity " 
 				<< packet->GetEntityID() << " doesn't exist; discarding LOS request " 
-				<< request->id << std::endl;
-			return;
+				<< request->id );
+			return NULL;
 		}
 		
 		request->start = 
@@ -138,10 +213,10 @@ void LOSDispatcher::processRequest( CigiLosSegReqV3_2 *packet )
 			destEntity = allEntities->findEntity( packet->GetDestEntityID() );
 			if( destEntity == NULL )
 			{
-				std::cout << "Warning in LOSDispatcher::processRequest - destination entity " 
+				MPV_LOG_WARNING( "LOSDispatcher::processRequest - destination entity " 
 					<< packet->GetDestEntityID() << " doesn't exist; discarding LOS request " 
-					<< request->id << std::endl;
-				return;
+					<< request->id );
+				return NULL;
 			}
 		}
 		else
@@ -150,12 +225,12 @@ void LOSDispatcher::processRequest( CigiLosSegReqV3_2 *packet )
 			
 			if( packet->GetSrcCoordSys() != CigiBaseLosSegReq::Entity )
 			{
-				std::cout << "Warning in LOSDispatcher::processRequest - "
+				MPV_LOG_WARNING( "LOSDispatcher::processRequest - "
 					<< "Host sent nonsensical LOS request: destination coordinate was set " 
 					<< "relative to source entity, but source coordinate wasn't an entity; "
 					<< "discarding LOS request " 
-					<< request->id << std::endl;
-				return;
+					<< request->id );
+				return NULL;
 			}
 			
 			destEntity = srcEntity;
@@ -163,11 +238,11 @@ void LOSDispatcher::processRequest( CigiLosSegReqV3_2 *packet )
 			{
 				// shouldn't reach this line; should have quit earlier 
 				// when source entity couldn't be found
-				std::cout << "Warning in LOSDispatcher::processRequest - " 
+				MPV_LOG_WARNING( "LOSDispatcher::processRequest - " 
 					<< "destination entity (also the source entity) doesn't exist; " 
 					<< "discarding LOS request " 
-					<< request->id << std::endl;
-				return;
+					<< request->id );
+				return NULL;
 			}
 		}
 		
@@ -191,31 +266,12 @@ void LOSDispatcher::processRequest( CigiLosSegReqV3_2 *packet )
 		request->end.Set( db.LatX, db.LonY, db.AltZ );
 	}
 	
-	RequestEntryMap::iterator iter = requests.find( request->id );
-	if( iter != requests.end() )
-	{
-		std::cout << "Warning in LOSDispatcher::processRequest - LOS request ID " 
-			<< request->id << " is still active.  \n"
-			<< "\tDiscarding previous request with same ID.  Expect strange behavior.\n";
-	}
-	RequestEntry entry;
-	entry.request = request.get();
-	requests[request->id] = entry;
-	
-	// finally, emit signal
-	newLOSRequest( request );
+	return request;
 }
 
 
-void LOSDispatcher::processRequest( CigiLosVectReqV3_2 *packet )
+RefPtr<LOSRequest> LOSDispatcher::buildRequest( CigiLosVectReqV3_2 *packet )
 {
-	if( numWorkers == 0 )
-	{
-		std::cout << "Error in LOSDispatcher::processRequest - no workers; discarding LOS request " 
-			<< packet->GetLosID() << std::endl;
-		return;
-	}
-	
 	RefPtr<LOSRequest> request = new LOSRequest();
 	
 	request->id = packet->GetLosID();
@@ -226,9 +282,9 @@ void LOSDispatcher::processRequest( CigiLosVectReqV3_2 *packet )
 	
 	if( request->materialMask == 0 )
 	{
-		std::cout << "Warning in LOSDispatcher::processRequest - "
+		MPV_LOG_WARNING( "LOSDispatcher::processRequest - "
 			<< "Host sent nonsensical LOS request: material mask set to 0 " 
-			<< "(request " << request->id << ")\n";
+			<< "(request " << request->id << ")" );
 	}
 	
 	request->requestedResponseCoordinateSystem = 
@@ -246,20 +302,20 @@ void LOSDispatcher::processRequest( CigiLosVectReqV3_2 *packet )
 		Entity *srcEntity = allEntities->findEntity( packet->GetEntityID() );
 		if( srcEntity == NULL )
 		{
-			std::cout << "Warning in LOSDispatcher::processRequest - source entity " 
+			MPV_LOG_WARNING( "LOSDispatcher::processRequest - source entity " 
 				<< packet->GetEntityID() << " doesn't exist; discarding LOS request " 
-				<< request->id << std::endl;
-			return;
+				<< request->id );
+			return NULL;
 		}
 		
 		if( srcEntity->getIsChild() )
 		{
-			std::cout << "Warning in LOSDispatcher::processRequest - "
+			MPV_LOG_WARNING( "LOSDispatcher::processRequest - "
 				<< "LOS requests on child entities not implemented yet; "
 				<< "discarding LOS request (child entity: " 
 				<< srcEntity->getID() << ", LOS request " 
-				<< request->id << ")\n";
-			return;
+				<< request->id << ")" );
+			return NULL;
 		}
 
 		const CoordinateSet &coord = srcEntity->getPositionDB();
@@ -334,18 +390,18 @@ void LOSDispatcher::processRequest( CigiLosVectReqV3_2 *packet )
 	double maxRange = packet->GetMaxRange();
 	if( minRange < 0. )
 	{
-		std::cout << "Warning in LOSDispatcher::processRequest - "
+		MPV_LOG_WARNING( "LOSDispatcher::processRequest - "
 			<< "Invalid minimum range: " << minRange << "; "
-			<< "discarding LOS request " << request->id << std::endl;
-		return;
+			<< "discarding LOS request " << request->id );
+		return NULL;
 	}
 	if( maxRange < minRange )
 	{
-		std::cout << "Warning in LOSDispatcher::processRequest - "
+		MPV_LOG_WARNING( "LOSDispatcher::processRequest - "
 			<< "Maximum range (" << maxRange 
 			<< ") is smaller than minimum range (" << minRange << "); "
-			<< "discarding LOS request " << request->id << std::endl;
-		return;
+			<< "discarding LOS request " << request->id );
+		return NULL;
 	}
 	
 	request->start = requestVector * minRange + 
@@ -355,15 +411,21 @@ void LOSDispatcher::processRequest( CigiLosVectReqV3_2 *packet )
 	
 	request->origin = requestPoint;
 	
+	return request;
+}
+
+
+void LOSDispatcher::dispatchRequest( LOSRequest *request )
+{
 	RequestEntryMap::iterator iter = requests.find( request->id );
 	if( iter != requests.end() )
 	{
-		std::cout << "Warning in LOSDispatcher::processRequest - LOS request ID " 
-			<< request->id << " is still active.  \n"
-			<< "\tDiscarding previous request with same ID.  Expect strange behavior.\n";
+		MPV_LOG_WARNING( "LOSDispatcher::processRequest - LOS request ID " 
+			<< request->id << " is still active; "
+			<< "discarding the previous request with the same ID.  Expect strange behavior." );
 	}
 	RequestEntry entry;
-	entry.request = request.get();
+	entry.request = request;
 	requests[request->id] = entry;
 	
 	// finally, emit signal
@@ -389,6 +451,8 @@ void LOSDispatcher::queueResponse( int requestID, mpv::LOSResponseList &response
 
 void LOSDispatcher::sendResponses( CigiOutgoingMsg *outgoing )
 {
+	updatePeriodicRequests( outgoing );
+	
 	std::list<RequestEntryMap::iterator> completedRequests;
 	
 	RequestEntryMap::iterator requestIter;
@@ -403,33 +467,19 @@ void LOSDispatcher::sendResponses( CigiOutgoingMsg *outgoing )
 		// sent
 		if( workerResponseList.size() >= numWorkers )
 		{
-			int numResponses = 0;
-		
-			// need to total the responses
-			std::list< mpv::LOSResponseList >::iterator workerIter;
-			for( workerIter = workerResponseList.begin(); workerIter != workerResponseList.end(); workerIter++ )
-			{
-				numResponses += workerIter->size();
-			}
-
-			if( numResponses > 0 )
-			{
-				std::list< mpv::LOSResponseList >::iterator workerIter;
-				for( workerIter = workerResponseList.begin(); workerIter != workerResponseList.end(); workerIter++ )
-				{
-					mpv::LOSResponseList::iterator responseIter;
-					for( responseIter = workerIter->begin(); responseIter != workerIter->end(); responseIter++ )
-					{
-						if( request->type == LOSRequest::Extended )
-							sendExtendedResponse( outgoing, request, responseIter->get(), numResponses );
-						else
-							sendResponse( outgoing, request, responseIter->get(), numResponses );
-					}
-				}
-			}
-			else
+			sendResponseLists( outgoing, request, workerResponseList );
+			
+			// periodic requests keep their results, for reuse if the 
+			// segment hasn't moved by the next time they're due
+			PeriodicRequestMap::iterator periodicIter = periodicRequests.find( requestID );
+			if( periodicIter != periodicRequests.end() )
 			{
-				sendMissResponse( outgoing, requestID );
+				PeriodicRequest &periodic = periodicIter->second;
+				periodic.framesUntilDue = periodic.updatePeriod;
+				periodic.haveResults = true;
+				periodic.resultsStart = request->start;
+				periodic.resultsEnd = request->end;
+				periodic.results = workerResponseList;
 			}
 			
 			// request has been handled
@@ -446,6 +496,122 @@ void LOSDispatcher::sendResponses( CigiOutgoingMsg *outgoing )
 }
 
 
+void LOSDispatcher::updatePeriodicRequests( CigiOutgoingMsg *outgoing )
+{
+	// find the requests that are due, most overdue first
+	std::vector< std::pair<int, int> > dueRequests;
+	PeriodicRequestMap::iterator iter;
+	for( iter = periodicRequests.begin(); iter != periodicRequests.end(); iter++ )
+	{
+		// requests still with the workers wait until their results are in
+		if( requests.find( iter->first ) != requests.end() )
+			continue;
+		
+		PeriodicRequest &periodic = iter->second;
+		periodic.framesUntilDue--;
+		if( periodic.framesUntilDue <= 0 )
+			dueRequests.push_back( std::make_pair( periodic.framesUntilDue, iter->first ) );
+	}
+	std::sort( dueRequests.begin(), dueRequests.end() );
+	
+	int evaluations = 0;
+	std::list<int> cancelledRequests;
+	for( unsigned int i = 0; i < dueRequests.size(); i++ )
+	{
+		int requestID = dueRequests[i].second;
+		PeriodicRequest &periodic = periodicRequests[requestID];
+		
+		RefPtr<LOSRequest> request = periodic.isVector 
+			? buildRequest( &periodic.vectorPacket ) 
+			: buildRequest( &periodic.segmentPacket );
+		if( !request.valid() )
+		{
+			// an entity is gone, and the request with it
+			cancelledRequests.push_back( requestID );
+			continue;
+		}
+		
+		// Unlike HOT requests, LOS segments may hit other (moving) 
+		// entities, so results are only reused if a tolerance is set.
+		if( periodic.haveResults && periodicTolerance >= 0. && 
+			( request->start - periodic.resultsStart ).mag() <= periodicTolerance && 
+			( request->end - periodic.resultsEnd ).mag() <= periodicTolerance )
+		{
+			sendResponseLists( outgoing, request.get(), periodic.results );
+			periodic.framesUntilDue = periodic.updatePeriod;
+			continue;
+		}
+		
+		// over budget, the request stays due, and goes early next frame
+		if( periodicEvaluationsPerFrame > 0 && 
+			evaluations >= periodicEvaluationsPerFrame )
+			continue;
+		evaluations++;
+		
+		dispatchRequest( request.get() );
+	}
+	
+	std::list<int>::iterator cancelledIter;
+	for( cancelledIter = cancelledRequests.begin(); cancelledIter != cancelledRequests.end(); cancelledIter++ )
+	{
+		periodicRequests.erase( *cancelledIter );
+	}
+}
+
+
+void LOSDispatcher::invalidatePeriodicResults()
+{
+	PeriodicRequestMap::iterator iter;
+	for( iter = periodicRequests.begin(); iter != periodicRequests.end(); iter++ )
+	{
+		iter->second.haveResults = false;
+		iter->second.results.clear();
+	}
+}
+
+
+void LOSDispatcher::reset()
+{
+	requests.clear();
+	periodicRequests.clear();
+}
+
+
+void LOSDispatcher::sendResponseLists( 
+	CigiOutgoingMsg *outgoing, 
+	LOSRequest *request, 
+	std::list< mpv::LOSResponseList > &workerResponseList )
+{
+	int numResponses = 0;
+
+	// need to total the responses
+	std::list< mpv::LOSResponseList >::iterator workerIter;
+	for( workerIter = workerResponseList.begin(); workerIter != workerResponseList.end(); workerIter++ )
+	{
+		numResponses += workerIter->size();
+	}
+
+	if( numResponses > 0 )
+	{
+		for( workerIter = workerResponseList.begin(); workerIter != workerResponseList.end(); workerIter++ )
+		{
+			mpv::LOSResponseList::iterator responseIter;
+			for( responseIter = workerIter->begin(); responseIter != workerIter->end(); responseIter++ )
+			{
+				if( request->type == LOSRequest::Extended )
+					sendExtendedResponse( outgoing, request, responseIter->get(), numResponses );
+				else
+					sendResponse( outgoing, request, responseIter->get(), numResponses );
+			}
+		}
+	}
+	else
+	{
+		sendMissResponse( outgoing, request );
+	}
+}
+
+
 void LOSDispatcher::sendResponse( 
 	CigiOutgoingMsg *outgoing, 
 	LOSRequest *request, 
@@ -509,11 +675,11 @@ void LOSDispatcher::sendExtendedResponse(
 		// host requested entity hits to be returned in entity coordinates, 
 		// and we hit an entity
 		
-		std::cout << "Fixme in LOSDispatcher::sendExtendedResponse - "
+		MPV_LOG_WARNING( "LOSDispatcher::sendExtendedResponse - "
 			<< "for LOS request ID " << request->id << ", Host requested that "
 			<< "entity-hit responses be in entity coordinates.  That case "
 			<< "isn't implemented in the MPV yet, so returning 0,0,0 in the "
-			<< "offset fields.\n";
+			<< "offset fields." );
 		packet.SetXoff( 0. );
 		packet.SetYoff( 0. );
 		packet.SetZoff( 0. );
@@ -563,19 +729,8 @@ void LOSDispatcher::sendExtendedResponse(
 }
 
 
-void LOSDispatcher::sendMissResponse( CigiOutgoingMsg *outgoing, int requestID )
+void LOSDispatcher::sendMissResponse( CigiOutgoingMsg *outgoing, LOSRequest *request )
 {
-	RequestEntryMap::iterator iter = requests.find( requestID );
-	
-	if( iter == requests.end() )
-	{
-		// hmm, that's weird... btw, should throw an exception or something
-		return;
-	}
-	
-	RequestEntry &requestEntry = iter->second;
-	RefPtr<LOSRequest> request = requestEntry.request;
-
 	if( request->type == LOSRequest::Extended )
 	{
 		CigiLosXRespV3_2 packet;
@@ -20,6 +20,9 @@
  *  2008-09-01 AUTHORNAME
  *      Initial release
  *  
+ *  2026-10-19
+ *      Added periodic (continuous) requests.
+ *  
  *  
  *  </pre>
  */
@@ -43,7 +46,14 @@
 #include "MissionFunctionsWorker.h"
 
 //=========================================================
+//! Turns LOS segment and vector requests into LOSRequests for the mission 
+//! functions workers, and their results into responses.
 //! 
+//! Requests with an update period, from entity-relative sources, are kept 
+//! and re-evaluated every update period frames, as HOATDispatcher does 
+//! for HAT/HOT requests.  Results are only reused when a periodic 
+//! tolerance is set, since a segment that hasn't moved can still hit an 
+//! entity that has.
 //! 
 class LOSDispatcher : public mpv::Referenced
 {
@@ -77,13 +87,47 @@ public:
 		entityMaterialOverrideCode = materialOverride;
 	}
 	
+	//=========================================================
+	//! Sets the maximum number of periodic requests sent to the workers 
+	//! each frame; 0 means no limit.
+	//! 
+	void setPeriodicEvaluationsPerFrame( int evaluations )
+	{
+		periodicEvaluationsPerFrame = evaluations;
+	}
+	
+	//=========================================================
+	//! Sets how far, in meters, the ends of a periodic request's segment 
+	//! may move before its intersections are found again.  A negative 
+	//! value (the default) means they are always found again.
+	//! 
+	void setPeriodicTolerance( double tolerance )
+	{
+		periodicTolerance = tolerance;
+	}
+	
 	void processRequest( CigiLosSegReqV3_2 *packet );
 	void processRequest( CigiLosVectReqV3_2 *packet );
 
 	void registerWorker( mpv::MissionFunctionsWorker *worker );
 	
+	//=========================================================
+	//! Re-evaluates the periodic requests that are due, then sends the 
+	//! responses for all the requests that the workers have finished.  
+	//! Should be called once per frame.
+	//! 
 	void sendResponses( CigiOutgoingMsg *outgoing );
 	
+	//=========================================================
+	//! Discards the intersections kept for periodic requests
+	//! 
+	void invalidatePeriodicResults();
+	
+	//=========================================================
+	//! Discards all requests, including the periodic ones
+	//! 
+	void reset();
+	
 protected:
 
 	class RequestEntry
@@ -94,13 +138,55 @@ protected:
 	};
 	typedef std::map< int, RequestEntry > RequestEntryMap;
 
+	class PeriodicRequest
+	{
+	public:
+		PeriodicRequest() : isVector( false ), updatePeriod( 0 ), 
+			framesUntilDue( 0 ), haveResults( false ) {}
+		
+		//! the request as the Host sent it; one of the two packets is used
+		bool isVector;
+		CigiLosSegReqV3_2 segmentPacket;
+		CigiLosVectReqV3_2 vectorPacket;
+		
+		int updatePeriod;
+		int framesUntilDue;
+		
+		//! the intersections from the last test, and the segment tested
+		bool haveResults;
+		mpv::Vect3 resultsStart;
+		mpv::Vect3 resultsEnd;
+		std::list< mpv::LOSResponseList > results;
+	};
+	typedef std::map< int, PeriodicRequest > PeriodicRequestMap;
+
 	//=========================================================
 	//! General Destructor
 	//! 
 	virtual ~LOSDispatcher();
 	
+	//=========================================================
+	//! Converts a request packet into a LOSRequest
+	//! \return the request, or NULL if the packet is invalid or refers 
+	//!         to an entity that doesn't exist
+	//! 
+	mpv::RefPtr<mpv::LOSRequest> buildRequest( CigiLosSegReqV3_2 *packet );
+	mpv::RefPtr<mpv::LOSRequest> buildRequest( CigiLosVectReqV3_2 *packet );
+	
+	//=========================================================
+	//! Hands a request to the workers
+	//! 
+	void dispatchRequest( mpv::LOSRequest *request );
+	
+	void updatePeriodicRequests( CigiOutgoingMsg *outgoing );
+	
 	void queueResponse( int requestID, mpv::LOSResponseList &responses );
 	
+	void sendResponseLists( 
+		CigiOutgoingMsg *outgoing, 
+		mpv::LOSRequest *request, 
+		std::list< mpv::LOSResponseList > &workerResponseList );
+	
 	void sendResponse( 
 		CigiOutgoingMsg *outgoing, 
 		mpv::LOSRequest *request, 
@@ -111,7 +197,7 @@ protected:
 		mpv::LOSRequest *request, 
 		mpv::LOSResponse *response, int numResponses );
 
-	void sendMissResponse( CigiOutgoingMsg *outgoing, int requestID );
+	void sendMissResponse( CigiOutgoingMsg *outgoing, mpv::LOSRequest *request );
 
 	mpv::CoordinateConverter *coordinateConverter;
 	
@@ -125,6 +211,11 @@ protected:
 	unsigned int terrainMaterialOverrideCode;
 	bool entityMaterialOverride;
 	unsigned int entityMaterialOverrideCode;
+	
+	PeriodicRequestMap periodicRequests;
+	
+	int periodicEvaluationsPerFrame;
+	double periodicTolerance;
 };
 
 #endif
@@ -22,6 +22,10 @@
  *      Initial release.  Plugin is based in part on the GDLS 
  *      pluginMissionFuncsOSG.
  *  
+ *  2026-10-19
+ *      Periodic requests are flushed on reset and shutdown, and their 
+ *      kept results on database load.
+ *  
  *  
  *  </pre>
  */
@@ -115,9 +119,15 @@ void PluginMissionFuncsMgr::act( SystemState::ID state, StateContext &stateConte
 		break;
 
 	case SystemState::DatabaseLoad:
+		// the terrain under the periodic requests is changing
+		hoatDispatcher->invalidatePeriodicResults();
+		losDispatcher->invalidatePeriodicResults();
+		break;
+
 	case SystemState::Reset:
 	case SystemState::Shutdown:
-		// fixme - flush all requests
+		hoatDispatcher->reset();
+		losDispatcher->reset();
 		break;
 
 	default:
@@ -152,6 +162,25 @@ void PluginMissionFuncsMgr::getConfig( void )
 		losDispatcher->setTerrainMaterialOverride( attr->asInt() );
 	}
 
+	attr = mission_functions_group->getAttribute("periodic_evaluations_per_frame");
+	if( attr )
+	{
+		hoatDispatcher->setPeriodicEvaluationsPerFrame( attr->asInt() );
+		losDispatcher->setPeriodicEvaluationsPerFrame( attr->asInt() );
+	}
+
+	attr = mission_functions_group->getAttribute("periodic_hot_tolerance");
+	if( attr )
+	{
+		hoatDispatcher->setPeriodicTolerance( attr->asFloat() );
+	}
+
+	attr = mission_functions_group->getAttribute("periodic_los_tolerance");
+	if( attr )
+	{
+		losDispatcher->setPeriodicTolerance( attr->asFloat() );
+	}
+
 }
 
 
@@ -43,6 +43,10 @@
  *      Moved some code out of PluginRenderCameraOSG and into a new class, 
  *      ViewportWrapper
  *
+ *  2026-10-19
+ *      Posts a camera per view, for viewers that render the views as 
+ *      slaves, and the views' render times
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -107,6 +111,15 @@ void PluginRenderCameraOSGNode::act( SystemState::ID state, StateContext &stateC
 	switch( state )
 	{
 	
+	case SystemState::BlackboardPost:
+		// This state is for posting things to the blackboard
+		
+		// filled in by setupViewports()
+		bb_->put( "OSGViewCameras", &viewCameras );
+		
+		bb_->put( "ViewRenderTimes", &viewRenderTimes );
+		break;
+
 	case SystemState::BlackboardRetrieve:
 		// This state is for retrieving things from the blackboard
 		
@@ -155,6 +168,7 @@ void PluginRenderCameraOSGNode::act( SystemState::ID state, StateContext &stateC
 void PluginRenderCameraOSGNode::operate()
 {
 	updateViewports();
+	updateRenderTimes();
 }
 
 
@@ -185,6 +199,7 @@ void PluginRenderCameraOSGNode::setupViewports()
 		//viewer->addViewport( viewportWrapper->getViewport() );
 
 		viewportMap[view->getID()] = viewportWrapper;
+		viewCameras[view->getID()] = viewportWrapper->getCamera();
 
     std::cout << "Created a viewport for view id " << view->getID() << std::endl;
 		
@@ -235,3 +250,23 @@ void PluginRenderCameraOSGNode::updateViewports()
 
 }
 
+
+// ================================================
+// updateRenderTimes
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderCameraOSGNode::updateRenderTimes()
+{
+	std::map< int, RefPtr<ViewportWrapper> >::iterator vpIter = viewportMap.begin();
+	for( ; vpIter != viewportMap.end(); vpIter++ )
+	{
+		ViewportWrapper *viewportWrapper = vpIter->second.get();
+		
+		// views that aren't rendered through their cameras never get a 
+		// graphics context, and have no times to report
+		if( viewportWrapper == NULL || 
+			viewportWrapper->getCamera()->getGraphicsContext() == NULL )
+			continue;
+		
+		viewportWrapper->getRenderTimes( viewRenderTimes[vpIter->first] );
+	}
+}
@@ -39,6 +39,10 @@
  *  2007-07-15 Andrew Sampson
  *      Changed interface to use new state machine API
  *
+ *  2026-10-19
+ *      Posts a camera per view, for viewers that render the views as 
+ *      slaves, and the views' render times
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -53,6 +57,7 @@
 #include <osg/Vec3d>
 #include <osg/Matrix>
 #include <osg/Group>
+#include <osg/Camera>
 #include <osgUtil/SceneView>
 #include <osg/LOD>
 
@@ -62,6 +67,7 @@
 #include "TrackerParams.h"
 #include "DefFileGroup.h"
 
+#include "ViewRenderTimes.h"
 #include "ViewportWrapper.h"
 
 
@@ -126,6 +132,21 @@ private:
 	//! 
 	std::map< int, mpv::RefPtr<ViewportWrapper> > viewportMap;
 	
+	//=========================================================
+	//! The cameras for the viewports in viewportMap, keyed by view ID.  
+	//! Posted to the blackboard as "OSGViewCameras".  A viewer that adds 
+	//! these as slave cameras renders each view with its own render stages, 
+	//! and can cull them in parallel.
+	//! 
+	std::map< int, osg::ref_ptr<osg::Camera> > viewCameras;
+	
+	//=========================================================
+	//! The cull and draw times for each view, keyed by view ID.  Posted to 
+	//! the blackboard as "ViewRenderTimes".  Only filled in for views that 
+	//! are rendered through their cameras.
+	//! 
+	mpvosg::ViewRenderTimesMap viewRenderTimes;
+	
 	//=========================================================
 	//! Called by act() when the system is in the Operate state.  This is the 
 	//! method that actually does the rendering.
@@ -142,6 +163,11 @@ private:
 	//! 
 	void updateViewports();
 
+	//=========================================================
+	//! Copies each view's render times out of its camera's statistics
+	//! 
+	void updateRenderTimes();
+
 };
 
 
@@ -25,13 +25,22 @@
  *  2008-06-29 Andrew Sampson
  *      Made ViewportWrapper a child class of ViewImp
  *
+ *  2026-10-19
+ *      Each viewport now has a camera of its own, so that a viewer can 
+ *      cull the views in parallel and time them separately
+ *
  * </pre>
  */
 
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 
 #include <osg/FrontFace>
+#include <osg/Viewport>
+#include <osg/Stats>
+#include <osgUtil/CullVisitor>
 
 #include "BindSlot.h"
 
@@ -48,12 +57,33 @@ using namespace mpvosg;
 ViewportWrapper::ViewportWrapper( View *v ) : ViewImp( v )
 {
 	projectionChanged = true;
+	viewportDirty = true;
 	
 	viewportNode = new osg::MatrixTransform;
 	projectionNode = new osg::Projection;
 
   viewportNode->addChild(projectionNode.get());
 
+	// The view and projection matrices are applied by viewportNode and 
+	// projectionNode, so the camera's own are left at identity.  The near 
+	// and far planes come from the view, not from the scene's bounds.
+	camera = new osg::Camera;
+	std::ostringstream cameraName;
+	cameraName << "View " << v->getID();
+	camera->setName( cameraName.str() );
+	camera->setReferenceFrame( osg::Transform::ABSOLUTE_RF );
+	camera->setViewMatrix( osg::Matrix::identity() );
+	camera->setProjectionMatrix( osg::Matrix::identity() );
+	camera->setComputeNearFarMode( osgUtil::CullVisitor::DO_NOT_COMPUTE_NEAR_FAR );
+	camera->setClearMask( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+	camera->addChild( viewportNode.get() );
+	camera->setUpdateCallback( new SubgraphUpdateCallback( this ) );
+
+	// the renderer records each frame's cull and draw times here
+	osg::Stats *stats = new osg::Stats( "Camera" );
+	stats->collectStats( "rendering", true );
+	camera->setStats( stats );
+
 	// retrieve the view state and apply it
 	typeChanged( view );
 	parallelProjectionChanged( view );
@@ -133,6 +163,40 @@ void ViewportWrapper::update( const osg::Matrix &viewMatrix )
 
   //viewportNode->setMatrix(osg::Matrix::inverse(viewMatrix));
   viewportNode->setMatrix(viewMatrix);
+
+	// the viewport can only be placed once the camera has a context to 
+	// place it in
+	if( camera->getGraphicsContext() != NULL && 
+		( viewportDirty || camera->getViewport() == NULL ) )
+	{
+		recalculateViewport();
+		viewportDirty = false;
+	}
+}
+
+
+// ================================================
+// getRenderTimes
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ViewportWrapper::getRenderTimes( mpvosg::ViewRenderTimes &times )
+{
+	osg::Stats *stats = camera->getStats();
+	if( stats == NULL )
+		return;
+
+	// The draw for the latest frames may still be in progress; averaging 
+	// skips the frames that don't have the attribute yet.
+	unsigned int latest = stats->getLatestFrameNumber();
+	unsigned int earliest = std::max( stats->getEarliestFrameNumber(), 
+		latest > 9 ? latest - 9 : 0 );
+
+	double value;
+	if( stats->getAveragedAttribute( earliest, latest, "Cull traversal time taken", value ) )
+		times.cullTime = value;
+	if( stats->getAveragedAttribute( earliest, latest, "Draw traversal time taken", value ) )
+		times.drawTime = value;
+	if( stats->getAveragedAttribute( earliest, latest, "GPU draw time taken", value ) )
+		times.gpuDrawTime = value;
 }
 
 
@@ -222,13 +286,8 @@ void ViewportWrapper::entityIDChanged( View *v )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void ViewportWrapper::viewportChanged( View *v )
 {
-  // Homey don't do that here.
-  /*
-	viewport->setLeft( view->getViewportLeft() );
-	viewport->setTop( view->getViewportTop() );
-	viewport->setWidth( view->getViewportWidth() );
-	viewport->setHeight( view->getViewportHeight() );
-  */
+	// applied by update(), once the camera has a context
+	viewportDirty = true;
 }
 
 
@@ -372,3 +431,52 @@ void ViewportWrapper::recalculateProjection()
 
 
 
+
+
+// ================================================
+// recalculateViewport
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ViewportWrapper::recalculateViewport()
+{
+	if( view == NULL )
+	{
+		std::cerr << "Error - in ViewportWrapper::recalculateViewport, view is NULL\n";
+		return;
+	}
+
+	const osg::GraphicsContext::Traits *traits = 
+		camera->getGraphicsContext()->getTraits();
+	if( traits == NULL )
+		return;
+
+	// The view's viewport is given as fractions of the window, measured 
+	// from the upper-left corner; GL measures from the lower-left.
+	double width = view->getViewportWidth() * traits->width;
+	double height = view->getViewportHeight() * traits->height;
+	double x = view->getViewportLeft() * traits->width;
+	double y = ( 1.0 - view->getViewportTop() - view->getViewportHeight() ) * traits->height;
+
+	// A new viewport object, rather than changes to the old one; the draw 
+	// thread may still be drawing the last frame with the old one.
+	camera->setViewport( new osg::Viewport( x, y, width, height ) );
+}
+
+
+// ================================================
+// SubgraphUpdateCallback::operator()
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ViewportWrapper::SubgraphUpdateCallback::operator()( osg::Node *node, osg::NodeVisitor *nv )
+{
+	osg::NodeVisitor::TraversalMode mode = nv->getTraversalMode();
+	nv->setTraversalMode( osg::NodeVisitor::TRAVERSE_ACTIVE_CHILDREN );
+
+	osg::MatrixTransform *viewportNode = wrapper->viewportNode.get();
+	for( unsigned int i = 0; i < viewportNode->getNumChildren(); i++ )
+	{
+		osg::Node *child = viewportNode->getChild( i );
+		if( child != wrapper->projectionNode.get() )
+			child->accept( *nv );
+	}
+
+	nv->setTraversalMode( mode );
+}
@@ -25,6 +25,10 @@
  *  2008-06-29 Andrew Sampson
  *      Made ViewportWrapper a child class of ViewImp
  *
+ *  2026-10-19
+ *      Each viewport now has a camera of its own, so that a viewer can 
+ *      cull the views in parallel and time them separately
+ *
  * </pre>
  */
 
@@ -35,10 +39,13 @@
 
 #include <osg/Matrix>
 #include <osg/Group>
+#include <osg/Camera>
+#include <osg/NodeCallback>
 #include <osg/MatrixTransform>
 #include <osg/Projection>
 
 #include "View.h"
+#include "ViewRenderTimes.h"
 
 //=========================================================
 //! A class to encapsulate a viewport.  This class was created to make it 
@@ -47,6 +54,12 @@
 //! will probably encourage code re-use if I ever create a (non-SDL) 
 //! window-rendering plugin.
 //! 
+//! Each viewport also has a camera of its own, carrying the viewport's 
+//! subgraph.  A viewer can render the cameras as slaves, giving each view 
+//! its own render stages and (with CullThreadPerCameraDrawThreadPerContext) 
+//! its own cull thread; the camera's statistics then record how long the 
+//! view took to cull and draw.
+//! 
 class ViewportWrapper : public mpv::ViewImp
 {
 public:
@@ -78,6 +91,22 @@ osg::Group * getSceneGraph(){ return viewportNode.get(); }
     return viewportNode.get();
   }
 
+	//=========================================================
+	//! Returns the camera for this viewport.  The camera renders the 
+	//! viewport's subgraph into the part of its graphics context given by 
+	//! the view's viewport_* parameters; it has no context until a viewer 
+	//! gives it one.
+	//! 
+	osg::Camera *getCamera() { return camera.get(); }
+
+	//=========================================================
+	//! Retrieves the view's cull and draw times from the camera's 
+	//! statistics, averaged over the last few frames
+	//! \param times - receives the times; left at 0 where nothing has been 
+	//!   measured
+	//! 
+	void getRenderTimes( mpvosg::ViewRenderTimes &times );
+
 protected:
 	virtual ~ViewportWrapper();
 
@@ -89,6 +118,29 @@ protected:
 	//! 
 	void recalculateProjection();
 
+	//=========================================================
+	//! Sets the camera's viewport from the view's viewport parameters and 
+	//! the size of the camera's graphics context
+	//! 
+	void recalculateViewport();
+
+	//=========================================================
+	//! Runs the update traversal over the viewport's own children (the 
+	//! symbol surfaces).  The viewer only visits a slave camera's update 
+	//! callback, not its subgraph, and the scene under projectionNode is 
+	//! updated through the master camera.
+	//! 
+	class SubgraphUpdateCallback : public osg::NodeCallback
+	{
+	public:
+		SubgraphUpdateCallback( ViewportWrapper *_wrapper ) : wrapper( _wrapper ) {}
+		virtual void operator()( osg::Node *node, osg::NodeVisitor *nv );
+	private:
+		ViewportWrapper *wrapper;
+	};
+	friend class SubgraphUpdateCallback;
+
+	osg::ref_ptr<osg::Camera> camera;
 	osg::ref_ptr<osg::MatrixTransform> viewportNode;
 	osg::ref_ptr<osg::Projection> projectionNode;
 
@@ -96,6 +148,9 @@ protected:
 	//! will set this to true if there have been any changes to the view 
 	//! frustum.
 	bool projectionChanged;
+
+	//! Indicates that the view's viewport parameters have changed
+	bool viewportDirty;
 };
 
 #endif
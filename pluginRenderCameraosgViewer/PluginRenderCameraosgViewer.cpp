@@ -1,8 +1,13 @@
 #include <iostream>
 
+#include <OpenThreads/ScopedLock>
+
+#include <osg/Viewport>
 #include <osgGA/StateSetManipulator>
 
 #include "PluginRenderCameraosgViewer.h"
+#include "Log.h"
+#include "CigiRecording.h"
 #include <osgViewer/ViewerEventHandlers>
 
 using namespace mpv;
@@ -40,6 +45,7 @@ PluginRenderCameraosgViewer::PluginRenderCameraosgViewer() : Plugin()
   name_ = "PluginRenderCameraosgViewer";
   licenseInfo_.setLicense( LicenseInfo::LicenseGPL );
   licenseInfo_.setOrigin( "Community" );
+  dependencies_.push_back( "PluginDefFileReader" );
   dependencies_.push_back( "PluginRenderCameraOSGNode" );
 
   viewer = new osgViewer::Viewer;
@@ -51,6 +57,31 @@ PluginRenderCameraosgViewer::PluginRenderCameraosgViewer() : Plugin()
   viewer->addEventHandler(new osgGA::StateSetManipulator(viewer->getCamera()->getOrCreateStateSet()));
 
   scene = 0;
+  viewCameras = NULL;
+  rootNode = NULL;
+  DefFileData = NULL;
+  frameHandoff = NULL;
+
+  useRenderThread = false;
+  threadingModel = viewer->getThreadingModel();
+  threadingModelChanged = false;
+  latencyReportInterval = 10.0f;
+
+  usePerViewCameras = true;
+  windowWidth = 800;
+  windowHeight = 600;
+  fullscreen = false;
+  offscreen = false;
+  windowTitle = "Multi-Purpose Viewer";
+
+  renderThread = NULL;
+  realized = false;
+  renderRequested = false;
+
+  latencyCount = 0;
+  latencySum = 0.0;
+  latencyMax = 0.0;
+  lastReportTime = mpv::cigiRecordingClock();
 
   std::cout << "PluginRenderCameraosgViewer created\n";
 }
@@ -61,8 +92,7 @@ PluginRenderCameraosgViewer::PluginRenderCameraosgViewer() : Plugin()
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 PluginRenderCameraosgViewer::~PluginRenderCameraosgViewer() throw() 
 {
-
-
+  stopRenderThread();
 }
 
 
@@ -71,38 +101,55 @@ PluginRenderCameraosgViewer::~PluginRenderCameraosgViewer() throw()
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void PluginRenderCameraosgViewer::act( SystemState::ID state, StateContext &stateContext )
 {
+  renderRequested = false;
+
   switch( state )
   {
     case SystemState::BlackboardRetrieve:
       std::list< osg::ref_ptr<osgGA::GUIEventAdapter> > *eventList;
       bb_->get( "GUIEventList", eventList );
+      bb_->get( "DefinitionData", DefFileData );
+      bb_->get( "FrameHandoff", frameHandoff );
+      bb_->get( "RootNodeOSG", rootNode, false );
+      // posted by PluginRenderCameraOSGNode
+      bb_->get( "OSGViewCameras", viewCameras, false );
       //
       // Create a handler that will bounce the GUI events emitted by
       // this viewer into the eventHandlerList
       viewer->addEventHandler(new EventProxyHandler(eventList));
       break;
 
+    case SystemState::ConfigurationProcess:
+      getConfig();
+      break;
+
     case SystemState::Standby:
     case SystemState::DatabaseLoad:
     case SystemState::Operate:
     case SystemState::Debug:
 
-      if(scene == 0) {
-        // Look for the scene data in the BB
-        bb_->get( "OSGNode", scene );
-        if(scene == 0) {
-          std::cout << "PluginRenderCameraosgViewer didn't find scene data in bb\n";
-          return;
-        }
-        viewer->setSceneData(scene);
-        viewer->realize();
-        viewer->getCamera()->setComputeNearFarMode( osgUtil::CullVisitor::DO_NOT_COMPUTE_NEAR_FAR );
+      if(scene == 0 && !setup())
+        return;
+
+      if( renderThread != NULL )
+      {
+        // the render thread will pick this frame up once the plugins 
+        // are done with it
+        renderRequested = true;
+      }
+      else
+      {
+        if( !realized )
+          realize();
+        renderFrame( frameHandoff != NULL ? 
+          frameHandoff->getWriteStartTime() : mpv::cigiRecordingClock() );
       }
-      viewer->frame();
 
+      reportLatency();
       break;
 
     case SystemState::Shutdown:
+      stopRenderThread();
       break;
 
     default:
@@ -110,3 +157,388 @@ void PluginRenderCameraosgViewer::act( SystemState::ID state, StateContext &stat
   }
 }
 
+
+// ================================================
+// getConfig
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderCameraosgViewer::getConfig()
+{
+  DefFileGroup *root = ( DefFileData != NULL ) ? *DefFileData : NULL;
+  DefFileGroup *group = 
+    ( root != NULL ) ? root->getGroupByURI( "/window/" ) : NULL;
+  if( group == NULL )
+    return;
+
+  DefFileAttrib *attr;
+
+  attr = group->getAttribute( "render_thread" );
+  if( attr )
+  {
+    if( scene != 0 && ( attr->asInt() != 0 ) != useRenderThread )
+      MPV_LOG_WARNING( "PluginRenderCameraosgViewer - render_thread can "
+        "only be changed at startup" );
+    else
+      useRenderThread = ( attr->asInt() != 0 );
+  }
+
+  attr = group->getAttribute( "threading_model" );
+  if( attr )
+  {
+    std::string name = attr->asString();
+    osgViewer::ViewerBase::ThreadingModel model;
+    if( name == "SingleThreaded" )
+      model = osgViewer::ViewerBase::SingleThreaded;
+    else if( name == "CullDrawThreadPerContext" )
+      model = osgViewer::ViewerBase::CullDrawThreadPerContext;
+    else if( name == "DrawThreadPerContext" )
+      model = osgViewer::ViewerBase::DrawThreadPerContext;
+    else if( name == "CullThreadPerCameraDrawThreadPerContext" )
+      model = osgViewer::ViewerBase::CullThreadPerCameraDrawThreadPerContext;
+    else
+    {
+      if( name != "Automatic" )
+        MPV_LOG_WARNING( "PluginRenderCameraosgViewer - unknown threading_model \"" 
+          << name << "\"; using Automatic" );
+      model = osgViewer::ViewerBase::AutomaticSelection;
+    }
+
+    if( model != threadingModel )
+    {
+      threadingModel = model;
+      threadingModelChanged = true;
+    }
+  }
+
+  attr = group->getAttribute( "latency_report_interval" );
+  if( attr )
+    latencyReportInterval = attr->asFloat();
+
+  // the window is only created once
+  if( scene != 0 )
+    return;
+
+  attr = group->getAttribute( "per_view_cameras" );
+  if( attr )
+    usePerViewCameras = ( attr->asInt() != 0 );
+
+  attr = group->getAttribute( "width" );
+  if( attr )
+    windowWidth = attr->asInt();
+
+  attr = group->getAttribute( "height" );
+  if( attr )
+    windowHeight = attr->asInt();
+
+  attr = group->getAttribute( "fullscreen" );
+  if( attr )
+    fullscreen = ( attr->asInt() != 0 );
+
+  attr = group->getAttribute( "offscreen" );
+  if( attr )
+    offscreen = ( attr->asInt() != 0 );
+
+  attr = group->getAttribute( "title" );
+  if( attr )
+    windowTitle = attr->asString();
+}
+
+
+// ================================================
+// setup
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool PluginRenderCameraosgViewer::setup()
+{
+  if( usePerViewCameras && viewCameras != NULL && rootNode != NULL )
+  {
+    // the cameras are filled in when the views are set up
+    if( viewCameras->empty() )
+      return false;
+
+    if( setupViewCameras() )
+    {
+      // the slaves carry the views; the scene data is only traversed 
+      // here for the event and update traversals
+      scene = rootNode;
+    }
+    else
+    {
+      MPV_LOG_WARNING( "PluginRenderCameraosgViewer - rendering a single "
+        "view in a window chosen by osgViewer instead" );
+      usePerViewCameras = false;
+    }
+  }
+
+  if( scene == 0 )
+  {
+    // Look for the scene data in the BB
+    bb_->get( "OSGNode", scene );
+    if(scene == 0) {
+      std::cout << "PluginRenderCameraosgViewer didn't find scene data in bb\n";
+      return false;
+    }
+  }
+  viewer->setSceneData(scene);
+
+  if( useRenderThread )
+  {
+    if( frameHandoff == NULL )
+    {
+      MPV_LOG_WARNING( "PluginRenderCameraosgViewer - the kernel doesn't "
+        "provide a frame handoff; rendering on the kernel thread" );
+    }
+    else
+    {
+      // the frame being written now is the first one the thread will see
+      frameHandoff->attachReader();
+      renderThread = new RenderThread( this );
+      renderThread->start();
+    }
+  }
+
+  return true;
+}
+
+
+// ================================================
+// setupViewCameras
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool PluginRenderCameraosgViewer::setupViewCameras()
+{
+  osg::GraphicsContext::WindowingSystemInterface *wsi = 
+    osg::GraphicsContext::getWindowingSystemInterface();
+  if( wsi == NULL )
+  {
+    MPV_LOG_ERROR( "PluginRenderCameraosgViewer - no windowing system interface" );
+    return false;
+  }
+
+  osg::ref_ptr<osg::GraphicsContext::Traits> traits = new osg::GraphicsContext::Traits;
+  traits->readDISPLAY();
+  traits->setUndefinedScreenDetailsToDefaultScreen();
+  traits->x = 0;
+  traits->y = 0;
+  traits->width = windowWidth;
+  traits->height = windowHeight;
+  traits->windowName = windowTitle;
+  traits->doubleBuffer = true;
+  traits->pbuffer = offscreen;
+  traits->windowDecoration = !fullscreen && !offscreen;
+
+  if( fullscreen && !offscreen )
+  {
+    // switch the screen to the requested resolution, if it can be; 
+    // either way the window covers the screen
+    unsigned int screenWidth = windowWidth, screenHeight = windowHeight;
+    wsi->setScreenResolution( *traits, windowWidth, windowHeight );
+    wsi->getScreenResolution( *traits, screenWidth, screenHeight );
+    traits->width = screenWidth;
+    traits->height = screenHeight;
+  }
+
+  graphicsContext = osg::GraphicsContext::createGraphicsContext( traits.get() );
+  if( !graphicsContext.valid() )
+  {
+    MPV_LOG_ERROR( "PluginRenderCameraosgViewer - couldn't create a " 
+      << traits->width << "x" << traits->height 
+      << ( offscreen ? " pbuffer" : " window" ) );
+    return false;
+  }
+
+  // The master camera has no context of its own, so only the slaves are 
+  // culled and drawn.  They share its state set, so that the 
+  // StateSetManipulator's toggles apply to every view.
+  osg::StateSet *masterStateSet = viewer->getCamera()->getOrCreateStateSet();
+
+  std::map< int, osg::ref_ptr<osg::Camera> >::iterator iter = viewCameras->begin();
+  for( ; iter != viewCameras->end(); iter++ )
+  {
+    osg::Camera *camera = iter->second.get();
+    if( camera == NULL )
+      continue;
+
+    // the viewport covers the window until PluginRenderCameraOSGNode 
+    // places the view's viewport, on its next update
+    camera->setGraphicsContext( graphicsContext.get() );
+    if( camera->getViewport() == NULL )
+      camera->setViewport( new osg::Viewport( 0, 0, traits->width, traits->height ) );
+    camera->setStateSet( masterStateSet );
+    camera->setDrawBuffer( traits->doubleBuffer ? GL_BACK : GL_FRONT );
+    camera->setReadBuffer( traits->doubleBuffer ? GL_BACK : GL_FRONT );
+
+    // the camera carries its own subgraph, not the master's scene data
+    viewer->addSlave( camera, false );
+  }
+
+  MPV_LOG_INFO( "PluginRenderCameraosgViewer - rendering " 
+    << viewCameras->size() << " views into a " << traits->width << "x" 
+    << traits->height << ( offscreen ? " pbuffer" : " window" ) );
+
+  return true;
+}
+
+
+// ================================================
+// realize
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderCameraosgViewer::realize()
+{
+  viewer->setThreadingModel( threadingModel );
+  threadingModelChanged = false;
+
+  viewer->realize();
+  viewer->getCamera()->setComputeNearFarMode( osgUtil::CullVisitor::DO_NOT_COMPUTE_NEAR_FAR );
+
+  osgViewer::ViewerBase::Contexts contexts;
+  viewer->getContexts( contexts );
+  if( !contexts.empty() )
+    contexts[0]->setSwapCallback( new SwapCallback( this ) );
+
+  realized = true;
+}
+
+
+// ================================================
+// renderFrame
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderCameraosgViewer::renderFrame( double writeStartTime )
+{
+  if( threadingModelChanged )
+  {
+    viewer->setThreadingModel( threadingModel );
+    threadingModelChanged = false;
+  }
+
+  // this is viewer->frame(), with a note of when the frame began
+  viewer->advance();
+
+  {
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock( latencyMutex );
+    unswappedFrames.push_back( writeStartTime );
+    // if nothing is being swapped (no window yet, or the swap callback was 
+    // replaced) don't let the queue grow
+    if( unswappedFrames.size() > 16 )
+      unswappedFrames.pop_front();
+  }
+
+  viewer->eventTraversal();
+  viewer->updateTraversal();
+
+  // With DrawThreadPerContext and CullThreadPerCameraDrawThreadPerContext, 
+  // this returns once the cull is done and the DYNAMIC drawables and 
+  // state sets have been drawn; the rest of the draw overlaps the next 
+  // frame.  Plugins that change drawables or state sets after setup must 
+  // mark them DYNAMIC, as those threading models always required.
+  viewer->renderingTraversals();
+}
+
+
+// ================================================
+// stopRenderThread
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderCameraosgViewer::stopRenderThread()
+{
+  if( renderThread == NULL )
+    return;
+
+  // wakes the thread, which exits instead of rendering
+  frameHandoff->detachReader();
+  renderThread->join();
+  delete renderThread;
+  renderThread = NULL;
+
+  // the draw threads may still be finishing the last frame
+  viewer->stopThreading();
+}
+
+
+// ================================================
+// RenderThread::run
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderCameraosgViewer::RenderThread::run()
+{
+  unsigned int frame;
+  double writeStartTime;
+
+  while( plugin->frameHandoff->beginRead( frame, writeStartTime ) )
+  {
+    if( plugin->renderRequested )
+    {
+      // the viewer is realized here so that its context belongs to this 
+      // thread
+      if( !plugin->realized )
+        plugin->realize();
+      plugin->renderFrame( writeStartTime );
+    }
+
+    plugin->frameHandoff->endRead();
+  }
+}
+
+
+// ================================================
+// SwapCallback::swapBuffersImplementation
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderCameraosgViewer::SwapCallback::swapBuffersImplementation( osg::GraphicsContext *gc )
+{
+  gc->swapBuffersImplementation();
+  plugin->frameSwapped();
+}
+
+
+// ================================================
+// frameSwapped
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderCameraosgViewer::frameSwapped()
+{
+  double now = mpv::cigiRecordingClock();
+
+  OpenThreads::ScopedLock<OpenThreads::Mutex> lock( latencyMutex );
+
+  if( unswappedFrames.empty() )
+    return;
+
+  double latency = now - unswappedFrames.front();
+  unswappedFrames.pop_front();
+  latencyCount++;
+  latencySum += latency;
+  if( latency > latencyMax )
+    latencyMax = latency;
+}
+
+
+// ================================================
+// reportLatency
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderCameraosgViewer::reportLatency()
+{
+  if( latencyReportInterval <= 0.0f )
+    return;
+
+  double now = mpv::cigiRecordingClock();
+  if( now - lastReportTime < latencyReportInterval )
+    return;
+
+  int count;
+  double sum, max;
+  {
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock( latencyMutex );
+    count = latencyCount;
+    sum = latencySum;
+    max = latencyMax;
+    latencyCount = 0;
+    latencySum = 0.0;
+    latencyMax = 0.0;
+  }
+
+  if( count > 0 )
+  {
+    MPV_LOG_INFO( "PluginRenderCameraosgViewer - " << count 
+      << " frames in " << ( now - lastReportTime ) << " s; latency from frame "
+      "start to swap: mean " << ( sum / count * 1000.0 ) << " ms, max " 
+      << ( max * 1000.0 ) << " ms (" 
+      << ( renderThread != NULL ? "render thread" : "kernel thread" ) << ")" );
+  }
+
+  lastReportTime = now;
+}
+
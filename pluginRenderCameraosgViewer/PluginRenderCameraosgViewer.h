@@ -1,6 +1,14 @@
+
 #ifndef PLUGIN_RENDER_CAMERA_OSGVIEWER_H
 #define PLUGIN_RENDER_CAMERA_OSGVIEWER_H
 
+#include <deque>
+#include <map>
+#include <string>
+
+#include <OpenThreads/Mutex>
+#include <OpenThreads/Thread>
+
 #include <osgViewer/Viewer>
 
 #include "Plugin.h"
@@ -8,39 +16,193 @@
 #include "View.h"
 #include "TrackerParams.h"
 #include "DefFileGroup.h"
+#include "FrameHandoff.h"
 
 
 //=========================================================
-//! This plugin is responsible for creating a rendering window and 
-//! rendering the scene.  
-//! It uses SDL to create a rendering window and OSG to render the scene.
-//! 
-class PluginRenderCameraosgViewer : public Plugin 
+//! This plugin is responsible for creating a rendering window and
+//! rendering the scene.
+//! It uses osgViewer to create a rendering window and render the scene.
+//!
+//! By default the scene is rendered from act(), on the kernel thread.
+//! With render_thread enabled, it is rendered on a thread of its own,
+//! which updates and culls each frame while the kernel is sending and
+//! waiting, then draws it while the kernel receives and the plugins write
+//! the next frame (see mpv::FrameHandoff).  Either way, the latency from the start
+//! of the kernel frame to the buffer swap is measured and logged.
+//!
+//! With per_view_cameras enabled (the default), the plugin creates the 
+//! window itself and renders each view through its own slave camera, as 
+//! posted by PluginRenderCameraOSGNode.  Each view then has its own render 
+//! stages, and with CullThreadPerCameraDrawThreadPerContext its own cull 
+//! thread; the culls finish before the window's draw begins.  The window 
+//! can be a pbuffer (offscreen), for running without a display.
+//!
+class PluginRenderCameraosgViewer : public Plugin
 {
 public:
 
 	//=========================================================
 	//! General Constructor
-	//! 
+	//!
 	PluginRenderCameraosgViewer();
 
 	//=========================================================
 	//! General Destructor
-	//! 
+	//!
 	virtual ~PluginRenderCameraosgViewer() throw();
-	
+
 	//=========================================================
 	//! The per-frame processing that this plugin performs.
 	//! This plugin's act() will update the camera and render the scene.
 	//! \param state - The current system state
-	//! \param stateContext - an object containing all the variables which 
+	//! \param stateContext - an object containing all the variables which
 	//!     influence state transitions
 	//!
 	virtual void act( SystemState::ID state, StateContext &stateContext );
-	
+
 private:
-  osg::ref_ptr<osgViewer::Viewer> viewer;
-  osg::Node *scene;
+
+	//=========================================================
+	//! Pulls some preferences out of the config file data
+	//!
+	void getConfig();
+
+	//=========================================================
+	//! Finds the scene and starts rendering it.  Returns false if the
+	//! scene isn't on the blackboard yet.
+	//!
+	bool setup();
+
+	//=========================================================
+	//! Creates the window, and adds the views' cameras to the viewer as 
+	//! slaves.  Returns false if the window can't be created.
+	//!
+	bool setupViewCameras();
+
+	//=========================================================
+	//! Realizes the viewer.  Called from whichever thread renders.
+	//!
+	void realize();
+
+	//=========================================================
+	//! Renders one frame.  Called from whichever thread renders.
+	//! \param writeStartTime - when the kernel began the frame
+	//!
+	void renderFrame( double writeStartTime );
+
+	//=========================================================
+	//! Stops the render thread, if it is running
+	//!
+	void stopRenderThread();
+
+	//=========================================================
+	//! Called from the draw thread after each buffer swap
+	//!
+	void frameSwapped();
+
+	//=========================================================
+	//! Logs the latency statistics, if it's time to
+	//!
+	void reportLatency();
+
+	//=========================================================
+	//! Runs renderFrame() for each frame handed off by the kernel
+	//!
+	class RenderThread : public OpenThreads::Thread
+	{
+	public:
+		RenderThread( PluginRenderCameraosgViewer *_plugin ) : plugin( _plugin ) {}
+		virtual void run();
+	private:
+		PluginRenderCameraosgViewer *plugin;
+	};
+	friend class RenderThread;
+
+	//=========================================================
+	//! Swaps buffers, then tells the plugin.  Installed on the first
+	//! context only, so that there's one swap per frame.
+	//!
+	class SwapCallback : public osg::GraphicsContext::SwapCallback
+	{
+	public:
+		SwapCallback( PluginRenderCameraosgViewer *_plugin ) : plugin( _plugin ) {}
+		virtual void swapBuffersImplementation( osg::GraphicsContext *gc );
+	private:
+		PluginRenderCameraosgViewer *plugin;
+	};
+	friend class SwapCallback;
+
+	osg::ref_ptr<osgViewer::Viewer> viewer;
+	osg::Node *scene;
+
+	//=========================================================
+	//! The cameras for the views, keyed by view ID.  Retrieved from the 
+	//! blackboard, if PluginRenderCameraOSGNode posted them.
+	//!
+	std::map< int, osg::ref_ptr<osg::Camera> > *viewCameras;
+
+	//=========================================================
+	//! The root node of the scene graph.  Retrieved from the blackboard.
+	//! The scene data when the views are rendered through their cameras.
+	//!
+	osg::Group *rootNode;
+
+	//! the window, when the views are rendered through their cameras
+	osg::ref_ptr<osg::GraphicsContext> graphicsContext;
+
+	//=========================================================
+	//! Configuration data.  Retrieved from the blackboard.
+	//!
+	DefFileGroup **DefFileData;
+
+	//=========================================================
+	//! Frame handoff from the kernel.  Retrieved from the blackboard.
+	//!
+	mpv::FrameHandoff *frameHandoff;
+
+	//! from the config; only read at startup
+	bool useRenderThread;
+
+	osgViewer::ViewerBase::ThreadingModel threadingModel;
+	//! set when the config changes the threading model; the model is only
+	//! applied then, so that the ThreadingHandler's changes stick
+	bool threadingModelChanged;
+
+	//! seconds between latency reports; 0 disables them
+	float latencyReportInterval;
+
+	//! from the config; only read at startup
+	bool usePerViewCameras;
+	int windowWidth;
+	int windowHeight;
+	bool fullscreen;
+	bool offscreen;
+	std::string windowTitle;
+
+	RenderThread *renderThread;
+	bool realized;
+
+	//! set by act() for the frames that should be rendered; the render
+	//! thread reads it while the kernel is between frames
+	bool renderRequested;
+
+	//=========================================================
+	//! When the kernel began each frame that has been rendered but not yet
+	//! swapped, oldest first.  Frames are swapped in the order they are
+	//! rendered, so the swap callback takes the front one.
+	//!
+	std::deque<double> unswappedFrames;
+
+	//=========================================================
+	//! Latency since the last report.  Protected by latencyMutex, along
+	//! with unswappedFrames.
+	//!
+	int latencyCount;
+	double latencySum;
+	double latencyMax;
+	double lastReportTime;
+	OpenThreads::Mutex latencyMutex;
 };
 
 
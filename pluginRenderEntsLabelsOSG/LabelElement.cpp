@@ -45,7 +45,8 @@ using namespace mpvosg;
 // ================================================
 // LabelElement
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-LabelElement::LabelElement() : EntityElement()
+LabelElement::LabelElement( LabelManager *manager ) : EntityElement(), 
+	labelManager( manager )
 {
 	groupNode = new osg::Group;
 }
@@ -70,6 +71,7 @@ bool LabelElement::construct( DefFileGroup *config, Entity *entity )
 	std::string defaultText = entity->getName();
 	float textSize = 0.2;
 	osg::Vec3 offset( 0, 0, 0 );
+	int priority = 0;
 
 	DefFileAttrib *attr;
 
@@ -105,11 +107,19 @@ bool LabelElement::construct( DefFileGroup *config, Entity *entity )
 			offset.set( v[0], v[1], v[2] );
 	}
 
-	LabelNode *label = new LabelNode;
+	// check to see if there is a "priority" attribute
+	attr = config->getAttribute( "priority" );
+	if( attr )
+	{
+		priority = attr->asInt();
+	}
+
+	LabelNode *label = new LabelNode( labelManager.get() );
 	label->setText( defaultText );
 	label->setColor( color );
 	label->setSize( textSize );
 	label->setPosition( offset );
+	label->setPriority( priority );
 	groupNode->addChild( label );
 
 	// check to see if there is a "component_id" attribute
@@ -32,13 +32,14 @@
 #include <osg/Group>
 
 #include "EntityElement.h"
+#include "LabelManager.h"
 
 
 class LabelElement : public mpvosg::EntityElement
 {
 public:
 
-	LabelElement();
+	LabelElement( LabelManager *manager );
 
 	virtual ~LabelElement();
 	
@@ -51,6 +52,8 @@ public:
 protected:
 
 	osg::ref_ptr< osg::Group > groupNode;
+	
+	osg::ref_ptr< LabelManager > labelManager;
 };
 
 
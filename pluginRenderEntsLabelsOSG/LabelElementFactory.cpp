@@ -34,7 +34,9 @@ using namespace mpvosg;
 // ================================================
 // constructor
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-LabelElementFactory::LabelElementFactory() : EntityElementFactory()
+LabelElementFactory::LabelElementFactory( LabelManager *manager ) : 
+	EntityElementFactory(), 
+	labelManager( manager )
 {
 	keyword = "label";
 }
@@ -60,7 +62,7 @@ EntityElement *LabelElementFactory::createElement(
 	DefFileAttrib *attr = elementDefinition->getAttribute( "element_type" );
 	if( attr == NULL || attr->asString() != keyword ) return NULL;
 	
-	LabelElement *result = new LabelElement();
+	LabelElement *result = new LabelElement( labelManager.get() );
 	
 	if( !result->construct( elementDefinition, entity ) )
 	{
@@ -27,13 +27,16 @@
 #ifndef _LABEL_ELEMENT_FACTORY_H_
 #define _LABEL_ELEMENT_FACTORY_H_
 
+#include <osg/ref_ptr>
+
 #include "EntityElementFactory.h"
+#include "LabelManager.h"
 
 
 class LabelElementFactory : public mpvosg::EntityElementFactory
 {
 public:
-	LabelElementFactory();
+	LabelElementFactory( LabelManager *manager );
 	virtual ~LabelElementFactory();
 	
 	virtual mpvosg::EntityElement *createElement( 
@@ -42,6 +45,8 @@ public:
 	
 protected:
 	
+	//! the label manager shared by all of the labels
+	osg::ref_ptr< LabelManager > labelManager;
 };
 
 #endif
@@ -0,0 +1,459 @@
+/** <pre>
+ *  Plugin to add text labels to entities, for the MPV
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  Initial Release: 2026-10-19
+ *  
+ * </pre>
+ */
+
+
+#include <algorithm>
+#include <math.h>
+
+#include <OpenThreads/ScopedLock>
+
+#include <osg/BlendFunc>
+#include <osg/Drawable>
+#include <osg/State>
+#include <osg/StateSet>
+#include <osg/Viewport>
+#include <osgText/String>
+#include <osgUtil/RenderStage>
+
+#include "LabelManager.h"
+
+
+namespace
+{
+
+//=========================================================
+//! The manager's only drawable.  It has no bounds of its own (its geode 
+//! is never culled), and simply hands drawing back to the manager.
+//! 
+class LabelBatchDrawable : public osg::Drawable
+{
+public:
+	
+	LabelBatchDrawable( LabelManager *newManager = NULL ) : 
+		osg::Drawable(), 
+		manager( newManager )
+	{
+		setSupportsDisplayList( false );
+		setUseDisplayList( false );
+		setDataVariance( osg::Object::DYNAMIC );
+	}
+	
+	LabelBatchDrawable( const LabelBatchDrawable &other, 
+		const osg::CopyOp &copyop = osg::CopyOp::SHALLOW_COPY ) : 
+		osg::Drawable( other, copyop ), 
+		manager( other.manager )
+	{
+	}
+	
+	META_Object( mpv, LabelBatchDrawable );
+	
+	virtual osg::BoundingBox computeBound() const
+	{
+		return osg::BoundingBox();
+	}
+	
+	virtual void drawImplementation( osg::RenderInfo &renderInfo ) const
+	{
+		if( manager != NULL )
+			manager->draw( renderInfo );
+	}
+	
+protected:
+	
+	//! not a ref_ptr, as the manager owns the drawable
+	LabelManager *manager;
+};
+
+
+//=========================================================
+//! Orders requests by descending priority, then ascending distance
+//! 
+struct RequestOrder
+{
+	RequestOrder( const std::vector<LabelRequest> &r ) : requests( r ) {}
+	
+	bool operator()( int a, int b ) const
+	{
+		const LabelRequest &ra = requests[a];
+		const LabelRequest &rb = requests[b];
+		if( ra.priority != rb.priority )
+			return ra.priority > rb.priority;
+		return ra.distance < rb.distance;
+	}
+	
+	const std::vector<LabelRequest> &requests;
+};
+
+}
+
+
+// ================================================
+// ViewLabels
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+LabelManager::ViewLabels::ViewLabels() : 
+	projection( new osg::RefMatrix ), 
+	modelView( new osg::RefMatrix )
+{
+	frames[0].number = frames[1].number = (unsigned int)-1;
+}
+
+
+// ================================================
+// LabelManager
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+LabelManager::LabelManager() : osg::Referenced(), 
+	fontResolution( 32, 32 ), 
+	declutter( true ), 
+	margin( 2.0 ), 
+	cellSize( 64.0 )
+{
+	geode = new osg::Geode;
+	geode->setName( "Entity Labels" );
+	// the labels can be anywhere on screen, in any view
+	geode->setCullingActive( false );
+	geode->addDrawable( new LabelBatchDrawable( this ) );
+	
+	osg::StateSet *stateset = geode->getOrCreateStateSet();
+	
+	stateset->setMode( GL_LIGHTING, 
+		osg::StateAttribute::OVERRIDE|osg::StateAttribute::OFF );
+	stateset->setMode( GL_CULL_FACE, osg::StateAttribute::OFF );
+	stateset->setTextureMode( 0, GL_TEXTURE_2D, osg::StateAttribute::ON );
+	
+	stateset->setMode( GL_BLEND, osg::StateAttribute::ON );
+	stateset->setAttributeAndModes( new osg::BlendFunc( 
+		osg::BlendFunc::SRC_ALPHA, osg::BlendFunc::ONE_MINUS_SRC_ALPHA ) );
+	
+	// the labels are drawn after everything else, and always on top
+	stateset->setMode( GL_DEPTH_TEST, osg::StateAttribute::OFF );
+	stateset->setRenderBinDetails( 11, "RenderBin" );
+}
+
+
+// ================================================
+// ~LabelManager
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+LabelManager::~LabelManager()
+{
+	ViewMap::iterator iter;
+	for( iter = views.begin(); iter != views.end(); iter++ )
+		delete iter->second;
+}
+
+
+// ================================================
+// setFont
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool LabelManager::setFont( const std::string &fontFile )
+{
+	osgText::Font *newFont = osgText::readFontFile( fontFile );
+	if( newFont == NULL )
+		return false;
+	
+	font = newFont;
+	return true;
+}
+
+
+// ================================================
+// createLayout
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+LabelLayout *LabelManager::createLayout( const std::string &text )
+{
+	if( !font.valid() )
+		return NULL;
+	
+	LabelLayout *layout = new LabelLayout;
+	layout->xMin = layout->yMin = 0.0;
+	layout->xMax = layout->yMax = 0.0;
+	
+	osgText::String characters( text );
+	float x = 0.0;
+	for( unsigned int i = 0; i < characters.size(); i++ )
+	{
+		osgText::Font::Glyph *glyph = 
+			font->getGlyph( fontResolution, characters[i] );
+		if( glyph == NULL )
+			continue;
+		
+		LabelLayout::Glyph entry;
+		entry.glyph = glyph;
+		entry.position.set( x + glyph->getHorizontalBearing().x(), 
+			glyph->getHorizontalBearing().y() );
+		
+		osg::Vec2 corner = entry.position + osg::Vec2( glyph->s(), glyph->t() );
+		if( layout->glyphs.empty() )
+		{
+			layout->xMin = entry.position.x();
+			layout->yMin = entry.position.y();
+			layout->xMax = corner.x();
+			layout->yMax = corner.y();
+		}
+		else
+		{
+			layout->xMin = std::min( layout->xMin, entry.position.x() );
+			layout->yMin = std::min( layout->yMin, entry.position.y() );
+			layout->xMax = std::max( layout->xMax, corner.x() );
+			layout->yMax = std::max( layout->yMax, corner.y() );
+		}
+		
+		layout->glyphs.push_back( entry );
+		x += glyph->getHorizontalAdvance();
+	}
+	
+	return layout;
+}
+
+
+// ================================================
+// getView
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+LabelManager::ViewLabels *LabelManager::getView( const osg::Camera *camera )
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( viewsMutex );
+	
+	ViewLabels *&view = views[camera];
+	if( view == NULL )
+		view = new ViewLabels;
+	return view;
+}
+
+
+// ================================================
+// submit
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void LabelManager::submit( osgUtil::CullVisitor *cv, const LabelRequest &request )
+{
+	// key the view on the camera that will draw it
+	osgUtil::RenderStage *renderStage = cv->getCurrentRenderStage();
+	const osg::Camera *camera = ( renderStage != NULL ) ? renderStage->getCamera() : NULL;
+	const osg::FrameStamp *frameStamp = cv->getFrameStamp();
+	if( camera == NULL || frameStamp == NULL )
+		return;
+	
+	ViewLabels *view = getView( camera );
+	
+	unsigned int frameNumber = frameStamp->getFrameNumber();
+	ViewLabels::Frame &frame = view->frames[frameNumber & 1];
+	
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( frame.mutex );
+	if( frame.number != frameNumber )
+	{
+		frame.requests.clear();
+		frame.number = frameNumber;
+	}
+	frame.requests.push_back( request );
+}
+
+
+// ================================================
+// draw
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void LabelManager::draw( osg::RenderInfo &renderInfo )
+{
+	osg::State *state = renderInfo.getState();
+	const osg::Camera *camera = renderInfo.getCurrentCamera();
+	const osg::FrameStamp *frameStamp = state->getFrameStamp();
+	const osg::Viewport *viewport = state->getCurrentViewport();
+	if( camera == NULL || frameStamp == NULL || viewport == NULL )
+		return;
+	
+	ViewLabels *view = getView( camera );
+	
+	unsigned int frameNumber = frameStamp->getFrameNumber();
+	ViewLabels::Frame &frame = view->frames[frameNumber & 1];
+	
+	{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( frame.mutex );
+		if( frame.number != frameNumber || frame.requests.empty() )
+			return;
+		placeLabels( view, frame.requests, viewport );
+	}
+	
+	// draw in window coordinates
+	view->projection->set( osg::Matrix::ortho2D( 
+		viewport->x(), viewport->x() + viewport->width(), 
+		viewport->y(), viewport->y() + viewport->height() ) );
+	state->applyProjectionMatrix( view->projection.get() );
+	state->applyModelViewMatrix( view->modelView.get() );
+	
+	state->disableAllVertexArrays();
+	state->unbindVertexBufferObject();
+	
+	BatchMap::iterator iter;
+	for( iter = view->batches.begin(); iter != view->batches.end(); iter++ )
+	{
+		Batch &batch = iter->second;
+		if( batch.vertices.empty() )
+			continue;
+		
+		state->applyTextureAttribute( 0, iter->first );
+		state->applyTextureMode( 0, GL_TEXTURE_2D, true );
+		
+		state->setVertexPointer( 2, GL_FLOAT, 0, &batch.vertices[0] );
+		state->setTexCoordPointer( 0, 2, GL_FLOAT, 0, &batch.texCoords[0] );
+		state->setColorPointer( 4, GL_FLOAT, 0, &batch.colors[0] );
+		
+		glDrawArrays( GL_QUADS, 0, batch.vertices.size() );
+	}
+}
+
+
+// ================================================
+// placeLabels
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void LabelManager::placeLabels( ViewLabels *view, 
+	std::vector<LabelRequest> &requests, const osg::Viewport *viewport )
+{
+	BatchMap::iterator batchIter;
+	for( batchIter = view->batches.begin(); batchIter != view->batches.end(); batchIter++ )
+	{
+		batchIter->second.vertices.clear();
+		batchIter->second.texCoords.clear();
+		batchIter->second.colors.clear();
+	}
+	
+	int count = requests.size();
+	view->order.resize( count );
+	for( int i = 0; i < count; i++ )
+		view->order[i] = i;
+	if( declutter )
+		std::sort( view->order.begin(), view->order.end(), RequestOrder( requests ) );
+	
+	float viewXMin = viewport->x();
+	float viewYMin = viewport->y();
+	float viewXMax = viewXMin + viewport->width();
+	float viewYMax = viewYMin + viewport->height();
+	
+	// The collision grid covers the viewport.  Each cell lists the placed 
+	// labels that overlap it, so a new label is only tested against its 
+	// neighbours.
+	int gridWidth = (int)ceil( viewport->width() / cellSize );
+	int gridHeight = (int)ceil( viewport->height() / cellSize );
+	view->placed.clear();
+	if( declutter )
+	{
+		view->grid.resize( gridWidth * gridHeight );
+		for( unsigned int i = 0; i < view->grid.size(); i++ )
+			view->grid[i].clear();
+	}
+	
+	for( int i = 0; i < count; i++ )
+	{
+		const LabelRequest &request = requests[view->order[i]];
+		const LabelLayout *layout = request.layout.get();
+		
+		float width = ( layout->xMax - layout->xMin ) * request.scale;
+		float height = ( layout->yMax - layout->yMin ) * request.scale;
+		
+		// snap to whole pixels, to keep the glyphs sharp
+		Rect rect;
+		rect.xMin = floor( request.anchor.x() - width * 0.5 + 0.5 );
+		rect.yMin = floor( request.anchor.y() + 0.5 );
+		rect.xMax = rect.xMin + width;
+		rect.yMax = rect.yMin + height;
+		
+		if( rect.xMax < viewXMin || rect.xMin > viewXMax || 
+			rect.yMax < viewYMin || rect.yMin > viewYMax )
+			continue;
+		
+		if( declutter )
+		{
+			int cellXMin = std::max( 0, (int)( ( rect.xMin - margin - viewXMin ) / cellSize ) );
+			int cellYMin = std::max( 0, (int)( ( rect.yMin - margin - viewYMin ) / cellSize ) );
+			int cellXMax = std::min( gridWidth - 1, (int)( ( rect.xMax + margin - viewXMin ) / cellSize ) );
+			int cellYMax = std::min( gridHeight - 1, (int)( ( rect.yMax + margin - viewYMin ) / cellSize ) );
+			
+			bool collides = false;
+			for( int y = cellYMin; y <= cellYMax && !collides; y++ )
+			{
+				for( int x = cellXMin; x <= cellXMax && !collides; x++ )
+				{
+					const std::vector<int> &cell = view->grid[y * gridWidth + x];
+					for( unsigned int j = 0; j < cell.size(); j++ )
+					{
+						const Rect &other = view->placed[cell[j]];
+						if( rect.xMin < other.xMax + margin && other.xMin < rect.xMax + margin && 
+							rect.yMin < other.yMax + margin && other.yMin < rect.yMax + margin )
+						{
+							collides = true;
+							break;
+						}
+					}
+				}
+			}
+			
+			if( collides )
+				continue;
+			
+			int index = view->placed.size();
+			view->placed.push_back( rect );
+			for( int y = cellYMin; y <= cellYMax; y++ )
+				for( int x = cellXMin; x <= cellXMax; x++ )
+					view->grid[y * gridWidth + x].push_back( index );
+		}
+		
+		addGlyphs( view, request, rect );
+	}
+}
+
+
+// ================================================
+// addGlyphs
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void LabelManager::addGlyphs( ViewLabels *view, const LabelRequest &request, 
+	const Rect &rect )
+{
+	const LabelLayout *layout = request.layout.get();
+	float scale = request.scale;
+	
+	for( unsigned int i = 0; i < layout->glyphs.size(); i++ )
+	{
+		const LabelLayout::Glyph &entry = layout->glyphs[i];
+		const osgText::Font::Glyph *glyph = entry.glyph.get();
+		
+		Batch &batch = view->batches[glyph->getTexture()];
+		
+		float x0 = rect.xMin + ( entry.position.x() - layout->xMin ) * scale;
+		float y0 = rect.yMin + ( entry.position.y() - layout->yMin ) * scale;
+		float x1 = x0 + glyph->s() * scale;
+		float y1 = y0 + glyph->t() * scale;
+		
+		const osg::Vec2 &minTC = glyph->getMinTexCoord();
+		const osg::Vec2 &maxTC = glyph->getMaxTexCoord();
+		
+		batch.vertices.push_back( osg::Vec2( x0, y0 ) );
+		batch.vertices.push_back( osg::Vec2( x1, y0 ) );
+		batch.vertices.push_back( osg::Vec2( x1, y1 ) );
+		batch.vertices.push_back( osg::Vec2( x0, y1 ) );
+		
+		batch.texCoords.push_back( osg::Vec2( minTC.x(), minTC.y() ) );
+		batch.texCoords.push_back( osg::Vec2( maxTC.x(), minTC.y() ) );
+		batch.texCoords.push_back( osg::Vec2( maxTC.x(), maxTC.y() ) );
+		batch.texCoords.push_back( osg::Vec2( minTC.x(), maxTC.y() ) );
+		
+		for( int corner = 0; corner < 4; corner++ )
+			batch.colors.push_back( request.color );
+	}
+}
@@ -0,0 +1,230 @@
+/** <pre>
+ *  Plugin to add text labels to entities, for the MPV
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  Initial Release: 2026-10-19
+ *  
+ * </pre>
+ */
+
+
+#ifndef _LABEL_MANAGER_H_
+#define _LABEL_MANAGER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <OpenThreads/Mutex>
+
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+#include <osg/Geode>
+#include <osg/Matrix>
+#include <osg/RenderInfo>
+#include <osg/Vec2>
+#include <osg/Vec4>
+#include <osgText/Font>
+#include <osgUtil/CullVisitor>
+
+
+//=========================================================
+//! The glyphs for one label's text, laid out left to right in font 
+//! texels.  A layout is never modified once created; LabelNode makes a 
+//! new one when its text changes, so a layout can safely be drawn while 
+//! the text is being changed.
+//! 
+struct LabelLayout : public osg::Referenced
+{
+	struct Glyph
+	{
+		osg::ref_ptr<osgText::Font::Glyph> glyph;
+		//! the glyph's lower left corner
+		osg::Vec2 position;
+	};
+	
+	std::vector<Glyph> glyphs;
+	
+	//! the extents of the glyphs
+	float xMin, xMax, yMin, yMax;
+};
+
+
+//=========================================================
+//! A label that survived culling, as submitted by a LabelNode
+//! 
+struct LabelRequest
+{
+	osg::ref_ptr<const LabelLayout> layout;
+	
+	//! the anchor point (bottom center of the text), in window coordinates
+	osg::Vec2 anchor;
+	
+	//! distance from the eyepoint; nearer labels win ties
+	float distance;
+	
+	//! pixels per font texel
+	float scale;
+	
+	osg::Vec4 color;
+	
+	//! higher priority labels are placed first
+	int priority;
+};
+
+
+//=========================================================
+//! Collects the labels that each view culls in a frame, removes those 
+//! that would overlap a higher priority label on screen, and draws the 
+//! rest in one batch per glyph texture.  Individual labels don't own any 
+//! drawables; the manager's node (see getNode()) must be added to the 
+//! scene once, and draws on top of everything else in every view.
+//! 
+class LabelManager : public osg::Referenced
+{
+public:
+	
+	LabelManager();
+	
+	//=========================================================
+	//! Loads the font used by all labels
+	//! \return false if the font could not be loaded
+	//! 
+	bool setFont( const std::string &fontFile );
+	
+	//=========================================================
+	//! Enables or disables decluttering.  When disabled, every label 
+	//! is drawn, overlapping or not.
+	//! 
+	void setDeclutter( bool enable ) { declutter = enable; }
+	
+	//=========================================================
+	//! Sets the gap, in pixels, that must separate two labels
+	//! 
+	void setMargin( float newMargin ) { margin = newMargin; }
+	
+	//=========================================================
+	//! Lays out a string in the label font
+	//! \return the layout, or NULL if no font has been loaded
+	//! 
+	LabelLayout *createLayout( const std::string &text );
+	
+	//! Returns the font resolution (glyph height in texels) used by layouts
+	float getFontHeight() const { return fontResolution.second; }
+	
+	//=========================================================
+	//! Adds a label to the cull visitor's view for the current frame.  
+	//! May be called from several cull threads at once, as long as each 
+	//! is culling a different view.
+	//! 
+	void submit( osgUtil::CullVisitor *cv, const LabelRequest &request );
+	
+	//=========================================================
+	//! Returns the node which draws the labels
+	//! 
+	osg::Node *getNode() { return geode.get(); }
+	
+	//=========================================================
+	//! Declutters and draws the labels submitted for the current camera 
+	//! in the current frame.  Called by the manager's drawable.
+	//! 
+	void draw( osg::RenderInfo &renderInfo );
+	
+protected:
+	
+	virtual ~LabelManager();
+	
+private:
+	
+	//! The quads for the glyphs in one glyph texture
+	struct Batch
+	{
+		std::vector<osg::Vec2> vertices;
+		std::vector<osg::Vec2> texCoords;
+		std::vector<osg::Vec4> colors;
+	};
+	
+	typedef std::map< const osgText::Font::GlyphTexture *, Batch > BatchMap;
+	
+	//! A placed label's screen rectangle
+	struct Rect
+	{
+		float xMin, yMin, xMax, yMax;
+	};
+	
+	//=========================================================
+	//! Everything kept per view.  Requests are double buffered by frame 
+	//! number, because some threading models cull the next frame while 
+	//! this one is drawn.
+	//! 
+	struct ViewLabels
+	{
+		ViewLabels();
+		
+		struct Frame
+		{
+			OpenThreads::Mutex mutex;
+			unsigned int number;
+			std::vector<LabelRequest> requests;
+		};
+		
+		//! indexed by the low bit of the frame number
+		Frame frames[2];
+		
+		// scratch space for draw(), kept to avoid reallocating every frame; 
+		// a view is only ever drawn by one thread at a time
+		
+		std::vector<int> order;
+		std::vector<Rect> placed;
+		std::vector< std::vector<int> > grid;
+		BatchMap batches;
+		osg::ref_ptr<osg::RefMatrix> projection;
+		osg::ref_ptr<osg::RefMatrix> modelView;
+	};
+	
+	typedef std::map< const osg::Camera *, ViewLabels * > ViewMap;
+	
+	ViewLabels *getView( const osg::Camera *camera );
+	
+	//=========================================================
+	//! Chooses which of the requests to draw, and fills the batches with 
+	//! their glyphs
+	//! 
+	void placeLabels( ViewLabels *view, std::vector<LabelRequest> &requests, 
+		const osg::Viewport *viewport );
+	
+	//! Adds a label's glyphs to the batches
+	void addGlyphs( ViewLabels *view, const LabelRequest &request, 
+		const Rect &rect );
+	
+	OpenThreads::Mutex viewsMutex;
+	ViewMap views;
+	
+	osg::ref_ptr<osgText::Font> font;
+	osgText::FontResolution fontResolution;
+	
+	osg::ref_ptr<osg::Geode> geode;
+	
+	bool declutter;
+	float margin;
+	
+	//! the size of the cells in the collision grid, in pixels
+	float cellSize;
+};
+
+#endif
@@ -19,6 +19,9 @@
  *  
  *  Initial Release: 2006-03-19 Andrew Sampson
  *  
+ *  2026-10-19
+ *      Labels no longer own a text drawable; they are decluttered and 
+ *      drawn in batches by LabelManager.
  * </pre>
  */
 
@@ -29,14 +32,7 @@
 
 #include <osgUtil/CullVisitor>
 
-#include <osg/Geode>
-#include <osg/Geometry>
-#include <osg/Depth>
-#include <osg/StateSet>
-#include <osg/Material>
-
-#include <osg/MatrixTransform>
-#include <osg/Projection>
+#include <osg/Viewport>
 
 #include "LabelNode.h"
 
@@ -55,11 +51,32 @@ LabelNode::LabelNode()
 }
 
 
+// ================================================
+// LabelNode
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+LabelNode::LabelNode( LabelManager *manager ) : 
+	labelManager( manager )
+{
+	init();
+}
+
+
 // ================================================
 // LabelNode
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 LabelNode::LabelNode(const LabelNode& dn,const CopyOp& copyop):
-		Group(dn,copyop)
+		Group(dn,copyop), 
+		fadeDistNear( dn.fadeDistNear ), 
+		fadeDistFar( dn.fadeDistFar ), 
+		alphaMin( dn.alphaMin ), 
+		alphaMax( dn.alphaMax ), 
+		textColor( dn.textColor ), 
+		text( dn.text ), 
+		characterSize( dn.characterSize ), 
+		textPosition( dn.textPosition ), 
+		priority( dn.priority ), 
+		labelManager( dn.labelManager ), 
+		layout( dn.layout )
 {
 }
 
@@ -69,50 +86,79 @@ LabelNode::LabelNode(const LabelNode& dn,const CopyOp& copyop):
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void LabelNode::traverse( NodeVisitor &nv )
 {
-
-	if( nv.getTraversalMode() == NodeVisitor::TRAVERSE_ACTIVE_CHILDREN )
+	osgUtil::CullVisitor *cv = dynamic_cast<osgUtil::CullVisitor*>( &nv );
+	if( cv != NULL )
 	{
-		// The opacity adjustment should only be done once per frame, when the 
-		// cull visitor traverses this node.
-		
-		float dist = nv.getDistanceToEyePoint( osg::Vec3(0,0,0), true );
-		
-		if( dist > fadeDistFar )
-		{
-			// if the camera is farther away than fadeDistFar, turn off the 
-			// children entirely
-			return;
-		}
-		
-		if( dist < fadeDistNear )
-		{
-			// do not modify the alpha if the camera is nearer than 
-			// fadeDistNear
-
-			textDrawable->setColor( osg::Vec4( textColor, alphaMax ) );
-		}
-		else
-		{
-			float alpha = alphaMax /* * 
-				((dist - fadeDistNear) / (fadeDistFar - fadeDistNear)) */ ;
-		
-			textDrawable->setColor( osg::Vec4( textColor, alpha ) );
-		}
-		
-		// don't need to dirty the display list, b/c display lists are disabled 
-		// for textDrawable
+		submit( cv );
 	}
 	
 	Group::traverse( nv );
 }
 
 
+// ================================================
+// submit
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void LabelNode::submit( osgUtil::CullVisitor *cv )
+{
+	if( !labelManager.valid() || !layout.valid() || layout->glyphs.empty() )
+		return;
+	
+	float dist = cv->getDistanceToEyePoint( textPosition, true );
+	
+	if( dist > fadeDistFar )
+	{
+		// if the camera is farther away than fadeDistFar, turn off the 
+		// label entirely
+		return;
+	}
+	
+	const osg::RefMatrix *modelView = cv->getModelViewMatrix();
+	const osg::RefMatrix *projection = cv->getProjectionMatrix();
+	const osg::Viewport *viewport = cv->getViewport();
+	if( modelView == NULL || projection == NULL || viewport == NULL )
+		return;
+	
+	// the label is behind the eyepoint
+	osg::Vec3 eye = textPosition * (*modelView);
+	if( eye.z() >= 0.0 )
+		return;
+	
+	// The text faces the screen, so its height in pixels is the projected 
+	// height of a vertical line characterSize long.
+	osg::Matrix eyeToWindow = (*projection) * viewport->computeWindowMatrix();
+	osg::Vec3 bottom = eye * eyeToWindow;
+	osg::Vec3 top = ( eye + osg::Vec3( 0.0, characterSize, 0.0 ) ) * eyeToWindow;
+	float pixelHeight = top.y() - bottom.y();
+	if( pixelHeight <= 0.0 )
+		return;
+	
+	LabelRequest request;
+	request.layout = layout;
+	request.anchor.set( bottom.x(), bottom.y() );
+	request.distance = dist;
+	request.scale = pixelHeight / labelManager->getFontHeight();
+	request.priority = priority;
+	
+	// The fade between fadeDistNear and fadeDistFar has never been enabled; 
+	// labels are drawn at alphaMax until they disappear at fadeDistFar.
+	request.color.set( textColor.x(), textColor.y(), textColor.z(), alphaMax );
+	
+	labelManager->submit( cv, request );
+}
+
+
 // ================================================
 // setText
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void LabelNode::setText( const std::string &newText )
 {
-	textDrawable->setText( newText );
+	if( newText == text && layout.valid() )
+		return;
+	
+	text = newText;
+	if( labelManager.valid() )
+		layout = labelManager->createLayout( text );
 }
 
 
@@ -122,7 +168,7 @@ void LabelNode::setText( const std::string &newText )
 void LabelNode::setColor( const osg::Vec3 &color )
 {
 	textColor = color;
-	// traverse() will take care of propagating this value to textDrawable
+	// submit() will take care of passing this value to the label manager
 }
 
 
@@ -131,7 +177,8 @@ void LabelNode::setColor( const osg::Vec3 &color )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void LabelNode::setSize( float newSize )
 {
-	textDrawable->setCharacterSize( newSize );
+	characterSize = newSize;
+	setInitialBound( osg::BoundingSphere( textPosition, characterSize ) );
 }
 
 
@@ -140,7 +187,17 @@ void LabelNode::setSize( float newSize )
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void LabelNode::setPosition( const osg::Vec3 &newPosition )
 {
-	textDrawable->setPosition( newPosition );
+	textPosition = newPosition;
+	setInitialBound( osg::BoundingSphere( textPosition, characterSize ) );
+}
+
+
+// ================================================
+// setPriority
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void LabelNode::setPriority( int newPriority )
+{
+	priority = newPriority;
 }
 
 
@@ -158,46 +215,14 @@ void LabelNode::init()
 	// the default text color is green
 	textColor.set( 0, 1, 0 );
 	
-	createText();
-}
-
-
-// ================================================
-// createText
-// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-void LabelNode::createText()
-{
-	osg::Geode *geode = new osg::Geode;
-	geode->setName( "Entity Label" );
-	
-	textDrawable = new osgText::Text;
-	textDrawable->setText( "" );
-	textDrawable->setUseDisplayList( false );
-	textDrawable->setFont( 0 );
-	textDrawable->setCharacterSize( 0.2 );
-	textDrawable->setPosition( osg::Vec3( 0., 0., 0. ) );
-	textDrawable->setColor( osg::Vec4( textColor, alphaMax ) );
-	textDrawable->setAlignment( osgText::Text::CENTER_BOTTOM );
-	textDrawable->setAxisAlignment( osgText::Text::SCREEN );
+	characterSize = 0.2;
+	textPosition.set( 0., 0., 0. );
+	priority = 0;
 	
-	geode->addDrawable( textDrawable.get() );
+	// The label has no drawables of its own, so give it a bound; otherwise 
+	// it would never be culled, or always be.
+	setInitialBound( osg::BoundingSphere( textPosition, characterSize ) );
 	
-	osg::StateSet *stateset = geode->getOrCreateStateSet();
-
-	// don't want lighting
-	stateset->setMode( GL_LIGHTING, 
-		osg::StateAttribute::OVERRIDE|osg::StateAttribute::OFF );
-
-	// definitely want blending (EntitySubgraphWrapper will enable blending 
-	// too, but it can't hurt to make sure...)
-	stateset->setMode( GL_BLEND, osg::StateAttribute::ON );
-
-	// don't want clockwise polygons
-	stateset->setMode( GL_CULL_FACE, StateAttribute::ON );
-
-	// transparent stuff goes in the last render bin
-	stateset->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-
-	addChild( geode );
+	setName( "Entity Label" );
+	setText( "" );
 }
-
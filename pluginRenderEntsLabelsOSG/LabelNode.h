@@ -19,6 +19,9 @@
  *  
  *  Initial Release: 2006-03-19 Andrew Sampson
  *  
+ *  2026-10-19
+ *      Labels no longer own a text drawable; they are decluttered and 
+ *      drawn in batches by LabelManager.
  * </pre>
  */
 
@@ -27,11 +30,16 @@
 #define LABELNODE_H
 
 #include <osg/Group>
-#include <osgText/Text>
+#include <osgUtil/CullVisitor>
 #include <string>
 
+#include "LabelManager.h"
+
 //=========================================================
-//! This class ...
+//! A text label, attached to an entity.  The label doesn't draw itself; 
+//! when culled, it hands its text, color and screen position to the 
+//! LabelManager, which declutters and draws all of the labels for a view 
+//! together.
 //! 
 class LabelNode : public osg::Group
 {
@@ -42,6 +50,12 @@ class LabelNode : public osg::Group
 		//!
         LabelNode();
 
+		//=========================================================
+		//! Constructor
+		//! \param manager - the label manager that will draw this label
+		//!
+        LabelNode( LabelManager *manager );
+
 		//=========================================================
 		//! Copy constructor 
 		//!
@@ -71,14 +85,21 @@ class LabelNode : public osg::Group
 		//!
 		void setPosition( const osg::Vec3 &newPosition );
 		
+		//=========================================================
+		//! 
+		//! \param newPriority - when labels overlap on screen, the one with 
+		//!        the highest priority is drawn
+		//!
+		void setPriority( int newPriority );
+		
 		//=========================================================
 		//! Macro that sets up some OSG stuff
 		//!
         META_Node(osg, LabelNode);
 
 		//=========================================================
-		//! Updates the text's opacity, according to the distance between 
-		//! the eyepoint and the node.
+		//! Submits the label to the label manager, if it is close enough 
+		//! to the eyepoint to be seen.
 		//! \param nv - the node visitor that is acting on this node
 		//!
 		void traverse( osg::NodeVisitor &nv );
@@ -118,11 +139,36 @@ class LabelNode : public osg::Group
 		osg::Vec3 textColor;
 
 		//=========================================================
-		//! The text label.  We need to hold on to a reference to it so 
-		//! that we can modify its opacity in traverse() and modify its 
-		//! text string in setText().
+		//! The text string.
+		//!
+		std::string text;
+
+		//=========================================================
+		//! The height of the text, in the same units as the entity.
+		//!
+		float characterSize;
+
+		//=========================================================
+		//! The offset of the bottom center of the text from the entity's 
+		//! origin.
+		//!
+		osg::Vec3 textPosition;
+
+		//=========================================================
+		//! See setPriority().
+		//!
+		int priority;
+
+		//=========================================================
+		//! The label manager, which draws this label.
+		//!
+		osg::ref_ptr< LabelManager > labelManager;
+
+		//=========================================================
+		//! The glyphs for the current text.  Replaced, never modified, 
+		//! when the text changes.
 		//!
-		osg::ref_ptr< osgText::Text > textDrawable;
+		osg::ref_ptr< LabelLayout > layout;
 
 		//=========================================================
 		//! Initializes member variables.  Called by constructors.
@@ -130,10 +176,10 @@ class LabelNode : public osg::Group
 		void init();
 
 		//=========================================================
-		//! A helper function which creates textDrawable and attaches it as a 
-		//! child.
+		//! Works out where the label falls on screen and submits it to 
+		//! the label manager.
 		//!
-		void createText();
+		void submit( osgUtil::CullVisitor *cv );
 };
 
 #endif
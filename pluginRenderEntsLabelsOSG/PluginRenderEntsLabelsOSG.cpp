@@ -33,6 +33,7 @@
 
 #include "PluginRenderEntsLabelsOSG.h"
 #include "LabelElementFactory.h"
+#include "Log.h"
 
 using namespace mpv;
 using namespace mpvosg;
@@ -49,6 +50,12 @@ PluginRenderEntsLabelsOSG::PluginRenderEntsLabelsOSG() : Plugin()
 	licenseInfo_.setOrigin( "AndrewSampson" );
 
 	dependencies_.push_back( "PluginRenderEntsOSG" );
+	dependencies_.push_back( "PluginDefFileReader" );
+
+	DefFileData = NULL;
+	rootNode = NULL;
+
+	labelManager = new LabelManager;
 }
 
 
@@ -71,15 +78,26 @@ void PluginRenderEntsLabelsOSG::act( SystemState::ID state, StateContext &stateC
 	case SystemState::BlackboardRetrieve:
 		// This state is for retrieving things from the blackboard
 
+		bb_->get( "DefinitionData", DefFileData );
+
 		// get the list of entity element factories from the BB
 		{
 			std::map< std::string, EntityElementFactory * > *entityElementFactoryMap;
 
 			bb_->get( "EntityElementFactories", entityElementFactoryMap );
-			EntityElementFactory *factory = new LabelElementFactory;
+			EntityElementFactory *factory = 
+				new LabelElementFactory( labelManager.get() );
 			(*entityElementFactoryMap)[factory->getKeyword()] = factory;
 		}
 		
+		// the label manager's node draws the labels for every view
+		bb_->get( "RootNodeOSG", rootNode );
+		rootNode->addChild( labelManager->getNode() );
+		
+		break;
+
+	case SystemState::ConfigurationProcess:
+		getConfig();
 		break;
 
 	default:
@@ -88,3 +106,48 @@ void PluginRenderEntsLabelsOSG::act( SystemState::ID state, StateContext &stateC
 	
 }
 
+
+// ================================================
+// getConfig
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderEntsLabelsOSG::getConfig()
+{
+	std::string newFontFile = "fonts/arial.ttf";
+	bool declutter = true;
+	float margin = 2.0;
+
+	DefFileGroup *root = ( DefFileData != NULL ) ? *DefFileData : NULL;
+	DefFileGroup *group = 
+		( root != NULL ) ? root->getGroupByURI( "/labels/" ) : NULL;
+	if( group != NULL )
+	{
+		DefFileAttrib *attr;
+
+		attr = group->getAttribute( "font" );
+		if( attr )
+			newFontFile = attr->asString();
+
+		attr = group->getAttribute( "declutter" );
+		if( attr )
+			declutter = ( attr->asInt() != 0 );
+
+		attr = group->getAttribute( "margin" );
+		if( attr )
+			margin = attr->asFloat();
+	}
+
+	labelManager->setDeclutter( declutter );
+	labelManager->setMargin( margin );
+
+	// the configuration may be reprocessed; only reload the font if it changed
+	if( newFontFile != fontFile )
+	{
+		fontFile = newFontFile;
+		if( !labelManager->setFont( fontFile ) )
+		{
+			MPV_LOG_ERROR( "PluginRenderEntsLabelsOSG - could not load font \"" 
+				<< fontFile << "\"; entity labels will not be drawn" );
+		}
+	}
+}
+
@@ -32,8 +32,15 @@
 #define PLUGIN_RENDER_ENTS_LABELS_OSG_H
 
 #include <list>
+#include <string>
+
+#include <osg/Group>
+#include <osg/ref_ptr>
 
 #include "Plugin.h"
+#include "DefFileGroup.h"
+
+#include "LabelManager.h"
 
 //=========================================================
 //! This plugin is responsible for adding text labels to entities.  
@@ -41,6 +48,10 @@
 //! fields, etc), and the like.  Note that the *Host* determines the content 
 //! of the text fields.
 //! 
+//! All of the labels are drawn by a single LabelManager, which removes 
+//! labels that would overlap on screen (keeping the highest priority, 
+//! nearest ones) and draws the rest in one batch.
+//! 
 class PluginRenderEntsLabelsOSG : public Plugin 
 {
 public:
@@ -65,6 +76,33 @@ public:
 	
 private:
 
+	//=========================================================
+	//! Reads the "labels" group from the config data
+	//!
+	void getConfig();
+
+	//=========================================================
+	//! The config data.
+	//! Retrieved from the blackboard.
+	//!
+	DefFileGroup **DefFileData;
+
+	//=========================================================
+	//! The root node of the scene.  The label manager's node is added 
+	//! to it.
+	//! Retrieved from the blackboard.
+	//!
+	osg::Group *rootNode;
+
+	//=========================================================
+	//! Declutters and draws all of the labels
+	//!
+	osg::ref_ptr< LabelManager > labelManager;
+
+	//=========================================================
+	//! The font file, as last loaded
+	//!
+	std::string fontFile;
 };
 
 #endif
@@ -21,6 +21,9 @@
  *  the resulting scene graph nodes in the form of an "entity element".
  *  
  *  Initial Release: 2007-03-24 Andrew Sampson
+ *  
+ *  2026-10-19
+ *      Added compiled parameters, parsed once per entity type.
  * </pre>
  */
 
@@ -62,13 +65,136 @@ ModelElement::~ModelElement()
 }
 
 
-bool ModelElement::construct( DefFileGroup *config, Entity *entity )
+ModelElement::Params *ModelElement::parse( DefFileGroup *config, int entityType )
 {
-
+	Params *params = new Params;
 	DefFileAttrib *attr = config->getAttribute( "filename" );
 	if( attr )
 	{
-		std::string modelname = attr->asString();
+		params->hasFilename = true;
+		params->filename = attr->asString();
+	}
+	
+	std::list<DefFileGroup *>::iterator groupIter;
+	for( groupIter = config->children.begin(); 
+		groupIter != config->children.end(); groupIter++ )
+	{
+		DefFileGroup *group = *groupIter;
+		
+		// articulated parts
+		if( group->getName() == "built_in_articulated_part" )
+		{
+			Params::ArtPart artPart;
+			
+			attr = group->getAttribute( "art_part_id" );
+			if( attr == NULL )
+			{
+				std::cout << "Warning - in definition for entity type " 
+					<< entityType
+					<< " - articulated part is missing its \"art_part_id\" attribute\n";
+				continue;
+			}
+			artPart.artPartID = attr->asInt();
+			
+			attr = group->getAttribute( "node_name" );
+			if( attr == NULL )
+			{
+				std::cout << "Warning - in definition for entity type " 
+					<< entityType
+					<< " - articulated part " << artPart.artPartID 
+					<< " is missing its \"node_name\" attribute\n";
+				continue;
+			}
+			artPart.nodeName = attr->asString();
+			
+			// FIXME - default "rotation" and "offset" for the articulation 
+			// are not implemented
+			
+			params->artParts.push_back( artPart );
+		}
+		
+		// switchable components
+		else if( group->getName() == "built_in_switch" )
+		{
+			Params::SwitchComponent switchComponent;
+			
+			attr = group->getAttribute( "component_id" );
+			if( attr == NULL )
+			{
+				std::cout << "Warning - in definition for entity type " 
+					<< entityType
+					<< " - switch component is missing its \"component_id\" attribute\n";
+				continue;
+			}
+			switchComponent.componentID = attr->asInt();
+			
+			attr = group->getAttribute( "node_name" );
+			if( attr == NULL )
+			{
+				std::cout << "Warning - in definition for entity type " 
+					<< entityType
+					<< " - switch component " << switchComponent.componentID 
+					<< " is missing its \"node_name\" attribute\n";
+				continue;
+			}
+			switchComponent.nodeName = attr->asString();
+			
+			// Find all the "state" sections.  These sections map a given 
+			// CIGI value to a position/child-node of the switch.  I.E. if 
+			// the Host specifies a value of N for the component control, 
+			// the SwitchNodeCompCtrl will use these state mappings to look 
+			// up the switch position associated with N, and will activate 
+			// that switch position.
+			std::list<DefFileGroup *>::iterator stateIter;
+			for( stateIter = group->children.begin(); 
+				stateIter != group->children.end(); stateIter++ )
+			{
+				DefFileGroup *stateGroup = *stateIter;
+				if( stateGroup->getName() == "state" )
+				{
+					int cigiValue, switchValue;
+					attr = stateGroup->getAttribute( "cigi_value" );
+					if( attr )
+					{
+						cigiValue = attr->asInt();
+						attr = stateGroup->getAttribute( "switch_value" );
+						if( attr )
+						{
+							switchValue = attr->asInt();
+							switchComponent.states.push_back( 
+								std::make_pair( cigiValue, switchValue ) );
+						}
+					}
+				}
+			}
+			
+			attr = group->getAttribute( "default_cigi_value" );
+			if( attr )
+			{
+				switchComponent.hasDefaultValue = true;
+				switchComponent.defaultValue = attr->asInt();
+			}
+			
+			params->switches.push_back( switchComponent );
+		}
+	}
+	
+	return params;
+}
+
+
+bool ModelElement::construct( DefFileGroup *config, Entity *entity )
+{
+	RefPtr<Params> params = parse( config, entity->getType() );
+	return construct( params.get(), entity );
+}
+
+
+bool ModelElement::construct( const Params *params, Entity *entity )
+{
+	if( params->hasFilename )
+	{
+		const std::string &modelname = params->filename;
 
 		osg::Node *cachedNode = modelCache->get( modelname );
 		if( cachedNode == NULL )
@@ -80,13 +206,13 @@ bool ModelElement::construct( DefFileGroup *config, Entity *entity )
 				modelCache->add( modelname, cachedNode );
 			}
 		}
-		copyAndAttachModelNode( config, entity, cachedNode );
+		copyAndAttachModelNode( params, entity, cachedNode );
 	}
 	return true;
 }
 
 
-void ModelElement::copyAndAttachModelNode( DefFileGroup *config, Entity *entity, osg::Node *cachedNode )
+void ModelElement::copyAndAttachModelNode( const Params *params, Entity *entity, osg::Node *cachedNode )
 {
 
 	osg::ref_ptr< osg::Node > modelNode;
@@ -156,24 +282,20 @@ void ModelElement::copyAndAttachModelNode( DefFileGroup *config, Entity *entity,
 			new SequenceNodeAnimationImp( animation, (osg::Sequence*)(*iter) ) );
 	}
 	
-	std::list<DefFileGroup *>::iterator groupIter;
-	
 	// articulated parts
-	for( groupIter = config->children.begin(); 
-		groupIter != config->children.end(); groupIter++ )
+	std::vector<Params::ArtPart>::const_iterator artPartIter;
+	for( artPartIter = params->artParts.begin(); 
+		artPartIter != params->artParts.end(); artPartIter++ )
 	{
-		DefFileGroup *artPartGroup = *groupIter;
-		if( artPartGroup->getName() == "built_in_articulated_part" )
-			constructTransformArtPart( artPartGroup, entity, modelNode.get() );
+		constructTransformArtPart( *artPartIter, entity, modelNode.get() );
 	}
 
 	// switchable components
-	for( groupIter = config->children.begin(); 
-		groupIter != config->children.end(); groupIter++ )
+	std::vector<Params::SwitchComponent>::const_iterator switchIter;
+	for( switchIter = params->switches.begin(); 
+		switchIter != params->switches.end(); switchIter++ )
 	{
-		DefFileGroup *switchGroup = *groupIter;
-		if( switchGroup->getName() == "built_in_switch" )
-			constructSwitchComponentCtrl( switchGroup, entity, modelNode.get() );
+		constructSwitchComponentCtrl( *switchIter, entity, modelNode.get() );
 	}
 	
 	
@@ -196,48 +318,20 @@ bool ModelElement::addChildElement( EntityElement *childElement )
 
 
 void ModelElement::constructTransformArtPart( 
-	DefFileGroup *config, Entity *entity, osg::Node *modelNode )
+	const Params::ArtPart &artPart, Entity *entity, osg::Node *modelNode )
 {
-	if( config == NULL || entity == NULL || modelNode == NULL )
-		return;
-	
-	int articulationID = -1;
-	osg::Node *transformNode = NULL;
-	DefFileAttrib *attr = NULL;
-
-	
-	attr = config->getAttribute( "art_part_id" );
-	if( attr )
-		articulationID = attr->asInt();
-	else
-	{
-		std::cout << "Warning - in definition for entity type " 
-			<< entity->getType()
-			<< " - articulated part is missing its \"art_part_id\" attribute\n";
+	if( entity == NULL || modelNode == NULL )
 		return;
-	}
 	
-
-	attr = config->getAttribute( "node_name" );
-	if( attr )
-	{
-		transformNode = searchForNodeByName( modelNode, attr->asString() );
-		if( transformNode == NULL )
-		{
-			std::cout << "Warning - in definition for entity type " 
-				<< entity->getType()
-				<< " - in articulated part " << articulationID 
-				<< ", couldn't find a node in the model scene graph with the name \""
-				<< attr->asString() << "\"\n";
-			return;
-		}
-	}
-	else
+	int articulationID = artPart.artPartID;
+	osg::Node *transformNode = searchForNodeByName( modelNode, artPart.nodeName );
+	if( transformNode == NULL )
 	{
 		std::cout << "Warning - in definition for entity type " 
 			<< entity->getType()
-			<< " - articulated part " << articulationID 
-			<< " is missing its \"node_name\" attribute\n";
+			<< " - in articulated part " << articulationID 
+			<< ", couldn't find a node in the model scene graph with the name \""
+			<< artPart.nodeName << "\"\n";
 		return;
 	}
 	
@@ -260,74 +354,26 @@ void ModelElement::constructTransformArtPart(
 		articulation->setEntityID( entity->getID() );
 	}
 
-	// If the user has specified default values for the articulation's 
-	// transform, then honor those values.
-	// Note that this has the potential for being a bit tricky:
-	// - if the articulation already existed, then the values specified here
-	//   will clobber those already set for the articulation
-	// - if the user has multiple articulated part sections for the same 
-	//   articulation id, and has provided conflicting default values for 
-	//   those sections, then the results will be unpredictable
-	attr = config->getAttribute( "rotation" );
-	if( attr )
-	{
-		// FIXME
-	}
-
-	attr = config->getAttribute( "offset" );
-	if( attr )
-	{
-		// FIXME
-	}
-	
 	articulation->addImplementation( 
 		new TransformNodeArticulationImp( articulation, transformNode->asTransform() ) );
 }
 
 
 void ModelElement::constructSwitchComponentCtrl( 
-	DefFileGroup *config, Entity *entity, osg::Node *modelNode )
+	const Params::SwitchComponent &switchComponent, Entity *entity, osg::Node *modelNode )
 {
-	if( config == NULL || entity == NULL || modelNode == NULL )
-		return;
-	
-	int componentID = -1;
-	osg::Node *switchNode = NULL;
-	DefFileAttrib *attr = NULL;
-
-	
-	attr = config->getAttribute( "component_id" );
-	if( attr )
-		componentID = attr->asInt();
-	else
-	{
-		std::cout << "Warning - in definition for entity type " 
-			<< entity->getType()
-			<< " - switch component is missing its \"component_id\" attribute\n";
+	if( entity == NULL || modelNode == NULL )
 		return;
-	}
 	
-
-	attr = config->getAttribute( "node_name" );
-	if( attr )
-	{
-		switchNode = searchForNodeByName( modelNode, attr->asString() );
-		if( switchNode == NULL )
-		{
-			std::cout << "Warning - in definition for entity type " 
-				<< entity->getType()
-				<< " - in switch component " << componentID 
-				<< ", couldn't find a node in the model scene graph with the name \""
-				<< attr->asString() << "\"\n";
-			return;
-		}
-	}
-	else
+	int componentID = switchComponent.componentID;
+	osg::Node *switchNode = searchForNodeByName( modelNode, switchComponent.nodeName );
+	if( switchNode == NULL )
 	{
 		std::cout << "Warning - in definition for entity type " 
 			<< entity->getType()
-			<< " - switch component " << componentID 
-			<< " is missing its \"node_name\" attribute\n";
+			<< " - in switch component " << componentID 
+			<< ", couldn't find a node in the model scene graph with the name \""
+			<< switchComponent.nodeName << "\"\n";
 		return;
 	}
 	
@@ -356,32 +402,11 @@ void ModelElement::constructSwitchComponentCtrl(
 		new SwitchNodeComponentImp( component, switchNode->asGroup() );
 	component->addImplementation( componentImp );
 
-	// Find all the "state" sections.  These sections map a given CIGI value 
-	// to a position/child-node of the switch.  I.E. if the Host specifies a 
-	// value of N for the component control, the SwitchNodeCompCtrl will use 
-	// these state mappings to look up the switch position associated with N, 
-	// and will activate that switch position.
-	
-	std::list<DefFileGroup *>::iterator groupIter;
-	for( groupIter = config->children.begin(); 
-		groupIter != config->children.end(); groupIter++ )
+	std::vector< std::pair<int, int> >::const_iterator stateIter;
+	for( stateIter = switchComponent.states.begin(); 
+		stateIter != switchComponent.states.end(); stateIter++ )
 	{
-		DefFileGroup *stateGroup = *groupIter;
-		if( stateGroup->getName() == "state" )
-		{
-			int cigiValue, switchValue;
-			attr = stateGroup->getAttribute( "cigi_value" );
-			if( attr )
-			{
-				cigiValue = attr->asInt();
-				attr = stateGroup->getAttribute( "switch_value" );
-				if( attr )
-				{
-					switchValue = attr->asInt();
-					componentImp->addSwitchStatePair( cigiValue, switchValue );
-				}
-			}
-		}
+		componentImp->addSwitchStatePair( stateIter->first, stateIter->second );
 	}
 
 	// If the user has specified a default value for the component's state, 
@@ -393,10 +418,9 @@ void ModelElement::constructSwitchComponentCtrl(
 	// - if the user has multiple component sections for the same 
 	//   component id, and has provided conflicting default values for 
 	//   those sections, then the results will be unpredictable
-	attr = config->getAttribute( "default_cigi_value" );
-	if( attr )
+	if( switchComponent.hasDefaultValue )
 	{
-		component->setState( attr->asInt() );
+		component->setState( switchComponent.defaultValue );
 	}
 
 }
@@ -21,6 +21,9 @@
  *  the resulting scene graph nodes in the form of an "entity element".
  *  
  *  Initial Release: 2007-03-24 Andrew Sampson
+ *  
+ *  2026-10-19
+ *      Added compiled parameters, parsed once per entity type.
  * </pre>
  */
 
@@ -28,9 +31,14 @@
 #ifndef _MODEL_ELEMENT_H_
 #define _MODEL_ELEMENT_H_
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <osg/Group>
 
 #include "EntityElement.h"
+#include "EntityElementFactory.h"
 #include "ModelCache.h"
 
 
@@ -42,12 +50,58 @@ class ModelElement : public mpvosg::EntityElement
 {
 public:
 	
+	//=========================================================
+	//! A model element definition, as compiled by parse().  Nodes are 
+	//! still found by name in each entity's copy of the model.
+	//! 
+	class Params : public mpvosg::ElementParams
+	{
+	public:
+		Params() : hasFilename( false ) {}
+		
+		struct ArtPart
+		{
+			int artPartID;
+			std::string nodeName;
+		};
+		
+		struct SwitchComponent
+		{
+			SwitchComponent() : componentID( -1 ), hasDefaultValue( false ), 
+				defaultValue( 0 ) {}
+			
+			int componentID;
+			std::string nodeName;
+			//! CIGI component state, switch position
+			std::vector< std::pair<int, int> > states;
+			bool hasDefaultValue;
+			int defaultValue;
+		};
+		
+		bool hasFilename;
+		std::string filename;
+		//! the built_in_articulated_part sections that name a node
+		std::vector<ArtPart> artParts;
+		//! the built_in_switch sections that name a node
+		std::vector<SwitchComponent> switches;
+	};
+	
 	ModelElement( ModelCache *cache );
 	
 	virtual ~ModelElement();
 	
+	//=========================================================
+	//! Parses a model element definition.  Incomplete articulated part and 
+	//! switch sections are reported and left out.
+	//! \param config - the element's config group
+	//! \param entityType - the entity type being compiled; for messages
+	//! 
+	static Params *parse( DefFileGroup *config, int entityType );
+	
 	virtual bool construct( DefFileGroup *config, mpv::Entity *entity );
 	
+	bool construct( const Params *params, mpv::Entity *entity );
+	
 	virtual osg::Node *getTopNode() { return groupNode.get(); }
 	
 	virtual bool addChildElement( mpvosg::EntityElement *childElement );
@@ -57,12 +111,12 @@ protected:
 	osg::ref_ptr< osg::Group > groupNode;
 	osg::ref_ptr< ModelCache > modelCache;
 	
-	void copyAndAttachModelNode( DefFileGroup *config, mpv::Entity *entity, osg::Node *cachedNode );
+	void copyAndAttachModelNode( const Params *params, mpv::Entity *entity, osg::Node *cachedNode );
 
 	void constructTransformArtPart( 
-		DefFileGroup *config, mpv::Entity *entity, osg::Node *modelNode );
+		const Params::ArtPart &artPart, mpv::Entity *entity, osg::Node *modelNode );
 	void constructSwitchComponentCtrl( 
-		DefFileGroup *config, mpv::Entity *entity, osg::Node *modelNode );
+		const Params::SwitchComponent &switchComponent, mpv::Entity *entity, osg::Node *modelNode );
 
 	//=========================================================
 	//! Creates the default model (the model displayed when a specified model 
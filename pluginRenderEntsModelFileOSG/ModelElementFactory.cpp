@@ -20,6 +20,9 @@
  *  This class constructs EntityElements containing nodes from model files
  *  
  *  Initial Release: 2007-03-24 Andrew Sampson
+ *  
+ *  2026-10-19
+ *      Added compile(), so that definitions are parsed once per type.
  * </pre>
  */
 
@@ -75,3 +78,39 @@ EntityElement *ModelElementFactory::createElement(
 }
 
 
+// ================================================
+// compile
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+ElementParams *ModelElementFactory::compile( 
+	DefFileGroup *elementDefinition, int entityType )
+{
+	if( elementDefinition == NULL ) return NULL;
+	
+	// sanity check
+	DefFileAttrib *attr = elementDefinition->getAttribute( "element_type" );
+	if( attr == NULL || attr->asString() != keyword ) return NULL;
+	
+	return ModelElement::parse( elementDefinition, entityType );
+}
+
+
+// ================================================
+// createElement
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EntityElement *ModelElementFactory::createElement( 
+	const ElementParams *params, Entity *entity )
+{
+	const ModelElement::Params *elementParams = 
+		dynamic_cast<const ModelElement::Params *>( params );
+	if( elementParams == NULL || entity == NULL ) return NULL;
+	
+	ModelElement *result = new ModelElement( modelCache.get() );
+	
+	if( !result->construct( elementParams, entity ) )
+	{
+		delete result;
+		result = NULL;
+	}
+	
+	return result;
+}
@@ -20,6 +20,9 @@
  *  This class constructs EntityElements containing nodes from model files
  *  
  *  Initial Release: 2007-03-24 Andrew Sampson
+ *  
+ *  2026-10-19
+ *      Added compile(), so that definitions are parsed once per type.
  * </pre>
  */
 
@@ -40,6 +43,12 @@ public:
 	virtual mpvosg::EntityElement *createElement( 
 		DefFileGroup *elementDefinition, mpv::Entity *ent );
 	
+	virtual mpvosg::ElementParams *compile( 
+		DefFileGroup *elementDefinition, int entityType );
+	
+	virtual mpvosg::EntityElement *createElement( 
+		const mpvosg::ElementParams *params, mpv::Entity *ent );
+	
 	
 protected:
 	osg::ref_ptr< ModelCache > modelCache;
@@ -36,6 +36,10 @@
  *      Ported plugin to the new entity interface.  Now contains code from 
  *      the symbology rendering plugin.
  *
+ *  2026-10-19
+ *      Entity definitions are compiled into templates when the config is 
+ *      processed, rather than walked on every entity creation.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -43,6 +47,7 @@
 
 #include <iostream>
 #include <osg/Group>
+#include <osg/Timer>
 
 #include "EntityImpOSG.h"
 
@@ -57,7 +62,10 @@ using namespace mpvosg;
 // ================================================
 // EntityNodeFactory
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-EntityNodeFactory::EntityNodeFactory() : Referenced()
+EntityNodeFactory::EntityNodeFactory() : Referenced(), 
+	useTemplates( true ), 
+	creationCount( 0 ), 
+	creationTime( 0.0 )
 {
 	entityBranchNode = new osg::Group;
 	entityBranchNode->setName( "Entity Branch Node" );
@@ -186,6 +194,8 @@ void EntityNodeFactory::removedTopLevelEntity(
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 EntityElement *EntityNodeFactory::createNewNodes( Entity *entity )
 {
+	osg::Timer_t startTick = osg::Timer::instance()->tick();
+	
 	// Create the root model node.  It is just a Group.
 	// Note that it is entirely acceptable if none of the assembly line 
 	// workers make any changes to the model node tree, in which case this 
@@ -199,7 +209,12 @@ EntityElement *EntityNodeFactory::createNewNodes( Entity *entity )
 	
 	DefFileGroup *configGroup = entity->getConfig();
 
-	if( configGroup )
+	if( configGroup && useTemplates )
+	{
+		EntityTemplate *entityTemplate = getTemplate( configGroup, entity->getType() );
+		instantiateElements( entityTemplate->elements, result, entity );
+	}
+	else if( configGroup )
 	{
 		// check the configGroup entry for any attributes that should 
 		// be handled at this point
@@ -213,11 +228,171 @@ EntityElement *EntityNodeFactory::createNewNodes( Entity *entity )
 		handleChildElements( configGroup, result, entity );
 	}
 	
+	creationCount++;
+	creationTime += osg::Timer::instance()->delta_s( startTick, osg::Timer::instance()->tick() );
 	
 	return result;
 }
 
 
+// ================================================
+// compileTemplates
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EntityNodeFactory::compileTemplates( DefFileGroup *root )
+{
+	templates.clear();
+	
+	if( root == NULL )
+		return;
+	
+	DefFileGroup *entitiesGroup = root->getGroupByURI( "/entities/" );
+	if( entitiesGroup == NULL )
+		return;
+	
+	std::list< DefFileGroup * >::iterator iter = entitiesGroup->children.begin();
+	for( ; iter != entitiesGroup->children.end(); iter++ )
+	{
+		DefFileGroup *group = (*iter);
+		if( group->getName() != "entity" )
+			continue;
+		
+		// the catch-all type is reported as -1
+		int entityType = -1;
+		DefFileAttrib *attr = group->getAttribute( "type_id" );
+		if( attr && attr->asString() != "default" )
+			entityType = attr->asInt();
+		
+		getTemplate( group, entityType );
+	}
+}
+
+
+// ================================================
+// getTemplate
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EntityNodeFactory::EntityTemplate *EntityNodeFactory::getTemplate( 
+	DefFileGroup *configGroup, int entityType )
+{
+	std::map< DefFileGroup *, RefPtr<EntityTemplate> >::iterator iter = 
+		templates.find( configGroup );
+	if( iter != templates.end() )
+		return iter->second.get();
+	
+	EntityTemplate *entityTemplate = new EntityTemplate;
+	templates[configGroup] = entityTemplate;
+	
+	// check the configGroup entry for any attributes that should 
+	// be handled at this point
+	DefFileAttrib *attr;
+	attr = configGroup->getAttribute( "ignore_alpha" );
+	if( attr )
+	{
+		std::cout << "Warning - ignore_alpha is not implemented yet" << std::endl;
+	}
+	
+	compileChildElements( configGroup, entityType, entityTemplate->elements );
+	
+	return entityTemplate;
+}
+
+
+// ================================================
+// compileChildElements
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EntityNodeFactory::compileChildElements( DefFileGroup *config, 
+	int entityType, std::vector<ElementTemplate> &elements )
+{
+	// for each "element" group...
+	std::list< DefFileGroup * >::iterator iter = config->children.begin();
+	for( ; iter != config->children.end(); iter++ )
+	{
+		if( (*iter)->getName() != "element" )
+			continue;
+		
+		DefFileGroup *elementGroup = (*iter);
+		DefFileAttrib *attr = elementGroup->getAttribute( "element_type" );
+		if( attr == NULL )
+			continue;
+		
+		elements.push_back( ElementTemplate() );
+		ElementTemplate &element = elements.back();
+		element.elementType = attr->asString();
+		element.definition = elementGroup;
+		
+		// look up factory in entityElementFactoryMap
+		ElementFactoryMap::iterator factoryIter = 
+			entityElementFactoryMap.find( element.elementType );
+		if( factoryIter != entityElementFactoryMap.end() )
+		{
+			element.factory = factoryIter->second;
+		}
+		else
+		{
+			std::cout << "Warning - in definition for entity type " 
+				<< entityType << " - couldn't find an entity element factory "
+				<< "that knows how to create \"" << element.elementType
+				<< "\" elements... ignoring this element" << std::endl;
+			// if a matching factory is not found, fall back 
+			// on groupFactory
+			element.factory = groupFactory;
+		}
+		
+		element.params = element.factory->compile( elementGroup, entityType );
+		
+		// recursion
+		compileChildElements( elementGroup, entityType, element.children );
+	}
+}
+
+
+// ================================================
+// instantiateElements
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void EntityNodeFactory::instantiateElements( 
+	const std::vector<ElementTemplate> &elements, 
+	EntityElement *parentElement, Entity *entity )
+{
+	std::vector<ElementTemplate>::const_iterator iter;
+	for( iter = elements.begin(); iter != elements.end(); iter++ )
+	{
+		EntityElement *element = NULL;
+		if( iter->params.valid() )
+			element = iter->factory->createElement( iter->params.get(), entity );
+		else
+			element = iter->factory->createElement( iter->definition, entity );
+		
+		if( element == NULL )
+		{
+			std::cout << "Warning - There was a problem creating an "
+				<< "element of type \"" << iter->elementType
+				<< "\" for entity #" << entity->getID() 
+				<< " (type " << entity->getType() << ")" 
+				<< std::endl;
+			
+			// try again with the groupFactory
+			element = groupFactory->createElement( iter->definition, entity );
+		}
+		
+		if( element == NULL )
+		{
+			std::cout << "Error - There was a serious error while "
+				<< "creating an element of type \"" << iter->elementType
+				<< "\" for entity #" << entity->getID() 
+				<< " (type " << entity->getType() << ")" 
+				<< std::endl;
+			// don't recurse... just let the loop move on to the next element
+		}
+		else
+		{
+			parentElement->addChildElement( element );
+
+			// recursion
+			instantiateElements( iter->children, element, entity );
+		}
+	}
+}
+
+
 // ================================================
 // 
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -36,6 +36,10 @@
  *      Ported plugin to the new entity interface.  Now contains code from 
  *      the symbology rendering plugin.
  *
+ *  2026-10-19
+ *      Entity definitions are compiled into templates when the config is 
+ *      processed, rather than walked on every entity creation.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -48,6 +52,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "Referenced.h"
 #include "Entity.h"
@@ -65,12 +70,48 @@
 //! The entity's representation is not constructed by just one software 
 //! component; the construction process ... FIXME
 //! 
+//! Each entity type's definition is compiled into an EntityTemplate: the 
+//! element tree, with each element's factory looked up and its definition 
+//! parsed by the factory.  Creating an entity then only instantiates the 
+//! template.  Elements whose factories don't compile their definitions 
+//! are created from the config group, as before.
+//! 
 class EntityNodeFactory : public mpv::Referenced
 {
 public:
 	
 	typedef std::map< std::string, mpvosg::EntityElementFactory * > ElementFactoryMap;
 
+	//=========================================================
+	//! An element of an entity template
+	//! 
+	struct ElementTemplate
+	{
+		ElementTemplate() : factory( NULL ), definition( NULL ) {}
+		
+		//! the element_type; for messages
+		std::string elementType;
+		mpvosg::EntityElementFactory *factory;
+		//! the element's config group
+		DefFileGroup *definition;
+		//! the factory's compiled definition; NULL if it doesn't compile 
+		//! definitions, in which case the element is created from the 
+		//! config group
+		mpv::RefPtr<mpvosg::ElementParams> params;
+		std::vector<ElementTemplate> children;
+	};
+	
+	//=========================================================
+	//! An entity type's elements, compiled from its config group
+	//! 
+	class EntityTemplate : public mpv::Referenced
+	{
+	public:
+		std::vector<ElementTemplate> elements;
+	protected:
+		virtual ~EntityTemplate() {}
+	};
+	
 	//=========================================================
 	//! General Constructor
 	//! 
@@ -102,6 +143,32 @@ public:
 		return &entityElementFactoryMap;
 	}
 	
+	//=========================================================
+	//! Compiles a template for each entity type in the config.  Called 
+	//! when the config is processed, after all the element factories have 
+	//! been registered.  Discards the previous templates.
+	//! \param root - The root of the config data tree
+	//! 
+	void compileTemplates( DefFileGroup *root );
+	
+	//=========================================================
+	//! Turns the use of templates on or off.  When off, each entity's 
+	//! definition is walked as it is created; useful for comparison.
+	//! 
+	void setUseTemplates( bool use ) { useTemplates = use; }
+	
+	bool getUseTemplates() const { return useTemplates; }
+	
+	//=========================================================
+	//! Returns the number of entity subgraphs created, and the time spent 
+	//! creating them, in seconds, since the last call to 
+	//! resetCreationStats()
+	//! 
+	int getCreationCount() const { return creationCount; }
+	double getCreationTime() const { return creationTime; }
+	
+	void resetCreationStats() { creationCount = 0; creationTime = 0.0; }
+	
 	//=========================================================
 	//! Returns the scene graph node where top-level entities are attached.
 	//! 
@@ -133,6 +200,35 @@ private:
 	//! 
 	GroupElementFactory *groupFactory;
 
+	//=========================================================
+	//! Compiled entity templates, keyed by the entity types' config groups
+	//! 
+	std::map< DefFileGroup *, mpv::RefPtr<EntityTemplate> > templates;
+	
+	bool useTemplates;
+	
+	int creationCount;
+	double creationTime;
+	
+	//=========================================================
+	//! Returns the template for an entity type's config group, compiling 
+	//! it if this group hasn't been seen before
+	//! 
+	EntityTemplate *getTemplate( DefFileGroup *configGroup, int entityType );
+	
+	//=========================================================
+	//! Compiles the element groups under config into templates
+	//! 
+	void compileChildElements( DefFileGroup *config, int entityType, 
+		std::vector<ElementTemplate> &elements );
+	
+	//=========================================================
+	//! Creates the elements described by a list of element templates, and 
+	//! adds them to parentElement
+	//! 
+	void instantiateElements( const std::vector<ElementTemplate> &elements, 
+		mpvosg::EntityElement *parentElement, mpv::Entity *entity );
+	
 	//=========================================================
 	//! This method creates entity elements are groups them into a 
 	//! hierarchy.
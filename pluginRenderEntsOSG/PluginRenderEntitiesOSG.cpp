@@ -47,6 +47,10 @@
  *      Ported plugin to the new entity interface.  Now contains code from 
  *      the symbology rendering plugin.
  *
+ *  2026-10-19
+ *      Compiles the entity templates when the config is processed, and 
+ *      reports the entity creation rate.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -55,7 +59,10 @@
 
 #include <iostream>
 
+#include <osg/Timer>
+
 #include "BindSlot.h"
+#include "Log.h"
 
 #include "PluginRenderEntitiesOSG.h"
 
@@ -81,6 +88,10 @@ PluginRenderEntsOSG::PluginRenderEntsOSG() : Plugin()
 	rootNode = NULL;
 	allEntities = NULL;
 	topLevelEntities = NULL;
+	DefFileData = NULL;
+	timeElapsedLastFrame = NULL;
+	creationReportInterval = 60.0f;
+	timeSinceReport = 0.0;
 	
 	nodeFactory = new EntityNodeFactory;
 }
@@ -129,6 +140,15 @@ void PluginRenderEntsOSG::act( SystemState::ID state, StateContext &stateContext
 		topLevelEntities->addedEntity.connect( BIND_SLOT2( EntityNodeFactory::addedTopLevelEntity, nodeFactory.get() ) );
 		topLevelEntities->removedEntity.connect( BIND_SLOT2( EntityNodeFactory::removedTopLevelEntity, nodeFactory.get() ) );
 
+		bb_->get( "DefinitionData", DefFileData );
+		bb_->get( "TimeElapsedLastFrame", timeElapsedLastFrame );
+
+		break;
+
+	case SystemState::ConfigurationProcess:
+		// The element factories are registered by now, so the templates 
+		// can be compiled
+		processConfigData();
 		break;
 
 	case SystemState::Operate:
@@ -148,6 +168,60 @@ void PluginRenderEntsOSG::act( SystemState::ID state, StateContext &stateContext
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void PluginRenderEntsOSG::operate( void ) 
 {
+	reportCreationRate();
+}
+
+
+// ================================================
+// processConfigData
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderEntsOSG::processConfigData() 
+{
+	if( *DefFileData == NULL )
+		return;
 
+	DefFileGroup *entitiesGroup = (*DefFileData)->getGroupByURI( "/entities/" );
+	if( entitiesGroup != NULL )
+	{
+		DefFileAttrib *attr = entitiesGroup->getAttribute( "entity_templates" );
+		if( attr )
+			nodeFactory->setUseTemplates( attr->asInt() != 0 );
+
+		attr = entitiesGroup->getAttribute( "creation_report_interval" );
+		if( attr )
+			creationReportInterval = attr->asFloat();
+	}
+
+	osg::Timer_t startTick = osg::Timer::instance()->tick();
+	nodeFactory->compileTemplates( *DefFileData );
+	MPV_LOG_INFO( "PluginRenderEntsOSG - compiled entity templates in " 
+		<< osg::Timer::instance()->delta_m( startTick, osg::Timer::instance()->tick() ) 
+		<< " ms" );
+}
+
+
+// ================================================
+// reportCreationRate
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderEntsOSG::reportCreationRate() 
+{
+	if( creationReportInterval <= 0.0f )
+		return;
+
+	timeSinceReport += *timeElapsedLastFrame;
+	if( timeSinceReport < creationReportInterval )
+		return;
+	timeSinceReport = 0.0;
+
+	int count = nodeFactory->getCreationCount();
+	double seconds = nodeFactory->getCreationTime();
+	if( count == 0 )
+		return;
+
+	MPV_LOG_INFO( "PluginRenderEntsOSG - created " << count 
+		<< " entity subgraphs in " << seconds * 1000.0 << " ms (" 
+		<< ( seconds > 0.0 ? count / seconds : 0.0 ) << " per second, templates " 
+		<< ( nodeFactory->getUseTemplates() ? "on" : "off" ) << ")" );
+	nodeFactory->resetCreationStats();
 }
 
@@ -47,6 +47,10 @@
  *      Ported plugin to the new entity interface.  Now contains code from 
  *      the symbology rendering plugin.
  *
+ *  2026-10-19
+ *      Compiles the entity templates when the config is processed, and 
+ *      reports the entity creation rate.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -135,6 +139,15 @@ private:
 	//! 
 	DefFileGroup **DefFileData;
 
+	//=========================================================
+	//! Time elapsed during the last frame.  Retrieved from the blackboard.
+	//! 
+	double *timeElapsedLastFrame;
+	
+	//! seconds between entity creation reports; 0 disables them
+	float creationReportInterval;
+	double timeSinceReport;
+
 	//=========================================================
 	//! EntityNodeFactory object.  Is used to create the model subgraphs.
 	//! 
@@ -147,6 +160,17 @@ private:
 	//! 
 	void operate( void );
 	
+	//=========================================================
+	//! Reads the template settings and compiles the entity templates
+	//! 
+	void processConfigData();
+	
+	//=========================================================
+	//! Logs the number of entity subgraphs created, and the rate at which 
+	//! they were created, if it's time to
+	//! 
+	void reportCreationRate();
+	
 };
 
 
@@ -20,6 +20,9 @@
  *  2008-09-28 Andrew Sampson
  *      Initial Release.  File copied from TransformElement.cpp
  *  
+ *  2026-10-19
+ *      Added compiled parameters, parsed once per entity type.
+ *  
  * </pre>
  */
 
@@ -44,34 +47,23 @@ SwitchElement::~SwitchElement()
 }
 
 
-bool SwitchElement::construct( DefFileGroup *config, Entity *entity )
+SwitchElement::Params *SwitchElement::parse( DefFileGroup *config, int entityType )
 {
-	int componentID = -1;
+	Params *params = new Params;
 	DefFileAttrib *attr = NULL;
 
 	
 	attr = config->getAttribute( "component_id" );
 	if( attr )
-		componentID = attr->asInt();
+		params->componentID = attr->asInt();
 	else
 	{
 		std::cout << "Warning - in definition for entity type " 
-			<< entity->getType()
+			<< entityType
 			<< " - switch component is missing its \"component_id\" attribute\n";
-		return false;
-	}
-	
-
-	Component *component = entity->findOrCreateComponent( componentID );
-	// check to see if the component was just created
-	if( component->getInstanceID() != entity->getID() )
-	{
-		component->setInstanceID( entity->getID() );
+		return params;
 	}
-
-	SwitchNodeComponentImp *componentImp = 
-		new SwitchNodeComponentImp( component, switchNode->asGroup() );
-	component->addImplementation( componentImp );
+	params->valid = true;
 
 	// Find all the "state" sections.  These sections map a given CIGI value 
 	// to a position/child-node of the switch.  I.E. if the Host specifies a 
@@ -95,12 +87,53 @@ bool SwitchElement::construct( DefFileGroup *config, Entity *entity )
 				if( attr )
 				{
 					switchValue = attr->asInt();
-					componentImp->addSwitchStatePair( cigiValue, switchValue );
+					params->states.push_back( std::make_pair( cigiValue, switchValue ) );
 				}
 			}
 		}
 	}
 
+	attr = config->getAttribute( "default_cigi_value" );
+	if( attr )
+	{
+		params->hasDefaultValue = true;
+		params->defaultValue = attr->asInt();
+	}
+
+	return params;
+}
+
+
+bool SwitchElement::construct( DefFileGroup *config, Entity *entity )
+{
+	RefPtr<Params> params = parse( config, entity->getType() );
+	return construct( params.get(), entity );
+}
+
+
+bool SwitchElement::construct( const Params *params, Entity *entity )
+{
+	if( !params->valid )
+		return false;
+
+	Component *component = entity->findOrCreateComponent( params->componentID );
+	// check to see if the component was just created
+	if( component->getInstanceID() != entity->getID() )
+	{
+		component->setInstanceID( entity->getID() );
+	}
+
+	SwitchNodeComponentImp *componentImp = 
+		new SwitchNodeComponentImp( component, switchNode->asGroup() );
+	component->addImplementation( componentImp );
+
+	std::vector< std::pair<int, int> >::const_iterator stateIter;
+	for( stateIter = params->states.begin(); 
+		stateIter != params->states.end(); stateIter++ )
+	{
+		componentImp->addSwitchStatePair( stateIter->first, stateIter->second );
+	}
+
 	// If the user has specified a default value for the component's state, 
 	// then honor that value.  The default value is set *after* the 
 	// cigi->osgswitch state mappings are processed above.
@@ -110,10 +143,9 @@ bool SwitchElement::construct( DefFileGroup *config, Entity *entity )
 	// - if the user has multiple component sections for the same 
 	//   component id, and has provided conflicting default values for 
 	//   those sections, then the results will be unpredictable
-	attr = config->getAttribute( "default_cigi_value" );
-	if( attr )
+	if( params->hasDefaultValue )
 	{
-		component->setState( attr->asInt() );
+		component->setState( params->defaultValue );
 	}
 
 	return true;
@@ -20,6 +20,9 @@
  *  2008-09-28 Andrew Sampson
  *      Initial Release.  File copied from TransformElement.h
  *  
+ *  2026-10-19
+ *      Added compiled parameters, parsed once per entity type.
+ *  
  * </pre>
  */
 
@@ -27,10 +30,14 @@
 #ifndef _SWITCH_ELEMENT_H_
 #define _SWITCH_ELEMENT_H_
 
+#include <utility>
+#include <vector>
+
 #include <osg/Vec3>
 #include <osg/Switch>
 
 #include "EntityElement.h"
+#include "EntityElementFactory.h"
 
 
 /**
@@ -42,12 +49,39 @@ class SwitchElement : public mpvosg::EntityElement
 {
 public:
 	
+	//=========================================================
+	//! A switch element definition, as compiled by parse()
+	//! 
+	class Params : public mpvosg::ElementParams
+	{
+	public:
+		Params() : componentID( -1 ), valid( false ), 
+			hasDefaultValue( false ), defaultValue( 0 ) {}
+		
+		int componentID;
+		//! false if the definition is missing its component ID
+		bool valid;
+		//! CIGI component state, switch position
+		std::vector< std::pair<int, int> > states;
+		bool hasDefaultValue;
+		int defaultValue;
+	};
+	
 	SwitchElement();
 	
 	virtual ~SwitchElement();
 	
+	//=========================================================
+	//! Parses a switch element definition
+	//! \param config - the element's config group
+	//! \param entityType - the entity type being compiled; for messages
+	//! 
+	static Params *parse( DefFileGroup *config, int entityType );
+	
 	virtual bool construct( DefFileGroup *config, mpv::Entity *entity );
 	
+	bool construct( const Params *params, mpv::Entity *entity );
+	
 	virtual osg::Node *getTopNode() { return switchNode.get(); }
 	
 	virtual bool addChildElement( mpvosg::EntityElement *childElement );
@@ -20,6 +20,9 @@
  *  2008-09-28 Andrew Sampson
  *      Initial Release.  File copied from TransformElementFactory.cpp
  *  
+ *  2026-10-19
+ *      Added compile(), so that definitions are parsed once per type.
+ *  
  * </pre>
  */
 
@@ -73,3 +76,39 @@ EntityElement *SwitchElementFactory::createElement(
 }
 
 
+// ================================================
+// compile
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+ElementParams *SwitchElementFactory::compile( 
+	DefFileGroup *elementDefinition, int entityType )
+{
+	if( elementDefinition == NULL ) return NULL;
+	
+	// sanity check
+	DefFileAttrib *attr = elementDefinition->getAttribute( "element_type" );
+	if( attr == NULL || attr->asString() != keyword ) return NULL;
+	
+	return SwitchElement::parse( elementDefinition, entityType );
+}
+
+
+// ================================================
+// createElement
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EntityElement *SwitchElementFactory::createElement( 
+	const ElementParams *params, Entity *entity )
+{
+	const SwitchElement::Params *elementParams = 
+		dynamic_cast<const SwitchElement::Params *>( params );
+	if( elementParams == NULL || entity == NULL ) return NULL;
+	
+	SwitchElement *result = new SwitchElement();
+	
+	if( !result->construct( elementParams, entity ) )
+	{
+		delete result;
+		result = NULL;
+	}
+	
+	return result;
+}
@@ -20,6 +20,9 @@
  *  2008-09-28 Andrew Sampson
  *      Initial Release.  File copied from TransformElementFactory.h
  *  
+ *  2026-10-19
+ *      Added compile(), so that definitions are parsed once per type.
+ *  
  * </pre>
  */
 
@@ -40,6 +43,12 @@ public:
 	virtual mpvosg::EntityElement *createElement( 
 		DefFileGroup *elementDefinition, mpv::Entity *ent );
 	
+	virtual mpvosg::ElementParams *compile( 
+		DefFileGroup *elementDefinition, int entityType );
+	
+	virtual mpvosg::EntityElement *createElement( 
+		const mpvosg::ElementParams *params, mpv::Entity *ent );
+	
 	
 protected:
 	
@@ -22,6 +22,9 @@
  *  which can be attached underneath.
  *  
  *  Initial Release: 2007-11-03 Andrew Sampson
+ *  
+ *  2026-10-19
+ *      Added compiled parameters, parsed once per entity type.
  * </pre>
  */
 
@@ -50,9 +53,11 @@ TransformElement::~TransformElement()
 }
 
 
-bool TransformElement::construct( DefFileGroup *config, Entity *entity )
+TransformElement::Params *TransformElement::parse( DefFileGroup *config, int entityType )
 {
-	osg::Matrixd mtx;
+	Params *params = new Params;
+	
+	osg::Matrixd &mtx = params->matrix;
 	mtx.makeIdentity();
 
 	DefFileAttrib *attr;
@@ -78,14 +83,30 @@ bool TransformElement::construct( DefFileGroup *config, Entity *entity )
 	
 	// fixme - allow user to specify full 4x4 matrix (would that be useful?)
 	
-	transformNode->setMatrix( mtx );
-	
 	// allow user to specify articulated part ID, to allow Host to 
 	// control this matrix
 	attr = config->getAttribute( "art_part_id" );
 	if( attr )
+		params->artPartID = attr->asInt();
+	
+	return params;
+}
+
+
+bool TransformElement::construct( DefFileGroup *config, Entity *entity )
+{
+	RefPtr<Params> params = parse( config, entity->getType() );
+	return construct( params.get(), entity );
+}
+
+
+bool TransformElement::construct( const Params *params, Entity *entity )
+{
+	transformNode->setMatrix( params->matrix );
+	
+	if( params->artPartID != -1 )
 	{
-		Articulation *articulation = entity->findOrCreateArticulation( attr->asInt() );
+		Articulation *articulation = entity->findOrCreateArticulation( params->artPartID );
 		// check to see if the articulation was just created
 		if( articulation->getEntityID() != entity->getID() )
 		{
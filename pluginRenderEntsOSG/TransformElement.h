@@ -18,6 +18,9 @@
  *  
  *  
  *  Initial Release: 2007-11-03 Andrew Sampson
+ *  
+ *  2026-10-19
+ *      Added compiled parameters, parsed once per entity type.
  * </pre>
  */
 
@@ -29,6 +32,7 @@
 #include <osg/MatrixTransform>
 
 #include "EntityElement.h"
+#include "EntityElementFactory.h"
 
 
 /**
@@ -40,12 +44,35 @@ class TransformElement : public mpvosg::EntityElement
 {
 public:
 	
+	//=========================================================
+	//! A transform element definition, as compiled by parse()
+	//! 
+	class Params : public mpvosg::ElementParams
+	{
+	public:
+		Params() : artPartID( -1 ) {}
+		
+		osg::Matrixd matrix;
+		
+		//! the articulated part that controls the transform; -1 if none
+		int artPartID;
+	};
+	
 	TransformElement();
 	
 	virtual ~TransformElement();
 	
+	//=========================================================
+	//! Parses a transform element definition
+	//! \param config - the element's config group
+	//! \param entityType - the entity type being compiled; for messages
+	//! 
+	static Params *parse( DefFileGroup *config, int entityType );
+	
 	virtual bool construct( DefFileGroup *config, mpv::Entity *entity );
 	
+	bool construct( const Params *params, mpv::Entity *entity );
+	
 	virtual osg::Node *getTopNode() { return transformNode.get(); }
 	
 	virtual bool addChildElement( mpvosg::EntityElement *childElement );
@@ -20,6 +20,9 @@
  *  This class constructs EntityElements containing a transform node
  *  
  *  Initial Release: 2007-11-03 Andrew Sampson
+ *  
+ *  2026-10-19
+ *      Added compile(), so that definitions are parsed once per type.
  * </pre>
  */
 
@@ -73,3 +76,41 @@ EntityElement *TransformElementFactory::createElement(
 }
 
 
+
+
+// ================================================
+// compile
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+ElementParams *TransformElementFactory::compile( 
+	DefFileGroup *elementDefinition, int entityType )
+{
+	if( elementDefinition == NULL ) return NULL;
+	
+	// sanity check
+	DefFileAttrib *attr = elementDefinition->getAttribute( "element_type" );
+	if( attr == NULL || attr->asString() != keyword ) return NULL;
+	
+	return TransformElement::parse( elementDefinition, entityType );
+}
+
+
+// ================================================
+// createElement
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+EntityElement *TransformElementFactory::createElement( 
+	const ElementParams *params, Entity *entity )
+{
+	const TransformElement::Params *elementParams = 
+		dynamic_cast<const TransformElement::Params *>( params );
+	if( elementParams == NULL || entity == NULL ) return NULL;
+	
+	TransformElement *result = new TransformElement();
+	
+	if( !result->construct( elementParams, entity ) )
+	{
+		delete result;
+		result = NULL;
+	}
+	
+	return result;
+}
@@ -20,6 +20,9 @@
  *  This class constructs EntityElements containing a transform node
  *  
  *  Initial Release: 2007-11-03 Andrew Sampson
+ *  
+ *  2026-10-19
+ *      Added compile(), so that definitions are parsed once per type.
  * </pre>
  */
 
@@ -39,6 +42,12 @@ public:
 	virtual mpvosg::EntityElement *createElement( 
 		DefFileGroup *elementDefinition, mpv::Entity *ent );
 	
+	virtual mpvosg::ElementParams *compile( 
+		DefFileGroup *elementDefinition, int entityType );
+	
+	virtual mpvosg::EntityElement *createElement( 
+		const mpvosg::ElementParams *params, mpv::Entity *ent );
+	
 	
 protected:
 	
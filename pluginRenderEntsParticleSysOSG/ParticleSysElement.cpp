@@ -68,7 +68,8 @@ bool ParticleSysElement::construct( DefFileGroup *config, Entity *entity )
 
 bool ParticleSysElement::construct( 
 	DefFileGroup *partSysDefinition, Entity *entity, 
-	osg::Group *worldSpaceBranch )
+	osg::Group *worldSpaceBranch, 
+	osgParticleHPS::ParticleUpdatePool *updatePool )
 {
 	osgParticleHPS::ParticleSystem *hps = NULL;
 	std::list<osgParticleHPS::MultiEmitter *> emitters;
@@ -89,17 +90,35 @@ bool ParticleSysElement::construct(
 	worldSpaceBranch->addChild( worldSpaceGroup.get() );
 
 	osgParticleHPS::ParticleSystemUpdater *partSysUpdater = new osgParticleHPS::ParticleSystemUpdater;
+	partSysUpdater->setUpdatePool( updatePool );
 	worldSpaceGroup->addChild( partSysUpdater );
 
+	// The random seed key has to be the same on every IG, so it's built 
+	// from the entity ID (assigned by the host) and the particle system name.
+	unsigned int seedKey = 2166136261u;
+	DefFileAttrib *nameAttr = partSysDefinition->getAttribute( "name" );
+	if( nameAttr )
+	{
+		const std::string &name = nameAttr->asString();
+		for( unsigned int i = 0; i < name.size(); i++ )
+			seedKey = ( seedKey ^ (unsigned char)name[i] ) * 16777619u;
+	}
+	hps->setRandomSeedKey( seedKey ^ ( (unsigned int)entity->getID() << 16 ) );
+
 	osg::Geode *geode = new osg::Geode;	
 	geode->addDrawable( hps );
 	worldSpaceGroup->addChild( geode );
 
+	// gives the system the update pool, which the processors need to 
+	// know about before they're added
+	partSysUpdater->addParticleSystem( hps );
+
 	std::list<osgParticleHPS::MultiEmitter *> ::iterator eiter;
 	for( eiter = emitters.begin(); eiter != emitters.end(); eiter++ )
 	{
 		if( !hps->getPermitCulling() )
 			(*eiter)->setCullingActive( false );
+		(*eiter)->updatePoolChanged();
 		groupNode->addChild( (*eiter) );
 		animImp->addParticleProcessor( (*eiter) );
 	}
@@ -109,12 +128,11 @@ bool ParticleSysElement::construct(
 	{
 		if( !hps->getPermitCulling() )
 			(*piter)->setCullingActive( false );
+		(*piter)->updatePoolChanged();
 		groupNode->addChild( (*piter) );
 		animImp->addParticleProcessor( (*piter) );
 	}
 	
-	partSysUpdater->addParticleSystem( hps );
-	
 	if( !hps->getPermitCulling() )
 	{
 		partSysUpdater->setCullingActive( false );
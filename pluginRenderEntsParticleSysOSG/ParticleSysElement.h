@@ -32,6 +32,7 @@
 #define PARTICLESYSELEMENT_H
 
 #include "EntityElement.h"
+#include "ParticleUpdatePool.h"
 
 //=========================================================
 //! 
@@ -44,7 +45,8 @@ public:
 	
 	virtual bool construct( DefFileGroup *config, mpv::Entity *entity );
 	bool construct( DefFileGroup *partSysDefinition, mpv::Entity *entity, 
-		osg::Group *worldSpaceBranch );
+		osg::Group *worldSpaceBranch, 
+		osgParticleHPS::ParticleUpdatePool *updatePool = NULL );
 	
 	virtual osg::Node *getTopNode() { return groupNode.get(); }
 	
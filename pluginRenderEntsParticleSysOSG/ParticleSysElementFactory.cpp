@@ -71,6 +71,19 @@ void ParticleSysElementFactory::init( DefFileGroup *root )
 	{
 		return;
 	}
+
+	// The pool can't be resized once it's in use, so it's only created the 
+	// first time through.
+	DefFileAttrib *threadsAttr = partSystemsGroup->getAttribute( "update_threads" );
+	if( threadsAttr && !updatePool.valid() )
+	{
+		int numThreads = threadsAttr->asInt();
+		if( numThreads > 0 )
+		{
+			updatePool = new osgParticleHPS::ParticleUpdatePool( numThreads );
+			updatePool->enableJobRandom();
+		}
+	}
 	
 	// For each particle system definition, populate partSysNameToDefinitionMap 
 	// with a pointer to the def group.  This will speed up the lookup time 
@@ -120,8 +133,12 @@ EntityElement *ParticleSysElementFactory::createElement(
 		return NULL;
 	}
 
-	// look for a particle system definition with a matching name
-	DefFileGroup *partSysDefinition = partSysNameToDefinitionMap[attr->asString()];
+	// look for a particle system definition with a matching name; find() 
+	// rather than [], so that a bad name doesn't add an entry per creation
+	std::map< std::string, DefFileGroup * >::iterator defIter = 
+		partSysNameToDefinitionMap.find( attr->asString() );
+	DefFileGroup *partSysDefinition = 
+		defIter != partSysNameToDefinitionMap.end() ? defIter->second : NULL;
 
 	if( !partSysDefinition )
 	{
@@ -134,7 +151,7 @@ EntityElement *ParticleSysElementFactory::createElement(
 
 	ParticleSysElement *result = new ParticleSysElement();
 	
-	if( !result->construct( partSysDefinition, entity, worldSpaceBranch ) )
+	if( !result->construct( partSysDefinition, entity, worldSpaceBranch, updatePool.get() ) )
 	{
 		delete result;
 		result = NULL;
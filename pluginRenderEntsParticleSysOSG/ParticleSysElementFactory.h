@@ -46,6 +46,17 @@
 #include "EntityElementFactory.h"
 
 
+//=========================================================
+//! Doesn't override compile(), so entity templates keep the element's 
+//! config group and call createElement() with it.  The element itself 
+//! only names a particle system; the work is HPSFactory building the 
+//! system from its definition, which would mean cloning a prototype 
+//! system, emitters and programs instead.  The processors' copy 
+//! constructors copy their particle system through the CopyOp, once per 
+//! processor, so a deep copy wouldn't share one system among them.  The 
+//! definitions are also only looked up in init(), which may run after 
+//! the templates are compiled.
+//! 
 class ParticleSysElementFactory : public mpvosg::EntityElementFactory
 {
 public:
@@ -72,6 +83,13 @@ public:
 	//! 
 	void setWorldSpaceBranch( osg::Group *wsb ) { worldSpaceBranch = wsb; }
 
+	//=========================================================
+	//! Returns the pool that runs the particle systems' simulation, or 
+	//! NULL if the particle systems are simulated during cull.  Valid 
+	//! after init().
+	//! 
+	osgParticleHPS::ParticleUpdatePool *getUpdatePool() { return updatePool.get(); }
+
 protected:
 
 	//=========================================================
@@ -92,6 +110,12 @@ protected:
 	//! particle systems in the scene.
 	//! 
 	osg::ref_ptr<osgParticleHPS::ParticleSystemUpdater> partSysUpdater;
+
+	//=========================================================
+	//! Runs the particle systems' emitters, programs and updates on worker 
+	//! threads.  Created by init() if update_threads is set in the def file.
+	//! 
+	osg::ref_ptr<osgParticleHPS::ParticleUpdatePool> updatePool;
 };
 
 #endif
@@ -38,6 +38,10 @@
  *  2007-07-15 Andrew Sampson
  *      Changed interface to use new state machine API
  *
+ *  2026-10-19
+ *      Uses its own stream from SyncedRandom, rather than the shared 
+ *      RandomNumberGenerator
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -48,7 +52,7 @@
 
 #include "range.h"
 
-#include "GenerateID.h"
+#include "RandomStream.h"
 
 #include "PluginRenderParticleSysOSG.h"
 
@@ -58,15 +62,30 @@ using namespace mpvosg;
 //=========================================================
 //! A pointer to our synchronized RNG.  Retrieved from the blackboard.
 //! 
-static GenerateID *randNumGen = NULL;
+static SyncedRandom *syncedRandom = NULL;
+
+//=========================================================
+//! This plugin's own random stream; nobody else's draws affect it.  
+//! Restarted whenever the host's frame number changes.
+//! 
+static RandomStream randStream;
+static unsigned int randStreamFrame = 0;
 
 
 int randNumGenWrapper( void )
 {
-	std::string dummy;
-	if( randNumGen )
-		return randNumGen->GetNextID( dummy );
-	return 0;
+	if( !syncedRandom )
+		return 0;
+	
+	unsigned int frame = syncedRandom->getFrameNumber();
+	if( frame != randStreamFrame )
+	{
+		static const unsigned int streamID = 
+			SyncedRandom::getStreamID( "PluginRenderEntsParticleSysOSG" );
+		randStream = syncedRandom->getStream( streamID, frame );
+		randStreamFrame = frame;
+	}
+	return (int)( randStream.next() & 0x7fffffff );
 }
 
 
@@ -92,6 +111,7 @@ PluginRenderEntsParticleSysOSG::PluginRenderEntsParticleSysOSG() : Plugin()
 //	dependencies_.push_back( "PluginSyncedRandomNumbers" );
 
 	rootNode = NULL;
+	dispatchCallbackInstalled = false;
 	
 	particleSysElementFactory = new ParticleSysElementFactory;
 }
@@ -128,11 +148,15 @@ void PluginRenderEntsParticleSysOSG::act( SystemState::ID state, StateContext &s
 
 			bb_->get("DefinitionData", DefFileData);
 
-			int *randNumGenMax = NULL;
-			if( bb_->get( "RandomNumberGenerator", randNumGen, false ) && 
-				bb_->get( "RandomNumberGeneratorMax", randNumGenMax, false ) )
+			if( bb_->get( "SyncedRandom", syncedRandom, false ) )
+			{
 				// set the osg::range objects to use the synchronized RNG 
-				osgParticleHPS::rangeSetRandFunc( randNumGenWrapper, *randNumGenMax );
+				randStreamFrame = syncedRandom->getFrameNumber();
+				randStream = syncedRandom->getStream( 
+					SyncedRandom::getStreamID( "PluginRenderEntsParticleSysOSG" ), 
+					randStreamFrame );
+				osgParticleHPS::rangeSetRandFunc( randNumGenWrapper, 0x7fffffff );
+			}
 		
 			// get the list of entity element factories from the BB
 			std::map< std::string, EntityElementFactory * > *entityElementFactoryMap;
@@ -144,6 +168,18 @@ void PluginRenderEntsParticleSysOSG::act( SystemState::ID state, StateContext &s
 
 	case SystemState::ConfigurationProcess:
 		particleSysElementFactory->init( *DefFileData );
+
+		// With an update pool, the particle systems queue their work during 
+		// the update traversal; the callback on the root runs it once the 
+		// whole scene has been traversed, and before cull.
+		if( particleSysElementFactory->getUpdatePool() && !dispatchCallbackInstalled )
+		{
+			osg::NodeCallback *callback = 
+				particleSysElementFactory->getUpdatePool()->getDispatchCallback();
+			callback->setNestedCallback( rootNode->getUpdateCallback() );
+			rootNode->setUpdateCallback( callback );
+			dispatchCallbackInstalled = true;
+		}
 		break;
 
 	case SystemState::Reset:
@@ -53,7 +53,7 @@
 #include "AllCigi.h"
 #include "Plugin.h"
 #include "Entity.h"
-#include "GenerateID.h"
+#include "RandomStream.h"
 #include "DefFileGroup.h"
 
 #include "ParticleSysElementFactory.h"
@@ -113,6 +113,12 @@ private:
 	//! Creates particle systems
 	//! 
 	ParticleSysElementFactory *particleSysElementFactory;
+
+	//=========================================================
+	//! Set once the update pool's dispatch callback has been attached to 
+	//! the root node
+	//! 
+	bool dispatchCallbackInstalled;
 };
 
 
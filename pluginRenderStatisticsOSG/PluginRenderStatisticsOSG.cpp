@@ -66,6 +66,7 @@
 #include "CheckeredColorScreen.h"
 #include "GradientColorScreen.h"
 #include "GridLinesScreen.h"
+#include "ViewTimingScreen.h"
 
 using namespace mpv;
 using namespace mpvosg;
@@ -182,6 +183,7 @@ PluginRenderStatisticsOSG::PluginRenderStatisticsOSG() : Plugin()
 	dependencies_.push_back( "PluginRenderOSG" );
 	dependencies_.push_back( "PluginUserInputMgrOSGGA" );
 	// libpluginEntityMgr is optional
+	// PluginRenderCameraOSGNode is optional
 
 	rootNode = NULL;
 	eventHandlerList = NULL;
@@ -277,6 +279,16 @@ void PluginRenderStatisticsOSG::act( SystemState::ID state, StateContext &stateC
 		}
 		}
 		
+		{
+		ViewRenderTimesMap *viewRenderTimes = NULL;
+		if( bb_->get( "ViewRenderTimes", viewRenderTimes, false ) )
+		{
+			ViewTimingScreen *viewTimingScreen = new ViewTimingScreen;
+			viewTimingScreen->setRenderTimes( viewRenderTimes );
+			overlayScreens[4].push_back( viewTimingScreen );
+		}
+		}
+		
 		break;
 
 	case SystemState::Operate:
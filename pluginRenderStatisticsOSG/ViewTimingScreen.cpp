@@ -0,0 +1,107 @@
+
+#include <stdio.h>
+#include <iostream>
+
+#ifdef WIN32
+#define snprintf _snprintf
+#endif
+
+#include <osg/StateSet>
+#include <osg/Geode>
+
+
+#include "ViewTimingScreen.h"
+
+using namespace mpv;
+using namespace mpvosg;
+
+ViewTimingScreen::ViewTimingScreen() :
+	OverlayScreen()
+{
+	renderTimes = NULL;
+	tableText = NULL;
+}
+
+
+ViewTimingScreen::~ViewTimingScreen()
+{
+}
+
+
+void ViewTimingScreen::resetView( const View *viewParams )
+{
+	projectionMatrix = osg::Matrix::ortho2D( 0.0, 1.0, 0.0, 1.0 );
+}
+
+
+void ViewTimingScreen::act( double deltaT )
+{
+	char tempText[256];
+	
+	if( renderTimes != NULL && geode.valid() )
+	{
+		std::string tableTextString;
+		
+		if( renderTimes->empty() )
+			tableTextString = "(views are not rendered through their own cameras)";
+		
+		ViewRenderTimesMap::iterator mapIter = renderTimes->begin();
+		for( ; mapIter != renderTimes->end(); mapIter++ )
+		{
+			const ViewRenderTimes &times = mapIter->second;
+			snprintf( tempText, 255, "%-5i %8.2f %8.2f %8.2f\n", 
+				mapIter->first, 
+				times.cullTime * 1000.0, 
+				times.drawTime * 1000.0, 
+				times.gpuDrawTime * 1000.0 );
+			tableTextString.append( tempText );
+		}
+		
+		tableText->setText( tableTextString.c_str() );
+	}
+}
+
+
+osg::Node *ViewTimingScreen::getNode()
+{
+	if( !geode.valid() )
+		createTextBox();
+	return geode.get();
+}
+
+
+// ================================================
+// createTextBox
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void ViewTimingScreen::createTextBox()
+{
+	geode = new osg::Geode();
+	
+	// turn lighting off for the text
+	osg::StateSet* stateset = geode->getOrCreateStateSet();
+	stateset->setMode(GL_LIGHTING,osg::StateAttribute::OFF);
+	
+	// disable depth test, and make sure that the text is drawn after 
+	// everything else so that it always appears on top.
+	stateset->setMode(GL_DEPTH_TEST,osg::StateAttribute::OFF);
+	stateset->setRenderBinDetails(11,"RenderBin");
+
+	osgText::Text *headerText = new osgText::Text;
+	headerText->setUseDisplayList( false );
+	geode->addDrawable( headerText );
+	headerText->setFont( 0 );
+	headerText->setCharacterSize( 0.02 );
+	headerText->setPosition( osg::Vec3( 0.05, 0.90, 0.0 ) );
+	headerText->setAlignment( osgText::Text::LEFT_BASE_LINE );
+	headerText->setText( "View  Cull ms  Draw ms   GPU ms" );
+	
+	tableText = new osgText::Text;
+	tableText->setUseDisplayList( false );
+	geode->addDrawable( tableText );
+	tableText->setFont( 0 );
+	tableText->setCharacterSize( 0.02 );
+	tableText->setPosition( osg::Vec3( 0.05, 0.85, 0.0 ) );
+	tableText->setAlignment( osgText::Text::LEFT_BASE_LINE );
+	tableText->setText( "" );
+	
+}
@@ -0,0 +1,62 @@
+/*
+
+
+
+
+*/
+
+#ifndef VIEW_TIMING_SCREEN_H
+#define VIEW_TIMING_SCREEN_H
+
+#include <osg/Geode>
+#include <osgText/Text>
+
+#include "OverlayScreen.h"
+#include "ViewRenderTimes.h"
+
+//=========================================================
+//! Displays how long each view took to cull and draw, as measured by 
+//! PluginRenderCameraOSGNode.  Views that aren't rendered through their 
+//! own cameras don't appear.
+//! 
+class ViewTimingScreen : public mpvosg::OverlayScreen
+{
+public:
+
+	ViewTimingScreen();
+	virtual ~ViewTimingScreen();
+	
+	virtual void resetView( const mpv::View *viewParams );
+	virtual void act( double deltaT );
+	
+	virtual osg::Node *getNode();
+	
+	void setRenderTimes( mpvosg::ViewRenderTimesMap *renderTimesMap )
+	{
+		renderTimes = renderTimesMap;
+	}
+	
+protected:
+
+	//=========================================================
+	//! 
+	//! 
+	osg::ref_ptr<osg::Geode> geode;
+	
+	//=========================================================
+	//! The render times for each view.  Retrieved from the blackboard.
+	//! 
+	mpvosg::ViewRenderTimesMap *renderTimes;
+
+	//=========================================================
+	//! Text object for displaying the timing table.
+	//! Note that geode stores a reference to this variable, so an 
+	//! additional reference-counted pointer isn't needed.
+	//! 
+	osgText::Text *tableText;
+	
+	void createTextBox();
+
+};
+
+#endif
@@ -35,19 +35,26 @@
  *  2007-07-21 Andrew Sampson
  *      Changed interface to use new state machine API
  *
+ *  2026-10-19
+ *      Tiled databases are paged around the view positions; the plugin 
+ *      tracks the views' eye points and their velocities for the pager.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
  */
 
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include <osg/PositionAttitudeTransform>
 #include <osg/StateSet>
 #include <osg/AlphaFunc>
 
 #include "BindSlot.h"
+#include "Log.h"
 
 #include "PluginRenderTerrainOSG.h"
 #include "TerrainImpOSG.h"
@@ -69,6 +76,12 @@ PluginRenderTerrainOSG::PluginRenderTerrainOSG() : Plugin()
 	dependencies_.push_back( "PluginTerrainMgr" );
 	rootNode = NULL;
 	terrainDatabases = NULL;
+	DefinitionData = NULL;
+	viewMap = NULL;
+	allEntities = NULL;
+	timeElapsedLastFrame = NULL;
+	pagingReportInterval = 60.0f;
+	timeSinceReport = 0.0;
 
 	terrainBranchNode = new osg::PositionAttitudeTransform;
 	terrainBranchNode->setName( "Terrain Branch Node" );
@@ -114,7 +127,26 @@ void PluginRenderTerrainOSG::act( SystemState::ID state, StateContext &stateCont
 		bb_->get( "TerrainDatabases", terrainDatabases );
 		terrainDatabases->addedTerrain.connect( 
 			BIND_SLOT2( PluginRenderTerrainOSG::addedTerrainCB, this ) );
+		terrainDatabases->removedTerrain.connect( 
+			BIND_SLOT2( PluginRenderTerrainOSG::removedTerrainCB, this ) );
+
+		bb_->get( "DefinitionData", DefinitionData );
+		bb_->get( "TimeElapsedLastFrame", timeElapsedLastFrame );
+
+		// only needed for tiled databases
+		bb_->get( "ViewMap", viewMap, false );
+		bb_->get( "AllEntities", allEntities, false );
+
+		break;
+
+	case SystemState::ConfigurationProcess:
+		processConfigData();
+		break;
 
+	case SystemState::DatabaseLoad:
+	case SystemState::Operate:
+	case SystemState::Debug:
+		updatePaging();
 		break;
 
 
@@ -130,7 +162,140 @@ void PluginRenderTerrainOSG::act( SystemState::ID state, StateContext &stateCont
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void PluginRenderTerrainOSG::addedTerrainCB( TerrainContainer*, Terrain *terrain )
 {
-	terrain->addImplementation( 
-		new TerrainImpOSG( terrain, terrainBranchNode.get() ) );
+	TerrainImpOSG *imp = new TerrainImpOSG( terrain, terrainBranchNode.get(), 
+		&pagingConfig );
+	terrain->addImplementation( imp );
+	imps.push_back( imp );
+}
+
+
+// ================================================
+// removedTerrainCB
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderTerrainOSG::removedTerrainCB( TerrainContainer*, Terrain *terrain )
+{
+	std::list< RefPtr<TerrainImpOSG> >::iterator iter = imps.begin();
+	while( iter != imps.end() )
+	{
+		if( (*iter)->getTerrain() == terrain )
+			iter = imps.erase( iter );
+		else
+			iter++;
+	}
+}
+
+
+// ================================================
+// processConfigData
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderTerrainOSG::processConfigData()
+{
+	if( *DefinitionData == NULL )
+		return;
+
+	DefFileGroup *databasesGroup = (*DefinitionData)->getGroupByURI( "/databases/" );
+	if( databasesGroup == NULL )
+		return;
+
+	// The threads are started when a tiled database is loaded, so changes 
+	// take effect at the next database load
+	DefFileAttrib *attr = databasesGroup->getAttribute( "paging_io_threads" );
+	if( attr )
+		pagingConfig.ioThreads = attr->asInt();
+
+	attr = databasesGroup->getAttribute( "paging_compile_threads" );
+	if( attr )
+		pagingConfig.compileThreads = attr->asInt();
+
+	attr = databasesGroup->getAttribute( "paging_max_resident_tiles" );
+	if( attr )
+		pagingConfig.maxResidentTiles = attr->asInt();
+
+	attr = databasesGroup->getAttribute( "paging_visible_radius" );
+	if( attr )
+		pagingConfig.visibleRadius = attr->asFloat();
+
+	attr = databasesGroup->getAttribute( "paging_lookahead" );
+	if( attr )
+		pagingConfig.lookahead = attr->asFloat();
+
+	attr = databasesGroup->getAttribute( "paging_report_interval" );
+	if( attr )
+		pagingReportInterval = attr->asFloat();
+}
+
+
+// ================================================
+// updatePaging
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginRenderTerrainOSG::updatePaging()
+{
+	double dt = *timeElapsedLastFrame;
+	std::vector<TilePager::EyePoint> eyePoints;
+
+	if( viewMap != NULL && allEntities != NULL )
+	{
+		std::map< int, RefPtr<View> >::iterator iter;
+		for( iter = viewMap->begin(); iter != viewMap->end(); iter++ )
+		{
+			View *view = iter->second.get();
+			Entity *entity = allEntities->findEntity( view->getEntityID() );
+			if( entity == NULL )
+				continue;
+
+			Vect3 eye = entity->getAbsoluteTransform() * view->getViewOffset();
+			osg::Vec3d position( eye[0], eye[1], eye[2] );
+
+			std::map<int, EyeMotion>::iterator motionIter = eyeMotion.find( iter->first );
+			if( motionIter == eyeMotion.end() )
+			{
+				EyeMotion &motion = eyeMotion[iter->first];
+				motion.position = position;
+			}
+			else if( dt > 0.0 )
+			{
+				EyeMotion &motion = motionIter->second;
+				osg::Vec3d displacement = position - motion.position;
+				motion.position = position;
+
+				if( displacement.length() > pagingConfig.visibleRadius )
+				{
+					// the eye point jumped, rather than moved; don't 
+					// extrapolate the jump
+					motion.velocity = osg::Vec3d( 0., 0., 0. );
+				}
+				else
+				{
+					// smooth over about half a second, to ride out the 
+					// jitter in the frame times
+					double blend = std::min( dt / 0.5, 1.0 );
+					motion.velocity += ( displacement / dt - motion.velocity ) * blend;
+				}
+			}
+
+			TilePager::EyePoint eyePoint;
+			eyePoint.position = position;
+			eyePoint.velocity = eyeMotion[iter->first].velocity;
+			eyePoints.push_back( eyePoint );
+		}
+	}
+
+	if( eyePoints.empty() )
+	{
+		// no views yet; page around the database origin
+		eyePoints.push_back( TilePager::EyePoint() );
+	}
+
+	std::list< RefPtr<TerrainImpOSG> >::iterator imp;
+	for( imp = imps.begin(); imp != imps.end(); imp++ )
+		(*imp)->updatePaging( eyePoints );
+
+	timeSinceReport += dt;
+	if( pagingReportInterval > 0.0f && timeSinceReport >= pagingReportInterval )
+	{
+		timeSinceReport = 0.0;
+		for( imp = imps.begin(); imp != imps.end(); imp++ )
+			(*imp)->reportPaging();
+	}
 }
 
@@ -35,6 +35,10 @@
  *  2007-07-21 Andrew Sampson
  *      Changed interface to use new state machine API
  *
+ *  2026-10-19
+ *      Tiled databases are paged around the view positions; the plugin 
+ *      tracks the views' eye points and their velocities for the pager.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -48,16 +52,26 @@
 #include <map>
 #include <osg/Group>
 #include <osg/PositionAttitudeTransform>
+#include <osg/Vec3d>
 
 #include "Plugin.h"
+#include "DefFileGroup.h"
 #include "Entity.h"
+#include "EntityContainer.h"
+#include "View.h"
 #include "Terrain.h"
 #include "TerrainContainer.h"
 
+#include "TerrainImpOSG.h"
+
 //=========================================================
 //! This plugin is responsible for creating and managing the terrain branch 
 //! of the scene graph.
 //! 
+//! Tiled databases are paged in around the views' eye points.  Each eye 
+//! point's velocity is estimated from its motion over the last few frames, 
+//! so that the pager can fetch the tiles ahead of it.
+//! 
 class PluginRenderTerrainOSG : public Plugin 
 {
 public:
@@ -81,11 +95,51 @@ public:
 	virtual void act( SystemState::ID state, StateContext &stateContext );
 	
 private:
+	
+	//! an eye point's position last frame, and its estimated velocity
+	struct EyeMotion
+	{
+		osg::Vec3d position;
+		osg::Vec3d velocity;
+	};
+	
+	//=========================================================
+	//! Reads the paging parameters from the config
+	//! 
+	void processConfigData();
+	
+	//=========================================================
+	//! Finds the views' eye points, updates their velocities, and passes 
+	//! them to the terrains' pagers
+	//! 
+	void updatePaging();
+	
 	//=========================================================
 	//! The root node of the scene graph.  Retrieved from the blackboard.
 	//! 
 	osg::Group *rootNode;
 	
+	//=========================================================
+	//! Configuration data.  Retrieved from the blackboard.
+	//! 
+	DefFileGroup **DefinitionData;
+	
+	//=========================================================
+	//! The views, keyed by view ID.  Retrieved from the blackboard, if 
+	//! present; without it, tiled databases only page around the origin.
+	//! 
+	std::map< int, mpv::RefPtr<mpv::View> > *viewMap;
+	
+	//=========================================================
+	//! All the entities.  Retrieved from the blackboard, if present.
+	//! 
+	mpv::EntityContainer *allEntities;
+	
+	//=========================================================
+	//! Time elapsed during the last frame.  Retrieved from the blackboard.
+	//! 
+	double *timeElapsedLastFrame;
+	
 	//=========================================================
 	//! A container, containing all known terrain databases.  
 	//! Retrieved from the blackboard.
@@ -97,7 +151,22 @@ private:
 	//! 
 	osg::ref_ptr<osg::PositionAttitudeTransform> terrainBranchNode;
 	
+	//! the imps created by this plugin, one per terrain
+	std::list< mpv::RefPtr<TerrainImpOSG> > imps;
+	
+	//! shared by the imps
+	TilePager::Config pagingConfig;
+	
+	//! eye point motion, keyed by view ID
+	std::map<int, EyeMotion> eyeMotion;
+	
+	//! seconds between paging reports; 0 disables them
+	float pagingReportInterval;
+	double timeSinceReport;
+	
 	void addedTerrainCB( mpv::TerrainContainer*, mpv::Terrain *terrain );
+	
+	void removedTerrainCB( mpv::TerrainContainer*, mpv::Terrain *terrain );
 };
 
 
@@ -20,12 +20,21 @@
  *  2008-10-12 Andrew Sampson
  *      Initial release.  Based on code from PluginRenderTerrainOSG.cpp
  *  
+ *  2026-10-19
+ *      Added preloading.  The loader thread no longer touches the scene 
+ *      graph; the loaded subgraph is attached by update(), or by load() 
+ *      if it is already in memory.
+ *  
+ *  2026-10-19
+ *      Tiled databases are paged in around the eye points by a TilePager.
+ *  
  *  
  *  </pre>
  */
 
 
 #include <iostream>
+#include <set>
 #include <string>
 #if WIN32
    #include <Windows.h> // for Sleep()!
@@ -34,9 +43,13 @@
 #endif
 #include <osg/Geode>
 #include <osg/Geometry>
+#include <osg/NodeVisitor>
 #include <osg/PositionAttitudeTransform>
+#include <osg/Texture>
 #include <osgDB/ReadFile>
 
+#include "Log.h"
+
 #include "TerrainImpOSG.h"
 
 #include "MoveDummyTerrainTransform.h"
@@ -44,12 +57,108 @@
 
 using namespace mpv;
 
+namespace
+{
+
+//=========================================================
+//! Estimates the memory held by a subgraph: vertex data, indices and 
+//! texture images.  Shared geometry and images are counted once.
+//! 
+class ResidentSizeVisitor : public osg::NodeVisitor
+{
+public:
+	ResidentSizeVisitor() : 
+		osg::NodeVisitor( osg::NodeVisitor::TRAVERSE_ALL_CHILDREN ), 
+		bytes( 0 )
+	{}
+	
+	virtual void apply( osg::Node &node )
+	{
+		addStateSet( node.getStateSet() );
+		traverse( node );
+	}
+	
+	virtual void apply( osg::Geode &geode )
+	{
+		addStateSet( geode.getStateSet() );
+		for( unsigned int i = 0; i < geode.getNumDrawables(); i++ )
+		{
+			osg::Drawable *drawable = geode.getDrawable( i );
+			if( drawable == NULL || !drawables.insert( drawable ).second )
+				continue;
+			
+			addStateSet( drawable->getStateSet() );
+			
+			osg::Geometry *geometry = drawable->asGeometry();
+			if( geometry == NULL )
+				continue;
+			
+			addArray( geometry->getVertexArray() );
+			addArray( geometry->getNormalArray() );
+			addArray( geometry->getColorArray() );
+			for( unsigned int unit = 0; unit < geometry->getNumTexCoordArrays(); unit++ )
+				addArray( geometry->getTexCoordArray( unit ) );
+			
+			// assumes 32-bit indices; most databases use fewer bytes
+			for( unsigned int j = 0; j < geometry->getNumPrimitiveSets(); j++ )
+				bytes += geometry->getPrimitiveSet( j )->getNumIndices() * 4;
+		}
+		traverse( geode );
+	}
+	
+	size_t bytes;
+	
+private:
+	void addArray( osg::Array *array )
+	{
+		if( array != NULL )
+			bytes += array->getTotalDataSize();
+	}
+	
+	void addStateSet( osg::StateSet *stateSet )
+	{
+		if( stateSet == NULL || !stateSets.insert( stateSet ).second )
+			return;
+		
+		for( unsigned int unit = 0; unit < stateSet->getTextureAttributeList().size(); unit++ )
+		{
+			osg::Texture *texture = dynamic_cast<osg::Texture *>( 
+				stateSet->getTextureAttribute( unit, osg::StateAttribute::TEXTURE ) );
+			if( texture == NULL )
+				continue;
+			
+			for( unsigned int i = 0; i < texture->getNumImages(); i++ )
+			{
+				osg::Image *image = texture->getImage( i );
+				if( image != NULL && images.insert( image ).second )
+					bytes += image->getTotalSizeInBytes();
+			}
+		}
+	}
+	
+	std::set<osg::Drawable *> drawables;
+	std::set<osg::StateSet *> stateSets;
+	std::set<osg::Image *> images;
+};
+
+}
+
 // ================================================
 // TerrainImpOSG
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-TerrainImpOSG::TerrainImpOSG( Terrain *_terrain, osg::Group *ap ) : 
+TerrainImpOSG::TerrainImpOSG( Terrain *_terrain, osg::Group *ap, 
+	const TilePager::Config *_pagingConfig ) : 
 	TerrainImp( _terrain ), 
 	attachmentPoint( ap ), 
+	pagingConfig( _pagingConfig ), 
+	attached( false ), 
+	loading( false ), 
+	loaderStarted( false ), 
+	loadFailed( false ), 
+	attachWhenLoaded( false ), 
+	residentBytes( 0 ), 
+	loadStartTick( 0 ), 
+	loadTime( 0.0 ), 
 	loaderThread( this )
 {
 	
@@ -70,27 +179,124 @@ TerrainImpOSG::~TerrainImpOSG()
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 void TerrainImpOSG::load()
 {
-	unload();
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
 	
-	loaderMutex.lock();
-	state = Terrain::Loading;
+	if( attached )
+		return;
 	
+	if( terrain->isTiled() )
+	{
+		pager = new TilePager( terrain, *pagingConfig );
+		attachmentPoint->addChild( pager->getRoot() );
+		attached = true;
+		loadStartTick = osg::Timer::instance()->tick();
+		// updatePaging() sets state to Loaded once the first tiles are in
+		state = Terrain::Loading;
+	}
+	else if( loading )
+	{
+		// a preload is under way; attach it when it's done
+		attachWhenLoaded = true;
+		state = Terrain::Loading;
+	}
+	else if( terrainNode.valid() || loadFailed )
+	{
+		// already in memory
+		attachTerrainSubgraph();
+	}
+	else
+	{
+		attachWhenLoaded = true;
+		state = Terrain::Loading;
+		startLoading();
+	}
+}
+
+
+// ================================================
+// preload
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TerrainImpOSG::preload()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
+	
+	if( terrain->isTiled() || loading || attached || terrainNode.valid() || loadFailed )
+		return;
+	
+	startLoading();
+}
+
+
+// ================================================
+// startLoading
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TerrainImpOSG::startLoading()
+{
+	// The previous load's thread has cleared loading and is exiting, if it 
+	// hasn't already; it doesn't need the mutex to do so.
+	if( loaderStarted )
+		loaderThread.join();
+	
+	loaderStarted = true;
+	loading = true;
+	loadFailed = false;
+	loadStartTick = osg::Timer::instance()->tick();
 	loaderThread.start();
-	loaderMutex.unlock();
 }
 
 
 // ================================================
-// attachTerrainSubgraph
+// finishedLoading
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-void TerrainImpOSG::attachTerrainSubgraph( osg::Node *node )
+void TerrainImpOSG::finishedLoading( osg::Node *node, size_t bytes )
 {
 	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
 	
 	terrainNode = node;
-	if( terrainNode.valid() )
+	loadFailed = !terrainNode.valid();
+	residentBytes = bytes;
+	loadTime = osg::Timer::instance()->delta_s( loadStartTick, osg::Timer::instance()->tick() );
+	loading = false;
+	
+	if( loadFailed )
+	{
+		std::cerr << "TerrainImpOSG::load() - " 
+			<< "could not load terrain database \""
+			<< terrain->getName() << "\" (id " << terrain->getID() << ") : \n"
+			<< "\tthere was an error while loading the following file: \n"
+			<< "\t" << terrain->getDirectoryname() << "/" << terrain->getFilename()
+			<< std::endl;
+	}
+}
+
+
+// ================================================
+// update
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TerrainImpOSG::update( double timeElapsed )
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
+	
+	if( attachWhenLoaded && !loading )
+		attachTerrainSubgraph();
+}
+
+
+// ================================================
+// attachTerrainSubgraph
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TerrainImpOSG::attachTerrainSubgraph()
+{
+	attachWhenLoaded = false;
+	
+	if( loadFailed )
+	{
+		if( !terrainNode.valid() )
+			terrainNode = createDummyTerrain();
+		state = Terrain::Broken;
+	}
+	else
 	{
-		attachmentPoint->addChild( terrainNode.get() );
 		// Get the pager and register the terrain node with it.
 		// This is required for the PagedLOD stuff.
     /*
@@ -101,21 +307,42 @@ void TerrainImpOSG::attachTerrainSubgraph( osg::Node *node )
 
 		state = Terrain::Loaded;
 	}
-	else
+	
+	attachmentPoint->addChild( terrainNode.get() );
+	attached = true;
+}
+
+
+// ================================================
+// detach
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TerrainImpOSG::detach()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
+	
+	// an in-progress load carries on as a preload
+	attachWhenLoaded = false;
+	
+	if( pager.valid() )
 	{
-		std::cerr << "TerrainImpOSG::load() - " 
-			<< "could not load terrain database \""
-			<< terrain->getName() << "\" (id " << terrain->getID() << ") : \n"
-			<< "\tthere was an error while loading the following file: \n"
-			<< "\t" << terrain->getDirectoryname() << "/" << terrain->getFilename()
-			<< std::endl;
+		// tiles are only kept around the eye points, so there's nothing 
+		// worth keeping
+		stopPager();
+	}
+	else if( attached )
+	{
+		attachmentPoint->removeChild( terrainNode.get() );
+		attached = false;
 		
-		terrainNode = createDummyTerrain();
-		attachmentPoint->addChild( terrainNode.get() );
-
-		state = Terrain::Broken;
+		// there's no point keeping the dummy terrain; the next load() will 
+		// try the file again
+		if( loadFailed )
+		{
+			terrainNode = NULL;
+			loadFailed = false;
+		}
 	}
-	
+	state = Terrain::NotLoaded;
 }
 
 
@@ -125,7 +352,7 @@ void TerrainImpOSG::attachTerrainSubgraph( osg::Node *node )
 void TerrainImpOSG::unload()
 {
 	// wait for in-progress load to complete
-	while( getState() == Terrain::Loading ) // getState() does locking
+	while( isLoading() ) // isLoading() does locking
 	{
 #if WIN32
     Sleep( 1000 );
@@ -137,6 +364,12 @@ void TerrainImpOSG::unload()
 	{
 	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
 	
+	if( loaderStarted )
+	{
+		loaderThread.join();
+		loaderStarted = false;
+	}
+	
 	// clear various caches; this reduces the mpv's memory footprint 
 	// following a database switch.  
 	// Unfortunately there's still a leak somewhere, as the memory usage 
@@ -145,11 +378,17 @@ void TerrainImpOSG::unload()
 	osgDB::Registry::instance()->clearArchiveCache();
 	//osgDB::Registry::instance()->getOrCreateDatabasePager()->clear();
 	
-	if( terrainNode.valid() )
+	if( pager.valid() )
+		stopPager();
+	else if( attached )
 	{
 		attachmentPoint->removeChild( terrainNode.get() );
-		terrainNode = NULL;
+		attached = false;
 	}
+	terrainNode = NULL;
+	loadFailed = false;
+	attachWhenLoaded = false;
+	residentBytes = 0;
 	state = Terrain::NotLoaded;
 	}
 }
@@ -168,6 +407,102 @@ Terrain::TerrainState TerrainImpOSG::getState()
 }
 
 
+// ================================================
+// isResident
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool TerrainImpOSG::isResident()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
+	// a failed load counts; load() will put the dummy terrain up at once
+	return pager.valid() || ( !loading && ( terrainNode.valid() || loadFailed ) );
+}
+
+
+// ================================================
+// isLoading
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool TerrainImpOSG::isLoading()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
+	return loading;
+}
+
+
+// ================================================
+// getResidentBytes
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+size_t TerrainImpOSG::getResidentBytes()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
+	return residentBytes;
+}
+
+
+// ================================================
+// getLoadTime
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+double TerrainImpOSG::getLoadTime()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
+	if( loading )
+		return osg::Timer::instance()->delta_s( loadStartTick, osg::Timer::instance()->tick() );
+	return loadTime;
+}
+
+
+// ================================================
+// updatePaging
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TerrainImpOSG::updatePaging( const std::vector<TilePager::EyePoint> &eyePoints )
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
+	
+	if( !pager.valid() )
+		return;
+	
+	pager->update( eyePoints );
+	
+	if( state == Terrain::Loading && pager->isVisibleSetResident() )
+	{
+		loadTime = osg::Timer::instance()->delta_s( loadStartTick, osg::Timer::instance()->tick() );
+		state = Terrain::Loaded;
+	}
+}
+
+
+// ================================================
+// reportPaging
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TerrainImpOSG::reportPaging()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( loaderMutex );
+	
+	if( !pager.valid() )
+		return;
+	
+	const TilePager::Counters &counters = pager->getCounters();
+	MPV_LOG_INFO( "TerrainImpOSG - terrain \"" << terrain->getName() 
+		<< "\": " << pager->getNumResidentTiles() << " tiles resident, " 
+		<< pager->getNumPendingTiles() << " pending; " 
+		<< counters.tilesLoaded << " loaded, " 
+		<< counters.tilesLate << " late, " 
+		<< counters.tilesEvicted << " evicted, " 
+		<< counters.tilesMissing << " missing" );
+}
+
+
+// ================================================
+// stopPager
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TerrainImpOSG::stopPager()
+{
+	pager->stop();
+	attachmentPoint->removeChild( pager->getRoot() );
+	pager = NULL;
+	attached = false;
+}
+
+
 
 // ================================================
 // createDummyTerrain
@@ -300,7 +635,16 @@ TerrainImpOSG::LoaderThread::~LoaderThread()
 void TerrainImpOSG::LoaderThread::run()
 {
 	std::string filename = terrainImp->terrain->getDirectoryname() + "/" + terrainImp->terrain->getFilename();
-	osg::Node *node = osgDB::readNodeFile( filename );
-	terrainImp->attachTerrainSubgraph( node );
+	osg::ref_ptr<osg::Node> node = osgDB::readNodeFile( filename );
+	
+	size_t bytes = 0;
+	if( node.valid() )
+	{
+		ResidentSizeVisitor sizeVisitor;
+		node->accept( sizeVisitor );
+		bytes = sizeVisitor.bytes;
+	}
+	
+	terrainImp->finishedLoading( node.get(), bytes );
 }
 
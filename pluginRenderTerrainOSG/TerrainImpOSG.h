@@ -20,6 +20,14 @@
  *  2008-10-12 Andrew Sampson
  *      Initial release.  Based on code from PluginRenderTerrainOSG.cpp
  *  
+ *  2026-10-19
+ *      Added preloading.  The loader thread no longer touches the scene 
+ *      graph; the loaded subgraph is attached by update(), or by load() 
+ *      if it is already in memory.
+ *  
+ *  2026-10-19
+ *      Tiled databases are paged in around the eye points by a TilePager.
+ *  
  *  
  *  </pre>
  */
@@ -32,13 +40,25 @@
 #include <OpenThreads/ScopedLock>
 #include <OpenThreads/Thread>
 #include <osg/Group>
+#include <osg/Timer>
 
 #include "Terrain.h"
+#include "TilePager.h"
 
 //=========================================================
 //! A child class of TerrainImp, which implements loading of a terrain 
 //! database via OSG.
 //! 
+//! The database is read on a thread of its own.  The subgraph it produces 
+//! is only attached to the scene from the kernel thread, in load() or 
+//! update().  A preloaded or detached subgraph stays in memory, off the 
+//! scene graph, until unload(); load() then attaches it at once.
+//! 
+//! A tiled database is instead paged in by a TilePager, which load() 
+//! creates and updatePaging() drives.  It counts as loaded once the tiles 
+//! around the eye points are in.  Tiled databases aren't preloaded, and 
+//! detaching one unloads it.
+//! 
 class TerrainImpOSG : public mpv::TerrainImp
 {
 public:
@@ -47,8 +67,11 @@ public:
 	//! \param _terrain - the Terrain object that this TerrainImp is 
 	//!        associated with
 	//! \param ap - the attachment point for the terrain scene graph
+	//! \param pagingConfig - paging parameters, for tiled databases; owned 
+	//!        by the caller, and read each time the database is loaded
 	//! 
-	TerrainImpOSG( mpv::Terrain *_terrain, osg::Group *ap );
+	TerrainImpOSG( mpv::Terrain *_terrain, osg::Group *ap, 
+		const TilePager::Config *pagingConfig );
 	
 	//! Performs loading of the terrain database for this imp.
 	//! Sets state accordingly.
@@ -58,9 +81,39 @@ public:
 	//! Sets state accordingly.
 	virtual void unload();
 	
+	//! Removes this imp's terrain database from the scene, but keeps it in 
+	//! memory.
+	virtual void detach();
+	
+	//! Begins loading this imp's terrain database, without attaching it.
+	virtual void preload();
+	
+	//! Attaches the subgraph if a load has finished.
+	virtual void update( double timeElapsed );
+	
 	//! Returns state, and wraps access to state in a mutex.
 	virtual mpv::Terrain::TerrainState getState();
 	
+	virtual bool isResident();
+	
+	virtual bool isLoading();
+	
+	virtual size_t getResidentBytes();
+	
+	virtual double getLoadTime();
+	
+	//=========================================================
+	//! Pages tiles in and out around the eye points, if this is a tiled 
+	//! database and it is loaded.  Called once per frame.
+	//! 
+	void updatePaging( const std::vector<TilePager::EyePoint> &eyePoints );
+	
+	//=========================================================
+	//! Logs the pager's counters, if this is a tiled database and it is 
+	//! loaded
+	//! 
+	void reportPaging();
+	
 	
 protected:
 	//=========================================================
@@ -69,7 +122,17 @@ protected:
 	virtual ~TerrainImpOSG();
 	
 	//! called by terrain loading thread
-	void attachTerrainSubgraph( osg::Node *node );
+	void finishedLoading( osg::Node *node, size_t bytes );
+	
+	//! Starts the loader thread.  loaderMutex must be held.
+	void startLoading();
+	
+	//! Stops the pager and removes its tiles.  loaderMutex must be held.
+	void stopPager();
+	
+	//! Attaches the loaded subgraph, or the dummy terrain if the load 
+	//! failed, and sets state.  loaderMutex must be held.
+	void attachTerrainSubgraph();
 	
 	//=========================================================
 	//! Sets up the "dummy" terrain.  The dummy terrain consists of a large 
@@ -89,13 +152,41 @@ protected:
 		float linewidth = 10.0 // actually half the linewidth, but whatever
 	);
 	
-	//! the loaded scene graph
+	//! the loaded scene graph; in memory whether or not it is attached
 	osg::ref_ptr<osg::Node> terrainNode;
 
 	//! the attachment point for the terrain scene graph
 	osg::ref_ptr<osg::Group> attachmentPoint;
 	
-	//! mutex which controls access to this->state and attachmentPoint
+	const TilePager::Config *pagingConfig;
+	
+	//! pages the tiles of a tiled database; only exists while it is loaded
+	osg::ref_ptr<TilePager> pager;
+	
+	//! true while terrainNode is a child of attachmentPoint
+	bool attached;
+	
+	//! true while the loader thread is running
+	bool loading;
+	
+	//! true if the loader thread has been started and not yet joined
+	bool loaderStarted;
+	
+	//! true if the last load failed; terrainNode is then NULL until the 
+	//! dummy terrain is attached in its place
+	bool loadFailed;
+	
+	//! true if the subgraph should be attached once the loader finishes
+	bool attachWhenLoaded;
+	
+	//! estimate of the memory held by terrainNode
+	size_t residentBytes;
+	
+	osg::Timer_t loadStartTick;
+	//! duration of the last completed load, in seconds
+	double loadTime;
+	
+	//! mutex which controls access to this->state and the members above
 	OpenThreads::Mutex loaderMutex;
 
 	class LoaderThread : public OpenThreads::Thread
@@ -0,0 +1,449 @@
+/** <pre>
+ *  MPV OSG terrain loading plugin
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include <OpenThreads/ScopedLock>
+#include <osgDB/ReadFile>
+#include <osgUtil/Optimizer>
+
+#include "Log.h"
+
+#include "TilePager.h"
+
+
+using namespace mpv;
+
+namespace
+{
+
+//! orders (priority, tile) pairs so that the lowest priority ends up last
+struct WorstFirst
+{
+	template<class T>
+	bool operator()( const T &a, const T &b ) const { return a.first > b.first; }
+};
+
+//! orders (last wanted, tile) pairs so that the least recently wanted is first
+struct OldestFirst
+{
+	template<class T>
+	bool operator()( const T &a, const T &b ) const { return a.first < b.first; }
+};
+
+void replaceAll( std::string &str, const std::string &from, const std::string &to )
+{
+	for( size_t pos = str.find( from ); pos != std::string::npos; 
+		pos = str.find( from, pos + to.size() ) )
+	{
+		str.replace( pos, from.size(), to );
+	}
+}
+
+}
+
+// ================================================
+// Config
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+TilePager::Config::Config() : 
+	ioThreads( 2 ), 
+	compileThreads( 1 ), 
+	maxResidentTiles( 256 ), 
+	visibleRadius( 5000.0 ), 
+	lookahead( 5.0 )
+{
+	
+}
+
+
+// ================================================
+// TilePager
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+TilePager::TilePager( Terrain *_terrain, const Config &_config ) : 
+	osg::Referenced(), 
+	terrain( _terrain ), 
+	config( _config ), 
+	frameNumber( 0 ), 
+	visibleSetResident( false ), 
+	primed( false ), 
+	stopping( false )
+{
+	root = new osg::Group;
+	root->setName( "Tiles for " + terrain->getName() );
+	
+	config.ioThreads = std::max( config.ioThreads, 1 );
+	config.compileThreads = std::max( config.compileThreads, 0 );
+	
+	for( int i = 0; i < config.ioThreads; i++ )
+		threads.push_back( new WorkerThread( this, false ) );
+	for( int i = 0; i < config.compileThreads; i++ )
+		threads.push_back( new WorkerThread( this, true ) );
+	
+	for( std::vector<WorkerThread *>::iterator iter = threads.begin(); 
+		iter != threads.end(); iter++ )
+	{
+		(*iter)->start();
+	}
+}
+
+
+// ================================================
+// ~TilePager
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+TilePager::~TilePager()
+{
+	stop();
+}
+
+
+// ================================================
+// stop
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TilePager::stop()
+{
+	{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	stopping = true;
+	requests.clear();
+	compileQueue.clear();
+	requestCondition.broadcast();
+	compileCondition.broadcast();
+	}
+	
+	// tiles being read are finished, then dropped
+	for( std::vector<WorkerThread *>::iterator iter = threads.begin(); 
+		iter != threads.end(); iter++ )
+	{
+		(*iter)->join();
+		delete *iter;
+	}
+	threads.clear();
+	
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	inFlight.clear();
+	mergeQueue.clear();
+}
+
+
+// ================================================
+// update
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TilePager::update( const std::vector<EyePoint> &eyePoints )
+{
+	frameNumber++;
+	
+	// attach the tiles that have finished loading
+	std::deque<LoadedTile> loaded;
+	{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	loaded.swap( mergeQueue );
+	for( std::deque<LoadedTile>::iterator iter = loaded.begin(); 
+		iter != loaded.end(); iter++ )
+	{
+		inFlight.erase( iter->key );
+	}
+	}
+	
+	for( std::deque<LoadedTile>::iterator iter = loaded.begin(); 
+		iter != loaded.end(); iter++ )
+	{
+		if( !iter->node.valid() )
+		{
+			missing.insert( iter->key );
+			counters.tilesMissing++;
+			continue;
+		}
+		
+		ResidentTile &tile = resident[iter->key];
+		if( tile.node.valid() )
+			root->removeChild( tile.node.get() );
+		tile.node = iter->node;
+		tile.lastWanted = frameNumber;
+		root->addChild( tile.node.get() );
+		counters.tilesLoaded++;
+	}
+	
+	// work out which tiles are wanted; the visible ones first, then the 
+	// ones along each eye point's path
+	std::map<TileKey, double> wanted;
+	std::vector<EyePoint>::const_iterator eye;
+	for( eye = eyePoints.begin(); eye != eyePoints.end(); eye++ )
+		addTilesAround( eye->position, 0.0, wanted );
+	
+	std::set<TileKey> visible;
+	std::map<TileKey, double>::iterator wantedIter;
+	for( wantedIter = wanted.begin(); wantedIter != wanted.end(); wantedIter++ )
+		visible.insert( wantedIter->first );
+	
+	if( config.lookahead > 0.0 )
+	{
+		for( eye = eyePoints.begin(); eye != eyePoints.end(); eye++ )
+		{
+			if( eye->velocity.length2() == 0.0 )
+				continue;
+			
+			// tiles the eye point will reach sooner are more urgent
+			addTilesAround( eye->position + eye->velocity * ( config.lookahead * 0.5 ), 
+				config.visibleRadius, wanted );
+			addTilesAround( eye->position + eye->velocity * config.lookahead, 
+				config.visibleRadius * 2.0, wanted );
+		}
+	}
+	
+	// check the visible set, and count the tiles that became visible 
+	// before they were loaded; a tile counts once until it is loaded or 
+	// goes out of view
+	bool allResident = true;
+	std::set<TileKey> stillLate;
+	for( std::set<TileKey>::iterator iter = visible.begin(); 
+		iter != visible.end(); iter++ )
+	{
+		if( resident.count( *iter ) || missing.count( *iter ) )
+			continue;
+		
+		allResident = false;
+		if( primed )
+		{
+			stillLate.insert( *iter );
+			if( !lateTiles.count( *iter ) )
+				counters.tilesLate++;
+		}
+	}
+	lateTiles.swap( stillLate );
+	visibleSetResident = allResident;
+	if( allResident && !eyePoints.empty() )
+		primed = true;
+	
+	// queue the wanted tiles that aren't in memory, and mark the ones that 
+	// are as recently used
+	std::vector< std::pair<double, TileKey> > toLoad;
+	for( wantedIter = wanted.begin(); wantedIter != wanted.end(); wantedIter++ )
+	{
+		std::map<TileKey, ResidentTile>::iterator residentIter = 
+			resident.find( wantedIter->first );
+		if( residentIter != resident.end() )
+			residentIter->second.lastWanted = frameNumber;
+		else if( !missing.count( wantedIter->first ) )
+			toLoad.push_back( std::make_pair( wantedIter->second, wantedIter->first ) );
+	}
+	std::sort( toLoad.begin(), toLoad.end(), WorstFirst() );
+	
+	{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	// tiles that are no longer wanted drop out of the queue
+	requests.clear();
+	for( std::vector< std::pair<double, TileKey> >::iterator iter = toLoad.begin(); 
+		iter != toLoad.end(); iter++ )
+	{
+		if( !inFlight.count( iter->second ) )
+			requests.push_back( iter->second );
+	}
+	if( !requests.empty() )
+		requestCondition.broadcast();
+	}
+	
+	// evict the least recently wanted tiles, if over budget; tiles wanted 
+	// this frame are never evicted, even if that means going over
+	if( (int)resident.size() > config.maxResidentTiles )
+	{
+		std::vector< std::pair<unsigned int, TileKey> > candidates;
+		std::map<TileKey, ResidentTile>::iterator residentIter;
+		for( residentIter = resident.begin(); residentIter != resident.end(); residentIter++ )
+		{
+			if( residentIter->second.lastWanted != frameNumber )
+				candidates.push_back( std::make_pair( 
+					residentIter->second.lastWanted, residentIter->first ) );
+		}
+		std::sort( candidates.begin(), candidates.end(), OldestFirst() );
+		
+		for( size_t i = 0; i < candidates.size() && 
+			(int)resident.size() > config.maxResidentTiles; i++ )
+		{
+			residentIter = resident.find( candidates[i].second );
+			root->removeChild( residentIter->second.node.get() );
+			resident.erase( residentIter );
+			counters.tilesEvicted++;
+		}
+	}
+}
+
+
+// ================================================
+// getNumPendingTiles
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int TilePager::getNumPendingTiles()
+{
+	OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+	return (int)( requests.size() + inFlight.size() );
+}
+
+
+// ================================================
+// addTilesAround
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TilePager::addTilesAround( const osg::Vec3d &point, double bias, 
+	std::map<TileKey, double> &wanted )
+{
+	const double size = terrain->getTileSize();
+	const double radius = config.visibleRadius;
+	const double x = point.x() - terrain->getTileOriginX();
+	const double y = point.y() - terrain->getTileOriginY();
+	
+	int minX = std::max( (int)floor( ( x - radius ) / size ), terrain->getTileMinX() );
+	int maxX = std::min( (int)floor( ( x + radius ) / size ), terrain->getTileMaxX() );
+	int minY = std::max( (int)floor( ( y - radius ) / size ), terrain->getTileMinY() );
+	int maxY = std::min( (int)floor( ( y + radius ) / size ), terrain->getTileMaxY() );
+	
+	for( int tileX = minX; tileX <= maxX; tileX++ )
+	{
+		for( int tileY = minY; tileY <= maxY; tileY++ )
+		{
+			// distance to the nearest point of the tile
+			double dx = std::max( fabs( x - ( tileX + 0.5 ) * size ) - size * 0.5, 0.0 );
+			double dy = std::max( fabs( y - ( tileY + 0.5 ) * size ) - size * 0.5, 0.0 );
+			double distance = sqrt( dx * dx + dy * dy );
+			if( distance > radius )
+				continue;
+			
+			TileKey key( tileX, tileY );
+			double priority = distance + bias;
+			std::map<TileKey, double>::iterator iter = wanted.find( key );
+			if( iter == wanted.end() )
+				wanted[key] = priority;
+			else if( priority < iter->second )
+				iter->second = priority;
+		}
+	}
+}
+
+
+// ================================================
+// getTileFilename
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+std::string TilePager::getTileFilename( const TileKey &key ) const
+{
+	std::ostringstream x, y;
+	x << key.first;
+	y << key.second;
+	
+	std::string filename = terrain->getTilePattern();
+	replaceAll( filename, "{x}", x.str() );
+	replaceAll( filename, "{y}", y.str() );
+	return terrain->getDirectoryname() + "/" + filename;
+}
+
+
+// ================================================
+// ioLoop
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TilePager::ioLoop()
+{
+	while( true )
+	{
+		LoadedTile tile;
+		
+		{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+		while( !stopping && requests.empty() )
+			requestCondition.wait( &mutex );
+		if( stopping )
+			return;
+		
+		tile.key = requests.back();
+		requests.pop_back();
+		inFlight.insert( tile.key );
+		}
+		
+		std::string filename = getTileFilename( tile.key );
+		tile.node = osgDB::readNodeFile( filename );
+		if( !tile.node.valid() )
+			MPV_LOG_DEBUG( "TilePager - could not read tile " << filename );
+		
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+		if( stopping )
+			return;
+		
+		if( tile.node.valid() && config.compileThreads > 0 )
+		{
+			compileQueue.push_back( tile );
+			compileCondition.signal();
+		}
+		else
+			mergeQueue.push_back( tile );
+	}
+}
+
+
+// ================================================
+// compileLoop
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TilePager::compileLoop()
+{
+	while( true )
+	{
+		LoadedTile tile;
+		
+		{
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+		while( !stopping && compileQueue.empty() )
+			compileCondition.wait( &mutex );
+		if( stopping )
+			return;
+		
+		tile = compileQueue.front();
+		compileQueue.pop_front();
+		}
+		
+		// Do the preparation that doesn't need a graphics context here, 
+		// rather than in the first cull or draw after the tile is attached.  
+		// Display lists and texture objects are still created on the tile's 
+		// first draw.
+		osgUtil::Optimizer optimizer;
+		optimizer.optimize( tile.node.get(), 
+			osgUtil::Optimizer::SHARE_DUPLICATE_STATE | 
+			osgUtil::Optimizer::CHECK_GEOMETRY );
+		tile.node->getBound();
+		
+		OpenThreads::ScopedLock<OpenThreads::Mutex> lock( mutex );
+		if( stopping )
+			return;
+		mergeQueue.push_back( tile );
+	}
+}
+
+
+// ================================================
+// WorkerThread::run
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void TilePager::WorkerThread::run()
+{
+	if( isCompileThread )
+		pager->compileLoop();
+	else
+		pager->ioLoop();
+}
@@ -0,0 +1,238 @@
+/** <pre>
+ *  MPV OSG terrain loading plugin
+ *  Copyright (c) 2026
+ *
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically
+ *  version 2.1 of the License.
+ *
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ *
+ *  2026-10-19
+ *      Initial release
+ *
+ * </pre>
+ */
+
+
+#ifndef _TILEPAGER_H_
+#define _TILEPAGER_H_
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/Thread>
+#include <osg/Group>
+#include <osg/Referenced>
+#include <osg/Vec3d>
+
+#include "Terrain.h"
+
+//=========================================================
+//! Pages the tiles of a tiled terrain database in and out around a set of 
+//! eye points.
+//! 
+//! Each frame, update() works out which tiles are wanted: those within the 
+//! visible radius of an eye point, and, for prefetching, those within the 
+//! visible radius of where each eye point will be over the next few 
+//! seconds at its current velocity.  Wanted tiles that aren't in memory 
+//! are queued for the I/O threads, nearest first; prefetch tiles come 
+//! after all the visible ones.  Loaded tiles pass through the compile 
+//! threads, if there are any, and are attached by update() on the kernel 
+//! thread.  When more tiles are resident than the budget allows, the ones 
+//! wanted least recently are removed.
+//! 
+class TilePager : public osg::Referenced
+{
+public:
+	
+	//=========================================================
+	//! Paging parameters; see deffilesamples/databaseinfo.def
+	//! 
+	struct Config
+	{
+		Config();
+		
+		//! number of threads reading tile files
+		int ioThreads;
+		//! number of threads preparing loaded tiles for rendering; 0 hands 
+		//! tiles straight from the I/O threads to the kernel thread
+		int compileThreads;
+		//! maximum number of tiles kept in memory
+		int maxResidentTiles;
+		//! tiles any part of which is within this horizontal distance of an 
+		//! eye point are visible, in database units
+		double visibleRadius;
+		//! how far ahead, in seconds, eye points are extrapolated
+		double lookahead;
+	};
+	
+	//=========================================================
+	//! An eye point, in database coordinates
+	//! 
+	struct EyePoint
+	{
+		osg::Vec3d position;
+		//! units per second
+		osg::Vec3d velocity;
+	};
+	
+	//=========================================================
+	//! Counters, since the pager was created
+	//! 
+	struct Counters
+	{
+		Counters() : tilesLoaded( 0 ), tilesLate( 0 ), tilesEvicted( 0 ), 
+			tilesMissing( 0 ) {}
+		
+		//! tiles read and attached
+		unsigned int tilesLoaded;
+		//! tiles that became visible before they were resident; not 
+		//! counted until the first visible set has been loaded
+		unsigned int tilesLate;
+		//! tiles removed to stay within the budget
+		unsigned int tilesEvicted;
+		//! tiles whose files couldn't be read (often just sea or gaps)
+		unsigned int tilesMissing;
+	};
+	
+	//=========================================================
+	//! Constructor; starts the threads
+	//! \param terrain - the tiled database to page
+	//! \param config - paging parameters
+	//! 
+	TilePager( mpv::Terrain *terrain, const Config &config );
+	
+	//=========================================================
+	//! Returns the group that the resident tiles are attached to
+	//! 
+	osg::Group *getRoot() { return root.get(); }
+	
+	//=========================================================
+	//! Queues, attaches and evicts tiles for the current eye points.  
+	//! Called once per frame from the kernel thread.
+	//! 
+	void update( const std::vector<EyePoint> &eyePoints );
+	
+	//=========================================================
+	//! Returns true if every tile visible in the last update() is resident 
+	//! (or known to be missing)
+	//! 
+	bool isVisibleSetResident() const { return visibleSetResident; }
+	
+	const Counters &getCounters() const { return counters; }
+	
+	int getNumResidentTiles() const { return (int)resident.size(); }
+	
+	//=========================================================
+	//! Returns the number of tiles queued or being loaded
+	//! 
+	int getNumPendingTiles();
+	
+	//=========================================================
+	//! Stops the threads, abandoning any queued tiles
+	//! 
+	void stop();
+	
+protected:
+	
+	//=========================================================
+	//! General Destructor
+	//! 
+	virtual ~TilePager();
+	
+	typedef std::pair<int, int> TileKey;
+	
+	//! a tile on its way from a file to the scene
+	struct LoadedTile
+	{
+		TileKey key;
+		osg::ref_ptr<osg::Node> node;
+	};
+	
+	//! a resident tile, and the last frame in which it was wanted
+	struct ResidentTile
+	{
+		osg::ref_ptr<osg::Node> node;
+		unsigned int lastWanted;
+	};
+	
+	//=========================================================
+	//! Adds the tiles within the visible radius of a point to wanted.  A 
+	//! tile's priority is its horizontal distance from the point plus the 
+	//! given bias; the lowest priority found for a tile is kept.
+	//! 
+	void addTilesAround( const osg::Vec3d &point, double bias, 
+		std::map<TileKey, double> &wanted );
+	
+	std::string getTileFilename( const TileKey &key ) const;
+	
+	//! called by the I/O threads
+	void ioLoop();
+	
+	//! called by the compile threads
+	void compileLoop();
+	
+	class WorkerThread : public OpenThreads::Thread
+	{
+	public:
+		WorkerThread( TilePager *_pager, bool _isCompileThread ) : 
+			pager( _pager ), isCompileThread( _isCompileThread ) {}
+		virtual void run();
+	private:
+		TilePager *pager;
+		bool isCompileThread;
+	};
+	friend class WorkerThread;
+	
+	//! not a RefPtr; the terrain owns the imp that owns this pager
+	mpv::Terrain *terrain;
+	Config config;
+	
+	osg::ref_ptr<osg::Group> root;
+	
+	// The following are only used by the kernel thread
+	
+	std::map<TileKey, ResidentTile> resident;
+	//! tiles whose files couldn't be read
+	std::set<TileKey> missing;
+	//! visible tiles that weren't resident when they became visible
+	std::set<TileKey> lateTiles;
+	unsigned int frameNumber;
+	bool visibleSetResident;
+	//! set once the first visible set has been loaded
+	bool primed;
+	Counters counters;
+	
+	// The following are shared with the threads, and protected by mutex
+	
+	OpenThreads::Mutex mutex;
+	//! requested tiles, sorted so that the most important is at the back
+	std::vector<TileKey> requests;
+	//! tiles taken from requests and not yet attached
+	std::set<TileKey> inFlight;
+	std::deque<LoadedTile> compileQueue;
+	std::deque<LoadedTile> mergeQueue;
+	OpenThreads::Condition requestCondition;
+	OpenThreads::Condition compileCondition;
+	bool stopping;
+	
+	std::vector<WorkerThread *> threads;
+};
+
+#endif
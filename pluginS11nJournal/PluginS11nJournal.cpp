@@ -0,0 +1,146 @@
+/** <pre>
+ *  MPV Serialization Journal plugin
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#include "PluginS11nJournal.h"
+#include "Log.h"
+
+using namespace mpv;
+using namespace mpvs11n;
+
+EXPORT_DYNAMIC_CLASS( PluginS11nJournal )
+
+// ================================================
+// PluginS11nJournal
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+PluginS11nJournal::PluginS11nJournal() : Plugin()
+{
+	name_ = "PluginS11nJournal";
+
+	licenseInfo_.setLicense( LicenseInfo::LicenseLGPL );
+	licenseInfo_.setOrigin( "Community" );
+
+	dependencies_.push_back( "PluginDefFileReader" );
+	dependencies_.push_back( "PluginS11nRoot" );
+
+	DefFileData = NULL;
+	rootNode = NULL;
+	timeElapsedLastFrame = NULL;
+
+	filename = "mpv_state.journal";
+	keyframeInterval = 600;
+
+	frame = 0;
+	time = 0.0;
+}
+
+
+// ================================================
+// ~PluginS11nJournal
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+PluginS11nJournal::~PluginS11nJournal() throw()
+{
+	writer.close();
+}
+
+
+// ================================================
+// act
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginS11nJournal::act( SystemState::ID state, StateContext &stateContext )
+{
+	switch( state )
+	{
+	case SystemState::BlackboardRetrieve:
+		
+		bb_->get( "DefinitionData", DefFileData );
+		bb_->get( "SerializationRootNode", rootNode );
+		bb_->get( "TimeElapsedLastFrame", timeElapsedLastFrame );
+		break;
+
+	case SystemState::ConfigurationProcess:
+		processConfigData();
+		break;
+
+	case SystemState::Reset:
+	case SystemState::Standby:
+	case SystemState::DatabaseLoad:
+	case SystemState::Operate:
+	case SystemState::Debug:
+		if( writer.isOpen() )
+		{
+			frame++;
+			if( timeElapsedLastFrame != NULL )
+				time += *timeElapsedLastFrame;
+			writer.endFrame( frame, time );
+		}
+		break;
+
+	case SystemState::Shutdown:
+		writer.close();
+		break;
+
+	default:
+		break;
+	}
+	
+}
+
+
+// ================================================
+// processConfigData
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginS11nJournal::processConfigData()
+{
+	DefFileGroup *root = ( DefFileData != NULL ) ? *DefFileData : NULL;
+	DefFileGroup *group = 
+		( root != NULL ) ? root->getGroupByURI( "/s11n_journal/" ) : NULL;
+	if( group != NULL )
+	{
+		DefFileAttrib *attr;
+
+		attr = group->getAttribute( "filename" );
+		if( attr )
+			filename = attr->asString();
+
+		attr = group->getAttribute( "keyframe_interval" );
+		if( attr )
+			keyframeInterval = attr->asInt();
+	}
+
+	// the configuration may be reprocessed; only start the journal once
+	if( writer.isOpen() || rootNode == NULL )
+		return;
+
+	if( !writer.open( filename, keyframeInterval ) )
+	{
+		MPV_LOG_ERROR( "PluginS11nJournal - could not create journal file \"" 
+			<< filename << "\"; the s11n tree will not be recorded" );
+		return;
+	}
+
+	writer.attach( rootNode );
+}
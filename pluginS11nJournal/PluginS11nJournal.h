@@ -0,0 +1,104 @@
+/** <pre>
+ *  MPV Serialization Journal plugin
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#ifndef _PLUGINS11NJOURNAL_H_
+#define _PLUGINS11NJOURNAL_H_
+
+#include <string>
+
+#include "Plugin.h"
+#include "DefFileGroup.h"
+
+#include "GroupNode.h"
+#include "JournalWriter.h"
+
+
+//=========================================================
+//! Records the s11n node tree to a journal file every frame, for 
+//! post-mission debrief.  Only the nodes that changed during a frame are 
+//! written, with a keyframe of the whole tree every so often, and the 
+//! writing happens on a background thread.  See mpvs11n::JournalReader 
+//! and utils/s11nJournalDump for the reading side.
+//! 
+class PluginS11nJournal : public Plugin 
+{
+public:
+	//=========================================================
+	//! General Constructor
+	//! 
+	PluginS11nJournal();
+
+protected:
+	//=========================================================
+	//! General Destructor
+	//! 
+	virtual ~PluginS11nJournal() throw();
+	
+public:
+	//=========================================================
+	//! The per-frame processing that this plugin performs.
+	//! This plugin's act() ends a journal frame in every state that 
+	//! follows configuration.
+	//! \param state - The current system state
+	//! \param stateContext - an object containing all the variables which 
+	//!     influence state transitions
+	//!
+	virtual void act( SystemState::ID state, StateContext &stateContext );
+	
+	
+private:
+
+	void processConfigData();
+
+	//=========================================================
+	//! The config data.
+	//! Retrieved from the blackboard.
+	//!
+	DefFileGroup **DefFileData;
+
+	//=========================================================
+	//! The root node of the serialization tree.
+	//! Retrieved from the blackboard.
+	//!
+	mpvs11n::GroupNode *rootNode;
+
+	//=========================================================
+	//! The length of the last frame, in seconds.
+	//! Retrieved from the blackboard.
+	//! 
+	double *timeElapsedLastFrame;
+
+	mpvs11n::JournalWriter writer;
+
+	std::string filename;
+	int keyframeInterval;
+
+	unsigned int frame;
+	double time;
+};
+
+#endif
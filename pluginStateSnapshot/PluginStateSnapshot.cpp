@@ -0,0 +1,284 @@
+/** <pre>
+ *  MPV State Snapshot plugin
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#include "PluginStateSnapshot.h"
+#include "Entity.h"
+#include "Symbol.h"
+#include "Log.h"
+
+using namespace mpv;
+
+EXPORT_DYNAMIC_CLASS( PluginStateSnapshot )
+
+// ================================================
+// PluginStateSnapshot
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+PluginStateSnapshot::PluginStateSnapshot() : Plugin()
+{
+	name_ = "PluginStateSnapshot";
+
+	licenseInfo_.setLicense( LicenseInfo::LicenseLGPL );
+	licenseInfo_.setOrigin( "Community" );
+
+	dependencies_.push_back( "PluginDefFileReader" );
+	dependencies_.push_back( "PluginEntityMgr" );
+	dependencies_.push_back( "PluginViewMgr" );
+	dependencies_.push_back( "PluginSymbologyMgr" );
+
+	DefFileData = NULL;
+	allEntities = NULL;
+	viewMap = NULL;
+	symbols = NULL;
+	timeElapsedLastFrame = NULL;
+
+	sharedMemoryName = "/mpv_state";
+	maxEntities = 4096;
+	maxViews = 32;
+	maxSymbols = 4096;
+
+	frame = 0;
+	time = 0.0;
+	warnedOverflow = false;
+}
+
+
+// ================================================
+// ~PluginStateSnapshot
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+PluginStateSnapshot::~PluginStateSnapshot() throw()
+{
+}
+
+
+// ================================================
+// act
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginStateSnapshot::act( SystemState::ID state, StateContext &stateContext )
+{
+	switch( state )
+	{
+	case SystemState::BlackboardRetrieve:
+		
+		bb_->get( "DefinitionData", DefFileData );
+		bb_->get( "AllEntities", allEntities );
+		bb_->get( "ViewMap", viewMap );
+		bb_->get( "Symbols", symbols );
+		bb_->get( "TimeElapsedLastFrame", timeElapsedLastFrame );
+		break;
+
+	case SystemState::ConfigurationProcess:
+		processConfigData();
+		break;
+
+	case SystemState::Reset:
+	case SystemState::Standby:
+	case SystemState::DatabaseLoad:
+	case SystemState::Operate:
+	case SystemState::Debug:
+		publish( state );
+		break;
+
+	case SystemState::Shutdown:
+		writer.close();
+		break;
+
+	default:
+		break;
+	}
+	
+}
+
+
+// ================================================
+// processConfigData
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginStateSnapshot::processConfigData()
+{
+	DefFileGroup *root = ( DefFileData != NULL ) ? *DefFileData : NULL;
+	DefFileGroup *group = 
+		( root != NULL ) ? root->getGroupByURI( "/state_snapshot/" ) : NULL;
+	if( group != NULL )
+	{
+		DefFileAttrib *attr;
+
+		attr = group->getAttribute( "shared_memory_name" );
+		if( attr )
+			sharedMemoryName = attr->asString();
+
+		attr = group->getAttribute( "max_entities" );
+		if( attr )
+			maxEntities = attr->asInt();
+
+		attr = group->getAttribute( "max_views" );
+		if( attr )
+			maxViews = attr->asInt();
+
+		attr = group->getAttribute( "max_symbols" );
+		if( attr )
+			maxSymbols = attr->asInt();
+	}
+
+	// the configuration may be reprocessed; only create the segment once
+	if( writer.isOpen() )
+		return;
+
+	if( !writer.create( sharedMemoryName, maxEntities, maxViews, maxSymbols ) )
+	{
+		MPV_LOG_ERROR( "PluginStateSnapshot - could not create shared memory segment \"" 
+			<< sharedMemoryName << "\"; no state snapshots will be published" );
+	}
+}
+
+
+// ================================================
+// publish
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginStateSnapshot::publish( SystemState::ID state )
+{
+	if( !writer.isOpen() )
+		return;
+
+	frame++;
+	if( timeElapsedLastFrame != NULL )
+		time += *timeElapsedLastFrame;
+
+	writer.beginFrame( frame, time, (int)state );
+
+	if( allEntities != NULL )
+	{
+		EntityContainer::EntityIteratorPair iterPair = allEntities->getEntities();
+		for( EntityContainer::EntityMap::iterator iter = iterPair.first; 
+			iter != iterPair.second; iter++ )
+		{
+			Entity *entity = iter->second.get();
+			// when the snapshot is full, keep going, so that the writer 
+			// counts every record left out
+			SnapshotEntity *record = writer.addEntity();
+			if( record == NULL )
+				continue;
+
+			const CoordinateSet &position = entity->getPositionGDC();
+			record->position[0] = position.LatX;
+			record->position[1] = position.LonY;
+			record->position[2] = position.AltZ;
+			record->orientation[0] = position.Yaw;
+			record->orientation[1] = position.Pitch;
+			record->orientation[2] = position.Roll;
+			record->id = entity->getID();
+			record->type = entity->getType();
+			record->parentID = entity->getParentID();
+			record->state = entity->getState();
+			record->alpha = entity->getAlpha();
+			record->groundClamp = entity->getGroundClampState();
+			record->flags = 
+				( entity->getIsChild() ? SnapshotEntity::IsChild : 0 ) | 
+				( entity->getInheritAlpha() ? SnapshotEntity::InheritAlpha : 0 ) | 
+				( entity->getCollisionDetectionEnabled() ? 
+					SnapshotEntity::CollisionDetectionEnabled : 0 );
+		}
+	}
+
+	if( viewMap != NULL )
+	{
+		std::map< int, RefPtr<View> >::iterator iter;
+		for( iter = viewMap->begin(); iter != viewMap->end(); iter++ )
+		{
+			View *view = iter->second.get();
+			SnapshotView *record = writer.addView();
+			if( record == NULL )
+				continue;
+
+			record->id = view->getID();
+			record->groupID = view->getGroupID();
+			record->entityID = view->getEntityID();
+			record->type = view->getType();
+			record->fov[0] = view->getFovLeft();
+			record->fov[1] = view->getFovRight();
+			record->fov[2] = view->getFovTop();
+			record->fov[3] = view->getFovBottom();
+			record->nearPlane = view->getNearPlane();
+			record->farPlane = view->getFarPlane();
+			Vect3 offset = view->getViewOffset();
+			Vect3 rotate = view->getViewRotate();
+			for( int i = 0; i < 3; i++ )
+			{
+				record->offset[i] = offset[i];
+				record->rotate[i] = rotate[i];
+			}
+			record->viewport[0] = view->getViewportLeft();
+			record->viewport[1] = view->getViewportTop();
+			record->viewport[2] = view->getViewportWidth();
+			record->viewport[3] = view->getViewportHeight();
+			record->mirrorMode = view->getMirrorMode();
+			record->parallelProjection = view->getParallelProjection() ? 1 : 0;
+		}
+	}
+
+	if( symbols != NULL )
+	{
+		SymbolContainer::SymbolIteratorPair iterPair = symbols->getSymbols();
+		for( SymbolContainer::SymbolMap::iterator iter = iterPair.first; 
+			iter != iterPair.second; iter++ )
+		{
+			Symbol *symbol = iter->second.get();
+			SnapshotSymbol *record = writer.addSymbol();
+			if( record == NULL )
+				continue;
+
+			Vect2 position = symbol->getPosition();
+			Vect2 scale = symbol->getScale();
+			Vect4 color = symbol->getColor();
+			record->position[0] = position[0];
+			record->position[1] = position[1];
+			record->scale[0] = scale[0];
+			record->scale[1] = scale[1];
+			record->rotation = symbol->getRotation();
+			for( int i = 0; i < 4; i++ )
+				record->color[i] = color[i];
+			record->id = symbol->getID();
+			record->parentID = symbol->getParentID();
+			record->surfaceID = symbol->getSurfaceID();
+			record->type = symbol->getType();
+			record->state = symbol->getState();
+			record->layer = symbol->getLayer();
+			record->flags = 
+				( symbol->getIsChild() ? SnapshotSymbol::IsChild : 0 ) | 
+				( symbol->getInheritColor() ? SnapshotSymbol::InheritColor : 0 ) | 
+				( symbol->getFlashState() ? SnapshotSymbol::FlashOn : 0 );
+		}
+	}
+
+	writer.publish();
+
+	if( writer.getOverflowCount() > 0 && !warnedOverflow )
+	{
+		MPV_LOG_WARNING( "PluginStateSnapshot - snapshot is full; " 
+			<< writer.getOverflowCount() << " records were left out.  "
+			"Raise max_entities, max_views or max_symbols." );
+		warnedOverflow = true;
+	}
+}
@@ -0,0 +1,127 @@
+/** <pre>
+ *  MPV State Snapshot plugin
+ *  Copyright (c) 2026
+ *  
+ *  This component is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; specifically 
+ *  version 2.1 of the License.
+ *  
+ *  This software is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this software; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *  
+ *  
+ *  2026-10-19
+ *      Initial release
+ *  
+ *  
+ *  </pre>
+ */
+
+
+#ifndef _PLUGINSTATESNAPSHOT_H_
+#define _PLUGINSTATESNAPSHOT_H_
+
+#include <map>
+#include <string>
+
+#include "RefPtr.h"
+#include "Plugin.h"
+#include "DefFileGroup.h"
+#include "EntityContainer.h"
+#include "SymbolContainer.h"
+#include "View.h"
+#include "StateSnapshot.h"
+
+
+//=========================================================
+//! Publishes a compact binary snapshot of the entity, view and symbol 
+//! state to a shared memory segment every frame, for external monitoring 
+//! tools.  Unlike the serialization (s11n) plugins, nothing is converted 
+//! to strings and no signals are connected; the plugin simply copies 
+//! fixed-size records once per frame.  See mpv::StateSnapshotReader and 
+//! utils/stateSnapshotDump for the reading side.
+//! 
+class PluginStateSnapshot : public Plugin 
+{
+public:
+	//=========================================================
+	//! General Constructor
+	//! 
+	PluginStateSnapshot();
+
+protected:
+	//=========================================================
+	//! General Destructor
+	//! 
+	virtual ~PluginStateSnapshot() throw();
+	
+public:
+	//=========================================================
+	//! The per-frame processing that this plugin performs.
+	//! This plugin's act() publishes a snapshot in every state that 
+	//! follows configuration.
+	//! \param state - The current system state
+	//! \param stateContext - an object containing all the variables which 
+	//!     influence state transitions
+	//!
+	virtual void act( SystemState::ID state, StateContext &stateContext );
+	
+	
+private:
+
+	void processConfigData();
+
+	void publish( SystemState::ID state );
+
+	//=========================================================
+	//! The config data.
+	//! Retrieved from the blackboard.
+	//!
+	DefFileGroup **DefFileData;
+
+	//=========================================================
+	//! An entity container, containing all the entities.  
+	//! Retrieved from the blackboard.
+	//! 
+	mpv::EntityContainer *allEntities;
+
+	//=========================================================
+	//! The views.  
+	//! Retrieved from the blackboard.
+	//! 
+	std::map< int, mpv::RefPtr<mpv::View> > *viewMap;
+
+	//=========================================================
+	//! The symbols.  
+	//! Retrieved from the blackboard.
+	//! 
+	mpv::SymbolContainer *symbols;
+
+	//=========================================================
+	//! The length of the last frame, in seconds.
+	//! Retrieved from the blackboard.
+	//! 
+	double *timeElapsedLastFrame;
+
+	mpv::StateSnapshotWriter writer;
+
+	std::string sharedMemoryName;
+	int maxEntities;
+	int maxViews;
+	int maxSymbols;
+
+	unsigned int frame;
+	double time;
+	
+	//! set once the overflow warning has been logged, to avoid repeats
+	bool warnedOverflow;
+};
+
+#endif
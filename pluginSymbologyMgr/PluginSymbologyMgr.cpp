@@ -50,6 +50,7 @@
 #include <CigiSymbolLineDefV3_3.h>
 #include <CigiSymbolCloneV3_3.h>
 
+#include "Log.h"
 #include "PluginSymbologyMgr.h"
 #include "SymbolText.h"
 #include "SymbolCircle.h"
@@ -306,7 +307,7 @@ void PluginSymbologyMgr::addSymbolSurface( SymbolSurface *surface )
 	if( surface == NULL )
 		return;
 	
-std::cerr << "PluginSymbologyMgr::addSymbolSurface\n";
+	MPV_LOG_DEBUG( "PluginSymbologyMgr::addSymbolSurface - surface " << surface->getID() );
 	// It is important that this is called (and the resulting 
 	// SymbolSurfaceContainer::addedSymbolSurface signal is emitted) before 
 	// the surface is added to the View or Entity container.  Doing so 
@@ -324,15 +325,15 @@ void PluginSymbologyMgr::attachSymbolSurface( SymbolSurface *surface )
 	if( surface == NULL )
 		return;
 	
-std::cerr << "PluginSymbologyMgr::attachSymbolSurface - surface " << surface->getID() << "\n";
+	MPV_LOG_DEBUG( "PluginSymbologyMgr::attachSymbolSurface - surface " << surface->getID() );
 
 	SymbolSurfaceContainer *container = getSurfaceContainer( surface );
 
 	// add surface to the entity or view that it is associated with
 	if( container == NULL )
-		std::cerr << "Error - when attaching symbol surface " 
+		MPV_LOG_ERROR( "when attaching symbol surface " 
 			<< surface->getID() 
-			<< ", could not find symbol container to attach to\n";
+			<< ", could not find symbol container to attach to" );
 	else
 		container->addSymbolSurface( surface );
 	
@@ -347,15 +348,15 @@ void PluginSymbologyMgr::detachSymbolSurface( SymbolSurface *surface )
 	if( surface == NULL )
 		return;
 	
-std::cerr << "PluginSymbologyMgr::detachSymbolSurface - surface " << surface->getID() << "\n";
+	MPV_LOG_DEBUG( "PluginSymbologyMgr::detachSymbolSurface - surface " << surface->getID() );
 
 	SymbolSurfaceContainer *container = getSurfaceContainer( surface );
 	
 	// remove surface from the entity or view that it is associated with
 	if( container == NULL )
-		std::cerr << "Error - when detaching symbol surface " 
+		MPV_LOG_ERROR( "when detaching symbol surface " 
 			<< surface->getID() 
-			<< ", could not find symbol container to detach from\n";
+			<< ", could not find symbol container to detach from" );
 	else
 		container->removeSymbolSurface( surface );
 	
@@ -379,9 +380,9 @@ SymbolSurfaceContainer *PluginSymbologyMgr::getSurfaceContainer( SymbolSurface *
 		else
 		{
 			// error - entity not found
-			std::cerr << "Error - for symbol surface " 
+			MPV_LOG_ERROR( "for symbol surface " 
 				<< surface->getID() << ", could not find entity " 
-				<< surface->getEntityID() << "\n";
+				<< surface->getEntityID() );
 		}
 	}
 	else if( surface->getAttachState() == SymbolSurface::View )
@@ -394,9 +395,9 @@ SymbolSurfaceContainer *PluginSymbologyMgr::getSurfaceContainer( SymbolSurface *
 		else
 		{
 			// error - view not found
-			std::cerr << "Error - for symbol surface " 
+			MPV_LOG_ERROR( "for symbol surface " 
 				<< surface->getID() << ", could not find view " 
-				<< surface->getViewID() << "\n";
+				<< surface->getViewID() );
 		}
 	}
 
@@ -479,12 +480,12 @@ void PluginSymbologyMgr::cloneSymbol(
 	}
 	else
 	{
-		std::cout << "PluginSymbologyMgr - warning - could not find "
+		MPV_LOG_WARNING( "PluginSymbologyMgr - could not find "
 			<< ( sourceIsIGDefined ? "IG-defined" : "existing" )
 			<< " symbol " << sourceID
-			<< "\n\twhen processing SymbolCloneDefinition for symbol " 
+			<< " when processing SymbolCloneDefinition for symbol " 
 			<< destinationID 
-			<< "\n\tDiscarding packet.\n";
+			<< "; discarding packet" );
 	}
 }
 
@@ -621,6 +622,8 @@ void PluginSymbologyMgr::SymbologyCtrlP::OnPacketReceived( CigiBasePacket *Packe
 	if( !symbol.valid() )
 	{
 		// error - symbol not found
+		MPV_LOG_WARNING( "in SymbologyCtrlP::OnPacketReceived() - symbol " 
+			<< symbolCtrl->GetSymbolID() << " doesn't exist" );
 		return;
 	}
 	
@@ -805,6 +808,8 @@ void PluginSymbologyMgr::ShortSymbologyCtrlP::OnPacketReceived( CigiBasePacket *
 	if( !symbol.valid() )
 	{
 		// error - symbol not found
+		MPV_LOG_WARNING( "in ShortSymbologyCtrlP::OnPacketReceived() - symbol " 
+			<< symbolCtrl->GetSymbolID() << " doesn't exist" );
 		return;
 	}
 	
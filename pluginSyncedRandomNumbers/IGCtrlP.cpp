@@ -31,6 +31,10 @@
  *  
  *  04/04/2004 ...                       MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Passes the frame number to an mpv::SyncedRandom
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -50,7 +54,7 @@
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 SyncRNIGCtrlP::SyncRNIGCtrlP()
 {
-	framenum = NULL;
+	syncedRandom = NULL;
 }
 
 // ================================================
@@ -69,12 +73,9 @@ void SyncRNIGCtrlP::OnPacketReceived(CigiBasePacket *Packet)
 {
 	CigiIGCtrlV3_2 *igc = (CigiIGCtrlV3_2 *)(Packet);
 	
-	if( framenum ) 
+	if( syncedRandom ) 
 	{
-		*framenum = igc->GetFrameCntr();
-//		std::cout << "frame: " << *framenum << std::endl;
+		syncedRandom->setFrameNumber( igc->GetFrameCntr() );
 	}
-	
-	
 }
 
@@ -31,6 +31,10 @@
  *  
  *  04/04/2004 ...                       MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Passes the frame number to an mpv::SyncedRandom
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -45,6 +49,7 @@
 #endif // _MSC_VER > 1000
 
 #include "AllCigi.h"
+#include "RandomStream.h"
 
 
 
@@ -74,10 +79,10 @@ public:
 
 
 	//=========================================================
-	//! Initializes the pointer to the current frame number
-	//! \param dn - The pointer to the current frame number.
+	//! Sets the object to pass the host's frame number to
+	//! \param sr - The synced random number source.
 	//!
-	void setFrameNumber( unsigned int *fn ) { framenum = fn; }
+	void setSyncedRandom( mpv::SyncedRandom *sr ) { syncedRandom = sr; }
 
 	//=========================================================
 	//! The callback handler for the CIGI ig control packet
@@ -89,9 +94,9 @@ private:
 	
 
 	//=========================================================
-	//! A pointer to the current frame number
+	//! Receives the current frame number
 	//!
-	unsigned int *framenum;
+	mpv::SyncedRandom *syncedRandom;
 	
 
 };
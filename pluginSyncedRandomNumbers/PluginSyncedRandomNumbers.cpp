@@ -35,6 +35,11 @@
  *  2007-07-21 Andrew Sampson
  *      Changed interface to use new state machine API
  *
+ *  2026-10-19
+ *      Posts an mpv::SyncedRandom ("SyncedRandom"), which hands out 
+ *      independent counter-based streams.  RandomNumberGenerator is 
+ *      still posted, but is now built on top of it.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -58,10 +63,9 @@ PluginSyncedRandomNumbers::PluginSyncedRandomNumbers() : Plugin()
 	licenseInfo_.setOrigin( "Boeing" );
 
 	ImsgPtr = NULL;
-	frameNumber = 0;
 	
-	igCtrlP.setFrameNumber( &frameNumber );
-	randGen.setSeed( &frameNumber );
+	igCtrlP.setSyncedRandom( &syncedRandom );
+	randGen.setSyncedRandom( &syncedRandom );
 	randGenMax = MPV_RAND_MAX;
 }
 
@@ -84,6 +88,7 @@ void PluginSyncedRandomNumbers::act( SystemState::ID state, StateContext &stateC
 	case SystemState::BlackboardPost:
 		// This state is for posting things to the blackboard and other 
 		// initialization tasks
+		bb_->put( "SyncedRandom", &syncedRandom );
 		bb_->put( "RandomNumberGenerator", &randGen );
 		bb_->put( "RandomNumberGeneratorMax", &randGenMax );
 		break;
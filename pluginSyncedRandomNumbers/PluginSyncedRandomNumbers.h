@@ -35,6 +35,11 @@
  *  2007-07-21 Andrew Sampson
  *      Changed interface to use new state machine API
  *
+ *  2026-10-19
+ *      Posts an mpv::SyncedRandom ("SyncedRandom"), which hands out 
+ *      independent counter-based streams.  RandomNumberGenerator is 
+ *      still posted, but is now built on top of it.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -95,12 +100,14 @@ private:
 	SyncRNIGCtrlP igCtrlP;
 	
 	//=========================================================
-	//! The current frame number, as reported by the host
+	//! Knows the current frame number, as reported by the host, and 
+	//! hands out random streams for it.  Posted to the blackboard.
 	//!
-	unsigned int frameNumber;
+	mpv::SyncedRandom syncedRandom;
 	
 	//=========================================================
-	//! Our synced random number generator.  Posted to the blackboard.
+	//! The old synced random number generator, kept for plugins that 
+	//! still use it.  Posted to the blackboard.
 	//!
 	RandGenerateID randGen;
 	
@@ -31,6 +31,12 @@
  *  
  *  05/10/2004 Andrew Sampson							  MPV_CR_DR_1
  *  Initial Release.
+ *
+ *  2026-10-19
+ *      Now a thin wrapper around an mpv::RandomStream.  Kept for plugins 
+ *      that still use the GenerateID interface; new code should use 
+ *      the "SyncedRandom" blackboard entry instead.
+ *
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -40,66 +46,53 @@
 #define RAND_GENERATE_ID_H
 
 #include "GenerateID.h"
+#include "RandomStream.h"
 
 #define MPV_RAND_MAX 2147483647
 
+//=========================================================
+//! Deprecated.  Adapts SyncedRandom to the GenerateID interface.  All 
+//! users share one stream, so the values each one gets depend on how 
+//! many the others drew first, and GetNextID is not thread safe.  Use 
+//! the "SyncedRandom" blackboard entry and a stream of your own instead.
+//!
 class RandGenerateID : public GenerateID
 {
 public:
 	RandGenerateID() : GenerateID() 
 	{
-		seed = NULL;
-		prevSeed = 0;
-		lastRandNum = 0;
+		syncedRandom = NULL;
+		prevFrame = 0;
+		streamID = mpv::SyncedRandom::getStreamID( "RandGenerateID" );
 	}
 	
 	virtual int GetNextID(std::string Type)
 	{
-//std::cout << "hello, this is randgenid" << std::endl;
-		if( !seed ) return 0;
-//std::cout << "hello, this is randgenid " << __LINE__ << " seed " << *seed << " lastrandnum " << lastRandNum <<  std::endl;
-		if( *seed != prevSeed )
+		if( !syncedRandom ) return 0;
+		
+		// The counter is only reset when the frame number changes, so a 
+		// stalled host doesn't make every frame draw the same values
+		unsigned int frame = syncedRandom->getFrameNumber();
+		if( frame != prevFrame )
 		{
-//std::cout << "hello, this is randgenid " << __LINE__ << " seed " << *seed << " lastrandnum " << lastRandNum <<  std::endl;
-			lastRandNum = randFirst( *seed );
-			prevSeed = *seed;
-//std::cout << "hello, this is randgenid " << __LINE__ << " seed " << *seed << " lastrandnum " << lastRandNum <<  std::endl;
+			stream = syncedRandom->getStream( streamID, frame );
+			prevFrame = frame;
 		}
-		else 
-		{
-//std::cout << "hello, this is randgenid " << __LINE__ << " seed " << *seed << " lastrandnum " << lastRandNum <<  std::endl;
-			lastRandNum = randSubsequent( lastRandNum );
-//std::cout << "hello, this is randgenid " << __LINE__ << " seed " << *seed << " lastrandnum " << lastRandNum <<  std::endl;
-		}
-//std::cout << "hello, this is randgenid " << __LINE__ << " seed " << *seed << " lastrandnum " << lastRandNum <<  std::endl;
-		return lastRandNum;
+		return (int)( stream.next() & MPV_RAND_MAX );
 	}
 	
-	void setSeed( unsigned int *s ) { seed = s; }
-	
-private:
-	unsigned int *seed;
-	unsigned int prevSeed;
-	int lastRandNum;
-	
-	int randFirst( int input )
-	{
-
-		int r = (( (16807 * input) + 0 ) % MPV_RAND_MAX);
-
-		((unsigned char*)(&r))[3] = ((unsigned char*)(&r))[0];
-
-		return r;
-	}
-
-	int randSubsequent( int input )
+	void setSyncedRandom( const mpv::SyncedRandom *s ) 
 	{
-		int r = (( (16807 * input) + 0 ) % MPV_RAND_MAX);
-		return r;
+		syncedRandom = s;
+		prevFrame = s ? s->getFrameNumber() : 0;
+		if( s ) stream = s->getStream( streamID, prevFrame );
 	}
-
 	
+private:
+	const mpv::SyncedRandom *syncedRandom;
+	unsigned int prevFrame;
+	unsigned int streamID;
+	mpv::RandomStream stream;
 };
 
 #endif
-
@@ -23,6 +23,10 @@
  *      Renamed plugin from PluginDatabaseMgr to PluginTerrainMgr.  Modified 
  *      to make use of Terrain class instead of old DatabaseParams class.
  *  
+ *  2026-10-19
+ *      Added preloading of likely-next databases within a memory budget, 
+ *      so that switching to one is immediate.
+ *  
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -30,9 +34,12 @@
 
 
 #include <iostream>
+#include <set>
+#include <sstream>
 
 #include "PluginTerrainMgr.h"
 #include "MPVExceptions.h"
+#include "Log.h"
 
 
 using namespace mpv;
@@ -43,7 +50,8 @@ EXPORT_DYNAMIC_CLASS( PluginTerrainMgr )
 // PluginTerrainMgr
 // vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 PluginTerrainMgr::PluginTerrainMgr() : Plugin(),
-	terrainDatabases( new TerrainContainer() )
+	terrainDatabases( new TerrainContainer() ),
+	preloadHintProc( this )
 {
 	name_ = "PluginTerrainMgr";
 	licenseInfo_.setLicense( LicenseInfo::LicenseGPL );
@@ -56,8 +64,16 @@ PluginTerrainMgr::PluginTerrainMgr() : Plugin(),
 	ReportedDatabaseNumber = NULL;
 	DefaultDatabaseNumber = NULL;
 	DefinitionData = NULL;
+	ImsgPtr = NULL;
+	timeElapsedLastFrame = NULL;
 	
 	isDatabaseLoadTransitionPending = false;
+
+	preloadBudget = 0;
+	preloadHintComponentID = -1;
+	preloadingID = -1;
+	preloadReportInterval = 60.0f;
+	timeSinceReport = 0.0;
 }
 
 
@@ -94,6 +110,15 @@ void PluginTerrainMgr::act( SystemState::ID state, StateContext &stateContext )
 
 		bb_->get( "DefinitionData", DefinitionData );
 
+		bb_->get( "TimeElapsedLastFrame", timeElapsedLastFrame );
+
+		bb_->get( "CigiIncomingMsg", ImsgPtr );
+		if( ImsgPtr != NULL )
+		{
+			ImsgPtr->RegisterEventProcessor( CIGI_COMP_CTRL_PACKET_ID_V3_3,
+				(CigiBaseEventProcessor *) &preloadHintProc );
+		}
+
 		break;
 
 	case SystemState::ConfigurationProcess:
@@ -102,10 +127,12 @@ void PluginTerrainMgr::act( SystemState::ID state, StateContext &stateContext )
 	
 	case SystemState::Reset:
 		*CommandedDatabaseNumber = *DefaultDatabaseNumber;
+		hintedPreloads.clear();
 		if( currentTerrain.valid() )
 		{
-			// unload the terrain
-			currentTerrain->unload();
+			// unload the terrain (or keep it in memory, if it's a 
+			// preload candidate)
+			releaseCurrentTerrain();
 			currentTerrain = NULL;
 		}
 		*LoadedDatabaseNumber = -128;
@@ -115,6 +142,9 @@ void PluginTerrainMgr::act( SystemState::ID state, StateContext &stateContext )
 	case SystemState::Operate:
 	case SystemState::Debug:
 
+		terrainDatabases->updateTerrains( *timeElapsedLastFrame );
+		updatePreloads();
+
 		*ReportedDatabaseNumber = *LoadedDatabaseNumber;
 
 		// FIXME - The CIGI standard states that the Host can force a database 
@@ -197,7 +227,7 @@ void PluginTerrainMgr::act( SystemState::ID state, StateContext &stateContext )
 			if( currentTerrain.valid() )
 			{
 				// unload the previous terrain
-				currentTerrain->unload();
+				releaseCurrentTerrain();
 			}
 			
 			// retrieve the commanded terrain and make it current
@@ -215,20 +245,26 @@ void PluginTerrainMgr::act( SystemState::ID state, StateContext &stateContext )
 			}
 			
 			std::cout << "PluginTerrainMgr - about to load terrain database \""
-				<< currentTerrain->getName() << "\" (id " << currentTerrain->getID() << ")\n";
-			// begin loading the current terrain
+				<< currentTerrain->getName() << "\" (id " << currentTerrain->getID() << ")"
+				<< ( currentTerrain->isResident() ? "; it is already in memory\n" : "\n" );
+			// begin loading the current terrain; if it was preloaded, this 
+			// just attaches it
 			currentTerrain->load();
 			
 			isDatabaseLoadTransitionPending = false;
 		}
 		else
 		{
+			// attaches the terrain once it has loaded
+			terrainDatabases->updateTerrains( *timeElapsedLastFrame );
+			
 			switch( currentTerrain->getState() )
 			{
 			case Terrain::Loaded:
 				// success
 				*LoadedDatabaseNumber = currentTerrain->getID();
 				stateContext.databaseLoadComplete = true;
+				knownSizes[currentTerrain->getID()] = currentTerrain->getResidentBytes();
 				break;
 			case Terrain::Broken:
 				// fail
@@ -270,6 +306,24 @@ void PluginTerrainMgr::processConfigData()
 		return;
 	}
 
+	DefFileAttrib *attr = databasesGroup->getAttribute( "preload_budget" );
+	if( attr )
+	{
+		float megabytes = attr->asFloat();
+		preloadBudget = ( megabytes > 0.0f ) ? 
+			(size_t)( megabytes * 1024.0f * 1024.0f ) : 0;
+	}
+
+	attr = databasesGroup->getAttribute( "preload_hint_component" );
+	if( attr )
+		preloadHintComponentID = attr->asInt();
+
+	attr = databasesGroup->getAttribute( "preload_report_interval" );
+	if( attr )
+		preloadReportInterval = attr->asFloat();
+
+	configuredPreloads.clear();
+
 	std::list<DefFileGroup*>::iterator dter = databasesGroup->children.begin();
 	for( ; dter != databasesGroup->children.end(); dter++ )
 	{
@@ -324,6 +378,60 @@ void PluginTerrainMgr::handleDatabaseConfigGroup( DefFileGroup *group )
 	if( attr )
 		terrain->setFilename( attr->asString() );
 
+	// tiled databases
+	attr = group->getAttribute( "tile_pattern" );
+	if( attr )
+	{
+		double size = 1000.0;
+		double originX = 0.0, originY = 0.0;
+		int minX = 0, minY = 0, maxX = -1, maxY = -1;
+
+		DefFileAttrib *tileAttr = group->getAttribute( "tile_size" );
+		if( tileAttr )
+			size = tileAttr->asFloat();
+
+		tileAttr = group->getAttribute( "tile_origin" );
+		if( tileAttr )
+		{
+			std::vector<float> origin = tileAttr->asFloats();
+			if( origin.size() >= 2 )
+			{
+				originX = origin[0];
+				originY = origin[1];
+			}
+		}
+
+		tileAttr = group->getAttribute( "tile_range" );
+		if( tileAttr )
+		{
+			std::vector<int> range = tileAttr->asInts();
+			if( range.size() >= 4 )
+			{
+				minX = range[0];
+				minY = range[1];
+				maxX = range[2];
+				maxY = range[3];
+			}
+		}
+
+		if( size <= 0.0 || maxX < minX || maxY < minY )
+		{
+			MPV_LOG_WARNING( "PluginTerrainMgr - in terrain database config for \""
+				<< terrain->getName() << "\" (id " << terrain->getID() << "): "
+				<< "tile_size must be positive and tile_range must list at least "
+				<< "one tile (min x, min y, max x, max y); loading it as a single file" );
+		}
+		else
+		{
+			terrain->setTiling( attr->asString(), size, originX, originY, 
+				minX, minY, maxX, maxY );
+		}
+	}
+
+	attr = group->getAttribute( "preload" );
+	if( attr && attr->asInt() != 0 )
+		configuredPreloads.push_back( id );
+
 	attr = group->getAttribute( "offset" );
 	if( attr )
 	{
@@ -486,3 +594,209 @@ void PluginTerrainMgr::handleCoordSysSpecificParamsLCC( CoordSysParams &coordSys
 }
 
 
+// ================================================
+// releaseCurrentTerrain
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginTerrainMgr::releaseCurrentTerrain()
+{
+	std::list<Terrain*> candidates;
+	getPreloadCandidates( candidates );
+
+	bool isCandidate = false;
+	std::list<Terrain*>::iterator iter;
+	for( iter = candidates.begin(); iter != candidates.end(); iter++ )
+	{
+		if( *iter == currentTerrain.get() )
+			isCandidate = true;
+	}
+
+	// Terrains that aren't candidates are unloaded straight away, so that 
+	// the next terrain doesn't load on top of them.  Candidates that don't 
+	// fit in the budget are evicted by updatePreloads().
+	if( preloadBudget > 0 && isCandidate )
+		currentTerrain->detach();
+	else
+		currentTerrain->unload();
+}
+
+
+// ================================================
+// getPreloadCandidates
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginTerrainMgr::getPreloadCandidates( std::list<Terrain*> &candidates )
+{
+	if( preloadBudget == 0 )
+		return;
+
+	std::list<int> ids( hintedPreloads );
+	ids.insert( ids.end(), configuredPreloads.begin(), configuredPreloads.end() );
+
+	std::set<int> seen;
+	std::list<int>::iterator iter;
+	for( iter = ids.begin(); iter != ids.end(); iter++ )
+	{
+		if( !seen.insert( *iter ).second )
+			continue;
+
+		// databases that the MPV doesn't know about can't be preloaded
+		Terrain *terrain = terrainDatabases->findTerrain( *iter );
+		if( terrain == NULL || terrain == currentTerrain.get() )
+			continue;
+
+		candidates.push_back( terrain );
+	}
+}
+
+
+// ================================================
+// updatePreloads
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginTerrainMgr::updatePreloads()
+{
+	if( preloadBudget == 0 )
+		return;
+
+	if( preloadReportInterval > 0.0f )
+	{
+		timeSinceReport += *timeElapsedLastFrame;
+		if( timeSinceReport >= preloadReportInterval )
+		{
+			reportResidency();
+			timeSinceReport = 0.0;
+		}
+	}
+
+	if( preloadingID != -1 )
+	{
+		Terrain *terrain = terrainDatabases->findTerrain( preloadingID );
+		if( terrain != NULL && terrain->isLoading() )
+			// one at a time
+			return;
+
+		// (if the Host switched to it meanwhile, it was reported as a load)
+		if( terrain != NULL && terrain != currentTerrain.get() )
+		{
+			knownSizes[preloadingID] = terrain->getResidentBytes();
+			MPV_LOG_INFO( "PluginTerrainMgr - preloaded terrain database \"" 
+				<< terrain->getName() << "\" (id " << preloadingID << ") in " 
+				<< terrain->getLoadTime() << " s; " 
+				<< ( terrain->getResidentBytes() / ( 1024.0 * 1024.0 ) ) << " MB" );
+		}
+		preloadingID = -1;
+	}
+
+	std::list<Terrain*> candidates;
+	getPreloadCandidates( candidates );
+
+	// the current terrain always gets its share of the budget
+	size_t used = currentTerrain.valid() ? currentTerrain->getResidentBytes() : 0;
+
+	// keep the resident candidates that fit, most important first
+	std::set<Terrain*> keep;
+	std::list<Terrain*>::iterator iter;
+	for( iter = candidates.begin(); iter != candidates.end(); iter++ )
+	{
+		Terrain *terrain = *iter;
+		if( !terrain->isResident() )
+			continue;
+		size_t bytes = terrain->getResidentBytes();
+		if( used + bytes <= preloadBudget )
+		{
+			used += bytes;
+			keep.insert( terrain );
+		}
+	}
+
+	// evict the rest
+	TerrainContainer::TerrainIteratorPair terrains = terrainDatabases->getTerrains();
+	for( ; terrains.first != terrains.second; terrains.first++ )
+	{
+		Terrain *terrain = terrains.first->second.get();
+		if( terrain == currentTerrain.get() || keep.count( terrain ) || 
+			terrain->isLoading() || terrain->getResidentBytes() == 0 )
+			continue;
+
+		MPV_LOG_INFO( "PluginTerrainMgr - evicting terrain database \"" 
+			<< terrain->getName() << "\" (id " << terrain->getID() << ") from memory" );
+		terrain->unload();
+	}
+
+	// don't compete with the current terrain for the disk
+	if( currentTerrain.valid() && currentTerrain->isLoading() )
+		return;
+
+	// start on the most important candidate that isn't in memory and 
+	// should fit
+	for( iter = candidates.begin(); iter != candidates.end(); iter++ )
+	{
+		Terrain *terrain = *iter;
+		if( terrain->isResident() || terrain->isLoading() )
+			continue;
+
+		std::map< int, size_t >::iterator sizeIter = knownSizes.find( terrain->getID() );
+		if( sizeIter != knownSizes.end() && used + sizeIter->second > preloadBudget )
+			continue;
+
+		MPV_LOG_INFO( "PluginTerrainMgr - preloading terrain database \"" 
+			<< terrain->getName() << "\" (id " << terrain->getID() << ")" );
+		terrain->preload();
+		preloadingID = terrain->getID();
+		break;
+	}
+}
+
+
+// ================================================
+// reportResidency
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginTerrainMgr::reportResidency()
+{
+	int count = 0;
+	size_t total = 0;
+	std::ostringstream details;
+
+	TerrainContainer::TerrainIteratorPair terrains = terrainDatabases->getTerrains();
+	for( ; terrains.first != terrains.second; terrains.first++ )
+	{
+		Terrain *terrain = terrains.first->second.get();
+		size_t bytes = terrain->getResidentBytes();
+		if( bytes == 0 && !terrain->isLoading() )
+			continue;
+
+		details << "\n\t" << terrain->getID() << " \"" << terrain->getName() << "\": ";
+		if( terrain->isLoading() )
+			details << "loading for " << terrain->getLoadTime() << " s";
+		else
+		{
+			details << ( bytes / ( 1024.0 * 1024.0 ) ) << " MB";
+			if( terrain == currentTerrain.get() )
+				details << " (current)";
+			count++;
+			total += bytes;
+		}
+	}
+
+	MPV_LOG_INFO( "PluginTerrainMgr - " << count << " terrain databases in memory, " 
+		<< ( total / ( 1024.0 * 1024.0 ) ) << " MB of a " 
+		<< ( preloadBudget / ( 1024.0 * 1024.0 ) ) << " MB budget" << details.str() );
+}
+
+
+// ================================================
+// PreloadHintProc::OnPacketReceived
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void PluginTerrainMgr::PreloadHintProc::OnPacketReceived( CigiBasePacket *packet )
+{
+	CigiCompCtrlV3_3 *compCtrl = static_cast<CigiCompCtrlV3_3 *>( packet );
+
+	if( plugin->preloadHintComponentID < 0 || 
+		compCtrl->GetCompClassV3() != CigiBaseCompCtrl::GlobalTerrainSurfaceV3 || 
+		compCtrl->GetCompID() != plugin->preloadHintComponentID )
+		return;
+
+	int id = compCtrl->GetLongCompData( 0 );
+
+	plugin->hintedPreloads.remove( id );
+	if( compCtrl->GetCompState() != 0 )
+		plugin->hintedPreloads.push_front( id );
+}
@@ -23,6 +23,10 @@
  *      Renamed plugin from PluginDatabaseMgr to PluginTerrainMgr.  Modified 
  *      to make use of Terrain class instead of old DatabaseParams class.
  *  
+ *  2026-10-19
+ *      Added preloading of likely-next databases within a memory budget, 
+ *      so that switching to one is immediate.
+ *  
  * </pre>
  *  The Boeing Company
  *  1.0
@@ -32,6 +36,8 @@
 #ifndef PLUGIN_TERRAIN_MGR_H
 #define PLUGIN_TERRAIN_MGR_H
 
+#include <list>
+#include <map>
 #include <string>
 
 #include "Plugin.h"
@@ -45,6 +51,15 @@
 //! This plugin initiates database-changes and manages the various 
 //! coordinate-system parameters associated with each database.
 //!
+//! It can also keep databases other than the current one in memory, so 
+//! that switching to them is immediate.  Candidates come from the 
+//! "preload" attribute of the database config groups, and from Host hints 
+//! (Component Control, class Global Terrain Surface, with the configured 
+//! component ID; state 1 adds the database in data word 0 as a candidate, 
+//! 0 withdraws it).  Hinted databases come first, most recent first, then 
+//! the configured ones in config order.  They are loaded one at a time in 
+//! the background, and kept as long as they fit in the memory budget.
+//!
 class PluginTerrainMgr : public Plugin 
 {
 public:
@@ -100,6 +115,17 @@ private:
 	//!
 	DefFileGroup **DefinitionData;
 
+	//=========================================================
+	//! The IncomingMsg pointer.  Retrieved from the blackboard.
+	//!
+	CigiIncomingMsg *ImsgPtr;
+
+	//=========================================================
+	//! The time elapsed during the last frame.  Retrieved from the 
+	//! blackboard.
+	//!
+	double *timeElapsedLastFrame;
+
 
 	//=========================================================
 	//! A terrain container, containing all Terrain objects.  This container 
@@ -118,6 +144,52 @@ private:
 	//! DatabaseLoad state from subsequent frames.  
 	bool isDatabaseLoadTransitionPending;
 
+	//! Memory available for terrains, including the current one, in bytes.  
+	//! 0 disables preloading.
+	size_t preloadBudget;
+
+	//! IDs of the databases marked for preloading in the config, in config 
+	//! order
+	std::list<int> configuredPreloads;
+
+	//! IDs of the databases hinted by the Host, most recent first
+	std::list<int> hintedPreloads;
+
+	//! The component ID for preload hints; -1 if hints aren't accepted
+	int preloadHintComponentID;
+
+	//! The terrain being preloaded, or -1
+	int preloadingID;
+
+	//! The measured size of each terrain that has been loaded, so that a 
+	//! terrain that didn't fit isn't loaded again until it will
+	std::map< int, size_t > knownSizes;
+
+	//! Seconds between residency reports; 0 disables them
+	float preloadReportInterval;
+	double timeSinceReport;
+
+	//=========================================================
+	//! Processes Component Control packets, looking for preload hints
+	//!
+	class PreloadHintProc : public CigiBaseEventProcessor
+	{
+	public:
+
+		PreloadHintProc( PluginTerrainMgr *_plugin )
+			: plugin( _plugin ) {}
+
+		virtual ~PreloadHintProc() {}
+
+		virtual void OnPacketReceived( CigiBasePacket *packet );
+
+	private:
+
+		PluginTerrainMgr *plugin;
+	};
+
+	PreloadHintProc preloadHintProc;
+
 	//=========================================================
 	//! Loads and processes the database specific definition data
 	//!   from the definition data construct
@@ -172,6 +244,29 @@ private:
 	//!
 	void clearAllDatabaseParams();
 
+	//=========================================================
+	//! Takes the current terrain off the display.  It stays in memory if 
+	//! it is a preload candidate, and is unloaded otherwise.
+	//!
+	void releaseCurrentTerrain();
+
+	//=========================================================
+	//! Lists the known terrains that should be kept in memory, most 
+	//! important first.  The current terrain isn't included.
+	//!
+	void getPreloadCandidates( std::list<mpv::Terrain*> &candidates );
+
+	//=========================================================
+	//! Evicts terrains that are no longer candidates or that don't fit in 
+	//! the budget, and starts preloading the next candidate that will
+	//!
+	void updatePreloads();
+
+	//=========================================================
+	//! Logs the resident terrains and their memory use
+	//!
+	void reportResidency();
+
 };
 
 
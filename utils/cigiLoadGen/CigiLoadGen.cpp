@@ -0,0 +1,941 @@
+/** <pre>
+ * MPV CIGI load generator utility
+ * Copyright (c) 2026
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Revision history:
+ *
+ * 2026-10-19
+ *     Initial version.  Structure based on symbologyStress.
+ *
+ * 2026-10-19
+ *     Added entity churn, for measuring the IG's entity creation rate.
+ *
+ */
+
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <CigiHatHotRespV3_2.h>
+#include <CigiHatHotXRespV3_2.h>
+#include <CigiLosRespV3_2.h>
+#include <CigiLosXRespV3_2.h>
+
+#include "CigiRecording.h"
+#include "CigiTransportUDP.h"
+#include "CigiTransportRing.h"
+
+#include "CigiLoadGen.h"
+
+
+using namespace std;
+
+
+// Packet sizes, in bytes, from the CIGI 3.3 ICD.  Used to split each
+// frame into datagrams no larger than maxDatagramSize.
+#define IG_CTRL_SIZE          24
+#define ENTITY_CTRL_SIZE      48
+#define ART_PART_CTRL_SIZE    32
+#define HAT_HOT_REQ_SIZE      32
+#define LOS_VECT_REQ_SIZE     56
+#define SYMBOL_CIRCLE_SIZE    40
+#define SYMBOL_CTRL_SIZE      40
+
+#define SURFACE_ID 0
+
+// each symbol lives for this many frames before it is destroyed
+#define SYMBOL_LIFETIME 10
+
+// each churned entity lives for this many frames before it is removed
+#define CHURN_LIFETIME 30
+
+#define MAX_ENTITY_ID 65535
+
+
+// ================================================
+// LoadGenParams
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+LoadGenParams::LoadGenParams() :
+	articulations( 2 ),
+	children( 1 ),
+	hotRequests( 10 ),
+	losRequests( 10 ),
+	symbolChurn( 0 ),
+	entityChurn( 0 ),
+	churnType( -1 ),
+	framesPerStep( 600 ),
+	entityType( 0 ),
+	maxDatagramSize( 8192 ),
+	originLat( 0.0 ),
+	originLon( 0.0 ),
+	originAlt( 100.0 ),
+	transportType( "udp" ),
+	sharedMemoryName( "/mpv_cigi" ),
+	igAddr( "127.0.0.1" ),
+	igPort( 8004 ),
+	listenPort( 8005 )
+{
+	entityCounts.push_back( 10 );
+	entityCounts.push_back( 100 );
+	entityCounts.push_back( 1000 );
+	entityCounts.push_back( 10000 );
+}
+
+
+static void printUsage( const char *program )
+{
+	cout << "Usage: " << program << " [options]\n"
+		<< "  --entities N[,N...]   entity counts to step through (10,100,1000,10000)\n"
+		<< "  --articulations M     articulated parts per entity (2)\n"
+		<< "  --children C          child entities per entity (1)\n"
+		<< "  --hot K               HOT requests per frame (10)\n"
+		<< "  --los K               LOS requests per frame (10)\n"
+		<< "  --symbols S           symbols destroyed and recreated per frame (0)\n"
+		<< "  --entity-churn E      entities removed and created per frame (0)\n"
+		<< "  --churn-type T        entity type of the churned entities (--entity-type)\n"
+		<< "  --frames F            frames at each entity count (600)\n"
+		<< "  --entity-type T       entity type to create (0)\n"
+		<< "  --datagram-size B     largest datagram to send (8192)\n"
+		<< "  --origin LAT,LON,ALT  center of the entity field (0,0,100)\n"
+		<< "  --transport TYPE      udp or shared_memory (udp)\n"
+		<< "  --shm-name NAME       IG's shared memory segment (/mpv_cigi)\n"
+		<< "  --ig-addr ADDR        IG address (127.0.0.1)\n"
+		<< "  --ig-port PORT        port the IG listens on (8004)\n"
+		<< "  --listen-port PORT    port to receive IG traffic on (8005)\n";
+}
+
+
+// ================================================
+// parse
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool LoadGenParams::parse( int argc, char *argv[] )
+{
+	for( int i = 1; i < argc; i++ )
+	{
+		std::string arg = argv[i];
+		if( arg == "--help" || arg == "-h" || i + 1 >= argc )
+		{
+			printUsage( argv[0] );
+			return false;
+		}
+
+		const char *value = argv[++i];
+		if( arg == "--entities" )
+		{
+			entityCounts.clear();
+			const char *p = value;
+			while( *p )
+			{
+				entityCounts.push_back( atoi( p ) );
+				p = strchr( p, ',' );
+				if( p == NULL )
+					break;
+				p++;
+			}
+		}
+		else if( arg == "--articulations" )
+			articulations = atoi( value );
+		else if( arg == "--children" )
+			children = atoi( value );
+		else if( arg == "--hot" )
+			hotRequests = atoi( value );
+		else if( arg == "--los" )
+			losRequests = atoi( value );
+		else if( arg == "--symbols" )
+			symbolChurn = atoi( value );
+		else if( arg == "--entity-churn" )
+			entityChurn = atoi( value );
+		else if( arg == "--churn-type" )
+			churnType = atoi( value );
+		else if( arg == "--frames" )
+			framesPerStep = atoi( value );
+		else if( arg == "--entity-type" )
+			entityType = atoi( value );
+		else if( arg == "--datagram-size" )
+			maxDatagramSize = atoi( value );
+		else if( arg == "--origin" )
+			sscanf( value, "%lf,%lf,%lf", &originLat, &originLon, &originAlt );
+		else if( arg == "--transport" )
+			transportType = value;
+		else if( arg == "--shm-name" )
+			sharedMemoryName = value;
+		else if( arg == "--ig-addr" )
+			igAddr = value;
+		else if( arg == "--ig-port" )
+			igPort = atoi( value );
+		else if( arg == "--listen-port" )
+			listenPort = atoi( value );
+		else
+		{
+			cout << "Unrecognized option " << arg << endl;
+			printUsage( argv[0] );
+			return false;
+		}
+	}
+
+	// articulated part IDs are 8 bits
+	articulations = std::max( 0, std::min( articulations, 256 ) );
+	children = std::max( 0, children );
+	hotRequests = std::max( 0, hotRequests );
+	losRequests = std::max( 0, losRequests );
+	symbolChurn = std::max( 0, symbolChurn );
+	entityChurn = std::max( 0, entityChurn );
+	if( churnType < 0 )
+		churnType = entityType;
+
+	// churned entities take IDs down from the top of the range; the slots 
+	// are one frame's worth larger than the lifetime, so that an ID is 
+	// never removed and reused in the same frame
+	int churnSlots = entityChurn * ( CHURN_LIFETIME + 1 );
+	if( churnSlots >= MAX_ENTITY_ID / 2 )
+	{
+		cout << "--entity-churn must be less than " 
+			<< MAX_ENTITY_ID / 2 / ( CHURN_LIFETIME + 1 ) << endl;
+		return false;
+	}
+
+	if( maxDatagramSize < 256 )
+	{
+		cout << "--datagram-size must be at least 256 bytes" << endl;
+		return false;
+	}
+
+	// entity IDs are 16 bits, and each entity brings its children
+	int maxEntities = ( MAX_ENTITY_ID - churnSlots ) / ( 1 + children );
+	for( unsigned int i = 0; i < entityCounts.size(); i++ )
+	{
+		if( entityCounts[i] > maxEntities )
+		{
+			cout << "Note - limiting " << entityCounts[i] << " entities to "
+				<< maxEntities << "; entity IDs would overflow" << endl;
+			entityCounts[i] = maxEntities;
+		}
+	}
+
+	return !entityCounts.empty() && framesPerStep > 0;
+}
+
+
+// ================================================
+// clear
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void LoadGenStats::clear()
+{
+	frameTimes.clear();
+	hotLatencies.clear();
+	losLatencies.clear();
+	droppedSOFs = 0;
+	unansweredHOT = 0;
+	unansweredLOS = 0;
+	datagramsSent = 0;
+	bytesSent = 0.0;
+}
+
+
+//! Prints mean, median, 99th percentile and max, in milliseconds
+static void printSummary( const char *label, std::vector<double> &samples )
+{
+	cout << "  " << label << ": ";
+	if( samples.empty() )
+	{
+		cout << "no samples" << endl;
+		return;
+	}
+
+	std::sort( samples.begin(), samples.end() );
+	double sum = 0.0;
+	for( unsigned int i = 0; i < samples.size(); i++ )
+		sum += samples[i];
+	unsigned int last = samples.size() - 1;
+
+	cout << "mean " << 1000.0 * sum / samples.size()
+		<< " ms, median " << 1000.0 * samples[last / 2]
+		<< " ms, 99th " << 1000.0 * samples[( last * 99 ) / 100]
+		<< " ms, max " << 1000.0 * samples[last]
+		<< " ms (" << samples.size() << " samples)" << endl;
+}
+
+
+// ================================================
+// CigiLoadGen
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+CigiLoadGen::CigiLoadGen( const LoadGenParams &p ) :
+	params( p ),
+	frame( 0 ),
+	session(),
+	incoming( session.GetIncomingMsgMgr() ),
+	outgoing( session.GetOutgoingMsgMgr() ),
+	responseProcessor( this ),
+	datagramSize( 0 ),
+	igIsInOperateMode( false ),
+	haveSOF( false ),
+	lastIGFrame( 0 ),
+	lastSOFTime( 0.0 ),
+	nextHotID( 0 ),
+	nextLosID( 0 ),
+	nextSymbolSlot( 0 ),
+	nextChurnSlot( 0 ),
+	churnCreated( 0 ),
+	transport( NULL ),
+	incomingBufferSize( 0 )
+{
+	session.SetCigiVersion( 3, 3 );
+	session.SetSynchronous( false );
+
+	IG.SetFrameCntr( frame );
+	IG.SetIGMode( CigiBaseIGCtrl::Operate );
+	IG.SetDatabaseID( 0 ); // 0 = no database change requested
+
+	outgoing.BeginMsg();
+
+	incoming.SetReaderCigiVersion( 3, 3 );
+	incoming.UsingIteration( false );
+
+	incoming.RegisterEventProcessor( CIGI_SOF_PACKET_ID_V3_2, &responseProcessor );
+	incoming.RegisterEventProcessor( CIGI_HAT_HOT_RESP_PACKET_ID_V3_2, &responseProcessor );
+	incoming.RegisterEventProcessor( CIGI_HAT_HOT_XRESP_PACKET_ID_V3_2, &responseProcessor );
+	incoming.RegisterEventProcessor( CIGI_LOS_RESP_PACKET_ID_V3_2, &responseProcessor );
+	incoming.RegisterEventProcessor( CIGI_LOS_XRESP_PACKET_ID_V3_2, &responseProcessor );
+
+	symbolSlotUsed.resize( params.symbolChurn * SYMBOL_LIFETIME, false );
+	churnSlotUsed.resize( params.entityChurn * ( CHURN_LIFETIME + 1 ), false );
+}
+
+
+CigiLoadGen::~CigiLoadGen()
+{
+	delete transport;
+}
+
+
+void CigiLoadGen::init()
+{
+	if( params.transportType == "shared_memory" )
+	{
+		// the IG creates the segment, so it has to be started first
+		mpv::CigiTransportRing *ring = new mpv::CigiTransportRing();
+		transport = ring;
+		if( !ring->openSharedMemory( params.sharedMemoryName, 0,
+			mpv::CigiTransportRing::HostSide ) )
+		{
+			cout << "Unable to attach to shared memory segment "
+			<< params.sharedMemoryName << "; is the IG running?" << endl;
+			exit( 1 );
+		}
+		return;
+	}
+
+	mpv::CigiTransportUDP *udp = new mpv::CigiTransportUDP();
+	transport = udp;
+	bool success = udp->open(
+		params.igAddr.c_str(), params.igPort, params.listenPort );
+	if( !success )
+	{
+		cout << "Unable to open socket (send: "
+		<< params.igAddr << ":" << params.igPort
+		<< " recv: " << params.listenPort << ")" << endl;
+		exit( 1 );
+	}
+}
+
+
+// ================================================
+// OnPacketReceived
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::ResponseProcessor::OnPacketReceived( CigiBasePacket *Packet )
+{
+	double now = mpv::cigiRecordingClock();
+
+	switch( Packet->GetPacketID() )
+	{
+	case CIGI_SOF_PACKET_ID_V3_2:
+	{
+		CigiSOFV3_2 *sof = (CigiSOFV3_2 *)Packet;
+		loadGen->igIsInOperateMode = (
+			sof->GetIGMode() == CigiBaseSOF::Operate ||
+			sof->GetIGMode() == CigiBaseSOF::debug );
+
+		unsigned int igFrame = sof->GetFrameCntr();
+		if( loadGen->haveSOF )
+		{
+			// the IG numbers its frames consecutively, so any gap is a
+			// frame whose SOF never arrived
+			unsigned int gap = igFrame - loadGen->lastIGFrame;
+			if( gap > 1 && gap < 0x80000000u )
+				loadGen->stats.droppedSOFs += gap - 1;
+			if( gap > 0 )
+				loadGen->stats.frameTimes.push_back(
+					( now - loadGen->lastSOFTime ) / gap );
+		}
+		loadGen->haveSOF = true;
+		loadGen->lastIGFrame = igFrame;
+		loadGen->lastSOFTime = now;
+		break;
+	}
+	case CIGI_HAT_HOT_RESP_PACKET_ID_V3_2:
+	case CIGI_HAT_HOT_XRESP_PACKET_ID_V3_2:
+	{
+		int id = ( Packet->GetPacketID() == CIGI_HAT_HOT_RESP_PACKET_ID_V3_2 ) ?
+			((CigiHatHotRespV3_2 *)Packet)->GetHatHotID() :
+			((CigiHatHotXRespV3_2 *)Packet)->GetHatHotID();
+		std::map<int, double>::iterator iter = loadGen->pendingHOT.find( id );
+		if( iter != loadGen->pendingHOT.end() )
+		{
+			loadGen->stats.hotLatencies.push_back( now - iter->second );
+			loadGen->pendingHOT.erase( iter );
+		}
+		break;
+	}
+	case CIGI_LOS_RESP_PACKET_ID_V3_2:
+	case CIGI_LOS_XRESP_PACKET_ID_V3_2:
+	{
+		// a request may get several responses (one per intersection);
+		// the first one is the one that counts
+		int id = ( Packet->GetPacketID() == CIGI_LOS_RESP_PACKET_ID_V3_2 ) ?
+			((CigiLosRespV3_2 *)Packet)->GetLosID() :
+			((CigiLosXRespV3_2 *)Packet)->GetLosID();
+		std::map<int, double>::iterator iter = loadGen->pendingLOS.find( id );
+		if( iter != loadGen->pendingLOS.end() )
+		{
+			loadGen->stats.losLatencies.push_back( now - iter->second );
+			loadGen->pendingLOS.erase( iter );
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+
+// ================================================
+// receive
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+bool CigiLoadGen::receive()
+{
+	// wait for the IG's start-of-frame; then pick up anything else that
+	// is already waiting
+	bool first = true;
+	while( true )
+	{
+		if( first )
+			incomingBufferSize = transport->recvBlock( incomingBuffer, sizeof( incomingBuffer ) );
+		else
+			incomingBufferSize = transport->recv( incomingBuffer, sizeof( incomingBuffer ) );
+
+		if( incomingBufferSize <= 0 )
+		{
+			if( first )
+			{
+				std::cerr << "There was a networking error\n";
+				return false;
+			}
+			return true;
+		}
+		first = false;
+
+		try
+		{
+			incoming.ProcessIncomingMsg( incomingBuffer, incomingBufferSize );
+		}
+		catch( CigiException & te )
+		{
+			cout << "Exception = " << te.what() << endl;
+		}
+	}
+}
+
+
+// ================================================
+// beginDatagram
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::beginDatagram()
+{
+	// every datagram in a frame starts with the same IG Control, so that
+	// the IG will accept it on its own
+	outgoing << IG;
+	datagramSize = IG_CTRL_SIZE;
+}
+
+
+// ================================================
+// sendDatagram
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::sendDatagram( bool force )
+{
+	if( !force && datagramSize <= IG_CTRL_SIZE )
+		return;
+
+	int msg_len;
+	outgoing.LockMsg();
+	unsigned char *cigi_buffer = outgoing.GetMsg( msg_len );
+
+	int retval = transport->send( cigi_buffer, msg_len );
+	if( retval == -1 )
+	{
+		cout << "Error sending!" << endl;
+	}
+	else
+	{
+		stats.datagramsSent++;
+		stats.bytesSent += msg_len;
+	}
+
+	outgoing.UnlockMsg();
+	datagramSize = 0;
+}
+
+
+// ================================================
+// reserve
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::reserve( int packetSize )
+{
+	if( datagramSize + packetSize > params.maxDatagramSize )
+	{
+		sendDatagram();
+		beginDatagram();
+	}
+	datagramSize += packetSize;
+}
+
+
+// ================================================
+// addEntities
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::addEntities( int numEntities, double t )
+{
+	// top-level entities are laid out on a grid, roughly 100m apart, and
+	// each one circles around its grid point
+	int gridWidth = (int)ceil( sqrt( (double)numEntities ) );
+	const double spacing = 0.001;
+
+	for( int i = 0; i < numEntities; i++ )
+	{
+		int id = 1 + i * ( 1 + params.children );
+		double phase = t + i * 0.1;
+
+		entityCtrl.SetEntityID( id );
+		entityCtrl.SetEntityType( params.entityType );
+		entityCtrl.SetEntityState( CigiBaseEntityCtrl::Active );
+		entityCtrl.SetAttachState( CigiBaseEntityCtrl::Detach );
+		entityCtrl.SetParentID( 0 );
+		entityCtrl.SetAlpha( 255 );
+		entityCtrl.SetLat( params.originLat +
+			spacing * ( i / gridWidth - gridWidth / 2 ) + 0.0002 * sin( phase ) );
+		entityCtrl.SetLon( params.originLon +
+			spacing * ( i % gridWidth - gridWidth / 2 ) + 0.0002 * cos( phase ) );
+		entityCtrl.SetAlt( params.originAlt );
+		entityCtrl.SetYaw( fmod( phase * 57.29578, 360.0 ) );
+		entityCtrl.SetPitch( 0.0 );
+		entityCtrl.SetRoll( 0.0 );
+		reserve( ENTITY_CTRL_SIZE );
+		outgoing << entityCtrl;
+
+		for( int j = 0; j < params.articulations; j++ )
+		{
+			artPartCtrl.SetEntityID( id );
+			artPartCtrl.SetArtPartID( j );
+			artPartCtrl.SetArtPartEn( true );
+			artPartCtrl.SetXOffEn( false );
+			artPartCtrl.SetYOffEn( false );
+			artPartCtrl.SetZOffEn( false );
+			artPartCtrl.SetRollEn( false );
+			artPartCtrl.SetPitchEn( false );
+			artPartCtrl.SetYawEn( true );
+			artPartCtrl.SetYaw( fmod( phase * 90.0 + j * 10.0, 360.0 ) - 180.0 );
+			reserve( ART_PART_CTRL_SIZE );
+			outgoing << artPartCtrl;
+		}
+
+		for( int k = 0; k < params.children; k++ )
+		{
+			entityCtrl.SetEntityID( id + 1 + k );
+			entityCtrl.SetAttachState( CigiBaseEntityCtrl::Attach );
+			entityCtrl.SetParentID( id );
+			entityCtrl.SetXoff( 0.0 );
+			entityCtrl.SetYoff( 5.0 * ( k + 1 ) );
+			entityCtrl.SetZoff( 0.0 );
+			entityCtrl.SetYaw( fmod( phase * 30.0 * ( k + 1 ), 360.0 ) );
+			reserve( ENTITY_CTRL_SIZE );
+			outgoing << entityCtrl;
+		}
+	}
+}
+
+
+// ================================================
+// addRequests
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::addRequests( int numEntities, double t )
+{
+	double now = mpv::cigiRecordingClock();
+	int gridWidth = (int)ceil( sqrt( (double)numEntities ) );
+	double extent = 0.001 * gridWidth;
+
+	for( int i = 0; i < params.hotRequests; i++ )
+	{
+		int id = nextHotID;
+		nextHotID = ( nextHotID + 1 ) & 0xffff;
+
+		// spread the requests over the entity field
+		double u = fmod( ( id * 0.618034 ), 1.0 ) - 0.5;
+		double v = fmod( ( id * 0.381966 ), 1.0 ) - 0.5;
+
+		hotRequest.SetHatHotID( id );
+		hotRequest.SetReqType( CigiBaseHatHotReq::HOT );
+		hotRequest.SetSrcCoordSys( CigiBaseHatHotReq::Geodetic );
+		hotRequest.SetUpdatePeriod( 0 );
+		hotRequest.SetEntityID( 0 );
+		hotRequest.SetLat( params.originLat + u * extent );
+		hotRequest.SetLon( params.originLon + v * extent );
+		hotRequest.SetAlt( params.originAlt );
+		reserve( HAT_HOT_REQ_SIZE );
+		outgoing << hotRequest;
+
+		pendingHOT[id] = now;
+	}
+
+	for( int i = 0; i < params.losRequests; i++ )
+	{
+		int id = nextLosID;
+		nextLosID = ( nextLosID + 1 ) & 0xffff;
+
+		double u = fmod( ( id * 0.618034 ), 1.0 ) - 0.5;
+		double v = fmod( ( id * 0.381966 ), 1.0 ) - 0.5;
+
+		losRequest.SetLosID( id );
+		losRequest.SetReqType( CigiBaseLosVectReq::Basic );
+		losRequest.SetSrcCoordSys( CigiBaseLosVectReq::Geodetic );
+		losRequest.SetResponseCoordSys( CigiBaseLosVectReq::Geodetic );
+		losRequest.SetAlphaThresh( 0 );
+		losRequest.SetEntityID( 0 );
+		losRequest.SetVectAz( fmod( t * 10.0 + id, 360.0 ) - 180.0 );
+		losRequest.SetVectEl( -45.0 );
+		losRequest.SetMinRange( 0.0 );
+		losRequest.SetMaxRange( 10000.0 );
+		losRequest.SetSrcLat( params.originLat + u * extent );
+		losRequest.SetSrcLon( params.originLon + v * extent );
+		losRequest.SetSrcAlt( params.originAlt + 500.0 );
+		losRequest.SetMask( 0xffffffff );
+		losRequest.SetUpdatePeriod( 0 );
+		reserve( LOS_VECT_REQ_SIZE );
+		outgoing << losRequest;
+
+		pendingLOS[id] = now;
+	}
+}
+
+
+// ================================================
+// defineSurface
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::defineSurface()
+{
+	CigiSymbolSurfaceDefV3_3 surfaceDef;
+	surfaceDef.SetSurfaceID( SURFACE_ID );
+	surfaceDef.SetSurfaceState( CigiBaseSymbolSurfaceDef::Active );
+	surfaceDef.SetAttached( CigiBaseSymbolSurfaceDef::ViewAttached );
+	surfaceDef.SetViewID( 0 );
+	surfaceDef.SetMinU( -1.0 );
+	surfaceDef.SetMinV( -1.0 );
+	surfaceDef.SetMaxU( 1.0 );
+	surfaceDef.SetMaxV( 1.0 );
+	surfaceDef.SetTopEdgePosition( 0.9 );
+	surfaceDef.SetBottomEdgePosition( 0.1 );
+	surfaceDef.SetLeftEdgePosition( 0.1 );
+	surfaceDef.SetRightEdgePosition( 0.9 );
+	outgoing << surfaceDef;
+}
+
+
+// ================================================
+// addSymbols
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::addSymbols()
+{
+	int numSlots = (int)symbolSlotUsed.size();
+
+	for( int i = 0; i < params.symbolChurn; i++ )
+	{
+		int slot = nextSymbolSlot;
+		nextSymbolSlot = ( nextSymbolSlot + 1 ) % numSlots;
+		int id = 1 + slot;
+
+		symbolCtrl.SetSymbolID( id );
+		symbolCtrl.SetAttachState( CigiBaseSymbolCtrl::Detach );
+		symbolCtrl.SetParentSymbolID( 0 );
+		symbolCtrl.SetSurfaceID( SURFACE_ID );
+		symbolCtrl.SetLayer( 0 );
+		symbolCtrl.SetInheritColor( CigiBaseSymbolCtrl::NotInherit );
+		symbolCtrl.SetFlashCtrl( CigiBaseSymbolCtrl::Continue );
+		symbolCtrl.SetFlashDutyCycle( 100 );
+		symbolCtrl.SetFlashPeriod( 1.0 );
+		symbolCtrl.SetRotation( 0.0 );
+		symbolCtrl.SetScaleU( 1.0 );
+		symbolCtrl.SetScaleV( 1.0 );
+
+		// the oldest symbol in this slot is destroyed...
+		if( symbolSlotUsed[slot] )
+		{
+			symbolCtrl.SetSymbolState( CigiBaseSymbolCtrl::Destroyed );
+			reserve( SYMBOL_CTRL_SIZE );
+			outgoing << symbolCtrl;
+		}
+
+		// ...and a new one takes its place
+		circleDef.SetSymbolID( id );
+		circleDef.SetDrawingStyle( CigiBaseSymbolCircleDef::Line );
+		circleDef.SetStipplePattern( 0xffff );
+		circleDef.SetLineWidth( 1.0 );
+		circleDef.SetStipplePatternLen( 1.0 );
+		circleDef.ClearCircles();
+		CigiBaseCircleSymbolData *circle = circleDef.AddCircle();
+		circle->SetCenterUPosition( 0.0 );
+		circle->SetCenterVPosition( 0.0 );
+		circle->SetRadius( 0.02 + 0.01 * ( id % 5 ) );
+		circle->SetInnerRadius( 0.0 );
+		circle->SetStartAngle( 0.0 );
+		circle->SetEndAngle( 360.0 );
+		reserve( SYMBOL_CIRCLE_SIZE );
+		outgoing << circleDef;
+
+		symbolCtrl.SetSymbolState( CigiBaseSymbolCtrl::Visible );
+		symbolCtrl.SetUPosition( fmod( id * 0.618034, 1.0 ) * 1.8 - 0.9 );
+		symbolCtrl.SetVPosition( fmod( id * 0.381966, 1.0 ) * 1.8 - 0.9 );
+		symbolCtrl.SetColor( 0, 255, 0, 255 );
+		reserve( SYMBOL_CTRL_SIZE );
+		outgoing << symbolCtrl;
+
+		symbolSlotUsed[slot] = true;
+	}
+}
+
+
+// ================================================
+// churnEntities
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::churnEntities( double t )
+{
+	int numSlots = (int)churnSlotUsed.size();
+
+	for( int i = 0; i < params.entityChurn; i++ )
+	{
+		int slot = nextChurnSlot;
+		nextChurnSlot = ( nextChurnSlot + 1 ) % numSlots;
+
+		entityCtrl.SetAttachState( CigiBaseEntityCtrl::Detach );
+		entityCtrl.SetParentID( 0 );
+
+		// the entity created CHURN_LIFETIME frames ago is removed...
+		int oldSlot = ( slot + params.entityChurn ) % numSlots;
+		if( churnSlotUsed[oldSlot] )
+		{
+			entityCtrl.SetEntityID( MAX_ENTITY_ID - oldSlot );
+			entityCtrl.SetEntityState( CigiBaseEntityCtrl::Remove );
+			reserve( ENTITY_CTRL_SIZE );
+			outgoing << entityCtrl;
+			churnSlotUsed[oldSlot] = false;
+		}
+
+		// ...and a new one is created, in the slot freed last frame
+		double phase = t + slot * 0.1;
+		entityCtrl.SetEntityID( MAX_ENTITY_ID - slot );
+		entityCtrl.SetEntityType( params.churnType );
+		entityCtrl.SetEntityState( CigiBaseEntityCtrl::Active );
+		entityCtrl.SetAlpha( 255 );
+		entityCtrl.SetLat( params.originLat + 0.002 * sin( phase ) );
+		entityCtrl.SetLon( params.originLon + 0.002 * cos( phase ) );
+		entityCtrl.SetAlt( params.originAlt );
+		entityCtrl.SetYaw( fmod( phase * 57.29578, 360.0 ) );
+		entityCtrl.SetPitch( 0.0 );
+		entityCtrl.SetRoll( 0.0 );
+		reserve( ENTITY_CTRL_SIZE );
+		outgoing << entityCtrl;
+		churnSlotUsed[slot] = true;
+		churnCreated++;
+	}
+}
+
+
+// ================================================
+// removeEntities
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::removeEntities( int numEntities )
+{
+	IG.SetFrameCntr( ++frame );
+	beginDatagram();
+
+	// removing a parent removes its children
+	for( int i = 0; i < numEntities; i++ )
+	{
+		entityCtrl.SetEntityID( 1 + i * ( 1 + params.children ) );
+		entityCtrl.SetAttachState( CigiBaseEntityCtrl::Detach );
+		entityCtrl.SetEntityState( CigiBaseEntityCtrl::Remove );
+		reserve( ENTITY_CTRL_SIZE );
+		outgoing << entityCtrl;
+	}
+
+	for( unsigned int slot = 0; slot < churnSlotUsed.size(); slot++ )
+	{
+		if( !churnSlotUsed[slot] )
+			continue;
+		entityCtrl.SetEntityID( MAX_ENTITY_ID - slot );
+		entityCtrl.SetAttachState( CigiBaseEntityCtrl::Detach );
+		entityCtrl.SetEntityState( CigiBaseEntityCtrl::Remove );
+		reserve( ENTITY_CTRL_SIZE );
+		outgoing << entityCtrl;
+		churnSlotUsed[slot] = false;
+	}
+
+	sendDatagram( true );
+}
+
+
+// ================================================
+// sendFrame
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::sendFrame( int numEntities )
+{
+	double t = frame / 60.0;
+
+	IG.SetFrameCntr( ++frame );
+
+	try
+	{
+		beginDatagram();
+		addEntities( numEntities, t );
+		addRequests( numEntities, t );
+		if( params.symbolChurn > 0 )
+			addSymbols();
+		if( params.entityChurn > 0 )
+			churnEntities( t );
+	}
+	catch( CigiException & te )
+	{
+		cout << __FILE__ << ":" << __LINE__ << " " << te.what() << endl;
+	}
+
+	// always send at least the IG Control, so the IG keeps running
+	sendDatagram( true );
+}
+
+
+// ================================================
+// finishStep
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+void CigiLoadGen::finishStep( int numEntities )
+{
+	stats.unansweredHOT = pendingHOT.size();
+	stats.unansweredLOS = pendingLOS.size();
+	pendingHOT.clear();
+	pendingLOS.clear();
+
+	int totalEntities = numEntities * ( 1 + params.children );
+	cout << numEntities << " entities (" << totalEntities << " including children, "
+		<< numEntities * params.articulations << " articulations), "
+		<< params.framesPerStep << " frames" << endl;
+	printSummary( "IG frame time", stats.frameTimes );
+	if( params.hotRequests > 0 )
+		printSummary( "HOT latency  ", stats.hotLatencies );
+	if( params.losRequests > 0 )
+		printSummary( "LOS latency  ", stats.losLatencies );
+	cout << "  sent " << (double)stats.datagramsSent / params.framesPerStep
+		<< " datagrams, " << stats.bytesSent / params.framesPerStep / 1024.0
+		<< " KB per frame" << endl;
+	if( params.entityChurn > 0 )
+	{
+		// the IG logs how long it spent creating them
+		cout << "  churned " << churnCreated << " entities of type " 
+			<< params.churnType << endl;
+		churnCreated = 0;
+	}
+	cout << "  dropped: " << stats.droppedSOFs << " SOFs, "
+		<< stats.unansweredHOT << " HOT requests, "
+		<< stats.unansweredLOS << " LOS requests" << endl;
+
+	stats.clear();
+}
+
+
+// ================================================
+// run
+// vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+int CigiLoadGen::run()
+{
+	cout << "Waiting for the IG to send SOF and transition to Operate mode." << endl;
+
+	while( !igIsInOperateMode )
+	{
+		if( !receive() )
+			return 1;
+		IG.SetFrameCntr( ++frame );
+		beginDatagram();
+		sendDatagram( true );
+	}
+
+	cout << "IG is ready.  Beginning tests." << endl;
+
+	if( params.symbolChurn > 0 )
+	{
+		if( !receive() )
+			return 1;
+		IG.SetFrameCntr( ++frame );
+		beginDatagram();
+		defineSurface();
+		sendDatagram( true );
+	}
+
+	int numEntities = 0;
+	for( unsigned int step = 0; step < params.entityCounts.size(); step++ )
+	{
+		numEntities = params.entityCounts[step];
+		stats.clear();
+
+		for( int i = 0; i < params.framesPerStep; i++ )
+		{
+			if( !receive() )
+				return 1;
+			sendFrame( numEntities );
+		}
+
+		finishStep( numEntities );
+	}
+
+	// clean up after ourselves
+	if( receive() )
+		removeEntities( numEntities );
+
+	return 0;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	LoadGenParams params;
+	if( !params.parse( argc, argv ) )
+		return 1;
+
+	CigiLoadGen loadGen( params );
+	loadGen.init();
+	return loadGen.run();
+}
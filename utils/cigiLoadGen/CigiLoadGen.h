@@ -0,0 +1,233 @@
+/** <pre>
+ * MPV CIGI load generator utility
+ * Copyright (c) 2026
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Revision history:
+ *
+ * 2026-10-19
+ *     Initial version.  Structure based on symbologyStress.
+ *
+ * 2026-10-19
+ *     Added entity churn, for measuring the IG's entity creation rate.
+ *
+ */
+
+
+#ifndef CIGILOADGEN_H
+#define CIGILOADGEN_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <CigiHostSession.h>
+#include <CigiIGCtrlV3_2.h>
+#include <CigiSOFV3_2.h>
+#include <CigiEntityCtrlV3.h>
+#include <CigiArtPartCtrlV3.h>
+#include <CigiHatHotReqV3_2.h>
+#include <CigiLosVectReqV3_2.h>
+#include <CigiSymbolSurfaceDefV3_3.h>
+#include <CigiSymbolCtrlV3_3.h>
+#include <CigiSymbolCircleDefV3_3.h>
+#include <CigiBaseEventProcessor.h>
+#include <CigiIO.h>
+#include <CigiExceptions.h>
+
+#include "CigiTransport.h"
+
+
+//=========================================================
+//! Everything the user can configure from the command line
+//!
+struct LoadGenParams
+{
+	LoadGenParams();
+
+	//! Parses the command line; returns false (after printing usage) if
+	//! the arguments don't make sense
+	bool parse( int argc, char *argv[] );
+
+	//! entity counts to step through, eg 10, 100, 1000, 10000
+	std::vector<int> entityCounts;
+	//! articulated parts per top-level entity
+	int articulations;
+	//! child entities per top-level entity
+	int children;
+	//! HOT requests per frame
+	int hotRequests;
+	//! LOS requests per frame
+	int losRequests;
+	//! symbols destroyed and recreated per frame
+	int symbolChurn;
+	//! entities removed and created per frame, in addition to the 
+	//! entityCounts entities
+	int entityChurn;
+	//! entity type of the churned entities
+	int churnType;
+	//! frames spent at each entity count
+	int framesPerStep;
+	//! entity type sent in Entity Control packets
+	int entityType;
+	//! the largest datagram sent to the IG; each frame is split as needed
+	int maxDatagramSize;
+
+	double originLat, originLon, originAlt;
+
+	//! "udp" or "shared_memory"
+	std::string transportType;
+	std::string sharedMemoryName;
+
+	std::string igAddr;
+	int igPort;
+	int listenPort;
+};
+
+
+//=========================================================
+//! Summary statistics for one step of the test
+//!
+struct LoadGenStats
+{
+	LoadGenStats() { clear(); }
+	void clear();
+
+	//! time between consecutive SOFs, ie the IG's frame time
+	std::vector<double> frameTimes;
+	//! request-to-response times
+	std::vector<double> hotLatencies;
+	std::vector<double> losLatencies;
+
+	//! IG frames for which no SOF arrived
+	int droppedSOFs;
+	//! requests still unanswered at the end of the step
+	int unansweredHOT;
+	int unansweredLOS;
+
+	int datagramsSent;
+	double bytesSent;
+};
+
+
+//=========================================================
+//! A synthetic CIGI host.  Drives N entities, each with M articulated
+//! parts and C children, plus a stream of HOT/LOS requests and symbol
+//! churn, stepping N through a list of counts and reporting the IG's
+//! frame time, request latency and losses at each step.
+//!
+class CigiLoadGen
+{
+
+public:
+
+	CigiLoadGen( const LoadGenParams &params );
+	~CigiLoadGen();
+
+	void init();
+	int run();
+
+private:
+
+	//! Receives this frame's traffic from the IG, blocking until the
+	//! first datagram arrives.  Returns false on a network error.
+	bool receive();
+
+	//! Builds and sends one frame's worth of packets
+	void sendFrame( int numEntities );
+
+	//! Starts a new datagram with an IG Control packet
+	void beginDatagram();
+
+	//! Makes room for a packet of the given size, sending the current
+	//! datagram first if the packet wouldn't fit
+	void reserve( int packetSize );
+
+	//! Sends the current datagram, if it holds anything beyond IG Control
+	void sendDatagram( bool force = false );
+
+	void addEntities( int numEntities, double t );
+	void addRequests( int numEntities, double t );
+	void addSymbols();
+	void churnEntities( double t );
+	void defineSurface();
+	void removeEntities( int numEntities );
+
+	void finishStep( int numEntities );
+
+	//! Receives SOFs and request responses
+	class ResponseProcessor : public CigiBaseEventProcessor
+	{
+	public:
+		ResponseProcessor( CigiLoadGen *loadGen ) : loadGen( loadGen ) {}
+		virtual ~ResponseProcessor() {}
+		virtual void OnPacketReceived( CigiBasePacket *Packet );
+		CigiLoadGen *loadGen;
+	};
+	friend class ResponseProcessor;
+
+	LoadGenParams params;
+	LoadGenStats stats;
+
+	unsigned int frame;
+
+	CigiHostSession session;
+	CigiIncomingMsg &incoming;
+	CigiOutgoingMsg &outgoing;
+
+	CigiIGCtrlV3_2 IG;
+	CigiEntityCtrlV3 entityCtrl;
+	CigiArtPartCtrlV3 artPartCtrl;
+	CigiHatHotReqV3_2 hotRequest;
+	CigiLosVectReqV3_2 losRequest;
+	CigiSymbolCircleDefV3_3 circleDef;
+	CigiSymbolCtrlV3_3 symbolCtrl;
+
+	ResponseProcessor responseProcessor;
+
+	//! bytes in the datagram being built
+	int datagramSize;
+
+	//! IG state, from the most recent SOF
+	bool igIsInOperateMode;
+	bool haveSOF;
+	unsigned int lastIGFrame;
+	double lastSOFTime;
+
+	//! outstanding requests, keyed by ID, with the time they were sent
+	std::map<int, double> pendingHOT;
+	std::map<int, double> pendingLOS;
+	int nextHotID;
+	int nextLosID;
+
+	//! symbol churn; slots cycle through symbol IDs
+	int nextSymbolSlot;
+	std::vector<bool> symbolSlotUsed;
+
+	//! entity churn; slots cycle through entity IDs down from the top
+	int nextChurnSlot;
+	std::vector<bool> churnSlotUsed;
+	//! churned entities created during the current step
+	int churnCreated;
+
+	mpv::CigiTransport *transport;
+	unsigned char incomingBuffer[ 65536 ];
+	int incomingBufferSize;
+
+};
+
+#endif
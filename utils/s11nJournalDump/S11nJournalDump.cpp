@@ -0,0 +1,120 @@
+/** <pre>
+ * MPV s11n journal dump utility
+ * Copyright (c) 2026
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Revision history:
+ *
+ * 2026-10-19
+ *     Initial version.
+ *
+ */
+
+
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "JournalReader.h"
+#include "NodeVisitorXML.h"
+
+using namespace mpvs11n;
+
+
+static void usage( const char *argv0 )
+{
+	std::cout << "Usage: " << argv0 << " [options] journal_file\n"
+		<< "Prints the s11n tree recorded by PluginS11nJournal, as xml.\n"
+		<< "  --list          print the recorded frame numbers and times and exit\n"
+		<< "  --frame N       print the tree as it was at frame N (the last frame)\n";
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::string filename;
+	bool list = false;
+	bool haveFrame = false;
+	unsigned int frame = 0;
+
+	for( int i = 1; i < argc; i++ )
+	{
+		std::string arg = argv[i];
+		if( arg == "--list" )
+			list = true;
+		else if( arg == "--frame" && i + 1 < argc )
+		{
+			frame = strtoul( argv[++i], NULL, 10 );
+			haveFrame = true;
+		}
+		else if( arg[0] != '-' && filename.empty() )
+			filename = arg;
+		else
+		{
+			usage( argv[0] );
+			return 1;
+		}
+	}
+
+	if( filename.empty() )
+	{
+		usage( argv[0] );
+		return 1;
+	}
+
+	JournalReader reader;
+	if( !reader.open( filename ) )
+	{
+		std::cerr << "Could not open journal \"" << filename << "\"\n";
+		return 1;
+	}
+
+	if( reader.getFrameCount() == 0 )
+	{
+		std::cerr << "The journal is empty\n";
+		return 1;
+	}
+
+	if( list )
+	{
+		for( int i = 0; i < reader.getFrameCount(); i++ )
+			printf( "%u\t%.3f\n", reader.getFrameNumber( i ), reader.getFrameTime( i ) );
+		return 0;
+	}
+
+	if( !haveFrame )
+		frame = reader.getFrameNumber( reader.getFrameCount() - 1 );
+
+	if( !reader.seek( frame ) )
+	{
+		std::cerr << "Frame " << frame << " is not in the journal\n";
+		return 1;
+	}
+
+	printf( "<!-- frame %u, time %.3f -->\n", 
+		reader.getCurrentFrame(), reader.getCurrentTime() );
+
+	mpv::RefPtr<Node> root = reader.buildTree();
+	if( root.valid() )
+	{
+		NodeVisitorXML visitor( std::cout );
+		root->accept( visitor );
+	}
+
+	return 0;
+}
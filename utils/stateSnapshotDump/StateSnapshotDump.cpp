@@ -0,0 +1,201 @@
+/** <pre>
+ * MPV state snapshot dump utility
+ * Copyright (c) 2026
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *
+ * Revision history:
+ *
+ * 2026-10-19
+ *     Initial version.
+ *
+ */
+
+
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <OpenThreads/Thread>
+
+#include "StateSnapshot.h"
+
+using namespace mpv;
+
+
+static void usage( const char *argv0 )
+{
+	std::cout << "Usage: " << argv0 << " [options]\n"
+		<< "Prints the state snapshots published by PluginStateSnapshot.\n"
+		<< "  --name NAME     shared memory segment name (/mpv_state)\n"
+		<< "  --schema        print the record layout and exit\n"
+		<< "  --once          print the newest snapshot and exit\n"
+		<< "  --summary       print one line per frame instead of every record\n"
+		<< "  --every N       print every Nth frame (1)\n";
+}
+
+
+static const char *recordName( int record )
+{
+	switch( record )
+	{
+	case SnapshotField::EntityRecord: return "entity";
+	case SnapshotField::ViewRecord: return "view";
+	case SnapshotField::SymbolRecord: return "symbol";
+	default: return "?";
+	}
+}
+
+
+static const char *typeName( int type )
+{
+	switch( type )
+	{
+	case SnapshotField::UInt8: return "uint8";
+	case SnapshotField::UInt16: return "uint16";
+	case SnapshotField::Int32: return "int32";
+	case SnapshotField::Float32: return "float32";
+	case SnapshotField::Float64: return "float64";
+	default: return "?";
+	}
+}
+
+
+static void printSchema( const std::vector<SnapshotField> &schema )
+{
+	for( unsigned int i = 0; i < schema.size(); i++ )
+	{
+		const SnapshotField &field = schema[i];
+		printf( "%-8s %-20s %-8s x%d  @%u\n", recordName( field.record ), 
+			field.name, typeName( field.type ), field.count, field.offset );
+	}
+}
+
+
+static void printSnapshot( const StateSnapshot &snapshot, bool summary )
+{
+	printf( "frame %u  time %.3f  state %d  entities %u  views %u  symbols %u\n", 
+		snapshot.frame, snapshot.time, snapshot.systemState, 
+		(unsigned int)snapshot.entities.size(), 
+		(unsigned int)snapshot.views.size(), 
+		(unsigned int)snapshot.symbols.size() );
+	if( summary )
+		return;
+
+	for( unsigned int i = 0; i < snapshot.entities.size(); i++ )
+	{
+		const SnapshotEntity &e = snapshot.entities[i];
+		printf( "  entity %5u type %5u parent %5u state %u alpha %3u clamp %u flags %x  "
+			"pos %.7f %.7f %.2f  ypr %.2f %.2f %.2f\n", 
+			e.id, e.type, e.parentID, e.state, e.alpha, e.groundClamp, e.flags, 
+			e.position[0], e.position[1], e.position[2], 
+			e.orientation[0], e.orientation[1], e.orientation[2] );
+	}
+
+	for( unsigned int i = 0; i < snapshot.views.size(); i++ )
+	{
+		const SnapshotView &v = snapshot.views[i];
+		printf( "  view %3d group %3d entity %5d type %d  fov %.2f %.2f %.2f %.2f  "
+			"near %.2f far %.1f  offset %.2f %.2f %.2f  rotate %.2f %.2f %.2f\n", 
+			v.id, v.groupID, v.entityID, v.type, 
+			v.fov[0], v.fov[1], v.fov[2], v.fov[3], v.nearPlane, v.farPlane, 
+			v.offset[0], v.offset[1], v.offset[2], 
+			v.rotate[0], v.rotate[1], v.rotate[2] );
+	}
+
+	for( unsigned int i = 0; i < snapshot.symbols.size(); i++ )
+	{
+		const SnapshotSymbol &s = snapshot.symbols[i];
+		printf( "  symbol %5u surface %5u parent %5u type %u state %u layer %3u flags %x  "
+			"pos %.3f %.3f  rot %.1f  scale %.2f %.2f  color %.2f %.2f %.2f %.2f\n", 
+			s.id, s.surfaceID, s.parentID, s.type, s.state, s.layer, s.flags, 
+			s.position[0], s.position[1], s.rotation, s.scale[0], s.scale[1], 
+			s.color[0], s.color[1], s.color[2], s.color[3] );
+	}
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::string name = "/mpv_state";
+	bool schemaOnly = false;
+	bool once = false;
+	bool summary = false;
+	int every = 1;
+
+	for( int i = 1; i < argc; i++ )
+	{
+		std::string arg = argv[i];
+		if( arg == "--name" && i + 1 < argc )
+			name = argv[++i];
+		else if( arg == "--schema" )
+			schemaOnly = true;
+		else if( arg == "--once" )
+			once = true;
+		else if( arg == "--summary" )
+			summary = true;
+		else if( arg == "--every" && i + 1 < argc )
+			every = atoi( argv[++i] );
+		else
+		{
+			usage( argv[0] );
+			return 1;
+		}
+	}
+	if( every < 1 )
+		every = 1;
+
+	StateSnapshotReader reader;
+	if( !reader.open( name ) )
+	{
+		std::cerr << "Unable to open state snapshot segment " << name 
+			<< "; is the IG running with PluginStateSnapshot?" << std::endl;
+		return 1;
+	}
+
+	if( schemaOnly )
+	{
+		printSchema( reader.getSchema() );
+		return 0;
+	}
+
+	StateSnapshot snapshot;
+	unsigned int lastFrame = 0;
+	while( true )
+	{
+		// polling the frame number costs one shared memory read; the 
+		// full copy is only made when there is something new
+		unsigned int latestFrame = reader.getLatestFrame();
+		if( latestFrame == lastFrame || 
+			( !once && latestFrame % every != 0 ) )
+		{
+			OpenThreads::Thread::microSleep( 500 );
+			continue;
+		}
+
+		if( reader.read( snapshot ) )
+		{
+			lastFrame = snapshot.frame;
+			printSnapshot( snapshot, summary );
+			fflush( stdout );
+			if( once )
+				break;
+		}
+	}
+
+	return 0;
+}